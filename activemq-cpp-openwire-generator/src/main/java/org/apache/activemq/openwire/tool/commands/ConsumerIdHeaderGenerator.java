@@ -24,6 +24,7 @@ public class ConsumerIdHeaderGenerator extends CommandHeaderGenerator {
     protected void populateIncludeFilesSet() {
         Set<String> includes = getIncludeFiles();
         includes.add("<activemq/commands/SessionId.h>");
+        includes.add("<mutex>");
 
         super.populateIncludeFilesSet();
     }
@@ -41,7 +42,9 @@ public class ConsumerIdHeaderGenerator extends CommandHeaderGenerator {
 
         out.println("    private:");
         out.println("");
+        out.println("        // Built on first use, ids are shared across threads once interned.");
         out.println("        mutable Pointer<SessionId> parentId;");
+        out.println("        mutable std::once_flag parentIdOnce;");
         out.println("");
     }
 
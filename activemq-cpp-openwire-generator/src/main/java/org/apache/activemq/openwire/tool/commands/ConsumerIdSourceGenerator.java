@@ -37,15 +37,14 @@ public class ConsumerIdSourceGenerator extends CommandSourceGenerator {
     }
 
     protected String generateInitializerList() {
-        return super.generateInitializerList() + ", parentId()";
+        return super.generateInitializerList() + ", parentId(), parentIdOnce()";
     }
 
     protected void generateAdditionalMethods( PrintWriter out ) {
         out.println("////////////////////////////////////////////////////////////////////////////////");
         out.println("const Pointer<SessionId>& ConsumerId::getParentId() const {");
-        out.println("    if (this->parentId == NULL) {");
-        out.println("        this->parentId.reset(new SessionId(this));");
-        out.println("    }");
+        out.println("    std::call_once(this->parentIdOnce,");
+        out.println("                   [this]() { this->parentId.reset(new SessionId(this)); });");
         out.println("    return this->parentId;");
         out.println("}");
         out.println("");
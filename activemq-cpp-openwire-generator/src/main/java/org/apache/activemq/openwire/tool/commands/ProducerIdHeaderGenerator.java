@@ -24,6 +24,7 @@ public class ProducerIdHeaderGenerator extends CommandHeaderGenerator {
     protected void populateIncludeFilesSet() {
         Set<String> includes = getIncludeFiles();
         includes.add("<activemq/commands/SessionId.h>");
+        includes.add("<mutex>");
 
         super.populateIncludeFilesSet();
     }
@@ -43,7 +44,9 @@ public class ProducerIdHeaderGenerator extends CommandHeaderGenerator {
 
         out.println("    private:");
         out.println("");
+        out.println("        // Built on first use, ids are shared across threads once interned.");
         out.println("        mutable Pointer<SessionId> parentId;");
+        out.println("        mutable std::once_flag parentIdOnce;");
         out.println("");
     }
 
@@ -52,15 +52,14 @@ public class ProducerIdSourceGenerator extends CommandSourceGenerator {
     }
 
     protected String generateInitializerList() {
-        return super.generateInitializerList() + ", parentId()";
+        return super.generateInitializerList() + ", parentId(), parentIdOnce()";
     }
 
     protected void generateAdditionalMethods( PrintWriter out ) {
         out.println("////////////////////////////////////////////////////////////////////////////////");
         out.println("const Pointer<SessionId>& ProducerId::getParentId() const {");
-        out.println("    if (this->parentId == NULL) {");
-        out.println("        this->parentId.reset(new SessionId(this));");
-        out.println("    }");
+        out.println("    std::call_once(this->parentIdOnce,");
+        out.println("                   [this]() { this->parentId.reset(new SessionId(this)); });");
         out.println("    return this->parentId;");
         out.println("}");
         out.println("");
@@ -24,6 +24,7 @@ public class SessionIdHeaderGenerator extends CommandHeaderGenerator {
     protected void populateIncludeFilesSet() {
         Set<String> includes = getIncludeFiles();
         includes.add("<activemq/commands/ConnectionId.h>");
+        includes.add("<mutex>");
 
         super.populateIncludeFilesSet();
     }
@@ -52,7 +53,9 @@ public class SessionIdHeaderGenerator extends CommandHeaderGenerator {
 
         out.println("    private:");
         out.println("");
+        out.println("        // Built on first use, ids are shared across threads once interned.");
         out.println("        mutable Pointer<ConnectionId> parentId;");
+        out.println("        mutable std::once_flag parentIdOnce;");
         out.println("");
     }
 
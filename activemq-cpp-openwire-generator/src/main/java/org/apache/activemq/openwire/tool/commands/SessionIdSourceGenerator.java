@@ -40,7 +40,7 @@ public class SessionIdSourceGenerator extends CommandSourceGenerator {
     }
 
     protected String generateInitializerList() {
-        return super.generateInitializerList() + ", parentId()";
+        return super.generateInitializerList() + ", parentId(), parentIdOnce()";
     }
 
     protected void generateAdditionalConstructors( PrintWriter out ) {
@@ -76,9 +76,8 @@ public class SessionIdSourceGenerator extends CommandSourceGenerator {
     protected void generateAdditionalMethods( PrintWriter out ) {
         out.println("////////////////////////////////////////////////////////////////////////////////");
         out.println("const Pointer<ConnectionId>& SessionId::getParentId() const {");
-        out.println("    if (this->parentId == NULL) {");
-        out.println("        this->parentId.reset(new ConnectionId(this));");
-        out.println("    }");
+        out.println("    std::call_once(this->parentIdOnce,");
+        out.println("                   [this]() { this->parentId.reset(new ConnectionId(this)); });");
         out.println("    return this->parentId;");
         out.println("}");
         out.println("");
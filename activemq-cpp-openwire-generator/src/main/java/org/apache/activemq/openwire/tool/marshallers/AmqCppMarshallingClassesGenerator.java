@@ -185,9 +185,14 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
             out.println(indent + "info->" + setter + "(Pointer<"+nativeType+">(dynamic_cast<" + nativeType + "* >(");
             out.println(indent + "    tightUnmarshalBrokerError(wireFormat, dataIn, bs))));");
         }
+        else if( isInternedProperty(property) ) {
+            String kind = isCachedProperty(property) ? "Cached" : "Nested";
+            out.println(indent + "info->" + setter + "(std::dynamic_pointer_cast<" + nativeType + ">(");
+            out.println(indent + "    tightUnmarshalInterned" + kind + "Object(wireFormat, dataIn, bs)));");
+        }
         else if( isCachedProperty(property) ) {
-            out.println(indent + "info->" + setter + "(Pointer<"+nativeType+">(dynamic_cast<" + nativeType + "* >(");
-            out.println(indent + "    tightUnmarshalCachedObject(wireFormat, dataIn, bs))));");
+            out.println(indent + "info->" + setter + "(std::dynamic_pointer_cast<" + nativeType + ">(");
+            out.println(indent + "    tightUnmarshalCachedObject(wireFormat, dataIn, bs)));");
         }
         else {
             out.println(indent + "info->" + setter + "(Pointer<"+nativeType+">(dynamic_cast<" + nativeType + "* >(");
@@ -195,6 +200,16 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
         }
     }
 
+    /**
+     * Ids and destinations are unmarshaled through the wire format's intern
+     * table so that repeats share one immutable instance.
+     */
+    protected boolean isInternedProperty(JProperty property) {
+        String type = property.getType().getSimpleName();
+        return type.equals("ProducerId") || type.equals("ConsumerId") ||
+               type.equals("ActiveMQDestination");
+    }
+
     protected void generateTightUnmarshalBodyForArrayProperty(PrintWriter out, JProperty property, JAnnotationValue size, String indent) {
         JClass propertyType = property.getType();
         String arrayType = propertyType.getArrayComponentType().getSimpleName();
@@ -446,9 +461,14 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
             out.println(indent + "info->" + setter + "(Pointer<"+nativeType+">(dynamic_cast< " + nativeType + "*>(");
             out.println(indent + "    looseUnmarshalBrokerError(wireFormat, dataIn))));");
         }
+        else if (isInternedProperty(property)) {
+            String kind = isCachedProperty(property) ? "Cached" : "Nested";
+            out.println(indent + "info->" + setter + "(std::dynamic_pointer_cast<" + nativeType + ">(");
+            out.println(indent + "    looseUnmarshalInterned" + kind + "Object(wireFormat, dataIn)));");
+        }
         else if (isCachedProperty(property)) {
-            out.println(indent + "info->" + setter + "(Pointer<"+nativeType+">(dynamic_cast<" + nativeType + "*>(");
-            out.println(indent + "    looseUnmarshalCachedObject(wireFormat, dataIn))));");
+            out.println(indent + "info->" + setter + "(std::dynamic_pointer_cast<" + nativeType + ">(");
+            out.println(indent + "    looseUnmarshalCachedObject(wireFormat, dataIn)));");
         }
         else {
             out.println(indent + "info->" + setter + "(Pointer<"+nativeType+">(dynamic_cast<" + nativeType + "*>(");
@@ -609,16 +629,18 @@ out.println("}");
 out.println("");
     }
 
+    List<JProperty> properties = getProperties();
+    boolean marshallerAware = isMarshallerAware();
+
+    for( String dataInType : DATA_IN_TYPES ) {
 out.println("///////////////////////////////////////////////////////////////////////////////");
-out.println("void "+className+"::tightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn, BooleanStream* bs) {");
+out.println("void "+className+"::tightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, "+dataInType+"* dataIn, BooleanStream* bs) {");
 out.println("");
 out.println("    try {");
 out.println("");
 out.println("        "+baseClass+"::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);");
 out.println("");
 
-    List<JProperty> properties = getProperties();
-    boolean marshallerAware = isMarshallerAware();
     if( !properties.isEmpty() || marshallerAware ) {
 
         String properClassName = getProperClassName( jclass.getSimpleName() );
@@ -650,6 +672,8 @@ out.println("    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, deca
 out.println("    AMQ_CATCHALL_THROW(decaf::io::IOException)" );
 out.println("}");
 out.println("");
+    }
+
 out.println("///////////////////////////////////////////////////////////////////////////////");
 out.println("int "+className+"::tightMarshal1(OpenWireFormat* wireFormat, DataStructure* dataStructure, BooleanStream* bs) {");
 out.println("");
@@ -685,8 +709,10 @@ out.println("    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, deca
 out.println("    AMQ_CATCHALL_THROW(decaf::io::IOException)" );
 out.println("}");
 out.println("");
+
+    for( String dataOutType : DATA_OUT_TYPES ) {
 out.println("///////////////////////////////////////////////////////////////////////////////");
-out.println("void "+className+"::tightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {");
+out.println("void "+className+"::tightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, "+dataOutType+"* dataOut, BooleanStream* bs) {");
 out.println("");
 out.println("    try {");
 out.println("");
@@ -717,8 +743,11 @@ out.println("    AMQ_CATCH_EXCEPTION_CONVERT( exceptions::ActiveMQException, dec
 out.println("    AMQ_CATCHALL_THROW(decaf::io::IOException)" );
 out.println("}");
 out.println("");
+    }
+
+    for( String dataInType : DATA_IN_TYPES ) {
 out.println("///////////////////////////////////////////////////////////////////////////////");
-out.println("void "+className+"::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {");
+out.println("void "+className+"::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, "+dataInType+"* dataIn) {");
 out.println("");
 out.println("    try {");
 out.println("");
@@ -752,8 +781,11 @@ out.println("    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, deca
 out.println("    AMQ_CATCHALL_THROW(decaf::io::IOException)" );
 out.println("}");
 out.println("");
+    }
+
+    for( String dataOutType : DATA_OUT_TYPES ) {
 out.println("///////////////////////////////////////////////////////////////////////////////");
-out.println("void "+className+"::looseMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut) {");
+out.println("void "+className+"::looseMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, "+dataOutType+"* dataOut) {");
 out.println("");
 out.println("    try {");
 out.println("");
@@ -788,6 +820,7 @@ out.println("    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, deca
 out.println("    AMQ_CATCHALL_THROW(decaf::io::IOException)" );
 out.println("}");
 out.println("");
+    }
 }
 
     public void generateFactory(PrintWriter out) {
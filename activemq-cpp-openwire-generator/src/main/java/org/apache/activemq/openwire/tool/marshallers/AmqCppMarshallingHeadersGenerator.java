@@ -35,6 +35,23 @@ import org.codehaus.jam.JProperty;
  */
 public class AmqCppMarshallingHeadersGenerator extends MultiSourceGenerator {
 
+    // Each stream bound method is emitted once per reader or writer type, the
+    // bodies are the same since both types offer the same read and write calls.
+    protected static final String[] DATA_IN_TYPES = { "DataInputStream", "ByteReader" };
+    protected static final String[] DATA_OUT_TYPES = { "DataOutputStream", "ByteWriter" };
+
+    /**
+     * Returns the namespace qualified name of one of the reader or writer
+     * types above for use in a header.
+     */
+    protected String getQualifiedDataType( String type ) {
+        if( type.startsWith("Data") ) {
+            return "decaf::io::" + type;
+        }
+
+        return "utils::" + type;
+    }
+
     protected String targetDir="./src/main";
     protected List<JClass> concreteClasses = new ArrayList<JClass>();
     protected File factoryFile;
@@ -271,28 +288,36 @@ out.println("");
 out.println("        virtual unsigned char getDataStructureType() const;");
 out.println("");
     }
+    for( String dataInType : DATA_IN_TYPES ) {
 out.println("        virtual void tightUnmarshal(OpenWireFormat* wireFormat,");
 out.println("                                    commands::DataStructure* dataStructure,");
-out.println("                                    decaf::io::DataInputStream* dataIn,");
+out.println("                                    "+getQualifiedDataType(dataInType)+"* dataIn,");
 out.println("                                    utils::BooleanStream* bs);");
 out.println("");
+    }
 out.println("        virtual int tightMarshal1(OpenWireFormat* wireFormat,");
 out.println("                                  commands::DataStructure* dataStructure,");
 out.println("                                  utils::BooleanStream* bs);");
 out.println("");
+    for( String dataOutType : DATA_OUT_TYPES ) {
 out.println("        virtual void tightMarshal2(OpenWireFormat* wireFormat,");
 out.println("                                   commands::DataStructure* dataStructure,");
-out.println("                                   decaf::io::DataOutputStream* dataOut,");
+out.println("                                   "+getQualifiedDataType(dataOutType)+"* dataOut,");
 out.println("                                   utils::BooleanStream* bs);");
 out.println("");
+    }
+    for( String dataInType : DATA_IN_TYPES ) {
 out.println("        virtual void looseUnmarshal(OpenWireFormat* wireFormat,");
 out.println("                                    commands::DataStructure* dataStructure,");
-out.println("                                    decaf::io::DataInputStream* dataIn);");
+out.println("                                    "+getQualifiedDataType(dataInType)+"* dataIn);");
 out.println("");
+    }
+    for( String dataOutType : DATA_OUT_TYPES ) {
 out.println("        virtual void looseMarshal(OpenWireFormat* wireFormat,");
 out.println("                                  commands::DataStructure* dataStructure,");
-out.println("                                  decaf::io::DataOutputStream* dataOut);");
+out.println("                                  "+getQualifiedDataType(dataOutType)+"* dataOut);");
 out.println("");
+    }
 out.println("    };");
 out.println("");
 out.println("}}}}}");
@@ -52,6 +52,14 @@ ActiveMQBlobMessage* ActiveMQBlobMessage::cloneDataStructure() const
     return message.release();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQBlobMessage* ActiveMQBlobMessage::cloneSharedDataStructure() const
+{
+    std::unique_ptr<ActiveMQBlobMessage> message(new ActiveMQBlobMessage());
+    message->copySharedDataStructure(this);
+    return message.release();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 cms::Message* ActiveMQBlobMessage::clone() const
 {
@@ -57,6 +57,8 @@ namespace commands
 
         virtual ActiveMQBlobMessage* cloneDataStructure() const;
 
+        virtual ActiveMQBlobMessage* cloneSharedDataStructure() const;
+
         virtual void copyDataStructure(const DataStructure* src);
 
         virtual std::string toString() const;
@@ -79,7 +79,8 @@ ActiveMQBytesMessage::ActiveMQBytesMessage()
       bytesOut(NULL),
       dataIn(),
       dataOut(),
-      length(0)
+      length(0),
+      inflatedBody()
 {
     this->clearBody();
 }
@@ -108,6 +109,14 @@ ActiveMQBytesMessage* ActiveMQBytesMessage::cloneDataStructure() const
     return message.release();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQBytesMessage* ActiveMQBytesMessage::cloneSharedDataStructure() const
+{
+    std::unique_ptr<ActiveMQBytesMessage> message(new ActiveMQBytesMessage());
+    message->copySharedDataStructure(this);
+    return message.release();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 cms::BytesMessage* ActiveMQBytesMessage::clone() const
 {
@@ -142,6 +151,7 @@ void ActiveMQBytesMessage::copyDataStructure(const DataStructure* src)
     nonConstSrc->storeContent();
 
     ActiveMQMessageTemplate<cms::BytesMessage>::copyDataStructure(src);
+    this->inflatedBody.reset(NULL);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -202,6 +212,61 @@ int ActiveMQBytesMessage::getBodyLength() const
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+std::pair<const unsigned char*, int> ActiveMQBytesMessage::getBodySpan() const
+{
+    this->failIfWriteOnlyBody();
+    try
+    {
+        const std::vector<unsigned char>* body = &this->getContent();
+
+        if (this->isCompressed())
+        {
+            if (this->inflatedBody.get() == NULL)
+            {
+                std::unique_ptr<std::vector<unsigned char>> buffer(
+                    new std::vector<unsigned char>());
+
+                if (!body->empty())
+                {
+                    try
+                    {
+                        InputStream* is = new ByteArrayInputStream(*body);
+                        DataInputStream dis(is, true);
+                        int             size = dis.readInt();
+
+                        if (size > 0)
+                        {
+                            InflaterInputStream inflater(is);
+                            DataInputStream     dataIn(&inflater);
+
+                            buffer->resize(size);
+                            dataIn.readFully(&(*buffer)[0], size);
+                        }
+                    }
+                    catch (IOException& ex)
+                    {
+                        throw CMSExceptionSupport::create(ex);
+                    }
+                }
+
+                this->inflatedBody.reset(buffer.release());
+            }
+
+            body = this->inflatedBody.get();
+        }
+
+        if (body->empty())
+        {
+            return std::pair<const unsigned char*, int>(NULL, 0);
+        }
+
+        return std::pair<const unsigned char*, int>(&(*body)[0],
+                                                    (int)body->size());
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQBytesMessage::clearBody()
 {
@@ -211,6 +276,7 @@ void ActiveMQBytesMessage::clearBody()
     this->dataOut.reset(NULL);
     this->bytesOut = NULL;
     this->dataIn.reset(NULL);
+    this->inflatedBody.reset(NULL);
     this->length = 0;
 }
 
@@ -230,6 +296,7 @@ void ActiveMQBytesMessage::reset()
         this->bytesOut = NULL;
         this->dataIn.reset(NULL);
         this->dataOut.reset(NULL);
+        this->inflatedBody.reset(NULL);
         this->length = 0;
         this->setReadOnlyBody(true);
     }
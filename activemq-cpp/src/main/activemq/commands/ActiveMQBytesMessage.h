@@ -26,6 +26,7 @@
 #include <decaf/io/DataOutputStream.h>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace activemq
@@ -58,6 +59,12 @@ namespace commands
          */
         mutable int length;
 
+        /**
+         * Inflated copy of a compressed body, built on demand for
+         * getBodySpan.
+         */
+        mutable std::unique_ptr<std::vector<unsigned char>> inflatedBody;
+
     public:
         const static unsigned char ID_ACTIVEMQBYTESMESSAGE;
 
@@ -74,6 +81,8 @@ namespace commands
 
         virtual ActiveMQBytesMessage* cloneDataStructure() const;
 
+        virtual ActiveMQBytesMessage* cloneSharedDataStructure() const;
+
         virtual void copyDataStructure(const DataStructure* src);
 
         virtual std::string toString() const;
@@ -150,6 +159,28 @@ namespace commands
 
         virtual void writeUTF(const std::string& value);
 
+    public:
+        /**
+         * Returns the message body without copying it.
+         *
+         * For an uncompressed body the pointer refers straight into the
+         * message content. A compressed body is inflated once into a buffer
+         * owned by this message and the pointer refers to that. The read
+         * position used by the read methods is not affected.
+         *
+         * The span is only valid while the message is alive and its body is
+         * not modified, any call to clearBody, reset or setContent
+         * invalidates it.
+         *
+         * @return a pointer to the first byte of the body and the body length,
+         *         the pointer is NULL when the body is empty.
+         *
+         * @throws MessageNotReadableException if the message is in write-only
+         *         mode.
+         * @throws CMSException if a compressed body cannot be inflated.
+         */
+        std::pair<const unsigned char*, int> getBodySpan() const;
+
     private:
         void storeContent();
 
@@ -73,6 +73,14 @@ ActiveMQMapMessage* ActiveMQMapMessage::cloneDataStructure() const
     return message;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQMapMessage* ActiveMQMapMessage::cloneSharedDataStructure() const
+{
+    ActiveMQMapMessage* message = new ActiveMQMapMessage();
+    message->copySharedDataStructure(this);
+    return message;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 cms::MapMessage* ActiveMQMapMessage::clone() const
 {
@@ -60,6 +60,8 @@ namespace commands
 
         virtual ActiveMQMapMessage* cloneDataStructure() const;
 
+        virtual ActiveMQMapMessage* cloneSharedDataStructure() const;
+
         virtual void copyDataStructure(const DataStructure* src);
 
         virtual void beforeMarshal(wireformat::WireFormat* wireFormat);
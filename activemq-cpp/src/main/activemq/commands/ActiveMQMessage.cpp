@@ -50,6 +50,14 @@ ActiveMQMessage* ActiveMQMessage::cloneDataStructure() const
     return message;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQMessage* ActiveMQMessage::cloneSharedDataStructure() const
+{
+    ActiveMQMessage* message = new ActiveMQMessage();
+    message->copySharedDataStructure(this);
+    return message;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 cms::Message* ActiveMQMessage::clone() const
 {
@@ -50,6 +50,8 @@ namespace commands
 
         virtual ActiveMQMessage* cloneDataStructure() const;
 
+        virtual ActiveMQMessage* cloneSharedDataStructure() const;
+
         virtual std::string toString() const;
 
         virtual bool equals(const DataStructure* value) const;
@@ -61,6 +61,14 @@ ActiveMQObjectMessage* ActiveMQObjectMessage::cloneDataStructure() const
     return message.release();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQObjectMessage* ActiveMQObjectMessage::cloneSharedDataStructure() const
+{
+    std::unique_ptr<ActiveMQObjectMessage> message(new ActiveMQObjectMessage());
+    message->copySharedDataStructure(this);
+    return message.release();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 cms::Message* ActiveMQObjectMessage::clone() const
 {
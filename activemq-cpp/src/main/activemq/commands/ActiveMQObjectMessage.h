@@ -49,6 +49,8 @@ namespace commands
 
         virtual ActiveMQObjectMessage* cloneDataStructure() const;
 
+        virtual ActiveMQObjectMessage* cloneSharedDataStructure() const;
+
         virtual void copyDataStructure(const DataStructure* src);
 
         virtual std::string toString() const;
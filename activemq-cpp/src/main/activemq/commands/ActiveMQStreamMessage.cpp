@@ -130,6 +130,14 @@ ActiveMQStreamMessage* ActiveMQStreamMessage::cloneDataStructure() const
     return message.release();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQStreamMessage* ActiveMQStreamMessage::cloneSharedDataStructure() const
+{
+    std::unique_ptr<ActiveMQStreamMessage> message(new ActiveMQStreamMessage());
+    message->copySharedDataStructure(this);
+    return message.release();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 cms::StreamMessage* ActiveMQStreamMessage::clone() const
 {
@@ -64,6 +64,8 @@ namespace commands
 
         virtual ActiveMQStreamMessage* cloneDataStructure() const;
 
+        virtual ActiveMQStreamMessage* cloneSharedDataStructure() const;
+
         virtual void copyDataStructure(const DataStructure* src);
 
         virtual std::string toString() const;
@@ -68,6 +68,14 @@ ActiveMQTextMessage* ActiveMQTextMessage::cloneDataStructure() const
     return message.release();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQTextMessage* ActiveMQTextMessage::cloneSharedDataStructure() const
+{
+    std::unique_ptr<ActiveMQTextMessage> message(new ActiveMQTextMessage());
+    message->copySharedDataStructure(this);
+    return message.release();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 cms::TextMessage* ActiveMQTextMessage::clone() const
 {
@@ -211,7 +219,9 @@ std::string ActiveMQTextMessage::getText() const
         }
         else
         {
-            if (this->getContent().size() <= 4)
+            // Content too short to hold the length prefix is truncated and
+            // left to readString32 to report.
+            if (this->getContent().empty())
             {
                 return "";
             }
@@ -243,6 +253,56 @@ std::string ActiveMQTextMessage::getText() const
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+std::string_view ActiveMQTextMessage::getTextView() const
+{
+    try
+    {
+        if (this->text.get() == NULL && !isCompressed())
+        {
+            const std::vector<unsigned char>& content = this->getContent();
+
+            if (content.empty())
+            {
+                return std::string_view();
+            }
+
+            if (content.size() >= 4)
+            {
+                // Same layout readString32 consumes, a big endian length
+                // followed by the raw bytes of the string.
+                int length = (int)(((unsigned int)content[0] << 24) |
+                                   ((unsigned int)content[1] << 16) |
+                                   ((unsigned int)content[2] << 8) |
+                                   (unsigned int)content[3]);
+
+                if (length <= 0)
+                {
+                    return std::string_view();
+                }
+
+                if ((std::size_t)length <= content.size() - 4)
+                {
+                    return std::string_view((const char*)&content[4],
+                                            (std::size_t)length);
+                }
+            }
+
+            // Truncated content, let getText report the failure.
+        }
+
+        getText();
+
+        if (this->text.get() == NULL)
+        {
+            return std::string_view();
+        }
+
+        return std::string_view(*(this->text));
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQTextMessage::setText(const char* msg)
 {
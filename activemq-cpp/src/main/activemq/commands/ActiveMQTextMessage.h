@@ -23,6 +23,7 @@
 #include <cms/TextMessage.h>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace activemq
@@ -51,6 +52,8 @@ namespace commands
 
         virtual ActiveMQTextMessage* cloneDataStructure() const;
 
+        virtual ActiveMQTextMessage* cloneSharedDataStructure() const;
+
         virtual void copyDataStructure(const DataStructure* src);
 
         virtual std::string toString() const;
@@ -72,6 +75,25 @@ namespace commands
         virtual void setText(const char* msg);
 
         virtual void setText(const std::string& msg);
+
+    public:
+        /**
+         * Returns a view of the message text without copying it.
+         *
+         * When the body is uncompressed marshaled content the view points
+         * straight into the content buffer, skipping the length prefix.
+         * Otherwise the text is decoded once into the same cache getText()
+         * uses and the view points at that.
+         *
+         * The view is only valid while the message is alive and its body is
+         * not modified, any call to setText, clearBody or setContent, or the
+         * marshaling of a message whose text was set locally, invalidates it.
+         *
+         * @return a view of the message text, empty if there is no body.
+         *
+         * @throws CMSException if the content cannot be decoded.
+         */
+        std::string_view getTextView() const;
     };
 
 }  // namespace commands
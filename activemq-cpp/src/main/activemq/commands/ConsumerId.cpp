@@ -21,6 +21,7 @@
 #include <decaf/internal/util/StringUtils.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
 #include <decaf/util/HashCode.h>
+#include <functional>
 #include <sstream>
 
 using namespace std;
@@ -47,7 +48,8 @@ ConsumerId::ConsumerId()
       connectionId(""),
       sessionId(0),
       value(0),
-      parentId()
+      parentId(),
+      parentIdOnce()
 {
 }
 
@@ -57,7 +59,8 @@ ConsumerId::ConsumerId(const ConsumerId& other)
       connectionId(""),
       sessionId(0),
       value(0),
-      parentId()
+      parentId(),
+      parentIdOnce()
 {
     this->copyDataStructure(&other);
 }
@@ -68,7 +71,8 @@ ConsumerId::ConsumerId(const SessionId& sessionId, long long consumerId)
       connectionId(""),
       sessionId(0),
       value(0),
-      parentId()
+      parentId(),
+      parentIdOnce()
 {
     this->connectionId = sessionId.getConnectionId();
     this->sessionId    = sessionId.getValue();
@@ -279,12 +283,28 @@ int ConsumerId::getHashCode() const
     return decaf::util::HashCode<std::string>()(this->toString());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+std::size_t ConsumerId::HASH::operator()(
+    const std::shared_ptr<ConsumerId>& id) const
+{
+    std::size_t hash = std::hash<long long>()(id->value);
+    return hash ^ (std::hash<long long>()(id->sessionId) + 0x9e3779b9 +
+                   (hash << 6) + (hash >> 2));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ConsumerId::EQUAL_TO::operator()(
+    const std::shared_ptr<ConsumerId>& left,
+    const std::shared_ptr<ConsumerId>& right) const
+{
+    return left->value == right->value && left->sessionId == right->sessionId &&
+           left->connectionId == right->connectionId;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 const std::shared_ptr<SessionId>& ConsumerId::getParentId() const
 {
-    if (this->parentId == NULL)
-    {
-        this->parentId.reset(new SessionId(this));
-    }
+    std::call_once(this->parentIdOnce,
+                   [this]() { this->parentId.reset(new SessionId(this)); });
     return this->parentId;
 }
@@ -29,6 +29,7 @@
 #include <activemq/util/SharedPtrComparator.h>
 #include <decaf/lang/Comparable.h>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -59,8 +60,27 @@ namespace commands
 
         typedef SharedPtrComparator<ConsumerId> COMPARATOR;
 
+        /**
+         * Hash and equality functors for unordered containers keyed on a
+         * std::shared_ptr<ConsumerId>.  Only the session id and the value are
+         * hashed, these are already unique among the consumers of a single
+         * connection so no string is hashed for each lookup.
+         */
+        struct HASH
+        {
+            std::size_t operator()(const std::shared_ptr<ConsumerId>& id) const;
+        };
+
+        struct EQUAL_TO
+        {
+            bool operator()(const std::shared_ptr<ConsumerId>& left,
+                            const std::shared_ptr<ConsumerId>& right) const;
+        };
+
     private:
+        // Built on first use, ids are shared across threads once interned.
         mutable std::shared_ptr<SessionId> parentId;
+        mutable std::once_flag             parentIdOnce;
 
     public:
         ConsumerId();
@@ -23,7 +23,9 @@
 #include <activemq/util/AMQLog.h>
 #include <activemq/wireformat/openwire/marshal/BaseDataStreamMarshaller.h>
 #include <activemq/wireformat/openwire/marshal/PrimitiveTypesMarshaller.h>
+#include <decaf/lang/Thread.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
+#include <algorithm>
 #include <chrono>
 
 using namespace std;
@@ -42,6 +44,19 @@ using namespace decaf::lang::exceptions;
  *
  */
 
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+// Returned for content and marshalled properties that were never set.
+const std::vector<unsigned char> EMPTY_BYTES;
+
+// Times a thread waiting for another's lazy property unmarshal yields before
+// it starts to sleep, the sleeps then double from 1us up to 256us.
+const int UNMARSHAL_WAIT_YIELDS = 16;
+
+}  // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 Message::Message()
     : BaseCommand(),
@@ -77,9 +92,12 @@ Message::Message()
       jMSXGroupFirstForConsumer(false),
       ackHandler(),
       properties(),
-      propertiesUnmarshaled(false),
+      propertiesState(PROPERTIES_MARSHALLED),
+      encodedPropertiesVersion(0),
+      propertiesDirty(false),
       readOnlyProperties(false),
       readOnlyBody(false),
+      shareBytesOnCopy(false),
       connection(NULL)
 {
 }
@@ -100,6 +118,32 @@ Message* Message::cloneDataStructure() const
     return message.release();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+Message* Message::cloneSharedDataStructure() const
+{
+    std::unique_ptr<Message> message(new Message());
+    message->copySharedDataStructure(this);
+    return message.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Message::copySharedDataStructure(const DataStructure* src)
+{
+    // The virtual copy runs the copies of every Message type in the chain,
+    // only the Message part needs to know that the bytes are shared.
+    this->shareBytesOnCopy = true;
+    try
+    {
+        this->copyDataStructure(src);
+    }
+    catch (...)
+    {
+        this->shareBytesOnCopy = false;
+        throw;
+    }
+    this->shareBytesOnCopy = false;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void Message::copyDataStructure(const DataStructure* src)
 {
@@ -137,8 +181,19 @@ void Message::copyDataStructure(const DataStructure* src)
     this->setReplyTo(srcPtr->getReplyTo());
     this->setTimestamp(srcPtr->getTimestamp());
     this->setType(srcPtr->getType());
-    this->setContent(srcPtr->getContent());
-    this->setMarshalledProperties(srcPtr->getMarshalledProperties());
+
+    bool shareBytes = this->shareBytesOnCopy;
+    if (shareBytes)
+    {
+        this->content              = srcPtr->content;
+        this->marshalledProperties = srcPtr->marshalledProperties;
+    }
+    else
+    {
+        this->setContent(srcPtr->getContent());
+        this->setMarshalledProperties(srcPtr->getMarshalledProperties());
+    }
+
     this->setDataStructure(srcPtr->getDataStructure());
     this->setTargetConsumerId(srcPtr->getTargetConsumerId());
     this->setCompressed(srcPtr->isCompressed());
@@ -161,9 +216,46 @@ void Message::copyDataStructure(const DataStructure* src)
     // 3. If properties map is empty, marshalledProperties stays empty
     // 4. Later unmarshal will fail to restore properties -> "Key does not exist
     // in map"
-    srcPtr->ensurePropertiesUnmarshaled();
-    this->properties.copy(srcPtr->properties);
-    this->propertiesUnmarshaled = true;
+    //
+    // A shared copy can leave the properties to be unmarshaled on first use
+    // as long as the source has not unmarshaled or set any of its own, the
+    // marshalled bytes then hold all of them.
+    //
+    // The source's map is only looked at while holding the same claim a lazy
+    // unmarshal takes, another thread may be filling it in otherwise.
+    bool shareProperties = false;
+    if (shareBytes)
+    {
+        int expected = PROPERTIES_MARSHALLED;
+        if (srcPtr->propertiesState.compare_exchange_strong(
+                expected,
+                PROPERTIES_UNMARSHALING,
+                std::memory_order_acquire))
+        {
+            shareProperties = srcPtr->properties.isEmpty();
+            srcPtr->propertiesState.store(PROPERTIES_MARSHALLED,
+                                          std::memory_order_release);
+        }
+    }
+
+    if (shareProperties)
+    {
+        this->properties.clear();
+        this->propertiesState.store(PROPERTIES_MARSHALLED,
+                                    std::memory_order_release);
+    }
+    else
+    {
+        srcPtr->ensurePropertiesUnmarshaled();
+        this->properties.copy(srcPtr->properties);
+        this->propertiesState.store(PROPERTIES_UNMARSHALED,
+                                    std::memory_order_release);
+    }
+
+    // The bytes came along with the properties, they are still current
+    // unless the source had changed its properties since encoding them.
+    this->propertiesDirty          = srcPtr->isPropertiesDirty();
+    this->encodedPropertiesVersion = this->properties.getModificationCount();
     this->setAckHandler(srcPtr->getAckHandler());
     this->setReadOnlyBody(srcPtr->isReadOnlyBody());
     this->setReadOnlyProperties(srcPtr->isReadOnlyProperties());
@@ -892,38 +984,53 @@ void Message::setType(const std::string& type)
 ////////////////////////////////////////////////////////////////////////////////
 const std::vector<unsigned char>& Message::getContent() const
 {
-    return content;
+    return content != NULL ? *content : EMPTY_BYTES;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 std::vector<unsigned char>& Message::getContent()
 {
-    return content;
+    // Bytes shared with another Message are copied before they can change.
+    if (content == NULL || content.use_count() > 1)
+    {
+        content.reset(new std::vector<unsigned char>(
+            content != NULL ? *content : EMPTY_BYTES));
+    }
+
+    return *content;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setContent(const std::vector<unsigned char>& content)
 {
-    this->content = content;
+    this->content.reset(new std::vector<unsigned char>(content));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 const std::vector<unsigned char>& Message::getMarshalledProperties() const
 {
-    return marshalledProperties;
+    return marshalledProperties != NULL ? *marshalledProperties : EMPTY_BYTES;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 std::vector<unsigned char>& Message::getMarshalledProperties()
 {
-    return marshalledProperties;
+    if (marshalledProperties == NULL || marshalledProperties.use_count() > 1)
+    {
+        marshalledProperties.reset(new std::vector<unsigned char>(
+            marshalledProperties != NULL ? *marshalledProperties
+                                         : EMPTY_BYTES));
+    }
+
+    return *marshalledProperties;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::setMarshalledProperties(
     const std::vector<unsigned char>& marshalledProperties)
 {
-    this->marshalledProperties = marshalledProperties;
+    this->marshalledProperties.reset(
+        new std::vector<unsigned char>(marshalledProperties));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1153,13 +1260,23 @@ void Message::beforeMarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED)
 {
     try
     {
-        marshalledProperties.clear();
+        // Unchanged properties, such as on a resend, a failover replay or a
+        // received Message passed on, keep the bytes already encoded.
+        if (!isPropertiesDirty() && marshalledProperties != NULL)
+        {
+            return;
+        }
+
+        marshalledProperties.reset();
         if (!properties.isEmpty())
         {
             wireformat::openwire::marshal::PrimitiveTypesMarshaller::marshal(
                 &properties,
-                marshalledProperties);
+                getMarshalledProperties());
         }
+
+        propertiesDirty          = false;
+        encodedPropertiesVersion = properties.getModificationCount();
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)
@@ -1172,34 +1289,76 @@ void Message::afterUnmarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED)
     // Lazy unmarshaling: defer property unmarshaling until first access
     // This allows corrupted properties to be detected when consumer accesses
     // them, enabling proper exception handling and redelivery mechanisms
-    propertiesUnmarshaled = false;
+    propertiesState.store(PROPERTIES_MARSHALLED, std::memory_order_release);
+    propertiesDirty          = false;
+    encodedPropertiesVersion = properties.getModificationCount();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Message::setEncodedProperties(const std::vector<unsigned char>& encoded)
+{
+    this->marshalledProperties.reset(new std::vector<unsigned char>(encoded));
+    this->properties.clear();
+    this->propertiesDirty          = false;
+    this->encodedPropertiesVersion = this->properties.getModificationCount();
+    this->propertiesState.store(PROPERTIES_MARSHALLED,
+                                std::memory_order_release);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Message::ensurePropertiesUnmarshaled() const
 {
-    // Fast path: already unmarshaled (no lock needed)
-    if (propertiesUnmarshaled)
+    // Fast path: already unmarshaled
+    if (propertiesState.load(std::memory_order_acquire) ==
+        PROPERTIES_UNMARSHALED)
     {
         return;
     }
 
-    // Thread-safe lazy unmarshaling with double-checked locking
-    synchronized(&propertiesUnmarshalMutex)
+    // Claim the unmarshal, a thread that loses the race waits for the winner
+    // rather than blocking on a lock, the window is a single decode.  The
+    // wait yields at first and then backs off to sleeps of growing length so
+    // that a slow decode does not keep the waiters' cores busy.
+    int expected = PROPERTIES_MARSHALLED;
+    int waits    = 0;
+    while (!propertiesState.compare_exchange_weak(expected,
+                                                  PROPERTIES_UNMARSHALING,
+                                                  std::memory_order_acquire,
+                                                  std::memory_order_acquire))
     {
-        // Check again inside lock (another thread may have unmarshaled)
-        if (propertiesUnmarshaled)
+        if (expected == PROPERTIES_UNMARSHALED)
         {
             return;
         }
 
-        // Skip unmarshaling if there are no marshalled properties
-        if (marshalledProperties.empty())
+        if (expected == PROPERTIES_UNMARSHALING)
         {
-            propertiesUnmarshaled = true;
-            return;
+            if (waits < UNMARSHAL_WAIT_YIELDS)
+            {
+                decaf::lang::Thread::yield();
+            }
+            else
+            {
+                int shift = std::min(waits - UNMARSHAL_WAIT_YIELDS, 8);
+                decaf::lang::Thread::sleep(0, 1000 << shift);
+            }
+
+            waits++;
         }
 
+        expected = PROPERTIES_MARSHALLED;
+    }
+
+    // Skip unmarshaling if there are no marshalled properties
+    if (getMarshalledProperties().empty())
+    {
+        propertiesState.store(PROPERTIES_UNMARSHALED,
+                              std::memory_order_release);
+        return;
+    }
+
+    try
+    {
         try
         {
             // Unmarshal properties from byte array (lazy unmarshaling)
@@ -1208,8 +1367,11 @@ void Message::ensurePropertiesUnmarshaled() const
             // trigger redelivery
             wireformat::openwire::marshal::PrimitiveTypesMarshaller::unmarshal(
                 const_cast<activemq::util::PrimitiveMap*>(&properties),
-                const_cast<std::vector<unsigned char>&>(marshalledProperties));
-            propertiesUnmarshaled = true;
+                const_cast<std::vector<unsigned char>&>(
+                    getMarshalledProperties()));
+            encodedPropertiesVersion = properties.getModificationCount();
+            propertiesState.store(PROPERTIES_UNMARSHALED,
+                                  std::memory_order_release);
         }
         catch (decaf::io::IOException& e)
         {
@@ -1219,7 +1381,7 @@ void Message::ensurePropertiesUnmarshaled() const
                 "(corrupted) for message id="
                     << (messageId ? messageId->toString() : "NULL")
                     << ", marshalledProperties.size="
-                    << marshalledProperties.size()
+                    << getMarshalledProperties().size()
                     << ", exception=" << e.getMessage());
             throw;
         }
@@ -1227,4 +1389,12 @@ void Message::ensurePropertiesUnmarshaled() const
                                     decaf::io::IOException)
         AMQ_CATCHALL_THROW(decaf::io::IOException)
     }
+    catch (...)
+    {
+        // Release the claim so the next access fails the same way and can be
+        // handled by the consumer again.
+        propertiesState.store(PROPERTIES_MARSHALLED,
+                              std::memory_order_release);
+        throw;
+    }
 }
@@ -34,7 +34,7 @@
 #include <activemq/core/ActiveMQAckHandler.h>
 #include <activemq/util/Config.h>
 #include <activemq/util/PrimitiveMap.h>
-#include <decaf/util/concurrent/Mutex.h>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -62,36 +62,36 @@ namespace commands
     class AMQCPP_API Message : public BaseCommand
     {
     protected:
-        std::shared_ptr<ProducerId>            producerId;
-        std::shared_ptr<ActiveMQDestination>   destination;
-        std::shared_ptr<TransactionId>         transactionId;
-        std::shared_ptr<ActiveMQDestination>   originalDestination;
-        std::shared_ptr<MessageId>             messageId;
-        std::shared_ptr<TransactionId>         originalTransactionId;
-        std::string                            groupID;
-        int                                    groupSequence;
-        std::string                            correlationId;
-        bool                                   persistent;
-        long long                              expiration;
-        unsigned char                          priority;
-        std::shared_ptr<ActiveMQDestination>   replyTo;
-        long long                              timestamp;
-        std::string                            type;
-        std::vector<unsigned char>             content;
-        std::vector<unsigned char>             marshalledProperties;
-        std::shared_ptr<DataStructure>         dataStructure;
-        std::shared_ptr<ConsumerId>            targetConsumerId;
-        bool                                   compressed;
-        int                                    redeliveryCounter;
-        std::vector<std::shared_ptr<BrokerId>> brokerPath;
-        long long                              arrival;
-        std::string                            userID;
-        bool                                   recievedByDFBridge;
-        bool                                   droppable;
-        std::vector<std::shared_ptr<BrokerId>> cluster;
-        long long                              brokerInTime;
-        long long                              brokerOutTime;
-        bool                                   jMSXGroupFirstForConsumer;
+        std::shared_ptr<ProducerId>                 producerId;
+        std::shared_ptr<ActiveMQDestination>        destination;
+        std::shared_ptr<TransactionId>              transactionId;
+        std::shared_ptr<ActiveMQDestination>        originalDestination;
+        std::shared_ptr<MessageId>                  messageId;
+        std::shared_ptr<TransactionId>              originalTransactionId;
+        std::string                                 groupID;
+        int                                         groupSequence;
+        std::string                                 correlationId;
+        bool                                        persistent;
+        long long                                   expiration;
+        unsigned char                               priority;
+        std::shared_ptr<ActiveMQDestination>        replyTo;
+        long long                                   timestamp;
+        std::string                                 type;
+        std::shared_ptr<std::vector<unsigned char>> content;
+        std::shared_ptr<std::vector<unsigned char>> marshalledProperties;
+        std::shared_ptr<DataStructure>              dataStructure;
+        std::shared_ptr<ConsumerId>                 targetConsumerId;
+        bool                                        compressed;
+        int                                         redeliveryCounter;
+        std::vector<std::shared_ptr<BrokerId>>      brokerPath;
+        long long                                   arrival;
+        std::string                                 userID;
+        bool                                        recievedByDFBridge;
+        bool                                        droppable;
+        std::vector<std::shared_ptr<BrokerId>>      cluster;
+        long long                                   brokerInTime;
+        long long                                   brokerOutTime;
+        bool                                        jMSXGroupFirstForConsumer;
 
     public:
         const static unsigned char ID_MESSAGE = 0;
@@ -105,12 +105,18 @@ namespace commands
         // Message Command's marshaledProperties vector.
         activemq::util::PrimitiveMap properties;
 
-        // Indicates if properties have been lazily unmarshaled from
-        // marshalledProperties
-        mutable bool propertiesUnmarshaled;
+        // State of the lazy unmarshal of properties from marshalledProperties,
+        // one of the PROPERTIES_* values.  Only the thread that moves it to
+        // PROPERTIES_UNMARSHALING writes the properties map.
+        mutable std::atomic<int> propertiesState;
 
-        // Mutex to protect thread-safe lazy unmarshaling of properties
-        mutable decaf::util::concurrent::Mutex propertiesUnmarshalMutex;
+        // Modification count of the properties when marshalledProperties
+        // last matched them, while unchanged a marshal reuses the bytes.
+        mutable int encodedPropertiesVersion;
+
+        // Set when the properties were copied from a Message whose bytes did
+        // not match its own properties.
+        bool propertiesDirty;
 
         // Indicates if the Message Properties are Read Only
         bool readOnlyProperties;
@@ -118,11 +124,29 @@ namespace commands
         // Indicates if the Message Body are Read Only
         bool readOnlyBody;
 
+        // Set while copySharedDataStructure fills in this Message.
+        bool shareBytesOnCopy;
+
     protected:
         core::ActiveMQConnection* connection;
 
         static const unsigned int DEFAULT_MESSAGE_SIZE = 1024;
 
+        static const int PROPERTIES_MARSHALLED   = 0;
+        static const int PROPERTIES_UNMARSHALING = 1;
+        static const int PROPERTIES_UNMARSHALED  = 2;
+
+        /**
+         * Copies the given Message into this one the way copyDataStructure
+         * does but shares the content and marshalled properties instead of
+         * copying them, the cloneSharedDataStructure of each Message type
+         * fills in its new instance with it.
+         *
+         * @param src
+         *      The Message to copy.
+         */
+        void copySharedDataStructure(const DataStructure* src);
+
     private:
         Message(const Message&);
         Message& operator=(const Message&);
@@ -135,7 +159,10 @@ namespace commands
          * this method throws an IOException which allows consumer code to
          * handle the error (e.g., trigger redelivery).
          *
-         * Thread-safe: uses double-checked locking pattern.
+         * Thread-safe without a lock: the first caller claims the unmarshal
+         * with an atomic state change and any concurrent caller waits until
+         * it completes, yielding at first and then sleeping for growing
+         * intervals.  Once unmarshaled only an acquire load is paid.
          *
          * @throws IOException if unmarshaling fails (corrupted properties)
          */
@@ -149,6 +176,18 @@ namespace commands
 
         virtual Message* cloneDataStructure() const;
 
+        /**
+         * Creates a copy of this Message that shares its content and its
+         * marshalled properties with this Message instead of copying them.
+         * The shared bytes are only copied if either Message is later
+         * modified, which makes this a cheap way to hand out a read only
+         * view of a received Message.
+         *
+         * @return a new Message of the same type as this one, the caller
+         * takes ownership of it.
+         */
+        virtual Message* cloneSharedDataStructure() const;
+
         virtual void copyDataStructure(const DataStructure* src);
 
         virtual std::string toString() const;
@@ -282,6 +321,27 @@ namespace commands
             return this->properties;
         }
 
+        /**
+         * Replaces all properties of this Message with an already encoded
+         * set, the bytes are sent as is and the in memory properties are
+         * decoded from them again on first access.
+         *
+         * @param encoded
+         *      The marshalled form of every property the Message should carry.
+         */
+        void setEncodedProperties(const std::vector<unsigned char>& encoded);
+
+        /**
+         * @return true if the properties have changed since they were last
+         *         marshalled, or since the marshalled form was received.
+         */
+        bool isPropertiesDirty() const
+        {
+            return this->propertiesDirty ||
+                   this->properties.getModificationCount() !=
+                       this->encodedPropertiesVersion;
+        }
+
         /**
          * Returns if the Message Properties Are Read Only
          * @return true if Message Properties are Read Only.
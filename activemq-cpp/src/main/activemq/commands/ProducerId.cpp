@@ -49,7 +49,8 @@ ProducerId::ProducerId()
       connectionId(""),
       value(0),
       sessionId(0),
-      parentId()
+      parentId(),
+      parentIdOnce()
 {
 }
 
@@ -59,7 +60,8 @@ ProducerId::ProducerId(const ProducerId& other)
       connectionId(""),
       value(0),
       sessionId(0),
-      parentId()
+      parentId(),
+      parentIdOnce()
 {
     this->copyDataStructure(&other);
 }
@@ -70,7 +72,8 @@ ProducerId::ProducerId(const SessionId& sessionId, long long consumerId)
       connectionId(""),
       value(0),
       sessionId(0),
-      parentId()
+      parentId(),
+      parentIdOnce()
 {
     this->connectionId = sessionId.getConnectionId();
     this->sessionId    = sessionId.getValue();
@@ -83,7 +86,8 @@ ProducerId::ProducerId(std::string producerKey)
       connectionId(""),
       value(0),
       sessionId(0),
-      parentId()
+      parentId(),
+      parentIdOnce()
 {
     // Parse off the producerId
     std::size_t p = producerKey.rfind(':');
@@ -319,10 +323,8 @@ int ProducerId::getHashCode() const
 ////////////////////////////////////////////////////////////////////////////////
 const std::shared_ptr<SessionId>& ProducerId::getParentId() const
 {
-    if (!this->parentId)
-    {
-        this->parentId.reset(new SessionId(this));
-    }
+    std::call_once(this->parentIdOnce,
+                   [this]() { this->parentId.reset(new SessionId(this)); });
     return this->parentId;
 }
 
@@ -29,6 +29,7 @@
 #include <activemq/util/SharedPtrComparator.h>
 #include <decaf/lang/Comparable.h>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -60,7 +61,9 @@ namespace commands
         typedef SharedPtrComparator<ProducerId> COMPARATOR;
 
     private:
+        // Built on first use, ids are shared across threads once interned.
         mutable std::shared_ptr<SessionId> parentId;
+        mutable std::once_flag             parentIdOnce;
 
     public:
         ProducerId();
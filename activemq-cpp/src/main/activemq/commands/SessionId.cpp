@@ -49,7 +49,8 @@ SessionId::SessionId()
     : BaseDataStructure(),
       connectionId(""),
       value(0),
-      parentId()
+      parentId(),
+      parentIdOnce()
 {
 }
 
@@ -58,7 +59,8 @@ SessionId::SessionId(const SessionId& other)
     : BaseDataStructure(),
       connectionId(""),
       value(0),
-      parentId()
+      parentId(),
+      parentIdOnce()
 {
     this->copyDataStructure(&other);
 }
@@ -68,7 +70,8 @@ SessionId::SessionId(const ConnectionId* connectionId, long long sessionId)
     : BaseDataStructure(),
       connectionId(""),
       value(0),
-      parentId()
+      parentId(),
+      parentIdOnce()
 {
     this->connectionId = connectionId->getValue();
     this->value        = sessionId;
@@ -79,7 +82,8 @@ SessionId::SessionId(const ProducerId* producerId)
     : BaseDataStructure(),
       connectionId(""),
       value(0),
-      parentId()
+      parentId(),
+      parentIdOnce()
 {
     this->connectionId = producerId->getConnectionId();
     this->value        = producerId->getSessionId();
@@ -90,7 +94,8 @@ SessionId::SessionId(const ConsumerId* consumerId)
     : BaseDataStructure(),
       connectionId(""),
       value(0),
-      parentId()
+      parentId(),
+      parentIdOnce()
 {
     this->connectionId = consumerId->getConnectionId();
     this->value        = consumerId->getSessionId();
@@ -276,9 +281,7 @@ int SessionId::getHashCode() const
 ////////////////////////////////////////////////////////////////////////////////
 const std::shared_ptr<ConnectionId>& SessionId::getParentId() const
 {
-    if (this->parentId == NULL)
-    {
-        this->parentId.reset(new ConnectionId(this));
-    }
+    std::call_once(this->parentIdOnce,
+                   [this]() { this->parentId.reset(new ConnectionId(this)); });
     return this->parentId;
 }
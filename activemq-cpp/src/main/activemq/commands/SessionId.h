@@ -29,6 +29,7 @@
 #include <activemq/util/SharedPtrComparator.h>
 #include <decaf/lang/Comparable.h>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -62,7 +63,9 @@ namespace commands
         typedef SharedPtrComparator<SessionId> COMPARATOR;
 
     private:
+        // Built on first use, ids are shared across threads once interned.
         mutable std::shared_ptr<ConnectionId> parentId;
+        mutable std::once_flag                parentIdOnce;
 
     public:
         SessionId();
@@ -279,7 +279,7 @@ bool WireFormatInfo::isCacheEnabled() const
 {
     try
     {
-        return false;
+        return properties.getBool("CacheEnabled");
     }
     AMQ_CATCH_NOTHROW(exceptions::ActiveMQException)
     AMQ_CATCHALL_NOTHROW()
@@ -288,12 +288,11 @@ bool WireFormatInfo::isCacheEnabled() const
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void WireFormatInfo::setCacheEnabled(bool cacheEnabled AMQCPP_UNUSED)
+void WireFormatInfo::setCacheEnabled(bool cacheEnabled)
 {
     try
     {
-        // Turning this on is not supported as it causes the client to not work.
-        properties.setBool("CacheEnabled", false);
+        properties.setBool("CacheEnabled", cacheEnabled);
     }
     AMQ_CATCH_NOTHROW(exceptions::ActiveMQException)
     AMQ_CATCHALL_NOTHROW()
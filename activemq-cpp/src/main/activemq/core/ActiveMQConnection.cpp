@@ -44,6 +44,8 @@
 #include <decaf/lang/Boolean.h>
 #include <decaf/lang/Integer.h>
 #include <decaf/lang/Math.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
 #include <decaf/util/Collection.h>
 #include <decaf/util/Iterator.h>
 #include <decaf/util/LinkedList.h>
@@ -56,6 +58,7 @@
 #include <decaf/util/concurrent/TimeUnit.h>
 #include <decaf/util/concurrent/locks/ReentrantReadWriteLock.h>
 #include <atomic>
+#include <unordered_map>
 
 #include <activemq/commands/ActiveMQMessage.h>
 #include <activemq/commands/BrokerError.h>
@@ -104,11 +107,13 @@ namespace core
     class ConnectionThreadFactory : public ThreadFactory
     {
     private:
+        std::string prefix;
         std::string connectionId;
 
     public:
-        ConnectionThreadFactory(std::string connectionId)
-            : connectionId(connectionId)
+        ConnectionThreadFactory(std::string prefix, std::string connectionId)
+            : prefix(prefix),
+              connectionId(connectionId)
         {
             if (connectionId.empty())
             {
@@ -124,8 +129,6 @@ namespace core
 
         virtual Thread* newThread(decaf::lang::Runnable* runnable)
         {
-            static std::string prefix = "ActiveMQ Connection Executor: ";
-
             std::string name   = prefix + connectionId;
             Thread*     thread = new Thread(runnable, name);
             return thread;
@@ -139,11 +142,18 @@ namespace core
         ConnectionConfig& operator=(const ConnectionConfig&);
 
     public:
-        typedef decaf::util::StlMap<std::shared_ptr<commands::ConsumerId>,
-                                    Dispatcher*,
-                                    commands::ConsumerId::COMPARATOR>
+        typedef std::unordered_map<std::shared_ptr<commands::ConsumerId>,
+                                   Dispatcher*,
+                                   commands::ConsumerId::HASH,
+                                   commands::ConsumerId::EQUAL_TO>
             DispatcherMap;
 
+        typedef std::unordered_multimap<std::shared_ptr<commands::ConsumerId>,
+                                        Thread*,
+                                        commands::ConsumerId::HASH,
+                                        commands::ConsumerId::EQUAL_TO>
+            DispatchingMap;
+
         typedef decaf::util::StlMap<std::shared_ptr<commands::ProducerId>,
                                     std::shared_ptr<ActiveMQProducerKernel>,
                                     commands::ProducerId::COMPARATOR>
@@ -164,6 +174,7 @@ namespace core
         std::shared_ptr<util::IdGenerator>       clientIdGenerator;
         std::shared_ptr<Scheduler>               scheduler;
         std::shared_ptr<ExecutorService>         executor;
+        std::shared_ptr<ExecutorService>         sessionTaskRunnerPool;
 
         util::LongSequenceGenerator sessionIds;
         util::LongSequenceGenerator consumerIdGenerator;
@@ -205,9 +216,15 @@ namespace core
         int          auditMaximumProducerNumber;
         long long    optimizeAcknowledgeTimeOut;
         long long    optimizedAckScheduledAckInterval;
+        int          ackBatchSize;
+        long long    ackBatchTimeOut;
         long long    consumerFailoverRedeliveryWaitPeriod;
         bool         consumerExpiryCheckEnabled;
         bool         advisoryConsumerDispatchAsync;
+        bool         copyMessageOnSend;
+        bool         useDedicatedTaskRunner;
+        int          maxThreadPoolSize;
+        bool         useLockFreeDispatch;
 
         std::unique_ptr<PrefetchPolicy>   defaultPrefetchPolicy;
         std::unique_ptr<RedeliveryPolicy> defaultRedeliveryPolicy;
@@ -226,8 +243,13 @@ namespace core
 
         std::shared_ptr<Exception> firstFailureError;
 
-        DispatcherMap dispatchers;
-        ProducerMap   activeProducers;
+        // The dispatchers are guarded by dispatchersMutex, which is not held
+        // while a message is dispatched.  Each running dispatch is recorded in
+        // dispatching with its thread so removeDispatcher can wait for it.
+        Mutex          dispatchersMutex;
+        DispatcherMap  dispatchers;
+        DispatchingMap dispatching;
+        ProducerMap    activeProducers;
 
         decaf::util::concurrent::locks::ReentrantReadWriteLock sessionsLock;
         decaf::util::LinkedList<std::shared_ptr<ActiveMQSessionKernel>>
@@ -247,6 +269,7 @@ namespace core
               clientIdGenerator(),
               scheduler(),
               executor(),
+              sessionTaskRunnerPool(),
               sessionIds(),
               consumerIdGenerator(),
               tempDestinationIds(),
@@ -284,9 +307,15 @@ namespace core
                   ActiveMQMessageAudit::MAXIMUM_PRODUCER_COUNT),
               optimizeAcknowledgeTimeOut(300),
               optimizedAckScheduledAckInterval(0),
+              ackBatchSize(0),
+              ackBatchTimeOut(1000),
               consumerFailoverRedeliveryWaitPeriod(0),
               consumerExpiryCheckEnabled(true),
               advisoryConsumerDispatchAsync(true),
+              copyMessageOnSend(true),
+              useDedicatedTaskRunner(true),
+              maxThreadPoolSize(System::availableProcessors()),
+              useLockFreeDispatch(false),
               defaultPrefetchPolicy(nullptr),
               defaultRedeliveryPolicy(nullptr),
               exceptionListener(nullptr),
@@ -298,7 +327,9 @@ namespace core
               brokerInfoReceived(),
               advisoryConsumer(),
               firstFailureError(),
+              dispatchersMutex(),
               dispatchers(),
+              dispatching(),
               activeProducers(),
               sessionsLock(),
               activeSessions(),
@@ -326,7 +357,8 @@ namespace core
                 5,
                 TimeUnit::SECONDS,
                 new LinkedBlockingQueue<Runnable*>(),
-                new ConnectionThreadFactory(connectionId->toString())));
+                new ConnectionThreadFactory("ActiveMQ Connection Executor: ",
+                                            connectionId->toString())));
 
             this->connectionInfo->setConnectionId(connectionId);
             this->scheduler.reset(new Scheduler(
@@ -343,6 +375,13 @@ namespace core
                     this->scheduler->shutdown();
                     this->executor->shutdown();
                     this->executor->awaitTermination(10, TimeUnit::MINUTES);
+                    if (this->sessionTaskRunnerPool != nullptr)
+                    {
+                        this->sessionTaskRunnerPool->shutdown();
+                        this->sessionTaskRunnerPool->awaitTermination(
+                            10,
+                            TimeUnit::MINUTES);
+                    }
                 }
             }
             AMQ_CATCHALL_NOTHROW()
@@ -352,6 +391,45 @@ namespace core
         {
             this->brokerInfoReceived->await();
         }
+
+        // Must be called with the dispatchersMutex held, returns true if any
+        // thread other than the given one is dispatching to the consumer.
+        bool isDispatching(const std::shared_ptr<ConsumerId>& consumer,
+                           Thread*                            current) const
+        {
+            std::pair<DispatchingMap::const_iterator,
+                      DispatchingMap::const_iterator>
+                range = this->dispatching.equal_range(consumer);
+            for (; range.first != range.second; ++range.first)
+            {
+                if (range.first->second != current)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void endDispatch(const std::shared_ptr<ConsumerId>& consumer,
+                         Thread*                            current)
+        {
+            synchronized(&this->dispatchersMutex)
+            {
+                std::pair<DispatchingMap::iterator, DispatchingMap::iterator>
+                    range = this->dispatching.equal_range(consumer);
+                for (; range.first != range.second; ++range.first)
+                {
+                    if (range.first->second == current)
+                    {
+                        this->dispatching.erase(range.first);
+                        break;
+                    }
+                }
+
+                this->dispatchersMutex.notifyAll();
+            }
+        }
     };
 
     // Static init.
@@ -646,9 +724,9 @@ void ActiveMQConnection::addDispatcher(
 {
     try
     {
-        synchronized(&this->config->dispatchers)
+        synchronized(&this->config->dispatchersMutex)
         {
-            this->config->dispatchers.put(consumer, dispatcher);
+            this->config->dispatchers[consumer] = dispatcher;
         }
     }
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
@@ -660,9 +738,16 @@ void ActiveMQConnection::removeDispatcher(
 {
     try
     {
-        synchronized(&this->config->dispatchers)
+        // Once removed no new dispatch can start, wait for any that another
+        // thread is still running so the caller can dispose of the consumer.
+        Thread* current = Thread::currentThread();
+        synchronized(&this->config->dispatchersMutex)
         {
-            this->config->dispatchers.remove(consumer);
+            this->config->dispatchers.erase(consumer);
+            while (this->config->isDispatching(consumer, current))
+            {
+                this->config->dispatchersMutex.wait();
+            }
         }
     }
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
@@ -1046,6 +1131,15 @@ void ActiveMQConnection::close()
             {
                 this->config->executor->shutdown();
             }
+
+            // The sessions are all disposed so none of their tasks remain.
+            synchronized(&this->config->mutex)
+            {
+                if (this->config->sessionTaskRunnerPool != nullptr)
+                {
+                    this->config->sessionTaskRunnerPool->shutdown();
+                }
+            }
         }
         catch (Exception& error)
         {
@@ -1402,16 +1496,28 @@ void ActiveMQConnection::onCommand(const std::shared_ptr<Command> command)
             // Check first to see if we are recovering.
             waitForTransportInterruptionProcessingToComplete();
 
-            // Look up the dispatcher.
+            // Look up the dispatcher, the lock is released before dispatching
+            // so that consumers can be added and removed in the meantime.
+            const std::shared_ptr<ConsumerId>& consumerId =
+                dispatch->getConsumerId();
+            Thread*     current    = Thread::currentThread();
             Dispatcher* dispatcher = nullptr;
-            synchronized(&this->config->dispatchers)
+            synchronized(&this->config->dispatchersMutex)
             {
-                dispatcher =
-                    this->config->dispatchers.get(dispatch->getConsumerId());
+                ConnectionConfig::DispatcherMap::const_iterator iter =
+                    this->config->dispatchers.find(consumerId);
+                if (iter != this->config->dispatchers.end())
+                {
+                    dispatcher = iter->second;
+                    this->config->dispatching.emplace(consumerId, current);
+                }
+            }
 
-                // If we have no registered dispatcher, the consumer was
-                // probably just closed.
-                if (dispatcher != nullptr)
+            // If we have no registered dispatcher, the consumer was probably
+            // just closed.
+            if (dispatcher != nullptr)
+            {
+                try
                 {
                     std::shared_ptr<commands::Message> message =
                         dispatch->getMessage();
@@ -1428,6 +1534,13 @@ void ActiveMQConnection::onCommand(const std::shared_ptr<Command> command)
 
                     dispatcher->dispatch(dispatch);
                 }
+                catch (...)
+                {
+                    this->config->endDispatch(consumerId, current);
+                    throw;
+                }
+
+                this->config->endDispatch(consumerId, current);
             }
         }
         else if (command->isProducerAck())
@@ -1671,7 +1784,7 @@ void ActiveMQConnection::transportResumed()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ActiveMQConnection::oneway(std::shared_ptr<Command> command)
+void ActiveMQConnection::oneway(const std::shared_ptr<Command>& command)
 {
     try
     {
@@ -2430,6 +2543,30 @@ void ActiveMQConnection::setOptimizedAckScheduledAckInterval(
         optimizedAckScheduledAckInterval;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConnection::getAckBatchSize() const
+{
+    return this->config->ackBatchSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setAckBatchSize(int ackBatchSize)
+{
+    this->config->ackBatchSize = ackBatchSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ActiveMQConnection::getAckBatchTimeOut() const
+{
+    return this->config->ackBatchTimeOut;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setAckBatchTimeOut(long long ackBatchTimeOut)
+{
+    this->config->ackBatchTimeOut = ackBatchTimeOut;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 long long ActiveMQConnection::getConsumerFailoverRedeliveryWaitPeriod() const
 {
@@ -2658,3 +2795,82 @@ void ActiveMQConnection::setConsumerExpiryCheckEnabled(
 {
     this->config->consumerExpiryCheckEnabled = consumerExpiryCheckEnabled;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnection::isUseDedicatedTaskRunner() const
+{
+    return this->config->useDedicatedTaskRunner;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setUseDedicatedTaskRunner(bool useDedicatedTaskRunner)
+{
+    this->config->useDedicatedTaskRunner = useDedicatedTaskRunner;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConnection::getMaxThreadPoolSize() const
+{
+    return this->config->maxThreadPoolSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setMaxThreadPoolSize(int maxThreadPoolSize)
+{
+    if (maxThreadPoolSize <= 0)
+    {
+        throw IllegalArgumentException(
+            __FILE__,
+            __LINE__,
+            "The max thread pool size must be greater than zero.");
+    }
+
+    this->config->maxThreadPoolSize = maxThreadPoolSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnection::isUseLockFreeDispatch() const
+{
+    return this->config->useLockFreeDispatch;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setUseLockFreeDispatch(bool useLockFreeDispatch)
+{
+    this->config->useLockFreeDispatch = useLockFreeDispatch;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<ExecutorService> ActiveMQConnection::getSessionTaskRunnerPool()
+{
+    synchronized(&this->config->mutex)
+    {
+        if (this->config->sessionTaskRunnerPool == nullptr)
+        {
+            this->config->sessionTaskRunnerPool.reset(new ThreadPoolExecutor(
+                this->config->maxThreadPoolSize,
+                this->config->maxThreadPoolSize,
+                5,
+                TimeUnit::SECONDS,
+                new LinkedBlockingQueue<Runnable*>(),
+                new ConnectionThreadFactory(
+                    "ActiveMQ Session Task: ",
+                    this->config->connectionInfo->getConnectionId()
+                        ->toString())));
+        }
+    }
+
+    return this->config->sessionTaskRunnerPool;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnection::isCopyMessageOnSend() const
+{
+    return this->config->copyMessageOnSend;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setCopyMessageOnSend(bool copyMessageOnSend)
+{
+    this->config->copyMessageOnSend = copyMessageOnSend;
+}
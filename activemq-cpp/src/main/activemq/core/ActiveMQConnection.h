@@ -857,6 +857,44 @@ namespace core
         void setOptimizedAckScheduledAckInterval(
             long long optimizedAckScheduledAckInterval);
 
+        /**
+         * Gets the number of auto acknowledged Messages a Session holds back
+         * before it sends their acks as one range ack per consumer.
+         *
+         * @return the ack batch size, zero when acks are not batched.
+         */
+        int getAckBatchSize() const;
+
+        /**
+         * Sets the number of Messages consumed across all the consumers of an
+         * AUTO_ACKNOWLEDGE Session whose acks are held back and then sent as
+         * one range ack per consumer.  A consumer also sends its held acks
+         * once half its prefetch is waiting on them.  Zero, the default, acks
+         * every Message as it is consumed.  Applies to Sessions created
+         * after the call.
+         *
+         * @param ackBatchSize
+         *      The number of Messages to hold before sending their acks.
+         */
+        void setAckBatchSize(int ackBatchSize);
+
+        /**
+         * Gets the longest time the acks for a consumed Message are held
+         * back, in microseconds.
+         *
+         * @return the ack batch time out in microseconds.
+         */
+        long long getAckBatchTimeOut() const;
+
+        /**
+         * Sets the longest time in microseconds the first ack in a batch is
+         * held back before the batch is sent even though it isn't full.
+         *
+         * @param ackBatchTimeOut
+         *      The time out in microseconds for a batch of acks.
+         */
+        void setAckBatchTimeOut(long long ackBatchTimeOut);
+
         /**
          * Should all created consumers be retroactive.
          *
@@ -942,6 +980,96 @@ namespace core
          */
         void setConsumerExpiryCheckEnabled(bool consumerExpiryCheckEnabled);
 
+        /**
+         * @return true if Messages are copied before being sent, this is the
+         * default.
+         */
+        bool isCopyMessageOnSend() const;
+
+        /**
+         * Configures whether a Message is copied before it is sent.  When
+         * disabled a Message that is already an ActiveMQ Message is sent as
+         * is, and the application must not modify or delete it until the send
+         * call returns, or for an asynchronous send until its AsyncCallback is
+         * called.  Producers can override this with the destination option
+         * producer.copyMessageOnSend.
+         *
+         * Sending in place modifies the application's Message: the send sets
+         * its message id, destination, producer id and transaction id,
+         * clears its broker path and makes its body and properties read
+         * only, just as it would for the copy.  The same Message can be sent
+         * again as it is, each send gives it a new message id; to change it
+         * between sends call clearBody or clearProperties first.
+         *
+         * @param copyMessageOnSend
+         *      False if Messages should be sent without being copied.
+         */
+        void setCopyMessageOnSend(bool copyMessageOnSend);
+
+        /**
+         * @return true if each asynchronous Session dispatches its messages
+         * from a Thread of its own, this is the default.
+         */
+        bool isUseDedicatedTaskRunner() const;
+
+        /**
+         * Configures how asynchronous Sessions dispatch their messages.  When
+         * enabled each Session starts a Thread of its own.  When disabled the
+         * Sessions share a pool of at most maxThreadPoolSize Threads, each
+         * Session is still dispatched by only one Thread at a time so the
+         * message order within a Session is kept.
+         *
+         * @param useDedicatedTaskRunner
+         *      False if Sessions should share a pool of dispatch Threads.
+         */
+        void setUseDedicatedTaskRunner(bool useDedicatedTaskRunner);
+
+        /**
+         * @return the number of Threads in the pool shared by the Sessions
+         * when useDedicatedTaskRunner is disabled.
+         */
+        int getMaxThreadPoolSize() const;
+
+        /**
+         * Sets the number of Threads in the pool shared by the Sessions when
+         * useDedicatedTaskRunner is disabled, defaults to the number of
+         * available processors.  Only applies if set before the pool is
+         * first used.
+         *
+         * @param maxThreadPoolSize
+         *      The number of Threads in the pool, must be greater than zero.
+         *
+         * @throws IllegalArgumentException if the size is not positive.
+         */
+        void setMaxThreadPoolSize(int maxThreadPoolSize);
+
+        /**
+         * @return true if Sessions and Consumers queue the messages dispatched
+         * to them in lock free channels.
+         */
+        bool isUseLockFreeDispatch() const;
+
+        /**
+         * Sets whether the Sessions and Consumers of this Connection
+         * queue the messages dispatched to them in lock free ring backed
+         * channels instead of the default locked lists.  The rings are sized
+         * to the Consumer's prefetch and spill to a locked list when full.
+         * Only applies to Sessions and Consumers created after it is set.
+         *
+         * @param useLockFreeDispatch
+         *      True if the lock free dispatch channels should be used.
+         */
+        void setUseLockFreeDispatch(bool useLockFreeDispatch);
+
+        /**
+         * Gets the pool of Threads shared by the Sessions of this Connection,
+         * the pool is created the first time this is called.
+         *
+         * @return the pool that runs the Sessions' dispatch tasks.
+         */
+        std::shared_ptr<decaf::util::concurrent::ExecutorService>
+        getSessionTaskRunnerPool();
+
         /**
          * @return the current connection's OpenWire protocol version.
          */
@@ -1060,7 +1188,7 @@ namespace core
          * @throws ActiveMQException if not currently connected, or if the
          * operation fails for any reason.
          */
-        void oneway(std::shared_ptr<commands::Command> command);
+        void oneway(const std::shared_ptr<commands::Command>& command);
 
         /**
          * Sends a synchronous request and returns the response from the broker.
@@ -30,6 +30,8 @@
 #include <decaf/lang/Integer.h>
 #include <decaf/lang/Long.h>
 #include <decaf/lang/Math.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
 #include <decaf/net/URI.h>
 #include <decaf/util/Properties.h>
@@ -102,9 +104,15 @@ namespace core
         int          auditMaximumProducerNumber;
         long long    optimizeAcknowledgeTimeOut;
         long long    optimizedAckScheduledAckInterval;
+        int          ackBatchSize;
+        long long    ackBatchTimeOut;
         long long    consumerFailoverRedeliveryWaitPeriod;
         bool         consumerExpiryCheckEnabled;
         bool         advisoryConsumerDispatchAsync;
+        bool         copyMessageOnSend;
+        bool         useDedicatedTaskRunner;
+        int          maxThreadPoolSize;
+        bool         useLockFreeDispatch;
 
         cms::ExceptionListener*           defaultListener;
         cms::MessageTransformer*          defaultTransformer;
@@ -144,9 +152,15 @@ namespace core
                   ActiveMQMessageAudit::MAXIMUM_PRODUCER_COUNT),
               optimizeAcknowledgeTimeOut(300),
               optimizedAckScheduledAckInterval(0),
+              ackBatchSize(0),
+              ackBatchTimeOut(1000),
               consumerFailoverRedeliveryWaitPeriod(0),
               consumerExpiryCheckEnabled(true),
               advisoryConsumerDispatchAsync(true),
+              copyMessageOnSend(true),
+              useDedicatedTaskRunner(true),
+              maxThreadPoolSize(System::availableProcessors()),
+              useLockFreeDispatch(false),
               defaultListener(nullptr),
               defaultTransformer(nullptr),
               defaultPrefetchPolicy(new DefaultPrefetchPolicy()),
@@ -287,6 +301,12 @@ namespace core
                 std::stoll(properties->getProperty(
                     "connection.optimizedAckScheduledAckInterval",
                     std::to_string(optimizedAckScheduledAckInterval)));
+            this->ackBatchSize = std::stoi(
+                properties->getProperty("connection.ackBatchSize",
+                                        std::to_string(ackBatchSize)));
+            this->ackBatchTimeOut = std::stoll(
+                properties->getProperty("connection.ackBatchTimeOut",
+                                        std::to_string(ackBatchTimeOut)));
             this->consumerFailoverRedeliveryWaitPeriod =
                 std::stoll(properties->getProperty(
                     "connection.consumerFailoverRedeliveryWaitPeriod",
@@ -306,6 +326,20 @@ namespace core
                 Boolean::parseBoolean(properties->getProperty(
                     "connection.consumerExpiryCheckEnabled",
                     Boolean::toString(consumerExpiryCheckEnabled)));
+            this->copyMessageOnSend = Boolean::parseBoolean(
+                properties->getProperty("connection.copyMessageOnSend",
+                                        Boolean::toString(copyMessageOnSend)));
+            this->useDedicatedTaskRunner =
+                Boolean::parseBoolean(properties->getProperty(
+                    "connection.useDedicatedTaskRunner",
+                    Boolean::toString(useDedicatedTaskRunner)));
+            this->maxThreadPoolSize = Integer::parseInt(
+                properties->getProperty("connection.maxThreadPoolSize",
+                                        Integer::toString(maxThreadPoolSize)));
+            this->useLockFreeDispatch =
+                Boolean::parseBoolean(properties->getProperty(
+                    "connection.useLockFreeDispatch",
+                    Boolean::toString(useLockFreeDispatch)));
 
             this->defaultPrefetchPolicy->configure(*properties);
             this->defaultRedeliveryPolicy->configure(*properties);
@@ -565,6 +599,8 @@ void ActiveMQConnectionFactory::configureConnection(
         this->settings->optimizeAcknowledgeTimeOut);
     connection->setOptimizedAckScheduledAckInterval(
         this->settings->optimizedAckScheduledAckInterval);
+    connection->setAckBatchSize(this->settings->ackBatchSize);
+    connection->setAckBatchTimeOut(this->settings->ackBatchTimeOut);
     connection->setSendAcksAsync(this->settings->sendAcksAsync);
     connection->setExclusiveConsumer(this->settings->exclusiveConsumer);
     connection->setTransactedIndividualAck(
@@ -577,6 +613,11 @@ void ActiveMQConnectionFactory::configureConnection(
     connection->setAlwaysSessionAsync(this->settings->alwaysSessionAsync);
     connection->setConsumerExpiryCheckEnabled(
         this->settings->consumerExpiryCheckEnabled);
+    connection->setCopyMessageOnSend(this->settings->copyMessageOnSend);
+    connection->setUseDedicatedTaskRunner(
+        this->settings->useDedicatedTaskRunner);
+    connection->setMaxThreadPoolSize(this->settings->maxThreadPoolSize);
+    connection->setUseLockFreeDispatch(this->settings->useLockFreeDispatch);
 
     if (this->settings->defaultListener)
     {
@@ -984,6 +1025,30 @@ void ActiveMQConnectionFactory::setOptimizedAckScheduledAckInterval(
         optimizedAckScheduledAckInterval;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConnectionFactory::getAckBatchSize() const
+{
+    return this->settings->ackBatchSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setAckBatchSize(int ackBatchSize)
+{
+    this->settings->ackBatchSize = ackBatchSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ActiveMQConnectionFactory::getAckBatchTimeOut() const
+{
+    return this->settings->ackBatchTimeOut;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setAckBatchTimeOut(long long ackBatchTimeOut)
+{
+    this->settings->ackBatchTimeOut = ackBatchTimeOut;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 long long ActiveMQConnectionFactory::getConsumerFailoverRedeliveryWaitPeriod()
     const
@@ -1047,3 +1112,60 @@ void ActiveMQConnectionFactory::setConsumerExpiryCheckEnabled(
 {
     this->settings->consumerExpiryCheckEnabled = consumerExpiryCheckEnabled;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnectionFactory::isCopyMessageOnSend() const
+{
+    return this->settings->copyMessageOnSend;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setCopyMessageOnSend(bool copyMessageOnSend)
+{
+    this->settings->copyMessageOnSend = copyMessageOnSend;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnectionFactory::isUseDedicatedTaskRunner() const
+{
+    return this->settings->useDedicatedTaskRunner;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setUseDedicatedTaskRunner(
+    bool useDedicatedTaskRunner)
+{
+    this->settings->useDedicatedTaskRunner = useDedicatedTaskRunner;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConnectionFactory::getMaxThreadPoolSize() const
+{
+    return this->settings->maxThreadPoolSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setMaxThreadPoolSize(int maxThreadPoolSize)
+{
+    if (maxThreadPoolSize <= 0)
+    {
+        throw IllegalArgumentException(
+            __FILE__,
+            __LINE__,
+            "The max thread pool size must be greater than zero.");
+    }
+
+    this->settings->maxThreadPoolSize = maxThreadPoolSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnectionFactory::isUseLockFreeDispatch() const
+{
+    return this->settings->useLockFreeDispatch;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setUseLockFreeDispatch(bool useLockFreeDispatch)
+{
+    this->settings->useLockFreeDispatch = useLockFreeDispatch;
+}
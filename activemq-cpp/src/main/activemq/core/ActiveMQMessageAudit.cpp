@@ -21,11 +21,14 @@
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/util/IdGenerator.h>
 
-#include <decaf/util/BitSet.h>
-#include <decaf/util/LRUCache.h>
-#include <decaf/util/concurrent/Mutex.h>
-
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 using namespace std;
 using namespace activemq;
@@ -33,15 +36,291 @@ using namespace activemq::util;
 using namespace activemq::core;
 using namespace activemq::commands;
 using namespace activemq::exceptions;
-using namespace decaf::util;
-using namespace decaf::util::concurrent;
-using namespace decaf::lang;
-using namespace decaf::lang::exceptions;
 
 ////////////////////////////////////////////////////////////////////////////////
 AMQCPP_API const int ActiveMQMessageAudit::DEFAULT_WINDOW_SIZE    = 2048;
 AMQCPP_API const int ActiveMQMessageAudit::MAXIMUM_PRODUCER_COUNT = 64;
 
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+    // Producers are spread over this many independently locked stripes.
+    const int STRIPES = 8;
+
+    /**
+     * Stands in for a connection id in a producer's hash with a bounded
+     * amount of work, ids from one host share a long prefix and differ in
+     * the time stamp and sequence numbers at their end.
+     */
+    std::size_t connectionTag(const std::string& connectionId)
+    {
+        const std::size_t TAIL = 16;
+
+        std::size_t length = connectionId.size();
+        std::size_t start  = length > TAIL ? length - TAIL : 0;
+        std::size_t tag    = length;
+        for (std::size_t i = start; i < length; ++i)
+        {
+            tag = tag * 31 + (unsigned char)connectionId[i];
+        }
+
+        return tag;
+    }
+
+    std::size_t hashProducer(std::size_t tag,
+                             long long   sessionId,
+                             long long   value)
+    {
+        std::size_t seed = tag;
+        seed ^= std::hash<long long>()(sessionId) + 0x9e3779b9 + (seed << 6) +
+                (seed >> 2);
+        seed ^= std::hash<long long>()(value) + 0x9e3779b9 + (seed << 6) +
+                (seed >> 2);
+        return seed;
+    }
+
+    bool parseField(const std::string& text,
+                    std::size_t        begin,
+                    std::size_t        end,
+                    long long&         result)
+    {
+        if (begin >= end || end - begin > 18)
+        {
+            return false;
+        }
+
+        result = 0;
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            if (text[i] < '0' || text[i] > '9')
+            {
+                return false;
+            }
+
+            result = result * 10 + (text[i] - '0');
+        }
+
+        return true;
+    }
+
+    /**
+     * Splits the seed of a string Message id, its ProducerId and a colon,
+     * into the fields a MessageId's producer is tracked by so both forms of
+     * the id find the same window.  A seed that does not end in a session
+     * and producer number is kept whole.
+     */
+    void splitSeed(const std::string& seed,
+                   std::string&       connectionId,
+                   long long&         sessionId,
+                   long long&         value)
+    {
+        connectionId = seed;
+        sessionId    = -1;
+        value        = -1;
+
+        if (seed.size() < 2 || seed[seed.size() - 1] != ':')
+        {
+            return;
+        }
+
+        std::size_t valueColon = seed.rfind(':', seed.size() - 2);
+        if (valueColon == std::string::npos || valueColon == 0)
+        {
+            return;
+        }
+
+        std::size_t sessionColon = seed.rfind(':', valueColon - 1);
+        if (sessionColon == std::string::npos || sessionColon == 0)
+        {
+            return;
+        }
+
+        long long parsedSession = 0;
+        long long parsedValue   = 0;
+        if (parseField(seed, sessionColon + 1, valueColon, parsedSession) &&
+            parseField(seed, valueColon + 1, seed.size() - 1, parsedValue))
+        {
+            connectionId.resize(sessionColon);
+            sessionId = parsedSession;
+            value     = parsedValue;
+        }
+    }
+
+    /**
+     * Tracks which of the most recent sequence ids of one producer have been
+     * seen, in a fixed size ring of bits whose head is the highest sequence id
+     * seen so far.  Ids that have fallen behind the ring are no longer known.
+     */
+    class ProducerWindow
+    {
+    public:
+        // Kept from when the producer was first seen, a check compares it
+        // only once the cheaper fields and the hash have matched.
+        std::string connectionId;
+        long long   sessionId;
+        long long   value;
+        std::size_t hash;
+
+    private:
+        long long                       highest;
+        unsigned long long              mask;
+        std::vector<unsigned long long> bits;
+
+    public:
+        ProducerWindow(const std::string& connectionId,
+                       long long          sessionId,
+                       long long          value,
+                       std::size_t        hash,
+                       int                auditDepth)
+            : connectionId(connectionId),
+              sessionId(sessionId),
+              value(value),
+              hash(hash),
+              highest(-1),
+              mask(0),
+              bits()
+        {
+            // Large enough to hold auditDepth ids behind the newest one.
+            unsigned long long size = 64;
+            while (size < (unsigned long long)auditDepth + 1)
+            {
+                size <<= 1;
+            }
+
+            this->mask = size - 1;
+            this->bits.resize(size / 64, 0);
+        }
+
+        bool matches(const std::string& connectionId,
+                     long long          sessionId,
+                     long long          value) const
+        {
+            return this->value == value && this->sessionId == sessionId &&
+                   this->connectionId == connectionId;
+        }
+
+        bool isTracked(long long sequence) const
+        {
+            return sequence >= 0 && sequence <= this->highest &&
+                   (unsigned long long)(this->highest - sequence) <= this->mask;
+        }
+
+        bool get(long long sequence) const
+        {
+            unsigned long long bit = (unsigned long long)sequence & this->mask;
+            return (this->bits[bit >> 6] & (1ULL << (bit & 63))) != 0;
+        }
+
+        void set(long long sequence, bool seen)
+        {
+            unsigned long long bit = (unsigned long long)sequence & this->mask;
+            if (seen)
+            {
+                this->bits[bit >> 6] |= (1ULL << (bit & 63));
+            }
+            else
+            {
+                this->bits[bit >> 6] &= ~(1ULL << (bit & 63));
+            }
+        }
+
+        /**
+         * Marks the sequence id as seen.
+         *
+         * @return true if it had already been seen.
+         */
+        bool markSeen(long long sequence)
+        {
+            if (sequence > this->highest)
+            {
+                // Slide the window forward, forgetting the ids it drops.
+                if (this->highest < 0 ||
+                    (unsigned long long)(sequence - this->highest) > this->mask)
+                {
+                    std::fill(this->bits.begin(), this->bits.end(), 0ULL);
+                }
+                else
+                {
+                    for (long long i = this->highest + 1; i < sequence; ++i)
+                    {
+                        set(i, false);
+                    }
+                }
+
+                set(sequence, true);
+                this->highest = sequence;
+                return false;
+            }
+
+            if (!isTracked(sequence))
+            {
+                return false;
+            }
+
+            bool seen = get(sequence);
+            if (!seen)
+            {
+                set(sequence, true);
+            }
+
+            return seen;
+        }
+
+        long long getLastSetIndex() const
+        {
+            for (long long i = this->highest; isTracked(i); --i)
+            {
+                if (get(i))
+                {
+                    return i;
+                }
+            }
+
+            return -1;
+        }
+    };
+
+    typedef std::list<ProducerWindow> WindowList;
+
+    struct AuditStripe
+    {
+        std::mutex mutex;
+
+        // Most recently used first, the index holds positions in the list.
+        WindowList                                                windows;
+        std::unordered_multimap<std::size_t, WindowList::iterator> index;
+
+        AuditStripe()
+            : mutex(),
+              windows(),
+              index()
+        {
+        }
+
+        void erase(WindowList::iterator window)
+        {
+            auto range = this->index.equal_range(window->hash);
+            for (auto iter = range.first; iter != range.second; ++iter)
+            {
+                if (iter->second == window)
+                {
+                    this->index.erase(iter);
+                    break;
+                }
+            }
+
+            this->windows.erase(window);
+        }
+
+        void eraseOldest()
+        {
+            erase(std::prev(this->windows.end()));
+        }
+    };
+
+}  // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 namespace activemq
 {
@@ -55,46 +334,197 @@ namespace core
         MessageAuditImpl& operator=(const MessageAuditImpl&);
 
     public:
-        int   auditDepth;
-        int   maximumNumberOfProducersToTrack;
-        Mutex mutex;
+        std::atomic<int> auditDepth;
+        std::atomic<int> maximumNumberOfProducersToTrack;
+
+        // Windows held across all stripes, the producer limit applies to it.
+        std::atomic<int> producerCount;
 
-        LRUCache<std::string, std::shared_ptr<BitSet>> map;
+        AuditStripe stripes[STRIPES];
 
         MessageAuditImpl()
-            : auditDepth(2048),
-              maximumNumberOfProducersToTrack(64),
-              mutex(),
-              map()
+            : auditDepth(ActiveMQMessageAudit::DEFAULT_WINDOW_SIZE),
+              maximumNumberOfProducersToTrack(
+                  ActiveMQMessageAudit::MAXIMUM_PRODUCER_COUNT),
+              producerCount(0),
+              stripes()
         {
         }
 
         MessageAuditImpl(int auditDepth, int maximumNumberOfProducersToTrack)
             : auditDepth(auditDepth),
               maximumNumberOfProducersToTrack(maximumNumberOfProducersToTrack),
-              mutex(),
-              map()
+              producerCount(0),
+              stripes()
         {
         }
 
-        void adjustMaxProducersToTrack(int value)
+        int getProducerLimit() const
+        {
+            return std::max(1, this->maximumNumberOfProducersToTrack.load());
+        }
+
+        /**
+         * Evicts least recently used windows of the stripe, which must be
+         * locked, while more producers than the limit are tracked.  The
+         * stripe's most recent window is kept when keepNewest is set.
+         */
+        void evictFrom(AuditStripe& stripe, bool keepNewest)
+        {
+            std::size_t keep = keepNewest ? 1 : 0;
+            while (this->producerCount.load() > getProducerLimit() &&
+                   stripe.windows.size() > keep)
+            {
+                stripe.eraseOldest();
+                this->producerCount--;
+            }
+        }
+
+        /**
+         * Brings the number of tracked producers back within the limit after
+         * a window was added to the locked stripe.  The stripe's own older
+         * windows go first, then those of any other stripe that is not busy,
+         * waiting on another stripe's lock here could deadlock.
+         */
+        void enforceLimit(AuditStripe& stripe)
+        {
+            evictFrom(stripe, true);
+
+            for (int i = 0; i < STRIPES &&
+                            this->producerCount.load() > getProducerLimit();
+                 ++i)
+            {
+                AuditStripe& other = this->stripes[i];
+                if (&other == &stripe)
+                {
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(other.mutex,
+                                                  std::try_to_lock);
+                if (lock.owns_lock())
+                {
+                    evictFrom(other, false);
+                }
+            }
+        }
+
+        AuditStripe& getStripe(std::size_t hash)
         {
-            // When value is smaller than current we need to move the entries
-            // to a new cache with that setting so that old ones are pruned
-            // since putAll will access the entries in the right order,
-            // this shouldn't result in wrong cache entries being removed
-            if (value < maximumNumberOfProducersToTrack)
+            return this->stripes[hash % STRIPES];
+        }
+
+        /**
+         * Finds the window of a producer, moving it to the front of its
+         * stripe, optionally creating it and evicting the least recently
+         * used one if the stripe is full.  The stripe must be locked.
+         */
+        ProducerWindow* findWindow(AuditStripe&       stripe,
+                                   const std::string& connectionId,
+                                   long long          sessionId,
+                                   long long          value,
+                                   std::size_t        hash,
+                                   bool               create)
+        {
+            auto range = stripe.index.equal_range(hash);
+            for (auto iter = range.first; iter != range.second; ++iter)
             {
-                LRUCache<std::string, std::shared_ptr<BitSet>> newMap(0,
-                                                                      value,
-                                                                      0.75f,
-                                                                      true);
-                newMap.putAll(this->map);
-                this->map.clear();
-                this->map.putAll(newMap);
+                if (iter->second->matches(connectionId, sessionId, value))
+                {
+                    stripe.windows.splice(stripe.windows.begin(),
+                                          stripe.windows,
+                                          iter->second);
+                    return &*iter->second;
+                }
             }
-            this->map.setMaxCacheSize(value);
+
+            if (!create)
+            {
+                return nullptr;
+            }
+
+            stripe.windows.emplace_front(connectionId,
+                                         sessionId,
+                                         value,
+                                         hash,
+                                         this->auditDepth.load());
+            stripe.index.emplace(hash, stripe.windows.begin());
+            this->producerCount++;
+            enforceLimit(stripe);
+
+            return &stripe.windows.front();
+        }
+
+        bool isDuplicate(const std::string& connectionId,
+                         long long          sessionId,
+                         long long          value,
+                         long long          sequence)
+        {
+            std::size_t  hash =
+                hashProducer(connectionTag(connectionId), sessionId, value);
+            AuditStripe& stripe = getStripe(hash);
+
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            ProducerWindow*             window =
+                findWindow(stripe, connectionId, sessionId, value, hash, true);
+
+            return sequence >= 0 && window->markSeen(sequence);
+        }
+
+        void rollback(const std::string& connectionId,
+                      long long          sessionId,
+                      long long          value,
+                      long long          sequence)
+        {
+            std::size_t  hash =
+                hashProducer(connectionTag(connectionId), sessionId, value);
+            AuditStripe& stripe = getStripe(hash);
+
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            ProducerWindow*             window =
+                findWindow(stripe, connectionId, sessionId, value, hash, false);
+
+            if (window != nullptr && window->isTracked(sequence))
+            {
+                window->set(sequence, false);
+            }
+        }
+
+        long long getLastSeqId(const std::string& connectionId,
+                               long long          sessionId,
+                               long long          value)
+        {
+            std::size_t  hash =
+                hashProducer(connectionTag(connectionId), sessionId, value);
+            AuditStripe& stripe = getStripe(hash);
+
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            ProducerWindow*             window =
+                findWindow(stripe, connectionId, sessionId, value, hash, false);
+
+            return window != nullptr ? window->getLastSetIndex() : -1;
+        }
+
+        void adjustMaxProducersToTrack(int value)
+        {
             this->maximumNumberOfProducersToTrack = value;
+
+            for (int i = 0; i < STRIPES; ++i)
+            {
+                std::lock_guard<std::mutex> lock(this->stripes[i].mutex);
+                evictFrom(this->stripes[i], false);
+            }
+        }
+
+        void clear()
+        {
+            for (int i = 0; i < STRIPES; ++i)
+            {
+                std::lock_guard<std::mutex> lock(this->stripes[i].mutex);
+                this->producerCount -= (int)this->stripes[i].windows.size();
+                this->stripes[i].index.clear();
+                this->stripes[i].windows.clear();
+            }
         }
     };
 
@@ -151,89 +581,36 @@ void ActiveMQMessageAudit::getMaximumNumberOfProducersToTrack(int value)
 ////////////////////////////////////////////////////////////////////////////////
 bool ActiveMQMessageAudit::isDuplicate(const std::string& id) const
 {
-    bool        answer = false;
-    std::string seed   = IdGenerator::getSeedFromId(id);
-    if (!seed.empty())
+    std::string seed = IdGenerator::getSeedFromId(id);
+    if (seed.empty())
     {
-        synchronized(&this->impl->mutex)
-        {
-            std::shared_ptr<BitSet> bits;
-            try
-            {
-                bits = this->impl->map.get(seed);
-            }
-            catch (NoSuchElementException& ex)
-            {
-                bits.reset(new BitSet(this->impl->auditDepth));
-                this->impl->map.put(seed, bits);
-            }
+        return false;
+    }
 
-            long long index = IdGenerator::getSequenceFromId(id);
-            if (index >= 0)
-            {
-                int scaledIndex = (int)index;
-                if (index > Integer::MAX_VALUE)
-                {
-                    scaledIndex = (int)(index % Integer::MAX_VALUE);
-                }
+    std::string connectionId;
+    long long   sessionId = -1;
+    long long   value     = -1;
+    splitSeed(seed, connectionId, sessionId, value);
 
-                answer = bits->get(scaledIndex);
-                if (!answer)
-                {
-                    bits->set(scaledIndex, true);
-                }
-            }
-        }
-    }
-    return answer;
+    return this->impl->isDuplicate(connectionId,
+                                   sessionId,
+                                   value,
+                                   IdGenerator::getSequenceFromId(id));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool ActiveMQMessageAudit::isDuplicate(std::shared_ptr<MessageId> msgId) const
 {
-    bool answer = false;
-
-    if (msgId != nullptr)
+    if (msgId == nullptr || msgId->getProducerId() == nullptr)
     {
-        std::shared_ptr<ProducerId> pid = msgId->getProducerId();
-        if (pid != nullptr)
-        {
-            std::string seed = pid->toString();
-            if (!seed.empty())
-            {
-                synchronized(&this->impl->mutex)
-                {
-                    std::shared_ptr<BitSet> bits;
-                    try
-                    {
-                        bits = this->impl->map.get(seed);
-                    }
-                    catch (NoSuchElementException& ex)
-                    {
-                        bits.reset(new BitSet(this->impl->auditDepth));
-                        this->impl->map.put(seed, bits);
-                    }
-
-                    long long index = msgId->getProducerSequenceId();
-                    if (index >= 0)
-                    {
-                        int scaledIndex = (int)index;
-                        if (index > Integer::MAX_VALUE)
-                        {
-                            scaledIndex = (int)(index % Integer::MAX_VALUE);
-                        }
-
-                        answer = bits->get(scaledIndex);
-                        if (!answer)
-                        {
-                            bits->set(scaledIndex, true);
-                        }
-                    }
-                }
-            }
-        }
+        return false;
     }
-    return answer;
+
+    const ProducerId& pid = *msgId->getProducerId();
+    return this->impl->isDuplicate(pid.getConnectionId(),
+                                   pid.getSessionId(),
+                                   pid.getValue(),
+                                   msgId->getProducerSequenceId());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -242,194 +619,102 @@ void ActiveMQMessageAudit::rollback(const std::string& msgId)
     std::string seed = IdGenerator::getSeedFromId(msgId);
     if (!seed.empty())
     {
-        synchronized(&this->impl->mutex)
-        {
-            std::shared_ptr<BitSet> bits;
-            try
-            {
-                bits = this->impl->map.get(seed);
-            }
-            catch (NoSuchElementException& ex)
-            {
-            }
-
-            if (bits != nullptr)
-            {
-                long long index = IdGenerator::getSequenceFromId(msgId);
-                if (index >= 0)
-                {
-                    int scaledIndex = (int)index;
-                    if (index > Integer::MAX_VALUE)
-                    {
-                        scaledIndex = (int)(index % Integer::MAX_VALUE);
-                    }
-
-                    bits->set(scaledIndex, false);
-                }
-            }
-        }
+        std::string connectionId;
+        long long   sessionId = -1;
+        long long   value     = -1;
+        splitSeed(seed, connectionId, sessionId, value);
+
+        this->impl->rollback(connectionId,
+                             sessionId,
+                             value,
+                             IdGenerator::getSequenceFromId(msgId));
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQMessageAudit::rollback(std::shared_ptr<commands::MessageId> msgId)
 {
-    if (msgId != nullptr)
+    if (msgId != nullptr && msgId->getProducerId() != nullptr)
     {
-        std::shared_ptr<ProducerId> pid = msgId->getProducerId();
-        if (pid != nullptr)
-        {
-            std::string seed = pid->toString();
-            if (!seed.empty())
-            {
-                synchronized(&this->impl->mutex)
-                {
-                    std::shared_ptr<BitSet> bits;
-                    try
-                    {
-                        bits = this->impl->map.get(seed);
-                    }
-                    catch (NoSuchElementException& ex)
-                    {
-                    }
-
-                    if (bits != nullptr)
-                    {
-                        long long index = msgId->getProducerSequenceId();
-                        if (index >= 0)
-                        {
-                            int scaledIndex = (int)index;
-                            if (index > Integer::MAX_VALUE)
-                            {
-                                scaledIndex = (int)(index % Integer::MAX_VALUE);
-                            }
-
-                            bits->set(scaledIndex, false);
-                        }
-                    }
-                }
-            }
-        }
+        const ProducerId& pid = *msgId->getProducerId();
+        this->impl->rollback(pid.getConnectionId(),
+                             pid.getSessionId(),
+                             pid.getValue(),
+                             msgId->getProducerSequenceId());
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool ActiveMQMessageAudit::isInOrder(const std::string& msgId) const
 {
-    bool answer = true;
+    if (msgId.empty())
+    {
+        return true;
+    }
 
-    if (!msgId.empty())
+    std::string seed = IdGenerator::getSeedFromId(msgId);
+    if (seed.empty())
     {
-        std::string seed = IdGenerator::getSeedFromId(msgId);
-        if (!seed.empty())
-        {
-            synchronized(&this->impl->mutex)
-            {
-                std::shared_ptr<BitSet> bits;
-                try
-                {
-                    bits = this->impl->map.get(seed);
-                }
-                catch (NoSuchElementException& ex)
-                {
-                    bits.reset(new BitSet(this->impl->auditDepth));
-                    this->impl->map.put(seed, bits);
-                }
+        return true;
+    }
 
-                long long index = IdGenerator::getSequenceFromId(msgId);
-                if (index >= 0)
-                {
-                    int scaledIndex = (int)index;
-                    if (index > Integer::MAX_VALUE)
-                    {
-                        scaledIndex = (int)(index % Integer::MAX_VALUE);
-                    }
+    std::string connectionId;
+    long long   sessionId = -1;
+    long long   value     = -1;
+    splitSeed(seed, connectionId, sessionId, value);
 
-                    answer = ((bits->length() - 1) == scaledIndex);
-                }
-            }
-        }
-    }
-    return answer;
+    long long index = IdGenerator::getSequenceFromId(msgId);
+    return index < 0 ||
+           this->impl->getLastSeqId(connectionId, sessionId, value) == index;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool ActiveMQMessageAudit::isInOrder(
     std::shared_ptr<commands::MessageId> msgId) const
 {
-    bool answer = false;
-
-    if (msgId != nullptr)
+    if (msgId == nullptr || msgId->getProducerId() == nullptr)
     {
-        std::shared_ptr<ProducerId> pid = msgId->getProducerId();
-        if (pid != nullptr)
-        {
-            std::string seed = pid->toString();
-            if (!seed.empty())
-            {
-                synchronized(&this->impl->mutex)
-                {
-                    std::shared_ptr<BitSet> bits;
-                    try
-                    {
-                        bits = this->impl->map.get(seed);
-                    }
-                    catch (NoSuchElementException& ex)
-                    {
-                        bits.reset(new BitSet(this->impl->auditDepth));
-                        this->impl->map.put(seed, bits);
-                    }
-
-                    long long index = msgId->getProducerSequenceId();
-                    if (index >= 0)
-                    {
-                        int scaledIndex = (int)index;
-                        if (index > Integer::MAX_VALUE)
-                        {
-                            scaledIndex = (int)(index % Integer::MAX_VALUE);
-                        }
-                        answer = ((bits->length() - 1) == scaledIndex);
-                    }
-                }
-            }
-        }
+        return false;
     }
-    return answer;
+
+    const ProducerId& pid   = *msgId->getProducerId();
+    long long         index = msgId->getProducerSequenceId();
+    return index >= 0 && this->impl->getLastSeqId(pid.getConnectionId(),
+                                                  pid.getSessionId(),
+                                                  pid.getValue()) == index;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 long long ActiveMQMessageAudit::getLastSeqId(
     std::shared_ptr<commands::ProducerId> id) const
 {
-    long result = -1;
-    if (id != nullptr)
+    if (id == nullptr)
     {
-        std::string seed = id->toString();
-        if (!seed.empty())
-        {
-            synchronized(&this->impl->mutex)
-            {
-                std::shared_ptr<BitSet> bits;
-                try
-                {
-                    bits = this->impl->map.get(seed);
-                }
-                catch (NoSuchElementException& ex)
-                {
-                }
-
-                if (bits != nullptr)
-                {
-                    result = bits->length() - 1;
-                }
-            }
-        }
+        return -1;
     }
-    return result;
+
+    return this->impl->getLastSeqId(id->getConnectionId(),
+                                    id->getSessionId(),
+                                    id->getValue());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQMessageAudit::getProducerCount() const
+{
+    return this->impl->producerCount;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQMessageAudit::getStripeIndex(const commands::ProducerId& id)
+{
+    return (int)(hashProducer(connectionTag(id.getConnectionId()),
+                              id.getSessionId(),
+                              id.getValue()) %
+                 STRIPES);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQMessageAudit::clear()
 {
-    this->impl->map.clear();
+    this->impl->clear();
 }
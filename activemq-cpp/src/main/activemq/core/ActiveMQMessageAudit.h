@@ -31,6 +31,13 @@ namespace core
 
     class MessageAuditImpl;
 
+    /**
+     * Provides basic audit functions for Messages.  Each producer is tracked
+     * by its numeric id with a fixed size window over its most recent
+     * sequence ids, so memory use does not grow with the number of messages
+     * audited.  Ids older than the audit depth behind the newest one seen
+     * from a producer are no longer reported as duplicates.
+     */
     class AMQCPP_API ActiveMQMessageAudit
     {
     private:
@@ -69,7 +76,8 @@ namespace core
         int getAuditDepth() const;
 
         /**
-         * Sets a new Audit Depth value.
+         * Sets a new Audit Depth value, producers already being tracked keep
+         * the window size they were created with.
          *
          * @param value
          *      The range of ids to track.
@@ -152,6 +160,24 @@ namespace core
          */
         long long getLastSeqId(std::shared_ptr<commands::ProducerId> id) const;
 
+        /**
+         * @return the number of producers currently tracked.  The maximum
+         * number of producers to track applies to this total, it can only
+         * be exceeded briefly while other threads are auditing.
+         */
+        int getProducerCount() const;
+
+        /**
+         * Producers are tracked in several independently locked stripes,
+         * this returns the one a given producer is kept in.
+         *
+         * @param id
+         *      The producer to look up.
+         *
+         * @return the index of the stripe that tracks the producer.
+         */
+        static int getStripeIndex(const commands::ProducerId& id);
+
         /**
          * Clears this Audit.
          */
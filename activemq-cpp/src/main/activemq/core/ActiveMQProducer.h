@@ -204,6 +204,55 @@ namespace core
             return this->kernel->getSendTimeout();
         }
 
+        /**
+         * Sets if Messages are copied before this Producer sends them, when
+         * disabled the application must not modify or delete a Message until
+         * send returns or its AsyncCallback is called.  A Message sent in
+         * place is left with the message id, destination and producer id of
+         * the send and with a read only body and properties.
+         * @param value - boolean indicating enable / disable (true / false)
+         */
+        void setCopyMessageOnSend(bool value)
+        {
+            this->kernel->setCopyMessageOnSend(value);
+        }
+
+        /**
+         * Gets if Messages are copied before this Producer sends them
+         * @return boolean indicating state of enable / disable (true / false)
+         */
+        bool isCopyMessageOnSend() const
+        {
+            return this->kernel->isCopyMessageOnSend();
+        }
+
+        /**
+         * Sets properties that are added to every Message this Producer sends,
+         * they are marshaled once rather than for each Message.  A property
+         * the Message sets itself takes precedence over one of the same name
+         * here.  An empty map removes the template.
+         *
+         * The properties only go into the Message that is sent, never into
+         * the caller's.  With copyMessageOnSend disabled a copy that shares
+         * the body is still made for each send while a template is set.
+         *
+         * @param properties
+         *      The properties to add to each Message sent.
+         */
+        void setPropertyTemplate(const util::PrimitiveMap& properties)
+        {
+            this->kernel->setPropertyTemplate(properties);
+        }
+
+        /**
+         * @return the properties added to every Message sent, or NULL if no
+         *         template has been set.
+         */
+        std::shared_ptr<MessagePropertyTemplate> getPropertyTemplate() const
+        {
+            return this->kernel->getPropertyTemplate();
+        }
+
         virtual void setMessageTransformer(cms::MessageTransformer* transformer)
         {
             this->kernel->setMessageTransformer(transformer);
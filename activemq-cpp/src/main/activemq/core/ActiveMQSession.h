@@ -205,6 +205,32 @@ namespace core
         {
             return this->kernel->getConnection();
         }
+
+        /**
+         * @return the number of messages queued in this Session waiting to be
+         * dispatched to its consumers.
+         */
+        int getDispatchQueueDepth() const
+        {
+            return this->kernel->getDispatchQueueDepth();
+        }
+
+        /**
+         * @return the number of times this Session's dispatch task has run.
+         */
+        long long getDispatchIterationCount() const
+        {
+            return this->kernel->getDispatchIterationCount();
+        }
+
+        /**
+         * @return the total time in nanoseconds this Session's dispatch task
+         * has been running.
+         */
+        long long getDispatchIterationTime() const
+        {
+            return this->kernel->getDispatchIterationTime();
+        }
     };
 
 }  // namespace core
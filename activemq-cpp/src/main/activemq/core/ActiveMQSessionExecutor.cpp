@@ -21,10 +21,17 @@
 #include <activemq/core/ActiveMQConnection.h>
 #include <activemq/core/ActiveMQSession.h>
 #include <activemq/core/FifoMessageDispatchChannel.h>
+#include <activemq/core/LockFreeMessageDispatchChannel.h>
+#include <activemq/core/LockFreePriorityMessageDispatchChannel.h>
+#include <activemq/core/PrefetchPolicy.h>
 #include <activemq/core/SimplePriorityMessageDispatchChannel.h>
 #include <activemq/core/kernels/ActiveMQConsumerKernel.h>
 #include <activemq/core/kernels/ActiveMQSessionKernel.h>
 #include <activemq/threads/DedicatedTaskRunner.h>
+#include <activemq/threads/PooledTaskRunner.h>
+
+#include <chrono>
+#include <memory>
 
 using namespace std;
 using namespace activemq;
@@ -40,9 +47,30 @@ using namespace decaf::util::concurrent;
 ActiveMQSessionExecutor::ActiveMQSessionExecutor(ActiveMQSessionKernel* session)
     : session(session),
       messageQueue(),
-      taskRunner()
+      taskRunner(),
+      iterationCount(0),
+      iterationTime(0)
 {
-    if (this->session->getConnection()->isMessagePrioritySupported())
+    ActiveMQConnection* connection = this->session->getConnection();
+
+    if (connection->isUseLockFreeDispatch())
+    {
+        // The Session queue is shared by all its Consumers, size it for a
+        // few Consumers at the default prefetch.
+        int capacity = connection->getPrefetchPolicy()->getQueuePrefetch() * 4;
+
+        if (connection->isMessagePrioritySupported())
+        {
+            this->messageQueue.reset(
+                new LockFreePriorityMessageDispatchChannel(capacity));
+        }
+        else
+        {
+            this->messageQueue.reset(
+                new LockFreeMessageDispatchChannel(capacity));
+        }
+    }
+    else if (connection->isMessagePrioritySupported())
     {
         this->messageQueue.reset(new SimplePriorityMessageDispatchChannel());
     }
@@ -79,10 +107,12 @@ ActiveMQSessionExecutor::~ActiveMQSessionExecutor()
     try
     {
         // Ensure that we shutdown the taskRunner Thread before we are done.
-        if (taskRunner != nullptr)
+        std::shared_ptr<TaskRunner> runner = std::atomic_exchange(
+            &this->taskRunner,
+            std::shared_ptr<TaskRunner>());
+        if (runner != nullptr)
         {
-            taskRunner->shutdown();
-            taskRunner.reset();
+            runner->shutdown();
         }
     }
     AMQ_CATCHALL_NOTHROW()
@@ -120,20 +150,38 @@ void ActiveMQSessionExecutor::wakeup()
         return;
     }
 
-    std::shared_ptr<TaskRunner> taskRunner;
-    synchronized(messageQueue.get())
+    // Called for every message dispatched, the monitor is only needed to
+    // create the TaskRunner.
+    std::shared_ptr<TaskRunner> taskRunner =
+        std::atomic_load(&this->taskRunner);
+
+    if (taskRunner == nullptr)
     {
-        if (this->taskRunner == nullptr)
+        synchronized(messageQueue.get())
         {
-            if (!messageQueue->isRunning())
+            taskRunner = std::atomic_load(&this->taskRunner);
+            if (taskRunner == nullptr)
             {
-                return;
+                if (!messageQueue->isRunning())
+                {
+                    return;
+                }
+                ActiveMQConnection* connection =
+                    this->session->getConnection();
+                if (connection->isUseDedicatedTaskRunner())
+                {
+                    taskRunner.reset(new DedicatedTaskRunner(this));
+                }
+                else
+                {
+                    taskRunner.reset(new PooledTaskRunner(
+                        connection->getSessionTaskRunnerPool(),
+                        this));
+                }
+                taskRunner->start();
+                std::atomic_store(&this->taskRunner, taskRunner);
             }
-            this->taskRunner.reset(new DedicatedTaskRunner(this));
-            this->taskRunner->start();
         }
-
-        taskRunner = this->taskRunner;
     }
 
     taskRunner->wakeup();
@@ -162,12 +210,8 @@ void ActiveMQSessionExecutor::stop()
         {
             messageQueue->stop();
 
-            taskRunner = this->taskRunner;
-
-            if (taskRunner != nullptr)
-            {
-                this->taskRunner.reset();
-            }
+            taskRunner = std::atomic_exchange(&this->taskRunner,
+                                              std::shared_ptr<TaskRunner>());
         }
     }
 
@@ -210,6 +254,35 @@ void ActiveMQSessionExecutor::dispatch(
 ////////////////////////////////////////////////////////////////////////////////
 bool ActiveMQSessionExecutor::iterate()
 {
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    // Records the time spent in this iteration however it ends.
+    class Finally
+    {
+    private:
+        ActiveMQSessionExecutor*              executor;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        Finally(ActiveMQSessionExecutor*              executor,
+                std::chrono::steady_clock::time_point start)
+            : executor(executor),
+              start(start)
+        {
+        }
+
+        ~Finally()
+        {
+            executor->iterationCount.fetch_add(1, std::memory_order_relaxed);
+            executor->iterationTime.fetch_add(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count(),
+                std::memory_order_relaxed);
+        }
+    } finalizer(this, start);
+
     try
     {
         if (this->session->iterateConsumers())
@@ -24,6 +24,7 @@
 #include <activemq/threads/Task.h>
 #include <activemq/threads/TaskRunner.h>
 #include <activemq/util/Config.h>
+#include <atomic>
 #include <memory>
 
 namespace activemq
@@ -52,9 +53,15 @@ namespace core
         /** The Channel that holds the waiting Messages for Dispatching. */
         std::shared_ptr<MessageDispatchChannel> messageQueue;
 
-        /** The Dispatcher TaskRunner */
+        /**
+         * The Dispatcher TaskRunner, only accessed through the std::atomic
+         * shared_ptr functions so that wakeup can read it without a lock.
+         */
         std::shared_ptr<activemq::threads::TaskRunner> taskRunner;
 
+        std::atomic<long long> iterationCount;
+        std::atomic<long long> iterationTime;
+
     private:
         ActiveMQSessionExecutor(const ActiveMQSessionExecutor&);
         ActiveMQSessionExecutor& operator=(const ActiveMQSessionExecutor&);
@@ -169,6 +176,33 @@ namespace core
             return messageQueue->removeAll();
         }
 
+        /**
+         * @return the number of messages waiting in this executor's queue to
+         * be dispatched to the Session's consumers.
+         */
+        int getQueueDepth() const
+        {
+            return messageQueue->size();
+        }
+
+        /**
+         * @return the number of times this executor has been iterated by its
+         * TaskRunner.
+         */
+        long long getIterationCount() const
+        {
+            return iterationCount.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @return the total time in nanoseconds this executor has spent being
+         * iterated by its TaskRunner.
+         */
+        long long getIterationTime() const
+        {
+            return iterationTime.load(std::memory_order_relaxed);
+        }
+
     private:
         /**
          * Dispatches a message to a particular consumer.
@@ -0,0 +1,237 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LockFreeMessageDispatchChannel.h"
+
+#include <decaf/lang/Thread.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+    // Number of times a blocking dequeue polls the ring before it parks.
+    const int SPIN_TRIES = 64;
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+LockFreeMessageDispatchChannel::LockFreeMessageDispatchChannel(int capacity)
+    : closed(false),
+      running(false),
+      waiters(0),
+      mutex(),
+      ring(capacity)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LockFreeMessageDispatchChannel::~LockFreeMessageDispatchChannel()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannel::enqueue(
+    const std::shared_ptr<MessageDispatch>& message)
+{
+    this->ring.offer(message);
+    signalWaiters();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannel::enqueueFirst(
+    const std::shared_ptr<MessageDispatch>& message)
+{
+    this->ring.offerFirst(message);
+    signalWaiters();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool LockFreeMessageDispatchChannel::isEmpty() const
+{
+    return this->ring.size() == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<MessageDispatch> LockFreeMessageDispatchChannel::dequeue(
+    long long timeout)
+{
+    if (timeout == 0)
+    {
+        return dequeueNoWait();
+    }
+
+    // Spin briefly, a busy producer is likely to hand over a message soon.
+    for (int i = 0; i < SPIN_TRIES && running && !closed; ++i)
+    {
+        if (this->ring.size() > 0)
+        {
+            std::shared_ptr<MessageDispatch> result = this->ring.poll();
+            if (result != nullptr)
+            {
+                return result;
+            }
+        }
+
+        Thread::yield();
+    }
+
+    for (;;)
+    {
+        synchronized(&mutex)
+        {
+            // Announce the waiter before checking so that an enqueue that
+            // misses it is guaranteed to be seen by the check.
+            this->waiters.fetch_add(1);
+
+            // Wait until the channel is ready to deliver messages.
+            while (!closed && (isEmpty() || !running))
+            {
+                if (timeout == -1)
+                {
+                    mutex.wait();
+                }
+                else
+                {
+                    mutex.wait(timeout);
+                    break;
+                }
+            }
+
+            this->waiters.fetch_sub(1);
+        }
+
+        if (closed || !running)
+        {
+            return std::shared_ptr<MessageDispatch>();
+        }
+
+        // Another receiver may have taken the message first, only an
+        // infinite wait goes back to waiting for the next one.  A message
+        // its producer has not finished offering is worth another try.
+        std::shared_ptr<MessageDispatch> result = this->ring.poll();
+        if (result != nullptr || (timeout != -1 && isEmpty()))
+        {
+            return result;
+        }
+
+        Thread::yield();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<MessageDispatch> LockFreeMessageDispatchChannel::dequeueNoWait()
+{
+    if (closed || !running || isEmpty())
+    {
+        return std::shared_ptr<MessageDispatch>();
+    }
+
+    return this->ring.poll();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<MessageDispatch> LockFreeMessageDispatchChannel::peek() const
+{
+    if (closed || !running || isEmpty())
+    {
+        return std::shared_ptr<MessageDispatch>();
+    }
+
+    return this->ring.peek();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannel::start()
+{
+    synchronized(&mutex)
+    {
+        if (!closed)
+        {
+            running = true;
+            mutex.notifyAll();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannel::stop()
+{
+    synchronized(&mutex)
+    {
+        running = false;
+        mutex.notifyAll();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannel::close()
+{
+    synchronized(&mutex)
+    {
+        if (!closed)
+        {
+            running = false;
+            closed  = true;
+        }
+        mutex.notifyAll();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannel::clear()
+{
+    this->ring.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int LockFreeMessageDispatchChannel::size() const
+{
+    return this->ring.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::shared_ptr<MessageDispatch>>
+LockFreeMessageDispatchChannel::removeAll()
+{
+    std::vector<std::shared_ptr<MessageDispatch>> result;
+    this->ring.drainTo(result);
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannel::signalWaiters()
+{
+    // Pairs with the waiter count taken in dequeue, the ring's count was
+    // raised by the offer so a consumer that is not counted here will see
+    // the message before it parks.
+    if (this->waiters.load() > 0)
+    {
+        synchronized(&mutex)
+        {
+            mutex.notify();
+        }
+    }
+}
@@ -0,0 +1,311 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LockFreePriorityMessageDispatchChannel.h"
+
+#include <cms/Message.h>
+
+#include <decaf/lang/Math.h>
+#include <decaf/lang/Thread.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+    // Number of times a blocking dequeue polls the lanes before it parks.
+    const int SPIN_TRIES = 64;
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+const int LockFreePriorityMessageDispatchChannel::MAX_PRIORITIES = 10;
+
+////////////////////////////////////////////////////////////////////////////////
+LockFreePriorityMessageDispatchChannel::LockFreePriorityMessageDispatchChannel(
+    int capacity)
+    : closed(false),
+      running(false),
+      waiters(0),
+      enqueued(0),
+      mutex(),
+      lanes()
+{
+    for (int i = 0; i < MAX_PRIORITIES; ++i)
+    {
+        int laneCapacity = i == cms::Message::DEFAULT_MSG_PRIORITY
+                               ? capacity
+                               : capacity / MAX_PRIORITIES;
+        this->lanes.emplace_back(new MessageDispatchRing(laneCapacity));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LockFreePriorityMessageDispatchChannel::~LockFreePriorityMessageDispatchChannel()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreePriorityMessageDispatchChannel::enqueue(
+    const std::shared_ptr<MessageDispatch>& message)
+{
+    getLane(message).offer(message);
+    this->enqueued.fetch_add(1);
+    signalWaiters();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreePriorityMessageDispatchChannel::enqueueFirst(
+    const std::shared_ptr<MessageDispatch>& message)
+{
+    getLane(message).offerFirst(message);
+    this->enqueued.fetch_add(1);
+    signalWaiters();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool LockFreePriorityMessageDispatchChannel::isEmpty() const
+{
+    return this->enqueued.load() <= 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<MessageDispatch>
+LockFreePriorityMessageDispatchChannel::dequeue(long long timeout)
+{
+    if (timeout == 0)
+    {
+        return dequeueNoWait();
+    }
+
+    // Spin briefly, a busy producer is likely to hand over a message soon.
+    for (int i = 0; i < SPIN_TRIES && running && !closed; ++i)
+    {
+        if (!isEmpty())
+        {
+            std::shared_ptr<MessageDispatch> result = removeFirst();
+            if (result != nullptr)
+            {
+                return result;
+            }
+        }
+
+        Thread::yield();
+    }
+
+    for (;;)
+    {
+        synchronized(&mutex)
+        {
+            // Announce the waiter before checking so that an enqueue that
+            // misses it is guaranteed to be seen by the check.
+            this->waiters.fetch_add(1);
+
+            // Wait until the channel is ready to deliver messages.
+            while (!closed && (isEmpty() || !running))
+            {
+                if (timeout == -1)
+                {
+                    mutex.wait();
+                }
+                else
+                {
+                    mutex.wait(timeout);
+                    break;
+                }
+            }
+
+            this->waiters.fetch_sub(1);
+        }
+
+        if (closed || !running)
+        {
+            return std::shared_ptr<MessageDispatch>();
+        }
+
+        // Another receiver may have taken the message first, only an
+        // infinite wait goes back to waiting for the next one.  A message
+        // its producer has not finished offering is worth another try.
+        std::shared_ptr<MessageDispatch> result = removeFirst();
+        if (result != nullptr || (timeout != -1 && isEmpty()))
+        {
+            return result;
+        }
+
+        Thread::yield();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<MessageDispatch>
+LockFreePriorityMessageDispatchChannel::dequeueNoWait()
+{
+    if (closed || !running || isEmpty())
+    {
+        return std::shared_ptr<MessageDispatch>();
+    }
+
+    return removeFirst();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<MessageDispatch> LockFreePriorityMessageDispatchChannel::peek()
+    const
+{
+    if (closed || !running || isEmpty())
+    {
+        return std::shared_ptr<MessageDispatch>();
+    }
+
+    for (int i = MAX_PRIORITIES - 1; i >= 0; --i)
+    {
+        if (this->lanes[i]->size() > 0)
+        {
+            std::shared_ptr<MessageDispatch> result = this->lanes[i]->peek();
+            if (result != nullptr)
+            {
+                return result;
+            }
+        }
+    }
+
+    return std::shared_ptr<MessageDispatch>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreePriorityMessageDispatchChannel::start()
+{
+    synchronized(&mutex)
+    {
+        if (!closed)
+        {
+            running = true;
+            mutex.notifyAll();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreePriorityMessageDispatchChannel::stop()
+{
+    synchronized(&mutex)
+    {
+        running = false;
+        mutex.notifyAll();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreePriorityMessageDispatchChannel::close()
+{
+    synchronized(&mutex)
+    {
+        if (!closed)
+        {
+            running = false;
+            closed  = true;
+        }
+        mutex.notifyAll();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreePriorityMessageDispatchChannel::clear()
+{
+    for (int i = 0; i < MAX_PRIORITIES; ++i)
+    {
+        this->enqueued.fetch_sub(this->lanes[i]->clear());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int LockFreePriorityMessageDispatchChannel::size() const
+{
+    int result = this->enqueued.load();
+    return result < 0 ? 0 : result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::shared_ptr<MessageDispatch>>
+LockFreePriorityMessageDispatchChannel::removeAll()
+{
+    std::vector<std::shared_ptr<MessageDispatch>> result;
+    for (int i = MAX_PRIORITIES - 1; i >= 0; --i)
+    {
+        this->enqueued.fetch_sub(this->lanes[i]->drainTo(result));
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MessageDispatchRing& LockFreePriorityMessageDispatchChannel::getLane(
+    const std::shared_ptr<MessageDispatch>& dispatch)
+{
+    int priority = cms::Message::DEFAULT_MSG_PRIORITY;
+
+    if (dispatch->getMessage() != nullptr)
+    {
+        priority = Math::max(dispatch->getMessage()->getPriority(), 0);
+        priority = Math::min(priority, MAX_PRIORITIES - 1);
+    }
+
+    return *this->lanes[priority];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<MessageDispatch>
+LockFreePriorityMessageDispatchChannel::removeFirst()
+{
+    for (int i = MAX_PRIORITIES - 1; i >= 0; --i)
+    {
+        if (this->lanes[i]->size() > 0)
+        {
+            std::shared_ptr<MessageDispatch> result = this->lanes[i]->poll();
+            if (result != nullptr)
+            {
+                this->enqueued.fetch_sub(1);
+                return result;
+            }
+        }
+    }
+
+    return std::shared_ptr<MessageDispatch>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreePriorityMessageDispatchChannel::signalWaiters()
+{
+    // Pairs with the waiter count taken in dequeue, the enqueued count was
+    // raised before this so a consumer that is not counted here will see
+    // the message before it parks.
+    if (this->waiters.load() > 0)
+    {
+        synchronized(&mutex)
+        {
+            mutex.notify();
+        }
+    }
+}
@@ -0,0 +1,170 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_LOCKFREEPRIORITYMESSAGEDISPATCHCHANNEL_H_
+#define _ACTIVEMQ_CORE_LOCKFREEPRIORITYMESSAGEDISPATCHCHANNEL_H_
+
+#include <activemq/core/MessageDispatchChannel.h>
+#include <activemq/core/MessageDispatchRing.h>
+#include <activemq/util/Config.h>
+
+#include <decaf/util/concurrent/Mutex.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace activemq
+{
+namespace core
+{
+
+    /**
+     * The lock free counterpart of SimplePriorityMessageDispatchChannel, each
+     * of the ten message priorities has a lane of its own backed by a
+     * MessageDispatchRing and dequeue takes from the highest priority lane
+     * that holds a message.
+     *
+     * Most messages are sent with the default priority so that lane is sized
+     * to the consumer's prefetch while the others start out smaller, any lane
+     * spills to a locked list rather than rejecting a message when it fills.
+     * Blocking dequeues spin then park as in LockFreeMessageDispatchChannel.
+     *
+     * @since 3.10
+     */
+    class AMQCPP_API LockFreePriorityMessageDispatchChannel
+        : public MessageDispatchChannel
+    {
+    private:
+        static const int MAX_PRIORITIES;
+
+        std::atomic<bool> closed;
+        std::atomic<bool> running;
+        std::atomic<int>  waiters;
+        std::atomic<int>  enqueued;
+
+        mutable decaf::util::concurrent::Mutex mutex;
+
+        std::vector<std::unique_ptr<MessageDispatchRing>> lanes;
+
+    private:
+        LockFreePriorityMessageDispatchChannel(
+            const LockFreePriorityMessageDispatchChannel&);
+        LockFreePriorityMessageDispatchChannel& operator=(
+            const LockFreePriorityMessageDispatchChannel&);
+
+    public:
+        /**
+         * Creates a new channel.
+         *
+         * @param capacity
+         *      The number of messages the default priority lane holds before
+         *      it spills to a locked list, usually the consumer's prefetch
+         *      size.
+         */
+        explicit LockFreePriorityMessageDispatchChannel(int capacity);
+
+        virtual ~LockFreePriorityMessageDispatchChannel();
+
+        virtual void enqueue(const std::shared_ptr<MessageDispatch>& message);
+
+        virtual void enqueueFirst(
+            const std::shared_ptr<MessageDispatch>& message);
+
+        virtual bool isEmpty() const;
+
+        virtual bool isClosed() const
+        {
+            return this->closed.load();
+        }
+
+        virtual bool isRunning() const
+        {
+            return this->running.load();
+        }
+
+        virtual std::shared_ptr<MessageDispatch> dequeue(long long timeout);
+
+        virtual std::shared_ptr<MessageDispatch> dequeueNoWait();
+
+        virtual std::shared_ptr<MessageDispatch> peek() const;
+
+        virtual void start();
+
+        virtual void stop();
+
+        virtual void close();
+
+        virtual void clear();
+
+        virtual int size() const;
+
+        virtual std::vector<std::shared_ptr<MessageDispatch>> removeAll();
+
+    public:
+        virtual void lock()
+        {
+            mutex.lock();
+        }
+
+        virtual bool tryLock()
+        {
+            return mutex.tryLock();
+        }
+
+        virtual void unlock()
+        {
+            mutex.unlock();
+        }
+
+        virtual void wait()
+        {
+            mutex.wait();
+        }
+
+        virtual void wait(long long millisecs)
+        {
+            mutex.wait(millisecs);
+        }
+
+        virtual void wait(long long millisecs, int nanos)
+        {
+            mutex.wait(millisecs, nanos);
+        }
+
+        virtual void notify()
+        {
+            mutex.notify();
+        }
+
+        virtual void notifyAll()
+        {
+            mutex.notifyAll();
+        }
+
+    private:
+        MessageDispatchRing& getLane(
+            const std::shared_ptr<MessageDispatch>& dispatch);
+
+        std::shared_ptr<MessageDispatch> removeFirst();
+
+        void signalWaiters();
+    };
+
+}  // namespace core
+}  // namespace activemq
+
+#endif /* _ACTIVEMQ_CORE_LOCKFREEPRIORITYMESSAGEDISPATCHCHANNEL_H_ */
@@ -0,0 +1,233 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MessageDispatchRing.h"
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+
+////////////////////////////////////////////////////////////////////////////////
+const int MessageDispatchRing::MIN_CAPACITY = 16;
+const int MessageDispatchRing::MAX_CAPACITY = 4096;
+
+////////////////////////////////////////////////////////////////////////////////
+MessageDispatchRing::MessageDispatchRing(int capacity)
+    : slots(),
+      mask(0),
+      tail(0),
+      head(0),
+      count(0),
+      spilled(0),
+      consumerLock(),
+      front(),
+      overflow()
+{
+    unsigned long long size = (unsigned long long)MIN_CAPACITY;
+    while (size < (unsigned long long)capacity &&
+           size < (unsigned long long)MAX_CAPACITY)
+    {
+        size <<= 1;
+    }
+
+    this->slots.reset(new Slot[size]);
+    this->mask = size - 1;
+
+    for (unsigned long long i = 0; i < size; ++i)
+    {
+        this->slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MessageDispatchRing::~MessageDispatchRing()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageDispatchRing::offer(const std::shared_ptr<MessageDispatch>& message)
+{
+    if (this->spilled.load(std::memory_order_acquire) == 0)
+    {
+        unsigned long long position = tail.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            Slot&              slot = this->slots[position & this->mask];
+            unsigned long long sequence =
+                slot.sequence.load(std::memory_order_acquire);
+            long long diff = (long long)(sequence - position);
+
+            if (diff == 0)
+            {
+                if (tail.compare_exchange_weak(position,
+                                               position + 1,
+                                               std::memory_order_relaxed))
+                {
+                    slot.value = message;
+                    slot.sequence.store(position + 1,
+                                        std::memory_order_release);
+                    this->count.fetch_add(1);
+                    return;
+                }
+            }
+            else if (diff < 0)
+            {
+                // The ring is full.
+                break;
+            }
+            else
+            {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(this->consumerLock);
+    this->overflow.push_back(message);
+    this->spilled.fetch_add(1);
+    this->count.fetch_add(1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageDispatchRing::offerFirst(
+    const std::shared_ptr<MessageDispatch>& message)
+{
+    std::lock_guard<std::mutex> lock(this->consumerLock);
+    this->front.push_front(message);
+    this->spilled.fetch_add(1);
+    this->count.fetch_add(1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<MessageDispatch> MessageDispatchRing::poll()
+{
+    std::lock_guard<std::mutex> lock(this->consumerLock);
+    return takeFirst();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<MessageDispatch> MessageDispatchRing::peek() const
+{
+    std::lock_guard<std::mutex> lock(this->consumerLock);
+    return peekFirst();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int MessageDispatchRing::drainTo(
+    std::vector<std::shared_ptr<MessageDispatch>>& result)
+{
+    std::lock_guard<std::mutex> lock(this->consumerLock);
+
+    int                              drained = 0;
+    std::shared_ptr<MessageDispatch> message;
+    while ((message = takeFirst()) != nullptr)
+    {
+        result.push_back(message);
+        drained++;
+    }
+
+    return drained;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int MessageDispatchRing::clear()
+{
+    std::lock_guard<std::mutex> lock(this->consumerLock);
+
+    int drained = 0;
+    while (takeFirst() != nullptr)
+    {
+        drained++;
+    }
+
+    return drained;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<MessageDispatch> MessageDispatchRing::takeFirst()
+{
+    std::shared_ptr<MessageDispatch> result;
+
+    if (!this->front.empty())
+    {
+        result = this->front.front();
+        this->front.pop_front();
+        this->spilled.fetch_sub(1);
+        this->count.fetch_sub(1);
+        return result;
+    }
+
+    // Messages still in the ring were offered before anything that spilled.
+    Slot&              slot     = this->slots[this->head & this->mask];
+    unsigned long long sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence == this->head + 1)
+    {
+        result.swap(slot.value);
+        slot.sequence.store(this->head + this->mask + 1,
+                            std::memory_order_release);
+        this->head++;
+        this->count.fetch_sub(1);
+        return result;
+    }
+
+    // A producer has claimed the slot but not published it yet, whatever
+    // spilled since was offered after it and has to wait its turn.
+    if (this->tail.load(std::memory_order_acquire) != this->head)
+    {
+        return result;
+    }
+
+    if (!this->overflow.empty())
+    {
+        result = this->overflow.front();
+        this->overflow.pop_front();
+        this->spilled.fetch_sub(1);
+        this->count.fetch_sub(1);
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<MessageDispatch> MessageDispatchRing::peekFirst() const
+{
+    if (!this->front.empty())
+    {
+        return this->front.front();
+    }
+
+    const Slot&        slot     = this->slots[this->head & this->mask];
+    unsigned long long sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence == this->head + 1)
+    {
+        return slot.value;
+    }
+
+    if (this->tail.load(std::memory_order_acquire) != this->head)
+    {
+        return std::shared_ptr<MessageDispatch>();
+    }
+
+    if (!this->overflow.empty())
+    {
+        return this->overflow.front();
+    }
+
+    return std::shared_ptr<MessageDispatch>();
+}
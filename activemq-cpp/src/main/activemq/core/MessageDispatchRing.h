@@ -0,0 +1,174 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_MESSAGEDISPATCHRING_H_
+#define _ACTIVEMQ_CORE_MESSAGEDISPATCHRING_H_
+
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/util/Config.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace activemq
+{
+namespace core
+{
+
+    using activemq::commands::MessageDispatch;
+
+    /**
+     * A bounded multi-producer, single-consumer queue of MessageDispatch
+     * instances used by the lock free MessageDispatchChannels.
+     *
+     * Producers claim a slot in a fixed size ring with a single CAS and so
+     * never block one another or the consumer.  When the ring is full, or
+     * when a message is pushed back to the front with offerFirst, the message
+     * is placed in a small locked spill list instead so that offer never
+     * fails; once anything has spilled, new messages follow it there until
+     * the consumer has drained it, which keeps each producer's messages in
+     * the order they were offered.
+     *
+     * The consumer side methods (poll, peek, drainTo and clear) are
+     * serialized by an internal lock that producers only take when they
+     * spill, so they can be called from any thread.
+     *
+     * @since 3.10
+     */
+    class AMQCPP_API MessageDispatchRing
+    {
+    public:
+        /**
+         * The smallest and largest number of slots in a ring, requested
+         * capacities are rounded up to a power of two within these bounds.
+         */
+        static const int MIN_CAPACITY;
+        static const int MAX_CAPACITY;
+
+    private:
+        struct Slot
+        {
+            std::atomic<unsigned long long>  sequence;
+            std::shared_ptr<MessageDispatch> value;
+        };
+
+        std::unique_ptr<Slot[]> slots;
+        unsigned long long      mask;
+
+        alignas(64) std::atomic<unsigned long long> tail;
+        alignas(64) unsigned long long head;
+
+        std::atomic<int> count;
+        std::atomic<int> spilled;
+
+        mutable std::mutex                           consumerLock;
+        std::deque<std::shared_ptr<MessageDispatch>> front;
+        std::deque<std::shared_ptr<MessageDispatch>> overflow;
+
+    private:
+        MessageDispatchRing(const MessageDispatchRing&);
+        MessageDispatchRing& operator=(const MessageDispatchRing&);
+
+    public:
+        /**
+         * Creates a new ring.
+         *
+         * @param capacity
+         *      The number of messages the ring should hold before spilling,
+         *      usually the prefetch size of the consumer it serves.
+         */
+        explicit MessageDispatchRing(int capacity);
+
+        ~MessageDispatchRing();
+
+        /**
+         * @return the number of slots in the ring.
+         */
+        int capacity() const
+        {
+            return (int)(this->mask + 1);
+        }
+
+        /**
+         * @return the number of messages held, including spilled ones.
+         */
+        int size() const
+        {
+            int result = this->count.load();
+            return result < 0 ? 0 : result;
+        }
+
+        /**
+         * Adds a message behind all those already offered, safe to call from
+         * any number of threads at once.
+         *
+         * @param message
+         *      The message to add.
+         */
+        void offer(const std::shared_ptr<MessageDispatch>& message);
+
+        /**
+         * Adds a message in front of all others, used to return a message that
+         * was dequeued but could not be delivered.
+         *
+         * @param message
+         *      The message to add.
+         */
+        void offerFirst(const std::shared_ptr<MessageDispatch>& message);
+
+        /**
+         * @return the first message, removed from the ring, or null if empty
+         *         or if the first one is still being offered.
+         */
+        std::shared_ptr<MessageDispatch> poll();
+
+        /**
+         * @return the first message, left in the ring, or null if empty.
+         */
+        std::shared_ptr<MessageDispatch> peek() const;
+
+        /**
+         * Removes every message and appends them in order to the given vector.
+         *
+         * @param result
+         *      The vector to append the messages to.
+         *
+         * @return the number of messages removed.
+         */
+        int drainTo(std::vector<std::shared_ptr<MessageDispatch>>& result);
+
+        /**
+         * Removes and discards every message.
+         *
+         * @return the number of messages removed.
+         */
+        int clear();
+
+    private:
+        // Both require the caller to hold the consumerLock.
+        std::shared_ptr<MessageDispatch> takeFirst();
+
+        std::shared_ptr<MessageDispatch> peekFirst() const;
+    };
+
+}  // namespace core
+}  // namespace activemq
+
+#endif /* _ACTIVEMQ_CORE_MESSAGEDISPATCHRING_H_ */
@@ -0,0 +1,155 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MessagePropertyTemplate.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+#include <activemq/wireformat/openwire/marshal/PrimitiveTypesMarshaller.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/IOException.h>
+#include <decaf/util/Iterator.h>
+
+#include <memory>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace activemq::util;
+using namespace activemq::wireformat::openwire::marshal;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+    void toBytes(ByteArrayOutputStream&      bytesOut,
+                 std::vector<unsigned char>& buffer)
+    {
+        std::pair<unsigned char*, int> array = bytesOut.toByteArray();
+        buffer.assign(array.first, array.first + array.second);
+        delete[] array.first;
+    }
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+MessagePropertyTemplate::MessagePropertyTemplate(
+    const util::PrimitiveMap& properties)
+    : properties(properties),
+      encoded(),
+      entries()
+{
+    try
+    {
+        if (!this->properties.isEmpty())
+        {
+            PrimitiveTypesMarshaller::marshal(&this->properties, this->encoded);
+        }
+
+        std::unique_ptr<Iterator<std::string>> keys(
+            this->properties.keySet().iterator());
+        while (keys->hasNext())
+        {
+            std::string key = keys->next();
+
+            ByteArrayOutputStream bytesOut;
+            DataOutputStream      dataOut(&bytesOut);
+            PrimitiveTypesMarshaller::marshalMapEntry(
+                dataOut,
+                key,
+                this->properties.get(key));
+
+            this->entries.push_back(
+                std::make_pair(key, std::vector<unsigned char>()));
+            toBytes(bytesOut, this->entries.back().second);
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MessagePropertyTemplate::~MessagePropertyTemplate()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessagePropertyTemplate::applyTo(commands::Message* message) const
+{
+    try
+    {
+        if (message == NULL || this->entries.empty())
+        {
+            return;
+        }
+
+        message->ensurePropertiesUnmarshaled();
+        const PrimitiveMap& own =
+            static_cast<const Message*>(message)->getMessageProperties();
+
+        if (own.isEmpty())
+        {
+            message->setEncodedProperties(this->encoded);
+            return;
+        }
+
+        // Only the Message's own properties are marshaled here, template
+        // entries it does not override are copied in already encoded.
+        int count = own.size();
+        for (size_t i = 0; i < this->entries.size(); ++i)
+        {
+            if (!own.containsKey(this->entries[i].first))
+            {
+                count++;
+            }
+        }
+
+        ByteArrayOutputStream bytesOut;
+        DataOutputStream      dataOut(&bytesOut);
+        dataOut.writeInt(count);
+
+        for (size_t i = 0; i < this->entries.size(); ++i)
+        {
+            const std::vector<unsigned char>& entry = this->entries[i].second;
+            if (!own.containsKey(this->entries[i].first))
+            {
+                dataOut.write(&entry[0], (int)entry.size());
+            }
+        }
+
+        std::unique_ptr<Iterator<std::string>> keys(own.keySet().iterator());
+        while (keys->hasNext())
+        {
+            std::string key = keys->next();
+            PrimitiveTypesMarshaller::marshalMapEntry(dataOut,
+                                                      key,
+                                                      own.get(key));
+        }
+
+        std::vector<unsigned char> combined;
+        toBytes(bytesOut, combined);
+        message->setEncodedProperties(combined);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
@@ -0,0 +1,104 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_MESSAGEPROPERTYTEMPLATE_H_
+#define _ACTIVEMQ_CORE_MESSAGEPROPERTYTEMPLATE_H_
+
+#include <activemq/util/Config.h>
+
+#include <activemq/commands/Message.h>
+#include <activemq/util/PrimitiveMap.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace activemq
+{
+namespace core
+{
+
+    /**
+     * A fixed set of Message properties that is encoded once and then added
+     * to many Messages, a Producer uses one to attach the same header
+     * properties to everything it sends without marshaling them each time.
+     *
+     * Properties a Message sets itself take precedence over those of the
+     * template with the same name, only the Message's own properties are
+     * encoded when it is sent.
+     */
+    class AMQCPP_API MessagePropertyTemplate
+    {
+    private:
+        MessagePropertyTemplate(const MessagePropertyTemplate&);
+        MessagePropertyTemplate& operator=(const MessagePropertyTemplate&);
+
+    private:
+        util::PrimitiveMap properties;
+
+        // The complete marshaled map, sent as is by Messages with no
+        // properties of their own.
+        std::vector<unsigned char> encoded;
+
+        // Each key with its marshaled map entry, in map order.
+        std::vector<std::pair<std::string, std::vector<unsigned char>>> entries;
+
+    public:
+        /**
+         * Creates a template holding a copy of the given properties.
+         *
+         * @param properties
+         *      The properties to add to each Message.
+         *
+         * @throws IOException if the properties cannot be marshaled.
+         */
+        MessagePropertyTemplate(const util::PrimitiveMap& properties);
+
+        ~MessagePropertyTemplate();
+
+        /**
+         * @return the properties this template adds to each Message.
+         */
+        const util::PrimitiveMap& getProperties() const
+        {
+            return this->properties;
+        }
+
+        /**
+         * @return the marshaled form of the template properties.
+         */
+        const std::vector<unsigned char>& getEncoded() const
+        {
+            return this->encoded;
+        }
+
+        /**
+         * Adds the template properties to the given Message, replacing its
+         * marshaled properties with the combined encoding of both sets.
+         *
+         * @param message
+         *      The Message that is about to be sent.
+         *
+         * @throws IOException if the Message properties cannot be decoded or
+         *         marshaled.
+         */
+        void applyTo(commands::Message* message) const;
+    };
+
+}  // namespace core
+}  // namespace activemq
+
+#endif /* _ACTIVEMQ_CORE_MESSAGEPROPERTYTEMPLATE_H_ */
@@ -28,6 +28,8 @@
 #include <activemq/core/ActiveMQConstants.h>
 #include <activemq/core/ActiveMQTransactionContext.h>
 #include <activemq/core/FifoMessageDispatchChannel.h>
+#include <activemq/core/LockFreeMessageDispatchChannel.h>
+#include <activemq/core/LockFreePriorityMessageDispatchChannel.h>
 #include <activemq/core/RedeliveryPolicy.h>
 #include <activemq/core/SimplePriorityMessageDispatchChannel.h>
 #include <activemq/core/kernels/ActiveMQSessionKernel.h>
@@ -127,12 +129,16 @@ namespace core
             bool                             transactedIndividualAck;
             bool                             nonBlockingRedelivery;
             bool                             consumerExpiryCheckEnabled;
+            bool                             zeroCopyDelivery;
+            bool                             lockFreeDispatch;
             bool                             optimizeAcknowledge;
             long long                        optimizeAckTimestamp;
             long long                        optimizeAcknowledgeTimeOut;
             long long                        optimizedAckScheduledAckInterval;
             Runnable*                        optimizedAckTask;
             int                              ackCounter;
+            bool                             ackBatching;
+            std::atomic<bool>                inAckBatch;
             int                              dispatchedCount;
             std::shared_ptr<ExecutorService> executor;
             ActiveMQSessionKernel*           session;
@@ -167,6 +173,8 @@ namespace core
                   transactedIndividualAck(false),
                   nonBlockingRedelivery(false),
                   consumerExpiryCheckEnabled(true),
+                  zeroCopyDelivery(false),
+                  lockFreeDispatch(false),
                   optimizeAcknowledge(false),
                   optimizeAckTimestamp(
                       std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -176,6 +184,8 @@ namespace core
                   optimizedAckScheduledAckInterval(),
                   optimizedAckTask(nullptr),
                   ackCounter(),
+                  ackBatching(false),
+                  inAckBatch(false),
                   dispatchedCount(),
                   executor(),
                   session(nullptr),
@@ -241,8 +251,13 @@ namespace core
                                 }
                                 else
                                 {
+                                    // Batched acks that were held back are
+                                    // redelivered and must reach the listener
+                                    // again rather than be dropped as
+                                    // duplicates.
                                     if (session->isClientAcknowledge() ||
-                                        session->isIndividualAcknowledge())
+                                        session->isIndividualAcknowledge() ||
+                                        ackBatching)
                                     {
                                         if (!info->isBrowser())
                                         {
@@ -273,6 +288,24 @@ namespace core
                 }
             }
 
+            // Empties the unconsumedMessages of a closed consumer, the broker
+            // redelivers them elsewhere so they must not be filtered as
+            // duplicates.
+            void discardUnconsumedMessages()
+            {
+                std::vector<std::shared_ptr<MessageDispatch>> list =
+                    unconsumedMessages->removeAll();
+                if (!info->isBrowser())
+                {
+                    for (std::size_t i = 0; i < list.size(); ++i)
+                    {
+                        session->getConnection()->rollbackDuplicate(
+                            parent,
+                            list[i]->getMessage());
+                    }
+                }
+            }
+
             void clearPreviouslyDelivered()
             {
                 if (previouslyDeliveredMessages != nullptr)
@@ -1126,7 +1159,22 @@ ActiveMQConsumerKernel::ActiveMQConsumerKernel(
         this->session->getConnection()->getRedeliveryPolicy()->clone());
     this->internal->scheduler = this->session->getScheduler();
 
-    if (this->session->getConnection()->isMessagePrioritySupported())
+    if (this->session->getConnection()->isUseLockFreeDispatch())
+    {
+        this->internal->lockFreeDispatch = true;
+
+        if (this->session->getConnection()->isMessagePrioritySupported())
+        {
+            this->internal->unconsumedMessages.reset(
+                new LockFreePriorityMessageDispatchChannel(prefetch));
+        }
+        else
+        {
+            this->internal->unconsumedMessages.reset(
+                new LockFreeMessageDispatchChannel(prefetch));
+        }
+    }
+    else if (this->session->getConnection()->isMessagePrioritySupported())
     {
         this->internal->unconsumedMessages.reset(
             new SimplePriorityMessageDispatchChannel());
@@ -1158,6 +1206,12 @@ ActiveMQConsumerKernel::ActiveMQConsumerKernel(
             session->getConnection()->getOptimizedAckScheduledAckInterval());
     }
 
+    if (session->isAckBatching() && !this->internal->optimizeAcknowledge &&
+        !consumerInfo->isBrowser())
+    {
+        this->internal->ackBatching = true;
+    }
+
     consumerInfo->setOptimizedAcknowledge(this->internal->optimizeAcknowledge);
     this->internal->failoverRedeliveryWaitPeriod =
         session->getConnection()->getConsumerFailoverRedeliveryWaitPeriod();
@@ -1414,21 +1468,7 @@ void ActiveMQConsumerKernel::dispose()
             }
 
             // Ensure these are filtered as duplicates.
-            std::vector<std::shared_ptr<MessageDispatch>> list =
-                this->internal->unconsumedMessages->removeAll();
-            if (!this->consumerInfo->isBrowser())
-            {
-                std::vector<std::shared_ptr<MessageDispatch>>::const_iterator
-                    iter = list.begin();
-
-                for (; iter != list.end(); ++iter)
-                {
-                    std::shared_ptr<MessageDispatch> md = *iter;
-                    this->session->getConnection()->rollbackDuplicate(
-                        this,
-                        md->getMessage());
-                }
-            }
+            this->internal->discardUnconsumedMessages();
 
             // If we encountered an error, propagate it.
             if (haveException)
@@ -1799,7 +1839,11 @@ void ActiveMQConsumerKernel::afterMessageIsConsumed(
             return;
         }
 
-        if (isAutoAcknowledgeEach())
+        if (isAutoAcknowledgeEach() && this->internal->ackBatching)
+        {
+            batchAck();
+        }
+        else if (isAutoAcknowledgeEach())
         {
             bool deliveringExpected = false;
             if (this->internal->deliveringAcks.compare_exchange_strong(
@@ -1896,6 +1940,84 @@ void ActiveMQConsumerKernel::afterMessageIsConsumed(
     AMQ_CATCHALL_THROW(ActiveMQException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumerKernel::batchAck()
+{
+    // Don't let the broker stall on a prefetch window that is full of
+    // consumed Messages waiting on the rest of the batch.
+    bool windowFull = false;
+    synchronized(&this->internal->deliveredMessages)
+    {
+        windowFull = this->internal->deliveredMessages.size() >=
+                     Math::max(1, this->consumerInfo->getPrefetchSize() / 2);
+    }
+
+    if (windowFull)
+    {
+        flushBatchedAcks();
+    }
+    else
+    {
+        bool join = !this->internal->inAckBatch.exchange(true);
+        this->session->batchAck(this->consumerInfo->getConsumerId(), join);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumerKernel::flushBatchedAcks()
+{
+    // Anything consumed after this point joins the next batch.
+    this->internal->inAckBatch.store(false);
+
+    if (this->internal->unconsumedMessages->isClosed())
+    {
+        return;
+    }
+
+    bool deliveringExpected = false;
+    if (!this->internal->deliveringAcks.compare_exchange_strong(
+            deliveringExpected,
+            true))
+    {
+        // An ack already being delivered was made before some of the held
+        // Messages were consumed, so stay in the batch until they are sent.
+        if (!this->internal->inAckBatch.exchange(true))
+        {
+            this->session->rejoinAckBatch(this->consumerInfo->getConsumerId());
+        }
+        return;
+    }
+
+    try
+    {
+        // Dispatch isn't held up while the ack is on the wire, deliveringAcks
+        // still keeps any other ack from overtaking it.
+        std::shared_ptr<MessageAck> ack;
+        synchronized(&this->internal->deliveredMessages)
+        {
+            ack = makeAckForAllDeliveredMessages(
+                ActiveMQConstants::ACK_TYPE_CONSUMED);
+            if (ack != nullptr)
+            {
+                this->internal->deliveredMessages.clear();
+            }
+        }
+
+        if (ack != nullptr)
+        {
+            this->session->sendAck(ack);
+        }
+    }
+    catch (Exception& ex)
+    {
+        this->internal->deliveringAcks.store(false);
+        this->session->getConnection()->onAsyncException(ex);
+        return;
+    }
+
+    this->internal->deliveringAcks.store(false);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConsumerKernel::deliverAcks()
 {
@@ -2346,6 +2468,13 @@ void ActiveMQConsumerKernel::dispatch(
 
     try
     {
+        AMQ_RECORD_EVENT(
+            "ActiveMQConsumerKernel",
+            "dispatch() consumer={} producerSeq={} redelivery={}",
+            this->consumerInfo->getConsumerId()->getValue(),
+            dispatch->getMessage()->getMessageId()->getProducerSequenceId(),
+            dispatch->getRedeliveryCounter());
+
         if (AMQ_LOG_DEBUG_ENABLED())
         {
             std::string messageId =
@@ -2370,10 +2499,13 @@ void ActiveMQConsumerKernel::dispatch(
         AMQ_LOG_DEBUG("ActiveMQConsumerKernel",
                       "dispatch(): Clear methods completed");
 
-        synchronized(this->internal->unconsumedMessages.get())
+        // Enqueuing on a lock free channel needs no outer lock, delivery to
+        // a listener is still serialized by the listenerMutex.
+        Lock channelLock(this->internal->unconsumedMessages.get(),
+                         !this->internal->lockFreeDispatch);
         {
             AMQ_LOG_DEBUG("ActiveMQConsumerKernel",
-                          "dispatch(): Acquired unconsumedMessages lock");
+                          "dispatch(): Checking unconsumedMessages");
 
             if (!this->internal->unconsumedMessages->isClosed())
             {
@@ -2524,6 +2656,14 @@ void ActiveMQConsumerKernel::dispatch(
                             }
                             this->internal->unconsumedMessages->enqueue(
                                 dispatch);
+                            if (this->internal->lockFreeDispatch &&
+                                this->internal->unconsumedMessages->isClosed())
+                            {
+                                // Without the lock close() may already have
+                                // emptied the channel, do what it does.
+                                this->internal->discardUnconsumedMessages();
+                                return;
+                            }
                             if (this->internal->messageAvailableListener !=
                                 nullptr)
                             {
@@ -2591,9 +2731,13 @@ std::unique_ptr<cms::Message> ActiveMQConsumerKernel::createCMSMessage(
     try
     {
         // Use cloneDataStructure() to get a raw pointer we fully own,
-        // then wrap it in unique_ptr to enable release() semantics.
+        // then wrap it in unique_ptr to enable release() semantics.  With
+        // zero copy delivery the clone shares the received body bytes and
+        // only copies them if the application modifies the Message.
         std::unique_ptr<Message> message(
-            dispatch->getMessage()->cloneDataStructure());
+            this->internal->zeroCopyDelivery
+                ? dispatch->getMessage()->cloneSharedDataStructure()
+                : dispatch->getMessage()->cloneDataStructure());
         if (this->internal->transformer != nullptr)
         {
             cms::Message* source = dynamic_cast<cms::Message*>(message.get());
@@ -2751,6 +2895,8 @@ void ActiveMQConsumerKernel::inProgressClearRequired()
     // Clears dispatched messages async to avoid lock contention with inprogress
     // acks.
     this->internal->isClearDeliveredList = true;
+    // The Session has reset its ack batch, the next held ack joins anew.
+    this->internal->inAckBatch.store(false);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2902,6 +3048,8 @@ void ActiveMQConsumerKernel::applyDestinationOptions(
         options.getProperty("consumer.transactedIndividualAck", "false"));
     this->internal->consumerExpiryCheckEnabled = Boolean::parseBoolean(
         options.getProperty("consumer.consumerExpiryCheckEnabled", "true"));
+    this->internal->zeroCopyDelivery = Boolean::parseBoolean(
+        options.getProperty("consumer.zeroCopyDelivery", "false"));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3133,6 +3281,18 @@ void ActiveMQConsumerKernel::setConsumerExpiryCheckEnabled(
     this->internal->consumerExpiryCheckEnabled = consumerExpiryCheckEnabled;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConsumerKernel::isZeroCopyDelivery() const
+{
+    return this->internal->zeroCopyDelivery;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumerKernel::setZeroCopyDelivery(bool zeroCopyDelivery)
+{
+    this->internal->zeroCopyDelivery = zeroCopyDelivery;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool ActiveMQConsumerKernel::isRedeliveryExpectedInCurrentTransaction(
     std::shared_ptr<MessageDispatch> dispatch) const
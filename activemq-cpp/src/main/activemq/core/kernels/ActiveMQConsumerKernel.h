@@ -230,6 +230,12 @@ namespace core
              */
             void deliverAcks();
 
+            /**
+             * Sends one range ack for the consumed Messages whose acks this
+             * consumer is holding back for its Session's ack batch.
+             */
+            void flushBatchedAcks();
+
             /**
              * Called on a Failover to clear any pending messages.
              */
@@ -405,6 +411,25 @@ namespace core
              */
             void setConsumerExpiryCheckEnabled(bool consumerExpiryCheckEnabled);
 
+            /**
+             * @return true if delivered Messages share their body with the
+             * received MessageDispatch instead of being deep copied.
+             */
+            bool isZeroCopyDelivery() const;
+
+            /**
+             * Configures whether the Messages handed to the application share
+             * their body bytes with the received Message.  The shared bytes
+             * are copied the first time the application modifies the Message
+             * so the received copy is never changed.  This feature is disabled
+             * by default and can be enabled with the destination option
+             * consumer.zeroCopyDelivery=true.
+             *
+             * @param zeroCopyDelivery
+             *      True if delivered Messages should share the received body.
+             */
+            void setZeroCopyDelivery(bool zeroCopyDelivery);
+
             /**
              * Returns true if the given MessageDispatch is expected to be
              * redelivered in the currently open transaction.  This would be
@@ -470,6 +495,8 @@ namespace core
             void ackLater(std::shared_ptr<commands::MessageDispatch> message,
                           int                                        ackType);
 
+            void batchAck();
+
             void immediateIndividualTransactedAck(
                 std::shared_ptr<commands::MessageDispatch> dispatch);
 
@@ -50,6 +50,7 @@ ActiveMQProducerKernel::ActiveMQProducerKernel(
     long long                                    sendTimeout)
     : disableTimestamps(false),
       disableMessageId(false),
+      copyMessageOnSend(true),
       defaultDeliveryMode(cms::Message::DEFAULT_DELIVERY_MODE),
       defaultPriority(cms::Message::DEFAULT_MSG_PRIORITY),
       defaultTimeToLive(cms::Message::DEFAULT_TIME_TO_LIVE),
@@ -60,7 +61,8 @@ ActiveMQProducerKernel::ActiveMQProducerKernel(
       memoryUsage(),
       destination(),
       messageSequence(),
-      transformer()
+      transformer(),
+      propertyTemplate()
 {
     if (session == nullptr || producerId == nullptr)
     {
@@ -77,6 +79,7 @@ ActiveMQProducerKernel::ActiveMQProducerKernel(
     this->producerInfo->setDestination(destination);
     this->producerInfo->setWindowSize(
         session->getConnection()->getProducerWindowSize());
+    this->copyMessageOnSend = session->getConnection()->isCopyMessageOnSend();
 
     // Get any options specified in the destination and apply them to the
     // ProducerInfo object.
@@ -85,6 +88,9 @@ ActiveMQProducerKernel::ActiveMQProducerKernel(
         const ActiveMQProperties& options = destination->getOptions();
         this->producerInfo->setDispatchAsync(Boolean::parseBoolean(
             options.getProperty("producer.dispatchAsync", "false")));
+        this->copyMessageOnSend = Boolean::parseBoolean(
+            options.getProperty("producer.copyMessageOnSend",
+                                Boolean::toString(this->copyMessageOnSend)));
 
         this->destination =
             std::dynamic_pointer_cast<cms::Destination>(destination);
@@ -419,6 +425,25 @@ void ActiveMQProducerKernel::send(const cms::Destination* destination,
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducerKernel::setPropertyTemplate(
+    const util::PrimitiveMap& properties)
+{
+    try
+    {
+        if (properties.isEmpty())
+        {
+            this->propertyTemplate.reset();
+        }
+        else
+        {
+            this->propertyTemplate.reset(
+                new MessagePropertyTemplate(properties));
+        }
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQProducerKernel::onProducerAck(const commands::ProducerAck& ack)
 {
@@ -26,6 +26,7 @@
 
 #include <activemq/commands/ProducerAck.h>
 #include <activemq/commands/ProducerInfo.h>
+#include <activemq/core/MessagePropertyTemplate.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/util/Config.h>
 #include <activemq/util/LongSequenceGenerator.h>
@@ -51,6 +52,9 @@ namespace core
             // Disable adding a Message Id
             bool disableMessageId;
 
+            // Copy each Message before it is sent
+            bool copyMessageOnSend;
+
             // The default delivery Mode of this Producer
             int defaultDeliveryMode;
 
@@ -85,6 +89,9 @@ namespace core
             // Used to tranform Message before sending them to the CMS bus.
             cms::MessageTransformer* transformer;
 
+            // Properties added to every Message sent, NULL if none.
+            std::shared_ptr<MessagePropertyTemplate> propertyTemplate;
+
         private:
             ActiveMQProducerKernel(const ActiveMQProducerKernel&);
             ActiveMQProducerKernel& operator=(const ActiveMQProducerKernel&);
@@ -236,6 +243,48 @@ namespace core
                 return this->disableTimestamps;
             }
 
+            /**
+             * Sets if Messages are copied before this Producer sends them, when
+             * disabled the application must not modify or delete a Message
+             * until send returns or its AsyncCallback is called.
+             * @param value - boolean indicating enable / disable (true / false)
+             */
+            void setCopyMessageOnSend(bool value)
+            {
+                this->copyMessageOnSend = value;
+            }
+
+            /**
+             * Gets if Messages are copied before this Producer sends them
+             * @return boolean indicating state of enable / disable (true /
+             * false)
+             */
+            bool isCopyMessageOnSend() const
+            {
+                return this->copyMessageOnSend;
+            }
+
+            /**
+             * Sets properties that are added to every Message this Producer
+             * sends, they are marshaled once here rather than once for each
+             * Message.  A property the Message sets itself takes precedence
+             * over one of the same name here.  An empty map removes the
+             * template.
+             *
+             * @param properties
+             *      The properties to add to each Message sent.
+             */
+            void setPropertyTemplate(const util::PrimitiveMap& properties);
+
+            /**
+             * @return the properties added to every Message sent, or NULL if
+             *         no template has been set.
+             */
+            std::shared_ptr<MessagePropertyTemplate> getPropertyTemplate() const
+            {
+                return this->propertyTemplate;
+            }
+
             /**
              * Sets the Priority that this Producers sends messages at
              * @param priority int value for Priority level
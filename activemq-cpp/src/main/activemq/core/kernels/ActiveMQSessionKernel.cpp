@@ -60,6 +60,8 @@
 #include <decaf/util/concurrent/locks/ReentrantReadWriteLock.h>
 #include <atomic>
 #include <chrono>
+#include <memory>
+#include <unordered_map>
 
 using namespace std;
 using namespace activemq;
@@ -84,12 +86,221 @@ namespace core
 
         class CloseSynhcronization;
 
+        /**
+         * Holds the consumers of an AUTO_ACKNOWLEDGE Session that have consumed
+         * Messages whose acks are being held back.  The batch is sent once it
+         * counts ackBatchSize Messages, or by a one shot task scheduled when
+         * its first ack is held that runs once the time out has passed.
+         * Sending the batch has each consumer send one range ack for all the
+         * Messages it holds.
+         */
+        class AckBatch : public std::enable_shared_from_this<AckBatch>
+        {
+        private:
+            Mutex                                                mutex;
+            std::vector<std::shared_ptr<ActiveMQConsumerKernel>> consumers;
+            int                                                  pending;
+            long long                                            generation;
+            bool                                                 closed;
+            std::shared_ptr<Scheduler>                           scheduler;
+            const int                                            size;
+            const long long                                      timeOut;
+
+        private:
+            AckBatch(const AckBatch&);
+            AckBatch& operator=(const AckBatch&);
+
+        public:
+            AckBatch(std::shared_ptr<Scheduler> scheduler,
+                     int                        size,
+                     long long                  timeOut)
+                : mutex(),
+                  consumers(),
+                  pending(0),
+                  generation(1),
+                  closed(false),
+                  scheduler(scheduler),
+                  size(size),
+                  timeOut(timeOut)
+            {
+            }
+
+            /**
+             * Counts one more held ack, the consumer is given the first time
+             * it holds one in this batch.  Returns true once the batch is full.
+             */
+            bool add(const std::shared_ptr<ActiveMQConsumerKernel>& consumer)
+            {
+                long long started = 0;
+                bool      full    = false;
+                synchronized(&mutex)
+                {
+                    started = hold(consumer);
+                    full    = !closed && pending >= size;
+                }
+
+                scheduleFlush(started);
+                return full;
+            }
+
+            /**
+             * Puts back a consumer whose held acks could not be sent when the
+             * batch was flushed, it is flushed again once the time out passes.
+             */
+            void rejoin(const std::shared_ptr<ActiveMQConsumerKernel>& consumer)
+            {
+                long long started = 0;
+                synchronized(&mutex)
+                {
+                    started = hold(consumer);
+                }
+
+                scheduleFlush(started);
+            }
+
+            void flush()
+            {
+                std::vector<std::shared_ptr<ActiveMQConsumerKernel>> held;
+                synchronized(&mutex)
+                {
+                    held.swap(consumers);
+                    pending = 0;
+                    generation++;
+                }
+
+                for (std::size_t i = 0; i < held.size(); ++i)
+                {
+                    held[i]->flushBatchedAcks();
+                }
+            }
+
+            /**
+             * Flushes the batch if it is still the one the task that calls
+             * this was scheduled for, a batch sent since then means the task
+             * has been cancelled.
+             */
+            void flush(long long batchGeneration)
+            {
+                synchronized(&mutex)
+                {
+                    if (batchGeneration != generation || pending == 0)
+                    {
+                        return;
+                    }
+                }
+
+                flush();
+            }
+
+            /**
+             * Forgets the held acks without sending them, the consumers
+             * clear the Messages they were held for themselves.
+             */
+            void reset()
+            {
+                synchronized(&mutex)
+                {
+                    consumers.clear();
+                    pending = 0;
+                    generation++;
+                }
+            }
+
+            /**
+             * Resets the batch and stops it from scheduling any more flushes.
+             */
+            void close()
+            {
+                synchronized(&mutex)
+                {
+                    closed = true;
+                }
+
+                reset();
+            }
+
+        private:
+            // Called with the mutex held, returns the generation whose flush
+            // is to be scheduled when this ack starts a batch, zero otherwise.
+            long long hold(
+                const std::shared_ptr<ActiveMQConsumerKernel>& consumer)
+            {
+                if (closed)
+                {
+                    return 0;
+                }
+
+                if (consumer != nullptr)
+                {
+                    consumers.push_back(consumer);
+                }
+
+                return pending++ == 0 ? generation : 0;
+            }
+
+            void scheduleFlush(long long batchGeneration);
+        };
+
+        /**
+         * Sends a Session's held acks once their time out has passed when no
+         * further Message filled the batch, runs once on the connection's
+         * Scheduler.
+         */
+        class AckBatchTask : public Runnable
+        {
+        private:
+            std::shared_ptr<AckBatch> batch;
+            long long                 generation;
+
+        private:
+            AckBatchTask(const AckBatchTask&);
+            AckBatchTask& operator=(const AckBatchTask&);
+
+        public:
+            AckBatchTask(std::shared_ptr<AckBatch> batch, long long generation)
+                : Runnable(),
+                  batch(batch),
+                  generation(generation)
+            {
+            }
+
+            virtual ~AckBatchTask()
+            {
+            }
+
+            virtual void run()
+            {
+                batch->flush(generation);
+            }
+        };
+
+        void AckBatch::scheduleFlush(long long batchGeneration)
+        {
+            if (batchGeneration == 0)
+            {
+                return;
+            }
+
+            // The time out is in microseconds, round up so the task never
+            // runs before it has passed.
+            this->scheduler->executeAfterDelay(
+                new AckBatchTask(shared_from_this(), batchGeneration),
+                (this->timeOut + 999) / 1000);
+        }
+
         class SessionConfig
         {
         private:
             SessionConfig(const SessionConfig&);
             SessionConfig& operator=(const SessionConfig&);
 
+        public:
+            typedef std::unordered_map<std::shared_ptr<ConsumerId>,
+                                       std::shared_ptr<ActiveMQConsumerKernel>,
+                                       ConsumerId::HASH,
+                                       ConsumerId::EQUAL_TO>
+                ConsumerIndex;
+
         public:
             std::atomic<bool> synchronizationRegistered;
             decaf::util::concurrent::locks::ReentrantReadWriteLock producerLock;
@@ -98,8 +309,10 @@ namespace core
             decaf::util::concurrent::locks::ReentrantReadWriteLock consumerLock;
             decaf::util::LinkedList<std::shared_ptr<ActiveMQConsumerKernel>>
                                                   consumers;
+            ConsumerIndex                         consumerIndex;
             std::shared_ptr<Scheduler>            scheduler;
             std::shared_ptr<CloseSynhcronization> closeSync;
+            std::shared_ptr<AckBatch>             ackBatch;
             Mutex                                 sendMutex;
             cms::MessageTransformer*              transformer;
             int                                   hashCode;
@@ -112,8 +325,10 @@ namespace core
                   producers(),
                   consumerLock(),
                   consumers(),
+                  consumerIndex(),
                   scheduler(),
                   closeSync(),
+                  ackBatch(),
                   sendMutex(),
                   transformer(nullptr),
                   hashCode(),
@@ -276,6 +491,17 @@ ActiveMQSessionKernel::ActiveMQSessionKernel(
     // Use the Connection's Scheduler.
     this->config->scheduler = this->connection->getScheduler();
 
+    // Batched acks only apply to plain auto acknowledge, the held acks are
+    // also sent from the Scheduler when no further Message arrives in time.
+    if (ackMode == cms::Session::AUTO_ACKNOWLEDGE &&
+        connection->getAckBatchSize() > 0)
+    {
+        this->config->ackBatch =
+            std::make_shared<AckBatch>(this->config->scheduler,
+                                       connection->getAckBatchSize(),
+                                       connection->getAckBatchTimeOut());
+    }
+
     AMQ_LOG_INFO("SessionKernel",
                  "Session created, sessionId=" << id->toString()
                                                << " ackMode=" << (int)ackMode);
@@ -435,6 +661,12 @@ void ActiveMQSessionKernel::dispose()
         // Stop the dispatch executor.
         stop();
 
+        // Held acks are sent by each consumer's dispose below.
+        if (this->config->ackBatch != nullptr)
+        {
+            this->config->ackBatch->close();
+        }
+
         // Dispose of all Consumers, the dispose method skips the RemoveInfo
         // command.
         this->config->consumerLock.writeLock().lock();
@@ -465,6 +697,7 @@ void ActiveMQSessionKernel::dispose()
                 }
             }
             this->config->consumers.clear();
+            this->config->consumerIndex.clear();
             this->config->consumerLock.writeLock().unlock();
         }
         catch (Exception& ex)
@@ -621,6 +854,13 @@ void ActiveMQSessionKernel::clearMessagesInProgress(
         this->executor->clearMessagesInProgress();
     }
 
+    // The consumers drop the Messages whose acks were held, the broker
+    // redelivers them.
+    if (this->config->ackBatch != nullptr)
+    {
+        this->config->ackBatch->reset();
+    }
+
     this->config->consumerLock.readLock().lock();
     try
     {
@@ -688,6 +928,52 @@ void ActiveMQSessionKernel::deliverAcks()
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQSessionKernel::isAckBatching() const
+{
+    return this->config->ackBatch != nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionKernel::batchAck(std::shared_ptr<ConsumerId> consumerId,
+                                     bool                        join)
+{
+    std::shared_ptr<AckBatch> batch = this->config->ackBatch;
+    if (batch == nullptr)
+    {
+        return;
+    }
+
+    std::shared_ptr<ActiveMQConsumerKernel> consumer;
+    if (join)
+    {
+        consumer = lookupConsumerKernel(consumerId);
+    }
+
+    if (batch->add(consumer))
+    {
+        batch->flush();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionKernel::rejoinAckBatch(
+    std::shared_ptr<ConsumerId> consumerId)
+{
+    std::shared_ptr<AckBatch> batch = this->config->ackBatch;
+    if (batch == nullptr)
+    {
+        return;
+    }
+
+    std::shared_ptr<ActiveMQConsumerKernel> consumer =
+        lookupConsumerKernel(consumerId);
+    if (consumer != nullptr)
+    {
+        batch->rejoin(consumer);
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 cms::MessageConsumer* ActiveMQSessionKernel::createConsumer(
     const cms::Destination* destination)
@@ -1256,26 +1542,33 @@ void ActiveMQSessionKernel::send(
             id->setProducerSequenceId(sequenceId);
 
             // NOTE:
-            // Now we copy the message before sending, this allows the user to
-            // reuse the message object without interfering with the copy that's
-            // being sent.  We could make this step optional to increase
-            // performance but for now we won't. To not do this implies that the
-            // user must never reuse the message object, or know that the
-            // configuration of Transports doesn't involve the message hanging
-            // around beyond the point that send returns.  When the transform
-            // step results in a new Message object being created we can just
-            // use that new instance, but when the original cms::Message pointer
-            // was already a commands::Message then we need to clone it.
+            // By default we copy the message before sending, this allows the
+            // user to reuse the message object without interfering with the
+            // copy that's being sent.  When the transform step results in a
+            // new Message object being created we can just use that new
+            // instance, but when the original cms::Message pointer was already
+            // a commands::Message then we need to clone it.  A producer that
+            // disables copyMessageOnSend sends the original in place instead,
+            // the user then must not reuse or delete it until send returns or
+            // the AsyncCallback is called.  Anything that keeps the message
+            // longer, such as the failover state tracker or the failover
+            // transport's map of unanswered requests, takes its own copy.
+            bool sendsOriginal = false;
             if (ActiveMQMessageTransformation::transformMessage(message,
                                                                 connection,
                                                                 &transformed))
             {
                 amqMessage.reset(transformed);
             }
-            else
+            else if (producer->isCopyMessageOnSend())
             {
                 amqMessage.reset(transformed->cloneDataStructure());
             }
+            else
+            {
+                amqMessage.reset(transformed, [](commands::Message*) {});
+                sendsOriginal = true;
+            }
 
             // Sets the Message ID on the original message per spec.
             message->setCMSMessageID(id->toString());
@@ -1294,6 +1587,20 @@ void ActiveMQSessionKernel::send(
             amqMessage->onSend();
             amqMessage->setProducerId(producerId);
 
+            std::shared_ptr<MessagePropertyTemplate> propertyTemplate =
+                producer->getPropertyTemplate();
+            if (propertyTemplate != nullptr)
+            {
+                // The template only ever goes into a copy, the caller's
+                // Message keeps its own properties.  The copy shares the body.
+                if (sendsOriginal)
+                {
+                    amqMessage.reset(amqMessage->cloneSharedDataStructure());
+                }
+
+                propertyTemplate->applyTo(amqMessage.get());
+            }
+
             AMQ_LOG_DEBUG("SessionKernel",
                           "Sending message, msgId="
                               << id->toString()
@@ -1580,7 +1887,7 @@ std::string ActiveMQSessionKernel::createTemporaryDestinationName()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ActiveMQSessionKernel::oneway(std::shared_ptr<Command> command)
+void ActiveMQSessionKernel::oneway(const std::shared_ptr<Command>& command)
 {
     try
     {
@@ -1630,6 +1937,7 @@ void ActiveMQSessionKernel::addConsumer(
         try
         {
             this->config->consumers.add(consumer);
+            this->config->consumerIndex[consumer->getConsumerId()] = consumer;
             this->config->consumerLock.writeLock().unlock();
         }
         catch (Exception& ex)
@@ -1666,6 +1974,7 @@ void ActiveMQSessionKernel::removeConsumer(
         try
         {
             this->config->consumers.remove(consumer);
+            this->config->consumerIndex.erase(consumer->getConsumerId());
             // Only remove audited dispatcher if connection is still open
             // This prevents accessing destroyed ConnectionAudit.
             if (!connectionClosed)
@@ -1772,20 +2081,16 @@ ActiveMQSessionKernel::lookupProducerKernel(std::shared_ptr<ProducerId> id)
 std::shared_ptr<ActiveMQConsumerKernel>
 ActiveMQSessionKernel::lookupConsumerKernel(std::shared_ptr<ConsumerId> id)
 {
+    std::shared_ptr<ActiveMQConsumerKernel> consumer;
+
     this->config->consumerLock.readLock().lock();
     try
     {
-        std::shared_ptr<Iterator<std::shared_ptr<ActiveMQConsumerKernel>>> iter(
-            this->config->consumers.iterator());
-
-        while (iter->hasNext())
+        SessionConfig::ConsumerIndex::const_iterator iter =
+            this->config->consumerIndex.find(id);
+        if (iter != this->config->consumerIndex.end())
         {
-            std::shared_ptr<ActiveMQConsumerKernel> consumer = iter->next();
-            if (consumer->getConsumerId()->equals(*id))
-            {
-                this->config->consumerLock.readLock().unlock();
-                return consumer;
-            }
+            consumer = iter->second;
         }
         this->config->consumerLock.readLock().unlock();
     }
@@ -1795,7 +2100,7 @@ ActiveMQSessionKernel::lookupConsumerKernel(std::shared_ptr<ConsumerId> id)
         throw;
     }
 
-    return std::shared_ptr<ActiveMQConsumerKernel>();
+    return consumer;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1991,6 +2296,25 @@ void ActiveMQSessionKernel::setSessionAsyncDispatch(bool sessionAsyncDispatch)
     this->config->sessionAsyncDispatch = sessionAsyncDispatch;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQSessionKernel::getDispatchQueueDepth() const
+{
+    return this->executor != nullptr ? this->executor->getQueueDepth() : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ActiveMQSessionKernel::getDispatchIterationCount() const
+{
+    return this->executor != nullptr ? this->executor->getIterationCount()
+                                     : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ActiveMQSessionKernel::getDispatchIterationTime() const
+{
+    return this->executor != nullptr ? this->executor->getIterationTime() : 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 decaf::util::ArrayList<std::shared_ptr<ActiveMQConsumerKernel>>
 ActiveMQSessionKernel::getConsumers() const
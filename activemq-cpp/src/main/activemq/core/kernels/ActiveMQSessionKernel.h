@@ -395,7 +395,7 @@ namespace core
              * @throws ActiveMQException if not currently connected, or if the
              *         operation fails for any reason.
              */
-            void oneway(std::shared_ptr<commands::Command> command);
+            void oneway(const std::shared_ptr<commands::Command>& command);
 
             /**
              * Sends a synchronous request and returns the response from the
@@ -498,6 +498,36 @@ namespace core
              */
             void deliverAcks();
 
+            /**
+             * @return true if this Session holds back the acks of its
+             * consumers and sends them in batches.
+             */
+            bool isAckBatching() const;
+
+            /**
+             * Called by a consumer of this Session that consumed a Message and
+             * is holding back its ack, once the batch is full or has waited
+             * too long every consumer in it sends its held acks.
+             *
+             * @param consumerId
+             *      The Id of the consumer holding back the ack.
+             * @param join
+             *      True for the first ack the consumer holds in this batch.
+             */
+            void batchAck(std::shared_ptr<commands::ConsumerId> consumerId,
+                          bool                                  join);
+
+            /**
+             * Called by a consumer of this Session whose held acks could not be
+             * sent when its batch was flushed, the consumer is put back into
+             * the current batch so the acks are sent once it is due.
+             *
+             * @param consumerId
+             *      The Id of the consumer still holding back acks.
+             */
+            void rejoinAckBatch(
+                std::shared_ptr<commands::ConsumerId> consumerId);
+
             /**
              * Request that this Session inform all of its consumers to clear
              * all messages that are currently in progress.
@@ -639,6 +669,24 @@ namespace core
              */
             void setSessionAsyncDispatch(bool sessionAsyncDispatch);
 
+            /**
+             * @return the number of messages queued in this Session waiting to
+             * be dispatched to its consumers.
+             */
+            int getDispatchQueueDepth() const;
+
+            /**
+             * @return the number of times this Session's dispatch task has been
+             * run by its dedicated Thread or by the shared pool.
+             */
+            long long getDispatchIterationCount() const;
+
+            /**
+             * @return the total time in nanoseconds this Session's dispatch
+             * task has been running.
+             */
+            long long getDispatchIterationTime() const;
+
             /**
              * Returns an ArrayList containing a copy of all consumers currently
              * in use on this Session.  Since this list is copied from the main
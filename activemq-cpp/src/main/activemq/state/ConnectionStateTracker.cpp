@@ -17,28 +17,46 @@
 
 #include "ConnectionStateTracker.h"
 
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/OutputStream.h>
 #include <decaf/lang/Runnable.h>
 #include <decaf/util/HashCode.h>
 #include <decaf/util/LinkedHashMap.h>
 #include <decaf/util/MapEntry.h>
 #include <decaf/util/NoSuchElementException.h>
+#include <decaf/util/concurrent/Concurrent.h>
 #include <decaf/util/concurrent/ConcurrentStlMap.h>
+#include <decaf/util/concurrent/Mutex.h>
 
 #include <activemq/commands/ConsumerControl.h>
 #include <activemq/commands/ExceptionResponse.h>
 #include <activemq/commands/RemoveInfo.h>
 #include <activemq/core/ActiveMQConstants.h>
+#include <activemq/transport/IOTransport.h>
 #include <activemq/transport/TransportListener.h>
 #include <activemq/wireformat/WireFormat.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <activemq/wireformat/openwire/marshal/DataStreamMarshaller.h>
+#include <activemq/wireformat/openwire/utils/BooleanStream.h>
+#include <activemq/wireformat/openwire/utils/ByteReader.h>
+
+#include <algorithm>
+#include <deque>
+#include <vector>
 
 using namespace activemq;
 using namespace activemq::core;
 using namespace activemq::state;
 using namespace activemq::commands;
 using namespace activemq::exceptions;
+using namespace activemq::transport;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::marshal;
+using namespace activemq::wireformat::openwire::utils;
 using namespace decaf;
 using namespace decaf::lang;
 using namespace decaf::util;
+using namespace decaf::util::concurrent;
 using namespace decaf::io;
 using namespace decaf::lang::exceptions;
 
@@ -110,6 +128,259 @@ namespace state
         }
     };
 
+    /**
+     * Writes into a fixed region of the MessageArena ring, the region is sized
+     * from the first marshal pass so the second can never run past it.
+     */
+    class ArenaOutputStream : public OutputStream
+    {
+    private:
+        unsigned char* position;
+        unsigned char* end;
+
+    private:
+        ArenaOutputStream(const ArenaOutputStream&);
+        ArenaOutputStream& operator=(const ArenaOutputStream&);
+
+    public:
+        ArenaOutputStream(unsigned char* position, unsigned char* end)
+            : OutputStream(),
+              position(position),
+              end(end)
+        {
+        }
+
+        virtual ~ArenaOutputStream()
+        {
+        }
+
+    protected:
+        virtual void doWriteByte(unsigned char value)
+        {
+            if (position == end)
+            {
+                throw IOException(__FILE__,
+                                  __LINE__,
+                                  "Marshalled Message overran its arena slot");
+            }
+
+            *position++ = value;
+        }
+
+        virtual void doWriteArrayBounded(const unsigned char* buffer,
+                                         int size AMQCPP_UNUSED,
+                                         int offset,
+                                         int length)
+        {
+            if (length > end - position)
+            {
+                throw IOException(__FILE__,
+                                  __LINE__,
+                                  "Marshalled Message overran its arena slot");
+            }
+
+            std::copy(buffer + offset, buffer + offset + length, position);
+            position += length;
+        }
+    };
+
+    /**
+     * Holds the tracked Messages as OpenWire frames in one ring buffer whose
+     * size is the message cache budget, the oldest entries are dropped to make
+     * room for new ones.  The frames are written with a private tight encoded
+     * wire format that has the marshal cache disabled so they never refer to
+     * state that belongs to any one connection.  On restore they go to the
+     * socket as they are when the new connection negotiated the same encoding,
+     * otherwise they are read back into Commands and sent through the new
+     * connection's own wire format.
+     */
+    class MessageArena
+    {
+    private:
+        struct Entry
+        {
+            std::size_t offset;
+            std::size_t length;
+        };
+
+        std::vector<unsigned char> ring;
+        std::deque<Entry>          entries;
+        std::size_t                limit;
+        std::size_t                tail;
+        OpenWireFormat             wireFormat;
+
+    private:
+        MessageArena(const MessageArena&);
+        MessageArena& operator=(const MessageArena&);
+
+    public:
+        Mutex mutex;
+
+    public:
+        MessageArena()
+            : ring(),
+              entries(),
+              limit(0),
+              tail(0),
+              wireFormat(Properties()),
+              mutex()
+        {
+            wireFormat.setVersion(OpenWireFormat::MAX_SUPPORTED_VERSION);
+            wireFormat.setTightEncodingEnabled(true);
+            wireFormat.setCacheEnabled(false);
+        }
+
+        void clear()
+        {
+            entries.clear();
+            tail = 0;
+        }
+
+        /**
+         * Marshals the Message into the ring as a size prefixed frame, a
+         * Message larger than the budget is kept on its own until the next one
+         * arrives.  The ring only ever grows, a smaller budget drops the
+         * entries instead.  Must be called with the mutex locked.
+         */
+        void add(Message* message, int budget)
+        {
+            unsigned char         type = message->getDataStructureType();
+            DataStreamMarshaller* dsm  = wireFormat.getMarshaller(type);
+            if (dsm == NULL)
+            {
+                throw IOException(__FILE__,
+                                  __LINE__,
+                                  "No marshaller for the tracked Message");
+            }
+
+            BooleanStream bs;
+            int           size = 1;
+            size += dsm->tightMarshal1(&wireFormat, message, &bs);
+            size += bs.marshalledSize();
+            std::size_t length = 4 + (std::size_t)size;
+
+            std::size_t capacity =
+                std::max((std::size_t)std::max(budget, 0), length);
+            if (capacity > ring.size())
+            {
+                // Entries keep their offsets in the larger ring.
+                ring.resize(capacity);
+            }
+            else if (capacity < limit)
+            {
+                clear();
+            }
+            limit = capacity;
+
+            std::size_t offset = reserve(length);
+
+            ArenaOutputStream stream(&ring[0] + offset,
+                                     &ring[0] + offset + length);
+            DataOutputStream  dataOut(&stream);
+            dataOut.writeInt(size);
+            dataOut.writeByte(type);
+            bs.marshal(&dataOut);
+            dsm->tightMarshal2(&wireFormat, message, &dataOut, &bs);
+
+            Entry entry = {offset, length};
+            entries.push_back(entry);
+            tail = offset + length;
+        }
+
+        /**
+         * Returns true if the given wire format reads the stored frames the
+         * same way the arena wrote them, so they can be sent without being
+         * decoded first.
+         */
+        bool isReplayableOn(const OpenWireFormat* target) const
+        {
+            return target != NULL &&
+                   target->getVersion() == wireFormat.getVersion() &&
+                   target->isTightEncodingEnabled() &&
+                   !target->isCacheEnabled() &&
+                   !target->isSizePrefixDisabled();
+        }
+
+        /**
+         * Writes every stored frame to the Transport in the order they were
+         * added, entries that sit next to each other in the ring go out in a
+         * single write.  Must be called with the mutex locked.
+         */
+        void replay(IOTransport* transport)
+        {
+            std::deque<Entry>::const_iterator iter = entries.begin();
+            while (iter != entries.end())
+            {
+                std::size_t offset = iter->offset;
+                std::size_t end    = offset + iter->length;
+                int         frames = 1;
+
+                while (++iter != entries.end() && iter->offset == end)
+                {
+                    end += iter->length;
+                    frames++;
+                }
+
+                transport->writeFrames(&ring[0] + offset,
+                                       (int)(end - offset),
+                                       frames);
+            }
+        }
+
+        /**
+         * Reads every Message in the ring back in the order they were added.
+         * Must be called with the mutex locked.
+         */
+        void restore(std::vector<std::shared_ptr<Command>>& messages)
+        {
+            messages.reserve(messages.size() + entries.size());
+
+            for (std::deque<Entry>::const_iterator iter = entries.begin();
+                 iter != entries.end();
+                 ++iter)
+            {
+                ByteReader reader(&ring[0] + iter->offset, iter->length);
+                messages.push_back(wireFormat.unmarshal(NULL, &reader));
+            }
+        }
+
+    private:
+        /**
+         * Finds a contiguous run of length bytes for the next entry, dropping
+         * the oldest entries until one opens up.
+         */
+        std::size_t reserve(std::size_t length)
+        {
+            while (!entries.empty())
+            {
+                std::size_t head = entries.front().offset;
+
+                if (tail > head)
+                {
+                    // Live bytes sit in [head, tail), room at either end.
+                    if (tail + length <= limit)
+                    {
+                        return tail;
+                    }
+                    else if (length <= head)
+                    {
+                        return 0;
+                    }
+                }
+                else if (tail + length <= head)
+                {
+                    // Wrapped, the only room is the gap before the head.
+                    return tail;
+                }
+
+                entries.pop_front();
+            }
+
+            tail = 0;
+            return 0;
+        }
+    };
+
     class StateTrackerImpl
     {
     private:
@@ -135,12 +406,16 @@ namespace state
         /** Store MessagePull commands for replay */
         MessagePullCache messagePullCache;
 
+        /** Store Messages as bytes if trackMessageBytes == true */
+        MessageArena messageArena;
+
         StateTrackerImpl(ConnectionStateTracker* parent)
             : parent(parent),
               TRACKED_RESPONSE_MARKER(std::make_shared<Tracked>()),
               connectionStates(),
               messageCache(parent),
-              messagePullCache(parent)
+              messagePullCache(parent),
+              messageArena()
         {
         }
 
@@ -151,6 +426,7 @@ namespace state
                 connectionStates.clear();
                 messageCache.clear();
                 messagePullCache.clear();
+                messageArena.clear();
             }
             AMQ_CATCHALL_NOTHROW()
         }
@@ -205,6 +481,7 @@ ConnectionStateTracker::ConnectionStateTracker()
       restoreProducers(true),
       restoreTransaction(true),
       trackMessages(true),
+      trackMessageBytes(false),
       trackTransactionProducers(true),
       maxMessageCacheSize(128 * 1024),
       maxMessagePullCacheSize(10)
@@ -249,14 +526,17 @@ void ConnectionStateTracker::trackBack(std::shared_ptr<Command> command)
     {
         if (command)
         {
-            if (trackMessages && command->isMessage())
+            if (trackMessages && !trackMessageBytes && command->isMessage())
             {
                 std::shared_ptr<Message> message =
                     std::dynamic_pointer_cast<Message>(command);
                 if (!message->getTransactionId())
                 {
-                    this->impl->messageCache.currentCacheSize +=
-                        message->getSize();
+                    synchronized(&this->impl->messageCache)
+                    {
+                        this->impl->messageCache.currentCacheSize +=
+                            message->getSize();
+                    }
                 }
             }
         }
@@ -304,6 +584,33 @@ void ConnectionStateTracker::restore(
             transport->oneway(messages->next());
         }
 
+        // The stored frames skip the decode when the new connection reads
+        // them the same way.  Writing them to the IOTransport directly keeps
+        // their order since every oneway above has already reached it.
+        std::vector<std::shared_ptr<Command>> arenaMessages;
+        synchronized(&this->impl->messageArena.mutex)
+        {
+            IOTransport* ioTransport = dynamic_cast<IOTransport*>(
+                transport->narrow(typeid(IOTransport)));
+            const OpenWireFormat* openWire =
+                dynamic_cast<const OpenWireFormat*>(
+                    transport->getWireFormat().get());
+
+            if (ioTransport != NULL &&
+                this->impl->messageArena.isReplayableOn(openWire))
+            {
+                this->impl->messageArena.replay(ioTransport);
+            }
+            else
+            {
+                this->impl->messageArena.restore(arenaMessages);
+            }
+        }
+        for (std::size_t i = 0; i < arenaMessages.size(); ++i)
+        {
+            transport->oneway(arenaMessages[i]);
+        }
+
         std::shared_ptr<Iterator<std::shared_ptr<Command>>> messagePullIter(
             this->impl->messagePullCache.values().iterator());
         while (messagePullIter->hasNext())
@@ -516,6 +823,15 @@ std::shared_ptr<Command> ConnectionStateTracker::processDestinationInfo(
 {
     try
     {
+        // DestinationInfo visits here for both operations, a removal must not
+        // record the destination again.
+        if (info != NULL &&
+            info->getOperationType() ==
+                ActiveMQConstants::DESTINATION_REMOVE_OPERATION)
+        {
+            return processRemoveDestination(info);
+        }
+
         if (info != NULL)
         {
             std::shared_ptr<ConnectionState> cs =
@@ -854,11 +1170,21 @@ std::shared_ptr<Command> ConnectionStateTracker::processMessage(Message* message
                 }
                 return this->impl->TRACKED_RESPONSE_MARKER;
             }
+            else if (trackMessages && trackMessageBytes)
+            {
+                synchronized(&this->impl->messageArena.mutex)
+                {
+                    this->impl->messageArena.add(message, maxMessageCacheSize);
+                }
+            }
             else if (trackMessages)
             {
-                this->impl->messageCache.put(
-                    message->getMessageId(),
-                    std::shared_ptr<Message>(message->cloneDataStructure()));
+                std::shared_ptr<Message> copy(message->cloneDataStructure());
+                synchronized(&this->impl->messageCache)
+                {
+                    this->impl->messageCache.put(message->getMessageId(),
+                                                 copy);
+                }
             }
         }
 
@@ -1100,9 +1426,11 @@ std::shared_ptr<Command> ConnectionStateTracker::processMessagePull(
         {
             std::string id = pull->getDestination()->toString() +
                              "::" + pull->getConsumerId()->toString();
-            this->impl->messagePullCache.put(
-                id,
-                std::shared_ptr<Command>(pull->cloneDataStructure()));
+            std::shared_ptr<Command> copy(pull->cloneDataStructure());
+            synchronized(&this->impl->messagePullCache)
+            {
+                this->impl->messagePullCache.put(id, copy);
+            }
         }
 
         return std::shared_ptr<Command>();
@@ -51,6 +51,7 @@ namespace state
         bool restoreProducers;
         bool restoreTransaction;
         bool trackMessages;
+        bool trackMessageBytes;
         bool trackTransactionProducers;
         int  maxMessageCacheSize;
         int  maxMessagePullCacheSize;
@@ -180,6 +181,23 @@ namespace state
             this->trackMessages = trackMessages;
         }
 
+        bool isTrackMessageBytes() const
+        {
+            return this->trackMessageBytes;
+        }
+
+        /**
+         * When enabled the tracked Messages are held only in their marshalled
+         * form, packed into a ring of getMaxMessageCacheSize() bytes, instead
+         * of as cloned Message objects.
+         *
+         * @param trackMessageBytes - true to keep tracked Messages as bytes.
+         */
+        void setTrackMessageBytes(bool trackMessageBytes)
+        {
+            this->trackMessageBytes = trackMessageBytes;
+        }
+
         int getMaxMessageCacheSize() const
         {
             return this->maxMessageCacheSize;
@@ -0,0 +1,302 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PooledTaskRunner.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+#include <atomic>
+
+using namespace activemq;
+using namespace activemq::threads;
+using namespace activemq::exceptions;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq
+{
+namespace threads
+{
+
+    class PooledTaskRunnerImpl
+        : public std::enable_shared_from_this<PooledTaskRunnerImpl>
+    {
+    private:
+        PooledTaskRunnerImpl(const PooledTaskRunnerImpl&);
+        PooledTaskRunnerImpl& operator=(const PooledTaskRunnerImpl&);
+
+    public:
+        mutable Mutex             mutex;
+        std::shared_ptr<Executor> executor;
+        Task*                     task;
+        int                       maxIterationsPerRun;
+
+        // queued    - a run has been handed to the executor or will be once
+        //             the current run ends.
+        // iterating - the task is being run by runningThread.
+        bool              started;
+        std::atomic<bool> stopped;
+        bool              queued;
+        bool              iterating;
+        Thread*           runningThread;
+
+    public:
+        PooledTaskRunnerImpl(const std::shared_ptr<Executor>& executor,
+                             Task*                            task,
+                             int maxIterationsPerRun)
+            : mutex(),
+              executor(executor),
+              task(task),
+              maxIterationsPerRun(maxIterationsPerRun),
+              started(false),
+              stopped(false),
+              queued(false),
+              iterating(false),
+              runningThread(NULL)
+        {
+        }
+
+        // Must be called with the mutex held.
+        void submit();
+
+        void runTask();
+    };
+
+    // Owned by the Executor, keeps the runner state alive until the run is
+    // complete even if the PooledTaskRunner is destroyed meanwhile.
+    class PooledTaskRunnerRun : public Runnable
+    {
+    private:
+        std::shared_ptr<PooledTaskRunnerImpl> impl;
+
+    public:
+        PooledTaskRunnerRun(const std::shared_ptr<PooledTaskRunnerImpl>& impl)
+            : Runnable(),
+              impl(impl)
+        {
+        }
+
+        virtual ~PooledTaskRunnerRun()
+        {
+        }
+
+        virtual void run()
+        {
+            impl->runTask();
+        }
+    };
+
+}  // namespace threads
+}  // namespace activemq
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunnerImpl::submit()
+{
+    try
+    {
+        this->executor->execute(new PooledTaskRunnerRun(shared_from_this()));
+    }
+    catch (Exception&)
+    {
+        // The executor is shutting down, nothing more will be run.
+        this->queued = false;
+        this->mutex.notifyAll();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunnerImpl::runTask()
+{
+    synchronized(&mutex)
+    {
+        this->queued = false;
+        if (this->stopped)
+        {
+            mutex.notifyAll();
+            return;
+        }
+
+        this->iterating     = true;
+        this->runningThread = Thread::currentThread();
+    }
+
+    bool done = false;
+    try
+    {
+        for (int i = 0; i < this->maxIterationsPerRun; ++i)
+        {
+            if (!this->task->iterate())
+            {
+                done = true;
+                break;
+            }
+
+            if (this->stopped)
+            {
+                break;
+            }
+        }
+    }
+    AMQ_CATCHALL_NOTHROW()
+
+    synchronized(&mutex)
+    {
+        this->iterating     = false;
+        this->runningThread = NULL;
+        mutex.notifyAll();
+
+        if (this->stopped)
+        {
+            this->queued = false;
+            return;
+        }
+
+        // Either the task has more work than one run allows or there was a
+        // wakeup while it was running, both need another run.
+        if (!done)
+        {
+            this->queued = true;
+        }
+
+        if (this->queued)
+        {
+            submit();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PooledTaskRunner::PooledTaskRunner(const std::shared_ptr<Executor>& executor,
+                                   Task*                            task,
+                                   int maxIterationsPerRun)
+    : impl()
+{
+    if (executor == NULL)
+    {
+        throw NullPointerException(__FILE__,
+                                   __LINE__,
+                                   "Executor passed was null");
+    }
+
+    if (task == NULL)
+    {
+        throw NullPointerException(__FILE__, __LINE__, "Task passed was null");
+    }
+
+    this->impl = std::make_shared<PooledTaskRunnerImpl>(
+        executor,
+        task,
+        maxIterationsPerRun > 0 ? maxIterationsPerRun : 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PooledTaskRunner::~PooledTaskRunner()
+{
+    try
+    {
+        this->shutdown();
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunner::start()
+{
+    synchronized(&impl->mutex)
+    {
+        if (impl->started || impl->stopped)
+        {
+            return;
+        }
+
+        impl->started = true;
+    }
+
+    this->wakeup();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool PooledTaskRunner::isStarted() const
+{
+    bool result = false;
+
+    synchronized(&impl->mutex)
+    {
+        result = impl->started;
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunner::shutdown(long long timeout)
+{
+    synchronized(&impl->mutex)
+    {
+        impl->stopped = true;
+
+        // The task can shut down its own runner from within iterate, waiting
+        // for the iteration to end would then never return.
+        if (impl->iterating &&
+            impl->runningThread != Thread::currentThread())
+        {
+            impl->mutex.wait(timeout);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunner::shutdown()
+{
+    synchronized(&impl->mutex)
+    {
+        impl->stopped = true;
+
+        while (impl->iterating &&
+               impl->runningThread != Thread::currentThread())
+        {
+            impl->mutex.wait();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunner::wakeup()
+{
+    synchronized(&impl->mutex)
+    {
+        if (!impl->started || impl->stopped || impl->queued)
+        {
+            return;
+        }
+
+        impl->queued = true;
+
+        // A running task is submitted again by runTask once it is done.
+        if (!impl->iterating)
+        {
+            impl->submit();
+        }
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_THREADS_POOLEDTASKRUNNER_H_
+#define _ACTIVEMQ_THREADS_POOLEDTASKRUNNER_H_
+
+#include <activemq/threads/Task.h>
+#include <activemq/threads/TaskRunner.h>
+#include <activemq/util/Config.h>
+
+#include <decaf/util/concurrent/Executor.h>
+
+#include <memory>
+
+namespace activemq
+{
+namespace threads
+{
+
+    class PooledTaskRunnerImpl;
+
+    /**
+     * A TaskRunner that runs its Task on a shared Executor instead of on a
+     * Thread of its own.  The Task is never run by more than one thread at a
+     * time, so any number of PooledTaskRunners can share the Threads of one
+     * Executor while each one still runs its Task serially.
+     *
+     * To keep a busy Task from holding on to a pooled Thread the Task is put
+     * back at the end of the Executor's queue after it has been iterated a
+     * fixed number of times.
+     *
+     * @since 3.10
+     */
+    class AMQCPP_API PooledTaskRunner : public TaskRunner
+    {
+    private:
+        std::shared_ptr<PooledTaskRunnerImpl> impl;
+
+    private:
+        PooledTaskRunner(const PooledTaskRunner&);
+        PooledTaskRunner& operator=(const PooledTaskRunner&);
+
+    public:
+        /**
+         * Creates a new PooledTaskRunner.
+         *
+         * @param executor
+         *      The Executor that runs the Task, shared with other runners.
+         * @param task
+         *      The Task to run, the caller retains ownership.
+         * @param maxIterationsPerRun
+         *      The number of times the Task is iterated before it yields its
+         *      pooled Thread to other runners.
+         *
+         * @throws NullPointerException if the executor or task is NULL.
+         */
+        PooledTaskRunner(
+            const std::shared_ptr<decaf::util::concurrent::Executor>& executor,
+            Task*                                                      task,
+            int maxIterationsPerRun = 1000);
+
+        virtual ~PooledTaskRunner();
+
+        virtual void start();
+
+        virtual bool isStarted() const;
+
+        /**
+         * Shutdown after a timeout, does not guarantee that the task's iterate
+         * method has completed.
+         *
+         * @param timeout - Time in Milliseconds to wait for the task to stop.
+         */
+        virtual void shutdown(long long timeout);
+
+        /**
+         * Shutdown once the task's iterate method is no longer running, when
+         * called from within the task it returns at once.
+         */
+        virtual void shutdown();
+
+        /**
+         * Signal the TaskRunner to wakeup and execute another iteration cycle
+         * on the task, the Task instance will be run until its iterate method
+         * has returned false indicating it is done.
+         */
+        virtual void wakeup();
+    };
+
+}  // namespace threads
+}  // namespace activemq
+
+#endif /*_ACTIVEMQ_THREADS_POOLEDTASKRUNNER_H_*/
@@ -19,6 +19,7 @@
 
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/util/Config.h>
+#include <decaf/lang/System.h>
 #include <decaf/lang/exceptions/UnsupportedOperationException.h>
 #include <decaf/util/concurrent/Concurrent.h>
 #include <typeinfo>
@@ -35,7 +36,8 @@ using namespace decaf::util::concurrent;
 
 ////////////////////////////////////////////////////////////////////////////////
 FutureResponse::FutureResponse()
-    : responseLatch(1),
+    : mutex(),
+      completed(false),
       response(),
       responseCallback()
 {
@@ -44,7 +46,8 @@ FutureResponse::FutureResponse()
 ////////////////////////////////////////////////////////////////////////////////
 FutureResponse::FutureResponse(
     const std::shared_ptr<ResponseCallback> responseCallback)
-    : responseLatch(1),
+    : mutex(),
+      completed(false),
       response(),
       responseCallback(responseCallback)
 {
@@ -55,13 +58,43 @@ FutureResponse::~FutureResponse()
 {
 }
 
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+// Waits for completion, a negative timeout waits forever.
+std::shared_ptr<Response> awaitResponse(
+    Mutex&                           mutex,
+    const bool&                      done,
+    const std::shared_ptr<Response>& value,
+    long long                        timeout = -1)
+{
+    std::shared_ptr<Response> result;
+
+    synchronized(&mutex)
+    {
+        long long deadline  = System::currentTimeMillis() + timeout;
+        long long remaining = timeout;
+
+        while (!done && (timeout < 0 || remaining > 0))
+        {
+            mutex.wait(timeout < 0 ? 0 : remaining);
+            remaining = deadline - System::currentTimeMillis();
+        }
+
+        result = value;
+    }
+
+    return result;
+}
+}  // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 std::shared_ptr<Response> FutureResponse::getResponse() const
 {
     try
     {
-        this->responseLatch.await();
-        return response;
+        return awaitResponse(this->mutex, this->completed, this->response);
     }
     catch (decaf::lang::exceptions::InterruptedException& ex)
     {
@@ -78,8 +111,7 @@ std::shared_ptr<Response> FutureResponse::getResponse()
 {
     try
     {
-        this->responseLatch.await();
-        return response;
+        return awaitResponse(this->mutex, this->completed, this->response);
     }
     catch (decaf::lang::exceptions::InterruptedException& ex)
     {
@@ -96,8 +128,10 @@ std::shared_ptr<Response> FutureResponse::getResponse(unsigned int timeout) cons
 {
     try
     {
-        this->responseLatch.await(timeout);
-        return response;
+        return awaitResponse(this->mutex,
+                             this->completed,
+                             this->response,
+                             timeout);
     }
     catch (decaf::lang::exceptions::InterruptedException& ex)
     {
@@ -113,8 +147,10 @@ std::shared_ptr<Response> FutureResponse::getResponse(unsigned int timeout)
 {
     try
     {
-        this->responseLatch.await(timeout);
-        return response;
+        return awaitResponse(this->mutex,
+                             this->completed,
+                             this->response,
+                             timeout);
     }
     catch (decaf::lang::exceptions::InterruptedException& ex)
     {
@@ -128,10 +164,25 @@ std::shared_ptr<Response> FutureResponse::getResponse(unsigned int timeout)
 ////////////////////////////////////////////////////////////////////////////////
 void FutureResponse::setResponse(std::shared_ptr<Response> response)
 {
-    this->response = response;
-    this->responseLatch.countDown();
+    synchronized(&this->mutex)
+    {
+        this->response  = response;
+        this->completed = true;
+        this->mutex.notifyAll();
+    }
+
     if (responseCallback)
     {
-        responseCallback->onComplete(this->response);
+        responseCallback->onComplete(response);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FutureResponse::reset()
+{
+    synchronized(&this->mutex)
+    {
+        this->response.reset();
+        this->completed = false;
     }
 }
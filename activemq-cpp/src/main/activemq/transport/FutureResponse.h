@@ -46,9 +46,14 @@ namespace transport
     class AMQCPP_API FutureResponse
     {
     private:
-        mutable decaf::util::concurrent::CountDownLatch responseLatch;
-        std::shared_ptr<Response>                       response;
-        std::shared_ptr<ResponseCallback>               responseCallback;
+        mutable decaf::util::concurrent::Mutex mutex;
+        bool                                   completed;
+        std::shared_ptr<Response>              response;
+        std::shared_ptr<ResponseCallback>      responseCallback;
+
+    private:
+        FutureResponse(const FutureResponse&);
+        FutureResponse& operator=(const FutureResponse&);
 
     public:
         FutureResponse();
@@ -87,6 +92,13 @@ namespace transport
          * @param response the response object for the request.
          */
         void setResponse(std::shared_ptr<Response> response);
+
+        /**
+         * Returns this future to its initial state so that it can be reused
+         * for another request.  The caller must ensure that no thread is
+         * waiting on or completing this future.
+         */
+        void reset();
     };
 
 }  // namespace transport
@@ -25,11 +25,14 @@
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/util/AMQLog.h>
 #include <activemq/util/Config.h>
+#include <activemq/wireformat/FrameDecoder.h>
 #include <activemq/wireformat/WireFormat.h>
 #include <activemq/wireformat/openwire/OpenWireFormat.h>
 #include <decaf/lang/exceptions/UnsupportedOperationException.h>
 #include <decaf/util/concurrent/Concurrent.h>
 #include <atomic>
+#include <chrono>
+#include <thread>
 #include <typeinfo>
 
 using namespace activemq;
@@ -104,6 +107,39 @@ namespace transport
         std::atomic<bool>                       closed;
         std::atomic<bool>                       started;
 
+        // Push driven read mode, see setAsyncReadSocket.
+        std::shared_ptr<decaf::net::Socket>       asyncSocket;
+        int                                       readBufferSize;
+        std::unique_ptr<wireformat::FrameDecoder> frameDecoder;
+        std::atomic<bool>                         asyncReading;
+
+        /**
+         * The frames written between two flushes, every writer that added a
+         * frame to it waits for the flush and sees the same result.
+         */
+        struct WriteBatch
+        {
+            bool                         flushed;
+            std::shared_ptr<IOException> error;
+
+            WriteBatch()
+                : flushed(false),
+                  error()
+            {
+            }
+        };
+
+        // Write coalescing, pendingFrames, flushScheduled and writeBatch are
+        // guarded by the outputStream's monitor.  writersWaiting counts the
+        // writers that have not yet got the monitor to add their frame.
+        int                         writeCoalesceMicros;
+        int                         pendingFrames;
+        bool                        flushScheduled;
+        std::shared_ptr<WriteBatch> writeBatch;
+        std::atomic<int>            writersWaiting;
+        std::atomic<long long> writeFlushCount;
+        std::atomic<long long> writeFrameCount;
+
         IOTransportImpl()
             : wireFormat(),
               listener(NULL),
@@ -111,7 +147,18 @@ namespace transport
               outputStream(NULL),
               thread(),
               closed(false),
-              started(false)
+              started(false),
+              asyncSocket(),
+              readBufferSize(8192),
+              frameDecoder(),
+              asyncReading(false),
+              writeCoalesceMicros(0),
+              pendingFrames(0),
+              flushScheduled(false),
+              writeBatch(new WriteBatch()),
+              writersWaiting(0),
+              writeFlushCount(0),
+              writeFrameCount(0)
         {
         }
 
@@ -122,9 +169,63 @@ namespace transport
               outputStream(NULL),
               thread(),
               closed(false),
-              started(false)
+              started(false),
+              asyncSocket(),
+              readBufferSize(8192),
+              frameDecoder(),
+              asyncReading(false),
+              writeCoalesceMicros(0),
+              pendingFrames(0),
+              flushScheduled(false),
+              writeBatch(new WriteBatch()),
+              writersWaiting(0),
+              writeFlushCount(0),
+              writeFrameCount(0)
         {
         }
+
+        /**
+         * Flushes every frame written since the last flush, the caller must
+         * hold the outputStream's monitor.
+         */
+        void flushPendingFrames()
+        {
+            int frames          = this->pendingFrames;
+            this->pendingFrames = 0;
+
+            this->outputStream->flush();
+
+            this->writeFlushCount.fetch_add(1);
+            this->writeFrameCount.fetch_add(frames);
+        }
+
+        /**
+         * Flushes the current batch and starts the next one, then wakes the
+         * writers waiting on it.  The caller must hold the outputStream's
+         * monitor.
+         */
+        void flushWriteBatch()
+        {
+            std::shared_ptr<WriteBatch> batch = this->writeBatch;
+            this->writeBatch.reset(new WriteBatch());
+            this->flushScheduled = false;
+
+            try
+            {
+                this->flushPendingFrames();
+            }
+            catch (IOException& ex)
+            {
+                batch->error.reset(new IOException(ex));
+            }
+            catch (Exception& ex)
+            {
+                batch->error.reset(new IOException(ex));
+            }
+
+            batch->flushed = true;
+            this->outputStream->notifyAll();
+        }
     };
 
 }  // namespace transport
@@ -201,6 +302,11 @@ void IOTransport::fire(const std::shared_ptr<Command> command)
             return;
         }
 
+        AMQ_RECORD_EVENT("IOTransport",
+                         "fire() cmdId={} type={cmd}",
+                         command->getCommandId(),
+                         command->getDataStructureType());
+
         // Log detailed message information for MessageDispatch commands
         if (command->isMessageDispatch())
         {
@@ -213,7 +319,7 @@ void IOTransport::fire(const std::shared_ptr<Command> command)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void IOTransport::oneway(const std::shared_ptr<Command> command)
+void IOTransport::oneway(const std::shared_ptr<Command>& command)
 {
     try
     {
@@ -224,8 +330,8 @@ void IOTransport::oneway(const std::shared_ptr<Command> command)
                               "IOTransport::oneway() - transport is closed!");
         }
 
-        // Make sure the thread has been started.
-        if (!impl->thread)
+        // Make sure the reader has been started.
+        if (!impl->thread && !impl->asyncReading.load())
         {
             throw IOException(
                 __FILE__,
@@ -250,19 +356,77 @@ void IOTransport::oneway(const std::shared_ptr<Command> command)
                               "IOTransport::oneway() - invalid output stream");
         }
 
+        AMQ_RECORD_EVENT("IOTransport",
+                         "oneway() cmdId={} type={cmd}",
+                         command->getCommandId(),
+                         command->getDataStructureType());
+
         AMQ_LOG_DEBUG(
             "IOTransport",
             "oneway() sending cmdId="
                 << command->getCommandId() << " type="
                 << AMQLogger::commandTypeName(command->getDataStructureType()));
 
+        bool                                     flushLeader = false;
+        std::shared_ptr<IOTransportImpl::WriteBatch> batch;
+
+        this->impl->writersWaiting.fetch_add(1);
         synchronized(impl->outputStream)
         {
+            this->impl->writersWaiting.fetch_sub(1);
+
             // Write the command to the output stream.
             this->impl->wireFormat->marshal(command,
                                             this,
                                             this->impl->outputStream);
-            this->impl->outputStream->flush();
+            this->impl->pendingFrames++;
+
+            if (this->impl->writeCoalesceMicros <= 0)
+            {
+                this->impl->flushPendingFrames();
+            }
+            else
+            {
+                // The first writer flushes for everyone that joins the batch
+                // before the flush, they wait for it and share its result.
+                batch = this->impl->writeBatch;
+                if (!this->impl->flushScheduled)
+                {
+                    this->impl->flushScheduled = true;
+                    flushLeader                = true;
+                }
+            }
+        }
+
+        if (flushLeader)
+        {
+            // Holding the flush back only pays off when another writer is
+            // about to add its frame, a lone writer flushes right away.
+            if (this->impl->writersWaiting.load() > 0)
+            {
+                std::this_thread::sleep_for(
+                    std::chrono::microseconds(this->impl->writeCoalesceMicros));
+            }
+
+            synchronized(impl->outputStream)
+            {
+                this->impl->flushWriteBatch();
+            }
+        }
+        else if (batch != nullptr)
+        {
+            synchronized(impl->outputStream)
+            {
+                while (!batch->flushed)
+                {
+                    impl->outputStream->wait();
+                }
+            }
+        }
+
+        if (batch != nullptr && batch->error != nullptr)
+        {
+            throw IOException(*batch->error);
         }
 
         AMQ_LOG_DEBUG("IOTransport",
@@ -273,6 +437,41 @@ void IOTransport::oneway(const std::shared_ptr<Command> command)
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::writeFrames(const unsigned char* buffer,
+                              int                  length,
+                              int                  frames)
+{
+    try
+    {
+        if (impl->closed.load())
+        {
+            throw IOException(
+                __FILE__,
+                __LINE__,
+                "IOTransport::writeFrames() - transport is closed!");
+        }
+
+        if (impl->outputStream == NULL)
+        {
+            throw IOException(
+                __FILE__,
+                __LINE__,
+                "IOTransport::writeFrames() - invalid output stream");
+        }
+
+        synchronized(impl->outputStream)
+        {
+            this->impl->outputStream->write(buffer, length);
+            this->impl->pendingFrames += frames;
+            this->impl->flushPendingFrames();
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void IOTransport::start()
 {
@@ -300,6 +499,29 @@ void IOTransport::start()
                                   "set before calling start");
             }
 
+            // A restart of a push driven Transport keeps its read loop.
+            if (impl->asyncReading.load())
+            {
+                return;
+            }
+
+            if (impl->asyncSocket && impl->asyncSocket->isAsyncReadSupported())
+            {
+                impl->frameDecoder.reset(
+                    impl->wireFormat->createFrameDecoder(this));
+            }
+
+            if (impl->frameDecoder)
+            {
+                AMQ_LOG_DEBUG("IOTransport",
+                              "start() using push driven reads, bufferSize="
+                                  << impl->readBufferSize);
+
+                impl->asyncReading.store(true);
+                impl->asyncSocket->startAsyncRead(this, impl->readBufferSize);
+                return;
+            }
+
             // Start the polling thread.
             impl->thread.reset(new Thread(this, "IOTransport reader Thread"));
             impl->thread->start();
@@ -361,6 +583,17 @@ void IOTransport::close()
             // No need to fire anymore async events now.
             this->impl->listener = NULL;
 
+            // Stop the read loop, this waits for any read being decoded on an
+            // I/O thread unless we are being closed from that very callback.
+            if (impl->asyncReading.load())
+            {
+                try
+                {
+                    impl->asyncSocket->stopAsyncRead();
+                }
+                AMQ_CATCHALL_NOTHROW()
+            }
+
             IOException error;
             bool        hasException = false;
 
@@ -444,7 +677,7 @@ void IOTransport::run()
                 fire(ex);
                 break;  // Exit the loop, connection is dead
             }
-            catch (decaf::io::IOException& ex)
+            catch (IOException& ex)
             {
                 // IO errors indicate connection problems - propagate to
                 // FailoverTransport
@@ -548,6 +781,72 @@ void IOTransport::run()
                       << " closed=" << this->impl->closed.load() << ")");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::onRead(const unsigned char* buffer, int length)
+{
+    try
+    {
+        impl->frameDecoder->append(buffer, length);
+
+        // Same contract as the polling thread, nothing more is delivered once
+        // stopped or closed, buffered data is kept for a restart.
+        while (this->impl->started.load() && !this->impl->closed.load())
+        {
+            std::shared_ptr<Command> command =
+                impl->frameDecoder->nextCommand();
+
+            if (!command)
+            {
+                break;
+            }
+
+            fire(command);
+        }
+
+        return;
+    }
+    catch (exceptions::ActiveMQException& ex)
+    {
+        AMQ_LOG_ERROR("IOTransport",
+                      "onRead() caught ActiveMQException: " << ex.getMessage());
+        ex.setMark(__FILE__, __LINE__);
+        fire(ex);
+    }
+    catch (decaf::lang::Exception& ex)
+    {
+        AMQ_LOG_ERROR("IOTransport",
+                      "onRead() caught Exception: " << ex.getMessage());
+        ex.setMark(__FILE__, __LINE__);
+        fire(ex);
+    }
+    catch (...)
+    {
+        AMQ_LOG_ERROR("IOTransport", "onRead() caught unknown exception");
+        exceptions::ActiveMQException ex(
+            __FILE__,
+            __LINE__,
+            "IOTransport::onRead - caught unknown exception");
+        fire(ex);
+    }
+
+    // Decoding failed, the stream can't be resynchronized so stop reading.
+    try
+    {
+        impl->asyncSocket->stopAsyncRead();
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::onReadException(decaf::io::IOException& ex)
+{
+    AMQ_LOG_ERROR("IOTransport",
+                  "onReadException() read loop terminated: "
+                      << ex.getMessage());
+    ex.setMark(__FILE__, __LINE__);
+    fire(ex);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 std::shared_ptr<FutureResponse> IOTransport::asyncRequest(
     const std::shared_ptr<Command> command                   AMQCPP_UNUSED,
@@ -592,6 +891,45 @@ void IOTransport::setOutputStream(decaf::io::DataOutputStream* os)
     this->impl->outputStream = os;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::setAsyncReadSocket(
+    const std::shared_ptr<decaf::net::Socket> socket,
+    int                                       readBufferSize)
+{
+    this->impl->asyncSocket    = socket;
+    this->impl->readBufferSize = readBufferSize > 0 ? readBufferSize : 8192;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool IOTransport::isAsyncReading() const
+{
+    return this->impl->asyncReading.load();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::setWriteCoalesceMicros(int micros)
+{
+    this->impl->writeCoalesceMicros = micros > 0 ? micros : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int IOTransport::getWriteCoalesceMicros() const
+{
+    return this->impl->writeCoalesceMicros;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long IOTransport::getWriteFlushCount() const
+{
+    return this->impl->writeFlushCount.load();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long IOTransport::getWriteFrameCount() const
+{
+    return this->impl->writeFrameCount.load();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 std::shared_ptr<wireformat::WireFormat> IOTransport::getWireFormat() const
 {
@@ -29,6 +29,8 @@
 #include <decaf/io/DataOutputStream.h>
 #include <decaf/lang/Runnable.h>
 #include <decaf/lang/Thread.h>
+#include <decaf/net/Socket.h>
+#include <decaf/net/SocketReadListener.h>
 #include <decaf/util/logging/LoggerDefines.h>
 #include <memory>
 
@@ -67,9 +69,19 @@ namespace transport
      * streams.  Close can be called explicitly by the user, but is also called
      * in the destructor.  Once this object has been closed, it cannot be
      * restarted.
+     *
+     * When a Socket is assigned with setAsyncReadSocket and the WireFormat can
+     * decode partial reads, no polling thread is created.  The Socket instead
+     * pushes each completed read to this object from the shared I/O threads,
+     * the data is fed to the WireFormat's FrameDecoder and every complete
+     * command is handed to the listener from that I/O thread.
+     *
+     * Writes can be coalesced by setting a write coalesce time, frames from
+     * concurrent oneway calls are then buffered and sent in a single flush.
      */
     class AMQCPP_API IOTransport : public Transport,
-                                   public decaf::lang::Runnable
+                                   public decaf::lang::Runnable,
+                                   public decaf::net::SocketReadListener
     {
         LOGDECAF_DECLARE(logger)
 
@@ -141,8 +153,77 @@ namespace transport
          */
         virtual void setOutputStream(decaf::io::DataOutputStream* os);
 
+        /**
+         * Sets a Socket whose reads should be pushed to this Transport rather
+         * than being pulled from the input stream by a dedicated thread.  If
+         * the Socket or the WireFormat does not support this the Transport
+         * falls back to the polling thread when started.  The input stream
+         * must still be set but is not read from in this mode.
+         *
+         * @param socket
+         *      The connected Socket that the input stream reads from.
+         * @param readBufferSize
+         *      The size of the buffer used for each read from the Socket.
+         */
+        virtual void setAsyncReadSocket(
+            const std::shared_ptr<decaf::net::Socket> socket,
+            int                                       readBufferSize);
+
+        /**
+         * @return true if this Transport was started in push driven read mode
+         * and no polling thread is in use.
+         */
+        bool isAsyncReading() const;
+
+        /**
+         * Sets how long a oneway call may hold back its flush so that frames
+         * written by other threads in the meantime go out with the same
+         * write.  The first writer to find no flush pending waits up to this
+         * long, but only while other writers are waiting to add a frame, and
+         * then flushes every frame written so far.  Writers that follow it
+         * wait for that flush and throw its IOException if it fails.  Zero,
+         * the default, flushes every frame as soon as it is written.
+         *
+         * @param micros
+         *      The maximum time in microseconds a frame waits to be flushed.
+         */
+        void setWriteCoalesceMicros(int micros);
+
+        /**
+         * @return the maximum time in microseconds a frame waits to be flushed.
+         */
+        int getWriteCoalesceMicros() const;
+
+        /**
+         * @return the number of times the output stream has been flushed, the
+         * number of frames per write is getWriteFrameCount() divided by this.
+         */
+        long long getWriteFlushCount() const;
+
+        /**
+         * @return the number of frames written to the output stream.
+         */
+        long long getWriteFrameCount() const;
+
+        /**
+         * Writes frames that are already encoded in this Transport's wire
+         * format and flushes them, the bytes go to the output stream as they
+         * are.  The caller must know that the peer decodes them the same way
+         * as frames marshaled here, nothing checks that they are valid.
+         *
+         * @param buffer
+         *      The encoded frames, each one whole.
+         * @param length
+         *      The number of bytes to write.
+         * @param frames
+         *      The number of frames the bytes hold.
+         *
+         * @throws IOException if the Transport is closed or the write fails.
+         */
+        void writeFrames(const unsigned char* buffer, int length, int frames);
+
     public:  // Transport methods
-        virtual void oneway(const std::shared_ptr<Command> command);
+        virtual void oneway(const std::shared_ptr<Command>& command);
 
         /**
          * {@inheritDoc}
@@ -237,6 +318,11 @@ namespace transport
 
     public:  // Runnable methods.
         virtual void run();
+
+    public:  // SocketReadListener methods.
+        virtual void onRead(const unsigned char* buffer, int length);
+
+        virtual void onReadException(decaf::io::IOException& ex);
     };
 
 }  // namespace transport
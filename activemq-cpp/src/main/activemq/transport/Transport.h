@@ -93,7 +93,7 @@ namespace transport
          * @throws UnsupportedOperationException if this method is not
          * implemented by this transport.
          */
-        virtual void oneway(const std::shared_ptr<Command> command) = 0;
+        virtual void oneway(const std::shared_ptr<Command>& command) = 0;
 
         /**
          * Sends a commands asynchronously, returning a FutureResponse object
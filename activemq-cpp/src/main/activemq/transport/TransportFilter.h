@@ -111,7 +111,7 @@ namespace transport
         virtual void transportResumed();
 
     public:
-        virtual void oneway(const std::shared_ptr<Command> command)
+        virtual void oneway(const std::shared_ptr<Command>& command)
         {
             checkClosed();
             next->oneway(command);
@@ -23,6 +23,7 @@
 #include <decaf/util/concurrent/Mutex.h>
 #include <decaf/util/logging/LoggerDefines.h>
 #include <atomic>
+#include <thread>
 
 #include <activemq/commands/ExceptionResponse.h>
 #include <activemq/commands/Response.h>
@@ -46,45 +47,60 @@ using namespace decaf::util::concurrent;
 namespace
 {
 
-class ResponseFinalizer
+// Number of outstanding requests that can be tracked without a lock, must be
+// a power of two.  Requests beyond this go to the overflow map.
+const unsigned int REQUEST_SLOTS = 256;
+
+// Slot states, packed with the command id into one word so that claiming or
+// completing a slot is a single compare-and-swap on that word.
+const unsigned long long SLOT_EMPTY      = 0;
+const unsigned long long SLOT_OWNED      = 1;
+const unsigned long long SLOT_WAITING    = 2;
+const unsigned long long SLOT_COMPLETING = 3;
+const unsigned long long SLOT_COMPLETED  = 4;
+const unsigned long long SLOT_STATE_MASK = 0xFFFFFFFFULL;
+
+inline unsigned long long slotTag(unsigned int       commandId,
+                                  unsigned long long state)
 {
-private:
-    ResponseFinalizer(const ResponseFinalizer&);
-    ResponseFinalizer operator=(const ResponseFinalizer&);
+    return ((unsigned long long)commandId << 32) | state;
+}
 
+/**
+ * One outstanding request.  The fields other than the tag are written only by
+ * the thread that moved the tag into SLOT_OWNED or SLOT_COMPLETING, the tag
+ * store that follows publishes them to the next owner.
+ */
+class RequestSlot
+{
 private:
-    Mutex*                                                  mutex;
-    int                                                     commandId;
-    HashMap<unsigned int, std::shared_ptr<FutureResponse>>* map;
+    RequestSlot(const RequestSlot&);
+    RequestSlot& operator=(const RequestSlot&);
 
 public:
-    ResponseFinalizer(
-        Mutex*                                                  mutex,
-        int                                                     commandId,
-        HashMap<unsigned int, std::shared_ptr<FutureResponse>>* map)
-        : mutex(mutex),
-          commandId(commandId),
-          map(map)
+    std::atomic<unsigned long long> tag;
+
+    // The future the current request completes.
+    FutureResponse* future;
+
+    // Holds async futures until completed, sync requests use the pooled one.
+    std::shared_ptr<FutureResponse> asyncFuture;
+
+    // Created on the first sync request in this slot and reused after that.
+    FutureResponse* pooled;
+
+public:
+    RequestSlot()
+        : tag(SLOT_EMPTY),
+          future(NULL),
+          asyncFuture(),
+          pooled(NULL)
     {
     }
 
-    ~ResponseFinalizer()
+    ~RequestSlot()
     {
-        synchronized(mutex)
-        {
-            // Only remove if the key still exists to avoid
-            // NoSuchElementException
-            if (map->containsKey(commandId))
-            {
-                try
-                {
-                    map->remove(commandId);
-                }
-                catch (...)
-                {
-                }
-            }
-        }
+        delete pooled;
     }
 };
 }  // namespace
@@ -99,25 +115,411 @@ namespace transport
 
         class CorrelatorData
         {
+        private:
+            CorrelatorData(const CorrelatorData&);
+            CorrelatorData& operator=(const CorrelatorData&);
+
         public:
             // The next command id for sent commands.
             std::atomic<int> nextCommandId;
 
-            // Map of request ids to future response objects.
+            // Outstanding requests indexed by command id.
+            RequestSlot slots[REQUEST_SLOTS];
+
+            // Requests that found every slot busy.
             HashMap<unsigned int, std::shared_ptr<FutureResponse>> requestMap;
 
-            // Sync object for accessing the request map.
+            // Number of entries in the request map, lets the response path
+            // skip the lock while the map is empty.
+            std::atomic<int> overflowCount;
+
+            // Sync object for the request map and the prior error.
             decaf::util::concurrent::Mutex mapMutex;
 
             // Indicates that an the filter is now unusable from some error.
             std::shared_ptr<Exception> priorError;
 
+            // Set along with priorError so the request path can check it
+            // without the lock.
+            std::atomic<bool> failed;
+
         public:
             CorrelatorData()
                 : nextCommandId(1),
+                  slots(),
                   requestMap(),
-                  mapMutex()
+                  overflowCount(0),
+                  mapMutex(),
+                  priorError(),
+                  failed(false)
+            {
+            }
+
+            /**
+             * Registers a pending request for the given command id.
+             *
+             * @param commandId
+             *      The id of the command that expects a response.
+             * @param async
+             *      The future of an async request, empty for a sync request
+             *      which is then given a pooled future.
+             * @param slot
+             *      Set to the claimed slot or NULL if the request went to the
+             *      overflow map.
+             * @param overflow
+             *      Set to the future of an overflow request.
+             *
+             * @return the future that the response will be delivered to.
+             *
+             * @throws IOException if the correlator has already failed.
+             */
+            FutureResponse* addRequest(
+                unsigned int                           commandId,
+                const std::shared_ptr<FutureResponse>& async,
+                RequestSlot*&                          slot,
+                std::shared_ptr<FutureResponse>&       overflow)
+            {
+                if (failed.load())
+                {
+                    throwPriorError(commandId, async);
+                }
+
+                slot = claim(commandId);
+
+                if (slot != NULL)
+                {
+                    if (async)
+                    {
+                        slot->asyncFuture = async;
+                        slot->future      = async.get();
+                    }
+                    else
+                    {
+                        if (slot->pooled == NULL)
+                        {
+                            slot->pooled = new FutureResponse();
+                        }
+                        slot->future = slot->pooled;
+                    }
+
+                    FutureResponse* future = slot->future;
+
+                    // Publishing before checking the failure flag pairs with
+                    // dispose() setting the flag before scanning the slots, so
+                    // one of the two always sees the other.
+                    slot->tag.store(slotTag(commandId, SLOT_WAITING));
+
+                    if (failed.load())
+                    {
+                        // Only report through the future if dispose() did
+                        // not get to it first.
+                        bool withdrawn =
+                            removeRequest(commandId, slot, (bool)async);
+                        throwPriorError(
+                            commandId,
+                            withdrawn ? async
+                                      : std::shared_ptr<FutureResponse>());
+                    }
+
+                    return future;
+                }
+
+                overflow = async ? async : std::shared_ptr<FutureResponse>(
+                                               new FutureResponse());
+
+                bool error = false;
+                synchronized(&mapMutex)
+                {
+                    error = (priorError != NULL);
+                    if (!error)
+                    {
+                        requestMap.put(commandId, overflow);
+                        overflowCount.fetch_add(1);
+                    }
+                }
+
+                if (error)
+                {
+                    throwPriorError(commandId, async);
+                }
+
+                return overflow.get();
+            }
+
+            /**
+             * Withdraws a request that will not wait for, or did already get,
+             * its response.  Called only by the thread that added it.
+             *
+             * @return true if the request had not been completed.
+             */
+            bool removeRequest(unsigned int commandId,
+                               RequestSlot* slot,
+                               bool         async)
+            {
+                if (slot == NULL)
+                {
+                    bool withdrawn = false;
+                    synchronized(&mapMutex)
+                    {
+                        if (requestMap.containsKey(commandId))
+                        {
+                            requestMap.remove(commandId);
+                            overflowCount.fetch_sub(1);
+                            withdrawn = true;
+                        }
+                    }
+                    return withdrawn;
+                }
+
+                unsigned long long expected = slotTag(commandId, SLOT_WAITING);
+                bool withdrawn = slot->tag.compare_exchange_strong(
+                    expected,
+                    slotTag(commandId, SLOT_OWNED));
+
+                if (withdrawn)
+                {
+                    // Nobody completed it, we own the slot again.
+                    slot->asyncFuture.reset();
+                }
+                else if (async)
+                {
+                    // The completing thread frees async slots itself.
+                    return false;
+                }
+                else
+                {
+                    // A completion is in progress, the pooled future can only
+                    // be reused once it is done with it.
+                    unsigned long long completed =
+                        slotTag(commandId, SLOT_COMPLETED);
+                    while (slot->tag.load(std::memory_order_acquire) !=
+                           completed)
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+
+                if (!async)
+                {
+                    slot->pooled->reset();
+                }
+                slot->future = NULL;
+                slot->tag.store(slotTag(commandId, SLOT_EMPTY),
+                                std::memory_order_release);
+
+                return withdrawn;
+            }
+
+            /**
+             * Delivers a response to the request with the given id.
+             *
+             * @return false if no such request is outstanding.
+             */
+            bool completeRequest(unsigned int                     commandId,
+                                 const std::shared_ptr<Response>& response)
             {
+                unsigned int home = commandId & (REQUEST_SLOTS - 1);
+                unsigned long long waiting = slotTag(commandId, SLOT_WAITING);
+
+                for (unsigned int i = 0; i < REQUEST_SLOTS; ++i)
+                {
+                    RequestSlot& slot = slots[(home + i) & (REQUEST_SLOTS - 1)];
+                    if (slot.tag.load(std::memory_order_relaxed) == waiting)
+                    {
+                        unsigned long long expected = waiting;
+                        if (slot.tag.compare_exchange_strong(
+                                expected,
+                                slotTag(commandId, SLOT_COMPLETING)))
+                        {
+                            completeSlot(slot, commandId, response);
+                            return true;
+                        }
+                    }
+                }
+
+                if (overflowCount.load() == 0)
+                {
+                    return false;
+                }
+
+                std::shared_ptr<FutureResponse> future;
+                synchronized(&mapMutex)
+                {
+                    if (requestMap.containsKey(commandId))
+                    {
+                        future = requestMap.remove(commandId);
+                        overflowCount.fetch_sub(1);
+                    }
+                }
+
+                if (!future)
+                {
+                    return false;
+                }
+
+                future->setResponse(response);
+                return true;
+            }
+
+            /**
+             * Records the error and fails every outstanding request with it,
+             * does nothing if an error was already recorded.
+             */
+            void failAll(const std::shared_ptr<Exception>& error)
+            {
+                HashMap<unsigned int, std::shared_ptr<FutureResponse>>
+                    requestsCopy;
+
+                synchronized(&mapMutex)
+                {
+                    if (priorError)
+                    {
+                        AMQ_LOG_DEBUG("ResponseCorrelator",
+                                      "dispose() ALREADY HAD PRIOR ERROR");
+                        return;
+                    }
+
+                    AMQ_LOG_DEBUG("ResponseCorrelator",
+                                  "dispose() clearing requests, overflow="
+                                      << requestMap.size());
+                    priorError = error;
+                    failed.store(true);
+
+                    // Copy the map to preserve correlation IDs
+                    requestsCopy.copy(requestMap);
+                    requestMap.clear();
+                    overflowCount.store(0);
+                }
+
+                std::shared_ptr<commands::BrokerError> exception(
+                    new commands::BrokerError);
+                exception->setExceptionClass("java.io.IOException");
+                exception->setMessage(error->getMessage());
+
+                for (unsigned int i = 0; i < REQUEST_SLOTS; ++i)
+                {
+                    RequestSlot&       slot = slots[i];
+                    unsigned long long tag  = slot.tag.load();
+
+                    if ((tag & SLOT_STATE_MASK) != SLOT_WAITING)
+                    {
+                        continue;
+                    }
+
+                    unsigned int commandId = (unsigned int)(tag >> 32);
+                    if (slot.tag.compare_exchange_strong(
+                            tag,
+                            slotTag(commandId, SLOT_COMPLETING)))
+                    {
+                        completeSlot(slot,
+                                     commandId,
+                                     createErrorResponse(commandId, exception));
+                    }
+                }
+
+                std::shared_ptr<Iterator<unsigned int>> iter(
+                    requestsCopy.keySet().iterator());
+                while (iter->hasNext())
+                {
+                    unsigned int correlationId = iter->next();
+                    requestsCopy.get(correlationId)
+                        ->setResponse(
+                            createErrorResponse(correlationId, exception));
+                }
+            }
+
+        private:
+            RequestSlot* claim(unsigned int commandId)
+            {
+                // Command ids are handed out in sequence so the home slot is
+                // nearly always free, probing only happens once more than
+                // REQUEST_SLOTS requests are outstanding at the same time.
+                unsigned int home = commandId & (REQUEST_SLOTS - 1);
+
+                for (unsigned int i = 0; i < REQUEST_SLOTS; ++i)
+                {
+                    RequestSlot& slot = slots[(home + i) & (REQUEST_SLOTS - 1)];
+                    unsigned long long tag =
+                        slot.tag.load(std::memory_order_relaxed);
+
+                    if ((tag & SLOT_STATE_MASK) == SLOT_EMPTY &&
+                        slot.tag.compare_exchange_strong(
+                            tag,
+                            slotTag(commandId, SLOT_OWNED),
+                            std::memory_order_acquire))
+                    {
+                        return &slot;
+                    }
+                }
+
+                return NULL;
+            }
+
+            // Called by the thread that moved the slot to SLOT_COMPLETING.
+            void completeSlot(RequestSlot&                     slot,
+                              unsigned int                     commandId,
+                              const std::shared_ptr<Response>& response)
+            {
+                if (slot.asyncFuture)
+                {
+                    // Nobody waits to release an async slot, free it before
+                    // running the callback.
+                    std::shared_ptr<FutureResponse> future;
+                    future.swap(slot.asyncFuture);
+                    slot.future = NULL;
+                    slot.tag.store(slotTag(commandId, SLOT_EMPTY),
+                                   std::memory_order_release);
+
+                    future->setResponse(response);
+                }
+                else
+                {
+                    slot.future->setResponse(response);
+                    slot.tag.store(slotTag(commandId, SLOT_COMPLETED),
+                                   std::memory_order_release);
+                }
+            }
+
+            std::shared_ptr<Response> createErrorResponse(
+                unsigned int                                  correlationId,
+                const std::shared_ptr<commands::BrokerError>& exception)
+            {
+                std::shared_ptr<commands::ExceptionResponse> errorResponse(
+                    new commands::ExceptionResponse);
+                errorResponse->setCorrelationId(correlationId);
+                errorResponse->setException(exception);
+                return errorResponse;
+            }
+
+            void throwPriorError(
+                unsigned int                           commandId,
+                const std::shared_ptr<FutureResponse>& async)
+            {
+                std::shared_ptr<Exception> error;
+                synchronized(&mapMutex)
+                {
+                    error = priorError;
+                }
+
+                AMQ_LOG_ERROR("ResponseCorrelator",
+                              "PRIOR ERROR EXISTS cmdId="
+                                  << commandId
+                                  << " error=" << error->getMessage());
+
+                if (async)
+                {
+                    std::shared_ptr<commands::BrokerError> exception(
+                        new commands::BrokerError(error));
+                    std::shared_ptr<commands::ExceptionResponse> response(
+                        new commands::ExceptionResponse);
+                    response->setException(exception);
+
+                    async->setResponse(response);
+                }
+
+                throw IOException(__FILE__,
+                                  __LINE__,
+                                  error->getMessage().c_str());
             }
         };
 
@@ -125,6 +527,72 @@ namespace transport
 }  // namespace transport
 }  // namespace activemq
 
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+/**
+ * Keeps a request registered for the lifetime of this object, so that the
+ * request is withdrawn even if an exception is thrown.
+ */
+class PendingRequest
+{
+private:
+    PendingRequest(const PendingRequest&);
+    PendingRequest operator=(const PendingRequest&);
+
+private:
+    CorrelatorData*                 impl;
+    unsigned int                    commandId;
+    bool                            async;
+    RequestSlot*                    slot;
+    std::shared_ptr<FutureResponse> overflow;
+    FutureResponse*                 future;
+
+public:
+    PendingRequest(CorrelatorData*                        impl,
+                   unsigned int                           commandId,
+                   const std::shared_ptr<FutureResponse>& async)
+        : impl(impl),
+          commandId(commandId),
+          async((bool)async),
+          slot(NULL),
+          overflow(),
+          future(NULL)
+    {
+        future = impl->addRequest(commandId, async, slot, overflow);
+    }
+
+    ~PendingRequest()
+    {
+        if (impl != NULL)
+        {
+            try
+            {
+                impl->removeRequest(commandId, slot, async);
+            }
+            catch (...)
+            {
+            }
+        }
+    }
+
+    FutureResponse* getFuture() const
+    {
+        return future;
+    }
+
+    /**
+     * Leaves the request registered, an async request stays outstanding
+     * until its response arrives.
+     */
+    void detach()
+    {
+        impl = NULL;
+    }
+};
+}  // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 ResponseCorrelator::ResponseCorrelator(std::shared_ptr<Transport> next)
     : TransportFilter(next),
@@ -146,7 +614,7 @@ ResponseCorrelator::~ResponseCorrelator()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ResponseCorrelator::oneway(const std::shared_ptr<Command> command)
+void ResponseCorrelator::oneway(const std::shared_ptr<Command>& command)
 {
     try
     {
@@ -176,61 +644,17 @@ std::shared_ptr<FutureResponse> ResponseCorrelator::asyncRequest(
         command->setCommandId(this->impl->nextCommandId.fetch_add(1));
         command->setResponseRequired(true);
 
-        // Add a future response object to the map indexed by this command id.
+        // Register a future response object under this command id.
         std::shared_ptr<FutureResponse> futureResponse(
             new FutureResponse(responseCallback));
-        std::shared_ptr<Exception> priorError;
-
-        synchronized(&this->impl->mapMutex)
-        {
-            priorError = this->impl->priorError;
-            if (!priorError)
-            {
-                this->impl->requestMap.put(
-                    (unsigned int)command->getCommandId(),
-                    futureResponse);
-            }
-        }
-
-        if (priorError)
-        {
-            std::shared_ptr<commands::BrokerError> exception(
-                new commands::BrokerError(priorError));
-            std::shared_ptr<commands::ExceptionResponse> response(
-                new commands::ExceptionResponse);
-            response->setException(exception);
-
-            futureResponse->setResponse(response);
-
-            throw IOException(__FILE__,
-                              __LINE__,
-                              this->impl->priorError->getMessage().c_str());
-        }
+        PendingRequest pending(this->impl,
+                               command->getCommandId(),
+                               futureResponse);
 
-        // Send the request.
-        try
-        {
-            next->oneway(command);
-        }
-        catch (Exception& ex)
-        {
-            // We have to ensure this gets cleaned out otherwise we can consume
-            // memory over time.
-            synchronized(&this->impl->mapMutex)
-            {
-                if (this->impl->requestMap.containsKey(command->getCommandId()))
-                {
-                    try
-                    {
-                        this->impl->requestMap.remove(command->getCommandId());
-                    }
-                    catch (...)
-                    {
-                    }
-                }
-            }
-            throw;
-        }
+        // Send the request, if that fails the pending request is withdrawn
+        // so that it does not consume memory over time.
+        next->oneway(command);
+        pending.detach();
 
         return futureResponse;
     }
@@ -257,43 +681,11 @@ std::shared_ptr<Response> ResponseCorrelator::request(
                 << command->getCommandId() << " type="
                 << AMQLogger::commandTypeName(command->getDataStructureType()));
 
-        // Add a future response object to the map indexed by this command id.
-        std::shared_ptr<FutureResponse> futureResponse(new FutureResponse());
-        std::shared_ptr<Exception>      priorError;
-
-        synchronized(&this->impl->mapMutex)
-        {
-            priorError = this->impl->priorError;
-            if (!priorError)
-            {
-                this->impl->requestMap.put(
-                    (unsigned int)command->getCommandId(),
-                    futureResponse);
-                AMQ_LOG_DEBUG("ResponseCorrelator",
-                              "added to map cmdId="
-                                  << command->getCommandId() << " mapSize="
-                                  << this->impl->requestMap.size());
-            }
-            else
-            {
-                AMQ_LOG_ERROR("ResponseCorrelator",
-                              "PRIOR ERROR EXISTS cmdId="
-                                  << command->getCommandId()
-                                  << " error=" << priorError->getMessage());
-            }
-        }
-
-        if (priorError)
-        {
-            throw IOException(__FILE__,
-                              __LINE__,
-                              this->impl->priorError->getMessage().c_str());
-        }
-
-        // The finalizer will cleanup the map even if an exception is thrown.
-        ResponseFinalizer finalizer(&this->impl->mapMutex,
-                                    command->getCommandId(),
-                                    &this->impl->requestMap);
+        // The pending request is withdrawn even if an exception is thrown,
+        // sync requests wait on a future pooled by the correlator.
+        PendingRequest pending(this->impl,
+                               command->getCommandId(),
+                               std::shared_ptr<FutureResponse>());
 
         // Wait to be notified of the response via the futureResponse object.
         std::shared_ptr<commands::Response> response;
@@ -302,7 +694,7 @@ std::shared_ptr<Response> ResponseCorrelator::request(
         next->oneway(command);
 
         // Get the response.
-        response = futureResponse->getResponse();
+        response = pending.getFuture()->getResponse();
 
         if (!response)
         {
@@ -333,32 +725,11 @@ std::shared_ptr<Response> ResponseCorrelator::request(
         command->setCommandId(this->impl->nextCommandId.fetch_add(1));
         command->setResponseRequired(true);
 
-        // Add a future response object to the map indexed by this command id.
-        std::shared_ptr<FutureResponse> futureResponse(new FutureResponse());
-        std::shared_ptr<Exception>      priorError;
-
-        synchronized(&this->impl->mapMutex)
-        {
-            priorError = this->impl->priorError;
-            if (!priorError)
-            {
-                this->impl->requestMap.put(
-                    (unsigned int)command->getCommandId(),
-                    futureResponse);
-            }
-        }
-
-        if (priorError)
-        {
-            throw IOException(__FILE__,
-                              __LINE__,
-                              this->impl->priorError->getMessage().c_str());
-        }
-
-        // The finalizer will cleanup the map even if an exception is thrown.
-        ResponseFinalizer finalizer(&this->impl->mapMutex,
-                                    command->getCommandId(),
-                                    &this->impl->requestMap);
+        // The pending request is withdrawn even if an exception is thrown,
+        // sync requests wait on a future pooled by the correlator.
+        PendingRequest pending(this->impl,
+                               command->getCommandId(),
+                               std::shared_ptr<FutureResponse>());
 
         // Wait to be notified of the response via the futureResponse object.
         std::shared_ptr<commands::Response> response;
@@ -367,7 +738,7 @@ std::shared_ptr<Response> ResponseCorrelator::request(
         next->oneway(command);
 
         // Get the response.
-        response = futureResponse->getResponse(timeout);
+        response = pending.getFuture()->getResponse(timeout);
 
         if (!response)
         {
@@ -414,62 +785,51 @@ void ResponseCorrelator::onCommand(const std::shared_ptr<Command> command)
         "onCommand() response correlationId=" << response->getCorrelationId());
 
     // It is a response - let's correlate ...
-    synchronized(&this->impl->mapMutex)
+    if (this->impl->completeRequest(response->getCorrelationId(), response))
     {
-        std::shared_ptr<FutureResponse> futureResponse;
-        try
-        {
-            futureResponse =
-                this->impl->requestMap.remove(response->getCorrelationId());
-            AMQ_LOG_DEBUG("ResponseCorrelator",
-                          "found and removed from map correlationId="
-                              << response->getCorrelationId()
-                              << " mapSize=" << this->impl->requestMap.size());
-        }
-        catch (NoSuchElementException& ex)
+        AMQ_LOG_DEBUG("ResponseCorrelator",
+                      "completed request correlationId="
+                          << response->getCorrelationId());
+        return;
+    }
+
+    AMQ_LOG_DEBUG("ResponseCorrelator",
+                  "NOT FOUND in requests correlationId="
+                      << response->getCorrelationId());
+
+    // Check if it's an ExceptionResponse - these should always be propagated
+    // even if we don't have the original request, as they indicate
+    // broker-level errors Note: Must check type first because
+    // dynamic_pointer_cast returns nullptr on failure
+    if (response->getDataStructureType() ==
+        commands::ExceptionResponse::ID_EXCEPTIONRESPONSE)
+    {
+        std::shared_ptr<commands::ExceptionResponse> exResponse =
+            std::dynamic_pointer_cast<commands::ExceptionResponse>(response);
+        if (exResponse->getException() != NULL)
         {
-            AMQ_LOG_DEBUG("ResponseCorrelator",
-                          "NOT FOUND in map correlationId="
-                              << response->getCorrelationId());
-
-            // Check if it's an ExceptionResponse - these should always be
-            // propagated even if we don't have the original request, as they
-            // indicate broker-level errors Note: Must check type first because
-            // dynamic_pointer_cast returns nullptr on failure
-            if (response->getDataStructureType() ==
-                commands::ExceptionResponse::ID_EXCEPTIONRESPONSE)
+            AMQ_LOG_ERROR("ResponseCorrelator",
+                          "ExceptionResponse not in map but propagating - "
+                              << exResponse->getException()->getMessage());
+
+            // Propagate the exception to the transport listener
+            // This ensures broker errors are not silently discarded
+            // during reconnection
+            synchronized(&this->impl->mapMutex)
             {
-                std::shared_ptr<commands::ExceptionResponse> exResponse =
-                    std::dynamic_pointer_cast<commands::ExceptionResponse>(
-                        response);
-                if (exResponse->getException() != NULL)
+                if (!this->impl->priorError)
                 {
-                    AMQ_LOG_ERROR(
-                        "ResponseCorrelator",
-                        "ExceptionResponse not in map but propagating - "
-                            << exResponse->getException()->getMessage());
-
-                    // Propagate the exception to the transport listener
-                    // This ensures broker errors are not silently discarded
-                    // during reconnection
-                    if (!this->impl->priorError)
-                    {
-                        this->impl->priorError.reset(new IOException(
-                            __FILE__,
-                            __LINE__,
-                            exResponse->getException()->getMessage().c_str()));
-                    }
-
-                    // Also propagate as a command so upper layers can handle it
-                    TransportFilter::onCommand(command);
-                    return;
+                    this->impl->priorError.reset(new IOException(
+                        __FILE__,
+                        __LINE__,
+                        exResponse->getException()->getMessage().c_str()));
+                    this->impl->failed.store(true);
                 }
             }
-            return;
-        }
 
-        // Set the response property in the future response.
-        futureResponse->setResponse(response);
+            // Also propagate as a command so upper layers can handle it
+            TransportFilter::onCommand(command);
+        }
     }
 }
 
@@ -499,51 +859,5 @@ void ResponseCorrelator::dispose(std::shared_ptr<Exception> error)
     AMQ_LOG_DEBUG("ResponseCorrelator",
                   "dispose() called error=" << error->getMessage());
 
-    HashMap<unsigned int, std::shared_ptr<FutureResponse>> requestsCopy;
-    synchronized(&this->impl->mapMutex)
-    {
-        if (!this->impl->priorError)
-        {
-            AMQ_LOG_DEBUG("ResponseCorrelator",
-                          "dispose() clearing map, size="
-                              << this->impl->requestMap.size());
-            this->impl->priorError = error;
-            // Copy the map to preserve correlation IDs
-            requestsCopy.copy(this->impl->requestMap);
-            this->impl->requestMap.clear();
-        }
-        else
-        {
-            AMQ_LOG_DEBUG("ResponseCorrelator",
-                          "dispose() ALREADY HAD PRIOR ERROR");
-        }
-    }
-
-    if (!requestsCopy.isEmpty())
-    {
-        std::shared_ptr<commands::BrokerError> exception(
-            new commands::BrokerError);
-        exception->setExceptionClass("java.io.IOException");
-        exception->setMessage(error->getMessage());
-
-        // Create individual ExceptionResponse for each pending request with
-        // correct correlation ID
-        std::shared_ptr<Iterator<unsigned int>> iter(
-            requestsCopy.keySet().iterator());
-        while (iter->hasNext())
-        {
-            unsigned int                    correlationId = iter->next();
-            std::shared_ptr<FutureResponse> futureResponse =
-                requestsCopy.get(correlationId);
-
-            // Create a unique ExceptionResponse for this request with the
-            // correct correlation ID
-            std::shared_ptr<commands::ExceptionResponse> errorResponse(
-                new commands::ExceptionResponse);
-            errorResponse->setCorrelationId(correlationId);
-            errorResponse->setException(exception);
-
-            futureResponse->setResponse(errorResponse);
-        }
-    }
+    this->impl->failAll(error);
 }
@@ -70,7 +70,7 @@ namespace transport
             virtual ~ResponseCorrelator();
 
         public:  // Transport Methods
-            virtual void oneway(const std::shared_ptr<Command> command);
+            virtual void oneway(const std::shared_ptr<Command>& command);
 
             virtual std::shared_ptr<FutureResponse> asyncRequest(
                 const std::shared_ptr<Command>          command,
@@ -18,6 +18,7 @@
 #include "FailoverTransport.h"
 
 #include <activemq/commands/ConnectionControl.h>
+#include <activemq/commands/Message.h>
 #include <activemq/commands/RemoveInfo.h>
 #include <activemq/commands/ShutdownInfo.h>
 #include <activemq/threads/CompositeTaskRunner.h>
@@ -28,6 +29,7 @@
 #include <activemq/transport/failover/BrokerStateInfo.h>
 #include <activemq/transport/failover/CloseTransportsTask.h>
 #include <activemq/transport/failover/FailoverTransportListener.h>
+#include <activemq/transport/failover/SendGate.h>
 #include <activemq/transport/failover/URIPool.h>
 #include <activemq/util/AMQLog.h>
 #include <activemq/util/URISupport.h>
@@ -94,6 +96,7 @@ namespace transport
             int           connectFailures;
             long long     reconnectDelay;
             bool          trackMessages;
+            bool          trackMessageBytes;
             bool          trackTransactionProducers;
             int           maxCacheSize;
             int           maxPullCacheSize;
@@ -132,6 +135,10 @@ namespace transport
 
             TransportListener* transportListener;
 
+            // Sends on a healthy connection don't take reconnectMutex, they
+            // go through sendGate to the Transport it was last opened with.
+            SendGate sendGate;
+
             FailoverTransportImpl(FailoverTransport* parent)
                 : closed(false),
                   connected(false),
@@ -148,6 +155,7 @@ namespace transport
                   connectFailures(0),
                   reconnectDelay(DEFAULT_INITIAL_RECONNECT_DELAY),
                   trackMessages(false),
+                  trackMessageBytes(false),
                   trackTransactionProducers(true),
                   maxCacheSize(128 * 1024),
                   maxPullCacheSize(10),
@@ -178,7 +186,8 @@ namespace transport
                       std::make_shared<DefaultTransportListener>()),
                   myTransportListener(
                       std::make_shared<FailoverTransportListener>(parent)),
-                  transportListener(NULL)
+                  transportListener(NULL),
+                  sendGate()
             {
                 this->backups.reset(new BackupTransportPool(parent,
                                                             taskRunner,
@@ -482,6 +491,8 @@ namespace transport
 
             void disconnect()
             {
+                sendGate.close();
+
                 std::shared_ptr<Transport> transport;
                 transport.swap(this->connectedTransport);
 
@@ -515,6 +526,49 @@ namespace transport
             {
                 return firstConnection || 0 != calculateReconnectAttemptLimit();
             }
+
+            /**
+             * Holds a request in the requestMap so it can be replayed if the
+             * connection fails before its response arrives. A Message may be
+             * the application's own instance when its producer does not copy
+             * on send, the map outlives the send call so it keeps a copy.
+             */
+            void trackRequest(const std::shared_ptr<Command>& command,
+                              const std::shared_ptr<Tracked>& tracked)
+            {
+                synchronized(&requestMap)
+                {
+                    if (tracked && tracked->isWaitingForResponse())
+                    {
+                        requestMap.put(command->getCommandId(), tracked);
+                    }
+                    else if (!tracked && command->isResponseRequired())
+                    {
+                        const Message* message =
+                            dynamic_cast<const Message*>(command.get());
+                        if (message != NULL)
+                        {
+                            requestMap.put(command->getCommandId(),
+                                           std::shared_ptr<Command>(
+                                               message->cloneDataStructure()));
+                        }
+                        else
+                        {
+                            requestMap.put(command->getCommandId(), command);
+                        }
+                    }
+                }
+            }
+
+            /**
+             * Publishes a newly connected and restored Transport to the send
+             * path, this must be called with the reconnect mutex locked.
+             */
+            void openSendGate(const std::shared_ptr<Transport>& transport)
+            {
+                sendGate.open(closed ? std::shared_ptr<Transport>()
+                                     : transport);
+            }
         };
 
         const int FailoverTransportImpl::DEFAULT_INITIAL_RECONNECT_DELAY = 10;
@@ -683,10 +737,100 @@ std::string FailoverTransport::getRemoteAddress() const
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void FailoverTransport::oneway(const std::shared_ptr<Command> command)
+bool FailoverTransport::onewayConnected(
+    const std::shared_ptr<Command>& command)
+{
+    Transport* transport = this->impl->sendGate.enter();
+    if (transport == NULL)
+    {
+        return false;
+    }
+
+    std::shared_ptr<Tracked> tracked;
+    try
+    {
+        tracked = stateTracker.track(command);
+        this->impl->trackRequest(command, tracked);
+    }
+    catch (Exception& ex)
+    {
+        this->impl->sendGate.leave();
+        ex.setMark(__FILE__, __LINE__);
+        throw IOException(ex);
+    }
+    catch (...)
+    {
+        // The locked path drops anything but an Exception as well.
+        this->impl->sendGate.leave();
+        return true;
+    }
+
+    try
+    {
+        transport->oneway(command);
+        stateTracker.trackBack(command);
+        if (command->isShutdownInfo())
+        {
+            this->impl->shutdown = true;
+        }
+        this->impl->sendGate.leave();
+        return true;
+    }
+    catch (IOException& e)
+    {
+        this->impl->sendGate.leave();
+        e.setMark(__FILE__, __LINE__);
+        AMQ_LOG_DEBUG("FailoverTransport",
+                      "oneway() send failed for cmdId="
+                          << command->getCommandId() << ": "
+                          << e.getMessage());
+
+        // Same handling as the locked path, a command the tracker will not
+        // replay is retried once reconnected.
+        bool retry = false;
+        if (!tracked)
+        {
+            synchronized(&this->impl->reconnectMutex)
+            {
+                retry = this->impl->canReconnect();
+            }
+
+            if (retry && command->isResponseRequired())
+            {
+                synchronized(&this->impl->requestMap)
+                {
+                    this->impl->requestMap.remove(command->getCommandId());
+                }
+            }
+        }
+
+        handleTransportFailure(e);
+        return !retry;
+    }
+    catch (...)
+    {
+        this->impl->sendGate.leave();
+        return true;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::oneway(const std::shared_ptr<Command>& command)
 {
     std::shared_ptr<Exception> error;
 
+    // While connected a Message or MessageAck goes straight to the connected
+    // Transport, only a disconnected or reconnecting transport serializes
+    // them. Tracking any other command changes ConnectionState structures,
+    // such as its temporary destinations and recovering pull consumers, that
+    // rely on the reconnect mutex, so those commands always take the locked
+    // path.
+    if (command && (command->isMessage() || command->isMessageAck()) &&
+        onewayConnected(command))
+    {
+        return;
+    }
+
     try
     {
         synchronized(&this->impl->reconnectMutex)
@@ -813,21 +957,7 @@ void FailoverTransport::oneway(const std::shared_ptr<Command> command)
                     try
                     {
                         tracked = stateTracker.track(command);
-                        synchronized(&this->impl->requestMap)
-                        {
-                            if (tracked && tracked->isWaitingForResponse())
-                            {
-                                this->impl->requestMap.put(
-                                    command->getCommandId(),
-                                    tracked);
-                            }
-                            else if (!tracked && command->isResponseRequired())
-                            {
-                                this->impl->requestMap.put(
-                                    command->getCommandId(),
-                                    command);
-                            }
-                        }
+                        this->impl->trackRequest(command, tracked);
                     }
                     catch (Exception& ex)
                     {
@@ -968,12 +1098,16 @@ void FailoverTransport::start()
             stateTracker.setMaxMessagePullCacheSize(
                 this->getMaxPullCacheSize());
             stateTracker.setTrackMessages(this->isTrackMessages());
+            stateTracker.setTrackMessageBytes(this->isTrackMessageBytes());
             stateTracker.setTrackTransactionProducers(
                 this->isTrackTransactionProducers());
 
             if (this->impl->connectedTransport)
             {
+                this->impl->sendGate.close();
+                this->impl->sendGate.drain(false);
                 stateTracker.restore(this->impl->connectedTransport);
+                this->impl->openSendGate(this->impl->connectedTransport);
             }
             else
             {
@@ -1021,6 +1155,7 @@ void FailoverTransport::close()
             this->impl->started = false;
             this->impl->closed  = true;
             this->impl->connected.store(false, std::memory_order_release);
+            this->impl->sendGate.close();
 
             this->impl->backups->setEnabled(false);
             synchronized(&this->impl->requestMap)
@@ -1107,6 +1242,11 @@ void FailoverTransport::restoreTransport(
             "FailoverTransport",
             "Restoring transport state, alreadyStarted=" << alreadyStarted);
 
+        // Sends still running on the old Transport must be tracked before the
+        // tracker is replayed, or they would be lost.  That Transport is being
+        // replaced, closing it fails any send stuck on it.
+        this->impl->sendGate.drain(true);
+
         // Only start the transport if it hasn't been started already.
         // Backup transports are pre-started, so we skip the start() call for
         // them.
@@ -1163,6 +1303,8 @@ void FailoverTransport::handleTransportFailure(
             return;
         }
 
+        this->impl->sendGate.close();
+
         std::shared_ptr<Transport> transport;
         this->impl->connectedTransport.swap(transport);
 
@@ -1744,6 +1886,7 @@ bool FailoverTransport::iterate()
                                                     std::memory_order_release);
                         // Memory barrier to ensure connected state is visible
                         std::atomic_thread_fence(std::memory_order_seq_cst);
+                        this->impl->openSendGate(transport);
                         AMQ_LOG_DEBUG("FailoverTransport",
                                       "Connection established, connected=true");
 
@@ -2214,6 +2357,18 @@ void FailoverTransport::setTrackMessages(bool value)
     this->impl->trackMessages = value;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool FailoverTransport::isTrackMessageBytes() const
+{
+    return this->impl->trackMessageBytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setTrackMessageBytes(bool value)
+{
+    this->impl->trackMessageBytes = value;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool FailoverTransport::isTrackTransactionProducers() const
 {
@@ -105,7 +105,7 @@ namespace transport
 
             virtual void close();
 
-            virtual void oneway(const std::shared_ptr<Command> command);
+            virtual void oneway(const std::shared_ptr<Command>& command);
 
             virtual std::shared_ptr<FutureResponse> asyncRequest(
                 const std::shared_ptr<Command>          command,
@@ -221,6 +221,10 @@ namespace transport
 
             void setTrackMessages(bool value);
 
+            bool isTrackMessageBytes() const;
+
+            void setTrackMessageBytes(bool value);
+
             bool isTrackTransactionProducers() const;
 
             void setTrackTransactionProducers(bool value);
@@ -315,6 +319,20 @@ namespace transport
                                       std::string newTransports);
 
             void processResponse(const std::shared_ptr<Response> response);
+
+            /**
+             * Sends the command on the connected Transport without taking the
+             * reconnect mutex, used for Message and MessageAck commands while
+             * the connection is healthy. Tracking those only touches caches
+             * the ConnectionStateTracker locks itself, or the transaction of
+             * the sending session.
+             *
+             * @param command - The Command to send.
+             *
+             * @return true if the send was handled, false if the caller must
+             * send it through the locked path that waits for a reconnect.
+             */
+            bool onewayConnected(const std::shared_ptr<Command>& command);
         };
 
     }  // namespace failover
@@ -122,6 +122,8 @@ std::shared_ptr<Transport> FailoverTransportFactory::doCreateComposite(
                                          "30000")));  // 30 second default
         transport->setTrackMessages(Boolean::parseBoolean(
             topLvlProperties.getProperty("trackMessages", "false")));
+        transport->setTrackMessageBytes(Boolean::parseBoolean(
+            topLvlProperties.getProperty("trackMessageBytes", "false")));
         transport->setMaxCacheSize(
             std::stoi(topLvlProperties.getProperty("maxCacheSize", "131072")));
         transport->setMaxPullCacheSize(
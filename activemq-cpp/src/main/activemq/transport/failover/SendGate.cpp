@@ -0,0 +1,141 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SendGate.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+#include <decaf/util/concurrent/Concurrent.h>
+
+using namespace activemq;
+using namespace activemq::exceptions;
+using namespace activemq::transport;
+using namespace activemq::transport::failover;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+    // The wakeup from leave() is what ends a drain, the timeout only bounds
+    // how long a missed one could stall it.
+    const long long DRAIN_WAIT_MILLIS = 100;
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+const unsigned int SendGate::OPEN = 0x80000000u;
+
+////////////////////////////////////////////////////////////////////////////////
+SendGate::SendGate()
+    : state(0),
+      transport(),
+      drained()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SendGate::~SendGate()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Transport* SendGate::enter()
+{
+    unsigned int current = state.load(std::memory_order_relaxed);
+    do
+    {
+        if ((current & OPEN) == 0)
+        {
+            return NULL;
+        }
+    } while (!state.compare_exchange_weak(current,
+                                          current + 1,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed));
+
+    return transport.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SendGate::leave()
+{
+    // Only the last send out of a closed gate can have someone waiting on it.
+    if (state.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        synchronized(&drained)
+        {
+            drained.notifyAll();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SendGate::close()
+{
+    state.fetch_and(~OPEN, std::memory_order_acq_rel);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SendGate::drain(bool release)
+{
+    if (getActiveSends() == 0)
+    {
+        return;
+    }
+
+    if (release && transport)
+    {
+        try
+        {
+            transport->close();
+        }
+        AMQ_CATCHALL_NOTHROW()
+    }
+
+    synchronized(&drained)
+    {
+        while (getActiveSends() != 0)
+        {
+            drained.wait(DRAIN_WAIT_MILLIS);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SendGate::open(const std::shared_ptr<Transport>& transport)
+{
+    close();
+    drain(this->transport != transport);
+    this->transport = transport;
+
+    if (transport)
+    {
+        state.fetch_or(OPEN, std::memory_order_release);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool SendGate::isOpen() const
+{
+    return (state.load(std::memory_order_acquire) & OPEN) != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+unsigned int SendGate::getActiveSends() const
+{
+    return state.load(std::memory_order_acquire) & ~OPEN;
+}
@@ -0,0 +1,134 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_TRANSPORT_FAILOVER_SENDGATE_H_
+#define _ACTIVEMQ_TRANSPORT_FAILOVER_SENDGATE_H_
+
+#include <atomic>
+#include <memory>
+
+#include <activemq/transport/Transport.h>
+#include <activemq/util/Config.h>
+
+#include <decaf/util/concurrent/Mutex.h>
+
+namespace activemq
+{
+namespace transport
+{
+    namespace failover
+    {
+
+        /**
+         * Lets sends on a healthy connection bypass the FailoverTransport's
+         * reconnect mutex.  A send enters the gate while it is open and uses
+         * the Transport published by the last call to open(), the reconnect
+         * logic closes the gate and drains it before that Transport changes.
+         *
+         * Entering and leaving are lock free, only a send that leaves a
+         * closed gate as the last one in takes the lock to wake the thread
+         * that is draining it.  All methods but enter() and leave() must be
+         * called by the owner of the reconnect mutex.
+         *
+         * @since 3.10
+         */
+        class AMQCPP_API SendGate
+        {
+        private:
+            static const unsigned int OPEN;
+
+            // The high bit is OPEN, the low bits count the sends in progress.
+            std::atomic<unsigned int> state;
+
+            std::shared_ptr<Transport> transport;
+
+            decaf::util::concurrent::Mutex drained;
+
+        private:
+            SendGate(const SendGate&);
+            SendGate& operator=(const SendGate&);
+
+        public:
+            SendGate();
+
+            virtual ~SendGate();
+
+            /**
+             * Enters the gate, a NULL result means it is closed and the send
+             * must take the locked path.  A non NULL result must be followed
+             * by a call to leave().
+             *
+             * @return the Transport to send on or NULL if the gate is closed.
+             */
+            Transport* enter();
+
+            /**
+             * Leaves the gate after a successful call to enter().
+             */
+            void leave();
+
+            /**
+             * Stops new sends from entering, sends already in progress are
+             * left to finish.
+             */
+            void close();
+
+            /**
+             * Waits for the sends that entered before the gate was closed to
+             * leave, the gate must be closed.
+             *
+             * @param release
+             *      when true and sends are still running the current Transport
+             *      is closed first so a send blocked on it fails instead of
+             *      holding up the caller.
+             */
+            void drain(bool release);
+
+            /**
+             * Closes and drains the gate, then publishes the given Transport
+             * and opens the gate again unless it is NULL.  A Transport other
+             * than the current one is released while draining.
+             *
+             * @param transport
+             *      the Transport that sends use from now on.
+             */
+            void open(const std::shared_ptr<Transport>& transport);
+
+            /**
+             * @return true if sends can currently enter the gate.
+             */
+            bool isOpen() const;
+
+            /**
+             * @return the number of sends that have entered and not left.
+             */
+            unsigned int getActiveSends() const;
+
+            /**
+             * @return the Transport published by the last call to open().
+             */
+            std::shared_ptr<Transport> getTransport() const
+            {
+                return this->transport;
+            }
+        };
+
+    }  // namespace failover
+}  // namespace transport
+}  // namespace activemq
+
+#endif /* _ACTIVEMQ_TRANSPORT_FAILOVER_SENDGATE_H_ */
@@ -89,9 +89,9 @@ namespace transport
 
             std::atomic<bool> failed;
             std::atomic<bool> inRead;
-            std::atomic<bool> inWrite;
+            // Number of threads currently inside oneway().
+            std::atomic<int> inWrite;
 
-            Mutex inWriteMutex;
             Mutex monitor;
 
             long long readCheckTime;
@@ -116,8 +116,7 @@ namespace transport
                   commandReceived(true),
                   failed(),
                   inRead(),
-                  inWrite(),
-                  inWriteMutex(),
+                  inWrite(0),
                   monitor(),
                   readCheckTime(0),
                   writeCheckTime(0),
@@ -424,50 +423,47 @@ void InactivityMonitor::onCommand(const std::shared_ptr<Command> command)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void InactivityMonitor::oneway(const std::shared_ptr<Command> command)
+void InactivityMonitor::oneway(const std::shared_ptr<Command>& command)
 {
     try
     {
-        // Disable inactivity monitoring while processing a command. Synchronize
-        // this method - its not synchronized further down the transport stack
-        // and gets called by more than one thread  by this class
-        synchronized(&this->members->inWriteMutex)
+        // Disable inactivity monitoring while processing a command.  Writers
+        // are only counted here, the transport below orders the writes, so
+        // concurrent senders do not queue on this filter as well.
+        this->members->inWrite.fetch_add(1);
+        try
         {
-            this->members->inWrite.store(true);
-            try
+            if (this->members->failed.load(std::memory_order_relaxed))
             {
-                if (this->members->failed.load())
-                {
-                    throw IOException(
-                        __FILE__,
-                        __LINE__,
-                        (std::string("Channel was inactive for too long: ") +
-                         next->getRemoteAddress())
-                            .c_str());
-                }
+                throw IOException(
+                    __FILE__,
+                    __LINE__,
+                    (std::string("Channel was inactive for too long: ") +
+                     next->getRemoteAddress())
+                        .c_str());
+            }
 
-                if (command->isWireFormatInfo())
+            if (command->isWireFormatInfo())
+            {
+                synchronized(&this->members->monitor)
                 {
-                    synchronized(&this->members->monitor)
-                    {
-                        this->members->localWireFormatInfo =
-                            std::dynamic_pointer_cast<WireFormatInfo>(command);
-                        startMonitorThreads();
-                    }
+                    this->members->localWireFormatInfo =
+                        std::dynamic_pointer_cast<WireFormatInfo>(command);
+                    startMonitorThreads();
                 }
+            }
 
-                this->next->oneway(command);
+            this->next->oneway(command);
 
-                this->members->commandSent.store(true);
-                this->members->inWrite.store(false);
-            }
-            catch (Exception& ex)
-            {
-                this->members->commandSent.store(true);
-                this->members->inWrite.store(false);
-                ex.setMark(__FILE__, __LINE__);
-                throw;
-            }
+            this->members->commandSent.store(true, std::memory_order_relaxed);
+            this->members->inWrite.fetch_sub(1);
+        }
+        catch (Exception& ex)
+        {
+            this->members->commandSent.store(true, std::memory_order_relaxed);
+            this->members->inWrite.fetch_sub(1);
+            ex.setMark(__FILE__, __LINE__);
+            throw;
         }
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -507,7 +503,7 @@ void InactivityMonitor::readCheck()
 ////////////////////////////////////////////////////////////////////////////////
 void InactivityMonitor::writeCheck()
 {
-    if (this->members->inWrite.load())
+    if (this->members->inWrite.load() > 0)
     {
         return;
     }
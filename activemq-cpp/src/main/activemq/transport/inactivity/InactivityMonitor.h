@@ -72,7 +72,7 @@ namespace transport
 
             virtual void onCommand(const std::shared_ptr<Command> command);
 
-            virtual void oneway(const std::shared_ptr<Command> command);
+            virtual void oneway(const std::shared_ptr<Command>& command);
 
         public:
             bool isKeepAliveResponseRequired() const;
@@ -42,7 +42,7 @@ void LoggingTransport::onCommand(const std::shared_ptr<Command> command)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void LoggingTransport::oneway(const std::shared_ptr<Command> command)
+void LoggingTransport::oneway(const std::shared_ptr<Command>& command)
 {
     try
     {
@@ -50,7 +50,7 @@ namespace transport
             virtual void onCommand(const std::shared_ptr<Command> command);
 
         public:  // TransportFilter methods.
-            virtual void oneway(const std::shared_ptr<Command> command);
+            virtual void oneway(const std::shared_ptr<Command>& command);
 
             /**
              * {@inheritDoc}
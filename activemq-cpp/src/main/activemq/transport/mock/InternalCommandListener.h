@@ -73,7 +73,10 @@ namespace transport
             void setResponseBuilder(
                 const std::shared_ptr<ResponseBuilder> responseBuilder)
             {
-                this->responseBuilder = responseBuilder;
+                synchronized(&inboundQueue)
+                {
+                    this->responseBuilder = responseBuilder;
+                }
             }
 
             virtual void onCommand(const std::shared_ptr<Command> command);
@@ -62,7 +62,7 @@ MockTransport::MockTransport(
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void MockTransport::oneway(const std::shared_ptr<Command> command)
+void MockTransport::oneway(const std::shared_ptr<Command>& command)
 {
     try
     {
@@ -147,6 +147,7 @@ namespace transport
                 const std::shared_ptr<ResponseBuilder> responseBuilder)
             {
                 this->responseBuilder = responseBuilder;
+                this->internalListener.setResponseBuilder(responseBuilder);
             }
 
             /**
@@ -171,7 +172,7 @@ namespace transport
             }
 
         public:  // Transport Methods
-            virtual void oneway(const std::shared_ptr<Command> command);
+            virtual void oneway(const std::shared_ptr<Command>& command);
 
             virtual std::shared_ptr<FutureResponse> asyncRequest(
                 const std::shared_ptr<Command>          command,
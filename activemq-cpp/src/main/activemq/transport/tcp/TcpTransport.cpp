@@ -76,6 +76,9 @@ namespace transport
             int  soSendBufferSize;
             bool tcpNoDelay;
 
+            bool asyncIo;
+            int  writeCoalesceMicros;
+
             TcpTransportImpl(const decaf::net::URI& location)
                 : connectTimeout(3000),
                   socket(),
@@ -90,7 +93,9 @@ namespace transport
                   soKeepAlive(false),
                   soReceiveBufferSize(-1),
                   soSendBufferSize(-1),
-                  tcpNoDelay(true)
+                  tcpNoDelay(true),
+                  asyncIo(false),
+                  writeCoalesceMicros(0)
             {
             }
         };
@@ -272,6 +277,14 @@ void TcpTransport::connect()
         // Give the IOTransport the streams.
         ioTransport->setInputStream(impl->dataInputStream.get());
         ioTransport->setOutputStream(impl->dataOutputStream.get());
+        ioTransport->setWriteCoalesceMicros(this->impl->writeCoalesceMicros);
+
+        // Reads pushed from the Socket would bypass the tracing streams.
+        if (this->impl->asyncIo && !this->impl->trace &&
+            impl->socket->isAsyncReadSupported())
+        {
+            ioTransport->setAsyncReadSocket(impl->socket, inputBufferSize);
+        }
     }
     AMQ_CATCH_RETHROW(ActiveMQException)
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
@@ -445,6 +458,44 @@ bool TcpTransport::isTcpNoDelay() const
     return this->impl->tcpNoDelay;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void TcpTransport::setIoMode(const std::string& ioMode)
+{
+    if (ioMode == "async")
+    {
+        this->impl->asyncIo = true;
+    }
+    else if (ioMode == "blocking")
+    {
+        this->impl->asyncIo = false;
+    }
+    else
+    {
+        throw IllegalArgumentException(__FILE__,
+                                       __LINE__,
+                                       "Unknown transport.ioMode: %s",
+                                       ioMode.c_str());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string TcpTransport::getIoMode() const
+{
+    return this->impl->asyncIo ? "async" : "blocking";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TcpTransport::setWriteCoalesceMicros(int micros)
+{
+    this->impl->writeCoalesceMicros = micros;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int TcpTransport::getWriteCoalesceMicros() const
+{
+    return this->impl->writeCoalesceMicros;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 decaf::net::URI TcpTransport::getLocation() const
 {
@@ -98,6 +98,40 @@ namespace transport
             void setTcpNoDelay(bool tcpNoDelay);
             bool isTcpNoDelay() const;
 
+            /**
+             * Sets how the Transport reads from its Socket, either "blocking"
+             * (the default) where a dedicated thread per connection waits in
+             * the WireFormat's unmarshal, or "async" where completed Socket
+             * reads are decoded and dispatched on the shared I/O threads with
+             * no reader thread per connection.  Async mode falls back to
+             * blocking reads when tracing is enabled or the Socket or
+             * WireFormat can't support it.
+             *
+             * Since commands are dispatched on the shared I/O threads in async
+             * mode a TransportListener that blocks stalls reads on every
+             * connection served by that thread.
+             *
+             * @param ioMode
+             *      Either "blocking" or "async".
+             *
+             * @throws IllegalArgumentException if the mode is not recognized.
+             */
+            void        setIoMode(const std::string& ioMode);
+            std::string getIoMode() const;
+
+            /**
+             * Sets the time in microseconds that a write may be held back so
+             * that frames sent concurrently are flushed together, see
+             * IOTransport::setWriteCoalesceMicros.  The coalesced frames are
+             * gathered in the output buffer, so outputBufferSize bounds how
+             * much goes out in a single write.
+             *
+             * @param micros
+             *      The maximum flush delay, zero flushes every frame at once.
+             */
+            void setWriteCoalesceMicros(int micros);
+            int  getWriteCoalesceMicros() const;
+
         public:  // Transport Methods
             virtual bool isFaultTolerant() const
             {
@@ -160,6 +160,9 @@ void TcpTransportFactory::doConfigureTransport(
             properties.getProperty("tcpNoDelay", "true")));
         tcp->setConnectTimeout(
             std::stoi(properties.getProperty("soConnectTimeout", "3000")));
+        tcp->setIoMode(properties.getProperty("transport.ioMode", "blocking"));
+        tcp->setWriteCoalesceMicros(std::stoi(
+            properties.getProperty("transport.writeCoalesceMicros", "0")));
     }
     AMQ_CATCH_RETHROW(ActiveMQException)
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
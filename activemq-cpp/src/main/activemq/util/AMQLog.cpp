@@ -20,8 +20,10 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdio>
 #include <cstring>
 #include <iomanip>
+#include <memory>
 #include <unordered_map>
 
 #ifdef _WIN32
@@ -56,12 +58,40 @@ namespace util
                        std::function<void(AMQLogLevel, const std::string&)>>
                                                  AMQLogger::contextHandlers;
     std::unordered_map<std::string, AMQLogLevel> AMQLogger::contextLevels;
+    std::atomic<int> AMQLogger::enabledCeiling{
+        static_cast<int>(AMQLogLevel::NONE)};
+    std::atomic<uint64_t> AMQLogger::contextLevelsEpoch{1};
+
+    namespace
+    {
+        // Per thread log context along with the level last resolved for it,
+        // the level is valid while epoch matches contextLevelsEpoch.  A
+        // level of -1 means the context has no level of its own.
+        struct ThreadLogContext
+        {
+            std::string context;
+            uint64_t    epoch;
+            int         level;
+
+            ThreadLogContext()
+                : context(),
+                  epoch(0),
+                  level(-1)
+            {
+            }
+        };
+
+        ThreadLogContext& getThreadLogContext()
+        {
+            static thread_local ThreadLogContext threadLogContext;
+            return threadLogContext;
+        }
+    }  // namespace
 
     // Function to access thread-local context (avoids DLL export issues)
     std::string& AMQLogger::getCurrentLogContextImpl()
     {
-        static thread_local std::string currentLogContext;
-        return currentLogContext;
+        return getThreadLogContext().context;
     }
 
     // Flight Recorder static members
@@ -101,9 +131,22 @@ namespace util
         }
     }  // namespace
 
+    void AMQLogger::updateEnabledCeiling()
+    {
+        int ceiling = static_cast<int>(
+            defaultLevel.load(std::memory_order_relaxed));
+        for (const auto& entry : contextLevels)
+        {
+            ceiling = (std::max)(ceiling, static_cast<int>(entry.second));
+        }
+        enabledCeiling.store(ceiling, std::memory_order_relaxed);
+    }
+
     void AMQLogger::setLevel(AMQLogLevel level)
     {
+        std::lock_guard<std::mutex> lock(contextMutex);
         defaultLevel.store(level, std::memory_order_relaxed);
+        updateEnabledCeiling();
     }
 
     AMQLogLevel AMQLogger::getLevel()
@@ -115,6 +158,8 @@ namespace util
     {
         std::lock_guard<std::mutex> lock(contextMutex);
         contextLevels[context] = level;
+        contextLevelsEpoch.fetch_add(1, std::memory_order_release);
+        updateEnabledCeiling();
     }
 
     AMQLogLevel AMQLogger::getLevel(const std::string& context)
@@ -131,31 +176,40 @@ namespace util
     void AMQLogger::clearLevel(const std::string& context)
     {
         std::lock_guard<std::mutex> lock(contextMutex);
-        contextLevels.erase(context);
+        if (contextLevels.erase(context) > 0)
+        {
+            contextLevelsEpoch.fetch_add(1, std::memory_order_release);
+            updateEnabledCeiling();
+        }
     }
 
     AMQLogLevel AMQLogger::getEffectiveLevel()
     {
-        std::string& currentContext = getCurrentLogContextImpl();
-        if (!currentContext.empty())
+        ThreadLogContext& current = getThreadLogContext();
+        if (!current.context.empty())
         {
-            std::lock_guard<std::mutex> lock(contextMutex);
-            auto                        it = contextLevels.find(currentContext);
-            if (it != contextLevels.end())
+            // Only go to the shared map when a context level was changed
+            // since this thread last looked its context up.
+            uint64_t epoch = contextLevelsEpoch.load(std::memory_order_acquire);
+            if (current.epoch != epoch)
             {
-                return it->second;
+                std::lock_guard<std::mutex> lock(contextMutex);
+                auto it       = contextLevels.find(current.context);
+                current.level = it != contextLevels.end()
+                                    ? static_cast<int>(it->second)
+                                    : -1;
+                current.epoch = epoch;
+            }
+
+            if (current.level >= 0)
+            {
+                return static_cast<AMQLogLevel>(current.level);
             }
         }
         // Fall back to default/global level
         return defaultLevel.load(std::memory_order_relaxed);
     }
 
-    bool AMQLogger::isEnabled(AMQLogLevel level)
-    {
-        AMQLogLevel effectiveLevel = getEffectiveLevel();
-        return static_cast<int>(level) <= static_cast<int>(effectiveLevel);
-    }
-
     void AMQLogger::setRecordOnlyMode(bool enabled)
     {
         recordOnlyMode.store(enabled, std::memory_order_relaxed);
@@ -458,15 +512,286 @@ namespace util
     // Flight Recorder Implementation
     ////////////////////////////////////////////////////////////////////////////////
 
+    namespace
+    {
+        // Rings are kept for exited threads so their last events can still
+        // be dumped, past this many rings a new thread takes over the ring
+        // of the thread that exited first.
+        const std::size_t MAX_EVENT_RINGS = 256;
+
+        // One slot of a thread's binary event ring.  The owning thread is
+        // the only writer, seq is used as a seqlock so that a concurrent
+        // dump can detect a slot overwritten while it was being copied.
+        struct EventSlot
+        {
+            std::atomic<uint64_t>                               seq;
+            std::atomic<uint64_t>                               ticks;
+            std::atomic<const AMQLogger::FlightRecorderFormat*> format;
+            std::atomic<uint64_t>
+                args[AMQLogger::FLIGHT_RECORDER_EVENT_ARGS];
+        };
+
+        struct EventRing
+        {
+            std::thread::id              owner;
+            std::size_t                  mask;
+            std::unique_ptr<EventSlot[]> slots;
+            std::atomic<uint64_t>        head;
+            std::atomic<uint64_t>        floor;
+            std::atomic<bool>            retired;
+
+            explicit EventRing(std::size_t capacity)
+                : owner(std::this_thread::get_id()),
+                  mask(capacity - 1),
+                  slots(new EventSlot[capacity]()),
+                  head(0),
+                  floor(0),
+                  retired(false)
+            {
+            }
+
+            void reset()
+            {
+                owner = std::this_thread::get_id();
+                for (std::size_t i = 0; i <= mask; ++i)
+                {
+                    slots[i].seq.store(0, std::memory_order_relaxed);
+                }
+                head.store(0, std::memory_order_relaxed);
+                floor.store(0, std::memory_order_relaxed);
+                retired.store(false, std::memory_order_relaxed);
+            }
+        };
+
+        // Registry of every thread's ring, the generation changes whenever
+        // the recorder is initialized or shut down so threads re-attach.
+        struct EventRecorder
+        {
+            std::mutex                              mutex;
+            std::vector<std::shared_ptr<EventRing>> rings;
+            std::atomic<uint64_t>                   generation;
+            std::size_t                             eventsPerThread;
+
+            EventRecorder()
+                : mutex(),
+                  rings(),
+                  generation(1),
+                  eventsPerThread(1024)
+            {
+            }
+        };
+
+        EventRecorder& getEventRecorder()
+        {
+            static EventRecorder recorder;
+            return recorder;
+        }
+
+        // Holds the calling thread's ring, the ring is only marked retired
+        // when the thread exits so its events outlive the thread.
+        struct ThreadEventRing
+        {
+            std::shared_ptr<EventRing> ring;
+            uint64_t                   generation;
+
+            ThreadEventRing()
+                : ring(),
+                  generation(0)
+            {
+            }
+
+            ~ThreadEventRing()
+            {
+                if (ring)
+                {
+                    ring->retired.store(true, std::memory_order_release);
+                }
+            }
+        };
+
+        EventRing* getThreadEventRing()
+        {
+            static thread_local ThreadEventRing local;
+
+            EventRecorder& recorder = getEventRecorder();
+            if (local.generation ==
+                recorder.generation.load(std::memory_order_acquire))
+            {
+                return local.ring.get();
+            }
+
+            std::lock_guard<std::mutex> lock(recorder.mutex);
+
+            if (local.ring)
+            {
+                local.ring->retired.store(true, std::memory_order_release);
+            }
+            local.ring.reset();
+
+            if (recorder.rings.size() >= MAX_EVENT_RINGS)
+            {
+                for (auto iter = recorder.rings.begin();
+                     iter != recorder.rings.end();
+                     ++iter)
+                {
+                    if ((*iter)->retired.load(std::memory_order_acquire))
+                    {
+                        local.ring = *iter;
+                        local.ring->reset();
+                        recorder.rings.erase(iter);
+                        break;
+                    }
+                }
+            }
+
+            if (!local.ring)
+            {
+                local.ring = std::make_shared<EventRing>(
+                    recorder.eventsPerThread);
+            }
+
+            recorder.rings.push_back(local.ring);
+            local.generation =
+                recorder.generation.load(std::memory_order_relaxed);
+            return local.ring.get();
+        }
+
+        // Copy of a binary event taken while dumping
+        struct EventSnapshot
+        {
+            uint64_t                               ticks;
+            const AMQLogger::FlightRecorderFormat* format;
+            uint64_t        args[AMQLogger::FLIGHT_RECORDER_EVENT_ARGS];
+            std::thread::id owner;
+        };
+
+        // Copies the newest events of a ring, skipping any slot that its
+        // owner overwrote during the copy.
+        void snapshotEventRing(const EventRing&            ring,
+                               std::size_t                 maxEntries,
+                               std::vector<EventSnapshot>& events)
+        {
+            uint64_t head     = ring.head.load(std::memory_order_acquire);
+            uint64_t capacity = static_cast<uint64_t>(ring.mask) + 1;
+            uint64_t first    = head > capacity ? head - capacity : 0;
+
+            first = (std::max)(first,
+                               ring.floor.load(std::memory_order_acquire));
+            if (maxEntries > 0 && head - first > maxEntries)
+            {
+                first = head - maxEntries;
+            }
+
+            for (uint64_t index = first; index < head; ++index)
+            {
+                const EventSlot& slot = ring.slots[index & ring.mask];
+
+                EventSnapshot event;
+                uint64_t      before = slot.seq.load(std::memory_order_acquire);
+                event.ticks  = slot.ticks.load(std::memory_order_relaxed);
+                event.format = slot.format.load(std::memory_order_relaxed);
+                for (int i = 0; i < AMQLogger::FLIGHT_RECORDER_EVENT_ARGS; ++i)
+                {
+                    event.args[i] =
+                        slot.args[i].load(std::memory_order_relaxed);
+                }
+                event.owner = ring.owner;
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (before == index * 2 + 2 &&
+                    slot.seq.load(std::memory_order_relaxed) == before)
+                {
+                    events.push_back(event);
+                }
+            }
+        }
+
+        void copyTruncated(char* dest, std::size_t size, const char* src)
+        {
+            std::size_t length = (std::min)(std::strlen(src), size - 1);
+            std::memcpy(dest, src, length);
+            dest[length] = '\0';
+        }
+
+        // Expands an event's format with its stored arguments
+        void formatEvent(const EventSnapshot&            event,
+                         AMQLogger::FlightRecorderEntry& entry)
+        {
+            entry.timestampTicks = event.ticks;
+            entry.threadId       = event.owner;
+            entry.level          = AMQLogLevel::DBG;
+            copyTruncated(entry.component,
+                          sizeof(entry.component),
+                          event.format->component);
+
+            std::string text;
+            int         next = 0;
+            for (const char* p = event.format->format; *p != '\0'; ++p)
+            {
+                const char* end = *p == '{' ? std::strchr(p, '}') : NULL;
+                if (end == NULL ||
+                    next >= AMQLogger::FLIGHT_RECORDER_EVENT_ARGS)
+                {
+                    text += *p;
+                    continue;
+                }
+
+                std::string spec(p + 1, end);
+                uint64_t    value = event.args[next++];
+                char        buffer[32];
+
+                if (spec == "cmd")
+                {
+                    text += AMQLogger::commandTypeName(
+                        static_cast<unsigned char>(value));
+                }
+                else if (spec == "x")
+                {
+                    std::snprintf(buffer,
+                                  sizeof(buffer),
+                                  "0x%llx",
+                                  static_cast<unsigned long long>(value));
+                    text += buffer;
+                }
+                else
+                {
+                    std::snprintf(buffer,
+                                  sizeof(buffer),
+                                  "%lld",
+                                  static_cast<long long>(value));
+                    text += buffer;
+                }
+                p = end;
+            }
+
+            copyTruncated(entry.message, sizeof(entry.message), text.c_str());
+        }
+    }  // namespace
+
     void AMQLogger::initializeFlightRecorder(double      memoryPercent,
                                              std::size_t minEntries,
-                                             std::size_t maxEntries)
+                                             std::size_t maxEntries,
+                                             std::size_t eventsPerThread)
     {
         if (flightRecorderEnabled.exchange(true))
         {
             return;  // Already initialized
         }
 
+        {
+            EventRecorder&              recorder = getEventRecorder();
+            std::lock_guard<std::mutex> lock(recorder.mutex);
+
+            std::size_t ringSize = 1;
+            while (ringSize < eventsPerThread)
+            {
+                ringSize <<= 1;
+            }
+            recorder.eventsPerThread = ringSize;
+            recorder.rings.clear();
+            recorder.generation.fetch_add(1, std::memory_order_release);
+        }
+
         std::size_t systemMemory = getSystemMemory();
         std::size_t allocBytes =
             static_cast<std::size_t>(systemMemory * memoryPercent);
@@ -524,11 +849,12 @@ namespace util
         flightRecorderBuffer.shrink_to_fit();
         flightRecorderWriteIndex.store(0);
         flightRecorderTotalCount.store(0);
-    }
 
-    bool AMQLogger::isFlightRecorderEnabled()
-    {
-        return flightRecorderEnabled.load(std::memory_order_relaxed);
+        // Threads still holding a ring keep it alive until they re-attach
+        EventRecorder&              recorder = getEventRecorder();
+        std::lock_guard<std::mutex> ringsLock(recorder.mutex);
+        recorder.rings.clear();
+        recorder.generation.fetch_add(1, std::memory_order_release);
     }
 
     void AMQLogger::recordToFlightRecorder(AMQLogLevel level,
@@ -557,17 +883,36 @@ namespace util
         entry.threadId = std::this_thread::get_id();
         entry.level    = level;
 
-        // Copy component (truncate if needed)
-        std::size_t compLen = std::strlen(component);
-        std::size_t copyLen = (std::min)(compLen, sizeof(entry.component) - 1);
-        std::memcpy(entry.component, component, copyLen);
-        entry.component[copyLen] = '\0';
+        // Copy component and message (truncate if needed)
+        copyTruncated(entry.component, sizeof(entry.component), component);
+        copyTruncated(entry.message, sizeof(entry.message), message);
+    }
+
+    void AMQLogger::recordEventArgs(const FlightRecorderFormat* format,
+                                    const uint64_t*             args)
+    {
+        if (!flightRecorderEnabled.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        EventRing* ring  = getThreadEventRing();
+        uint64_t   index = ring->head.load(std::memory_order_relaxed);
+        EventSlot& slot  = ring->slots[index & ring->mask];
 
-        // Copy message (truncate if needed)
-        std::size_t msgLen = std::strlen(message);
-        copyLen            = (std::min)(msgLen, sizeof(entry.message) - 1);
-        std::memcpy(entry.message, message, copyLen);
-        entry.message[copyLen] = '\0';
+        // Odd sequence marks the slot as being written
+        slot.seq.store(index * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.ticks.store(rdtsc(), std::memory_order_relaxed);
+        slot.format.store(format, std::memory_order_relaxed);
+        for (int i = 0; i < FLIGHT_RECORDER_EVENT_ARGS; ++i)
+        {
+            slot.args[i].store(args[i], std::memory_order_relaxed);
+        }
+
+        slot.seq.store(index * 2 + 2, std::memory_order_release);
+        ring->head.store(index + 1, std::memory_order_release);
     }
 
     void AMQLogger::dumpFlightRecorder(std::ostream& out,
@@ -623,10 +968,6 @@ namespace util
         std::lock_guard<std::mutex> lock(flightRecorderDumpMutex);
 
         std::size_t cap = flightRecorderBuffer.size();
-        if (cap == 0)
-        {
-            return;
-        }
 
         uint64_t total =
             flightRecorderTotalCount.load(std::memory_order_acquire);
@@ -642,11 +983,6 @@ namespace util
             validEntries = maxEntries;
         }
 
-        if (validEntries == 0)
-        {
-            return;
-        }
-
         // Start from oldest entry
         uint64_t startIdx;
         if (total <= cap)
@@ -658,11 +994,68 @@ namespace util
             startIdx = currentIdx - validEntries;
         }
 
-        // Output in chronological order
-        for (std::size_t i = 0; i < validEntries; ++i)
+        // Binary events are copied out of every thread's ring first and only
+        // the ones that end up being output are formatted.
+        std::vector<EventSnapshot> events;
+        {
+            EventRecorder&              recorder = getEventRecorder();
+            std::lock_guard<std::mutex> ringsLock(recorder.mutex);
+            for (const auto& ring : recorder.rings)
+            {
+                snapshotEventRing(*ring, maxEntries, events);
+            }
+        }
+
+        std::stable_sort(events.begin(),
+                         events.end(),
+                         [](const EventSnapshot& a, const EventSnapshot& b)
+                         { return a.ticks < b.ticks; });
+
+        // Merge both in chronological order, keeping the newest maxEntries
+        std::size_t available = validEntries + events.size();
+        std::size_t skip       = 0;
+        if (maxEntries > 0 && available > maxEntries)
         {
-            std::size_t bufIdx = static_cast<std::size_t>((startIdx + i) % cap);
-            callback(flightRecorderBuffer[bufIdx]);
+            skip = available - maxEntries;
+        }
+
+        FlightRecorderEntry formatted;
+        std::size_t         entry = 0;
+        std::size_t         event = 0;
+        while (entry < validEntries || event < events.size())
+        {
+            const FlightRecorderEntry* next =
+                entry < validEntries
+                    ? &flightRecorderBuffer[static_cast<std::size_t>(
+                          (startIdx + entry) % cap)]
+                    : NULL;
+
+            bool takeEvent = event < events.size() &&
+                             (next == NULL ||
+                              events[event].ticks < next->timestampTicks);
+
+            if (skip > 0)
+            {
+                --skip;
+            }
+            else if (takeEvent)
+            {
+                formatEvent(events[event], formatted);
+                callback(formatted);
+            }
+            else
+            {
+                callback(*next);
+            }
+
+            if (takeEvent)
+            {
+                ++event;
+            }
+            else
+            {
+                ++entry;
+            }
         }
     }
 
@@ -676,6 +1069,17 @@ namespace util
         std::lock_guard<std::mutex> lock(flightRecorderDumpMutex);
         flightRecorderWriteIndex.store(0, std::memory_order_release);
         flightRecorderTotalCount.store(0, std::memory_order_release);
+
+        {
+            EventRecorder&              recorder = getEventRecorder();
+            std::lock_guard<std::mutex> ringsLock(recorder.mutex);
+            for (const auto& ring : recorder.rings)
+            {
+                ring->floor.store(ring->head.load(std::memory_order_acquire),
+                                  std::memory_order_release);
+            }
+        }
+
         flightRecorderStartTicks     = rdtsc();
         flightRecorderWallClockStart = std::chrono::system_clock::now();
     }
@@ -737,7 +1141,12 @@ namespace util
     ////////////////////////////////////////////////////////////////////////////////
     void AMQLogger::setLogContext(const std::string& context)
     {
-        getCurrentLogContextImpl() = context;
+        ThreadLogContext& current = getThreadLogContext();
+        if (current.context != context)
+        {
+            current.context = context;
+            current.epoch   = 0;
+        }
     }
 
     ////////////////////////////////////////////////////////////////////////////////
@@ -132,6 +132,25 @@ namespace util
             }
         };
 
+        /**
+         * Maximum number of arguments a binary Flight Recorder event carries.
+         */
+        static const int FLIGHT_RECORDER_EVENT_ARGS = 4;
+
+        /**
+         * Static description of a binary Flight Recorder event, one instance
+         * per AMQ_RECORD_EVENT call site.  Events store only a pointer to
+         * their format and the raw argument values, the text is produced
+         * when the Flight Recorder is dumped.  In the format "{}" prints the
+         * next argument in decimal, "{x}" in hex and "{cmd}" as the name of
+         * a command type.
+         */
+        struct FlightRecorderFormat
+        {
+            const char* component;
+            const char* format;
+        };
+
     private:
         // Default/global log level - used when no context is set or context has
         // no specific level
@@ -150,10 +169,21 @@ namespace util
                                                             contextHandlers;
         static std::unordered_map<std::string, AMQLogLevel> contextLevels;
 
+        // Most verbose level enabled by the default level or any context
+        // level, lets isEnabled() reject a statement with one relaxed load
+        static std::atomic<int> enabledCeiling;
+
+        // Bumped whenever a context level changes so threads know to refresh
+        // their cached context level
+        static std::atomic<uint64_t> contextLevelsEpoch;
+
         // Helper to get thread-local context (avoids DLL export issues with
         // thread_local static)
         static std::string& getCurrentLogContextImpl();
 
+        // Recomputes enabledCeiling, caller must hold contextMutex
+        static void updateEnabledCeiling();
+
         // Flight Recorder circular buffer
         static std::vector<FlightRecorderEntry> flightRecorderBuffer;
         static std::atomic<uint64_t>            flightRecorderWriteIndex;
@@ -207,16 +237,29 @@ namespace util
         /**
          * Get the effective log level for the current thread's context.
          * Returns context-specific level if set, otherwise default level.
+         * The context level is cached per thread and only looked up again
+         * after some context level has been changed.
          * @return The effective log level
          */
         static AMQLogLevel getEffectiveLevel();
 
         /**
          * Check if a given level is enabled for the current thread's context.
+         * When neither the default level nor any context level enables the
+         * level this costs a single relaxed atomic load.
          * @param level The level to check
          * @return true if the level is enabled
          */
-        static bool isEnabled(AMQLogLevel level);
+        static bool isEnabled(AMQLogLevel level)
+        {
+            if (static_cast<int>(level) >
+                enabledCeiling.load(std::memory_order_relaxed))
+            {
+                return false;
+            }
+            return static_cast<int>(level) <=
+                   static_cast<int>(getEffectiveLevel());
+        }
 
         /**
          * Enable/disable record-only mode for maximum performance.
@@ -383,10 +426,14 @@ namespace util
          * for 0.5%)
          * @param minEntries Minimum number of entries (default 1024)
          * @param maxEntries Maximum number of entries (default 1M)
+         * @param eventsPerThread Capacity of each thread's binary event ring,
+         * rounded up to a power of two (default 1024)
          */
-        static void initializeFlightRecorder(double      memoryPercent = 0.005,
-                                             std::size_t minEntries    = 1024,
-                                             std::size_t maxEntries = 1048576);
+        static void initializeFlightRecorder(
+            double      memoryPercent   = 0.005,
+            std::size_t minEntries      = 1024,
+            std::size_t maxEntries      = 1048576,
+            std::size_t eventsPerThread = 1024);
 
         /**
          * Shutdown the Flight Recorder and release memory.
@@ -396,11 +443,37 @@ namespace util
         /**
          * Check if the Flight Recorder is enabled.
          */
-        static bool isFlightRecorderEnabled();
+        static bool isFlightRecorderEnabled()
+        {
+            return flightRecorderEnabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Record a binary event into the calling thread's event ring.  No
+         * formatting is done here, the arguments are stored as raw integer
+         * values.  Use the AMQ_RECORD_EVENT macro instead of calling this
+         * directly.
+         *
+         * @param format The static format of the calling site
+         * @param args Up to FLIGHT_RECORDER_EVENT_ARGS integral, enum or
+         * pointer values
+         */
+        template <typename... Args>
+        static void recordEvent(const FlightRecorderFormat* format,
+                                Args... args)
+        {
+            static_assert(sizeof...(Args) <= FLIGHT_RECORDER_EVENT_ARGS,
+                          "Too many Flight Recorder event arguments");
+
+            uint64_t values[FLIGHT_RECORDER_EVENT_ARGS] = {
+                toEventArg(args)...};
+            recordEventArgs(format, values);
+        }
 
         /**
          * Dump all recorded events to an output stream.
-         * Events are output in chronological order.
+         * Events are output in chronological order, binary events from the
+         * per thread rings are formatted and merged with the logged entries.
          * @param out The output stream
          * @param maxEntries Maximum entries to dump (0 = all)
          */
@@ -453,6 +526,24 @@ namespace util
         static void recordToFlightRecorder(AMQLogLevel level,
                                            const char* component,
                                            const char* message);
+
+        /**
+         * Internal: Store a binary event in the calling thread's ring.
+         */
+        static void recordEventArgs(const FlightRecorderFormat* format,
+                                    const uint64_t*             args);
+
+        template <typename T>
+        static uint64_t toEventArg(T value)
+        {
+            return static_cast<uint64_t>(value);
+        }
+
+        template <typename T>
+        static uint64_t toEventArg(T* value)
+        {
+            return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+        }
     };
 
 }  // namespace util
@@ -464,6 +555,16 @@ namespace util
 // These macros provide zero-overhead logging when the level is not enabled.
 // The level check happens before any string construction.
 
+/**
+ * Most verbose level compiled into the client, as the numeric value of an
+ * AMQLogLevel (0 = NONE ... 4 = DBG).  Statements above this level are
+ * removed by the compiler and can never be enabled at runtime, e.g. build
+ * with -DAMQ_LOG_COMPILE_LEVEL=2 to drop all INFO and DEBUG logging.
+ */
+#ifndef AMQ_LOG_COMPILE_LEVEL
+#define AMQ_LOG_COMPILE_LEVEL 4
+#endif
+
 /**
  * Log at DEBUG level.
  * Usage: AMQ_LOG_DEBUG("Component", "Message " << variable << " more text");
@@ -471,7 +572,8 @@ namespace util
 #define AMQ_LOG_DEBUG(component, message)                                    \
     do                                                                       \
     {                                                                        \
-        if (activemq::util::AMQLogger::isEnabled(                            \
+        if (AMQ_LOG_COMPILE_LEVEL >= 4 &&                                    \
+            activemq::util::AMQLogger::isEnabled(                            \
                 activemq::util::AMQLogLevel::DBG))                           \
         {                                                                    \
             std::ostringstream _amq_oss;                                     \
@@ -489,7 +591,8 @@ namespace util
 #define AMQ_LOG_WARN(component, message)                                      \
     do                                                                        \
     {                                                                         \
-        if (activemq::util::AMQLogger::isEnabled(                             \
+        if (AMQ_LOG_COMPILE_LEVEL >= 2 &&                                     \
+            activemq::util::AMQLogger::isEnabled(                             \
                 activemq::util::AMQLogLevel::WARN))                           \
         {                                                                     \
             std::ostringstream _amq_oss;                                      \
@@ -507,7 +610,8 @@ namespace util
 #define AMQ_LOG_INFO(component, message)                                      \
     do                                                                        \
     {                                                                         \
-        if (activemq::util::AMQLogger::isEnabled(                             \
+        if (AMQ_LOG_COMPILE_LEVEL >= 3 &&                                     \
+            activemq::util::AMQLogger::isEnabled(                             \
                 activemq::util::AMQLogLevel::INFO))                           \
         {                                                                     \
             std::ostringstream _amq_oss;                                      \
@@ -525,7 +629,8 @@ namespace util
 #define AMQ_LOG_ERROR(component, message)                                    \
     do                                                                       \
     {                                                                        \
-        if (activemq::util::AMQLogger::isEnabled(                            \
+        if (AMQ_LOG_COMPILE_LEVEL >= 1 &&                                    \
+            activemq::util::AMQLogger::isEnabled(                            \
                 activemq::util::AMQLogLevel::ERR))                           \
         {                                                                    \
             std::ostringstream _amq_oss;                                     \
@@ -536,29 +641,53 @@ namespace util
         }                                                                    \
     } while (0)
 
+/**
+ * Record a binary Flight Recorder event, independent of the log level.
+ * The arguments (one to four integral, enum or pointer values) are stored
+ * raw and the message is only formatted if the recorder is dumped, which
+ * keeps this cheap enough to leave on in production.
+ * Usage: AMQ_RECORD_EVENT("IOTransport", "sent cmdId={} type={cmd}",
+ *                         command->getCommandId(), type);
+ */
+#define AMQ_RECORD_EVENT(component, format, ...)                          \
+    do                                                                    \
+    {                                                                     \
+        if (activemq::util::AMQLogger::isFlightRecorderEnabled())         \
+        {                                                                 \
+            static const activemq::util::AMQLogger::FlightRecorderFormat  \
+                _amq_event_format = {component, format};                  \
+            activemq::util::AMQLogger::recordEvent(&_amq_event_format,    \
+                                                   __VA_ARGS__);          \
+        }                                                                 \
+    } while (0)
+
 /**
  * Check if DEBUG logging is enabled.
  * Useful for avoiding expensive operations when not logging.
  */
-#define AMQ_LOG_DEBUG_ENABLED() \
-    activemq::util::AMQLogger::isEnabled(activemq::util::AMQLogLevel::DBG)
+#define AMQ_LOG_DEBUG_ENABLED()    \
+    (AMQ_LOG_COMPILE_LEVEL >= 4 && \
+     activemq::util::AMQLogger::isEnabled(activemq::util::AMQLogLevel::DBG))
 
 /**
  * Check if INFO logging is enabled.
  */
-#define AMQ_LOG_INFO_ENABLED() \
-    activemq::util::AMQLogger::isEnabled(activemq::util::AMQLogLevel::INFO)
+#define AMQ_LOG_INFO_ENABLED()     \
+    (AMQ_LOG_COMPILE_LEVEL >= 3 && \
+     activemq::util::AMQLogger::isEnabled(activemq::util::AMQLogLevel::INFO))
 
 /**
  * Check if WARN logging is enabled.
  */
-#define AMQ_LOG_WARN_ENABLED() \
-    activemq::util::AMQLogger::isEnabled(activemq::util::AMQLogLevel::WARN)
+#define AMQ_LOG_WARN_ENABLED()     \
+    (AMQ_LOG_COMPILE_LEVEL >= 2 && \
+     activemq::util::AMQLogger::isEnabled(activemq::util::AMQLogLevel::WARN))
 
 /**
  * Check if ERROR logging is enabled.
  */
-#define AMQ_LOG_ERROR_ENABLED() \
-    activemq::util::AMQLogger::isEnabled(activemq::util::AMQLogLevel::ERR)
+#define AMQ_LOG_ERROR_ENABLED()    \
+    (AMQ_LOG_COMPILE_LEVEL >= 1 && \
+     activemq::util::AMQLogger::isEnabled(activemq::util::AMQLogLevel::ERR))
 
 #endif /* _ACTIVEMQ_UTIL_AMQLOG_H_ */
@@ -35,7 +35,8 @@ using namespace std;
 ////////////////////////////////////////////////////////////////////////////////
 PrimitiveMap::PrimitiveMap()
     : decaf::util::StlMap<std::string, PrimitiveValueNode>(),
-      converter()
+      converter(),
+      valueModCount(0)
 {
 }
 
@@ -48,17 +49,43 @@ PrimitiveMap::~PrimitiveMap()
 PrimitiveMap::PrimitiveMap(
     const decaf::util::Map<std::string, PrimitiveValueNode>& src)
     : decaf::util::StlMap<std::string, PrimitiveValueNode>(src),
-      converter()
+      converter(),
+      valueModCount(0)
 {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 PrimitiveMap::PrimitiveMap(const PrimitiveMap& src)
     : decaf::util::StlMap<std::string, PrimitiveValueNode>(src),
-      converter()
+      converter(),
+      valueModCount(0)
 {
 }
 
+////////////////////////////////////////////////////////////////////////////////
+PrimitiveValueNode& PrimitiveMap::get(const std::string& key)
+{
+    PrimitiveValueNode& value =
+        decaf::util::StlMap<std::string, PrimitiveValueNode>::get(key);
+    this->valueModCount++;
+    return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+decaf::util::Set<decaf::util::MapEntry<std::string, PrimitiveValueNode>>&
+PrimitiveMap::entrySet()
+{
+    this->valueModCount++;
+    return decaf::util::StlMap<std::string, PrimitiveValueNode>::entrySet();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+decaf::util::Collection<PrimitiveValueNode>& PrimitiveMap::values()
+{
+    this->valueModCount++;
+    return decaf::util::StlMap<std::string, PrimitiveValueNode>::values();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 std::string PrimitiveMap::toString() const
 {
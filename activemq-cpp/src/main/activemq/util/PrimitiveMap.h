@@ -41,6 +41,10 @@ namespace util
     private:
         PrimitiveValueConverter converter;
 
+        // Times a value was handed out for modification in place, the
+        // StlMap count only covers entries that are put or removed.
+        int valueModCount;
+
     public:
         /**
          * Default Constructor, creates an empty map.
@@ -67,6 +71,48 @@ namespace util
          */
         PrimitiveMap(const PrimitiveMap& source);
 
+        /**
+         * Gets a count that changes each time entries are added to, replaced
+         * in or removed from this Map, and each time a value is handed out
+         * through a non const accessor since it, or a list or map nested in
+         * it, can then be modified in place.
+         *
+         * @return the current modification count.
+         */
+        int getModificationCount() const
+        {
+            return decaf::util::StlMap<std::string, PrimitiveValueNode>::
+                       getModificationCount() +
+                   this->valueModCount;
+        }
+
+        using decaf::util::StlMap<std::string, PrimitiveValueNode>::get;
+        using decaf::util::StlMap<std::string, PrimitiveValueNode>::entrySet;
+        using decaf::util::StlMap<std::string, PrimitiveValueNode>::values;
+
+        /**
+         * {@inheritDoc}
+         *
+         * Counts as a modification, see getModificationCount.
+         */
+        virtual PrimitiveValueNode& get(const std::string& key);
+
+        /**
+         * {@inheritDoc}
+         *
+         * Counts as a modification, see getModificationCount.
+         */
+        virtual decaf::util::Set<
+            decaf::util::MapEntry<std::string, PrimitiveValueNode>>&
+        entrySet();
+
+        /**
+         * {@inheritDoc}
+         *
+         * Counts as a modification, see getModificationCount.
+         */
+        virtual decaf::util::Collection<PrimitiveValueNode>& values();
+
         /**
          * Converts the contents into a formatted string that can be output
          * in a Log File or other debugging tool.
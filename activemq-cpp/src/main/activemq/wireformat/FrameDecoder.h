@@ -0,0 +1,71 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_WIREFORMAT_FRAMEDECODER_H_
+#define _ACTIVEMQ_WIREFORMAT_FRAMEDECODER_H_
+
+#include <activemq/commands/Command.h>
+#include <activemq/util/Config.h>
+#include <decaf/io/IOException.h>
+#include <memory>
+
+namespace activemq
+{
+namespace wireformat
+{
+
+    /**
+     * Decodes Commands from data that arrives in arbitrary sized chunks, such
+     * as the completed reads of a non-blocking Socket.  Unlike the stream
+     * based WireFormat::unmarshal a FrameDecoder never blocks waiting for more
+     * data, it buffers partial frames until the rest of the frame arrives.
+     *
+     * A FrameDecoder instance belongs to a single connection and is not thread
+     * safe, the caller must serialize calls to it.
+     */
+    class AMQCPP_API FrameDecoder
+    {
+    public:
+        virtual ~FrameDecoder();
+
+        /**
+         * Appends the given bytes to the data buffered by this decoder.
+         *
+         * @param buffer
+         *      The bytes to append, copied before this method returns.
+         * @param length
+         *      The number of bytes in the buffer.
+         *
+         * @throws IOException if the data cannot be buffered.
+         */
+        virtual void append(const unsigned char* buffer, int length) = 0;
+
+        /**
+         * Decodes the next Command from the buffered data.
+         *
+         * @return the next Command or an empty pointer if a complete frame
+         * has not been buffered yet.
+         *
+         * @throws IOException if the buffered data is not a valid frame.
+         */
+        virtual std::shared_ptr<commands::Command> nextCommand() = 0;
+    };
+
+}  // namespace wireformat
+}  // namespace activemq
+
+#endif /*_ACTIVEMQ_WIREFORMAT_FRAMEDECODER_H_*/
@@ -24,3 +24,10 @@ using namespace activemq::wireformat;
 WireFormat::~WireFormat()
 {
 }
+
+////////////////////////////////////////////////////////////////////////////////
+FrameDecoder* WireFormat::createFrameDecoder(
+    const activemq::transport::Transport* transport AMQCPP_UNUSED)
+{
+    return NULL;
+}
@@ -18,6 +18,7 @@
 #ifndef _ACTIVEMQ_WIREFORMAT_WIREFORMAT_H_
 #define _ACTIVEMQ_WIREFORMAT_WIREFORMAT_H_
 
+#include <activemq/wireformat/FrameDecoder.h>
 #include <activemq/wireformat/WireFormatNegotiator.h>
 
 #include <decaf/io/DataInputStream.h>
@@ -58,9 +59,10 @@ namespace wireformat
          *
          * @throws IOException if an I/O error occurs.
          */
-        virtual void marshal(const std::shared_ptr<commands::Command> command,
-                             const activemq::transport::Transport*    transport,
-                             decaf::io::DataOutputStream*             out) = 0;
+        virtual void marshal(
+            const std::shared_ptr<commands::Command>& command,
+            const activemq::transport::Transport*     transport,
+            decaf::io::DataOutputStream*              out) = 0;
 
         /**
          * Stream based unmarshaling, blocks on reads on the input stream until
@@ -129,6 +131,23 @@ namespace wireformat
          */
         virtual std::shared_ptr<transport::Transport> createNegotiator(
             const std::shared_ptr<transport::Transport> transport) = 0;
+
+        /**
+         * Creates a FrameDecoder that decodes Commands of this WireFormat from
+         * data delivered in arbitrary chunks, allowing a Transport to be fed
+         * by non-blocking reads instead of a thread blocked in unmarshal.
+         *
+         * The default implementation returns NULL, meaning this WireFormat can
+         * only be read from a blocking stream.
+         *
+         * @param transport
+         *      The Transport that the decoded Commands are read from.
+         *
+         * @return a new FrameDecoder that the caller owns, or NULL if this
+         * WireFormat does not support incremental decoding.
+         */
+        virtual FrameDecoder* createFrameDecoder(
+            const activemq::transport::Transport* transport);
     };
 
 }  // namespace wireformat
@@ -17,21 +17,28 @@
 
 #include "OpenWireFormat.h"
 
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/ActiveMQTempQueue.h>
+#include <activemq/commands/ActiveMQTempTopic.h>
+#include <activemq/commands/ActiveMQTopic.h>
+#include <activemq/commands/ConsumerId.h>
 #include <activemq/commands/DataStructure.h>
 #include <activemq/commands/Message.h>
+#include <activemq/commands/ProducerId.h>
 #include <activemq/commands/WireFormatInfo.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/transport/IOTransport.h>
 #include <activemq/util/AMQLog.h>
 #include <activemq/wireformat/MarshalAware.h>
 #include <activemq/wireformat/openwire/OpenWireFormatNegotiator.h>
+#include <activemq/wireformat/openwire/OpenWireFrameDecoder.h>
 #include <activemq/wireformat/openwire/marshal/DataStreamMarshaller.h>
 #include <activemq/wireformat/openwire/marshal/generated/MarshallerFactory.h>
 #include <activemq/wireformat/openwire/utils/BooleanStream.h>
-#include <decaf/io/ByteArrayOutputStream.h>
 #include <decaf/lang/Boolean.h>
 #include <decaf/lang/Math.h>
 #include <decaf/util/UUID.h>
+#include <cstring>
 
 using namespace std;
 using namespace activemq;
@@ -48,9 +55,23 @@ using namespace decaf::util;
 using namespace decaf::lang;
 using namespace decaf::lang::
     exceptions;  ////////////////////////////////////////////////////////////////////////////////
-const unsigned char OpenWireFormat::NULL_TYPE             = 0;
-const int           OpenWireFormat::DEFAULT_VERSION       = 1;
-const int           OpenWireFormat::MAX_SUPPORTED_VERSION = 11;
+const unsigned char OpenWireFormat::NULL_TYPE                 = 0;
+const int           OpenWireFormat::DEFAULT_VERSION           = 1;
+const int           OpenWireFormat::MAX_SUPPORTED_VERSION     = 11;
+const int           OpenWireFormat::MAX_CACHE_SIZE            = 16383;
+const int           OpenWireFormat::DEFAULT_INTERN_TABLE_SIZE = 1024;
+
+namespace
+{
+
+// The marshal buffer is dropped rather than reset once a single large
+// command has grown it past this size.
+const std::size_t MAX_RETAINED_MARSHAL_BUFFER = 1024 * 1024;
+
+// Marks a flag slot in an intern key that the field didn't read.
+const char INTERN_NO_FLAG = 2;
+
+}  // namespace
 
 ////////////////////////////////////////////////////////////////////////////////
 OpenWireFormat::OpenWireFormat(const decaf::util::Properties& properties)
@@ -63,17 +84,34 @@ OpenWireFormat::OpenWireFormat(const decaf::util::Properties& properties)
       version(0),
       stackTraceEnabled(true),
       tcpNoDelayEnabled(true),
-      cacheEnabled(true),
+      cacheEnabled(false),
       cacheSize(1024),
       tightEncodingEnabled(false),
       sizePrefixDisabled(false),
       maxInactivityDuration(30000),
-      maxInactivityDurationInitialDelay(10000)
+      maxInactivityDurationInitialDelay(10000),
+      maxFrameSize(OpenWireFrameDecoder::DEFAULT_MAX_FRAME_SIZE),
+      marshalCacheMap(),
+      nextMarshalCacheIndex(0),
+      marshalCacheKeyBuffer(),
+      marshalCacheKey(),
+      buildingMarshalCacheKey(false),
+      unmarshalCache(),
+      internTable(DEFAULT_INTERN_TABLE_SIZE),
+      internKey(),
+      marshalBuffer()
 {
     // initialize the universal marshalers, don't need to reset them again
     // after this so its safe to do this here.
     generated::MarshallerFactory().configure(this);
 
+    this->setInternTableSize(std::stoi(
+        properties.getProperty("wireFormat.internTableSize",
+                               std::to_string(DEFAULT_INTERN_TABLE_SIZE))));
+    this->setMaxFrameSize(std::stoi(properties.getProperty(
+        "wireFormat.maxFrameSize",
+        std::to_string(OpenWireFrameDecoder::DEFAULT_MAX_FRAME_SIZE))));
+
     // Set to Default as lowest common denominator, then we will try
     // and move up to the preferred when the wireformat is negotiated.
     this->setVersion(DEFAULT_VERSION);
@@ -102,6 +140,24 @@ std::shared_ptr<Transport> OpenWireFormat::createNegotiator(
     AMQ_CATCHALL_THROW(UnsupportedOperationException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+FrameDecoder* OpenWireFormat::createFrameDecoder(
+    const activemq::transport::Transport* transport)
+{
+    if (this->sizePrefixDisabled ||
+        (this->preferedWireFormatInfo &&
+         this->preferedWireFormatInfo->isSizePrefixDisabled()))
+    {
+        return NULL;
+    }
+
+    return new OpenWireFrameDecoder(
+        this,
+        transport,
+        OpenWireFrameDecoder::DEFAULT_INITIAL_CAPACITY,
+        this->maxFrameSize);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void OpenWireFormat::destroyMarshalers()
 {
@@ -151,6 +207,12 @@ void OpenWireFormat::addMarshaller(DataStreamMarshaller* marshaller)
     dataMarshallers[type & 0xFF] = marshaller;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+DataStreamMarshaller* OpenWireFormat::getMarshaller(unsigned char type) const
+{
+    return dataMarshallers[type & 0xFF];
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void OpenWireFormat::setPreferedWireFormatInfo(
     const std::shared_ptr<commands::WireFormatInfo> info)
@@ -159,9 +221,10 @@ void OpenWireFormat::setPreferedWireFormatInfo(
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void OpenWireFormat::marshal(const std::shared_ptr<commands::Command> command,
-                             const activemq::transport::Transport*    transport,
-                             decaf::io::DataOutputStream*             dataOut)
+void OpenWireFormat::marshal(
+    const std::shared_ptr<commands::Command>& command,
+    const activemq::transport::Transport*     transport,
+    decaf::io::DataOutputStream*              dataOut)
 {
     if (transport == NULL)
     {
@@ -202,6 +265,8 @@ void OpenWireFormat::marshal(const std::shared_ptr<commands::Command> command,
 
             if (tightEncodingEnabled)
             {
+                // The size pass gives the length up front, so the frame is
+                // written straight to the transport's stream.
                 BooleanStream bs;
                 size += dsm->tightMarshal1(this, dataStructure, &bs);
                 size += bs.marshalledSize();
@@ -215,49 +280,40 @@ void OpenWireFormat::marshal(const std::shared_ptr<commands::Command> command,
                 bs.marshal(dataOut);
                 dsm->tightMarshal2(this, dataStructure, dataOut, &bs);
             }
+            else if (sizePrefixDisabled)
+            {
+                dataOut->writeByte(type);
+                dsm->looseMarshal(this, dataStructure, dataOut);
+            }
             else
             {
-                if (sizePrefixDisabled)
+                // The loose size is only known once the command is encoded,
+                // a placeholder is written and filled in afterwards.
+                if (marshalBuffer.capacity() > MAX_RETAINED_MARSHAL_BUFFER)
                 {
-                    dataOut->writeByte(type);
-                    dsm->looseMarshal(this, dataStructure, dataOut);
+                    std::vector<unsigned char>().swap(marshalBuffer);
                 }
-                else
-                {
-                    ByteArrayOutputStream* baos = new ByteArrayOutputStream();
-                    std::unique_ptr<DataOutputStream> looseOut(
-                        new DataOutputStream(baos, true));
 
-                    looseOut->writeByte(type);
-                    dsm->looseMarshal(this, dataStructure, looseOut.get());
-                    looseOut->close();
+                marshalBuffer.clear();
+                ByteWriter writer(marshalBuffer);
 
-                    // Now the data goes to the transport from out byte buffer.
-                    dataOut->writeInt((int)baos->size());
+                writer.writeInt(0);
+                writer.writeByte(type);
+                dsm->looseMarshal(this, dataStructure, &writer);
+                writer.setInt(0, (int)(writer.size() - 4));
 
-                    if (baos->size() > 0)
-                    {
-                        std::pair<unsigned char*, int> array =
-                            baos->toByteArray();
-
-                        try
-                        {
-                            dataOut->write(array.first, array.second);
-                        }
-                        catch (Exception& ex)
-                        {
-                            delete[] array.first;
-                            throw;
-                        }
-
-                        delete[] array.first;
-                    }
-                }
+                // Now the data goes to the transport straight from the buffer
+                // in a single write.
+                dataOut->write(writer.getData(), (int)writer.size());
             }
         }
         else
         {
-            dataOut->writeInt(size);
+            if (!sizePrefixDisabled)
+            {
+                dataOut->writeInt(size);
+            }
+
             dataOut->writeByte(NULL_TYPE);
         }
     }
@@ -268,11 +324,12 @@ void OpenWireFormat::marshal(const std::shared_ptr<commands::Command> command,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-std::shared_ptr<commands::Command> OpenWireFormat::unmarshal(
-    const activemq::transport::Transport* transport,
-    decaf::io::DataInputStream*           dis)
+struct OpenWireFormat::Codec
 {
-    try
+    template <typename In>
+    static std::shared_ptr<Command> unmarshal(OpenWireFormat* self,
+                                              const Transport* transport,
+                                              In*              dis)
     {
         if (dis == NULL)
         {
@@ -281,13 +338,13 @@ std::shared_ptr<commands::Command> OpenWireFormat::unmarshal(
                                          "DataInputStream passed is NULL");
         }
 
-        if (!sizePrefixDisabled)
+        if (!self->sizePrefixDisabled)
         {
             dis->readInt();
         }
 
         // Get the unmarshalled DataStructure
-        std::shared_ptr<DataStructure> data(doUnmarshal(transport, dis));
+        std::shared_ptr<DataStructure> data(self->doUnmarshal(transport, dis));
 
         if (!data)
         {
@@ -305,25 +362,14 @@ std::shared_ptr<commands::Command> OpenWireFormat::unmarshal(
 
         return command;
     }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
-}
 
-////////////////////////////////////////////////////////////////////////////////
-commands::DataStructure* OpenWireFormat::doUnmarshal(
-    const activemq::transport::Transport* transport,
-    DataInputStream*                      dis)
-{
-    try
+    template <typename In>
+    static DataStructure* doUnmarshal(OpenWireFormat*  self,
+                                      const Transport* transport,
+                                      In*              dis)
     {
         // Store current transport for access by marshallers
-        this->currentTransport = transport;
-
-        // Cast transport to IOTransport for partial storage access
-        IOTransport* ioTransport = const_cast<IOTransport*>(
-            dynamic_cast<const IOTransport*>(transport));
+        self->currentTransport = transport;
 
         class Finally
         {
@@ -354,14 +400,13 @@ commands::DataStructure* OpenWireFormat::doUnmarshal(
             }
         }
 
-        finalizer(&(this->receiving), &(this->currentTransport));
+        finalizer(&(self->receiving), &(self->currentTransport));
 
         unsigned char dataType = dis->readByte();
 
         if (dataType != NULL_TYPE)
         {
-            DataStreamMarshaller* dsm = dynamic_cast<DataStreamMarshaller*>(
-                dataMarshallers[dataType & 0xFF]);
+            DataStreamMarshaller* dsm = self->dataMarshallers[dataType & 0xFF];
 
             if (dsm == NULL)
             {
@@ -377,15 +422,15 @@ commands::DataStructure* OpenWireFormat::doUnmarshal(
             // command so that we can fill in its data.
             std::unique_ptr<DataStructure> data(dsm->createObject());
 
-            if (this->tightEncodingEnabled)
+            if (self->tightEncodingEnabled)
             {
                 BooleanStream bs;
                 bs.unmarshal(dis);
-                dsm->tightUnmarshal(this, data.get(), dis, &bs);
+                dsm->tightUnmarshal(self, data.get(), dis, &bs);
             }
             else
             {
-                dsm->looseUnmarshal(this, data.get(), dis);
+                dsm->looseUnmarshal(self, data.get(), dis);
             }
 
             return data.release();
@@ -393,70 +438,12 @@ commands::DataStructure* OpenWireFormat::doUnmarshal(
 
         return NULL;
     }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
-}
-
-////////////////////////////////////////////////////////////////////////////////
-int OpenWireFormat::tightMarshalNestedObject1(commands::DataStructure* object,
-                                              utils::BooleanStream*    bs)
-{
-    try
-    {
-        bs->writeBoolean(object != NULL);
-        if (object == NULL)
-        {
-            return 0;
-        }
-
-        if (object->isMarshalAware())
-        {
-            std::vector<unsigned char> sequence =
-                object->getMarshaledForm(this);
-            bs->writeBoolean(!sequence.empty());
-            if (!sequence.empty())
-            {
-                return (int)(1 + sequence.size());
-            }
-        }
-
-        unsigned char type = object->getDataStructureType();
-        if (type == 0)
-        {
-            throw IOException(
-                __FILE__,
-                __LINE__,
-                "No valid data structure type for object of this type");
-        }
-
-        DataStreamMarshaller* dsm = dataMarshallers[type & 0xFF];
-
-        if (dsm == NULL)
-        {
-            throw IOException(
-                __FILE__,
-                __LINE__,
-                (string("OpenWireFormat::marshal - Unknown data type: ") +
-                 std::to_string(type))
-                    .c_str());
-        }
-
-        return 1 + dsm->tightMarshal1(this, object, bs);
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
-}
 
-////////////////////////////////////////////////////////////////////////////////
-void OpenWireFormat::tightMarshalNestedObject2(DataStructure*    o,
-                                               DataOutputStream* ds,
-                                               BooleanStream*    bs)
-{
-    try
+    template <typename Out>
+    static void tightMarshalNestedObject2(OpenWireFormat* self,
+                                          DataStructure*  o,
+                                          Out*            ds,
+                                          BooleanStream*  bs)
     {
         if (!bs->readBoolean())
         {
@@ -470,12 +457,12 @@ void OpenWireFormat::tightMarshalNestedObject2(DataStructure*    o,
         if (o->isMarshalAware() && bs->readBoolean())
         {
             MarshalAware*         ma       = dynamic_cast<MarshalAware*>(o);
-            vector<unsigned char> sequence = ma->getMarshaledForm(this);
+            vector<unsigned char> sequence = ma->getMarshaledForm(self);
             ds->write(&sequence[0], (int)sequence.size());
         }
         else
         {
-            DataStreamMarshaller* dsm = dataMarshallers[type & 0xFF];
+            DataStreamMarshaller* dsm = self->dataMarshallers[type & 0xFF];
 
             if (dsm == NULL)
             {
@@ -487,176 +474,782 @@ void OpenWireFormat::tightMarshalNestedObject2(DataStructure*    o,
                         .c_str());
             }
 
-            dsm->tightMarshal2(this, o, ds, bs);
+            dsm->tightMarshal2(self, o, ds, bs);
         }
     }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
-}
 
-////////////////////////////////////////////////////////////////////////////////
-DataStructure* OpenWireFormat::tightUnmarshalNestedObject(DataInputStream* dis,
-                                                          BooleanStream*   bs)
-{
-    try
+    template <typename In>
+    static DataStructure* tightUnmarshalNestedObject(OpenWireFormat* self,
+                                                     In*             dis,
+                                                     BooleanStream*  bs)
     {
         if (bs->readBoolean())
         {
             const unsigned char dataType = dis->readByte();
 
-            DataStreamMarshaller* dsm = dataMarshallers[dataType & 0xFF];
-
-            if (dsm == NULL)
-            {
-                throw IOException(
-                    __FILE__,
-                    __LINE__,
-                    (string("OpenWireFormat::marshal - Unknown data type: ") +
-                     std::to_string(dataType))
-                        .c_str());
-            }
-
-            std::unique_ptr<DataStructure> data(dsm->createObject());
-
-            if (data->isMarshalAware() && bs->readBoolean())
-            {
-                dis->readInt();
-                dis->readByte();
-
-                BooleanStream bs2;
-                bs2.unmarshal(dis);
-
-                dsm->tightUnmarshal(this, data.get(), dis, &bs2);
-            }
-            else
-            {
-                dsm->tightUnmarshal(this, data.get(), dis, bs);
-            }
-
-            return data.release();
+            return tightUnmarshalObject(self,
+                                        marshallerFor(self, dataType),
+                                        dis,
+                                        bs);
         }
         else
         {
             return NULL;
         }
     }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
-}
 
-////////////////////////////////////////////////////////////////////////////////
-DataStructure* OpenWireFormat::looseUnmarshalNestedObject(
-    decaf::io::DataInputStream* dis)
-{
-    try
+    template <typename In>
+    static DataStructure* looseUnmarshalNestedObject(OpenWireFormat* self,
+                                                     In*             dis)
     {
         if (dis->readBoolean())
         {
             unsigned char dataType = dis->readByte();
 
-            DataStreamMarshaller* dsm = dataMarshallers[dataType & 0xFF];
-
-            if (dsm == NULL)
-            {
-                throw IOException(
-                    __FILE__,
-                    __LINE__,
-                    (string("OpenWireFormat::marshal - Unknown data type: ") +
-                     std::to_string(dataType))
-                        .c_str());
-            }
-
-            std::unique_ptr<DataStructure> data(dsm->createObject());
-            dsm->looseUnmarshal(this, data.get(), dis);
-            return data.release();
+            return looseUnmarshalObject(self,
+                                        marshallerFor(self, dataType),
+                                        dis);
         }
         else
         {
             return NULL;
         }
     }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
-}
 
-////////////////////////////////////////////////////////////////////////////////
-void OpenWireFormat::looseMarshalNestedObject(
-    commands::DataStructure*     o,
-    decaf::io::DataOutputStream* dataOut)
-{
-    try
+    template <typename In>
+    static std::shared_ptr<DataStructure> tightUnmarshalInternedObject(
+        OpenWireFormat* self,
+        In*             dis,
+        BooleanStream*  bs)
     {
-        dataOut->writeBoolean(o != NULL);
-        if (o != NULL)
+        if (!bs->readBoolean())
         {
-            unsigned char dataType = o->getDataStructureType();
+            return std::shared_ptr<DataStructure>();
+        }
 
-            dataOut->writeByte(dataType);
+        const unsigned char   dataType = dis->readByte();
+        DataStreamMarshaller* dsm      = marshallerFor(self, dataType);
+        const char*           layout   = internLayout(dataType);
 
-            DataStreamMarshaller* dsm = dataMarshallers[dataType & 0xFF];
+        if (layout == NULL || self->internTable.getCapacity() == 0)
+        {
+            return std::shared_ptr<DataStructure>(
+                tightUnmarshalObject(self, dsm, dis, bs));
+        }
 
-            if (dsm == NULL)
-            {
-                throw IOException(
-                    __FILE__,
-                    __LINE__,
-                    (string("OpenWireFormat::marshal - Unknown data type: ") +
-                     std::to_string(dataType))
-                        .c_str());
-            }
+        readInternKey(self, dataType, layout, dis, bs);
 
-            dsm->looseMarshal(this, o, dataOut);
+        std::shared_ptr<DataStructure> object =
+            self->internTable.get(self->internKey);
+
+        if (!object)
+        {
+            object = unmarshalInternKey(self, dsm, layout, true);
+            self->internTable.put(self->internKey, object);
         }
+
+        return object;
     }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
-}
 
-////////////////////////////////////////////////////////////////////////////////
-void OpenWireFormat::renegotiateWireFormat(const WireFormatInfo& info)
-{
-    if (!preferedWireFormatInfo)
+    template <typename In>
+    static std::shared_ptr<DataStructure> looseUnmarshalInternedObject(
+        OpenWireFormat* self,
+        In*             dis)
     {
-        throw IllegalStateException(__FILE__,
-                                    __LINE__,
-                                    "OpenWireFormat::renegotiateWireFormat - "
-                                    "Wireformat cannot not be renegotiated.");
+        if (!dis->readBoolean())
+        {
+            return std::shared_ptr<DataStructure>();
+        }
+
+        const unsigned char   dataType = dis->readByte();
+        DataStreamMarshaller* dsm      = marshallerFor(self, dataType);
+        const char*           layout   = internLayout(dataType);
+
+        if (layout == NULL || self->internTable.getCapacity() == 0)
+        {
+            return std::shared_ptr<DataStructure>(
+                looseUnmarshalObject(self, dsm, dis));
+        }
+
+        readInternKey(self, dataType, layout, dis, (BooleanStream*)NULL);
+
+        std::shared_ptr<DataStructure> object =
+            self->internTable.get(self->internKey);
+
+        if (!object)
+        {
+            object = unmarshalInternKey(self, dsm, layout, false);
+            self->internTable.put(self->internKey, object);
+        }
+
+        return object;
     }
 
-    this->setVersion(
-        Math::min(preferedWireFormatInfo->getVersion(), info.getVersion()));
-    this->stackTraceEnabled = info.isStackTraceEnabled() &&
-                              preferedWireFormatInfo->isStackTraceEnabled();
-    this->tcpNoDelayEnabled = info.isTcpNoDelayEnabled() &&
-                              preferedWireFormatInfo->isTcpNoDelayEnabled();
-    this->cacheEnabled = info.isCacheEnabled() &&
-                         preferedWireFormatInfo->isCacheEnabled();
-    this->tightEncodingEnabled =
-        info.isTightEncodingEnabled() &&
-        preferedWireFormatInfo->isTightEncodingEnabled();
-    this->sizePrefixDisabled = info.isSizePrefixDisabled() &&
-                               preferedWireFormatInfo->isSizePrefixDisabled();
-    this->cacheSize =
-        min(info.getCacheSize(), preferedWireFormatInfo->getCacheSize());
-    this->maxInactivityDuration =
-        min(info.getMaxInactivityDuration(),
-            preferedWireFormatInfo->getMaxInactivityDuration());
-    this->maxInactivityDurationInitialDelay =
-        min(info.getMaxInactivityDurationInitalDelay(),
-            preferedWireFormatInfo->getMaxInactivityDurationInitalDelay());
+    static DataStreamMarshaller* marshallerFor(OpenWireFormat* self,
+                                               unsigned char   dataType)
+    {
+        DataStreamMarshaller* dsm = self->dataMarshallers[dataType & 0xFF];
 
-    AMQ_LOG_INFO("OpenWireFormat",
-                 "Wire format negotiated: version="
-                     << this->version << " cacheEnabled=" << this->cacheEnabled
-                     << " tightEncoding=" << this->tightEncodingEnabled
-                     << " maxInactivityDuration=" << this->maxInactivityDuration
-                     << "ms");
+        if (dsm == NULL)
+        {
+            throw IOException(
+                __FILE__,
+                __LINE__,
+                (string("OpenWireFormat::marshal - Unknown data type: ") +
+                 std::to_string(dataType))
+                    .c_str());
+        }
+
+        return dsm;
+    }
+
+    template <typename In>
+    static DataStructure* tightUnmarshalObject(OpenWireFormat*       self,
+                                               DataStreamMarshaller* dsm,
+                                               In*                   dis,
+                                               BooleanStream*        bs)
+    {
+        std::unique_ptr<DataStructure> data(dsm->createObject());
+
+        if (data->isMarshalAware() && bs->readBoolean())
+        {
+            dis->readInt();
+            dis->readByte();
+
+            BooleanStream bs2;
+            bs2.unmarshal(dis);
+
+            dsm->tightUnmarshal(self, data.get(), dis, &bs2);
+        }
+        else
+        {
+            dsm->tightUnmarshal(self, data.get(), dis, bs);
+        }
+
+        return data.release();
+    }
+
+    template <typename In>
+    static DataStructure* looseUnmarshalObject(OpenWireFormat*       self,
+                                               DataStreamMarshaller* dsm,
+                                               In*                   dis)
+    {
+        std::unique_ptr<DataStructure> data(dsm->createObject());
+        dsm->looseUnmarshal(self, data.get(), dis);
+        return data.release();
+    }
+
+    // The fields of each interned type in wire order, 'S' for a string and
+    // 'L' for a long.  None of them are marshal aware.
+    static const char* internLayout(unsigned char dataType)
+    {
+        switch (dataType)
+        {
+            case ProducerId::ID_PRODUCERID:
+            case ConsumerId::ID_CONSUMERID:
+                return "SLL";
+            case ActiveMQQueue::ID_ACTIVEMQQUEUE:
+            case ActiveMQTopic::ID_ACTIVEMQTOPIC:
+            case ActiveMQTempQueue::ID_ACTIVEMQTEMPQUEUE:
+            case ActiveMQTempTopic::ID_ACTIVEMQTEMPTOPIC:
+                return "S";
+            default:
+                return NULL;
+        }
+    }
+
+    // Reads the wire form of an interned type into the key buffer without
+    // decoding it.  The key holds the type and encoding, then for tight
+    // encoding two slots per field for the flags it read from the boolean
+    // stream, then the bytes of every field as they were on the wire.
+    template <typename In>
+    static void readInternKey(OpenWireFormat* self,
+                              unsigned char   dataType,
+                              const char*     layout,
+                              In*             dis,
+                              BooleanStream*  bs)
+    {
+        std::string& key = self->internKey;
+
+        key.clear();
+        key.push_back((char)dataType);
+        key.push_back(bs != NULL ? 'T' : 'L');
+
+        std::size_t flags = key.size();
+        if (bs != NULL)
+        {
+            key.append(2 * std::strlen(layout), INTERN_NO_FLAG);
+        }
+
+        for (const char* field = layout; *field != '\0'; ++field, flags += 2)
+        {
+            int size = 0;
+
+            if (*field == 'S')
+            {
+                bool present;
+
+                if (bs != NULL)
+                {
+                    present    = bs->readBoolean();
+                    key[flags] = (char)present;
+                    if (present)
+                    {
+                        key[flags + 1] = (char)bs->readBoolean();
+                    }
+                }
+                else
+                {
+                    present = dis->readBoolean();
+                    key.push_back((char)present);
+                }
+
+                if (present)
+                {
+                    // Ascii and modified UTF-8 strings share a length prefix.
+                    unsigned short length = dis->readUnsignedShort();
+                    key.push_back((char)(length >> 8));
+                    key.push_back((char)(length & 0xFF));
+                    size = length;
+                }
+            }
+            else if (bs != NULL)
+            {
+                bool wide      = bs->readBoolean();
+                bool nonZero   = bs->readBoolean();
+                key[flags]     = (char)wide;
+                key[flags + 1] = (char)nonZero;
+                size           = wide ? (nonZero ? 8 : 4) : (nonZero ? 2 : 0);
+            }
+            else
+            {
+                size = 8;
+            }
+
+            if (size > 0)
+            {
+                std::size_t offset = key.size();
+                key.resize(offset + (std::size_t)size);
+                dis->readFully((unsigned char*)&key[offset], size);
+            }
+        }
+    }
+
+    // Unmarshals the object whose wire form is in the key buffer, replaying
+    // the flags and bytes read into it through the type's own marshaller.
+    static std::shared_ptr<DataStructure> unmarshalInternKey(
+        OpenWireFormat*       self,
+        DataStreamMarshaller* dsm,
+        const char*           layout,
+        bool                  tight)
+    {
+        const std::string&   key   = self->internKey;
+        const unsigned char* bytes = (const unsigned char*)key.data();
+        std::size_t          start = 2;
+
+        std::unique_ptr<DataStructure> data(dsm->createObject());
+
+        if (tight)
+        {
+            BooleanStream flags;
+
+            std::size_t end = start + 2 * std::strlen(layout);
+            for (std::size_t i = start; i < end; ++i)
+            {
+                if (key[i] != INTERN_NO_FLAG)
+                {
+                    flags.writeBoolean(key[i] != 0);
+                }
+            }
+
+            // Rewinds to the first flag written.
+            flags.clear();
+
+            ByteReader reader(bytes + end, key.size() - end);
+            dsm->tightUnmarshal(self, data.get(), &reader, &flags);
+        }
+        else
+        {
+            ByteReader reader(bytes + start, key.size() - start);
+            dsm->looseUnmarshal(self, data.get(), &reader);
+        }
+
+        // Once interned the instance is read from any thread, so fill in the
+        // parts destinations otherwise compute on first use.  The ids build
+        // their parent ids under a once_flag and need nothing here.
+        if (ActiveMQDestination* destination =
+                dynamic_cast<ActiveMQDestination*>(data.get()))
+        {
+            destination->getCompositeDestinations();
+        }
+
+        return std::shared_ptr<DataStructure>(data.release());
+    }
+
+    template <typename Out>
+    static void looseMarshalNestedObject(OpenWireFormat* self,
+                                         DataStructure*  o,
+                                         Out*            dataOut)
+    {
+        dataOut->writeBoolean(o != NULL);
+        if (o != NULL)
+        {
+            unsigned char dataType = o->getDataStructureType();
+
+            dataOut->writeByte(dataType);
+
+            DataStreamMarshaller* dsm = self->dataMarshallers[dataType & 0xFF];
+
+            if (dsm == NULL)
+            {
+                throw IOException(
+                    __FILE__,
+                    __LINE__,
+                    (string("OpenWireFormat::marshal - Unknown data type: ") +
+                     std::to_string(dataType))
+                        .c_str());
+            }
+
+            dsm->looseMarshal(self, o, dataOut);
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<commands::Command> OpenWireFormat::unmarshal(
+    const activemq::transport::Transport* transport,
+    decaf::io::DataInputStream*           dis)
+{
+    try
+    {
+        return Codec::unmarshal(this, transport, dis);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<commands::Command> OpenWireFormat::unmarshal(
+    const activemq::transport::Transport* transport,
+    ByteReader*                           dis)
+{
+    try
+    {
+        return Codec::unmarshal(this, transport, dis);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+commands::DataStructure* OpenWireFormat::doUnmarshal(
+    const activemq::transport::Transport* transport,
+    DataInputStream*                      dis)
+{
+    try
+    {
+        return Codec::doUnmarshal(this, transport, dis);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+commands::DataStructure* OpenWireFormat::doUnmarshal(
+    const activemq::transport::Transport* transport,
+    ByteReader*                           dis)
+{
+    try
+    {
+        return Codec::doUnmarshal(this, transport, dis);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int OpenWireFormat::tightMarshalNestedObject1(commands::DataStructure* object,
+                                              utils::BooleanStream*    bs)
+{
+    try
+    {
+        bs->writeBoolean(object != NULL);
+        if (object == NULL)
+        {
+            return 0;
+        }
+
+        if (object->isMarshalAware())
+        {
+            std::vector<unsigned char> sequence =
+                object->getMarshaledForm(this);
+            bs->writeBoolean(!sequence.empty());
+            if (!sequence.empty())
+            {
+                return (int)(1 + sequence.size());
+            }
+        }
+
+        unsigned char type = object->getDataStructureType();
+        if (type == 0)
+        {
+            throw IOException(
+                __FILE__,
+                __LINE__,
+                "No valid data structure type for object of this type");
+        }
+
+        DataStreamMarshaller* dsm = dataMarshallers[type & 0xFF];
+
+        if (dsm == NULL)
+        {
+            throw IOException(
+                __FILE__,
+                __LINE__,
+                (string("OpenWireFormat::marshal - Unknown data type: ") +
+                 std::to_string(type))
+                    .c_str());
+        }
+
+        return 1 + dsm->tightMarshal1(this, object, bs);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::tightMarshalNestedObject2(DataStructure*    o,
+                                               DataOutputStream* ds,
+                                               BooleanStream*    bs)
+{
+    try
+    {
+        Codec::tightMarshalNestedObject2(this, o, ds, bs);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::tightMarshalNestedObject2(DataStructure* o,
+                                               ByteWriter*    ds,
+                                               BooleanStream* bs)
+{
+    try
+    {
+        Codec::tightMarshalNestedObject2(this, o, ds, bs);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+DataStructure* OpenWireFormat::tightUnmarshalNestedObject(DataInputStream* dis,
+                                                          BooleanStream*   bs)
+{
+    try
+    {
+        return Codec::tightUnmarshalNestedObject(this, dis, bs);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+DataStructure* OpenWireFormat::tightUnmarshalNestedObject(ByteReader*    dis,
+                                                          BooleanStream* bs)
+{
+    try
+    {
+        return Codec::tightUnmarshalNestedObject(this, dis, bs);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+DataStructure* OpenWireFormat::looseUnmarshalNestedObject(
+    decaf::io::DataInputStream* dis)
+{
+    try
+    {
+        return Codec::looseUnmarshalNestedObject(this, dis);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+DataStructure* OpenWireFormat::looseUnmarshalNestedObject(ByteReader* dis)
+{
+    try
+    {
+        return Codec::looseUnmarshalNestedObject(this, dis);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<DataStructure> OpenWireFormat::tightUnmarshalInternedObject(
+    DataInputStream* dis,
+    BooleanStream*   bs)
+{
+    try
+    {
+        return Codec::tightUnmarshalInternedObject(this, dis, bs);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<DataStructure> OpenWireFormat::tightUnmarshalInternedObject(
+    ByteReader*    dis,
+    BooleanStream* bs)
+{
+    try
+    {
+        return Codec::tightUnmarshalInternedObject(this, dis, bs);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<DataStructure> OpenWireFormat::looseUnmarshalInternedObject(
+    DataInputStream* dis)
+{
+    try
+    {
+        return Codec::looseUnmarshalInternedObject(this, dis);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<DataStructure> OpenWireFormat::looseUnmarshalInternedObject(
+    ByteReader* dis)
+{
+    try
+    {
+        return Codec::looseUnmarshalInternedObject(this, dis);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::looseMarshalNestedObject(
+    commands::DataStructure*     o,
+    decaf::io::DataOutputStream* dataOut)
+{
+    try
+    {
+        Codec::looseMarshalNestedObject(this, o, dataOut);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::looseMarshalNestedObject(commands::DataStructure* o,
+                                              ByteWriter*              dataOut)
+{
+    try
+    {
+        Codec::looseMarshalNestedObject(this, o, dataOut);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::renegotiateWireFormat(const WireFormatInfo& info)
+{
+    if (!preferedWireFormatInfo)
+    {
+        throw IllegalStateException(__FILE__,
+                                    __LINE__,
+                                    "OpenWireFormat::renegotiateWireFormat - "
+                                    "Wireformat cannot not be renegotiated.");
+    }
+
+    this->setVersion(
+        Math::min(preferedWireFormatInfo->getVersion(), info.getVersion()));
+    this->stackTraceEnabled = info.isStackTraceEnabled() &&
+                              preferedWireFormatInfo->isStackTraceEnabled();
+    this->tcpNoDelayEnabled = info.isTcpNoDelayEnabled() &&
+                              preferedWireFormatInfo->isTcpNoDelayEnabled();
+    this->cacheEnabled = info.isCacheEnabled() &&
+                         preferedWireFormatInfo->isCacheEnabled();
+    this->tightEncodingEnabled =
+        info.isTightEncodingEnabled() &&
+        preferedWireFormatInfo->isTightEncodingEnabled();
+    this->sizePrefixDisabled = info.isSizePrefixDisabled() &&
+                               preferedWireFormatInfo->isSizePrefixDisabled();
+    this->cacheSize =
+        min(info.getCacheSize(), preferedWireFormatInfo->getCacheSize());
+
+    // Whatever was cached under the old settings is unknown to the peer.
+    this->resetMarshalCaches();
+    this->maxInactivityDuration =
+        min(info.getMaxInactivityDuration(),
+            preferedWireFormatInfo->getMaxInactivityDuration());
+    this->maxInactivityDurationInitialDelay =
+        min(info.getMaxInactivityDurationInitalDelay(),
+            preferedWireFormatInfo->getMaxInactivityDurationInitalDelay());
+
+    AMQ_LOG_INFO("OpenWireFormat",
+                 "Wire format negotiated: version="
+                     << this->version << " cacheEnabled=" << this->cacheEnabled
+                     << " tightEncoding=" << this->tightEncodingEnabled
+                     << " maxInactivityDuration=" << this->maxInactivityDuration
+                     << "ms");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int OpenWireFormat::getMarshalCacheIndex(DataStructure* object)
+{
+    if (object == NULL || this->marshalCacheMap.empty())
+    {
+        return -1;
+    }
+
+    std::unordered_map<std::string, short>::const_iterator iter =
+        this->marshalCacheMap.find(encodeMarshalCacheKey(object));
+
+    return iter != this->marshalCacheMap.end() ? iter->second : -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+short OpenWireFormat::addToMarshalCache(DataStructure* object)
+{
+    int limit = MAX_CACHE_SIZE;
+    if (this->cacheSize > 0)
+    {
+        limit = Math::min(this->cacheSize, MAX_CACHE_SIZE);
+    }
+
+    // Entries are never evicted, once full everything is sent in full.
+    if (object == NULL || (int)this->marshalCacheMap.size() >= limit)
+    {
+        return -1;
+    }
+
+    short index = (short)this->nextMarshalCacheIndex++;
+    this->marshalCacheMap[encodeMarshalCacheKey(object)] = index;
+
+    return index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::setSharedInUnmarshalCache(
+    short                                 index,
+    const std::shared_ptr<DataStructure>& object)
+{
+    if (index == -1)
+    {
+        return;
+    }
+
+    if (index < 0 || index >= MAX_CACHE_SIZE)
+    {
+        throw IOException(__FILE__,
+                          __LINE__,
+                          "OpenWireFormat - Invalid cache index: %d",
+                          (int)index);
+    }
+
+    if ((std::size_t)index >= this->unmarshalCache.size())
+    {
+        this->unmarshalCache.resize((std::size_t)index + 1);
+    }
+
+    this->unmarshalCache[index] = object;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<DataStructure> OpenWireFormat::getSharedFromUnmarshalCache(
+    short index) const
+{
+    if (index < 0 || index >= MAX_CACHE_SIZE)
+    {
+        throw IOException(__FILE__,
+                          __LINE__,
+                          "OpenWireFormat - Invalid cache index: %d",
+                          (int)index);
+    }
+
+    if ((std::size_t)index >= this->unmarshalCache.size())
+    {
+        return std::shared_ptr<DataStructure>();
+    }
+
+    return this->unmarshalCache[index];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::resetMarshalCaches()
+{
+    this->marshalCacheMap.clear();
+    this->nextMarshalCacheIndex = 0;
+    this->unmarshalCache.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const std::string& OpenWireFormat::encodeMarshalCacheKey(DataStructure* object)
+{
+    this->marshalCacheKeyBuffer.clear();
+    ByteWriter writer(this->marshalCacheKeyBuffer);
+
+    this->buildingMarshalCacheKey = true;
+    try
+    {
+        Codec::looseMarshalNestedObject(this, object, &writer);
+    }
+    catch (...)
+    {
+        this->buildingMarshalCacheKey = false;
+        throw;
+    }
+    this->buildingMarshalCacheKey = false;
+
+    this->marshalCacheKey.assign((const char*)writer.getData(), writer.size());
+    return this->marshalCacheKey;
 }
@@ -23,11 +23,18 @@
 #include <activemq/util/Config.h>
 #include <activemq/wireformat/WireFormat.h>
 #include <activemq/wireformat/openwire/utils/BooleanStream.h>
+#include <activemq/wireformat/openwire/utils/ByteReader.h>
+#include <activemq/wireformat/openwire/utils/ByteWriter.h>
+#include <activemq/wireformat/openwire/utils/InternTable.h>
+#include <decaf/io/DataOutputStream.h>
 #include <decaf/lang/exceptions/IllegalArgumentException.h>
 #include <decaf/lang/exceptions/IllegalStateException.h>
 #include <decaf/util/Properties.h>
 #include <atomic>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace activemq
 {
@@ -53,6 +60,14 @@ namespace wireformat
             // Defines the maximum supported openwire version
             static const int MAX_SUPPORTED_VERSION;
 
+            // Largest number of entries in the marshal cache, cache indexes
+            // are sent as shorts.
+            static const int MAX_CACHE_SIZE;
+
+            // Number of ids and destinations the intern table holds unless
+            // the wireFormat.internTableSize property says otherwise.
+            static const int DEFAULT_INTERN_TABLE_SIZE;
+
         private:
             // Configuration parameters
             decaf::util::Properties properties;
@@ -84,6 +99,42 @@ namespace wireformat
             long long maxInactivityDuration;
             long long maxInactivityDurationInitialDelay;
 
+            // Largest frame the frame decoder accepts, checked against the
+            // size prefix before the frame is buffered.
+            int maxFrameSize;
+
+            // Marshal cache, maps the loose encoding of each object sent so
+            // far to the index the peer stores it under.  The key is encoded
+            // into the key buffer, nested cached objects are written inline
+            // while it is built.  Only used by the thread that marshals.
+            std::unordered_map<std::string, short> marshalCacheMap;
+            int                                    nextMarshalCacheIndex;
+            std::vector<unsigned char>             marshalCacheKeyBuffer;
+            std::string                            marshalCacheKey;
+            bool                                   buildingMarshalCacheKey;
+
+            // Unmarshal cache, holds each object the peer has sent by the
+            // index it assigned, the instances are handed out to every command
+            // that refers to them.  Only used by the thread that unmarshals.
+            std::vector<std::shared_ptr<commands::DataStructure>>
+                unmarshalCache;
+
+            // Shared instances of the ids and destinations the peer has sent,
+            // keyed by their wire bytes which are read into the key buffer
+            // first so that a repeat is found without decoding it again.
+            // Only used by the thread that unmarshals.
+            utils::InternTable internTable;
+            std::string        internKey;
+
+            // Loose frames with a size prefix are encoded here so the size
+            // can be filled in, then handed to the transport in a single
+            // write.  Kept between calls so its storage is reused.
+            std::vector<unsigned char> marshalBuffer;
+
+            // Holds the implementations shared by the stream and span based
+            // forms of the nested object helpers.
+            struct Codec;
+
         public:
             /**
              * Constructs a new OpenWireFormat object
@@ -107,6 +158,15 @@ namespace wireformat
             virtual std::shared_ptr<transport::Transport> createNegotiator(
                 const std::shared_ptr<transport::Transport> transport);
 
+            /**
+             * {@inheritDoc}
+             *
+             * Returns NULL when the size prefix is disabled since frames can
+             * then only be delimited by unmarshaling them from a stream.
+             */
+            virtual FrameDecoder* createFrameDecoder(
+                const activemq::transport::Transport* transport);
+
             /**
              * Allows an external source to add marshalers to this object for
              * types that may be marshaled or unmarshaled.
@@ -114,13 +174,28 @@ namespace wireformat
              */
             void addMarshaller(marshal::DataStreamMarshaller* marshaler);
 
+            /**
+             * Gets the marshaler registered for the given type.
+             * @param type - the data structure type of the marshaler wanted.
+             * @return the Marshaler or NULL if none is registered for type.
+             */
+            marshal::DataStreamMarshaller* getMarshaller(
+                unsigned char type) const;
+
             /**
              * {@inheritDoc}
+             *
+             * Tight frames and frames without a size prefix are written to
+             * the stream as they are encoded, loose frames with a size prefix
+             * are staged in a buffer the wire format reuses.  Either way the
+             * marshal state is not locked, only one thread may marshal at a
+             * time, which the IOTransport ensures by holding its output
+             * stream's monitor.
              */
             virtual void marshal(
-                const std::shared_ptr<commands::Command> command,
-                const activemq::transport::Transport*    transport,
-                decaf::io::DataOutputStream*             out);
+                const std::shared_ptr<commands::Command>& command,
+                const activemq::transport::Transport*     transport,
+                decaf::io::DataOutputStream*              out);
 
             /**
              * {@inheritDoc}
@@ -129,6 +204,25 @@ namespace wireformat
                 const activemq::transport::Transport* transport,
                 decaf::io::DataInputStream*           in);
 
+            /**
+             * Unmarshals a command from a span holding one complete frame,
+             * including its size prefix unless that is disabled.  This is
+             * the form used by the frame decoder, the command is decoded
+             * straight from the buffered bytes with no stream in between.
+             *
+             * @param transport
+             *      The Transport that is unmarshaling.
+             * @param in
+             *      The reader over the frame's bytes.
+             *
+             * @return the unmarshalled Command.
+             *
+             * @throws IOException if the frame can't be decoded.
+             */
+            std::shared_ptr<commands::Command> unmarshal(
+                const activemq::transport::Transport* transport,
+                utils::ByteReader*                    in);
+
         public:
             /**
              * Utility method for Tight Marshaling the given object to the
@@ -153,6 +247,9 @@ namespace wireformat
             void tightMarshalNestedObject2(commands::DataStructure*     o,
                                            decaf::io::DataOutputStream* ds,
                                            utils::BooleanStream*        bs);
+            void tightMarshalNestedObject2(commands::DataStructure* o,
+                                           utils::ByteWriter*       ds,
+                                           utils::BooleanStream*    bs);
 
             /**
              * Utility method used to Unmarshal a Nested DataStructure type
@@ -166,6 +263,9 @@ namespace wireformat
             commands::DataStructure* tightUnmarshalNestedObject(
                 decaf::io::DataInputStream* dis,
                 utils::BooleanStream*       bs);
+            commands::DataStructure* tightUnmarshalNestedObject(
+                utils::ByteReader*    dis,
+                utils::BooleanStream* bs);
 
             /**
              * Utility method to unmarshal an DataStructure object from an
@@ -178,6 +278,45 @@ namespace wireformat
              */
             commands::DataStructure* looseUnmarshalNestedObject(
                 decaf::io::DataInputStream* dis);
+            commands::DataStructure* looseUnmarshalNestedObject(
+                utils::ByteReader* dis);
+
+            /**
+             * Tight unmarshals a nested object the same way as
+             * tightUnmarshalNestedObject but returns ProducerId, ConsumerId
+             * and destination instances from the intern table, one instance
+             * is shared by every command carrying the same wire bytes.  Other
+             * types are unmarshaled as usual.
+             *
+             * The instances returned may be shared and must not be modified.
+             *
+             * @param dis - DataInputStream to read from
+             * @param bs - BooleanStream to read from
+             * @return the unmarshaled object, empty if it was NULL.
+             * @throws IOException if an error occurs.
+             */
+            std::shared_ptr<commands::DataStructure>
+            tightUnmarshalInternedObject(decaf::io::DataInputStream* dis,
+                                         utils::BooleanStream*       bs);
+            std::shared_ptr<commands::DataStructure>
+            tightUnmarshalInternedObject(utils::ByteReader*    dis,
+                                         utils::BooleanStream* bs);
+
+            /**
+             * Loose unmarshals a nested object the same way as
+             * looseUnmarshalNestedObject but returns ProducerId, ConsumerId
+             * and destination instances from the intern table.
+             *
+             * The instances returned may be shared and must not be modified.
+             *
+             * @param dis - the DataInputStream to read the data from
+             * @return the unmarshaled object, empty if it was NULL.
+             * @throws IOException if an error occurs.
+             */
+            std::shared_ptr<commands::DataStructure>
+            looseUnmarshalInternedObject(decaf::io::DataInputStream* dis);
+            std::shared_ptr<commands::DataStructure>
+            looseUnmarshalInternedObject(utils::ByteReader* dis);
 
             /**
              * Utility method to loosely Marshal an object that is derived from
@@ -189,6 +328,8 @@ namespace wireformat
              */
             void looseMarshalNestedObject(commands::DataStructure*     o,
                                           decaf::io::DataOutputStream* dataOut);
+            void looseMarshalNestedObject(commands::DataStructure* o,
+                                          utils::ByteWriter*       dataOut);
 
             /**
              * Called to re-negotiate the settings for the WireFormatInfo, these
@@ -298,6 +439,16 @@ namespace wireformat
                 return cacheEnabled;
             }
 
+            /**
+             * Checks if objects being marshaled should be sent through the
+             * cache, false while a cache key is being encoded.
+             * @return true if the marshal cache is in use
+             */
+            bool isMarshalCacheEnabled() const
+            {
+                return cacheEnabled && !buildingMarshalCacheKey;
+            }
+
             /**
              * Sets if the cacheEnabled flag is on
              * @param cacheEnabled - true to turn flag is on
@@ -305,6 +456,7 @@ namespace wireformat
             void setCacheEnabled(bool cacheEnabled)
             {
                 this->cacheEnabled = cacheEnabled;
+                this->resetMarshalCaches();
             }
 
             /**
@@ -325,6 +477,66 @@ namespace wireformat
                 this->cacheSize = value;
             }
 
+            /**
+             * Returns the number of ids and destinations kept in the intern
+             * table, zero when interning is disabled.
+             * @return the capacity of the intern table.
+             */
+            int getInternTableSize() const
+            {
+                return this->internTable.getCapacity();
+            }
+
+            /**
+             * Sets the number of ids and destinations kept in the intern
+             * table, the least recently used are dropped once it is full.
+             * Unlike the marshal cache this isn't negotiated with the peer.
+             *
+             * @param value
+             *      The capacity of the intern table, zero disables it.
+             *
+             * @throws IllegalArgumentException if the value is negative.
+             */
+            void setInternTableSize(int value)
+            {
+                this->internTable.setCapacity(value);
+            }
+
+            /**
+             * Returns the largest frame, not counting its size prefix, that
+             * the frame decoders made by this wire format accept.
+             * @return the maximum frame size in bytes.
+             */
+            int getMaxFrameSize() const
+            {
+                return this->maxFrameSize;
+            }
+
+            /**
+             * Sets the largest frame the frame decoders made by this wire
+             * format accept, a larger size prefix is reported as an
+             * IOException before any of the frame is buffered.  Unlike the
+             * other settings this isn't negotiated with the peer.
+             *
+             * @param value
+             *      The maximum frame size in bytes.
+             *
+             * @throws IllegalArgumentException if the value is not positive.
+             */
+            void setMaxFrameSize(int value)
+            {
+                if (value <= 0)
+                {
+                    throw decaf::lang::exceptions::IllegalArgumentException(
+                        __FILE__,
+                        __LINE__,
+                        "Max frame size must be positive: %d",
+                        value);
+                }
+
+                this->maxFrameSize = value;
+            }
+
             /**
              * Checks if the tightEncodingEnabled flag is on
              * @return true if the flag is on.
@@ -399,6 +611,63 @@ namespace wireformat
                 this->maxInactivityDurationInitialDelay = value;
             }
 
+            /**
+             * Looks up the index under which an object with the same wire
+             * form as the given one was sent to the peer.
+             *
+             * @param object
+             *      The object that is about to be marshaled.
+             *
+             * @return the object's cache index or -1 if it is not cached.
+             */
+            int getMarshalCacheIndex(commands::DataStructure* object);
+
+            /**
+             * Assigns the next cache index to the given object, the object
+             * must be marshaled in full along with the index returned so the
+             * peer can store it.  Once the cache is full objects are no longer
+             * cached and the index returned is -1.
+             *
+             * @param object
+             *      The object that is about to be marshaled.
+             *
+             * @return the cache index assigned to the object, or -1 if the
+             * cache is full.
+             */
+            short addToMarshalCache(commands::DataStructure* object);
+
+            /**
+             * Stores an object the peer sent in full under the cache index the
+             * peer assigned it without copying it, later references to the
+             * index yield the same instance.
+             *
+             * @param index
+             *      The cache index sent with the object, -1 if the peer did
+             *      not cache it.
+             * @param object
+             *      The unmarshaled object, may be empty.
+             *
+             * @throws IOException if the index is out of range.
+             */
+            void setSharedInUnmarshalCache(
+                short                                           index,
+                const std::shared_ptr<commands::DataStructure>& object);
+
+            /**
+             * Gets the instance held for an object the peer previously sent
+             * in full, it is shared with the cache and must not be modified.
+             *
+             * @param index
+             *      The cache index the peer sent in place of the object.
+             *
+             * @return the cached object, empty if the peer cached a NULL
+             * value at the index.
+             *
+             * @throws IOException if the index is out of range.
+             */
+            std::shared_ptr<commands::DataStructure>
+            getSharedFromUnmarshalCache(short index) const;
+
             /**
              * Gets the current transport being used for unmarshaling
              * @return the current transport, or nullptr if not unmarshaling
@@ -429,6 +698,9 @@ namespace wireformat
             commands::DataStructure* doUnmarshal(
                 const activemq::transport::Transport* transport,
                 decaf::io::DataInputStream*           dis);
+            commands::DataStructure* doUnmarshal(
+                const activemq::transport::Transport* transport,
+                utils::ByteReader*                    dis);
 
             /**
              * Cleans up all registered Marshallers and empties the
@@ -437,6 +709,21 @@ namespace wireformat
              * this object
              */
             void destroyMarshalers();
+
+            /**
+             * Empties both marshaling caches and sizes them for the currently
+             * negotiated cache size.
+             */
+            void resetMarshalCaches();
+
+            /**
+             * Encodes the marshal cache key of the given object, its loose
+             * wire form without the cache applied to nested objects.
+             *
+             * @return the key, valid until the next key is encoded.
+             */
+            const std::string& encodeMarshalCacheKey(
+                commands::DataStructure* object);
         };
 
     }  // namespace openwire
@@ -47,6 +47,7 @@ OpenWireFormatNegotiator::OpenWireFormatNegotiator(
       firstTime(true),
       wireInfoSentDownLatch(1),
       readyCountDownLatch(1),
+      ready(false),
       openWireFormat(wireFormat)
 {
 }
@@ -62,32 +63,38 @@ OpenWireFormatNegotiator::~OpenWireFormatNegotiator()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void OpenWireFormatNegotiator::oneway(const std::shared_ptr<Command> command)
+void OpenWireFormatNegotiator::oneway(const std::shared_ptr<Command>& command)
 {
     try
     {
         checkClosed();
 
-        AMQ_LOG_DEBUG(
-            "OpenWireFormatNegotiator",
-            "oneway() waiting for negotiation cmdId="
-                << command->getCommandId() << " type="
-                << AMQLogger::commandTypeName(command->getDataStructureType()));
-
-        if (!readyCountDownLatch.await(negotiationTimeout))
+        if (!ready.load(std::memory_order_acquire))
         {
-            throw IOException(__FILE__,
-                              __LINE__,
-                              "OpenWireFormatNegotiator::oneway"
-                              "Wire format negotiation timeout: peer did not "
-                              "send his wire format.");
-        }
+            AMQ_LOG_DEBUG(
+                "OpenWireFormatNegotiator",
+                "oneway() waiting for negotiation cmdId="
+                    << command->getCommandId() << " type="
+                    << AMQLogger::commandTypeName(
+                           command->getDataStructureType()));
+
+            if (!awaitReady())
+            {
+                throw IOException(
+                    __FILE__,
+                    __LINE__,
+                    "OpenWireFormatNegotiator::oneway"
+                    "Wire format negotiation timeout: peer did not "
+                    "send his wire format.");
+            }
 
-        AMQ_LOG_DEBUG(
-            "OpenWireFormatNegotiator",
-            "oneway() negotiation complete, sending cmdId="
-                << command->getCommandId() << " type="
-                << AMQLogger::commandTypeName(command->getDataStructureType()));
+            AMQ_LOG_DEBUG(
+                "OpenWireFormatNegotiator",
+                "oneway() negotiation complete, sending cmdId="
+                    << command->getCommandId() << " type="
+                    << AMQLogger::commandTypeName(
+                           command->getDataStructureType()));
+        }
 
         next->oneway(command);
     }
@@ -105,7 +112,7 @@ std::shared_ptr<Response> OpenWireFormatNegotiator::request(
     {
         checkClosed();
 
-        if (!readyCountDownLatch.await(negotiationTimeout))
+        if (!awaitReady())
         {
             throw IOException(__FILE__,
                               __LINE__,
@@ -131,7 +138,7 @@ std::shared_ptr<Response> OpenWireFormatNegotiator::request(
     {
         checkClosed();
 
-        if (!readyCountDownLatch.await(negotiationTimeout))
+        if (!awaitReady())
         {
             throw IOException(__FILE__,
                               __LINE__,
@@ -176,7 +183,7 @@ void OpenWireFormatNegotiator::onCommand(const std::shared_ptr<Command> command)
             AMQ_LOG_DEBUG("OpenWireFormatNegotiator",
                           "onCommand() renegotiation done, counting down "
                           "readyCountDownLatch");
-            readyCountDownLatch.countDown();
+            markReady();
         }
         catch (exceptions::ActiveMQException& ex)
         {
@@ -184,7 +191,7 @@ void OpenWireFormatNegotiator::onCommand(const std::shared_ptr<Command> command)
                 "OpenWireFormatNegotiator",
                 "onCommand() exception during WireFormatInfo processing: "
                     << ex.getMessage());
-            readyCountDownLatch.countDown();
+            markReady();
             TransportFilter::onCommand(command);
         }
     }
@@ -196,13 +203,31 @@ void OpenWireFormatNegotiator::onCommand(const std::shared_ptr<Command> command)
 ////////////////////////////////////////////////////////////////////////////////
 void OpenWireFormatNegotiator::onException(const decaf::lang::Exception& ex)
 {
-    readyCountDownLatch.countDown();
+    markReady();
     TransportFilter::onException(ex);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void OpenWireFormatNegotiator::afterNextIsStopped()
 {
+    markReady();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool OpenWireFormatNegotiator::awaitReady()
+{
+    if (ready.load(std::memory_order_acquire))
+    {
+        return true;
+    }
+
+    return readyCountDownLatch.await(negotiationTimeout);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatNegotiator::markReady()
+{
+    ready.store(true, std::memory_order_release);
     readyCountDownLatch.countDown();
 }
 
@@ -56,6 +56,12 @@ namespace wireformat
             decaf::util::concurrent::CountDownLatch wireInfoSentDownLatch;
             decaf::util::concurrent::CountDownLatch readyCountDownLatch;
 
+            /**
+             * Set once readyCountDownLatch has been counted down so that sends
+             * made after negotiation skip the latch and its monitor entirely.
+             */
+            std::atomic<bool> ready;
+
             /**
              * The OpenWireFormat object that we use in negotiation.
              */
@@ -65,6 +71,18 @@ namespace wireformat
             OpenWireFormatNegotiator(const OpenWireFormatNegotiator&);
             OpenWireFormatNegotiator& operator=(const OpenWireFormatNegotiator&);
 
+            /**
+             * Waits for negotiation to finish, returning false on timeout.
+             * Only the first sends pay for the latch, later ones see the
+             * ready flag.
+             */
+            bool awaitReady();
+
+            /**
+             * Releases everyone waiting on negotiation.
+             */
+            void markReady();
+
         public:
             /**
              * Constructor - Initializes this object around another Transport
@@ -78,7 +96,7 @@ namespace wireformat
             virtual ~OpenWireFormatNegotiator();
 
             virtual void oneway(
-                const std::shared_ptr<commands::Command> command);
+                const std::shared_ptr<commands::Command>& command);
 
             virtual std::shared_ptr<commands::Response> request(
                 const std::shared_ptr<commands::Command> command);
@@ -0,0 +1,229 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OpenWireFrameDecoder.h"
+
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <activemq/wireformat/openwire/utils/ByteReader.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <cstring>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+const int OpenWireFrameDecoder::DEFAULT_INITIAL_CAPACITY = 8192;
+const int OpenWireFrameDecoder::MAX_RETAINED_CAPACITY    = 1024 * 1024;
+const int OpenWireFrameDecoder::DEFAULT_MAX_FRAME_SIZE   = 100 * 1024 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+OpenWireFrameDecoder::OpenWireFrameDecoder(OpenWireFormat*  wireFormat,
+                                           const Transport* transport,
+                                           int              initialCapacity,
+                                           int              maxFrameSize)
+    : wireFormat(wireFormat),
+      transport(transport),
+      buffer(),
+      head(0),
+      tail(0),
+      initialCapacity(0),
+      maxFrameSize(maxFrameSize),
+      frameSize(-1)
+{
+    if (wireFormat == NULL)
+    {
+        throw NullPointerException(__FILE__,
+                                   __LINE__,
+                                   "OpenWireFormat passed is NULL");
+    }
+
+    if (initialCapacity <= 0)
+    {
+        throw IllegalArgumentException(__FILE__,
+                                       __LINE__,
+                                       "Initial capacity must be positive: %d",
+                                       initialCapacity);
+    }
+
+    if (maxFrameSize <= 0)
+    {
+        throw IllegalArgumentException(__FILE__,
+                                       __LINE__,
+                                       "Max frame size must be positive: %d",
+                                       maxFrameSize);
+    }
+
+    this->initialCapacity = (std::size_t)initialCapacity;
+    this->buffer.resize(this->initialCapacity);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+OpenWireFrameDecoder::~OpenWireFrameDecoder()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFrameDecoder::append(const unsigned char* data, int length)
+{
+    if (length < 0)
+    {
+        throw IOException(__FILE__,
+                          __LINE__,
+                          "OpenWireFrameDecoder - Invalid length: %d",
+                          length);
+    }
+
+    if (length == 0)
+    {
+        return;
+    }
+
+    if (data == NULL)
+    {
+        throw IOException(__FILE__,
+                          __LINE__,
+                          "OpenWireFrameDecoder - Buffer passed is NULL");
+    }
+
+    if (this->head == this->tail)
+    {
+        this->head = 0;
+        this->tail = 0;
+
+        // Don't hold on to the memory used by an unusually large frame.
+        if (this->buffer.size() > (std::size_t)MAX_RETAINED_CAPACITY &&
+            this->frameSize < 0)
+        {
+            std::vector<unsigned char>(this->initialCapacity)
+                .swap(this->buffer);
+        }
+    }
+
+    this->ensureWritable((std::size_t)length);
+
+    std::memcpy(&this->buffer[this->tail], data, (std::size_t)length);
+    this->tail += (std::size_t)length;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<Command> OpenWireFrameDecoder::nextCommand()
+{
+    std::size_t available = this->tail - this->head;
+
+    if (this->frameSize < 0)
+    {
+        if (available < 4)
+        {
+            return std::shared_ptr<Command>();
+        }
+
+        const unsigned char* prefix = &this->buffer[this->head];
+
+        int size = (int)(((unsigned int)prefix[0] << 24) |
+                         ((unsigned int)prefix[1] << 16) |
+                         ((unsigned int)prefix[2] << 8) |
+                         (unsigned int)prefix[3]);
+
+        if (size < 0)
+        {
+            throw IOException(__FILE__,
+                              __LINE__,
+                              "OpenWireFrameDecoder - Invalid frame size: %d",
+                              size);
+        }
+
+        if (size > this->maxFrameSize)
+        {
+            throw IOException(
+                __FILE__,
+                __LINE__,
+                "OpenWireFrameDecoder - Frame size of %d larger than max "
+                "allowed %d",
+                size,
+                this->maxFrameSize);
+        }
+
+        this->frameSize = size;
+    }
+
+    std::size_t frameLength = 4 + (std::size_t)this->frameSize;
+
+    if (available < frameLength)
+    {
+        return std::shared_ptr<Command>();
+    }
+
+    // Reads the frame in place, the buffer isn't touched until this returns.
+    ByteReader frame(&this->buffer[this->head], frameLength);
+
+    this->head      += frameLength;
+    this->frameSize  = -1;
+
+    return this->wireFormat->unmarshal(this->transport, &frame);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFrameDecoder::reset()
+{
+    this->head      = 0;
+    this->tail      = 0;
+    this->frameSize = -1;
+
+    if (this->buffer.size() > (std::size_t)MAX_RETAINED_CAPACITY)
+    {
+        std::vector<unsigned char>(this->initialCapacity).swap(this->buffer);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFrameDecoder::ensureWritable(std::size_t length)
+{
+    if (this->buffer.size() - this->tail >= length)
+    {
+        return;
+    }
+
+    // Move the unread bytes to the front before growing the buffer.
+    std::size_t unread = this->tail - this->head;
+    if (this->head > 0)
+    {
+        if (unread > 0)
+        {
+            std::memmove(&this->buffer[0], &this->buffer[this->head], unread);
+        }
+
+        this->head = 0;
+        this->tail = unread;
+    }
+
+    if (this->buffer.size() - this->tail < length)
+    {
+        std::size_t required = this->tail + length;
+        std::size_t capacity = this->buffer.size() * 2;
+
+        this->buffer.resize(capacity > required ? capacity : required);
+    }
+}
@@ -0,0 +1,151 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_WIREFORMAT_OPENWIRE_OPENWIREFRAMEDECODER_H_
+#define _ACTIVEMQ_WIREFORMAT_OPENWIRE_OPENWIREFRAMEDECODER_H_
+
+#include <activemq/commands/Command.h>
+#include <activemq/util/Config.h>
+#include <activemq/wireformat/FrameDecoder.h>
+#include <decaf/io/IOException.h>
+#include <memory>
+#include <vector>
+
+namespace activemq
+{
+namespace transport
+{
+    class Transport;
+}
+
+namespace wireformat
+{
+    namespace openwire
+    {
+
+        class OpenWireFormat;
+
+        /**
+         * Incremental decoder for size prefixed OpenWire frames.
+         *
+         * Bytes are appended to a per-connection buffer that is reused for the
+         * life of the connection.  Once the four byte size prefix of a frame
+         * has been buffered it is remembered so that later calls resume where
+         * the last left off.  A frame larger than the maximum frame size is
+         * rejected as soon as its prefix is read, and the buffer only grows
+         * as the bytes of a frame arrive so a bad prefix can't make it
+         * allocate memory for data that was never sent.  When the complete
+         * frame is buffered it is handed to the OpenWireFormat's unmarshal
+         * through a ByteReader so the marshallers decode it straight from the
+         * buffer.
+         *
+         * Unread bytes are moved to the front of the buffer instead of being
+         * allowed to wrap, which keeps every frame contiguous so it can be
+         * unmarshaled without first being copied out.
+         *
+         * Instances of this class are not thread safe.
+         */
+        class AMQCPP_API OpenWireFrameDecoder : public wireformat::FrameDecoder
+        {
+        public:
+            // Initial capacity of the buffer if none is specified.
+            static const int DEFAULT_INITIAL_CAPACITY;
+
+            // Largest buffer kept once it drains, larger ones are released.
+            static const int MAX_RETAINED_CAPACITY;
+
+            // Largest frame accepted if no maximum frame size is specified.
+            static const int DEFAULT_MAX_FRAME_SIZE;
+
+        private:
+            OpenWireFormat*                       wireFormat;
+            const activemq::transport::Transport* transport;
+
+            std::vector<unsigned char> buffer;
+            std::size_t                head;
+            std::size_t                tail;
+            std::size_t                initialCapacity;
+            int                        maxFrameSize;
+
+            // Size of the frame at head, or -1 until its prefix is buffered.
+            int frameSize;
+
+        private:
+            OpenWireFrameDecoder(const OpenWireFrameDecoder&);
+            OpenWireFrameDecoder& operator=(const OpenWireFrameDecoder&);
+
+        public:
+            /**
+             * Creates a new decoder for frames read by the given Transport.
+             *
+             * @param wireFormat
+             *      The OpenWireFormat used to unmarshal complete frames.
+             * @param transport
+             *      The Transport that the frames are read from, passed on to
+             *      the OpenWireFormat's unmarshal.
+             * @param initialCapacity
+             *      The initial size of the decoder's buffer.
+             * @param maxFrameSize
+             *      The largest frame size accepted, not counting the prefix.
+             *
+             * @throws NullPointerException if the wireFormat is NULL.
+             * @throws IllegalArgumentException if initialCapacity or
+             * maxFrameSize is not positive.
+             */
+            OpenWireFrameDecoder(
+                OpenWireFormat*                       wireFormat,
+                const activemq::transport::Transport* transport,
+                int initialCapacity = DEFAULT_INITIAL_CAPACITY,
+                int maxFrameSize    = DEFAULT_MAX_FRAME_SIZE);
+
+            virtual ~OpenWireFrameDecoder();
+
+            virtual void append(const unsigned char* buffer, int length);
+
+            virtual std::shared_ptr<commands::Command> nextCommand();
+
+            /**
+             * @return the number of bytes buffered that have not yet been
+             * decoded.
+             */
+            std::size_t getBufferedSize() const
+            {
+                return this->tail - this->head;
+            }
+
+            /**
+             * @return the current capacity of the decoder's buffer.
+             */
+            std::size_t getCapacity() const
+            {
+                return this->buffer.size();
+            }
+
+            /**
+             * Discards any buffered data, including a partially read frame.
+             */
+            void reset();
+
+        private:
+            void ensureWritable(std::size_t length);
+        };
+
+    }  // namespace openwire
+}  // namespace wireformat
+}  // namespace activemq
+
+#endif /*_ACTIVEMQ_WIREFORMAT_OPENWIRE_OPENWIREFRAMEDECODER_H_*/
@@ -25,6 +25,7 @@
 #include <activemq/util/Config.h>
 #include <activemq/wireformat/openwire/marshal/BaseDataStreamMarshaller.h>
 #include <activemq/wireformat/openwire/utils/HexTable.h>
+#include <decaf/internal/util/ModifiedUTF8.h>
 #include <memory>
 #include <string>
 
@@ -40,23 +41,821 @@ using namespace activemq::wireformat::openwire::utils;
 using namespace decaf::io;
 using namespace decaf::util;
 using namespace decaf::lang;
+using decaf::internal::util::ModifiedUTF8;
 
 ////////////////////////////////////////////////////////////////////////////////
 utils::HexTable BaseDataStreamMarshaller::hexTable;
 
 ////////////////////////////////////////////////////////////////////////////////
-commands::DataStructure* BaseDataStreamMarshaller::tightUnmarshalCachedObject(
-    OpenWireFormat*             wireFormat,
-    decaf::io::DataInputStream* dataIn,
-    utils::BooleanStream*       bs)
+struct BaseDataStreamMarshaller::Codec
 {
-    try
+    template <typename In>
+    static std::shared_ptr<DataStructure> tightUnmarshalCachedObject(
+        OpenWireFormat* wireFormat,
+        In*             dataIn,
+        BooleanStream*  bs)
     {
-        return wireFormat->tightUnmarshalNestedObject(dataIn, bs);
+        try
+        {
+            if (wireFormat->isCacheEnabled())
+            {
+                bool  inlined = bs->readBoolean();
+                short index   = dataIn->readShort();
+
+                if (inlined)
+                {
+                    std::shared_ptr<DataStructure> object(
+                        wireFormat->tightUnmarshalNestedObject(dataIn, bs));
+                    wireFormat->setSharedInUnmarshalCache(index, object);
+                    return object;
+                }
+
+                return wireFormat->getSharedFromUnmarshalCache(index);
+            }
+
+            return std::shared_ptr<DataStructure>(
+                wireFormat->tightUnmarshalNestedObject(dataIn, bs));
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
     }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+
+    template <typename Out>
+    static void tightMarshalCachedObject2(OpenWireFormat* wireFormat,
+                                          DataStructure*  data,
+                                          Out*            dataOut,
+                                          BooleanStream*  bs)
+    {
+        try
+        {
+            if (wireFormat->isMarshalCacheEnabled())
+            {
+                // Added to the cache by the first pass, -1 if it was full.
+                int index = wireFormat->getMarshalCacheIndex(data);
+                dataOut->writeShort((short)index);
+
+                if (bs->readBoolean())
+                {
+                    wireFormat->tightMarshalNestedObject2(data, dataOut, bs);
+                }
+
+                return;
+            }
+
+            wireFormat->tightMarshalNestedObject2(data, dataOut, bs);
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename Out>
+    static void looseMarshalCachedObject(OpenWireFormat* wireFormat,
+                                         DataStructure*  data,
+                                         Out*            dataOut)
+    {
+        try
+        {
+            if (wireFormat->isMarshalCacheEnabled())
+            {
+                int index = wireFormat->getMarshalCacheIndex(data);
+                dataOut->writeBoolean(index == -1);
+
+                if (index == -1)
+                {
+                    dataOut->writeShort(wireFormat->addToMarshalCache(data));
+                    wireFormat->looseMarshalNestedObject(data, dataOut);
+                }
+                else
+                {
+                    dataOut->writeShort((short)index);
+                }
+
+                return;
+            }
+
+            wireFormat->looseMarshalNestedObject(data, dataOut);
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename In>
+    static std::shared_ptr<DataStructure> looseUnmarshalCachedObject(
+        OpenWireFormat* wireFormat,
+        In*             dataIn)
+    {
+        try
+        {
+            if (wireFormat->isCacheEnabled())
+            {
+                bool  inlined = dataIn->readBoolean();
+                short index   = dataIn->readShort();
+
+                if (inlined)
+                {
+                    std::shared_ptr<DataStructure> object(
+                        wireFormat->looseUnmarshalNestedObject(dataIn));
+                    wireFormat->setSharedInUnmarshalCache(index, object);
+                    return object;
+                }
+
+                return wireFormat->getSharedFromUnmarshalCache(index);
+            }
+
+            return std::shared_ptr<DataStructure>(
+                wireFormat->looseUnmarshalNestedObject(dataIn));
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename In>
+    static std::shared_ptr<DataStructure> tightUnmarshalInternedCachedObject(
+        OpenWireFormat* wireFormat,
+        In*             dataIn,
+        BooleanStream*  bs)
+    {
+        try
+        {
+            if (wireFormat->isCacheEnabled())
+            {
+                bool  inlined = bs->readBoolean();
+                short index   = dataIn->readShort();
+
+                if (inlined)
+                {
+                    std::shared_ptr<DataStructure> object =
+                        wireFormat->tightUnmarshalInternedObject(dataIn, bs);
+                    wireFormat->setSharedInUnmarshalCache(index, object);
+                    return object;
+                }
+
+                return wireFormat->getSharedFromUnmarshalCache(index);
+            }
+
+            return wireFormat->tightUnmarshalInternedObject(dataIn, bs);
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename In>
+    static std::shared_ptr<DataStructure> looseUnmarshalInternedCachedObject(
+        OpenWireFormat* wireFormat,
+        In*             dataIn)
+    {
+        try
+        {
+            if (wireFormat->isCacheEnabled())
+            {
+                bool  inlined = dataIn->readBoolean();
+                short index   = dataIn->readShort();
+
+                if (inlined)
+                {
+                    std::shared_ptr<DataStructure> object =
+                        wireFormat->looseUnmarshalInternedObject(dataIn);
+                    wireFormat->setSharedInUnmarshalCache(index, object);
+                    return object;
+                }
+
+                return wireFormat->getSharedFromUnmarshalCache(index);
+            }
+
+            return wireFormat->looseUnmarshalInternedObject(dataIn);
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename Out>
+    static void tightMarshalNestedObject2(OpenWireFormat* wireFormat,
+                                          DataStructure*  object,
+                                          Out*            dataOut,
+                                          BooleanStream*  bs)
+    {
+        try
+        {
+            wireFormat->tightMarshalNestedObject2(object, dataOut, bs);
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename In>
+    static DataStructure* tightUnmarshalNestedObject(OpenWireFormat* wireFormat,
+                                                     In*             dataIn,
+                                                     BooleanStream*  bs)
+    {
+        try
+        {
+            return wireFormat->tightUnmarshalNestedObject(dataIn, bs);
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename In>
+    static DataStructure* looseUnmarshalNestedObject(OpenWireFormat* wireFormat,
+                                                     In*             dataIn)
+    {
+        try
+        {
+            return wireFormat->looseUnmarshalNestedObject(dataIn);
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename In>
+    static std::shared_ptr<DataStructure> tightUnmarshalInternedNestedObject(
+        OpenWireFormat* wireFormat,
+        In*             dataIn,
+        BooleanStream*  bs)
+    {
+        try
+        {
+            return wireFormat->tightUnmarshalInternedObject(dataIn, bs);
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename In>
+    static std::shared_ptr<DataStructure> looseUnmarshalInternedNestedObject(
+        OpenWireFormat* wireFormat,
+        In*             dataIn)
+    {
+        try
+        {
+            return wireFormat->looseUnmarshalInternedObject(dataIn);
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename Out>
+    static void looseMarshalNestedObject(OpenWireFormat* wireFormat,
+                                         DataStructure*  object,
+                                         Out*            dataOut)
+    {
+        try
+        {
+            wireFormat->looseMarshalNestedObject(object, dataOut);
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename In>
+    static std::string tightUnmarshalString(BaseDataStreamMarshaller* self,
+                                            In*                       dataIn,
+                                            BooleanStream*            bs)
+    {
+        try
+        {
+            if (bs->readBoolean())
+            {
+                if (bs->readBoolean())
+                {
+                    return self->readAsciiString(dataIn);
+                }
+                else
+                {
+                    return dataIn->readUTF();
+                }
+            }
+            else
+            {
+                return "";
+            }
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename Out>
+    static void tightMarshalString2(const std::string& value,
+                                    Out*               dataOut,
+                                    BooleanStream*     bs)
+    {
+        try
+        {
+            if (bs->readBoolean())
+            {
+                // If we verified it only holds ascii values
+                if (bs->readBoolean())
+                {
+                    dataOut->writeShort((short)value.length());
+                    dataOut->writeBytes(value);
+                }
+                else
+                {
+                    dataOut->writeUTF(value);
+                }
+            }
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename Out>
+    static void looseMarshalString(const std::string value,
+                                   Out*              dataOut)
+    {
+        try
+        {
+            dataOut->writeBoolean(value != "");
+            if (value != "")
+            {
+                dataOut->writeUTF(value);
+            }
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename In>
+    static std::string looseUnmarshalString(In* dataIn)
+    {
+        try
+        {
+            if (dataIn->readBoolean())
+            {
+                return dataIn->readUTF();
+            }
+            else
+            {
+                return "";
+            }
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename Out>
+    static void tightMarshalLong2(OpenWireFormat* wireFormat,
+                                  long long       value,
+                                  Out*            dataOut,
+                                  BooleanStream*  bs)
+    {
+        try
+        {
+            if (bs->readBoolean())
+            {
+                if (bs->readBoolean())
+                {
+                    dataOut->writeLong(value);
+                }
+                else
+                {
+                    dataOut->writeInt((int)value);
+                }
+            }
+            else
+            {
+                if (bs->readBoolean())
+                {
+                    dataOut->writeShort((short)value);
+                }
+            }
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename In>
+    static long long tightUnmarshalLong(OpenWireFormat* wireFormat,
+                                        In*             dataIn,
+                                        BooleanStream*  bs)
+    {
+        try
+        {
+            if (bs->readBoolean())
+            {
+                if (bs->readBoolean())
+                {
+                    return dataIn->readLong();
+                }
+                else
+                {
+                    return (unsigned int)dataIn->readInt();
+                }
+            }
+            else
+            {
+                if (bs->readBoolean())
+                {
+                    return dataIn->readUnsignedShort();
+                }
+                else
+                {
+                    return 0;
+                }
+            }
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename Out>
+    static void looseMarshalLong(OpenWireFormat* wireFormat,
+                                 long long       value,
+                                 Out*            dataOut)
+    {
+        try
+        {
+            dataOut->writeLong(value);
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename In>
+    static long long looseUnmarshalLong(OpenWireFormat* wireFormat,
+                                        In*             dataIn)
+    {
+        try
+        {
+            return dataIn->readLong();
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename In>
+    static DataStructure* tightUnmarshalBrokerError(
+        BaseDataStreamMarshaller* self,
+        OpenWireFormat*           wireFormat,
+        In*                       dataIn,
+        BooleanStream*            bs)
+    {
+        try
+        {
+            if (bs->readBoolean())
+            {
+                std::unique_ptr<BrokerError> answer(new BrokerError());
+
+                answer->setExceptionClass(
+                    self->tightUnmarshalString(dataIn, bs));
+                answer->setMessage(self->tightUnmarshalString(dataIn, bs));
+
+                if (wireFormat->isStackTraceEnabled())
+                {
+                    short length = dataIn->readShort();
+                    std::vector<std::shared_ptr<BrokerError::StackTraceElement>>
+                        stackTrace;
+
+                    for (int i = 0; i < length; ++i)
+                    {
+                        std::shared_ptr<BrokerError::StackTraceElement>
+                            element(new BrokerError::StackTraceElement);
+
+                        element->ClassName =
+                            self->tightUnmarshalString(dataIn, bs);
+                        element->MethodName =
+                            self->tightUnmarshalString(dataIn, bs);
+                        element->FileName =
+                            self->tightUnmarshalString(dataIn, bs);
+                        element->LineNumber = dataIn->readInt();
+                        stackTrace.push_back(element);
+                    }
+
+                    answer->setStackTraceElements(stackTrace);
+                    answer->setCause(std::shared_ptr<BrokerError>(
+                        dynamic_cast<BrokerError*>(
+                            self->tightUnmarshalBrokerError(wireFormat,
+                                                            dataIn,
+                                                            bs))));
+                }
+
+                return answer.release();
+            }
+            else
+            {
+                return NULL;
+            }
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename Out>
+    static void tightMarshalBrokerError2(BaseDataStreamMarshaller* self,
+                                         OpenWireFormat*           wireFormat,
+                                         DataStructure*            data,
+                                         Out*                      dataOut,
+                                         BooleanStream*            bs)
+    {
+        try
+        {
+            if (bs->readBoolean())
+            {
+                BrokerError* error = dynamic_cast<BrokerError*>(data);
+
+                self->tightMarshalString2(error->getExceptionClass(),
+                                          dataOut,
+                                          bs);
+                self->tightMarshalString2(error->getMessage(), dataOut, bs);
+
+                if (wireFormat->isStackTraceEnabled())
+                {
+                    int length = (short)error->getStackTraceElements().size();
+                    dataOut->writeShort((short)length);
+
+                    for (int i = 0; i < length; ++i)
+                    {
+                        std::shared_ptr<BrokerError::StackTraceElement>
+                            element = error->getStackTraceElements()[i];
+
+                        self->tightMarshalString2(element->ClassName,
+                                                  dataOut,
+                                                  bs);
+                        self->tightMarshalString2(element->MethodName,
+                                                  dataOut,
+                                                  bs);
+                        self->tightMarshalString2(element->FileName,
+                                                  dataOut,
+                                                  bs);
+                        dataOut->writeInt(element->LineNumber);
+                    }
+
+                    self->tightMarshalBrokerError2(wireFormat,
+                                                   error->getCause().get(),
+                                                   dataOut,
+                                                   bs);
+                }
+            }
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename In>
+    static DataStructure* looseUnmarshalBrokerError(
+        BaseDataStreamMarshaller* self,
+        OpenWireFormat*           wireFormat,
+        In*                       dataIn)
+    {
+        try
+        {
+            if (dataIn->readBoolean())
+            {
+                std::unique_ptr<BrokerError> answer(new BrokerError());
+
+                answer->setExceptionClass(self->looseUnmarshalString(dataIn));
+                answer->setMessage(self->looseUnmarshalString(dataIn));
+
+                if (wireFormat->isStackTraceEnabled())
+                {
+                    short length = dataIn->readShort();
+                    std::vector<std::shared_ptr<BrokerError::StackTraceElement>>
+                        stackTrace;
+
+                    for (int i = 0; i < length; ++i)
+                    {
+                        std::shared_ptr<BrokerError::StackTraceElement>
+                            element(new BrokerError::StackTraceElement);
+
+                        element->ClassName =
+                            self->looseUnmarshalString(dataIn);
+                        element->MethodName =
+                            self->looseUnmarshalString(dataIn);
+                        element->FileName =
+                            self->looseUnmarshalString(dataIn);
+                        element->LineNumber = dataIn->readInt();
+
+                        stackTrace.push_back(element);
+                    }
+                    answer->setStackTraceElements(stackTrace);
+                    answer->setCause(std::shared_ptr<BrokerError>(
+                        dynamic_cast<BrokerError*>(
+                            self->looseUnmarshalBrokerError(wireFormat,
+                                                            dataIn))));
+                }
+
+                return answer.release();
+            }
+            else
+            {
+                return NULL;
+            }
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename Out>
+    static void looseMarshalBrokerError(BaseDataStreamMarshaller* self,
+                                        OpenWireFormat*           wireFormat,
+                                        DataStructure*            data,
+                                        Out*                      dataOut)
+    {
+        try
+        {
+            BrokerError* error = dynamic_cast<BrokerError*>(data);
+
+            dataOut->write(error != NULL);
+
+            if (error != NULL)
+            {
+                self->looseMarshalString(error->getExceptionClass(), dataOut);
+                self->looseMarshalString(error->getMessage(), dataOut);
+
+                if (wireFormat->isStackTraceEnabled())
+                {
+                    size_t length = error->getStackTraceElements().size();
+
+                    dataOut->writeShort((short)length);
+
+                    for (size_t i = 0; i < length; ++i)
+                    {
+                        std::shared_ptr<BrokerError::StackTraceElement> element(
+                            error->getStackTraceElements()[i]);
+
+                        self->looseMarshalString(element->ClassName, dataOut);
+                        self->looseMarshalString(element->MethodName, dataOut);
+                        self->looseMarshalString(element->FileName, dataOut);
+
+                        dataOut->writeInt(element->LineNumber);
+                    }
+
+                    self->looseMarshalBrokerError(wireFormat,
+                                                  error->getCause().get(),
+                                                  dataOut);
+                }
+            }
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename In>
+    static std::vector<unsigned char> tightUnmarshalByteArray(
+        In*            dataIn,
+        BooleanStream* bs)
+    {
+        try
+        {
+            std::vector<unsigned char> data;
+            if (bs->readBoolean())
+            {
+                int size = dataIn->readInt();
+                if (size < 0)
+                {
+                    throw IOException(__FILE__,
+                                      __LINE__,
+                                      "Negative byte array size encountered.");
+                }
+                else if (size > 0)
+                {
+                    data.resize(size);
+                    dataIn->readFully(&data[0], (int)data.size());
+                }
+            }
+
+            return data;
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename In>
+    static std::vector<unsigned char> looseUnmarshalByteArray(In* dataIn)
+    {
+        try
+        {
+            if (dataIn->readBoolean())
+            {
+                int                        size = dataIn->readInt();
+                std::vector<unsigned char> data;
+                if (size < 0)
+                {
+                    throw IOException(__FILE__,
+                                      __LINE__,
+                                      "Negative byte array size encountered.");
+                }
+                else if (size > 0)
+                {
+                    data.resize(size);
+                    dataIn->readFully(&data[0], (int)data.size());
+                }
+                return data;
+            }
+
+            return std::vector<unsigned char>();
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename In>
+    static std::vector<unsigned char> tightUnmarshalConstByteArray(
+        In*            dataIn,
+        BooleanStream* bs,
+        int            size)
+    {
+        try
+        {
+            std::vector<unsigned char> data;
+            if (size > 0)
+            {
+                data.resize(size);
+                dataIn->readFully(&data[0], (int)data.size());
+            }
+            return data;
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename In>
+    static std::vector<unsigned char> looseUnmarshalConstByteArray(In* dataIn,
+                                                                   int size)
+    {
+        try
+        {
+            std::vector<unsigned char> data;
+            if (size > 0)
+            {
+                data.resize(size);
+                dataIn->readFully(&data[0], (int)data.size());
+            }
+            return data;
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+
+    template <typename In>
+    static std::string readAsciiString(In* dataIn)
+    {
+        try
+        {
+            // Written as a short but ascii strings can hold up to 65535 chars.
+            int size = dataIn->readUnsignedShort();
+
+            // The bytes are the characters, read them straight into place.
+            std::string text((std::size_t)size, '\0');
+            if (size > 0)
+            {
+                dataIn->readFully((unsigned char*)&text[0], size);
+            }
+
+            return text;
+        }
+        AMQ_CATCH_RETHROW(IOException)
+        AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+        AMQ_CATCHALL_THROW(IOException)
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<DataStructure>
+BaseDataStreamMarshaller::tightUnmarshalCachedObject(
+    OpenWireFormat*  wireFormat,
+    DataInputStream* dataIn,
+    BooleanStream*   bs)
+{
+    return Codec::tightUnmarshalCachedObject(wireFormat, dataIn, bs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<DataStructure>
+BaseDataStreamMarshaller::tightUnmarshalCachedObject(
+    OpenWireFormat* wireFormat,
+    ByteReader*     dataIn,
+    BooleanStream*  bs)
+{
+    return Codec::tightUnmarshalCachedObject(wireFormat, dataIn, bs);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -67,6 +866,21 @@ int BaseDataStreamMarshaller::tightMarshalCachedObject1(
 {
     try
     {
+        if (wireFormat->isMarshalCacheEnabled())
+        {
+            bool cached = wireFormat->getMarshalCacheIndex(data) != -1;
+            bs->writeBoolean(!cached);
+
+            if (!cached)
+            {
+                int rc = wireFormat->tightMarshalNestedObject1(data, bs);
+                wireFormat->addToMarshalCache(data);
+                return 2 + rc;
+            }
+
+            return 2;
+        }
+
         return wireFormat->tightMarshalNestedObject1(data, bs);
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -76,47 +890,58 @@ int BaseDataStreamMarshaller::tightMarshalCachedObject1(
 
 ////////////////////////////////////////////////////////////////////////////////
 void BaseDataStreamMarshaller::tightMarshalCachedObject2(
-    OpenWireFormat*              wireFormat,
-    commands::DataStructure*     data,
-    decaf::io::DataOutputStream* dataOut,
-    utils::BooleanStream*        bs)
+    OpenWireFormat*   wireFormat,
+    DataStructure*    data,
+    DataOutputStream* dataOut,
+    BooleanStream*    bs)
 {
-    try
-    {
-        wireFormat->tightMarshalNestedObject2(data, dataOut, bs);
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+    Codec::tightMarshalCachedObject2(wireFormat, data, dataOut, bs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::tightMarshalCachedObject2(
+    OpenWireFormat* wireFormat,
+    DataStructure*  data,
+    ByteWriter*     dataOut,
+    BooleanStream*  bs)
+{
+    Codec::tightMarshalCachedObject2(wireFormat, data, dataOut, bs);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void BaseDataStreamMarshaller::looseMarshalCachedObject(
-    OpenWireFormat*              wireFormat,
-    commands::DataStructure*     data,
-    decaf::io::DataOutputStream* dataOut)
+    OpenWireFormat*   wireFormat,
+    DataStructure*    data,
+    DataOutputStream* dataOut)
 {
-    try
-    {
-        wireFormat->looseMarshalNestedObject(data, dataOut);
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+    Codec::looseMarshalCachedObject(wireFormat, data, dataOut);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-commands::DataStructure* BaseDataStreamMarshaller::looseUnmarshalCachedObject(
-    OpenWireFormat*             wireFormat,
-    decaf::io::DataInputStream* dataIn)
+void BaseDataStreamMarshaller::looseMarshalCachedObject(
+    OpenWireFormat* wireFormat,
+    DataStructure*  data,
+    ByteWriter*     dataOut)
 {
-    try
-    {
-        return wireFormat->looseUnmarshalNestedObject(dataIn);
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+    Codec::looseMarshalCachedObject(wireFormat, data, dataOut);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<DataStructure>
+BaseDataStreamMarshaller::looseUnmarshalCachedObject(
+    OpenWireFormat*  wireFormat,
+    DataInputStream* dataIn)
+{
+    return Codec::looseUnmarshalCachedObject(wireFormat, dataIn);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<DataStructure>
+BaseDataStreamMarshaller::looseUnmarshalCachedObject(
+    OpenWireFormat* wireFormat,
+    ByteReader*     dataIn)
+{
+    return Codec::looseUnmarshalCachedObject(wireFormat, dataIn);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -136,90 +961,166 @@ int BaseDataStreamMarshaller::tightMarshalNestedObject1(
 
 ////////////////////////////////////////////////////////////////////////////////
 void BaseDataStreamMarshaller::tightMarshalNestedObject2(
-    OpenWireFormat*              wireFormat,
-    commands::DataStructure*     object,
-    decaf::io::DataOutputStream* dataOut,
-    utils::BooleanStream*        bs)
+    OpenWireFormat*   wireFormat,
+    DataStructure*    object,
+    DataOutputStream* dataOut,
+    BooleanStream*    bs)
 {
-    try
-    {
-        wireFormat->tightMarshalNestedObject2(object, dataOut, bs);
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+    Codec::tightMarshalNestedObject2(wireFormat, object, dataOut, bs);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-commands::DataStructure* BaseDataStreamMarshaller::tightUnmarshalNestedObject(
-    OpenWireFormat*             wireFormat,
-    decaf::io::DataInputStream* dataIn,
-    utils::BooleanStream*       bs)
+void BaseDataStreamMarshaller::tightMarshalNestedObject2(
+    OpenWireFormat* wireFormat,
+    DataStructure*  object,
+    ByteWriter*     dataOut,
+    BooleanStream*  bs)
 {
-    try
-    {
-        return wireFormat->tightUnmarshalNestedObject(dataIn, bs);
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+    Codec::tightMarshalNestedObject2(wireFormat, object, dataOut, bs);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-commands::DataStructure* BaseDataStreamMarshaller::looseUnmarshalNestedObject(
-    OpenWireFormat*             wireFormat,
-    decaf::io::DataInputStream* dataIn)
+DataStructure* BaseDataStreamMarshaller::tightUnmarshalNestedObject(
+    OpenWireFormat*  wireFormat,
+    DataInputStream* dataIn,
+    BooleanStream*   bs)
 {
-    try
-    {
-        return wireFormat->looseUnmarshalNestedObject(dataIn);
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+    return Codec::tightUnmarshalNestedObject(wireFormat, dataIn, bs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+DataStructure* BaseDataStreamMarshaller::tightUnmarshalNestedObject(
+    OpenWireFormat* wireFormat,
+    ByteReader*     dataIn,
+    BooleanStream*  bs)
+{
+    return Codec::tightUnmarshalNestedObject(wireFormat, dataIn, bs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+DataStructure* BaseDataStreamMarshaller::looseUnmarshalNestedObject(
+    OpenWireFormat*  wireFormat,
+    DataInputStream* dataIn)
+{
+    return Codec::looseUnmarshalNestedObject(wireFormat, dataIn);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+DataStructure* BaseDataStreamMarshaller::looseUnmarshalNestedObject(
+    OpenWireFormat* wireFormat,
+    ByteReader*     dataIn)
+{
+    return Codec::looseUnmarshalNestedObject(wireFormat, dataIn);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<DataStructure>
+BaseDataStreamMarshaller::tightUnmarshalInternedCachedObject(
+    OpenWireFormat*  wireFormat,
+    DataInputStream* dataIn,
+    BooleanStream*   bs)
+{
+    return Codec::tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<DataStructure>
+BaseDataStreamMarshaller::tightUnmarshalInternedCachedObject(
+    OpenWireFormat* wireFormat,
+    ByteReader*     dataIn,
+    BooleanStream*  bs)
+{
+    return Codec::tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<DataStructure>
+BaseDataStreamMarshaller::looseUnmarshalInternedCachedObject(
+    OpenWireFormat*  wireFormat,
+    DataInputStream* dataIn)
+{
+    return Codec::looseUnmarshalInternedCachedObject(wireFormat, dataIn);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<DataStructure>
+BaseDataStreamMarshaller::looseUnmarshalInternedCachedObject(
+    OpenWireFormat* wireFormat,
+    ByteReader*     dataIn)
+{
+    return Codec::looseUnmarshalInternedCachedObject(wireFormat, dataIn);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<DataStructure>
+BaseDataStreamMarshaller::tightUnmarshalInternedNestedObject(
+    OpenWireFormat*  wireFormat,
+    DataInputStream* dataIn,
+    BooleanStream*   bs)
+{
+    return Codec::tightUnmarshalInternedNestedObject(wireFormat, dataIn, bs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<DataStructure>
+BaseDataStreamMarshaller::tightUnmarshalInternedNestedObject(
+    OpenWireFormat* wireFormat,
+    ByteReader*     dataIn,
+    BooleanStream*  bs)
+{
+    return Codec::tightUnmarshalInternedNestedObject(wireFormat, dataIn, bs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<DataStructure>
+BaseDataStreamMarshaller::looseUnmarshalInternedNestedObject(
+    OpenWireFormat*  wireFormat,
+    DataInputStream* dataIn)
+{
+    return Codec::looseUnmarshalInternedNestedObject(wireFormat, dataIn);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<DataStructure>
+BaseDataStreamMarshaller::looseUnmarshalInternedNestedObject(
+    OpenWireFormat* wireFormat,
+    ByteReader*     dataIn)
+{
+    return Codec::looseUnmarshalInternedNestedObject(wireFormat, dataIn);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void BaseDataStreamMarshaller::looseMarshalNestedObject(
-    OpenWireFormat*              wireFormat,
-    commands::DataStructure*     object,
-    decaf::io::DataOutputStream* dataOut)
+    OpenWireFormat*   wireFormat,
+    DataStructure*    object,
+    DataOutputStream* dataOut)
 {
-    try
-    {
-        wireFormat->looseMarshalNestedObject(object, dataOut);
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+    Codec::looseMarshalNestedObject(wireFormat, object, dataOut);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::looseMarshalNestedObject(
+    OpenWireFormat* wireFormat,
+    DataStructure*  object,
+    ByteWriter*     dataOut)
+{
+    Codec::looseMarshalNestedObject(wireFormat, object, dataOut);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 std::string BaseDataStreamMarshaller::tightUnmarshalString(
-    decaf::io::DataInputStream* dataIn,
-    utils::BooleanStream*       bs)
+    DataInputStream* dataIn,
+    BooleanStream*   bs)
 {
-    try
-    {
-        if (bs->readBoolean())
-        {
-            if (bs->readBoolean())
-            {
-                return this->readAsciiString(dataIn);
-            }
-            else
-            {
-                return dataIn->readUTF();
-            }
-        }
-        else
-        {
-            return "";
-        }
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+    return Codec::tightUnmarshalString(this, dataIn, bs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string BaseDataStreamMarshaller::tightUnmarshalString(
+    ByteReader*    dataIn,
+    BooleanStream* bs)
+{
+    return Codec::tightUnmarshalString(this, dataIn, bs);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -231,30 +1132,13 @@ int BaseDataStreamMarshaller::tightMarshalString1(const std::string&    value,
         bs->writeBoolean(value != "");
         if (value != "")
         {
-            size_t strlen = value.length();
+            std::size_t strlen = value.length();
 
-            int  utflen      = 0;
-            int  c           = 0;
-            bool isOnlyAscii = true;
-
-            for (size_t i = 0; i < strlen; ++i)
-            {
-                c = value[i];
-                if ((c >= 0x0001) && (c <= 0x007F))
-                {  // ASCII char
-                    utflen++;
-                }
-                else if (c > 0x07FF)
-                {
-                    utflen += 3;
-                    isOnlyAscii = false;
-                }
-                else
-                {
-                    isOnlyAscii = false;
-                    utflen += 2;
-                }
-            }
+            // Each char is written as one code unit, see writeUTF, so the
+            // string is only ASCII when none of them took two bytes.
+            std::size_t utflen =
+                ModifiedUTF8::encodedLength(value.c_str(), strlen);
+            bool isOnlyAscii = utflen == strlen;
 
             if (utflen >= 0x10000)
             {
@@ -267,7 +1151,7 @@ int BaseDataStreamMarshaller::tightMarshalString1(const std::string&    value,
 
             bs->writeBoolean(isOnlyAscii);
 
-            return utflen + 2;
+            return (int)utflen + 2;
         }
         else
         {
@@ -280,68 +1164,46 @@ int BaseDataStreamMarshaller::tightMarshalString1(const std::string&    value,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void BaseDataStreamMarshaller::tightMarshalString2(
-    const std::string&           value,
-    decaf::io::DataOutputStream* dataOut,
-    utils::BooleanStream*        bs)
+void BaseDataStreamMarshaller::tightMarshalString2(const std::string& value,
+                                                   DataOutputStream*  dataOut,
+                                                   BooleanStream*     bs)
 {
-    try
-    {
-        if (bs->readBoolean())
-        {
-            // If we verified it only holds ascii values
-            if (bs->readBoolean())
-            {
-                dataOut->writeShort((short)value.length());
-                dataOut->writeBytes(value);
-            }
-            else
-            {
-                dataOut->writeUTF(value);
-            }
-        }
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+    Codec::tightMarshalString2(value, dataOut, bs);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void BaseDataStreamMarshaller::looseMarshalString(
-    const std::string            value,
-    decaf::io::DataOutputStream* dataOut)
+void BaseDataStreamMarshaller::tightMarshalString2(const std::string& value,
+                                                   ByteWriter*        dataOut,
+                                                   BooleanStream*     bs)
 {
-    try
-    {
-        dataOut->writeBoolean(value != "");
-        if (value != "")
-        {
-            dataOut->writeUTF(value);
-        }
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+    Codec::tightMarshalString2(value, dataOut, bs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::looseMarshalString(const std::string value,
+                                                  DataOutputStream* dataOut)
+{
+    Codec::looseMarshalString(value, dataOut);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::looseMarshalString(const std::string value,
+                                                  ByteWriter*       dataOut)
+{
+    Codec::looseMarshalString(value, dataOut);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 std::string BaseDataStreamMarshaller::looseUnmarshalString(
-    decaf::io::DataInputStream* dataIn)
+    DataInputStream* dataIn)
 {
-    try
-    {
-        if (dataIn->readBoolean())
-        {
-            return dataIn->readUTF();
-        }
-        else
-        {
-            return "";
-        }
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+    return Codec::looseUnmarshalString(dataIn);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string BaseDataStreamMarshaller::looseUnmarshalString(ByteReader* dataIn)
+{
+    return Codec::looseUnmarshalString(dataIn);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -387,152 +1249,89 @@ int BaseDataStreamMarshaller::tightMarshalLong1(OpenWireFormat* wireFormat
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void BaseDataStreamMarshaller::tightMarshalLong2(
-    OpenWireFormat* wireFormat   AMQCPP_UNUSED,
-    long long                    value,
-    decaf::io::DataOutputStream* dataOut,
-    utils::BooleanStream*        bs)
+void BaseDataStreamMarshaller::tightMarshalLong2(OpenWireFormat*   wireFormat,
+                                                 long long         value,
+                                                 DataOutputStream* dataOut,
+                                                 BooleanStream*    bs)
 {
-    try
-    {
-        if (bs->readBoolean())
-        {
-            if (bs->readBoolean())
-            {
-                dataOut->writeLong(value);
-            }
-            else
-            {
-                dataOut->writeInt((int)value);
-            }
-        }
-        else
-        {
-            if (bs->readBoolean())
-            {
-                dataOut->writeShort((short)value);
-            }
-        }
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+    Codec::tightMarshalLong2(wireFormat, value, dataOut, bs);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-long long BaseDataStreamMarshaller::tightUnmarshalLong(
-    OpenWireFormat* wireFormat  AMQCPP_UNUSED,
-    decaf::io::DataInputStream* dataIn,
-    utils::BooleanStream*       bs)
+void BaseDataStreamMarshaller::tightMarshalLong2(OpenWireFormat* wireFormat,
+                                                 long long       value,
+                                                 ByteWriter*     dataOut,
+                                                 BooleanStream*  bs)
 {
-    try
-    {
-        if (bs->readBoolean())
-        {
-            if (bs->readBoolean())
-            {
-                return dataIn->readLong();
-            }
-            else
-            {
-                return (unsigned int)dataIn->readInt();
-            }
-        }
-        else
-        {
-            if (bs->readBoolean())
-            {
-                return dataIn->readUnsignedShort();
-            }
-            else
-            {
-                return 0;
-            }
-        }
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+    Codec::tightMarshalLong2(wireFormat, value, dataOut, bs);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void BaseDataStreamMarshaller::looseMarshalLong(
-    OpenWireFormat* wireFormat   AMQCPP_UNUSED,
-    long long                    value,
-    decaf::io::DataOutputStream* dataOut)
+long long BaseDataStreamMarshaller::tightUnmarshalLong(
+    OpenWireFormat*  wireFormat,
+    DataInputStream* dataIn,
+    BooleanStream*   bs)
 {
-    try
-    {
-        dataOut->writeLong(value);
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+    return Codec::tightUnmarshalLong(wireFormat, dataIn, bs);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-long long BaseDataStreamMarshaller::looseUnmarshalLong(
-    OpenWireFormat* wireFormat  AMQCPP_UNUSED,
-    decaf::io::DataInputStream* dataIn)
+long long BaseDataStreamMarshaller::tightUnmarshalLong(
+    OpenWireFormat* wireFormat,
+    ByteReader*     dataIn,
+    BooleanStream*  bs)
 {
-    try
-    {
-        return dataIn->readLong();
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+    return Codec::tightUnmarshalLong(wireFormat, dataIn, bs);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-commands::DataStructure* BaseDataStreamMarshaller::tightUnmarshalBrokerError(
-    OpenWireFormat*             wireFormat,
-    decaf::io::DataInputStream* dataIn,
-    utils::BooleanStream*       bs)
+void BaseDataStreamMarshaller::looseMarshalLong(OpenWireFormat*   wireFormat,
+                                                long long         value,
+                                                DataOutputStream* dataOut)
 {
-    try
-    {
-        if (bs->readBoolean())
-        {
-            std::unique_ptr<BrokerError> answer(new BrokerError());
+    Codec::looseMarshalLong(wireFormat, value, dataOut);
+}
 
-            answer->setExceptionClass(tightUnmarshalString(dataIn, bs));
-            answer->setMessage(tightUnmarshalString(dataIn, bs));
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::looseMarshalLong(OpenWireFormat* wireFormat,
+                                                long long       value,
+                                                ByteWriter*     dataOut)
+{
+    Codec::looseMarshalLong(wireFormat, value, dataOut);
+}
 
-            if (wireFormat->isStackTraceEnabled())
-            {
-                short length = dataIn->readShort();
-                std::vector<std::shared_ptr<BrokerError::StackTraceElement>>
-                    stackTrace;
+////////////////////////////////////////////////////////////////////////////////
+long long BaseDataStreamMarshaller::looseUnmarshalLong(
+    OpenWireFormat*  wireFormat,
+    DataInputStream* dataIn)
+{
+    return Codec::looseUnmarshalLong(wireFormat, dataIn);
+}
 
-                for (int i = 0; i < length; ++i)
-                {
-                    std::shared_ptr<BrokerError::StackTraceElement> element(
-                        new BrokerError::StackTraceElement);
-
-                    element->ClassName  = tightUnmarshalString(dataIn, bs);
-                    element->MethodName = tightUnmarshalString(dataIn, bs);
-                    element->FileName   = tightUnmarshalString(dataIn, bs);
-                    element->LineNumber = dataIn->readInt();
-                    stackTrace.push_back(element);
-                }
+////////////////////////////////////////////////////////////////////////////////
+long long BaseDataStreamMarshaller::looseUnmarshalLong(
+    OpenWireFormat* wireFormat,
+    ByteReader*     dataIn)
+{
+    return Codec::looseUnmarshalLong(wireFormat, dataIn);
+}
 
-                answer->setStackTraceElements(stackTrace);
-                answer->setCause(
-                    std::shared_ptr<BrokerError>(dynamic_cast<BrokerError*>(
-                        tightUnmarshalBrokerError(wireFormat, dataIn, bs))));
-            }
+////////////////////////////////////////////////////////////////////////////////
+DataStructure* BaseDataStreamMarshaller::tightUnmarshalBrokerError(
+    OpenWireFormat*  wireFormat,
+    DataInputStream* dataIn,
+    BooleanStream*   bs)
+{
+    return Codec::tightUnmarshalBrokerError(this, wireFormat, dataIn, bs);
+}
 
-            return answer.release();
-        }
-        else
-        {
-            return NULL;
-        }
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+////////////////////////////////////////////////////////////////////////////////
+DataStructure* BaseDataStreamMarshaller::tightUnmarshalBrokerError(
+    OpenWireFormat* wireFormat,
+    ByteReader*     dataIn,
+    BooleanStream*  bs)
+{
+    return Codec::tightUnmarshalBrokerError(this, wireFormat, dataIn, bs);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -587,235 +1386,124 @@ int BaseDataStreamMarshaller::tightMarshalBrokerError1(
 
 ////////////////////////////////////////////////////////////////////////////////
 void BaseDataStreamMarshaller::tightMarshalBrokerError2(
-    OpenWireFormat*              wireFormat,
-    commands::DataStructure*     data,
-    decaf::io::DataOutputStream* dataOut,
-    utils::BooleanStream*        bs)
+    OpenWireFormat*   wireFormat,
+    DataStructure*    data,
+    DataOutputStream* dataOut,
+    BooleanStream*    bs)
 {
-    try
-    {
-        if (bs->readBoolean())
-        {
-            BrokerError* error = dynamic_cast<BrokerError*>(data);
-
-            tightMarshalString2(error->getExceptionClass(), dataOut, bs);
-            tightMarshalString2(error->getMessage(), dataOut, bs);
-
-            if (wireFormat->isStackTraceEnabled())
-            {
-                int length = (short)error->getStackTraceElements().size();
-                dataOut->writeShort((short)length);
-
-                for (int i = 0; i < length; ++i)
-                {
-                    std::shared_ptr<BrokerError::StackTraceElement> element =
-                        error->getStackTraceElements()[i];
-
-                    tightMarshalString2(element->ClassName, dataOut, bs);
-                    tightMarshalString2(element->MethodName, dataOut, bs);
-                    tightMarshalString2(element->FileName, dataOut, bs);
-                    dataOut->writeInt(element->LineNumber);
-                }
-
-                tightMarshalBrokerError2(wireFormat,
-                                         error->getCause().get(),
-                                         dataOut,
-                                         bs);
-            }
-        }
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+    Codec::tightMarshalBrokerError2(this, wireFormat, data, dataOut, bs);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-commands::DataStructure* BaseDataStreamMarshaller::looseUnmarshalBrokerError(
-    OpenWireFormat*             wireFormat,
-    decaf::io::DataInputStream* dataIn)
+void BaseDataStreamMarshaller::tightMarshalBrokerError2(
+    OpenWireFormat* wireFormat,
+    DataStructure*  data,
+    ByteWriter*     dataOut,
+    BooleanStream*  bs)
 {
-    try
-    {
-        if (dataIn->readBoolean())
-        {
-            std::unique_ptr<BrokerError> answer(new BrokerError());
-
-            answer->setExceptionClass(looseUnmarshalString(dataIn));
-            answer->setMessage(looseUnmarshalString(dataIn));
-
-            if (wireFormat->isStackTraceEnabled())
-            {
-                short length = dataIn->readShort();
-                std::vector<std::shared_ptr<BrokerError::StackTraceElement>>
-                    stackTrace;
-
-                for (int i = 0; i < length; ++i)
-                {
-                    std::shared_ptr<BrokerError::StackTraceElement> element(
-                        new BrokerError::StackTraceElement);
-
-                    element->ClassName  = looseUnmarshalString(dataIn);
-                    element->MethodName = looseUnmarshalString(dataIn);
-                    element->FileName   = looseUnmarshalString(dataIn);
-                    element->LineNumber = dataIn->readInt();
+    Codec::tightMarshalBrokerError2(this, wireFormat, data, dataOut, bs);
+}
 
-                    stackTrace.push_back(element);
-                }
-                answer->setStackTraceElements(stackTrace);
-                answer->setCause(
-                    std::shared_ptr<BrokerError>(dynamic_cast<BrokerError*>(
-                        looseUnmarshalBrokerError(wireFormat, dataIn))));
-            }
+////////////////////////////////////////////////////////////////////////////////
+DataStructure* BaseDataStreamMarshaller::looseUnmarshalBrokerError(
+    OpenWireFormat*  wireFormat,
+    DataInputStream* dataIn)
+{
+    return Codec::looseUnmarshalBrokerError(this, wireFormat, dataIn);
+}
 
-            return answer.release();
-        }
-        else
-        {
-            return NULL;
-        }
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+////////////////////////////////////////////////////////////////////////////////
+DataStructure* BaseDataStreamMarshaller::looseUnmarshalBrokerError(
+    OpenWireFormat* wireFormat,
+    ByteReader*     dataIn)
+{
+    return Codec::looseUnmarshalBrokerError(this, wireFormat, dataIn);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void BaseDataStreamMarshaller::looseMarshalBrokerError(
-    OpenWireFormat*              wireFormat,
-    commands::DataStructure*     data,
-    decaf::io::DataOutputStream* dataOut)
+    OpenWireFormat*   wireFormat,
+    DataStructure*    data,
+    DataOutputStream* dataOut)
 {
-    try
-    {
-        BrokerError* error = dynamic_cast<BrokerError*>(data);
-
-        dataOut->write(error != NULL);
-
-        if (error != NULL)
-        {
-            looseMarshalString(error->getExceptionClass(), dataOut);
-            looseMarshalString(error->getMessage(), dataOut);
-
-            if (wireFormat->isStackTraceEnabled())
-            {
-                size_t length = error->getStackTraceElements().size();
-
-                dataOut->writeShort((short)length);
-
-                for (size_t i = 0; i < length; ++i)
-                {
-                    std::shared_ptr<BrokerError::StackTraceElement> element(
-                        error->getStackTraceElements()[i]);
-
-                    looseMarshalString(element->ClassName, dataOut);
-                    looseMarshalString(element->MethodName, dataOut);
-                    looseMarshalString(element->FileName, dataOut);
+    Codec::looseMarshalBrokerError(this, wireFormat, data, dataOut);
+}
 
-                    dataOut->writeInt(element->LineNumber);
-                }
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::looseMarshalBrokerError(
+    OpenWireFormat* wireFormat,
+    DataStructure*  data,
+    ByteWriter*     dataOut)
+{
+    Codec::looseMarshalBrokerError(this, wireFormat, data, dataOut);
+}
 
-                looseMarshalBrokerError(wireFormat,
-                                        error->getCause().get(),
-                                        dataOut);
-            }
-        }
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+////////////////////////////////////////////////////////////////////////////////
+std::vector<unsigned char> BaseDataStreamMarshaller::tightUnmarshalByteArray(
+    DataInputStream* dataIn,
+    BooleanStream*   bs)
+{
+    return Codec::tightUnmarshalByteArray(dataIn, bs);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 std::vector<unsigned char> BaseDataStreamMarshaller::tightUnmarshalByteArray(
-    decaf::io::DataInputStream* dataIn,
-    utils::BooleanStream*       bs)
+    ByteReader*    dataIn,
+    BooleanStream* bs)
 {
-    try
-    {
-        std::vector<unsigned char> data;
-        if (bs->readBoolean())
-        {
-            int size = dataIn->readInt();
-            if (size > 0)
-            {
-                data.resize(size);
-                dataIn->readFully(&data[0], (int)data.size());
-            }
-        }
+    return Codec::tightUnmarshalByteArray(dataIn, bs);
+}
 
-        return data;
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+////////////////////////////////////////////////////////////////////////////////
+std::vector<unsigned char> BaseDataStreamMarshaller::looseUnmarshalByteArray(
+    DataInputStream* dataIn)
+{
+    return Codec::looseUnmarshalByteArray(dataIn);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 std::vector<unsigned char> BaseDataStreamMarshaller::looseUnmarshalByteArray(
-    decaf::io::DataInputStream* dataIn)
+    ByteReader* dataIn)
 {
-    try
-    {
-        if (dataIn->readBoolean())
-        {
-            int                        size = dataIn->readInt();
-            std::vector<unsigned char> data;
-            if (size > 0)
-            {
-                data.resize(size);
-                dataIn->readFully(&data[0], (int)data.size());
-            }
-            return data;
-        }
+    return Codec::looseUnmarshalByteArray(dataIn);
+}
 
-        return std::vector<unsigned char>();
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+////////////////////////////////////////////////////////////////////////////////
+std::vector<unsigned char>
+BaseDataStreamMarshaller::tightUnmarshalConstByteArray(
+    DataInputStream* dataIn,
+    BooleanStream*   bs,
+    int              size)
+{
+    return Codec::tightUnmarshalConstByteArray(dataIn, bs, size);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 std::vector<unsigned char>
 BaseDataStreamMarshaller::tightUnmarshalConstByteArray(
-    decaf::io::DataInputStream* dataIn,
-    utils::BooleanStream* bs    AMQCPP_UNUSED,
-    int                         size)
+    ByteReader*    dataIn,
+    BooleanStream* bs,
+    int            size)
 {
-    try
-    {
-        std::vector<unsigned char> data;
-        if (size > 0)
-        {
-            data.resize(size);
-            dataIn->readFully(&data[0], (int)data.size());
-        }
-        return data;
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+    return Codec::tightUnmarshalConstByteArray(dataIn, bs, size);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 std::vector<unsigned char>
 BaseDataStreamMarshaller::looseUnmarshalConstByteArray(
-    decaf::io::DataInputStream* dataIn,
-    int                         size)
+    DataInputStream* dataIn,
+    int              size)
 {
-    try
-    {
-        std::vector<unsigned char> data;
-        if (size > 0)
-        {
-            data.resize(size);
-            dataIn->readFully(&data[0], (int)data.size());
-        }
-        return data;
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+    return Codec::looseUnmarshalConstByteArray(dataIn, size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<unsigned char>
+BaseDataStreamMarshaller::looseUnmarshalConstByteArray(
+    ByteReader* dataIn,
+    int         size)
+{
+    return Codec::looseUnmarshalConstByteArray(dataIn, size);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -875,26 +1563,14 @@ std::string BaseDataStreamMarshaller::toHexFromBytes(
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-std::string BaseDataStreamMarshaller::readAsciiString(
-    decaf::io::DataInputStream* dataIn)
+std::string BaseDataStreamMarshaller::readAsciiString(DataInputStream* dataIn)
 {
-    try
-    {
-        std::string text;
-        int         size = dataIn->readShort();
-
-        if (size > 0)
-        {
-            std::vector<char> data(size);
-            dataIn->readFully((unsigned char*)&data[0], size);
-
-            // Now build a string and copy data into it.
-            text.insert(text.begin(), data.begin(), data.end());
-        }
+    return Codec::readAsciiString(dataIn);
+}
 
-        return text;
-    }
-    AMQ_CATCH_RETHROW(IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
-    AMQ_CATCHALL_THROW(IOException)
+////////////////////////////////////////////////////////////////////////////////
+std::string BaseDataStreamMarshaller::readAsciiString(ByteReader* dataIn)
+{
+    return Codec::readAsciiString(dataIn);
 }
+
@@ -127,6 +127,39 @@ namespace wireformat
                 {
                 }
 
+                // Span based forms of the above, the generated marshallers
+                // chain up to these in the same way.
+
+                virtual void tightMarshal2(
+                    OpenWireFormat* format           AMQCPP_UNUSED,
+                    commands::DataStructure* command AMQCPP_UNUSED,
+                    utils::ByteWriter* out           AMQCPP_UNUSED,
+                    utils::BooleanStream* bs         AMQCPP_UNUSED)
+                {
+                }
+
+                virtual void tightUnmarshal(
+                    OpenWireFormat* format           AMQCPP_UNUSED,
+                    commands::DataStructure* command AMQCPP_UNUSED,
+                    utils::ByteReader* in            AMQCPP_UNUSED,
+                    utils::BooleanStream* bs         AMQCPP_UNUSED)
+                {
+                }
+
+                virtual void looseMarshal(
+                    OpenWireFormat* format           AMQCPP_UNUSED,
+                    commands::DataStructure* command AMQCPP_UNUSED,
+                    utils::ByteWriter* out           AMQCPP_UNUSED)
+                {
+                }
+
+                virtual void looseUnmarshal(
+                    OpenWireFormat* format           AMQCPP_UNUSED,
+                    commands::DataStructure* command AMQCPP_UNUSED,
+                    utils::ByteReader* in            AMQCPP_UNUSED)
+                {
+                }
+
             public:
                 // Statics
 
@@ -167,14 +200,22 @@ namespace wireformat
                  * @param wireFormat - The OpenwireFormat properties
                  * @param dataIn - stream to read marshaled form from
                  * @param bs - boolean stream to marshal to.
-                 * @return pointer to a new DataStructure Object
+                 * @return the unmarshaled object, shared with the cache when
+                 * the peer cached it so it must not be modified.
                  * @throws IOException if an error occurs.
                  */
-                virtual commands::DataStructure* tightUnmarshalCachedObject(
+                virtual std::shared_ptr<commands::DataStructure>
+                tightUnmarshalCachedObject(
                     OpenWireFormat*             wireFormat,
                     decaf::io::DataInputStream* dataIn,
                     utils::BooleanStream*       bs);
 
+                virtual std::shared_ptr<commands::DataStructure>
+                tightUnmarshalCachedObject(
+                    OpenWireFormat*       wireFormat,
+                    utils::ByteReader*    dataIn,
+                    utils::BooleanStream* bs);
+
                 /**
                  * Tightly marshals the passed DataStructure based object to the
                  * passed BooleanStream returning the size of the data marshaled
@@ -204,6 +245,12 @@ namespace wireformat
                     decaf::io::DataOutputStream* dataOut,
                     utils::BooleanStream*        bs);
 
+                virtual void tightMarshalCachedObject2(
+                    OpenWireFormat*          wireFormat,
+                    commands::DataStructure* data,
+                    utils::ByteWriter*       dataOut,
+                    utils::BooleanStream*    bs);
+
                 /**
                  * Loosely marshals the passed DataStructure based object to the
                  * passed stream returning nothing
@@ -217,17 +264,29 @@ namespace wireformat
                     commands::DataStructure*     data,
                     decaf::io::DataOutputStream* dataOut);
 
+                virtual void looseMarshalCachedObject(
+                    OpenWireFormat*          wireFormat,
+                    commands::DataStructure* data,
+                    utils::ByteWriter*       dataOut);
+
                 /**
                  * Loose Unmarshal the cached object
                  * @param wireFormat - The OpenwireFormat properties
                  * @param dataIn - stream to read marshaled form from
-                 * @return pointer to a new DataStructure Object
+                 * @return the unmarshaled object, shared with the cache when
+                 * the peer cached it so it must not be modified.
                  * @throws IOException if an error occurs.
                  */
-                virtual commands::DataStructure* looseUnmarshalCachedObject(
+                virtual std::shared_ptr<commands::DataStructure>
+                looseUnmarshalCachedObject(
                     OpenWireFormat*             wireFormat,
                     decaf::io::DataInputStream* dataIn);
 
+                virtual std::shared_ptr<commands::DataStructure>
+                looseUnmarshalCachedObject(
+                    OpenWireFormat*    wireFormat,
+                    utils::ByteReader* dataIn);
+
                 /**
                  * Tightly marshals the passed DataStructure based object to the
                  * passed BooleanStream returning the size of the data marshaled
@@ -257,6 +316,12 @@ namespace wireformat
                     decaf::io::DataOutputStream* dataOut,
                     utils::BooleanStream*        bs);
 
+                virtual void tightMarshalNestedObject2(
+                    OpenWireFormat*          wireFormat,
+                    commands::DataStructure* object,
+                    utils::ByteWriter*       dataOut,
+                    utils::BooleanStream*    bs);
+
                 /**
                  * Tight Unmarshal the nested object
                  * @param wireFormat - The OpenwireFormat properties
@@ -270,6 +335,11 @@ namespace wireformat
                     decaf::io::DataInputStream* dataIn,
                     utils::BooleanStream*       bs);
 
+                virtual commands::DataStructure* tightUnmarshalNestedObject(
+                    OpenWireFormat*       wireFormat,
+                    utils::ByteReader*    dataIn,
+                    utils::BooleanStream* bs);
+
                 /**
                  * Loose Unmarshal the nested object
                  * @param wireFormat - The OpenwireFormat properties
@@ -281,6 +351,93 @@ namespace wireformat
                     OpenWireFormat*             wireFormat,
                     decaf::io::DataInputStream* dataIn);
 
+                virtual commands::DataStructure* looseUnmarshalNestedObject(
+                    OpenWireFormat*    wireFormat,
+                    utils::ByteReader* dataIn);
+
+                /**
+                 * Tight unmarshal a cached object that is a ProducerId,
+                 * ConsumerId or destination.  The instance is taken from the
+                 * wire format's intern table and may be shared with other
+                 * commands, so it must not be modified.
+                 * @param wireFormat - The OpenwireFormat properties
+                 * @param dataIn - stream to read marshaled form from
+                 * @param bs - boolean stream to marshal to.
+                 * @return the shared DataStructure Object
+                 * @throws IOException if an error occurs.
+                 */
+                virtual std::shared_ptr<commands::DataStructure>
+                tightUnmarshalInternedCachedObject(
+                    OpenWireFormat*             wireFormat,
+                    decaf::io::DataInputStream* dataIn,
+                    utils::BooleanStream*       bs);
+
+                virtual std::shared_ptr<commands::DataStructure>
+                tightUnmarshalInternedCachedObject(
+                    OpenWireFormat*       wireFormat,
+                    utils::ByteReader*    dataIn,
+                    utils::BooleanStream* bs);
+
+                /**
+                 * Loose unmarshal a cached object that is a ProducerId,
+                 * ConsumerId or destination, see
+                 * tightUnmarshalInternedCachedObject.
+                 * @param wireFormat - The OpenwireFormat properties
+                 * @param dataIn - stream to read marshaled form from
+                 * @return the shared DataStructure Object
+                 * @throws IOException if an error occurs.
+                 */
+                virtual std::shared_ptr<commands::DataStructure>
+                looseUnmarshalInternedCachedObject(
+                    OpenWireFormat*             wireFormat,
+                    decaf::io::DataInputStream* dataIn);
+
+                virtual std::shared_ptr<commands::DataStructure>
+                looseUnmarshalInternedCachedObject(
+                    OpenWireFormat*    wireFormat,
+                    utils::ByteReader* dataIn);
+
+                /**
+                 * Tight unmarshal a nested object that is a ProducerId,
+                 * ConsumerId or destination, see
+                 * tightUnmarshalInternedCachedObject.
+                 * @param wireFormat - The OpenwireFormat properties
+                 * @param dataIn - stream to read marshaled form from
+                 * @param bs - boolean stream to marshal to.
+                 * @return the shared DataStructure Object
+                 * @throws IOException if an error occurs.
+                 */
+                virtual std::shared_ptr<commands::DataStructure>
+                tightUnmarshalInternedNestedObject(
+                    OpenWireFormat*             wireFormat,
+                    decaf::io::DataInputStream* dataIn,
+                    utils::BooleanStream*       bs);
+
+                virtual std::shared_ptr<commands::DataStructure>
+                tightUnmarshalInternedNestedObject(
+                    OpenWireFormat*       wireFormat,
+                    utils::ByteReader*    dataIn,
+                    utils::BooleanStream* bs);
+
+                /**
+                 * Loose unmarshal a nested object that is a ProducerId,
+                 * ConsumerId or destination, see
+                 * tightUnmarshalInternedCachedObject.
+                 * @param wireFormat - The OpenwireFormat properties
+                 * @param dataIn - stream to read marshaled form from
+                 * @return the shared DataStructure Object
+                 * @throws IOException if an error occurs.
+                 */
+                virtual std::shared_ptr<commands::DataStructure>
+                looseUnmarshalInternedNestedObject(
+                    OpenWireFormat*             wireFormat,
+                    decaf::io::DataInputStream* dataIn);
+
+                virtual std::shared_ptr<commands::DataStructure>
+                looseUnmarshalInternedNestedObject(
+                    OpenWireFormat*    wireFormat,
+                    utils::ByteReader* dataIn);
+
                 /**
                  * Loose marshall the nested object
                  * @param wireFormat - The OpenwireFormat properties
@@ -293,6 +450,11 @@ namespace wireformat
                     commands::DataStructure*     object,
                     decaf::io::DataOutputStream* dataOut);
 
+                virtual void looseMarshalNestedObject(
+                    OpenWireFormat*          wireFormat,
+                    commands::DataStructure* object,
+                    utils::ByteWriter*       dataOut);
+
                 /**
                  * Performs Tight Unmarshaling of String Objects
                  * @param dataIn - the DataInputStream to Un-Marshal from
@@ -304,6 +466,10 @@ namespace wireformat
                     decaf::io::DataInputStream* dataIn,
                     utils::BooleanStream*       bs);
 
+                virtual std::string tightUnmarshalString(
+                    utils::ByteReader*    dataIn,
+                    utils::BooleanStream* bs);
+
                 /**
                  * Tight Marshals the String to a Booleans Stream Object,
                  * returns the marshaled size.
@@ -327,6 +493,11 @@ namespace wireformat
                     decaf::io::DataOutputStream* dataOut,
                     utils::BooleanStream*        bs);
 
+                virtual void tightMarshalString2(
+                    const std::string&    value,
+                    utils::ByteWriter*    dataOut,
+                    utils::BooleanStream* bs);
+
                 /**
                  * Loose Marshal the String to the DataOuputStream passed
                  * @param value - string to marshal
@@ -337,6 +508,10 @@ namespace wireformat
                     const std::string            value,
                     decaf::io::DataOutputStream* dataOut);
 
+                virtual void looseMarshalString(
+                    const std::string  value,
+                    utils::ByteWriter* dataOut);
+
                 /**
                  * Loose Un-Marshal the String to the DataOuputStream passed
                  * @param dataIn - stream to read marshaled form from
@@ -346,6 +521,9 @@ namespace wireformat
                 virtual std::string looseUnmarshalString(
                     decaf::io::DataInputStream* dataIn);
 
+                virtual std::string looseUnmarshalString(
+                    utils::ByteReader* dataIn);
+
                 /**
                  * Tightly marshal the long long to the BooleanStream passed.
                  * @param wireFormat - The OpenwireFormat properties
@@ -372,6 +550,12 @@ namespace wireformat
                     decaf::io::DataOutputStream* dataOut,
                     utils::BooleanStream*        bs);
 
+                virtual void tightMarshalLong2(
+                    OpenWireFormat*       wireFormat,
+                    long long             value,
+                    utils::ByteWriter*    dataOut,
+                    utils::BooleanStream* bs);
+
                 /**
                  * Tight marshal the long long type.
                  * @param wireFormat - The OpenwireFormat properties
@@ -385,6 +569,11 @@ namespace wireformat
                     decaf::io::DataInputStream* dataIn,
                     utils::BooleanStream*       bs);
 
+                virtual long long tightUnmarshalLong(
+                    OpenWireFormat*       wireFormat,
+                    utils::ByteReader*    dataIn,
+                    utils::BooleanStream* bs);
+
                 /**
                  * Tightly marshal the long long to the BooleanStream passed.
                  * @param wireFormat - The OpenwireFormat properties
@@ -397,6 +586,11 @@ namespace wireformat
                     long long                    value,
                     decaf::io::DataOutputStream* dataOut);
 
+                virtual void looseMarshalLong(
+                    OpenWireFormat*    wireFormat,
+                    long long          value,
+                    utils::ByteWriter* dataOut);
+
                 /**
                  * Loose marshal the long long type.
                  * @param wireFormat - The OpenwireFormat properties
@@ -408,6 +602,10 @@ namespace wireformat
                     OpenWireFormat*             wireFormat,
                     decaf::io::DataInputStream* dataIn);
 
+                virtual long long looseUnmarshalLong(
+                    OpenWireFormat*    wireFormat,
+                    utils::ByteReader* dataIn);
+
                 /**
                  * Tight Unmarshal an array of char
                  * @param dataIn - the DataInputStream to Un-Marshal from
@@ -419,6 +617,10 @@ namespace wireformat
                     decaf::io::DataInputStream* dataIn,
                     utils::BooleanStream*       bs);
 
+                virtual std::vector<unsigned char> tightUnmarshalByteArray(
+                    utils::ByteReader*    dataIn,
+                    utils::BooleanStream* bs);
+
                 /**
                  * Loose Unmarshal an array of char
                  * @param dataIn - the DataInputStream to Un-Marshal from
@@ -428,6 +630,9 @@ namespace wireformat
                 virtual std::vector<unsigned char> looseUnmarshalByteArray(
                     decaf::io::DataInputStream* dataIn);
 
+                virtual std::vector<unsigned char> looseUnmarshalByteArray(
+                    utils::ByteReader* dataIn);
+
                 /**
                  * Tight Unmarshal a fixed size array from that data input
                  * stream and return an stl vector of char as the resultant.
@@ -442,6 +647,11 @@ namespace wireformat
                     utils::BooleanStream*       bs,
                     int                         size);
 
+                virtual std::vector<unsigned char> tightUnmarshalConstByteArray(
+                    utils::ByteReader*    dataIn,
+                    utils::BooleanStream* bs,
+                    int                   size);
+
                 /**
                  * Tight Unmarshal a fixed size array from that data input
                  * stream and return an stl vector of char as the resultant.
@@ -454,6 +664,10 @@ namespace wireformat
                     decaf::io::DataInputStream* dataIn,
                     int                         size);
 
+                virtual std::vector<unsigned char> looseUnmarshalConstByteArray(
+                    utils::ByteReader* dataIn,
+                    int                size);
+
                 /**
                  * Tight Unarshall the Error object
                  * @param wireFormat - The OpenwireFormat properties
@@ -467,6 +681,11 @@ namespace wireformat
                     decaf::io::DataInputStream* dataIn,
                     utils::BooleanStream*       bs);
 
+                virtual commands::DataStructure* tightUnmarshalBrokerError(
+                    OpenWireFormat*       wireFormat,
+                    utils::ByteReader*    dataIn,
+                    utils::BooleanStream* bs);
+
                 /**
                  * Tight Marshal the Error object
                  * @param wireFormat - The OpenwireFormat properties
@@ -494,6 +713,12 @@ namespace wireformat
                     decaf::io::DataOutputStream* dataOut,
                     utils::BooleanStream*        bs);
 
+                virtual void tightMarshalBrokerError2(
+                    OpenWireFormat*          wireFormat,
+                    commands::DataStructure* data,
+                    utils::ByteWriter*       dataOut,
+                    utils::BooleanStream*    bs);
+
                 /**
                  * Loose Unarshal the Error object
                  * @param wireFormat - The OpenwireFormat properties
@@ -505,6 +730,10 @@ namespace wireformat
                     OpenWireFormat*             wireFormat,
                     decaf::io::DataInputStream* dataIn);
 
+                virtual commands::DataStructure* looseUnmarshalBrokerError(
+                    OpenWireFormat*    wireFormat,
+                    utils::ByteReader* dataIn);
+
                 /**
                  * Tight Marshal the Error object
                  * @param wireFormat - The OpenwireFormat properties
@@ -517,6 +746,11 @@ namespace wireformat
                     commands::DataStructure*     data,
                     decaf::io::DataOutputStream* dataOut);
 
+                virtual void looseMarshalBrokerError(
+                    OpenWireFormat*          wireFormat,
+                    commands::DataStructure* data,
+                    utils::ByteWriter*       dataOut);
+
                 /**
                  * Tightly Marshal an array of DataStructure objects to the
                  * provided boolean stream, and return the size that the tight
@@ -570,12 +804,11 @@ namespace wireformat
                  * @return size of the marshalled data
                  * @throws IOException if an error occurs.
                  */
-                template <typename T>
-                void tightMarshalObjectArray2(
-                    OpenWireFormat*              wireFormat,
-                    std::vector<T>               objects,
-                    decaf::io::DataOutputStream* dataOut,
-                    utils::BooleanStream*        bs)
+                template <typename T, typename Out>
+                void tightMarshalObjectArray2(OpenWireFormat*       wireFormat,
+                                              std::vector<T>        objects,
+                                              Out*                  dataOut,
+                                              utils::BooleanStream* bs)
                 {
                     try
                     {
@@ -606,11 +839,10 @@ namespace wireformat
                  * @return size of the marshalled data
                  * @throws IOException if an error occurs.
                  */
-                template <typename T>
-                void looseMarshalObjectArray(
-                    OpenWireFormat*              wireFormat,
-                    std::vector<T>               objects,
-                    decaf::io::DataOutputStream* dataOut)
+                template <typename T, typename Out>
+                void looseMarshalObjectArray(OpenWireFormat* wireFormat,
+                                             std::vector<T>  objects,
+                                             Out*            dataOut)
                 {
                     try
                     {
@@ -641,6 +873,13 @@ namespace wireformat
                  */
                 virtual std::string readAsciiString(
                     decaf::io::DataInputStream* dataIn);
+
+                virtual std::string readAsciiString(utils::ByteReader* dataIn);
+
+            private:
+                // Holds the implementations shared by the stream and span based
+                // forms of the helpers above.
+                struct Codec;
             };
 
         }  // namespace marshal
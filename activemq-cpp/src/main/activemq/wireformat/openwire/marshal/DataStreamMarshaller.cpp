@@ -17,12 +17,126 @@
 
 #include "DataStreamMarshaller.h"
 
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+
 using namespace activemq;
 using namespace activemq::wireformat;
 using namespace activemq::wireformat::openwire;
 using namespace activemq::wireformat::openwire::marshal;
+using namespace activemq::wireformat::openwire::utils;
+using namespace activemq::commands;
+using namespace decaf::io;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+// Reads the rest of the span through a DataInputStream over it in place,
+// then moves the reader past whatever the stream consumed.
+class SpanInput
+{
+private:
+    ByteReader*          reader;
+    ByteArrayInputStream bytes;
+
+public:
+    DataInputStream dis;
+
+private:
+    SpanInput(const SpanInput&);
+    SpanInput& operator=(const SpanInput&);
+
+public:
+    SpanInput(ByteReader* reader)
+        : reader(reader),
+          bytes(reader->getData() + reader->getPosition(),
+                (int)reader->remaining()),
+          dis(&bytes)
+    {
+    }
+
+    void finish()
+    {
+        reader->skip(reader->remaining() - (std::size_t)bytes.available());
+    }
+};
+
+// Collects what a DataOutputStream writes and appends it to the writer.
+class SpanOutput
+{
+private:
+    ByteWriter*           writer;
+    ByteArrayOutputStream bytes;
+
+public:
+    DataOutputStream dos;
+
+private:
+    SpanOutput(const SpanOutput&);
+    SpanOutput& operator=(const SpanOutput&);
+
+public:
+    SpanOutput(ByteWriter* writer)
+        : writer(writer),
+          bytes(),
+          dos(&bytes)
+    {
+    }
+
+    void finish()
+    {
+        std::pair<unsigned char*, int> array = bytes.toByteArray();
+        writer->write(array.first, array.second);
+        delete[] array.first;
+    }
+};
+
+}  // namespace
 
 ////////////////////////////////////////////////////////////////////////////////
 DataStreamMarshaller::~DataStreamMarshaller()
 {
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void DataStreamMarshaller::tightMarshal2(OpenWireFormat* format,
+                                         DataStructure*  command,
+                                         ByteWriter*     out,
+                                         BooleanStream*  bs)
+{
+    SpanOutput output(out);
+    tightMarshal2(format, command, &output.dos, bs);
+    output.finish();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DataStreamMarshaller::tightUnmarshal(OpenWireFormat* format,
+                                          DataStructure*  command,
+                                          ByteReader*     in,
+                                          BooleanStream*  bs)
+{
+    SpanInput input(in);
+    tightUnmarshal(format, command, &input.dis, bs);
+    input.finish();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DataStreamMarshaller::looseMarshal(OpenWireFormat* format,
+                                        DataStructure*  command,
+                                        ByteWriter*     out)
+{
+    SpanOutput output(out);
+    looseMarshal(format, command, &output.dos);
+    output.finish();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DataStreamMarshaller::looseUnmarshal(OpenWireFormat* format,
+                                          DataStructure*  command,
+                                          ByteReader*     in)
+{
+    SpanInput input(in);
+    looseUnmarshal(format, command, &input.dis);
+    input.finish();
+}
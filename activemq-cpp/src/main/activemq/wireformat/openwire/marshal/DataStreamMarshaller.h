@@ -22,6 +22,8 @@
 #include <activemq/util/Config.h>
 #include <activemq/wireformat/openwire/OpenWireFormat.h>
 #include <activemq/wireformat/openwire/utils/BooleanStream.h>
+#include <activemq/wireformat/openwire/utils/ByteReader.h>
+#include <activemq/wireformat/openwire/utils/ByteWriter.h>
 #include <decaf/io/DataInputStream.h>
 #include <decaf/io/DataOutputStream.h>
 #include <decaf/io/IOException.h>
@@ -120,6 +122,59 @@ namespace wireformat
                 virtual void looseUnmarshal(OpenWireFormat*          format,
                                             commands::DataStructure* command,
                                             decaf::io::DataInputStream* dis) = 0;
+
+                // Span based forms of the methods above, used when the whole
+                // command is held in one contiguous buffer.  The generated
+                // marshallers implement these directly, the defaults adapt the
+                // stream based form so other marshallers keep working.
+
+                /**
+                 * Tight Marshal to the given buffer
+                 * @param format - The OpenwireFormat properties
+                 * @param command -  the object to Marshal
+                 * @param out - the ByteWriter to Marshal to
+                 * @param bs - boolean stream to marshal to.
+                 * @throws IOException if an error occurs.
+                 */
+                virtual void tightMarshal2(OpenWireFormat*          format,
+                                           commands::DataStructure* command,
+                                           utils::ByteWriter*       out,
+                                           utils::BooleanStream*    bs);
+
+                /**
+                 * Tight Un-marhsal from the given span
+                 * @param format - The OpenwireFormat properties
+                 * @param command -  the object to Un-Marshal
+                 * @param in - the ByteReader to Un-Marshal from
+                 * @param bs - boolean stream to unmarshal from.
+                 * @throws IOException if an error occurs.
+                 */
+                virtual void tightUnmarshal(OpenWireFormat*          format,
+                                            commands::DataStructure* command,
+                                            utils::ByteReader*       in,
+                                            utils::BooleanStream*    bs);
+
+                /**
+                 * Loose Marshal to the given buffer
+                 * @param format - The OpenwireFormat properties
+                 * @param command -  the object to Marshal
+                 * @param out - the ByteWriter to Marshal to
+                 * @throws IOException if an error occurs.
+                 */
+                virtual void looseMarshal(OpenWireFormat*          format,
+                                          commands::DataStructure* command,
+                                          utils::ByteWriter*       out);
+
+                /**
+                 * Loose Un-marhsal from the given span
+                 * @param format - The OpenwireFormat properties
+                 * @param command -  the object to Un-Marshal
+                 * @param in - the ByteReader to Un-Marshal from
+                 * @throws IOException if an error occurs.
+                 */
+                virtual void looseUnmarshal(OpenWireFormat*          format,
+                                            commands::DataStructure* command,
+                                            utils::ByteReader*       in);
             };
 
         }  // namespace marshal
@@ -223,9 +223,7 @@ void PrimitiveTypesMarshaller::marshalPrimitiveMap(
         while (keys->hasNext())
         {
             std::string key = keys->next();
-            dataOut.writeUTF(key);
-            PrimitiveValueNode value = map.get(key);
-            marshalPrimitive(dataOut, value);
+            marshalMapEntry(dataOut, key, map.get(key));
         }
     }
     AMQ_CATCH_RETHROW(io::IOException)
@@ -233,6 +231,22 @@ void PrimitiveTypesMarshaller::marshalPrimitiveMap(
     AMQ_CATCHALL_THROW(io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void PrimitiveTypesMarshaller::marshalMapEntry(
+    decaf::io::DataOutputStream& dataOut,
+    const std::string&           key,
+    const PrimitiveValueNode&    value)
+{
+    try
+    {
+        dataOut.writeUTF(key);
+        marshalPrimitive(dataOut, value);
+    }
+    AMQ_CATCH_RETHROW(io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, io::IOException)
+    AMQ_CATCHALL_THROW(io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void PrimitiveTypesMarshaller::marshalPrimitiveList(
     decaf::io::DataOutputStream&                 dataOut,
@@ -172,6 +172,27 @@ namespace wireformat
                 static util::PrimitiveList* unmarshalList(
                     decaf::io::DataInputStream& dataIn);
 
+                /**
+                 * Marshal a single key and value in the form used for each
+                 * entry of a marshaled PrimitiveMap, the entry count that
+                 * precedes the entries is not written.
+                 *
+                 * @param dataOut
+                 *      Reference to a DataOutputStream to write the marshaled
+                 * data to.
+                 * @param key
+                 *      The key of the map entry.
+                 * @param value
+                 *      The value of the map entry.
+                 *
+                 * @throws IOException if an I/O error occurs during this
+                 * operation.
+                 */
+                static void marshalMapEntry(
+                    decaf::io::DataOutputStream&    dataOut,
+                    const std::string&              key,
+                    const util::PrimitiveValueNode& value);
+
             protected:
                 /**
                  * Marshal a Map of Primitives to the given OutputStream, can
@@ -86,6 +86,41 @@ void ActiveMQBlobMessageMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQBlobMessageMarshaller::tightUnmarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteReader*     dataIn,
+    BooleanStream*  bs)
+{
+    try
+    {
+        MessageMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+        ActiveMQBlobMessage* info =
+            dynamic_cast<ActiveMQBlobMessage*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 3)
+        {
+            info->setRemoteBlobUrl(tightUnmarshalString(dataIn, bs));
+        }
+        if (wireVersion >= 3)
+        {
+            info->setMimeType(tightUnmarshalString(dataIn, bs));
+        }
+        if (wireVersion >= 3)
+        {
+            info->setDeletedByBroker(bs->readBoolean());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int ActiveMQBlobMessageMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                                  DataStructure*  dataStructure,
@@ -156,6 +191,40 @@ void ActiveMQBlobMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQBlobMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                                  DataStructure*  dataStructure,
+                                                  ByteWriter*     dataOut,
+                                                  BooleanStream*  bs)
+{
+    try
+    {
+        MessageMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+        ActiveMQBlobMessage* info =
+            dynamic_cast<ActiveMQBlobMessage*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 3)
+        {
+            tightMarshalString2(info->getRemoteBlobUrl(), dataOut, bs);
+        }
+        if (wireVersion >= 3)
+        {
+            tightMarshalString2(info->getMimeType(), dataOut, bs);
+        }
+        if (wireVersion >= 3)
+        {
+            bs->readBoolean();
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQBlobMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
                                                    DataStructure* dataStructure,
@@ -188,6 +257,39 @@ void ActiveMQBlobMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQBlobMessageMarshaller::looseUnmarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteReader*     dataIn)
+{
+    try
+    {
+        MessageMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
+        ActiveMQBlobMessage* info =
+            dynamic_cast<ActiveMQBlobMessage*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 3)
+        {
+            info->setRemoteBlobUrl(looseUnmarshalString(dataIn));
+        }
+        if (wireVersion >= 3)
+        {
+            info->setMimeType(looseUnmarshalString(dataIn));
+        }
+        if (wireVersion >= 3)
+        {
+            info->setDeletedByBroker(dataIn->readBoolean());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQBlobMessageMarshaller::looseMarshal(OpenWireFormat* wireFormat,
                                                  DataStructure*  dataStructure,
@@ -219,3 +321,35 @@ void ActiveMQBlobMessageMarshaller::looseMarshal(OpenWireFormat* wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQBlobMessageMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                                 DataStructure*  dataStructure,
+                                                 ByteWriter*     dataOut)
+{
+    try
+    {
+        ActiveMQBlobMessage* info =
+            dynamic_cast<ActiveMQBlobMessage*>(dataStructure);
+        MessageMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 3)
+        {
+            looseMarshalString(info->getRemoteBlobUrl(), dataOut);
+        }
+        if (wireVersion >= 3)
+        {
+            looseMarshalString(info->getMimeType(), dataOut);
+        }
+        if (wireVersion >= 3)
+        {
+            dataOut->writeBoolean(info->isDeletedByBroker());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
@@ -74,6 +74,29 @@ void ActiveMQBytesMessageMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQBytesMessageMarshaller::tightUnmarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteReader*     dataIn,
+    BooleanStream*  bs)
+{
+    try
+    {
+        MessageMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+        ActiveMQBytesMessage* info =
+            dynamic_cast<ActiveMQBytesMessage*>(dataStructure);
+        info->beforeUnmarshal(wireFormat);
+
+        info->afterUnmarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int ActiveMQBytesMessageMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                                   DataStructure*  dataStructure,
@@ -116,6 +139,27 @@ void ActiveMQBytesMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQBytesMessageMarshaller::tightMarshal2(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteWriter*     dataOut,
+    BooleanStream*  bs)
+{
+    try
+    {
+        MessageMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+        ActiveMQBytesMessage* info =
+            dynamic_cast<ActiveMQBytesMessage*>(dataStructure);
+        info->afterMarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQBytesMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
                                                     DataStructure* dataStructure,
@@ -135,6 +179,26 @@ void ActiveMQBytesMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQBytesMessageMarshaller::looseUnmarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteReader*     dataIn)
+{
+    try
+    {
+        MessageMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
+        ActiveMQBytesMessage* info =
+            dynamic_cast<ActiveMQBytesMessage*>(dataStructure);
+        info->beforeUnmarshal(wireFormat);
+        info->afterUnmarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQBytesMessageMarshaller::looseMarshal(OpenWireFormat* wireFormat,
                                                   DataStructure*  dataStructure,
@@ -153,3 +217,22 @@ void ActiveMQBytesMessageMarshaller::looseMarshal(OpenWireFormat* wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQBytesMessageMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                                  DataStructure*  dataStructure,
+                                                  ByteWriter*     dataOut)
+{
+    try
+    {
+        ActiveMQBytesMessage* info =
+            dynamic_cast<ActiveMQBytesMessage*>(dataStructure);
+        info->beforeMarshal(wireFormat);
+        MessageMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+        info->afterMarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
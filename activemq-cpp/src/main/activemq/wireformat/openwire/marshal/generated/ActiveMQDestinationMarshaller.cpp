@@ -63,6 +63,30 @@ void ActiveMQDestinationMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQDestinationMarshaller::tightUnmarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteReader*     dataIn,
+    BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn,
+                                                 bs);
+
+        ActiveMQDestination* info =
+            dynamic_cast<ActiveMQDestination*>(dataStructure);
+        info->setPhysicalName(tightUnmarshalString(dataIn, bs));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int ActiveMQDestinationMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                                  DataStructure*  dataStructure,
@@ -109,6 +133,29 @@ void ActiveMQDestinationMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQDestinationMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                                  DataStructure*  dataStructure,
+                                                  ByteWriter*     dataOut,
+                                                  BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightMarshal2(wireFormat,
+                                                dataStructure,
+                                                dataOut,
+                                                bs);
+
+        ActiveMQDestination* info =
+            dynamic_cast<ActiveMQDestination*>(dataStructure);
+        tightMarshalString2(info->getPhysicalName(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQDestinationMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
                                                    DataStructure* dataStructure,
@@ -129,6 +176,27 @@ void ActiveMQDestinationMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQDestinationMarshaller::looseUnmarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteReader*     dataIn)
+{
+    try
+    {
+        BaseDataStreamMarshaller::looseUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn);
+        ActiveMQDestination* info =
+            dynamic_cast<ActiveMQDestination*>(dataStructure);
+        info->setPhysicalName(looseUnmarshalString(dataIn));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQDestinationMarshaller::looseMarshal(OpenWireFormat* wireFormat,
                                                  DataStructure*  dataStructure,
@@ -148,3 +216,23 @@ void ActiveMQDestinationMarshaller::looseMarshal(OpenWireFormat* wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQDestinationMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                                 DataStructure*  dataStructure,
+                                                 ByteWriter*     dataOut)
+{
+    try
+    {
+        ActiveMQDestination* info =
+            dynamic_cast<ActiveMQDestination*>(dataStructure);
+        BaseDataStreamMarshaller::looseMarshal(wireFormat,
+                                               dataStructure,
+                                               dataOut);
+        looseMarshalString(info->getPhysicalName(), dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
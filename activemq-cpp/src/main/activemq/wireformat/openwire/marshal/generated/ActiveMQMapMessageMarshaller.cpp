@@ -74,6 +74,28 @@ void ActiveMQMapMessageMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQMapMessageMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                                  DataStructure*  dataStructure,
+                                                  ByteReader*     dataIn,
+                                                  BooleanStream*  bs)
+{
+    try
+    {
+        MessageMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+        ActiveMQMapMessage* info =
+            dynamic_cast<ActiveMQMapMessage*>(dataStructure);
+        info->beforeUnmarshal(wireFormat);
+
+        info->afterUnmarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int ActiveMQMapMessageMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                                 DataStructure*  dataStructure,
@@ -116,6 +138,26 @@ void ActiveMQMapMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQMapMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                                 DataStructure*  dataStructure,
+                                                 ByteWriter*     dataOut,
+                                                 BooleanStream*  bs)
+{
+    try
+    {
+        MessageMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+        ActiveMQMapMessage* info =
+            dynamic_cast<ActiveMQMapMessage*>(dataStructure);
+        info->afterMarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQMapMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
                                                   DataStructure*  dataStructure,
@@ -135,6 +177,25 @@ void ActiveMQMapMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQMapMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                                  DataStructure*  dataStructure,
+                                                  ByteReader*     dataIn)
+{
+    try
+    {
+        MessageMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
+        ActiveMQMapMessage* info =
+            dynamic_cast<ActiveMQMapMessage*>(dataStructure);
+        info->beforeUnmarshal(wireFormat);
+        info->afterUnmarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQMapMessageMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                                 DataStructure*    dataStructure,
@@ -153,3 +214,22 @@ void ActiveMQMapMessageMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQMapMessageMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                                DataStructure*  dataStructure,
+                                                ByteWriter*     dataOut)
+{
+    try
+    {
+        ActiveMQMapMessage* info =
+            dynamic_cast<ActiveMQMapMessage*>(dataStructure);
+        info->beforeMarshal(wireFormat);
+        MessageMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+        info->afterMarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
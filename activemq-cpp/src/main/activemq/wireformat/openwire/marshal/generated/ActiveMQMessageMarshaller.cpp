@@ -73,6 +73,27 @@ void ActiveMQMessageMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQMessageMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn,
+                                               BooleanStream*  bs)
+{
+    try
+    {
+        MessageMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+        ActiveMQMessage* info = dynamic_cast<ActiveMQMessage*>(dataStructure);
+        info->beforeUnmarshal(wireFormat);
+
+        info->afterUnmarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int ActiveMQMessageMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                              DataStructure*  dataStructure,
@@ -113,6 +134,25 @@ void ActiveMQMessageMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteWriter*     dataOut,
+                                              BooleanStream*  bs)
+{
+    try
+    {
+        MessageMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+        ActiveMQMessage* info = dynamic_cast<ActiveMQMessage*>(dataStructure);
+        info->afterMarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQMessageMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                                DataStructure*   dataStructure,
@@ -131,6 +171,24 @@ void ActiveMQMessageMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn)
+{
+    try
+    {
+        MessageMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
+        ActiveMQMessage* info = dynamic_cast<ActiveMQMessage*>(dataStructure);
+        info->beforeUnmarshal(wireFormat);
+        info->afterUnmarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQMessageMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                              DataStructure*    dataStructure,
@@ -148,3 +206,21 @@ void ActiveMQMessageMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQMessageMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                             DataStructure*  dataStructure,
+                                             ByteWriter*     dataOut)
+{
+    try
+    {
+        ActiveMQMessage* info = dynamic_cast<ActiveMQMessage*>(dataStructure);
+        info->beforeMarshal(wireFormat);
+        MessageMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+        info->afterMarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
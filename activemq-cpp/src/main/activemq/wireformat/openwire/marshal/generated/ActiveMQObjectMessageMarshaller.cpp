@@ -75,6 +75,29 @@ void ActiveMQObjectMessageMarshaller::tightUnmarshal(
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQObjectMessageMarshaller::tightUnmarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteReader*     dataIn,
+    BooleanStream*  bs)
+{
+    try
+    {
+        MessageMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+        ActiveMQObjectMessage* info =
+            dynamic_cast<ActiveMQObjectMessage*>(dataStructure);
+        info->beforeUnmarshal(wireFormat);
+
+        info->afterUnmarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int ActiveMQObjectMessageMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                                    DataStructure* dataStructure,
@@ -117,6 +140,27 @@ void ActiveMQObjectMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQObjectMessageMarshaller::tightMarshal2(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteWriter*     dataOut,
+    BooleanStream*  bs)
+{
+    try
+    {
+        MessageMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+        ActiveMQObjectMessage* info =
+            dynamic_cast<ActiveMQObjectMessage*>(dataStructure);
+        info->afterMarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQObjectMessageMarshaller::looseUnmarshal(
     OpenWireFormat*  wireFormat,
@@ -137,6 +181,26 @@ void ActiveMQObjectMessageMarshaller::looseUnmarshal(
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQObjectMessageMarshaller::looseUnmarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteReader*     dataIn)
+{
+    try
+    {
+        MessageMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
+        ActiveMQObjectMessage* info =
+            dynamic_cast<ActiveMQObjectMessage*>(dataStructure);
+        info->beforeUnmarshal(wireFormat);
+        info->afterUnmarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQObjectMessageMarshaller::looseMarshal(OpenWireFormat* wireFormat,
                                                    DataStructure* dataStructure,
@@ -155,3 +219,23 @@ void ActiveMQObjectMessageMarshaller::looseMarshal(OpenWireFormat* wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQObjectMessageMarshaller::looseMarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteWriter*     dataOut)
+{
+    try
+    {
+        ActiveMQObjectMessage* info =
+            dynamic_cast<ActiveMQObjectMessage*>(dataStructure);
+        info->beforeMarshal(wireFormat);
+        MessageMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+        info->afterMarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
@@ -71,6 +71,25 @@ void ActiveMQQueueMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQQueueMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                             DataStructure*  dataStructure,
+                                             ByteReader*     dataIn,
+                                             BooleanStream*  bs)
+{
+    try
+    {
+        ActiveMQDestinationMarshaller::tightUnmarshal(wireFormat,
+                                                      dataStructure,
+                                                      dataIn,
+                                                      bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int ActiveMQQueueMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                            DataStructure*  dataStructure,
@@ -109,6 +128,25 @@ void ActiveMQQueueMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQQueueMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                            DataStructure*  dataStructure,
+                                            ByteWriter*     dataOut,
+                                            BooleanStream*  bs)
+{
+    try
+    {
+        ActiveMQDestinationMarshaller::tightMarshal2(wireFormat,
+                                                     dataStructure,
+                                                     dataOut,
+                                                     bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQQueueMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                              DataStructure*   dataStructure,
@@ -126,6 +164,23 @@ void ActiveMQQueueMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQQueueMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                             DataStructure*  dataStructure,
+                                             ByteReader*     dataIn)
+{
+    try
+    {
+        ActiveMQDestinationMarshaller::looseUnmarshal(wireFormat,
+                                                      dataStructure,
+                                                      dataIn);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQQueueMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                            DataStructure*    dataStructure,
@@ -142,3 +197,20 @@ void ActiveMQQueueMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQQueueMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                           DataStructure*  dataStructure,
+                                           ByteWriter*     dataOut)
+{
+    try
+    {
+        ActiveMQDestinationMarshaller::looseMarshal(wireFormat,
+                                                    dataStructure,
+                                                    dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
@@ -75,6 +75,29 @@ void ActiveMQStreamMessageMarshaller::tightUnmarshal(
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamMessageMarshaller::tightUnmarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteReader*     dataIn,
+    BooleanStream*  bs)
+{
+    try
+    {
+        MessageMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+        ActiveMQStreamMessage* info =
+            dynamic_cast<ActiveMQStreamMessage*>(dataStructure);
+        info->beforeUnmarshal(wireFormat);
+
+        info->afterUnmarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int ActiveMQStreamMessageMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                                    DataStructure* dataStructure,
@@ -117,6 +140,27 @@ void ActiveMQStreamMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamMessageMarshaller::tightMarshal2(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteWriter*     dataOut,
+    BooleanStream*  bs)
+{
+    try
+    {
+        MessageMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+        ActiveMQStreamMessage* info =
+            dynamic_cast<ActiveMQStreamMessage*>(dataStructure);
+        info->afterMarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQStreamMessageMarshaller::looseUnmarshal(
     OpenWireFormat*  wireFormat,
@@ -137,6 +181,26 @@ void ActiveMQStreamMessageMarshaller::looseUnmarshal(
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamMessageMarshaller::looseUnmarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteReader*     dataIn)
+{
+    try
+    {
+        MessageMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
+        ActiveMQStreamMessage* info =
+            dynamic_cast<ActiveMQStreamMessage*>(dataStructure);
+        info->beforeUnmarshal(wireFormat);
+        info->afterUnmarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQStreamMessageMarshaller::looseMarshal(OpenWireFormat* wireFormat,
                                                    DataStructure* dataStructure,
@@ -155,3 +219,23 @@ void ActiveMQStreamMessageMarshaller::looseMarshal(OpenWireFormat* wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamMessageMarshaller::looseMarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteWriter*     dataOut)
+{
+    try
+    {
+        ActiveMQStreamMessage* info =
+            dynamic_cast<ActiveMQStreamMessage*>(dataStructure);
+        info->beforeMarshal(wireFormat);
+        MessageMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+        info->afterMarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
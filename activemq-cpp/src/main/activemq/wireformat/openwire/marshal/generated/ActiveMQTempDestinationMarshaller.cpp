@@ -60,6 +60,26 @@ void ActiveMQTempDestinationMarshaller::tightUnmarshal(
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQTempDestinationMarshaller::tightUnmarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteReader*     dataIn,
+    BooleanStream*  bs)
+{
+    try
+    {
+        ActiveMQDestinationMarshaller::tightUnmarshal(wireFormat,
+                                                      dataStructure,
+                                                      dataIn,
+                                                      bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int ActiveMQTempDestinationMarshaller::tightMarshal1(
     OpenWireFormat* wireFormat,
@@ -100,6 +120,26 @@ void ActiveMQTempDestinationMarshaller::tightMarshal2(
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQTempDestinationMarshaller::tightMarshal2(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteWriter*     dataOut,
+    BooleanStream*  bs)
+{
+    try
+    {
+        ActiveMQDestinationMarshaller::tightMarshal2(wireFormat,
+                                                     dataStructure,
+                                                     dataOut,
+                                                     bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQTempDestinationMarshaller::looseUnmarshal(
     OpenWireFormat*  wireFormat,
@@ -118,6 +158,24 @@ void ActiveMQTempDestinationMarshaller::looseUnmarshal(
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQTempDestinationMarshaller::looseUnmarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteReader*     dataIn)
+{
+    try
+    {
+        ActiveMQDestinationMarshaller::looseUnmarshal(wireFormat,
+                                                      dataStructure,
+                                                      dataIn);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQTempDestinationMarshaller::looseMarshal(
     OpenWireFormat*   wireFormat,
@@ -135,3 +193,21 @@ void ActiveMQTempDestinationMarshaller::looseMarshal(
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQTempDestinationMarshaller::looseMarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteWriter*     dataOut)
+{
+    try
+    {
+        ActiveMQDestinationMarshaller::looseMarshal(wireFormat,
+                                                    dataStructure,
+                                                    dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
@@ -71,6 +71,25 @@ void ActiveMQTempTopicMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQTempTopicMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                                 DataStructure*  dataStructure,
+                                                 ByteReader*     dataIn,
+                                                 BooleanStream*  bs)
+{
+    try
+    {
+        ActiveMQTempDestinationMarshaller::tightUnmarshal(wireFormat,
+                                                          dataStructure,
+                                                          dataIn,
+                                                          bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int ActiveMQTempTopicMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                                DataStructure*  dataStructure,
@@ -109,6 +128,25 @@ void ActiveMQTempTopicMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQTempTopicMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                                DataStructure*  dataStructure,
+                                                ByteWriter*     dataOut,
+                                                BooleanStream*  bs)
+{
+    try
+    {
+        ActiveMQTempDestinationMarshaller::tightMarshal2(wireFormat,
+                                                         dataStructure,
+                                                         dataOut,
+                                                         bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQTempTopicMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                                  DataStructure*   dataStructure,
@@ -126,6 +164,23 @@ void ActiveMQTempTopicMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQTempTopicMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                                 DataStructure*  dataStructure,
+                                                 ByteReader*     dataIn)
+{
+    try
+    {
+        ActiveMQTempDestinationMarshaller::looseUnmarshal(wireFormat,
+                                                          dataStructure,
+                                                          dataIn);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQTempTopicMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                                DataStructure*    dataStructure,
@@ -142,3 +197,20 @@ void ActiveMQTempTopicMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQTempTopicMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteWriter*     dataOut)
+{
+    try
+    {
+        ActiveMQTempDestinationMarshaller::looseMarshal(wireFormat,
+                                                        dataStructure,
+                                                        dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
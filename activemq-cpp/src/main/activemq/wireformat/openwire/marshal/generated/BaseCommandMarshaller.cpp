@@ -63,6 +63,29 @@ void BaseCommandMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void BaseCommandMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                           DataStructure*  dataStructure,
+                                           ByteReader*     dataIn,
+                                           BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn,
+                                                 bs);
+
+        BaseCommand* info = dynamic_cast<BaseCommand*>(dataStructure);
+        info->setCommandId(dataIn->readInt());
+        info->setResponseRequired(bs->readBoolean());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int BaseCommandMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                          DataStructure*  dataStructure,
@@ -108,6 +131,29 @@ void BaseCommandMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void BaseCommandMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                          DataStructure*  dataStructure,
+                                          ByteWriter*     dataOut,
+                                          BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightMarshal2(wireFormat,
+                                                dataStructure,
+                                                dataOut,
+                                                bs);
+
+        BaseCommand* info = dynamic_cast<BaseCommand*>(dataStructure);
+        dataOut->writeInt(info->getCommandId());
+        bs->readBoolean();
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void BaseCommandMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                            DataStructure*   dataStructure,
@@ -128,6 +174,26 @@ void BaseCommandMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void BaseCommandMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                           DataStructure*  dataStructure,
+                                           ByteReader*     dataIn)
+{
+    try
+    {
+        BaseDataStreamMarshaller::looseUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn);
+        BaseCommand* info = dynamic_cast<BaseCommand*>(dataStructure);
+        info->setCommandId(dataIn->readInt());
+        info->setResponseRequired(dataIn->readBoolean());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void BaseCommandMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                          DataStructure*    dataStructure,
@@ -147,3 +213,23 @@ void BaseCommandMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void BaseCommandMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                         DataStructure*  dataStructure,
+                                         ByteWriter*     dataOut)
+{
+    try
+    {
+        BaseCommand* info = dynamic_cast<BaseCommand*>(dataStructure);
+        BaseDataStreamMarshaller::looseMarshal(wireFormat,
+                                               dataStructure,
+                                               dataOut);
+        dataOut->writeInt(info->getCommandId());
+        dataOut->writeBoolean(info->isResponseRequired());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
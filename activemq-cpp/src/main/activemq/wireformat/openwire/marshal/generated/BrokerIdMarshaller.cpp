@@ -74,6 +74,28 @@ void BrokerIdMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void BrokerIdMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                        DataStructure*  dataStructure,
+                                        ByteReader*     dataIn,
+                                        BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn,
+                                                 bs);
+
+        BrokerId* info = dynamic_cast<BrokerId*>(dataStructure);
+        info->setValue(tightUnmarshalString(dataIn, bs));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int BrokerIdMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                       DataStructure*  dataStructure,
@@ -118,6 +140,28 @@ void BrokerIdMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void BrokerIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                       DataStructure*  dataStructure,
+                                       ByteWriter*     dataOut,
+                                       BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightMarshal2(wireFormat,
+                                                dataStructure,
+                                                dataOut,
+                                                bs);
+
+        BrokerId* info = dynamic_cast<BrokerId*>(dataStructure);
+        tightMarshalString2(info->getValue(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void BrokerIdMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                         DataStructure*   dataStructure,
@@ -137,6 +181,25 @@ void BrokerIdMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void BrokerIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                        DataStructure*  dataStructure,
+                                        ByteReader*     dataIn)
+{
+    try
+    {
+        BaseDataStreamMarshaller::looseUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn);
+        BrokerId* info = dynamic_cast<BrokerId*>(dataStructure);
+        info->setValue(looseUnmarshalString(dataIn));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void BrokerIdMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                       DataStructure*    dataStructure,
@@ -155,3 +218,22 @@ void BrokerIdMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void BrokerIdMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                      DataStructure*  dataStructure,
+                                      ByteWriter*     dataOut)
+{
+    try
+    {
+        BrokerId* info = dynamic_cast<BrokerId*>(dataStructure);
+        BaseDataStreamMarshaller::looseMarshal(wireFormat,
+                                               dataStructure,
+                                               dataOut);
+        looseMarshalString(info->getValue(), dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
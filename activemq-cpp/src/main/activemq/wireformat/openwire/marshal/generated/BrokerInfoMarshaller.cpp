@@ -69,8 +69,75 @@ void BrokerInfoMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setBrokerId(std::shared_ptr<BrokerId>(dynamic_cast<BrokerId*>(
-            tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setBrokerId(std::dynamic_pointer_cast<BrokerId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
+        info->setBrokerURL(tightUnmarshalString(dataIn, bs));
+
+        if (bs->readBoolean())
+        {
+            short size = dataIn->readShort();
+            info->getPeerBrokerInfos().reserve(size);
+            for (int i = 0; i < size; i++)
+            {
+                info->getPeerBrokerInfos().push_back(
+                    std::shared_ptr<BrokerInfo>(dynamic_cast<BrokerInfo*>(
+                        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+            }
+        }
+        else
+        {
+            info->getPeerBrokerInfos().clear();
+        }
+        info->setBrokerName(tightUnmarshalString(dataIn, bs));
+        info->setSlaveBroker(bs->readBoolean());
+        info->setMasterBroker(bs->readBoolean());
+        info->setFaultTolerantConfiguration(bs->readBoolean());
+        if (wireVersion >= 2)
+        {
+            info->setDuplexConnection(bs->readBoolean());
+        }
+        if (wireVersion >= 2)
+        {
+            info->setNetworkConnection(bs->readBoolean());
+        }
+        if (wireVersion >= 2)
+        {
+            info->setConnectionId(tightUnmarshalLong(wireFormat, dataIn, bs));
+        }
+        if (wireVersion >= 3)
+        {
+            info->setBrokerUploadUrl(tightUnmarshalString(dataIn, bs));
+        }
+        if (wireVersion >= 3)
+        {
+            info->setNetworkProperties(tightUnmarshalString(dataIn, bs));
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void BrokerInfoMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                          DataStructure*  dataStructure,
+                                          ByteReader*     dataIn,
+                                          BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        BrokerInfo* info = dynamic_cast<BrokerInfo*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setBrokerId(std::dynamic_pointer_cast<BrokerId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
         info->setBrokerURL(tightUnmarshalString(dataIn, bs));
 
         if (bs->readBoolean())
@@ -230,6 +297,63 @@ void BrokerInfoMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void BrokerInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                         DataStructure*  dataStructure,
+                                         ByteWriter*     dataOut,
+                                         BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        BrokerInfo* info = dynamic_cast<BrokerInfo*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getBrokerId().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalString2(info->getBrokerURL(), dataOut, bs);
+        tightMarshalObjectArray2(wireFormat,
+                                 info->getPeerBrokerInfos(),
+                                 dataOut,
+                                 bs);
+        tightMarshalString2(info->getBrokerName(), dataOut, bs);
+        bs->readBoolean();
+        bs->readBoolean();
+        bs->readBoolean();
+        if (wireVersion >= 2)
+        {
+            bs->readBoolean();
+        }
+        if (wireVersion >= 2)
+        {
+            bs->readBoolean();
+        }
+        if (wireVersion >= 2)
+        {
+            tightMarshalLong2(wireFormat, info->getConnectionId(), dataOut, bs);
+        }
+        if (wireVersion >= 3)
+        {
+            tightMarshalString2(info->getBrokerUploadUrl(), dataOut, bs);
+        }
+        if (wireVersion >= 3)
+        {
+            tightMarshalString2(info->getNetworkProperties(), dataOut, bs);
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void BrokerInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                           DataStructure*   dataStructure,
@@ -244,8 +368,72 @@ void BrokerInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setBrokerId(std::shared_ptr<BrokerId>(dynamic_cast<BrokerId*>(
-            looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setBrokerId(std::dynamic_pointer_cast<BrokerId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
+        info->setBrokerURL(looseUnmarshalString(dataIn));
+
+        if (dataIn->readBoolean())
+        {
+            short size = dataIn->readShort();
+            info->getPeerBrokerInfos().reserve(size);
+            for (int i = 0; i < size; i++)
+            {
+                info->getPeerBrokerInfos().push_back(
+                    std::shared_ptr<BrokerInfo>(dynamic_cast<BrokerInfo*>(
+                        looseUnmarshalNestedObject(wireFormat, dataIn))));
+            }
+        }
+        else
+        {
+            info->getPeerBrokerInfos().clear();
+        }
+        info->setBrokerName(looseUnmarshalString(dataIn));
+        info->setSlaveBroker(dataIn->readBoolean());
+        info->setMasterBroker(dataIn->readBoolean());
+        info->setFaultTolerantConfiguration(dataIn->readBoolean());
+        if (wireVersion >= 2)
+        {
+            info->setDuplexConnection(dataIn->readBoolean());
+        }
+        if (wireVersion >= 2)
+        {
+            info->setNetworkConnection(dataIn->readBoolean());
+        }
+        if (wireVersion >= 2)
+        {
+            info->setConnectionId(looseUnmarshalLong(wireFormat, dataIn));
+        }
+        if (wireVersion >= 3)
+        {
+            info->setBrokerUploadUrl(looseUnmarshalString(dataIn));
+        }
+        if (wireVersion >= 3)
+        {
+            info->setNetworkProperties(looseUnmarshalString(dataIn));
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void BrokerInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                          DataStructure*  dataStructure,
+                                          ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        BrokerInfo* info = dynamic_cast<BrokerInfo*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setBrokerId(std::dynamic_pointer_cast<BrokerId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
         info->setBrokerURL(looseUnmarshalString(dataIn));
 
         if (dataIn->readBoolean())
@@ -343,3 +531,53 @@ void BrokerInfoMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void BrokerInfoMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                        DataStructure*  dataStructure,
+                                        ByteWriter*     dataOut)
+{
+    try
+    {
+        BrokerInfo* info = dynamic_cast<BrokerInfo*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+
+        int wireVersion = wireFormat->getVersion();
+
+        looseMarshalCachedObject(wireFormat,
+                                 info->getBrokerId().get(),
+                                 dataOut);
+        looseMarshalString(info->getBrokerURL(), dataOut);
+        looseMarshalObjectArray(wireFormat,
+                                info->getPeerBrokerInfos(),
+                                dataOut);
+        looseMarshalString(info->getBrokerName(), dataOut);
+        dataOut->writeBoolean(info->isSlaveBroker());
+        dataOut->writeBoolean(info->isMasterBroker());
+        dataOut->writeBoolean(info->isFaultTolerantConfiguration());
+        if (wireVersion >= 2)
+        {
+            dataOut->writeBoolean(info->isDuplexConnection());
+        }
+        if (wireVersion >= 2)
+        {
+            dataOut->writeBoolean(info->isNetworkConnection());
+        }
+        if (wireVersion >= 2)
+        {
+            looseMarshalLong(wireFormat, info->getConnectionId(), dataOut);
+        }
+        if (wireVersion >= 3)
+        {
+            looseMarshalString(info->getBrokerUploadUrl(), dataOut);
+        }
+        if (wireVersion >= 3)
+        {
+            looseMarshalString(info->getNetworkProperties(), dataOut);
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
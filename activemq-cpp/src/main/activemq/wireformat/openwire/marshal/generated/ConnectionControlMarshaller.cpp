@@ -98,6 +98,52 @@ void ConnectionControlMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionControlMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                                 DataStructure*  dataStructure,
+                                                 ByteReader*     dataIn,
+                                                 BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        ConnectionControl* info =
+            dynamic_cast<ConnectionControl*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setClose(bs->readBoolean());
+        info->setExit(bs->readBoolean());
+        info->setFaultTolerant(bs->readBoolean());
+        info->setResume(bs->readBoolean());
+        info->setSuspend(bs->readBoolean());
+        if (wireVersion >= 6)
+        {
+            info->setConnectedBrokers(tightUnmarshalString(dataIn, bs));
+        }
+        if (wireVersion >= 6)
+        {
+            info->setReconnectTo(tightUnmarshalString(dataIn, bs));
+        }
+        if (wireVersion >= 6)
+        {
+            info->setRebalanceConnection(bs->readBoolean());
+        }
+        if (wireVersion >= 8)
+        {
+            info->setToken(tightUnmarshalByteArray(dataIn, bs));
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int ConnectionControlMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                                DataStructure*  dataStructure,
@@ -199,6 +245,59 @@ void ConnectionControlMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionControlMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                                DataStructure*  dataStructure,
+                                                ByteWriter*     dataOut,
+                                                BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        ConnectionControl* info =
+            dynamic_cast<ConnectionControl*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        bs->readBoolean();
+        bs->readBoolean();
+        bs->readBoolean();
+        bs->readBoolean();
+        bs->readBoolean();
+        if (wireVersion >= 6)
+        {
+            tightMarshalString2(info->getConnectedBrokers(), dataOut, bs);
+        }
+        if (wireVersion >= 6)
+        {
+            tightMarshalString2(info->getReconnectTo(), dataOut, bs);
+        }
+        if (wireVersion >= 6)
+        {
+            bs->readBoolean();
+        }
+        if (wireVersion >= 8)
+        {
+            if (bs->readBoolean())
+            {
+                dataOut->writeInt((int)info->getToken().size());
+                dataOut->write((const unsigned char*)(&info->getToken()[0]),
+                               (int)info->getToken().size(),
+                               0,
+                               (int)info->getToken().size());
+            }
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConnectionControlMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                                  DataStructure*   dataStructure,
@@ -242,6 +341,49 @@ void ConnectionControlMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionControlMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                                 DataStructure*  dataStructure,
+                                                 ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        ConnectionControl* info =
+            dynamic_cast<ConnectionControl*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setClose(dataIn->readBoolean());
+        info->setExit(dataIn->readBoolean());
+        info->setFaultTolerant(dataIn->readBoolean());
+        info->setResume(dataIn->readBoolean());
+        info->setSuspend(dataIn->readBoolean());
+        if (wireVersion >= 6)
+        {
+            info->setConnectedBrokers(looseUnmarshalString(dataIn));
+        }
+        if (wireVersion >= 6)
+        {
+            info->setReconnectTo(looseUnmarshalString(dataIn));
+        }
+        if (wireVersion >= 6)
+        {
+            info->setRebalanceConnection(dataIn->readBoolean());
+        }
+        if (wireVersion >= 8)
+        {
+            info->setToken(looseUnmarshalByteArray(dataIn));
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConnectionControlMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                                DataStructure*    dataStructure,
@@ -290,3 +432,52 @@ void ConnectionControlMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionControlMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteWriter*     dataOut)
+{
+    try
+    {
+        ConnectionControl* info =
+            dynamic_cast<ConnectionControl*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+
+        int wireVersion = wireFormat->getVersion();
+
+        dataOut->writeBoolean(info->isClose());
+        dataOut->writeBoolean(info->isExit());
+        dataOut->writeBoolean(info->isFaultTolerant());
+        dataOut->writeBoolean(info->isResume());
+        dataOut->writeBoolean(info->isSuspend());
+        if (wireVersion >= 6)
+        {
+            looseMarshalString(info->getConnectedBrokers(), dataOut);
+        }
+        if (wireVersion >= 6)
+        {
+            looseMarshalString(info->getReconnectTo(), dataOut);
+        }
+        if (wireVersion >= 6)
+        {
+            dataOut->writeBoolean(info->isRebalanceConnection());
+        }
+        if (wireVersion >= 8)
+        {
+            dataOut->write(info->getToken().size() != 0);
+            if (info->getToken().size() != 0)
+            {
+                dataOut->writeInt((int)info->getToken().size());
+                dataOut->write((const unsigned char*)(&info->getToken()[0]),
+                               (int)info->getToken().size(),
+                               0,
+                               (int)info->getToken().size());
+            }
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
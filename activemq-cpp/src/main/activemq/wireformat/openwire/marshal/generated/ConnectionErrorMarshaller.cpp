@@ -79,6 +79,33 @@ void ConnectionErrorMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionErrorMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn,
+                                               BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        ConnectionError* info = dynamic_cast<ConnectionError*>(dataStructure);
+        info->setException(
+            std::shared_ptr<BrokerError>(dynamic_cast<BrokerError*>(
+                tightUnmarshalBrokerError(wireFormat, dataIn, bs))));
+        info->setConnectionId(
+            std::shared_ptr<ConnectionId>(dynamic_cast<ConnectionId*>(
+                tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int ConnectionErrorMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                              DataStructure*  dataStructure,
@@ -134,6 +161,35 @@ void ConnectionErrorMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionErrorMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteWriter*     dataOut,
+                                              BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        ConnectionError* info = dynamic_cast<ConnectionError*>(dataStructure);
+        tightMarshalBrokerError2(wireFormat,
+                                 info->getException().get(),
+                                 dataOut,
+                                 bs);
+        tightMarshalNestedObject2(wireFormat,
+                                  info->getConnectionId().get(),
+                                  dataOut,
+                                  bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConnectionErrorMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                                DataStructure*   dataStructure,
@@ -158,6 +214,30 @@ void ConnectionErrorMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionErrorMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        ConnectionError* info = dynamic_cast<ConnectionError*>(dataStructure);
+        info->setException(
+            std::shared_ptr<BrokerError>(dynamic_cast<BrokerError*>(
+                looseUnmarshalBrokerError(wireFormat, dataIn))));
+        info->setConnectionId(
+            std::shared_ptr<ConnectionId>(dynamic_cast<ConnectionId*>(
+                looseUnmarshalNestedObject(wireFormat, dataIn))));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConnectionErrorMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                              DataStructure*    dataStructure,
@@ -179,3 +259,25 @@ void ConnectionErrorMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionErrorMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                             DataStructure*  dataStructure,
+                                             ByteWriter*     dataOut)
+{
+    try
+    {
+        ConnectionError* info = dynamic_cast<ConnectionError*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+        looseMarshalBrokerError(wireFormat,
+                                info->getException().get(),
+                                dataOut);
+        looseMarshalNestedObject(wireFormat,
+                                 info->getConnectionId().get(),
+                                 dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
@@ -69,9 +69,71 @@ void ConnectionInfoMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setConnectionId(
-            std::shared_ptr<ConnectionId>(dynamic_cast<ConnectionId*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
+        info->setClientId(tightUnmarshalString(dataIn, bs));
+        info->setPassword(tightUnmarshalString(dataIn, bs));
+        info->setUserName(tightUnmarshalString(dataIn, bs));
+
+        if (bs->readBoolean())
+        {
+            short size = dataIn->readShort();
+            info->getBrokerPath().reserve(size);
+            for (int i = 0; i < size; i++)
+            {
+                info->getBrokerPath().push_back(
+                    std::shared_ptr<BrokerId>(dynamic_cast<BrokerId*>(
+                        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+            }
+        }
+        else
+        {
+            info->getBrokerPath().clear();
+        }
+        info->setBrokerMasterConnector(bs->readBoolean());
+        info->setManageable(bs->readBoolean());
+        if (wireVersion >= 2)
+        {
+            info->setClientMaster(bs->readBoolean());
+        }
+        if (wireVersion >= 6)
+        {
+            info->setFaultTolerant(bs->readBoolean());
+        }
+        if (wireVersion >= 6)
+        {
+            info->setFailoverReconnect(bs->readBoolean());
+        }
+        if (wireVersion >= 8)
+        {
+            info->setClientIp(tightUnmarshalString(dataIn, bs));
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionInfoMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteReader*     dataIn,
+                                              BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        ConnectionInfo* info = dynamic_cast<ConnectionInfo*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
         info->setClientId(tightUnmarshalString(dataIn, bs));
         info->setPassword(tightUnmarshalString(dataIn, bs));
         info->setUserName(tightUnmarshalString(dataIn, bs));
@@ -214,6 +276,56 @@ void ConnectionInfoMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                             DataStructure*  dataStructure,
+                                             ByteWriter*     dataOut,
+                                             BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        ConnectionInfo* info = dynamic_cast<ConnectionInfo*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getConnectionId().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalString2(info->getClientId(), dataOut, bs);
+        tightMarshalString2(info->getPassword(), dataOut, bs);
+        tightMarshalString2(info->getUserName(), dataOut, bs);
+        tightMarshalObjectArray2(wireFormat, info->getBrokerPath(), dataOut, bs);
+        bs->readBoolean();
+        bs->readBoolean();
+        if (wireVersion >= 2)
+        {
+            bs->readBoolean();
+        }
+        if (wireVersion >= 6)
+        {
+            bs->readBoolean();
+        }
+        if (wireVersion >= 6)
+        {
+            bs->readBoolean();
+        }
+        if (wireVersion >= 8)
+        {
+            tightMarshalString2(info->getClientIp(), dataOut, bs);
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConnectionInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                               DataStructure*   dataStructure,
@@ -228,9 +340,68 @@ void ConnectionInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setConnectionId(
-            std::shared_ptr<ConnectionId>(dynamic_cast<ConnectionId*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
+        info->setClientId(looseUnmarshalString(dataIn));
+        info->setPassword(looseUnmarshalString(dataIn));
+        info->setUserName(looseUnmarshalString(dataIn));
+
+        if (dataIn->readBoolean())
+        {
+            short size = dataIn->readShort();
+            info->getBrokerPath().reserve(size);
+            for (int i = 0; i < size; i++)
+            {
+                info->getBrokerPath().push_back(
+                    std::shared_ptr<BrokerId>(dynamic_cast<BrokerId*>(
+                        looseUnmarshalNestedObject(wireFormat, dataIn))));
+            }
+        }
+        else
+        {
+            info->getBrokerPath().clear();
+        }
+        info->setBrokerMasterConnector(dataIn->readBoolean());
+        info->setManageable(dataIn->readBoolean());
+        if (wireVersion >= 2)
+        {
+            info->setClientMaster(dataIn->readBoolean());
+        }
+        if (wireVersion >= 6)
+        {
+            info->setFaultTolerant(dataIn->readBoolean());
+        }
+        if (wireVersion >= 6)
+        {
+            info->setFailoverReconnect(dataIn->readBoolean());
+        }
+        if (wireVersion >= 8)
+        {
+            info->setClientIp(looseUnmarshalString(dataIn));
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        ConnectionInfo* info = dynamic_cast<ConnectionInfo*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
         info->setClientId(looseUnmarshalString(dataIn));
         info->setPassword(looseUnmarshalString(dataIn));
         info->setUserName(looseUnmarshalString(dataIn));
@@ -318,3 +489,47 @@ void ConnectionInfoMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionInfoMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                            DataStructure*  dataStructure,
+                                            ByteWriter*     dataOut)
+{
+    try
+    {
+        ConnectionInfo* info = dynamic_cast<ConnectionInfo*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+
+        int wireVersion = wireFormat->getVersion();
+
+        looseMarshalCachedObject(wireFormat,
+                                 info->getConnectionId().get(),
+                                 dataOut);
+        looseMarshalString(info->getClientId(), dataOut);
+        looseMarshalString(info->getPassword(), dataOut);
+        looseMarshalString(info->getUserName(), dataOut);
+        looseMarshalObjectArray(wireFormat, info->getBrokerPath(), dataOut);
+        dataOut->writeBoolean(info->isBrokerMasterConnector());
+        dataOut->writeBoolean(info->isManageable());
+        if (wireVersion >= 2)
+        {
+            dataOut->writeBoolean(info->isClientMaster());
+        }
+        if (wireVersion >= 6)
+        {
+            dataOut->writeBoolean(info->isFaultTolerant());
+        }
+        if (wireVersion >= 6)
+        {
+            dataOut->writeBoolean(info->isFailoverReconnect());
+        }
+        if (wireVersion >= 8)
+        {
+            looseMarshalString(info->getClientIp(), dataOut);
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
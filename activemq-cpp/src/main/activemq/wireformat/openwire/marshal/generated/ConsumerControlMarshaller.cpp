@@ -71,14 +71,57 @@ void ConsumerControlMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
 
         if (wireVersion >= 6)
         {
-            info->setDestination(std::shared_ptr<ActiveMQDestination>(
-                dynamic_cast<ActiveMQDestination*>(
-                    tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+            info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+                tightUnmarshalInternedNestedObject(wireFormat, dataIn, bs)));
         }
         info->setClose(bs->readBoolean());
-        info->setConsumerId(
-            std::shared_ptr<ConsumerId>(dynamic_cast<ConsumerId*>(
-                tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            tightUnmarshalInternedNestedObject(wireFormat, dataIn, bs)));
+        info->setPrefetch(dataIn->readInt());
+        if (wireVersion >= 2)
+        {
+            info->setFlush(bs->readBoolean());
+        }
+        if (wireVersion >= 2)
+        {
+            info->setStart(bs->readBoolean());
+        }
+        if (wireVersion >= 2)
+        {
+            info->setStop(bs->readBoolean());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerControlMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn,
+                                               BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        ConsumerControl* info = dynamic_cast<ConsumerControl*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 6)
+        {
+            info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+                tightUnmarshalInternedNestedObject(wireFormat, dataIn, bs)));
+        }
+        info->setClose(bs->readBoolean());
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            tightUnmarshalInternedNestedObject(wireFormat, dataIn, bs)));
         info->setPrefetch(dataIn->readInt());
         if (wireVersion >= 2)
         {
@@ -193,6 +236,55 @@ void ConsumerControlMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerControlMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteWriter*     dataOut,
+                                              BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        ConsumerControl* info = dynamic_cast<ConsumerControl*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 6)
+        {
+            tightMarshalNestedObject2(wireFormat,
+                                      info->getDestination().get(),
+                                      dataOut,
+                                      bs);
+        }
+        bs->readBoolean();
+        tightMarshalNestedObject2(wireFormat,
+                                  info->getConsumerId().get(),
+                                  dataOut,
+                                  bs);
+        dataOut->writeInt(info->getPrefetch());
+        if (wireVersion >= 2)
+        {
+            bs->readBoolean();
+        }
+        if (wireVersion >= 2)
+        {
+            bs->readBoolean();
+        }
+        if (wireVersion >= 2)
+        {
+            bs->readBoolean();
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConsumerControlMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                                DataStructure*   dataStructure,
@@ -209,14 +301,54 @@ void ConsumerControlMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
 
         if (wireVersion >= 6)
         {
-            info->setDestination(std::shared_ptr<ActiveMQDestination>(
-                dynamic_cast<ActiveMQDestination*>(
-                    looseUnmarshalNestedObject(wireFormat, dataIn))));
+            info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+                looseUnmarshalInternedNestedObject(wireFormat, dataIn)));
         }
         info->setClose(dataIn->readBoolean());
-        info->setConsumerId(
-            std::shared_ptr<ConsumerId>(dynamic_cast<ConsumerId*>(
-                looseUnmarshalNestedObject(wireFormat, dataIn))));
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            looseUnmarshalInternedNestedObject(wireFormat, dataIn)));
+        info->setPrefetch(dataIn->readInt());
+        if (wireVersion >= 2)
+        {
+            info->setFlush(dataIn->readBoolean());
+        }
+        if (wireVersion >= 2)
+        {
+            info->setStart(dataIn->readBoolean());
+        }
+        if (wireVersion >= 2)
+        {
+            info->setStop(dataIn->readBoolean());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerControlMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        ConsumerControl* info = dynamic_cast<ConsumerControl*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 6)
+        {
+            info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+                looseUnmarshalInternedNestedObject(wireFormat, dataIn)));
+        }
+        info->setClose(dataIn->readBoolean());
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            looseUnmarshalInternedNestedObject(wireFormat, dataIn)));
         info->setPrefetch(dataIn->readInt());
         if (wireVersion >= 2)
         {
@@ -278,3 +410,45 @@ void ConsumerControlMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerControlMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                             DataStructure*  dataStructure,
+                                             ByteWriter*     dataOut)
+{
+    try
+    {
+        ConsumerControl* info = dynamic_cast<ConsumerControl*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 6)
+        {
+            looseMarshalNestedObject(wireFormat,
+                                     info->getDestination().get(),
+                                     dataOut);
+        }
+        dataOut->writeBoolean(info->isClose());
+        looseMarshalNestedObject(wireFormat,
+                                 info->getConsumerId().get(),
+                                 dataOut);
+        dataOut->writeInt(info->getPrefetch());
+        if (wireVersion >= 2)
+        {
+            dataOut->writeBoolean(info->isFlush());
+        }
+        if (wireVersion >= 2)
+        {
+            dataOut->writeBoolean(info->isStart());
+        }
+        if (wireVersion >= 2)
+        {
+            dataOut->writeBoolean(info->isStop());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
@@ -76,6 +76,30 @@ void ConsumerIdMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerIdMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                          DataStructure*  dataStructure,
+                                          ByteReader*     dataIn,
+                                          BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn,
+                                                 bs);
+
+        ConsumerId* info = dynamic_cast<ConsumerId*>(dataStructure);
+        info->setConnectionId(tightUnmarshalString(dataIn, bs));
+        info->setSessionId(tightUnmarshalLong(wireFormat, dataIn, bs));
+        info->setValue(tightUnmarshalLong(wireFormat, dataIn, bs));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int ConsumerIdMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                         DataStructure*  dataStructure,
@@ -124,6 +148,30 @@ void ConsumerIdMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                         DataStructure*  dataStructure,
+                                         ByteWriter*     dataOut,
+                                         BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightMarshal2(wireFormat,
+                                                dataStructure,
+                                                dataOut,
+                                                bs);
+
+        ConsumerId* info = dynamic_cast<ConsumerId*>(dataStructure);
+        tightMarshalString2(info->getConnectionId(), dataOut, bs);
+        tightMarshalLong2(wireFormat, info->getSessionId(), dataOut, bs);
+        tightMarshalLong2(wireFormat, info->getValue(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConsumerIdMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                           DataStructure*   dataStructure,
@@ -145,6 +193,27 @@ void ConsumerIdMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                          DataStructure*  dataStructure,
+                                          ByteReader*     dataIn)
+{
+    try
+    {
+        BaseDataStreamMarshaller::looseUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn);
+        ConsumerId* info = dynamic_cast<ConsumerId*>(dataStructure);
+        info->setConnectionId(looseUnmarshalString(dataIn));
+        info->setSessionId(looseUnmarshalLong(wireFormat, dataIn));
+        info->setValue(looseUnmarshalLong(wireFormat, dataIn));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConsumerIdMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                         DataStructure*    dataStructure,
@@ -165,3 +234,24 @@ void ConsumerIdMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerIdMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                        DataStructure*  dataStructure,
+                                        ByteWriter*     dataOut)
+{
+    try
+    {
+        ConsumerId* info = dynamic_cast<ConsumerId*>(dataStructure);
+        BaseDataStreamMarshaller::looseMarshal(wireFormat,
+                                               dataStructure,
+                                               dataOut);
+        looseMarshalString(info->getConnectionId(), dataOut);
+        looseMarshalLong(wireFormat, info->getSessionId(), dataOut);
+        looseMarshalLong(wireFormat, info->getValue(), dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
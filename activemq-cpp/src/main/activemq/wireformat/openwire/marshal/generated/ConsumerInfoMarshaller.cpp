@@ -69,13 +69,95 @@ void ConsumerInfoMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setConsumerId(
-            std::shared_ptr<ConsumerId>(dynamic_cast<ConsumerId*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
         info->setBrowser(bs->readBoolean());
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setPrefetchSize(dataIn->readInt());
+        info->setMaximumPendingMessageLimit(dataIn->readInt());
+        info->setDispatchAsync(bs->readBoolean());
+        info->setSelector(tightUnmarshalString(dataIn, bs));
+        if (wireVersion >= 10)
+        {
+            info->setClientId(tightUnmarshalString(dataIn, bs));
+        }
+        info->setSubscriptionName(tightUnmarshalString(dataIn, bs));
+        info->setNoLocal(bs->readBoolean());
+        info->setExclusive(bs->readBoolean());
+        info->setRetroactive(bs->readBoolean());
+        info->setPriority(dataIn->readByte());
+
+        if (bs->readBoolean())
+        {
+            short size = dataIn->readShort();
+            info->getBrokerPath().reserve(size);
+            for (int i = 0; i < size; i++)
+            {
+                info->getBrokerPath().push_back(
+                    std::shared_ptr<BrokerId>(dynamic_cast<BrokerId*>(
+                        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+            }
+        }
+        else
+        {
+            info->getBrokerPath().clear();
+        }
+        info->setAdditionalPredicate(
+            std::shared_ptr<BooleanExpression>(dynamic_cast<BooleanExpression*>(
+                tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+        info->setNetworkSubscription(bs->readBoolean());
+        info->setOptimizedAcknowledge(bs->readBoolean());
+        info->setNoRangeAcks(bs->readBoolean());
+        if (wireVersion >= 4)
+        {
+            if (bs->readBoolean())
+            {
+                short size = dataIn->readShort();
+                info->getNetworkConsumerPath().reserve(size);
+                for (int i = 0; i < size; i++)
+                {
+                    info->getNetworkConsumerPath().push_back(
+                        std::shared_ptr<ConsumerId>(dynamic_cast<ConsumerId*>(
+                            tightUnmarshalNestedObject(wireFormat,
+                                                       dataIn,
+                                                       bs))));
+                }
+            }
+            else
+            {
+                info->getNetworkConsumerPath().clear();
+            }
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerInfoMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                            DataStructure*  dataStructure,
+                                            ByteReader*     dataIn,
+                                            BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        ConsumerInfo* info = dynamic_cast<ConsumerInfo*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setBrowser(bs->readBoolean());
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
         info->setPrefetchSize(dataIn->readInt());
         info->setMaximumPendingMessageLimit(dataIn->readInt());
         info->setDispatchAsync(bs->readBoolean());
@@ -252,6 +334,67 @@ void ConsumerInfoMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                           DataStructure*  dataStructure,
+                                           ByteWriter*     dataOut,
+                                           BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        ConsumerInfo* info = dynamic_cast<ConsumerInfo*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getConsumerId().get(),
+                                  dataOut,
+                                  bs);
+        bs->readBoolean();
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getDestination().get(),
+                                  dataOut,
+                                  bs);
+        dataOut->writeInt(info->getPrefetchSize());
+        dataOut->writeInt(info->getMaximumPendingMessageLimit());
+        bs->readBoolean();
+        tightMarshalString2(info->getSelector(), dataOut, bs);
+        if (wireVersion >= 10)
+        {
+            tightMarshalString2(info->getClientId(), dataOut, bs);
+        }
+        tightMarshalString2(info->getSubscriptionName(), dataOut, bs);
+        bs->readBoolean();
+        bs->readBoolean();
+        bs->readBoolean();
+        dataOut->write(info->getPriority());
+        tightMarshalObjectArray2(wireFormat, info->getBrokerPath(), dataOut, bs);
+        tightMarshalNestedObject2(wireFormat,
+                                  info->getAdditionalPredicate().get(),
+                                  dataOut,
+                                  bs);
+        bs->readBoolean();
+        bs->readBoolean();
+        bs->readBoolean();
+        if (wireVersion >= 4)
+        {
+            tightMarshalObjectArray2(wireFormat,
+                                     info->getNetworkConsumerPath(),
+                                     dataOut,
+                                     bs);
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConsumerInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                             DataStructure*   dataStructure,
@@ -266,13 +409,90 @@ void ConsumerInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setConsumerId(
-            std::shared_ptr<ConsumerId>(dynamic_cast<ConsumerId*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
         info->setBrowser(dataIn->readBoolean());
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setPrefetchSize(dataIn->readInt());
+        info->setMaximumPendingMessageLimit(dataIn->readInt());
+        info->setDispatchAsync(dataIn->readBoolean());
+        info->setSelector(looseUnmarshalString(dataIn));
+        if (wireVersion >= 10)
+        {
+            info->setClientId(looseUnmarshalString(dataIn));
+        }
+        info->setSubscriptionName(looseUnmarshalString(dataIn));
+        info->setNoLocal(dataIn->readBoolean());
+        info->setExclusive(dataIn->readBoolean());
+        info->setRetroactive(dataIn->readBoolean());
+        info->setPriority(dataIn->readByte());
+
+        if (dataIn->readBoolean())
+        {
+            short size = dataIn->readShort();
+            info->getBrokerPath().reserve(size);
+            for (int i = 0; i < size; i++)
+            {
+                info->getBrokerPath().push_back(
+                    std::shared_ptr<BrokerId>(dynamic_cast<BrokerId*>(
+                        looseUnmarshalNestedObject(wireFormat, dataIn))));
+            }
+        }
+        else
+        {
+            info->getBrokerPath().clear();
+        }
+        info->setAdditionalPredicate(
+            std::shared_ptr<BooleanExpression>(dynamic_cast<BooleanExpression*>(
+                looseUnmarshalNestedObject(wireFormat, dataIn))));
+        info->setNetworkSubscription(dataIn->readBoolean());
+        info->setOptimizedAcknowledge(dataIn->readBoolean());
+        info->setNoRangeAcks(dataIn->readBoolean());
+        if (wireVersion >= 4)
+        {
+            if (dataIn->readBoolean())
+            {
+                short size = dataIn->readShort();
+                info->getNetworkConsumerPath().reserve(size);
+                for (int i = 0; i < size; i++)
+                {
+                    info->getNetworkConsumerPath().push_back(
+                        std::shared_ptr<ConsumerId>(dynamic_cast<ConsumerId*>(
+                            looseUnmarshalNestedObject(wireFormat, dataIn))));
+                }
+            }
+            else
+            {
+                info->getNetworkConsumerPath().clear();
+            }
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                            DataStructure*  dataStructure,
+                                            ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        ConsumerInfo* info = dynamic_cast<ConsumerInfo*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setBrowser(dataIn->readBoolean());
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
         info->setPrefetchSize(dataIn->readInt());
         info->setMaximumPendingMessageLimit(dataIn->readInt());
         info->setDispatchAsync(dataIn->readBoolean());
@@ -384,3 +604,55 @@ void ConsumerInfoMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerInfoMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                          DataStructure*  dataStructure,
+                                          ByteWriter*     dataOut)
+{
+    try
+    {
+        ConsumerInfo* info = dynamic_cast<ConsumerInfo*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+
+        int wireVersion = wireFormat->getVersion();
+
+        looseMarshalCachedObject(wireFormat,
+                                 info->getConsumerId().get(),
+                                 dataOut);
+        dataOut->writeBoolean(info->isBrowser());
+        looseMarshalCachedObject(wireFormat,
+                                 info->getDestination().get(),
+                                 dataOut);
+        dataOut->writeInt(info->getPrefetchSize());
+        dataOut->writeInt(info->getMaximumPendingMessageLimit());
+        dataOut->writeBoolean(info->isDispatchAsync());
+        looseMarshalString(info->getSelector(), dataOut);
+        if (wireVersion >= 10)
+        {
+            looseMarshalString(info->getClientId(), dataOut);
+        }
+        looseMarshalString(info->getSubscriptionName(), dataOut);
+        dataOut->writeBoolean(info->isNoLocal());
+        dataOut->writeBoolean(info->isExclusive());
+        dataOut->writeBoolean(info->isRetroactive());
+        dataOut->write(info->getPriority());
+        looseMarshalObjectArray(wireFormat, info->getBrokerPath(), dataOut);
+        looseMarshalNestedObject(wireFormat,
+                                 info->getAdditionalPredicate().get(),
+                                 dataOut);
+        dataOut->writeBoolean(info->isNetworkSubscription());
+        dataOut->writeBoolean(info->isOptimizedAcknowledge());
+        dataOut->writeBoolean(info->isNoRangeAcks());
+        if (wireVersion >= 4)
+        {
+            looseMarshalObjectArray(wireFormat,
+                                    info->getNetworkConsumerPath(),
+                                    dataOut);
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
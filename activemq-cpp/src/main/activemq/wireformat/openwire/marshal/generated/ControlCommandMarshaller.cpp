@@ -74,6 +74,28 @@ void ControlCommandMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ControlCommandMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteReader*     dataIn,
+                                              BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        ControlCommand* info = dynamic_cast<ControlCommand*>(dataStructure);
+        info->setCommand(tightUnmarshalString(dataIn, bs));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int ControlCommandMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                             DataStructure*  dataStructure,
@@ -117,6 +139,28 @@ void ControlCommandMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ControlCommandMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                             DataStructure*  dataStructure,
+                                             ByteWriter*     dataOut,
+                                             BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        ControlCommand* info = dynamic_cast<ControlCommand*>(dataStructure);
+        tightMarshalString2(info->getCommand(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ControlCommandMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                               DataStructure*   dataStructure,
@@ -136,6 +180,25 @@ void ControlCommandMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ControlCommandMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        ControlCommand* info = dynamic_cast<ControlCommand*>(dataStructure);
+        info->setCommand(looseUnmarshalString(dataIn));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ControlCommandMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                             DataStructure*    dataStructure,
@@ -152,3 +215,20 @@ void ControlCommandMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ControlCommandMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                            DataStructure*  dataStructure,
+                                            ByteWriter*     dataOut)
+{
+    try
+    {
+        ControlCommand* info = dynamic_cast<ControlCommand*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+        looseMarshalString(info->getCommand(), dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
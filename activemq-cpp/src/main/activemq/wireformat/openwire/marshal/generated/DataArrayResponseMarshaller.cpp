@@ -90,6 +90,44 @@ void DataArrayResponseMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void DataArrayResponseMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                                 DataStructure*  dataStructure,
+                                                 ByteReader*     dataIn,
+                                                 BooleanStream*  bs)
+{
+    try
+    {
+        ResponseMarshaller::tightUnmarshal(wireFormat,
+                                           dataStructure,
+                                           dataIn,
+                                           bs);
+
+        DataArrayResponse* info =
+            dynamic_cast<DataArrayResponse*>(dataStructure);
+
+        if (bs->readBoolean())
+        {
+            short size = dataIn->readShort();
+            info->getData().reserve(size);
+            for (int i = 0; i < size; i++)
+            {
+                info->getData().push_back(
+                    std::shared_ptr<DataStructure>(dynamic_cast<DataStructure*>(
+                        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+            }
+        }
+        else
+        {
+            info->getData().clear();
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int DataArrayResponseMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                                DataStructure*  dataStructure,
@@ -135,6 +173,29 @@ void DataArrayResponseMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void DataArrayResponseMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                                DataStructure*  dataStructure,
+                                                ByteWriter*     dataOut,
+                                                BooleanStream*  bs)
+{
+    try
+    {
+        ResponseMarshaller::tightMarshal2(wireFormat,
+                                          dataStructure,
+                                          dataOut,
+                                          bs);
+
+        DataArrayResponse* info =
+            dynamic_cast<DataArrayResponse*>(dataStructure);
+        tightMarshalObjectArray2(wireFormat, info->getData(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void DataArrayResponseMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                                  DataStructure*   dataStructure,
@@ -168,6 +229,39 @@ void DataArrayResponseMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void DataArrayResponseMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                                 DataStructure*  dataStructure,
+                                                 ByteReader*     dataIn)
+{
+    try
+    {
+        ResponseMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
+        DataArrayResponse* info =
+            dynamic_cast<DataArrayResponse*>(dataStructure);
+
+        if (dataIn->readBoolean())
+        {
+            short size = dataIn->readShort();
+            info->getData().reserve(size);
+            for (int i = 0; i < size; i++)
+            {
+                info->getData().push_back(
+                    std::shared_ptr<DataStructure>(dynamic_cast<DataStructure*>(
+                        looseUnmarshalNestedObject(wireFormat, dataIn))));
+            }
+        }
+        else
+        {
+            info->getData().clear();
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void DataArrayResponseMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                                DataStructure*    dataStructure,
@@ -185,3 +279,21 @@ void DataArrayResponseMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void DataArrayResponseMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteWriter*     dataOut)
+{
+    try
+    {
+        DataArrayResponse* info =
+            dynamic_cast<DataArrayResponse*>(dataStructure);
+        ResponseMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+        looseMarshalObjectArray(wireFormat, info->getData(), dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
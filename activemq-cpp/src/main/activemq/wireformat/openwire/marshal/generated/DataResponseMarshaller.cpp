@@ -76,6 +76,30 @@ void DataResponseMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void DataResponseMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                            DataStructure*  dataStructure,
+                                            ByteReader*     dataIn,
+                                            BooleanStream*  bs)
+{
+    try
+    {
+        ResponseMarshaller::tightUnmarshal(wireFormat,
+                                           dataStructure,
+                                           dataIn,
+                                           bs);
+
+        DataResponse* info = dynamic_cast<DataResponse*>(dataStructure);
+        info->setData(
+            std::shared_ptr<DataStructure>(dynamic_cast<DataStructure*>(
+                tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int DataResponseMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                           DataStructure*  dataStructure,
@@ -122,6 +146,31 @@ void DataResponseMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void DataResponseMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                           DataStructure*  dataStructure,
+                                           ByteWriter*     dataOut,
+                                           BooleanStream*  bs)
+{
+    try
+    {
+        ResponseMarshaller::tightMarshal2(wireFormat,
+                                          dataStructure,
+                                          dataOut,
+                                          bs);
+
+        DataResponse* info = dynamic_cast<DataResponse*>(dataStructure);
+        tightMarshalNestedObject2(wireFormat,
+                                  info->getData().get(),
+                                  dataOut,
+                                  bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void DataResponseMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                             DataStructure*   dataStructure,
@@ -141,6 +190,25 @@ void DataResponseMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void DataResponseMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                            DataStructure*  dataStructure,
+                                            ByteReader*     dataIn)
+{
+    try
+    {
+        ResponseMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
+        DataResponse* info = dynamic_cast<DataResponse*>(dataStructure);
+        info->setData(
+            std::shared_ptr<DataStructure>(dynamic_cast<DataStructure*>(
+                looseUnmarshalNestedObject(wireFormat, dataIn))));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void DataResponseMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                           DataStructure*    dataStructure,
@@ -157,3 +225,20 @@ void DataResponseMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void DataResponseMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                          DataStructure*  dataStructure,
+                                          ByteWriter*     dataOut)
+{
+    try
+    {
+        DataResponse* info = dynamic_cast<DataResponse*>(dataStructure);
+        ResponseMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+        looseMarshalNestedObject(wireFormat, info->getData().get(), dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
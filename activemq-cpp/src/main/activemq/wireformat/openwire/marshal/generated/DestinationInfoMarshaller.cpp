@@ -66,12 +66,53 @@ void DestinationInfoMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
                                               bs);
 
         DestinationInfo* info = dynamic_cast<DestinationInfo*>(dataStructure);
-        info->setConnectionId(
-            std::shared_ptr<ConnectionId>(dynamic_cast<ConnectionId*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setOperationType(dataIn->readByte());
+        info->setTimeout(tightUnmarshalLong(wireFormat, dataIn, bs));
+
+        if (bs->readBoolean())
+        {
+            short size = dataIn->readShort();
+            info->getBrokerPath().reserve(size);
+            for (int i = 0; i < size; i++)
+            {
+                info->getBrokerPath().push_back(
+                    std::shared_ptr<BrokerId>(dynamic_cast<BrokerId*>(
+                        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+            }
+        }
+        else
+        {
+            info->getBrokerPath().clear();
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void DestinationInfoMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn,
+                                               BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        DestinationInfo* info = dynamic_cast<DestinationInfo*>(dataStructure);
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
         info->setOperationType(dataIn->readByte());
         info->setTimeout(tightUnmarshalLong(wireFormat, dataIn, bs));
 
@@ -157,6 +198,38 @@ void DestinationInfoMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void DestinationInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteWriter*     dataOut,
+                                              BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        DestinationInfo* info = dynamic_cast<DestinationInfo*>(dataStructure);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getConnectionId().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getDestination().get(),
+                                  dataOut,
+                                  bs);
+        dataOut->write(info->getOperationType());
+        tightMarshalLong2(wireFormat, info->getTimeout(), dataOut, bs);
+        tightMarshalObjectArray2(wireFormat, info->getBrokerPath(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void DestinationInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                                DataStructure*   dataStructure,
@@ -168,12 +241,50 @@ void DestinationInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                               dataStructure,
                                               dataIn);
         DestinationInfo* info = dynamic_cast<DestinationInfo*>(dataStructure);
-        info->setConnectionId(
-            std::shared_ptr<ConnectionId>(dynamic_cast<ConnectionId*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setOperationType(dataIn->readByte());
+        info->setTimeout(looseUnmarshalLong(wireFormat, dataIn));
+
+        if (dataIn->readBoolean())
+        {
+            short size = dataIn->readShort();
+            info->getBrokerPath().reserve(size);
+            for (int i = 0; i < size; i++)
+            {
+                info->getBrokerPath().push_back(
+                    std::shared_ptr<BrokerId>(dynamic_cast<BrokerId*>(
+                        looseUnmarshalNestedObject(wireFormat, dataIn))));
+            }
+        }
+        else
+        {
+            info->getBrokerPath().clear();
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void DestinationInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        DestinationInfo* info = dynamic_cast<DestinationInfo*>(dataStructure);
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
         info->setOperationType(dataIn->readByte());
         info->setTimeout(looseUnmarshalLong(wireFormat, dataIn));
 
@@ -223,3 +334,28 @@ void DestinationInfoMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void DestinationInfoMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                             DataStructure*  dataStructure,
+                                             ByteWriter*     dataOut)
+{
+    try
+    {
+        DestinationInfo* info = dynamic_cast<DestinationInfo*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getConnectionId().get(),
+                                 dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getDestination().get(),
+                                 dataOut);
+        dataOut->write(info->getOperationType());
+        looseMarshalLong(wireFormat, info->getTimeout(), dataOut);
+        looseMarshalObjectArray(wireFormat, info->getBrokerPath(), dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
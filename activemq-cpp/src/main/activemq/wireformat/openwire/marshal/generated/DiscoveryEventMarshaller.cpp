@@ -75,6 +75,29 @@ void DiscoveryEventMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void DiscoveryEventMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteReader*     dataIn,
+                                              BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn,
+                                                 bs);
+
+        DiscoveryEvent* info = dynamic_cast<DiscoveryEvent*>(dataStructure);
+        info->setServiceName(tightUnmarshalString(dataIn, bs));
+        info->setBrokerName(tightUnmarshalString(dataIn, bs));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int DiscoveryEventMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                             DataStructure*  dataStructure,
@@ -121,6 +144,29 @@ void DiscoveryEventMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void DiscoveryEventMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                             DataStructure*  dataStructure,
+                                             ByteWriter*     dataOut,
+                                             BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightMarshal2(wireFormat,
+                                                dataStructure,
+                                                dataOut,
+                                                bs);
+
+        DiscoveryEvent* info = dynamic_cast<DiscoveryEvent*>(dataStructure);
+        tightMarshalString2(info->getServiceName(), dataOut, bs);
+        tightMarshalString2(info->getBrokerName(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void DiscoveryEventMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                               DataStructure*   dataStructure,
@@ -141,6 +187,26 @@ void DiscoveryEventMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void DiscoveryEventMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteReader*     dataIn)
+{
+    try
+    {
+        BaseDataStreamMarshaller::looseUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn);
+        DiscoveryEvent* info = dynamic_cast<DiscoveryEvent*>(dataStructure);
+        info->setServiceName(looseUnmarshalString(dataIn));
+        info->setBrokerName(looseUnmarshalString(dataIn));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void DiscoveryEventMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                             DataStructure*    dataStructure,
@@ -160,3 +226,23 @@ void DiscoveryEventMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void DiscoveryEventMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                            DataStructure*  dataStructure,
+                                            ByteWriter*     dataOut)
+{
+    try
+    {
+        DiscoveryEvent* info = dynamic_cast<DiscoveryEvent*>(dataStructure);
+        BaseDataStreamMarshaller::looseMarshal(wireFormat,
+                                               dataStructure,
+                                               dataOut);
+        looseMarshalString(info->getServiceName(), dataOut);
+        looseMarshalString(info->getBrokerName(), dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
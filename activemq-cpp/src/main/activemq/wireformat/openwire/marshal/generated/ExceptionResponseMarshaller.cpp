@@ -77,6 +77,31 @@ void ExceptionResponseMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ExceptionResponseMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                                 DataStructure*  dataStructure,
+                                                 ByteReader*     dataIn,
+                                                 BooleanStream*  bs)
+{
+    try
+    {
+        ResponseMarshaller::tightUnmarshal(wireFormat,
+                                           dataStructure,
+                                           dataIn,
+                                           bs);
+
+        ExceptionResponse* info =
+            dynamic_cast<ExceptionResponse*>(dataStructure);
+        info->setException(
+            std::shared_ptr<BrokerError>(dynamic_cast<BrokerError*>(
+                tightUnmarshalBrokerError(wireFormat, dataIn, bs))));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int ExceptionResponseMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                                DataStructure*  dataStructure,
@@ -127,6 +152,32 @@ void ExceptionResponseMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ExceptionResponseMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                                DataStructure*  dataStructure,
+                                                ByteWriter*     dataOut,
+                                                BooleanStream*  bs)
+{
+    try
+    {
+        ResponseMarshaller::tightMarshal2(wireFormat,
+                                          dataStructure,
+                                          dataOut,
+                                          bs);
+
+        ExceptionResponse* info =
+            dynamic_cast<ExceptionResponse*>(dataStructure);
+        tightMarshalBrokerError2(wireFormat,
+                                 info->getException().get(),
+                                 dataOut,
+                                 bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ExceptionResponseMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                                  DataStructure*   dataStructure,
@@ -147,6 +198,26 @@ void ExceptionResponseMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ExceptionResponseMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                                 DataStructure*  dataStructure,
+                                                 ByteReader*     dataIn)
+{
+    try
+    {
+        ResponseMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
+        ExceptionResponse* info =
+            dynamic_cast<ExceptionResponse*>(dataStructure);
+        info->setException(
+            std::shared_ptr<BrokerError>(dynamic_cast<BrokerError*>(
+                looseUnmarshalBrokerError(wireFormat, dataIn))));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ExceptionResponseMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                                DataStructure*    dataStructure,
@@ -166,3 +237,23 @@ void ExceptionResponseMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ExceptionResponseMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteWriter*     dataOut)
+{
+    try
+    {
+        ExceptionResponse* info =
+            dynamic_cast<ExceptionResponse*>(dataStructure);
+        ResponseMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+        looseMarshalBrokerError(wireFormat,
+                                info->getException().get(),
+                                dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
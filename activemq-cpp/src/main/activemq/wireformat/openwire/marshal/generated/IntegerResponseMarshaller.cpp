@@ -74,6 +74,28 @@ void IntegerResponseMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void IntegerResponseMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn,
+                                               BooleanStream*  bs)
+{
+    try
+    {
+        ResponseMarshaller::tightUnmarshal(wireFormat,
+                                           dataStructure,
+                                           dataIn,
+                                           bs);
+
+        IntegerResponse* info = dynamic_cast<IntegerResponse*>(dataStructure);
+        info->setResult(dataIn->readInt());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int IntegerResponseMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                              DataStructure*  dataStructure,
@@ -114,6 +136,28 @@ void IntegerResponseMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void IntegerResponseMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteWriter*     dataOut,
+                                              BooleanStream*  bs)
+{
+    try
+    {
+        ResponseMarshaller::tightMarshal2(wireFormat,
+                                          dataStructure,
+                                          dataOut,
+                                          bs);
+
+        IntegerResponse* info = dynamic_cast<IntegerResponse*>(dataStructure);
+        dataOut->writeInt(info->getResult());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void IntegerResponseMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                                DataStructure*   dataStructure,
@@ -131,6 +175,23 @@ void IntegerResponseMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void IntegerResponseMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn)
+{
+    try
+    {
+        ResponseMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
+        IntegerResponse* info = dynamic_cast<IntegerResponse*>(dataStructure);
+        info->setResult(dataIn->readInt());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void IntegerResponseMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                              DataStructure*    dataStructure,
@@ -147,3 +208,20 @@ void IntegerResponseMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void IntegerResponseMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                             DataStructure*  dataStructure,
+                                             ByteWriter*     dataOut)
+{
+    try
+    {
+        IntegerResponse* info = dynamic_cast<IntegerResponse*>(dataStructure);
+        ResponseMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+        dataOut->writeInt(info->getResult());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
@@ -66,9 +66,34 @@ void JournalQueueAckMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
                                                  bs);
 
         JournalQueueAck* info = dynamic_cast<JournalQueueAck*>(dataStructure);
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedNestedObject(wireFormat, dataIn, bs)));
+        info->setMessageAck(
+            std::shared_ptr<MessageAck>(dynamic_cast<MessageAck*>(
                 tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void JournalQueueAckMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn,
+                                               BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn,
+                                                 bs);
+
+        JournalQueueAck* info = dynamic_cast<JournalQueueAck*>(dataStructure);
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedNestedObject(wireFormat, dataIn, bs)));
         info->setMessageAck(
             std::shared_ptr<MessageAck>(dynamic_cast<MessageAck*>(
                 tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
@@ -135,6 +160,35 @@ void JournalQueueAckMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void JournalQueueAckMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteWriter*     dataOut,
+                                              BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightMarshal2(wireFormat,
+                                                dataStructure,
+                                                dataOut,
+                                                bs);
+
+        JournalQueueAck* info = dynamic_cast<JournalQueueAck*>(dataStructure);
+        tightMarshalNestedObject2(wireFormat,
+                                  info->getDestination().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalNestedObject2(wireFormat,
+                                  info->getMessageAck().get(),
+                                  dataOut,
+                                  bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void JournalQueueAckMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                                DataStructure*   dataStructure,
@@ -146,9 +200,31 @@ void JournalQueueAckMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                                  dataStructure,
                                                  dataIn);
         JournalQueueAck* info = dynamic_cast<JournalQueueAck*>(dataStructure);
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedNestedObject(wireFormat, dataIn)));
+        info->setMessageAck(
+            std::shared_ptr<MessageAck>(dynamic_cast<MessageAck*>(
                 looseUnmarshalNestedObject(wireFormat, dataIn))));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void JournalQueueAckMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn)
+{
+    try
+    {
+        BaseDataStreamMarshaller::looseUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn);
+        JournalQueueAck* info = dynamic_cast<JournalQueueAck*>(dataStructure);
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedNestedObject(wireFormat, dataIn)));
         info->setMessageAck(
             std::shared_ptr<MessageAck>(dynamic_cast<MessageAck*>(
                 looseUnmarshalNestedObject(wireFormat, dataIn))));
@@ -182,3 +258,27 @@ void JournalQueueAckMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void JournalQueueAckMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                             DataStructure*  dataStructure,
+                                             ByteWriter*     dataOut)
+{
+    try
+    {
+        JournalQueueAck* info = dynamic_cast<JournalQueueAck*>(dataStructure);
+        BaseDataStreamMarshaller::looseMarshal(wireFormat,
+                                               dataStructure,
+                                               dataOut);
+        looseMarshalNestedObject(wireFormat,
+                                 info->getDestination().get(),
+                                 dataOut);
+        looseMarshalNestedObject(wireFormat,
+                                 info->getMessageAck().get(),
+                                 dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
@@ -66,9 +66,39 @@ void JournalTopicAckMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
                                                  bs);
 
         JournalTopicAck* info = dynamic_cast<JournalTopicAck*>(dataStructure);
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedNestedObject(wireFormat, dataIn, bs)));
+        info->setMessageId(std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
+            tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+        info->setMessageSequenceId(tightUnmarshalLong(wireFormat, dataIn, bs));
+        info->setSubscritionName(tightUnmarshalString(dataIn, bs));
+        info->setClientId(tightUnmarshalString(dataIn, bs));
+        info->setTransactionId(
+            std::shared_ptr<TransactionId>(dynamic_cast<TransactionId*>(
                 tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void JournalTopicAckMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn,
+                                               BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn,
+                                                 bs);
+
+        JournalTopicAck* info = dynamic_cast<JournalTopicAck*>(dataStructure);
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedNestedObject(wireFormat, dataIn, bs)));
         info->setMessageId(std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
             tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
         info->setMessageSequenceId(tightUnmarshalLong(wireFormat, dataIn, bs));
@@ -153,6 +183,42 @@ void JournalTopicAckMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void JournalTopicAckMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteWriter*     dataOut,
+                                              BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightMarshal2(wireFormat,
+                                                dataStructure,
+                                                dataOut,
+                                                bs);
+
+        JournalTopicAck* info = dynamic_cast<JournalTopicAck*>(dataStructure);
+        tightMarshalNestedObject2(wireFormat,
+                                  info->getDestination().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalNestedObject2(wireFormat,
+                                  info->getMessageId().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalLong2(wireFormat, info->getMessageSequenceId(), dataOut, bs);
+        tightMarshalString2(info->getSubscritionName(), dataOut, bs);
+        tightMarshalString2(info->getClientId(), dataOut, bs);
+        tightMarshalNestedObject2(wireFormat,
+                                  info->getTransactionId().get(),
+                                  dataOut,
+                                  bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void JournalTopicAckMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                                DataStructure*   dataStructure,
@@ -164,9 +230,36 @@ void JournalTopicAckMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                                  dataStructure,
                                                  dataIn);
         JournalTopicAck* info = dynamic_cast<JournalTopicAck*>(dataStructure);
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedNestedObject(wireFormat, dataIn)));
+        info->setMessageId(std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
+            looseUnmarshalNestedObject(wireFormat, dataIn))));
+        info->setMessageSequenceId(looseUnmarshalLong(wireFormat, dataIn));
+        info->setSubscritionName(looseUnmarshalString(dataIn));
+        info->setClientId(looseUnmarshalString(dataIn));
+        info->setTransactionId(
+            std::shared_ptr<TransactionId>(dynamic_cast<TransactionId*>(
                 looseUnmarshalNestedObject(wireFormat, dataIn))));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void JournalTopicAckMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn)
+{
+    try
+    {
+        BaseDataStreamMarshaller::looseUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn);
+        JournalTopicAck* info = dynamic_cast<JournalTopicAck*>(dataStructure);
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedNestedObject(wireFormat, dataIn)));
         info->setMessageId(std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
             looseUnmarshalNestedObject(wireFormat, dataIn))));
         info->setMessageSequenceId(looseUnmarshalLong(wireFormat, dataIn));
@@ -211,3 +304,33 @@ void JournalTopicAckMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void JournalTopicAckMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                             DataStructure*  dataStructure,
+                                             ByteWriter*     dataOut)
+{
+    try
+    {
+        JournalTopicAck* info = dynamic_cast<JournalTopicAck*>(dataStructure);
+        BaseDataStreamMarshaller::looseMarshal(wireFormat,
+                                               dataStructure,
+                                               dataOut);
+        looseMarshalNestedObject(wireFormat,
+                                 info->getDestination().get(),
+                                 dataOut);
+        looseMarshalNestedObject(wireFormat,
+                                 info->getMessageId().get(),
+                                 dataOut);
+        looseMarshalLong(wireFormat, info->getMessageSequenceId(), dataOut);
+        looseMarshalString(info->getSubscritionName(), dataOut);
+        looseMarshalString(info->getClientId(), dataOut);
+        looseMarshalNestedObject(wireFormat,
+                                 info->getTransactionId().get(),
+                                 dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
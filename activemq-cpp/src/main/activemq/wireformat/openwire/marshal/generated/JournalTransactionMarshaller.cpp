@@ -79,6 +79,33 @@ void JournalTransactionMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void JournalTransactionMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                                  DataStructure*  dataStructure,
+                                                  ByteReader*     dataIn,
+                                                  BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn,
+                                                 bs);
+
+        JournalTransaction* info =
+            dynamic_cast<JournalTransaction*>(dataStructure);
+        info->setTransactionId(
+            std::shared_ptr<TransactionId>(dynamic_cast<TransactionId*>(
+                tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+        info->setType(dataIn->readByte());
+        info->setWasPrepared(bs->readBoolean());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int JournalTransactionMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                                 DataStructure*  dataStructure,
@@ -133,6 +160,34 @@ void JournalTransactionMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void JournalTransactionMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                                 DataStructure*  dataStructure,
+                                                 ByteWriter*     dataOut,
+                                                 BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightMarshal2(wireFormat,
+                                                dataStructure,
+                                                dataOut,
+                                                bs);
+
+        JournalTransaction* info =
+            dynamic_cast<JournalTransaction*>(dataStructure);
+        tightMarshalNestedObject2(wireFormat,
+                                  info->getTransactionId().get(),
+                                  dataOut,
+                                  bs);
+        dataOut->write(info->getType());
+        bs->readBoolean();
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void JournalTransactionMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
                                                   DataStructure*  dataStructure,
@@ -157,6 +212,30 @@ void JournalTransactionMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void JournalTransactionMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                                  DataStructure*  dataStructure,
+                                                  ByteReader*     dataIn)
+{
+    try
+    {
+        BaseDataStreamMarshaller::looseUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn);
+        JournalTransaction* info =
+            dynamic_cast<JournalTransaction*>(dataStructure);
+        info->setTransactionId(
+            std::shared_ptr<TransactionId>(dynamic_cast<TransactionId*>(
+                looseUnmarshalNestedObject(wireFormat, dataIn))));
+        info->setType(dataIn->readByte());
+        info->setWasPrepared(dataIn->readBoolean());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void JournalTransactionMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                                 DataStructure*    dataStructure,
@@ -180,3 +259,27 @@ void JournalTransactionMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void JournalTransactionMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                                DataStructure*  dataStructure,
+                                                ByteWriter*     dataOut)
+{
+    try
+    {
+        JournalTransaction* info =
+            dynamic_cast<JournalTransaction*>(dataStructure);
+        BaseDataStreamMarshaller::looseMarshal(wireFormat,
+                                               dataStructure,
+                                               dataOut);
+        looseMarshalNestedObject(wireFormat,
+                                 info->getTransactionId().get(),
+                                 dataOut);
+        dataOut->write(info->getType());
+        dataOut->writeBoolean(info->getWasPrepared());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
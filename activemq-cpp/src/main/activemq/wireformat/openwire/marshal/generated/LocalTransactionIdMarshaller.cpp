@@ -68,9 +68,33 @@ void LocalTransactionIdMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
         LocalTransactionId* info =
             dynamic_cast<LocalTransactionId*>(dataStructure);
         info->setValue(tightUnmarshalLong(wireFormat, dataIn, bs));
-        info->setConnectionId(
-            std::shared_ptr<ConnectionId>(dynamic_cast<ConnectionId*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void LocalTransactionIdMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                                  DataStructure*  dataStructure,
+                                                  ByteReader*     dataIn,
+                                                  BooleanStream*  bs)
+{
+    try
+    {
+        TransactionIdMarshaller::tightUnmarshal(wireFormat,
+                                                dataStructure,
+                                                dataIn,
+                                                bs);
+
+        LocalTransactionId* info =
+            dynamic_cast<LocalTransactionId*>(dataStructure);
+        info->setValue(tightUnmarshalLong(wireFormat, dataIn, bs));
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
@@ -131,6 +155,33 @@ void LocalTransactionIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void LocalTransactionIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                                 DataStructure*  dataStructure,
+                                                 ByteWriter*     dataOut,
+                                                 BooleanStream*  bs)
+{
+    try
+    {
+        TransactionIdMarshaller::tightMarshal2(wireFormat,
+                                               dataStructure,
+                                               dataOut,
+                                               bs);
+
+        LocalTransactionId* info =
+            dynamic_cast<LocalTransactionId*>(dataStructure);
+        tightMarshalLong2(wireFormat, info->getValue(), dataOut, bs);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getConnectionId().get(),
+                                  dataOut,
+                                  bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void LocalTransactionIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
                                                   DataStructure*  dataStructure,
@@ -144,9 +195,30 @@ void LocalTransactionIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
         LocalTransactionId* info =
             dynamic_cast<LocalTransactionId*>(dataStructure);
         info->setValue(looseUnmarshalLong(wireFormat, dataIn));
-        info->setConnectionId(
-            std::shared_ptr<ConnectionId>(dynamic_cast<ConnectionId*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void LocalTransactionIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                                  DataStructure*  dataStructure,
+                                                  ByteReader*     dataIn)
+{
+    try
+    {
+        TransactionIdMarshaller::looseUnmarshal(wireFormat,
+                                                dataStructure,
+                                                dataIn);
+        LocalTransactionId* info =
+            dynamic_cast<LocalTransactionId*>(dataStructure);
+        info->setValue(looseUnmarshalLong(wireFormat, dataIn));
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
@@ -176,3 +248,26 @@ void LocalTransactionIdMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void LocalTransactionIdMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                                DataStructure*  dataStructure,
+                                                ByteWriter*     dataOut)
+{
+    try
+    {
+        LocalTransactionId* info =
+            dynamic_cast<LocalTransactionId*>(dataStructure);
+        TransactionIdMarshaller::looseMarshal(wireFormat,
+                                              dataStructure,
+                                              dataOut);
+        looseMarshalLong(wireFormat, info->getValue(), dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getConnectionId().get(),
+                                 dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
@@ -69,15 +69,56 @@ void MessageAckMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
-        info->setTransactionId(
-            std::shared_ptr<TransactionId>(dynamic_cast<TransactionId*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
-        info->setConsumerId(
-            std::shared_ptr<ConsumerId>(dynamic_cast<ConsumerId*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setTransactionId(std::dynamic_pointer_cast<TransactionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setAckType(dataIn->readByte());
+        info->setFirstMessageId(
+            std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
+                tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+        info->setLastMessageId(
+            std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
+                tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+        info->setMessageCount(dataIn->readInt());
+        if (wireVersion >= 7)
+        {
+            info->setPoisonCause(
+                std::shared_ptr<BrokerError>(dynamic_cast<BrokerError*>(
+                    tightUnmarshalBrokerError(wireFormat, dataIn, bs))));
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageAckMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                          DataStructure*  dataStructure,
+                                          ByteReader*     dataIn,
+                                          BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        MessageAck* info = dynamic_cast<MessageAck*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setTransactionId(std::dynamic_pointer_cast<TransactionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
         info->setAckType(dataIn->readByte());
         info->setFirstMessageId(
             std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
@@ -196,6 +237,59 @@ void MessageAckMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void MessageAckMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                         DataStructure*  dataStructure,
+                                         ByteWriter*     dataOut,
+                                         BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        MessageAck* info = dynamic_cast<MessageAck*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getDestination().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getTransactionId().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getConsumerId().get(),
+                                  dataOut,
+                                  bs);
+        dataOut->write(info->getAckType());
+        tightMarshalNestedObject2(wireFormat,
+                                  info->getFirstMessageId().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalNestedObject2(wireFormat,
+                                  info->getLastMessageId().get(),
+                                  dataOut,
+                                  bs);
+        dataOut->writeInt(info->getMessageCount());
+        if (wireVersion >= 7)
+        {
+            tightMarshalBrokerError2(wireFormat,
+                                     info->getPoisonCause().get(),
+                                     dataOut,
+                                     bs);
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void MessageAckMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                           DataStructure*   dataStructure,
@@ -210,15 +304,53 @@ void MessageAckMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
-        info->setTransactionId(
-            std::shared_ptr<TransactionId>(dynamic_cast<TransactionId*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
-        info->setConsumerId(
-            std::shared_ptr<ConsumerId>(dynamic_cast<ConsumerId*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setTransactionId(std::dynamic_pointer_cast<TransactionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setAckType(dataIn->readByte());
+        info->setFirstMessageId(
+            std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
+                looseUnmarshalNestedObject(wireFormat, dataIn))));
+        info->setLastMessageId(
+            std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
+                looseUnmarshalNestedObject(wireFormat, dataIn))));
+        info->setMessageCount(dataIn->readInt());
+        if (wireVersion >= 7)
+        {
+            info->setPoisonCause(
+                std::shared_ptr<BrokerError>(dynamic_cast<BrokerError*>(
+                    looseUnmarshalBrokerError(wireFormat, dataIn))));
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageAckMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                          DataStructure*  dataStructure,
+                                          ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        MessageAck* info = dynamic_cast<MessageAck*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setTransactionId(std::dynamic_pointer_cast<TransactionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
         info->setAckType(dataIn->readByte());
         info->setFirstMessageId(
             std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
@@ -281,3 +413,45 @@ void MessageAckMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageAckMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                        DataStructure*  dataStructure,
+                                        ByteWriter*     dataOut)
+{
+    try
+    {
+        MessageAck* info = dynamic_cast<MessageAck*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+
+        int wireVersion = wireFormat->getVersion();
+
+        looseMarshalCachedObject(wireFormat,
+                                 info->getDestination().get(),
+                                 dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getTransactionId().get(),
+                                 dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getConsumerId().get(),
+                                 dataOut);
+        dataOut->write(info->getAckType());
+        looseMarshalNestedObject(wireFormat,
+                                 info->getFirstMessageId().get(),
+                                 dataOut);
+        looseMarshalNestedObject(wireFormat,
+                                 info->getLastMessageId().get(),
+                                 dataOut);
+        dataOut->writeInt(info->getMessageCount());
+        if (wireVersion >= 7)
+        {
+            looseMarshalBrokerError(wireFormat,
+                                    info->getPoisonCause().get(),
+                                    dataOut);
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
@@ -69,12 +69,39 @@ void MessageDispatchMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
 
         MessageDispatch* info = dynamic_cast<MessageDispatch*>(dataStructure);
 
-        info->setConsumerId(
-            std::shared_ptr<ConsumerId>(dynamic_cast<ConsumerId*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setMessage(std::shared_ptr<Message>(dynamic_cast<Message*>(
+            tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+        info->setRedeliveryCounter(dataIn->readInt());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageDispatchMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn,
+                                               BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        MessageDispatch* info = dynamic_cast<MessageDispatch*>(dataStructure);
+
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
         info->setMessage(std::shared_ptr<Message>(dynamic_cast<Message*>(
             tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
         info->setRedeliveryCounter(dataIn->readInt());
@@ -147,6 +174,40 @@ void MessageDispatchMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void MessageDispatchMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteWriter*     dataOut,
+                                              BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        MessageDispatch* info = dynamic_cast<MessageDispatch*>(dataStructure);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getConsumerId().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getDestination().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalNestedObject2(wireFormat,
+                                  info->getMessage().get(),
+                                  dataOut,
+                                  bs);
+        dataOut->writeInt(info->getRedeliveryCounter());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void MessageDispatchMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                                DataStructure*   dataStructure,
@@ -158,12 +219,35 @@ void MessageDispatchMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                               dataStructure,
                                               dataIn);
         MessageDispatch* info = dynamic_cast<MessageDispatch*>(dataStructure);
-        info->setConsumerId(
-            std::shared_ptr<ConsumerId>(dynamic_cast<ConsumerId*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setMessage(std::shared_ptr<Message>(dynamic_cast<Message*>(
+            looseUnmarshalNestedObject(wireFormat, dataIn))));
+        info->setRedeliveryCounter(dataIn->readInt());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageDispatchMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        MessageDispatch* info = dynamic_cast<MessageDispatch*>(dataStructure);
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
         info->setMessage(std::shared_ptr<Message>(dynamic_cast<Message*>(
             looseUnmarshalNestedObject(wireFormat, dataIn))));
         info->setRedeliveryCounter(dataIn->readInt());
@@ -197,3 +281,27 @@ void MessageDispatchMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageDispatchMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                             DataStructure*  dataStructure,
+                                             ByteWriter*     dataOut)
+{
+    try
+    {
+        MessageDispatch* info = dynamic_cast<MessageDispatch*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getConsumerId().get(),
+                                 dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getDestination().get(),
+                                 dataOut);
+        looseMarshalNestedObject(wireFormat, info->getMessage().get(), dataOut);
+        dataOut->writeInt(info->getRedeliveryCounter());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
@@ -68,12 +68,40 @@ void MessageDispatchNotificationMarshaller::tightUnmarshal(
 
         MessageDispatchNotification* info =
             dynamic_cast<MessageDispatchNotification*>(dataStructure);
-        info->setConsumerId(
-            std::shared_ptr<ConsumerId>(dynamic_cast<ConsumerId*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setDeliverySequenceId(tightUnmarshalLong(wireFormat, dataIn, bs));
+        info->setMessageId(std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
+            tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageDispatchNotificationMarshaller::tightUnmarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteReader*     dataIn,
+    BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        MessageDispatchNotification* info =
+            dynamic_cast<MessageDispatchNotification*>(dataStructure);
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
         info->setDeliverySequenceId(tightUnmarshalLong(wireFormat, dataIn, bs));
         info->setMessageId(std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
             tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
@@ -155,6 +183,45 @@ void MessageDispatchNotificationMarshaller::tightMarshal2(
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void MessageDispatchNotificationMarshaller::tightMarshal2(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteWriter*     dataOut,
+    BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        MessageDispatchNotification* info =
+            dynamic_cast<MessageDispatchNotification*>(dataStructure);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getConsumerId().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getDestination().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalLong2(wireFormat,
+                          info->getDeliverySequenceId(),
+                          dataOut,
+                          bs);
+        tightMarshalNestedObject2(wireFormat,
+                                  info->getMessageId().get(),
+                                  dataOut,
+                                  bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void MessageDispatchNotificationMarshaller::looseUnmarshal(
     OpenWireFormat*  wireFormat,
@@ -168,12 +235,37 @@ void MessageDispatchNotificationMarshaller::looseUnmarshal(
                                               dataIn);
         MessageDispatchNotification* info =
             dynamic_cast<MessageDispatchNotification*>(dataStructure);
-        info->setConsumerId(
-            std::shared_ptr<ConsumerId>(dynamic_cast<ConsumerId*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setDeliverySequenceId(looseUnmarshalLong(wireFormat, dataIn));
+        info->setMessageId(std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
+            looseUnmarshalNestedObject(wireFormat, dataIn))));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageDispatchNotificationMarshaller::looseUnmarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        MessageDispatchNotification* info =
+            dynamic_cast<MessageDispatchNotification*>(dataStructure);
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
         info->setDeliverySequenceId(looseUnmarshalLong(wireFormat, dataIn));
         info->setMessageId(std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
             looseUnmarshalNestedObject(wireFormat, dataIn))));
@@ -211,3 +303,31 @@ void MessageDispatchNotificationMarshaller::looseMarshal(
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageDispatchNotificationMarshaller::looseMarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteWriter*     dataOut)
+{
+    try
+    {
+        MessageDispatchNotification* info =
+            dynamic_cast<MessageDispatchNotification*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getConsumerId().get(),
+                                 dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getDestination().get(),
+                                 dataOut);
+        looseMarshalLong(wireFormat, info->getDeliverySequenceId(), dataOut);
+        looseMarshalNestedObject(wireFormat,
+                                 info->getMessageId().get(),
+                                 dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
@@ -73,9 +73,40 @@ void MessageIdMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
         {
             info->setTextView(tightUnmarshalString(dataIn, bs));
         }
-        info->setProducerId(
-            std::shared_ptr<ProducerId>(dynamic_cast<ProducerId*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setProducerId(std::dynamic_pointer_cast<ProducerId>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setProducerSequenceId(tightUnmarshalLong(wireFormat, dataIn, bs));
+        info->setBrokerSequenceId(tightUnmarshalLong(wireFormat, dataIn, bs));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageIdMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                         DataStructure*  dataStructure,
+                                         ByteReader*     dataIn,
+                                         BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn,
+                                                 bs);
+
+        MessageId* info = dynamic_cast<MessageId*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 10)
+        {
+            info->setTextView(tightUnmarshalString(dataIn, bs));
+        }
+        info->setProducerId(std::dynamic_pointer_cast<ProducerId>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
         info->setProducerSequenceId(tightUnmarshalLong(wireFormat, dataIn, bs));
         info->setBrokerSequenceId(tightUnmarshalLong(wireFormat, dataIn, bs));
     }
@@ -155,6 +186,43 @@ void MessageIdMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void MessageIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                        DataStructure*  dataStructure,
+                                        ByteWriter*     dataOut,
+                                        BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightMarshal2(wireFormat,
+                                                dataStructure,
+                                                dataOut,
+                                                bs);
+
+        MessageId* info = dynamic_cast<MessageId*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 10)
+        {
+            tightMarshalString2(info->getTextView(), dataOut, bs);
+        }
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getProducerId().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalLong2(wireFormat,
+                          info->getProducerSequenceId(),
+                          dataOut,
+                          bs);
+        tightMarshalLong2(wireFormat, info->getBrokerSequenceId(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void MessageIdMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                          DataStructure*   dataStructure,
@@ -173,9 +241,37 @@ void MessageIdMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
         {
             info->setTextView(looseUnmarshalString(dataIn));
         }
-        info->setProducerId(
-            std::shared_ptr<ProducerId>(dynamic_cast<ProducerId*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setProducerId(std::dynamic_pointer_cast<ProducerId>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setProducerSequenceId(looseUnmarshalLong(wireFormat, dataIn));
+        info->setBrokerSequenceId(looseUnmarshalLong(wireFormat, dataIn));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                         DataStructure*  dataStructure,
+                                         ByteReader*     dataIn)
+{
+    try
+    {
+        BaseDataStreamMarshaller::looseUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn);
+        MessageId* info = dynamic_cast<MessageId*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 10)
+        {
+            info->setTextView(looseUnmarshalString(dataIn));
+        }
+        info->setProducerId(std::dynamic_pointer_cast<ProducerId>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
         info->setProducerSequenceId(looseUnmarshalLong(wireFormat, dataIn));
         info->setBrokerSequenceId(looseUnmarshalLong(wireFormat, dataIn));
     }
@@ -214,3 +310,33 @@ void MessageIdMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageIdMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                       DataStructure*  dataStructure,
+                                       ByteWriter*     dataOut)
+{
+    try
+    {
+        MessageId* info = dynamic_cast<MessageId*>(dataStructure);
+        BaseDataStreamMarshaller::looseMarshal(wireFormat,
+                                               dataStructure,
+                                               dataOut);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 10)
+        {
+            looseMarshalString(info->getTextView(), dataOut);
+        }
+        looseMarshalCachedObject(wireFormat,
+                                 info->getProducerId().get(),
+                                 dataOut);
+        looseMarshalLong(wireFormat, info->getProducerSequenceId(), dataOut);
+        looseMarshalLong(wireFormat, info->getBrokerSequenceId(), dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
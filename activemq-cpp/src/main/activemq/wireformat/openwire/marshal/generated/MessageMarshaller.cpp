@@ -57,32 +57,139 @@ void MessageMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setProducerId(
-            std::shared_ptr<ProducerId>(dynamic_cast<ProducerId*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
-        info->setTransactionId(
-            std::shared_ptr<TransactionId>(dynamic_cast<TransactionId*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
-        info->setOriginalDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setProducerId(std::dynamic_pointer_cast<ProducerId>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setTransactionId(std::dynamic_pointer_cast<TransactionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
+        info->setOriginalDestination(
+            std::dynamic_pointer_cast<ActiveMQDestination>(
+                tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
         info->setMessageId(std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
             tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
-        info->setOriginalTransactionId(
-            std::shared_ptr<TransactionId>(dynamic_cast<TransactionId*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setOriginalTransactionId(std::dynamic_pointer_cast<TransactionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
         info->setGroupID(tightUnmarshalString(dataIn, bs));
         info->setGroupSequence(dataIn->readInt());
         info->setCorrelationId(tightUnmarshalString(dataIn, bs));
         info->setPersistent(bs->readBoolean());
         info->setExpiration(tightUnmarshalLong(wireFormat, dataIn, bs));
         info->setPriority(dataIn->readByte());
-        info->setReplyTo(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
+        info->setReplyTo(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedNestedObject(wireFormat, dataIn, bs)));
+        info->setTimestamp(tightUnmarshalLong(wireFormat, dataIn, bs));
+        info->setType(tightUnmarshalString(dataIn, bs));
+        info->setContent(tightUnmarshalByteArray(dataIn, bs));
+        info->setMarshalledProperties(tightUnmarshalByteArray(dataIn, bs));
+
+        info->setDataStructure(
+            std::shared_ptr<DataStructure>(dynamic_cast<DataStructure*>(
                 tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+        info->setTargetConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setCompressed(bs->readBoolean());
+        info->setRedeliveryCounter(dataIn->readInt());
+
+        if (bs->readBoolean())
+        {
+            short size = dataIn->readShort();
+            info->getBrokerPath().reserve(size);
+            for (int i = 0; i < size; i++)
+            {
+                info->getBrokerPath().push_back(
+                    std::shared_ptr<BrokerId>(dynamic_cast<BrokerId*>(
+                        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+            }
+        }
+        else
+        {
+            info->getBrokerPath().clear();
+        }
+        info->setArrival(tightUnmarshalLong(wireFormat, dataIn, bs));
+        info->setUserID(tightUnmarshalString(dataIn, bs));
+        info->setRecievedByDFBridge(bs->readBoolean());
+        if (wireVersion >= 2)
+        {
+            info->setDroppable(bs->readBoolean());
+        }
+        if (wireVersion >= 3)
+        {
+            if (bs->readBoolean())
+            {
+                short size = dataIn->readShort();
+                info->getCluster().reserve(size);
+                for (int i = 0; i < size; i++)
+                {
+                    info->getCluster().push_back(
+                        std::shared_ptr<BrokerId>(dynamic_cast<BrokerId*>(
+                            tightUnmarshalNestedObject(wireFormat,
+                                                       dataIn,
+                                                       bs))));
+                }
+            }
+            else
+            {
+                info->getCluster().clear();
+            }
+        }
+        if (wireVersion >= 3)
+        {
+            info->setBrokerInTime(tightUnmarshalLong(wireFormat, dataIn, bs));
+        }
+        if (wireVersion >= 3)
+        {
+            info->setBrokerOutTime(tightUnmarshalLong(wireFormat, dataIn, bs));
+        }
+        if (wireVersion >= 10)
+        {
+            info->setJMSXGroupFirstForConsumer(bs->readBoolean());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                       DataStructure*  dataStructure,
+                                       ByteReader*     dataIn,
+                                       BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        Message* info = dynamic_cast<Message*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setProducerId(std::dynamic_pointer_cast<ProducerId>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setTransactionId(std::dynamic_pointer_cast<TransactionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
+        info->setOriginalDestination(
+            std::dynamic_pointer_cast<ActiveMQDestination>(
+                tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setMessageId(std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
+            tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+        info->setOriginalTransactionId(std::dynamic_pointer_cast<TransactionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
+        info->setGroupID(tightUnmarshalString(dataIn, bs));
+        info->setGroupSequence(dataIn->readInt());
+        info->setCorrelationId(tightUnmarshalString(dataIn, bs));
+        info->setPersistent(bs->readBoolean());
+        info->setExpiration(tightUnmarshalLong(wireFormat, dataIn, bs));
+        info->setPriority(dataIn->readByte());
+        info->setReplyTo(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedNestedObject(wireFormat, dataIn, bs)));
         info->setTimestamp(tightUnmarshalLong(wireFormat, dataIn, bs));
         info->setType(tightUnmarshalString(dataIn, bs));
         info->setContent(tightUnmarshalByteArray(dataIn, bs));
@@ -91,9 +198,8 @@ void MessageMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
         info->setDataStructure(
             std::shared_ptr<DataStructure>(dynamic_cast<DataStructure*>(
                 tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
-        info->setTargetConsumerId(
-            std::shared_ptr<ConsumerId>(dynamic_cast<ConsumerId*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setTargetConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
         info->setCompressed(bs->readBoolean());
         info->setRedeliveryCounter(dataIn->readInt());
 
@@ -360,6 +466,120 @@ void MessageMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void MessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                      DataStructure*  dataStructure,
+                                      ByteWriter*     dataOut,
+                                      BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        Message* info = dynamic_cast<Message*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getProducerId().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getDestination().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getTransactionId().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getOriginalDestination().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalNestedObject2(wireFormat,
+                                  info->getMessageId().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getOriginalTransactionId().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalString2(info->getGroupID(), dataOut, bs);
+        dataOut->writeInt(info->getGroupSequence());
+        tightMarshalString2(info->getCorrelationId(), dataOut, bs);
+        bs->readBoolean();
+        tightMarshalLong2(wireFormat, info->getExpiration(), dataOut, bs);
+        dataOut->write(info->getPriority());
+        tightMarshalNestedObject2(wireFormat,
+                                  info->getReplyTo().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalLong2(wireFormat, info->getTimestamp(), dataOut, bs);
+        tightMarshalString2(info->getType(), dataOut, bs);
+        if (bs->readBoolean())
+        {
+            dataOut->writeInt((int)info->getContent().size());
+            dataOut->write((const unsigned char*)(&info->getContent()[0]),
+                           (int)info->getContent().size(),
+                           0,
+                           (int)info->getContent().size());
+        }
+        if (bs->readBoolean())
+        {
+            dataOut->writeInt((int)info->getMarshalledProperties().size());
+            dataOut->write(
+                (const unsigned char*)(&info->getMarshalledProperties()[0]),
+                (int)info->getMarshalledProperties().size(),
+                0,
+                (int)info->getMarshalledProperties().size());
+        }
+        tightMarshalNestedObject2(wireFormat,
+                                  info->getDataStructure().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getTargetConsumerId().get(),
+                                  dataOut,
+                                  bs);
+        bs->readBoolean();
+        dataOut->writeInt(info->getRedeliveryCounter());
+        tightMarshalObjectArray2(wireFormat, info->getBrokerPath(), dataOut, bs);
+        tightMarshalLong2(wireFormat, info->getArrival(), dataOut, bs);
+        tightMarshalString2(info->getUserID(), dataOut, bs);
+        bs->readBoolean();
+        if (wireVersion >= 2)
+        {
+            bs->readBoolean();
+        }
+        if (wireVersion >= 3)
+        {
+            tightMarshalObjectArray2(wireFormat,
+                                     info->getCluster(),
+                                     dataOut,
+                                     bs);
+        }
+        if (wireVersion >= 3)
+        {
+            tightMarshalLong2(wireFormat, info->getBrokerInTime(), dataOut, bs);
+        }
+        if (wireVersion >= 3)
+        {
+            tightMarshalLong2(wireFormat, info->getBrokerOutTime(), dataOut, bs);
+        }
+        if (wireVersion >= 10)
+        {
+            bs->readBoolean();
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void MessageMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                        DataStructure*   dataStructure,
@@ -374,32 +594,133 @@ void MessageMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setProducerId(
-            std::shared_ptr<ProducerId>(dynamic_cast<ProducerId*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
-        info->setTransactionId(
-            std::shared_ptr<TransactionId>(dynamic_cast<TransactionId*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
-        info->setOriginalDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setProducerId(std::dynamic_pointer_cast<ProducerId>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setTransactionId(std::dynamic_pointer_cast<TransactionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
+        info->setOriginalDestination(
+            std::dynamic_pointer_cast<ActiveMQDestination>(
+                looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
         info->setMessageId(std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
             looseUnmarshalNestedObject(wireFormat, dataIn))));
-        info->setOriginalTransactionId(
-            std::shared_ptr<TransactionId>(dynamic_cast<TransactionId*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setOriginalTransactionId(std::dynamic_pointer_cast<TransactionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
         info->setGroupID(looseUnmarshalString(dataIn));
         info->setGroupSequence(dataIn->readInt());
         info->setCorrelationId(looseUnmarshalString(dataIn));
         info->setPersistent(dataIn->readBoolean());
         info->setExpiration(looseUnmarshalLong(wireFormat, dataIn));
         info->setPriority(dataIn->readByte());
-        info->setReplyTo(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
+        info->setReplyTo(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedNestedObject(wireFormat, dataIn)));
+        info->setTimestamp(looseUnmarshalLong(wireFormat, dataIn));
+        info->setType(looseUnmarshalString(dataIn));
+        info->setContent(looseUnmarshalByteArray(dataIn));
+        info->setMarshalledProperties(looseUnmarshalByteArray(dataIn));
+        info->setDataStructure(
+            std::shared_ptr<DataStructure>(dynamic_cast<DataStructure*>(
                 looseUnmarshalNestedObject(wireFormat, dataIn))));
+        info->setTargetConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setCompressed(dataIn->readBoolean());
+        info->setRedeliveryCounter(dataIn->readInt());
+
+        if (dataIn->readBoolean())
+        {
+            short size = dataIn->readShort();
+            info->getBrokerPath().reserve(size);
+            for (int i = 0; i < size; i++)
+            {
+                info->getBrokerPath().push_back(
+                    std::shared_ptr<BrokerId>(dynamic_cast<BrokerId*>(
+                        looseUnmarshalNestedObject(wireFormat, dataIn))));
+            }
+        }
+        else
+        {
+            info->getBrokerPath().clear();
+        }
+        info->setArrival(looseUnmarshalLong(wireFormat, dataIn));
+        info->setUserID(looseUnmarshalString(dataIn));
+        info->setRecievedByDFBridge(dataIn->readBoolean());
+        if (wireVersion >= 2)
+        {
+            info->setDroppable(dataIn->readBoolean());
+        }
+        if (wireVersion >= 3)
+        {
+            if (dataIn->readBoolean())
+            {
+                short size = dataIn->readShort();
+                info->getCluster().reserve(size);
+                for (int i = 0; i < size; i++)
+                {
+                    info->getCluster().push_back(
+                        std::shared_ptr<BrokerId>(dynamic_cast<BrokerId*>(
+                            looseUnmarshalNestedObject(wireFormat, dataIn))));
+                }
+            }
+            else
+            {
+                info->getCluster().clear();
+            }
+        }
+        if (wireVersion >= 3)
+        {
+            info->setBrokerInTime(looseUnmarshalLong(wireFormat, dataIn));
+        }
+        if (wireVersion >= 3)
+        {
+            info->setBrokerOutTime(looseUnmarshalLong(wireFormat, dataIn));
+        }
+        if (wireVersion >= 10)
+        {
+            info->setJMSXGroupFirstForConsumer(dataIn->readBoolean());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                       DataStructure*  dataStructure,
+                                       ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        Message* info = dynamic_cast<Message*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setProducerId(std::dynamic_pointer_cast<ProducerId>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setTransactionId(std::dynamic_pointer_cast<TransactionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
+        info->setOriginalDestination(
+            std::dynamic_pointer_cast<ActiveMQDestination>(
+                looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setMessageId(std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
+            looseUnmarshalNestedObject(wireFormat, dataIn))));
+        info->setOriginalTransactionId(std::dynamic_pointer_cast<TransactionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
+        info->setGroupID(looseUnmarshalString(dataIn));
+        info->setGroupSequence(dataIn->readInt());
+        info->setCorrelationId(looseUnmarshalString(dataIn));
+        info->setPersistent(dataIn->readBoolean());
+        info->setExpiration(looseUnmarshalLong(wireFormat, dataIn));
+        info->setPriority(dataIn->readByte());
+        info->setReplyTo(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedNestedObject(wireFormat, dataIn)));
         info->setTimestamp(looseUnmarshalLong(wireFormat, dataIn));
         info->setType(looseUnmarshalString(dataIn));
         info->setContent(looseUnmarshalByteArray(dataIn));
@@ -407,9 +728,8 @@ void MessageMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
         info->setDataStructure(
             std::shared_ptr<DataStructure>(dynamic_cast<DataStructure*>(
                 looseUnmarshalNestedObject(wireFormat, dataIn))));
-        info->setTargetConsumerId(
-            std::shared_ptr<ConsumerId>(dynamic_cast<ConsumerId*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setTargetConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
         info->setCompressed(dataIn->readBoolean());
         info->setRedeliveryCounter(dataIn->readInt());
 
@@ -568,3 +888,100 @@ void MessageMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                     DataStructure*  dataStructure,
+                                     ByteWriter*     dataOut)
+{
+    try
+    {
+        Message* info = dynamic_cast<Message*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+
+        int wireVersion = wireFormat->getVersion();
+
+        looseMarshalCachedObject(wireFormat,
+                                 info->getProducerId().get(),
+                                 dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getDestination().get(),
+                                 dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getTransactionId().get(),
+                                 dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getOriginalDestination().get(),
+                                 dataOut);
+        looseMarshalNestedObject(wireFormat,
+                                 info->getMessageId().get(),
+                                 dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getOriginalTransactionId().get(),
+                                 dataOut);
+        looseMarshalString(info->getGroupID(), dataOut);
+        dataOut->writeInt(info->getGroupSequence());
+        looseMarshalString(info->getCorrelationId(), dataOut);
+        dataOut->writeBoolean(info->isPersistent());
+        looseMarshalLong(wireFormat, info->getExpiration(), dataOut);
+        dataOut->write(info->getPriority());
+        looseMarshalNestedObject(wireFormat, info->getReplyTo().get(), dataOut);
+        looseMarshalLong(wireFormat, info->getTimestamp(), dataOut);
+        looseMarshalString(info->getType(), dataOut);
+        dataOut->write(info->getContent().size() != 0);
+        if (info->getContent().size() != 0)
+        {
+            dataOut->writeInt((int)info->getContent().size());
+            dataOut->write((const unsigned char*)(&info->getContent()[0]),
+                           (int)info->getContent().size(),
+                           0,
+                           (int)info->getContent().size());
+        }
+        dataOut->write(info->getMarshalledProperties().size() != 0);
+        if (info->getMarshalledProperties().size() != 0)
+        {
+            dataOut->writeInt((int)info->getMarshalledProperties().size());
+            dataOut->write(
+                (const unsigned char*)(&info->getMarshalledProperties()[0]),
+                (int)info->getMarshalledProperties().size(),
+                0,
+                (int)info->getMarshalledProperties().size());
+        }
+        looseMarshalNestedObject(wireFormat,
+                                 info->getDataStructure().get(),
+                                 dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getTargetConsumerId().get(),
+                                 dataOut);
+        dataOut->writeBoolean(info->isCompressed());
+        dataOut->writeInt(info->getRedeliveryCounter());
+        looseMarshalObjectArray(wireFormat, info->getBrokerPath(), dataOut);
+        looseMarshalLong(wireFormat, info->getArrival(), dataOut);
+        looseMarshalString(info->getUserID(), dataOut);
+        dataOut->writeBoolean(info->isRecievedByDFBridge());
+        if (wireVersion >= 2)
+        {
+            dataOut->writeBoolean(info->isDroppable());
+        }
+        if (wireVersion >= 3)
+        {
+            looseMarshalObjectArray(wireFormat, info->getCluster(), dataOut);
+        }
+        if (wireVersion >= 3)
+        {
+            looseMarshalLong(wireFormat, info->getBrokerInTime(), dataOut);
+        }
+        if (wireVersion >= 3)
+        {
+            looseMarshalLong(wireFormat, info->getBrokerOutTime(), dataOut);
+        }
+        if (wireVersion >= 10)
+        {
+            dataOut->writeBoolean(info->isJMSXGroupFirstForConsumer());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
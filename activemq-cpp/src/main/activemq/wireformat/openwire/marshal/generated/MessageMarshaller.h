@@ -69,6 +69,12 @@ namespace wireformat
                         decaf::io::DataInputStream* dataIn,
                         utils::BooleanStream*       bs);
 
+                    virtual void tightUnmarshal(
+                        OpenWireFormat*          wireFormat,
+                        commands::DataStructure* dataStructure,
+                        utils::ByteReader*       dataIn,
+                        utils::BooleanStream*    bs);
+
                     virtual int tightMarshal1(
                         OpenWireFormat*          wireFormat,
                         commands::DataStructure* dataStructure,
@@ -80,15 +86,31 @@ namespace wireformat
                         decaf::io::DataOutputStream* dataOut,
                         utils::BooleanStream*        bs);
 
+                    virtual void tightMarshal2(
+                        OpenWireFormat*          wireFormat,
+                        commands::DataStructure* dataStructure,
+                        utils::ByteWriter*       dataOut,
+                        utils::BooleanStream*    bs);
+
                     virtual void looseUnmarshal(
                         OpenWireFormat*             wireFormat,
                         commands::DataStructure*    dataStructure,
                         decaf::io::DataInputStream* dataIn);
 
+                    virtual void looseUnmarshal(
+                        OpenWireFormat*          wireFormat,
+                        commands::DataStructure* dataStructure,
+                        utils::ByteReader*       dataIn);
+
                     virtual void looseMarshal(
                         OpenWireFormat*              wireFormat,
                         commands::DataStructure*     dataStructure,
                         decaf::io::DataOutputStream* dataOut);
+
+                    virtual void looseMarshal(
+                        OpenWireFormat*          wireFormat,
+                        commands::DataStructure* dataStructure,
+                        utils::ByteWriter*       dataOut);
                 };
 
             }  // namespace generated
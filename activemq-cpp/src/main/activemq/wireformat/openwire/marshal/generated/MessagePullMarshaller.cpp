@@ -69,12 +69,49 @@ void MessagePullMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setConsumerId(
-            std::shared_ptr<ConsumerId>(dynamic_cast<ConsumerId*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setTimeout(tightUnmarshalLong(wireFormat, dataIn, bs));
+        if (wireVersion >= 3)
+        {
+            info->setCorrelationId(tightUnmarshalString(dataIn, bs));
+        }
+        if (wireVersion >= 3)
+        {
+            info->setMessageId(
+                std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
+                    tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void MessagePullMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                           DataStructure*  dataStructure,
+                                           ByteReader*     dataIn,
+                                           BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        MessagePull* info = dynamic_cast<MessagePull*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
         info->setTimeout(tightUnmarshalLong(wireFormat, dataIn, bs));
         if (wireVersion >= 3)
         {
@@ -177,6 +214,50 @@ void MessagePullMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void MessagePullMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                          DataStructure*  dataStructure,
+                                          ByteWriter*     dataOut,
+                                          BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        MessagePull* info = dynamic_cast<MessagePull*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getConsumerId().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getDestination().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalLong2(wireFormat, info->getTimeout(), dataOut, bs);
+        if (wireVersion >= 3)
+        {
+            tightMarshalString2(info->getCorrelationId(), dataOut, bs);
+        }
+        if (wireVersion >= 3)
+        {
+            tightMarshalNestedObject2(wireFormat,
+                                      info->getMessageId().get(),
+                                      dataOut,
+                                      bs);
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void MessagePullMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                            DataStructure*   dataStructure,
@@ -191,12 +272,46 @@ void MessagePullMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setConsumerId(
-            std::shared_ptr<ConsumerId>(dynamic_cast<ConsumerId*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setTimeout(looseUnmarshalLong(wireFormat, dataIn));
+        if (wireVersion >= 3)
+        {
+            info->setCorrelationId(looseUnmarshalString(dataIn));
+        }
+        if (wireVersion >= 3)
+        {
+            info->setMessageId(
+                std::shared_ptr<MessageId>(dynamic_cast<MessageId*>(
+                    looseUnmarshalNestedObject(wireFormat, dataIn))));
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void MessagePullMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                           DataStructure*  dataStructure,
+                                           ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        MessagePull* info = dynamic_cast<MessagePull*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setConsumerId(std::dynamic_pointer_cast<ConsumerId>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
         info->setTimeout(looseUnmarshalLong(wireFormat, dataIn));
         if (wireVersion >= 3)
         {
@@ -250,3 +365,39 @@ void MessagePullMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void MessagePullMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                         DataStructure*  dataStructure,
+                                         ByteWriter*     dataOut)
+{
+    try
+    {
+        MessagePull* info = dynamic_cast<MessagePull*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+
+        int wireVersion = wireFormat->getVersion();
+
+        looseMarshalCachedObject(wireFormat,
+                                 info->getConsumerId().get(),
+                                 dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getDestination().get(),
+                                 dataOut);
+        looseMarshalLong(wireFormat, info->getTimeout(), dataOut);
+        if (wireVersion >= 3)
+        {
+            looseMarshalString(info->getCorrelationId(), dataOut);
+        }
+        if (wireVersion >= 3)
+        {
+            looseMarshalNestedObject(wireFormat,
+                                     info->getMessageId().get(),
+                                     dataOut);
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
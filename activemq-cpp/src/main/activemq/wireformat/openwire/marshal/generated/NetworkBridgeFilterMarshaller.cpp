@@ -70,9 +70,44 @@ void NetworkBridgeFilterMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setNetworkBrokerId(
-            std::shared_ptr<BrokerId>(dynamic_cast<BrokerId*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setNetworkBrokerId(std::dynamic_pointer_cast<BrokerId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
+        if (wireVersion >= 10)
+        {
+            info->setMessageTTL(dataIn->readInt());
+        }
+        if (wireVersion >= 10)
+        {
+            info->setConsumerTTL(dataIn->readInt());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void NetworkBridgeFilterMarshaller::tightUnmarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteReader*     dataIn,
+    BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn,
+                                                 bs);
+
+        NetworkBridgeFilter* info =
+            dynamic_cast<NetworkBridgeFilter*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setNetworkBrokerId(std::dynamic_pointer_cast<BrokerId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
         if (wireVersion >= 10)
         {
             info->setMessageTTL(dataIn->readInt());
@@ -159,6 +194,43 @@ void NetworkBridgeFilterMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void NetworkBridgeFilterMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                                  DataStructure*  dataStructure,
+                                                  ByteWriter*     dataOut,
+                                                  BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightMarshal2(wireFormat,
+                                                dataStructure,
+                                                dataOut,
+                                                bs);
+
+        NetworkBridgeFilter* info =
+            dynamic_cast<NetworkBridgeFilter*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getNetworkBrokerId().get(),
+                                  dataOut,
+                                  bs);
+        if (wireVersion >= 10)
+        {
+            dataOut->writeInt(info->getMessageTTL());
+        }
+        if (wireVersion >= 10)
+        {
+            dataOut->writeInt(info->getConsumerTTL());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void NetworkBridgeFilterMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
                                                    DataStructure* dataStructure,
@@ -174,9 +246,41 @@ void NetworkBridgeFilterMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setNetworkBrokerId(
-            std::shared_ptr<BrokerId>(dynamic_cast<BrokerId*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setNetworkBrokerId(std::dynamic_pointer_cast<BrokerId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
+        if (wireVersion >= 10)
+        {
+            info->setMessageTTL(dataIn->readInt());
+        }
+        if (wireVersion >= 10)
+        {
+            info->setConsumerTTL(dataIn->readInt());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void NetworkBridgeFilterMarshaller::looseUnmarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteReader*     dataIn)
+{
+    try
+    {
+        BaseDataStreamMarshaller::looseUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn);
+        NetworkBridgeFilter* info =
+            dynamic_cast<NetworkBridgeFilter*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setNetworkBrokerId(std::dynamic_pointer_cast<BrokerId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
         if (wireVersion >= 10)
         {
             info->setMessageTTL(dataIn->readInt());
@@ -224,3 +328,36 @@ void NetworkBridgeFilterMarshaller::looseMarshal(OpenWireFormat* wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void NetworkBridgeFilterMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                                 DataStructure*  dataStructure,
+                                                 ByteWriter*     dataOut)
+{
+    try
+    {
+        NetworkBridgeFilter* info =
+            dynamic_cast<NetworkBridgeFilter*>(dataStructure);
+        BaseDataStreamMarshaller::looseMarshal(wireFormat,
+                                               dataStructure,
+                                               dataOut);
+
+        int wireVersion = wireFormat->getVersion();
+
+        looseMarshalCachedObject(wireFormat,
+                                 info->getNetworkBrokerId().get(),
+                                 dataOut);
+        if (wireVersion >= 10)
+        {
+            dataOut->writeInt(info->getMessageTTL());
+        }
+        if (wireVersion >= 10)
+        {
+            dataOut->writeInt(info->getConsumerTTL());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
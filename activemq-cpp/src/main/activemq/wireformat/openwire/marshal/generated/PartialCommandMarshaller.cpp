@@ -75,6 +75,29 @@ void PartialCommandMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void PartialCommandMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteReader*     dataIn,
+                                              BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn,
+                                                 bs);
+
+        PartialCommand* info = dynamic_cast<PartialCommand*>(dataStructure);
+        info->setCommandId(dataIn->readInt());
+        info->setData(tightUnmarshalByteArray(dataIn, bs));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int PartialCommandMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                             DataStructure*  dataStructure,
@@ -128,6 +151,36 @@ void PartialCommandMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void PartialCommandMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                             DataStructure*  dataStructure,
+                                             ByteWriter*     dataOut,
+                                             BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightMarshal2(wireFormat,
+                                                dataStructure,
+                                                dataOut,
+                                                bs);
+
+        PartialCommand* info = dynamic_cast<PartialCommand*>(dataStructure);
+        dataOut->writeInt(info->getCommandId());
+        if (bs->readBoolean())
+        {
+            dataOut->writeInt((int)info->getData().size());
+            dataOut->write((const unsigned char*)(&info->getData()[0]),
+                           (int)info->getData().size(),
+                           0,
+                           (int)info->getData().size());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void PartialCommandMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                               DataStructure*   dataStructure,
@@ -148,6 +201,26 @@ void PartialCommandMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void PartialCommandMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteReader*     dataIn)
+{
+    try
+    {
+        BaseDataStreamMarshaller::looseUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn);
+        PartialCommand* info = dynamic_cast<PartialCommand*>(dataStructure);
+        info->setCommandId(dataIn->readInt());
+        info->setData(looseUnmarshalByteArray(dataIn));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void PartialCommandMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                             DataStructure*    dataStructure,
@@ -175,3 +248,31 @@ void PartialCommandMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void PartialCommandMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                            DataStructure*  dataStructure,
+                                            ByteWriter*     dataOut)
+{
+    try
+    {
+        PartialCommand* info = dynamic_cast<PartialCommand*>(dataStructure);
+        BaseDataStreamMarshaller::looseMarshal(wireFormat,
+                                               dataStructure,
+                                               dataOut);
+        dataOut->writeInt(info->getCommandId());
+        dataOut->write(info->getData().size() != 0);
+        if (info->getData().size() != 0)
+        {
+            dataOut->writeInt((int)info->getData().size());
+            dataOut->write((const unsigned char*)(&info->getData()[0]),
+                           (int)info->getData().size(),
+                           0,
+                           (int)info->getData().size());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
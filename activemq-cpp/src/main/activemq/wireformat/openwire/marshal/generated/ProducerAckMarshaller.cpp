@@ -71,9 +71,41 @@ void ProducerAckMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
 
         if (wireVersion >= 3)
         {
-            info->setProducerId(
-                std::shared_ptr<ProducerId>(dynamic_cast<ProducerId*>(
-                    tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+            info->setProducerId(std::dynamic_pointer_cast<ProducerId>(
+                tightUnmarshalInternedNestedObject(wireFormat, dataIn, bs)));
+        }
+        if (wireVersion >= 3)
+        {
+            info->setSize(dataIn->readInt());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ProducerAckMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                           DataStructure*  dataStructure,
+                                           ByteReader*     dataIn,
+                                           BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        ProducerAck* info = dynamic_cast<ProducerAck*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 3)
+        {
+            info->setProducerId(std::dynamic_pointer_cast<ProducerId>(
+                tightUnmarshalInternedNestedObject(wireFormat, dataIn, bs)));
         }
         if (wireVersion >= 3)
         {
@@ -153,6 +185,41 @@ void ProducerAckMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ProducerAckMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                          DataStructure*  dataStructure,
+                                          ByteWriter*     dataOut,
+                                          BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        ProducerAck* info = dynamic_cast<ProducerAck*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 3)
+        {
+            tightMarshalNestedObject2(wireFormat,
+                                      info->getProducerId().get(),
+                                      dataOut,
+                                      bs);
+        }
+        if (wireVersion >= 3)
+        {
+            dataOut->writeInt(info->getSize());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ProducerAckMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                            DataStructure*   dataStructure,
@@ -169,9 +236,38 @@ void ProducerAckMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
 
         if (wireVersion >= 3)
         {
-            info->setProducerId(
-                std::shared_ptr<ProducerId>(dynamic_cast<ProducerId*>(
-                    looseUnmarshalNestedObject(wireFormat, dataIn))));
+            info->setProducerId(std::dynamic_pointer_cast<ProducerId>(
+                looseUnmarshalInternedNestedObject(wireFormat, dataIn)));
+        }
+        if (wireVersion >= 3)
+        {
+            info->setSize(dataIn->readInt());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ProducerAckMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                           DataStructure*  dataStructure,
+                                           ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        ProducerAck* info = dynamic_cast<ProducerAck*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 3)
+        {
+            info->setProducerId(std::dynamic_pointer_cast<ProducerId>(
+                looseUnmarshalInternedNestedObject(wireFormat, dataIn)));
         }
         if (wireVersion >= 3)
         {
@@ -212,3 +308,32 @@ void ProducerAckMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ProducerAckMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                         DataStructure*  dataStructure,
+                                         ByteWriter*     dataOut)
+{
+    try
+    {
+        ProducerAck* info = dynamic_cast<ProducerAck*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 3)
+        {
+            looseMarshalNestedObject(wireFormat,
+                                     info->getProducerId().get(),
+                                     dataOut);
+        }
+        if (wireVersion >= 3)
+        {
+            dataOut->writeInt(info->getSize());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
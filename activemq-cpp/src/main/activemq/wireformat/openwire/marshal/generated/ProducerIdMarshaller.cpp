@@ -76,6 +76,30 @@ void ProducerIdMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ProducerIdMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                          DataStructure*  dataStructure,
+                                          ByteReader*     dataIn,
+                                          BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn,
+                                                 bs);
+
+        ProducerId* info = dynamic_cast<ProducerId*>(dataStructure);
+        info->setConnectionId(tightUnmarshalString(dataIn, bs));
+        info->setValue(tightUnmarshalLong(wireFormat, dataIn, bs));
+        info->setSessionId(tightUnmarshalLong(wireFormat, dataIn, bs));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int ProducerIdMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                         DataStructure*  dataStructure,
@@ -124,6 +148,30 @@ void ProducerIdMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ProducerIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                         DataStructure*  dataStructure,
+                                         ByteWriter*     dataOut,
+                                         BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightMarshal2(wireFormat,
+                                                dataStructure,
+                                                dataOut,
+                                                bs);
+
+        ProducerId* info = dynamic_cast<ProducerId*>(dataStructure);
+        tightMarshalString2(info->getConnectionId(), dataOut, bs);
+        tightMarshalLong2(wireFormat, info->getValue(), dataOut, bs);
+        tightMarshalLong2(wireFormat, info->getSessionId(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ProducerIdMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                           DataStructure*   dataStructure,
@@ -145,6 +193,27 @@ void ProducerIdMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ProducerIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                          DataStructure*  dataStructure,
+                                          ByteReader*     dataIn)
+{
+    try
+    {
+        BaseDataStreamMarshaller::looseUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn);
+        ProducerId* info = dynamic_cast<ProducerId*>(dataStructure);
+        info->setConnectionId(looseUnmarshalString(dataIn));
+        info->setValue(looseUnmarshalLong(wireFormat, dataIn));
+        info->setSessionId(looseUnmarshalLong(wireFormat, dataIn));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ProducerIdMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                         DataStructure*    dataStructure,
@@ -165,3 +234,24 @@ void ProducerIdMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ProducerIdMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                        DataStructure*  dataStructure,
+                                        ByteWriter*     dataOut)
+{
+    try
+    {
+        ProducerId* info = dynamic_cast<ProducerId*>(dataStructure);
+        BaseDataStreamMarshaller::looseMarshal(wireFormat,
+                                               dataStructure,
+                                               dataOut);
+        looseMarshalString(info->getConnectionId(), dataOut);
+        looseMarshalLong(wireFormat, info->getValue(), dataOut);
+        looseMarshalLong(wireFormat, info->getSessionId(), dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
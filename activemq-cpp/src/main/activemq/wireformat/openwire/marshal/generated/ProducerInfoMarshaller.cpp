@@ -69,12 +69,62 @@ void ProducerInfoMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setProducerId(
-            std::shared_ptr<ProducerId>(dynamic_cast<ProducerId*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setProducerId(std::dynamic_pointer_cast<ProducerId>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+
+        if (bs->readBoolean())
+        {
+            short size = dataIn->readShort();
+            info->getBrokerPath().reserve(size);
+            for (int i = 0; i < size; i++)
+            {
+                info->getBrokerPath().push_back(
+                    std::shared_ptr<BrokerId>(dynamic_cast<BrokerId*>(
+                        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+            }
+        }
+        else
+        {
+            info->getBrokerPath().clear();
+        }
+        if (wireVersion >= 2)
+        {
+            info->setDispatchAsync(bs->readBoolean());
+        }
+        if (wireVersion >= 3)
+        {
+            info->setWindowSize(dataIn->readInt());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ProducerInfoMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                            DataStructure*  dataStructure,
+                                            ByteReader*     dataIn,
+                                            BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        ProducerInfo* info = dynamic_cast<ProducerInfo*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setProducerId(std::dynamic_pointer_cast<ProducerId>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
 
         if (bs->readBoolean())
         {
@@ -184,6 +234,47 @@ void ProducerInfoMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ProducerInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                           DataStructure*  dataStructure,
+                                           ByteWriter*     dataOut,
+                                           BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        ProducerInfo* info = dynamic_cast<ProducerInfo*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getProducerId().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getDestination().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalObjectArray2(wireFormat, info->getBrokerPath(), dataOut, bs);
+        if (wireVersion >= 2)
+        {
+            bs->readBoolean();
+        }
+        if (wireVersion >= 3)
+        {
+            dataOut->writeInt(info->getWindowSize());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ProducerInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                             DataStructure*   dataStructure,
@@ -198,12 +289,59 @@ void ProducerInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setProducerId(
-            std::shared_ptr<ProducerId>(dynamic_cast<ProducerId*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setProducerId(std::dynamic_pointer_cast<ProducerId>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+
+        if (dataIn->readBoolean())
+        {
+            short size = dataIn->readShort();
+            info->getBrokerPath().reserve(size);
+            for (int i = 0; i < size; i++)
+            {
+                info->getBrokerPath().push_back(
+                    std::shared_ptr<BrokerId>(dynamic_cast<BrokerId*>(
+                        looseUnmarshalNestedObject(wireFormat, dataIn))));
+            }
+        }
+        else
+        {
+            info->getBrokerPath().clear();
+        }
+        if (wireVersion >= 2)
+        {
+            info->setDispatchAsync(dataIn->readBoolean());
+        }
+        if (wireVersion >= 3)
+        {
+            info->setWindowSize(dataIn->readInt());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ProducerInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                            DataStructure*  dataStructure,
+                                            ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        ProducerInfo* info = dynamic_cast<ProducerInfo*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setProducerId(std::dynamic_pointer_cast<ProducerId>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
 
         if (dataIn->readBoolean())
         {
@@ -268,3 +406,37 @@ void ProducerInfoMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ProducerInfoMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                          DataStructure*  dataStructure,
+                                          ByteWriter*     dataOut)
+{
+    try
+    {
+        ProducerInfo* info = dynamic_cast<ProducerInfo*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+
+        int wireVersion = wireFormat->getVersion();
+
+        looseMarshalCachedObject(wireFormat,
+                                 info->getProducerId().get(),
+                                 dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getDestination().get(),
+                                 dataOut);
+        looseMarshalObjectArray(wireFormat, info->getBrokerPath(), dataOut);
+        if (wireVersion >= 2)
+        {
+            dataOut->writeBoolean(info->isDispatchAsync());
+        }
+        if (wireVersion >= 3)
+        {
+            dataOut->writeInt(info->getWindowSize());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
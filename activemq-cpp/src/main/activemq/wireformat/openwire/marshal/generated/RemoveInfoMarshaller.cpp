@@ -69,9 +69,39 @@ void RemoveInfoMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setObjectId(
-            std::shared_ptr<DataStructure>(dynamic_cast<DataStructure*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setObjectId(std::dynamic_pointer_cast<DataStructure>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
+        if (wireVersion >= 5)
+        {
+            info->setLastDeliveredSequenceId(
+                tightUnmarshalLong(wireFormat, dataIn, bs));
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void RemoveInfoMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                          DataStructure*  dataStructure,
+                                          ByteReader*     dataIn,
+                                          BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        RemoveInfo* info = dynamic_cast<RemoveInfo*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setObjectId(std::dynamic_pointer_cast<DataStructure>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
         if (wireVersion >= 5)
         {
             info->setLastDeliveredSequenceId(
@@ -151,6 +181,41 @@ void RemoveInfoMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void RemoveInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                         DataStructure*  dataStructure,
+                                         ByteWriter*     dataOut,
+                                         BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        RemoveInfo* info = dynamic_cast<RemoveInfo*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getObjectId().get(),
+                                  dataOut,
+                                  bs);
+        if (wireVersion >= 5)
+        {
+            tightMarshalLong2(wireFormat,
+                              info->getLastDeliveredSequenceId(),
+                              dataOut,
+                              bs);
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void RemoveInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                           DataStructure*   dataStructure,
@@ -165,9 +230,36 @@ void RemoveInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setObjectId(
-            std::shared_ptr<DataStructure>(dynamic_cast<DataStructure*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setObjectId(std::dynamic_pointer_cast<DataStructure>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
+        if (wireVersion >= 5)
+        {
+            info->setLastDeliveredSequenceId(
+                looseUnmarshalLong(wireFormat, dataIn));
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void RemoveInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                          DataStructure*  dataStructure,
+                                          ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        RemoveInfo* info = dynamic_cast<RemoveInfo*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setObjectId(std::dynamic_pointer_cast<DataStructure>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
         if (wireVersion >= 5)
         {
             info->setLastDeliveredSequenceId(
@@ -207,3 +299,31 @@ void RemoveInfoMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void RemoveInfoMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                        DataStructure*  dataStructure,
+                                        ByteWriter*     dataOut)
+{
+    try
+    {
+        RemoveInfo* info = dynamic_cast<RemoveInfo*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+
+        int wireVersion = wireFormat->getVersion();
+
+        looseMarshalCachedObject(wireFormat,
+                                 info->getObjectId().get(),
+                                 dataOut);
+        if (wireVersion >= 5)
+        {
+            looseMarshalLong(wireFormat,
+                             info->getLastDeliveredSequenceId(),
+                             dataOut);
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
@@ -68,9 +68,35 @@ void RemoveSubscriptionInfoMarshaller::tightUnmarshal(
 
         RemoveSubscriptionInfo* info =
             dynamic_cast<RemoveSubscriptionInfo*>(dataStructure);
-        info->setConnectionId(
-            std::shared_ptr<ConnectionId>(dynamic_cast<ConnectionId*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
+        info->setSubcriptionName(tightUnmarshalString(dataIn, bs));
+        info->setClientId(tightUnmarshalString(dataIn, bs));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void RemoveSubscriptionInfoMarshaller::tightUnmarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteReader*     dataIn,
+    BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        RemoveSubscriptionInfo* info =
+            dynamic_cast<RemoveSubscriptionInfo*>(dataStructure);
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
         info->setSubcriptionName(tightUnmarshalString(dataIn, bs));
         info->setClientId(tightUnmarshalString(dataIn, bs));
     }
@@ -135,6 +161,35 @@ void RemoveSubscriptionInfoMarshaller::tightMarshal2(
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void RemoveSubscriptionInfoMarshaller::tightMarshal2(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteWriter*     dataOut,
+    BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        RemoveSubscriptionInfo* info =
+            dynamic_cast<RemoveSubscriptionInfo*>(dataStructure);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getConnectionId().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalString2(info->getSubcriptionName(), dataOut, bs);
+        tightMarshalString2(info->getClientId(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void RemoveSubscriptionInfoMarshaller::looseUnmarshal(
     OpenWireFormat*  wireFormat,
@@ -148,9 +203,32 @@ void RemoveSubscriptionInfoMarshaller::looseUnmarshal(
                                               dataIn);
         RemoveSubscriptionInfo* info =
             dynamic_cast<RemoveSubscriptionInfo*>(dataStructure);
-        info->setConnectionId(
-            std::shared_ptr<ConnectionId>(dynamic_cast<ConnectionId*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
+        info->setSubcriptionName(looseUnmarshalString(dataIn));
+        info->setClientId(looseUnmarshalString(dataIn));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void RemoveSubscriptionInfoMarshaller::looseUnmarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        RemoveSubscriptionInfo* info =
+            dynamic_cast<RemoveSubscriptionInfo*>(dataStructure);
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
         info->setSubcriptionName(looseUnmarshalString(dataIn));
         info->setClientId(looseUnmarshalString(dataIn));
     }
@@ -181,3 +259,26 @@ void RemoveSubscriptionInfoMarshaller::looseMarshal(OpenWireFormat* wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void RemoveSubscriptionInfoMarshaller::looseMarshal(
+    OpenWireFormat* wireFormat,
+    DataStructure*  dataStructure,
+    ByteWriter*     dataOut)
+{
+    try
+    {
+        RemoveSubscriptionInfo* info =
+            dynamic_cast<RemoveSubscriptionInfo*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getConnectionId().get(),
+                                 dataOut);
+        looseMarshalString(info->getSubcriptionName(), dataOut);
+        looseMarshalString(info->getClientId(), dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
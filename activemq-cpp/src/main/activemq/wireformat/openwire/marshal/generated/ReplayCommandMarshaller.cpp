@@ -75,6 +75,29 @@ void ReplayCommandMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ReplayCommandMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                             DataStructure*  dataStructure,
+                                             ByteReader*     dataIn,
+                                             BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        ReplayCommand* info = dynamic_cast<ReplayCommand*>(dataStructure);
+        info->setFirstNakNumber(dataIn->readInt());
+        info->setLastNakNumber(dataIn->readInt());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int ReplayCommandMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                            DataStructure*  dataStructure,
@@ -116,6 +139,29 @@ void ReplayCommandMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ReplayCommandMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                            DataStructure*  dataStructure,
+                                            ByteWriter*     dataOut,
+                                            BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        ReplayCommand* info = dynamic_cast<ReplayCommand*>(dataStructure);
+        dataOut->writeInt(info->getFirstNakNumber());
+        dataOut->writeInt(info->getLastNakNumber());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ReplayCommandMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                              DataStructure*   dataStructure,
@@ -136,6 +182,26 @@ void ReplayCommandMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ReplayCommandMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                             DataStructure*  dataStructure,
+                                             ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        ReplayCommand* info = dynamic_cast<ReplayCommand*>(dataStructure);
+        info->setFirstNakNumber(dataIn->readInt());
+        info->setLastNakNumber(dataIn->readInt());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ReplayCommandMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                            DataStructure*    dataStructure,
@@ -153,3 +219,21 @@ void ReplayCommandMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ReplayCommandMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                           DataStructure*  dataStructure,
+                                           ByteWriter*     dataOut)
+{
+    try
+    {
+        ReplayCommand* info = dynamic_cast<ReplayCommand*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+        dataOut->writeInt(info->getFirstNakNumber());
+        dataOut->writeInt(info->getLastNakNumber());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
@@ -74,6 +74,28 @@ void ResponseMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ResponseMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                        DataStructure*  dataStructure,
+                                        ByteReader*     dataIn,
+                                        BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        Response* info = dynamic_cast<Response*>(dataStructure);
+        info->setCorrelationId(dataIn->readInt());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int ResponseMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                       DataStructure*  dataStructure,
@@ -114,6 +136,28 @@ void ResponseMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ResponseMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                       DataStructure*  dataStructure,
+                                       ByteWriter*     dataOut,
+                                       BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        Response* info = dynamic_cast<Response*>(dataStructure);
+        dataOut->writeInt(info->getCorrelationId());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ResponseMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                         DataStructure*   dataStructure,
@@ -133,6 +177,25 @@ void ResponseMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ResponseMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                        DataStructure*  dataStructure,
+                                        ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        Response* info = dynamic_cast<Response*>(dataStructure);
+        info->setCorrelationId(dataIn->readInt());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ResponseMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                       DataStructure*    dataStructure,
@@ -149,3 +212,20 @@ void ResponseMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void ResponseMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                      DataStructure*  dataStructure,
+                                      ByteWriter*     dataOut)
+{
+    try
+    {
+        Response* info = dynamic_cast<Response*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+        dataOut->writeInt(info->getCorrelationId());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
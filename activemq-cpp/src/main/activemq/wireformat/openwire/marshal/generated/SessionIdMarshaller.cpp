@@ -75,6 +75,29 @@ void SessionIdMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void SessionIdMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                         DataStructure*  dataStructure,
+                                         ByteReader*     dataIn,
+                                         BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn,
+                                                 bs);
+
+        SessionId* info = dynamic_cast<SessionId*>(dataStructure);
+        info->setConnectionId(tightUnmarshalString(dataIn, bs));
+        info->setValue(tightUnmarshalLong(wireFormat, dataIn, bs));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int SessionIdMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                        DataStructure*  dataStructure,
@@ -121,6 +144,29 @@ void SessionIdMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void SessionIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                        DataStructure*  dataStructure,
+                                        ByteWriter*     dataOut,
+                                        BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightMarshal2(wireFormat,
+                                                dataStructure,
+                                                dataOut,
+                                                bs);
+
+        SessionId* info = dynamic_cast<SessionId*>(dataStructure);
+        tightMarshalString2(info->getConnectionId(), dataOut, bs);
+        tightMarshalLong2(wireFormat, info->getValue(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void SessionIdMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                          DataStructure*   dataStructure,
@@ -141,6 +187,26 @@ void SessionIdMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void SessionIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                         DataStructure*  dataStructure,
+                                         ByteReader*     dataIn)
+{
+    try
+    {
+        BaseDataStreamMarshaller::looseUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn);
+        SessionId* info = dynamic_cast<SessionId*>(dataStructure);
+        info->setConnectionId(looseUnmarshalString(dataIn));
+        info->setValue(looseUnmarshalLong(wireFormat, dataIn));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void SessionIdMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                        DataStructure*    dataStructure,
@@ -160,3 +226,23 @@ void SessionIdMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void SessionIdMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                       DataStructure*  dataStructure,
+                                       ByteWriter*     dataOut)
+{
+    try
+    {
+        SessionId* info = dynamic_cast<SessionId*>(dataStructure);
+        BaseDataStreamMarshaller::looseMarshal(wireFormat,
+                                               dataStructure,
+                                               dataOut);
+        looseMarshalString(info->getConnectionId(), dataOut);
+        looseMarshalLong(wireFormat, info->getValue(), dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
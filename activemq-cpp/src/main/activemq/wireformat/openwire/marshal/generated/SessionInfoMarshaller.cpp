@@ -66,8 +66,31 @@ void SessionInfoMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
                                               bs);
 
         SessionInfo* info = dynamic_cast<SessionInfo*>(dataStructure);
-        info->setSessionId(std::shared_ptr<SessionId>(dynamic_cast<SessionId*>(
-            tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setSessionId(std::dynamic_pointer_cast<SessionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void SessionInfoMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                           DataStructure*  dataStructure,
+                                           ByteReader*     dataIn,
+                                           BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        SessionInfo* info = dynamic_cast<SessionInfo*>(dataStructure);
+        info->setSessionId(std::dynamic_pointer_cast<SessionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
@@ -123,6 +146,31 @@ void SessionInfoMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void SessionInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                          DataStructure*  dataStructure,
+                                          ByteWriter*     dataOut,
+                                          BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        SessionInfo* info = dynamic_cast<SessionInfo*>(dataStructure);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getSessionId().get(),
+                                  dataOut,
+                                  bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void SessionInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                            DataStructure*   dataStructure,
@@ -134,8 +182,28 @@ void SessionInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                               dataStructure,
                                               dataIn);
         SessionInfo* info = dynamic_cast<SessionInfo*>(dataStructure);
-        info->setSessionId(std::shared_ptr<SessionId>(dynamic_cast<SessionId*>(
-            looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setSessionId(std::dynamic_pointer_cast<SessionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void SessionInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                           DataStructure*  dataStructure,
+                                           ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        SessionInfo* info = dynamic_cast<SessionInfo*>(dataStructure);
+        info->setSessionId(std::dynamic_pointer_cast<SessionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
@@ -161,3 +229,22 @@ void SessionInfoMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void SessionInfoMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                         DataStructure*  dataStructure,
+                                         ByteWriter*     dataOut)
+{
+    try
+    {
+        SessionInfo* info = dynamic_cast<SessionInfo*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getSessionId().get(),
+                                 dataOut);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
@@ -70,16 +70,58 @@ void SubscriptionInfoMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
         int wireVersion = wireFormat->getVersion();
 
         info->setClientId(tightUnmarshalString(dataIn, bs));
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
         info->setSelector(tightUnmarshalString(dataIn, bs));
         info->setSubcriptionName(tightUnmarshalString(dataIn, bs));
         if (wireVersion >= 3)
         {
-            info->setSubscribedDestination(std::shared_ptr<ActiveMQDestination>(
-                dynamic_cast<ActiveMQDestination*>(
-                    tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+            info->setSubscribedDestination(
+                std::dynamic_pointer_cast<ActiveMQDestination>(
+                    tightUnmarshalInternedNestedObject(wireFormat,
+                                                       dataIn,
+                                                       bs)));
+        }
+        if (wireVersion >= 11)
+        {
+            info->setNoLocal(bs->readBoolean());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void SubscriptionInfoMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                                DataStructure*  dataStructure,
+                                                ByteReader*     dataIn,
+                                                BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn,
+                                                 bs);
+
+        SubscriptionInfo* info = dynamic_cast<SubscriptionInfo*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setClientId(tightUnmarshalString(dataIn, bs));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            tightUnmarshalInternedCachedObject(wireFormat, dataIn, bs)));
+        info->setSelector(tightUnmarshalString(dataIn, bs));
+        info->setSubcriptionName(tightUnmarshalString(dataIn, bs));
+        if (wireVersion >= 3)
+        {
+            info->setSubscribedDestination(
+                std::dynamic_pointer_cast<ActiveMQDestination>(
+                    tightUnmarshalInternedNestedObject(wireFormat,
+                                                       dataIn,
+                                                       bs)));
         }
         if (wireVersion >= 11)
         {
@@ -175,6 +217,48 @@ void SubscriptionInfoMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void SubscriptionInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteWriter*     dataOut,
+                                               BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightMarshal2(wireFormat,
+                                                dataStructure,
+                                                dataOut,
+                                                bs);
+
+        SubscriptionInfo* info = dynamic_cast<SubscriptionInfo*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        tightMarshalString2(info->getClientId(), dataOut, bs);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getDestination().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalString2(info->getSelector(), dataOut, bs);
+        tightMarshalString2(info->getSubcriptionName(), dataOut, bs);
+        if (wireVersion >= 3)
+        {
+            tightMarshalNestedObject2(wireFormat,
+                                      info->getSubscribedDestination().get(),
+                                      dataOut,
+                                      bs);
+        }
+        if (wireVersion >= 11)
+        {
+            bs->readBoolean();
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void SubscriptionInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                                 DataStructure*   dataStructure,
@@ -190,16 +274,51 @@ void SubscriptionInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
         int wireVersion = wireFormat->getVersion();
 
         info->setClientId(looseUnmarshalString(dataIn));
-        info->setDestination(std::shared_ptr<ActiveMQDestination>(
-            dynamic_cast<ActiveMQDestination*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
         info->setSelector(looseUnmarshalString(dataIn));
         info->setSubcriptionName(looseUnmarshalString(dataIn));
         if (wireVersion >= 3)
         {
-            info->setSubscribedDestination(std::shared_ptr<ActiveMQDestination>(
-                dynamic_cast<ActiveMQDestination*>(
-                    looseUnmarshalNestedObject(wireFormat, dataIn))));
+            info->setSubscribedDestination(
+                std::dynamic_pointer_cast<ActiveMQDestination>(
+                    looseUnmarshalInternedNestedObject(wireFormat, dataIn)));
+        }
+        if (wireVersion >= 11)
+        {
+            info->setNoLocal(dataIn->readBoolean());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void SubscriptionInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                                DataStructure*  dataStructure,
+                                                ByteReader*     dataIn)
+{
+    try
+    {
+        BaseDataStreamMarshaller::looseUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn);
+        SubscriptionInfo* info = dynamic_cast<SubscriptionInfo*>(dataStructure);
+
+        int wireVersion = wireFormat->getVersion();
+
+        info->setClientId(looseUnmarshalString(dataIn));
+        info->setDestination(std::dynamic_pointer_cast<ActiveMQDestination>(
+            looseUnmarshalInternedCachedObject(wireFormat, dataIn)));
+        info->setSelector(looseUnmarshalString(dataIn));
+        info->setSubcriptionName(looseUnmarshalString(dataIn));
+        if (wireVersion >= 3)
+        {
+            info->setSubscribedDestination(
+                std::dynamic_pointer_cast<ActiveMQDestination>(
+                    looseUnmarshalInternedNestedObject(wireFormat, dataIn)));
         }
         if (wireVersion >= 11)
         {
@@ -248,3 +367,40 @@ void SubscriptionInfoMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void SubscriptionInfoMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteWriter*     dataOut)
+{
+    try
+    {
+        SubscriptionInfo* info = dynamic_cast<SubscriptionInfo*>(dataStructure);
+        BaseDataStreamMarshaller::looseMarshal(wireFormat,
+                                               dataStructure,
+                                               dataOut);
+
+        int wireVersion = wireFormat->getVersion();
+
+        looseMarshalString(info->getClientId(), dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getDestination().get(),
+                                 dataOut);
+        looseMarshalString(info->getSelector(), dataOut);
+        looseMarshalString(info->getSubcriptionName(), dataOut);
+        if (wireVersion >= 3)
+        {
+            looseMarshalNestedObject(wireFormat,
+                                     info->getSubscribedDestination().get(),
+                                     dataOut);
+        }
+        if (wireVersion >= 11)
+        {
+            dataOut->writeBoolean(info->isNoLocal());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
@@ -66,12 +66,36 @@ void TransactionInfoMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
                                               bs);
 
         TransactionInfo* info = dynamic_cast<TransactionInfo*>(dataStructure);
-        info->setConnectionId(
-            std::shared_ptr<ConnectionId>(dynamic_cast<ConnectionId*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
-        info->setTransactionId(
-            std::shared_ptr<TransactionId>(dynamic_cast<TransactionId*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
+        info->setTransactionId(std::dynamic_pointer_cast<TransactionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
+        info->setType(dataIn->readByte());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TransactionInfoMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn,
+                                               BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn,
+                                              bs);
+
+        TransactionInfo* info = dynamic_cast<TransactionInfo*>(dataStructure);
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
+        info->setTransactionId(std::dynamic_pointer_cast<TransactionId>(
+            tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
         info->setType(dataIn->readByte());
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -136,6 +160,36 @@ void TransactionInfoMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void TransactionInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteWriter*     dataOut,
+                                              BooleanStream*  bs)
+{
+    try
+    {
+        BaseCommandMarshaller::tightMarshal2(wireFormat,
+                                             dataStructure,
+                                             dataOut,
+                                             bs);
+
+        TransactionInfo* info = dynamic_cast<TransactionInfo*>(dataStructure);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getConnectionId().get(),
+                                  dataOut,
+                                  bs);
+        tightMarshalCachedObject2(wireFormat,
+                                  info->getTransactionId().get(),
+                                  dataOut,
+                                  bs);
+        dataOut->write(info->getType());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void TransactionInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                                DataStructure*   dataStructure,
@@ -147,12 +201,33 @@ void TransactionInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                               dataStructure,
                                               dataIn);
         TransactionInfo* info = dynamic_cast<TransactionInfo*>(dataStructure);
-        info->setConnectionId(
-            std::shared_ptr<ConnectionId>(dynamic_cast<ConnectionId*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
-        info->setTransactionId(
-            std::shared_ptr<TransactionId>(dynamic_cast<TransactionId*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
+        info->setTransactionId(std::dynamic_pointer_cast<TransactionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
+        info->setType(dataIn->readByte());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TransactionInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn)
+{
+    try
+    {
+        BaseCommandMarshaller::looseUnmarshal(wireFormat,
+                                              dataStructure,
+                                              dataIn);
+        TransactionInfo* info = dynamic_cast<TransactionInfo*>(dataStructure);
+        info->setConnectionId(std::dynamic_pointer_cast<ConnectionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
+        info->setTransactionId(std::dynamic_pointer_cast<TransactionId>(
+            looseUnmarshalCachedObject(wireFormat, dataIn)));
         info->setType(dataIn->readByte());
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -183,3 +258,26 @@ void TransactionInfoMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void TransactionInfoMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                             DataStructure*  dataStructure,
+                                             ByteWriter*     dataOut)
+{
+    try
+    {
+        TransactionInfo* info = dynamic_cast<TransactionInfo*>(dataStructure);
+        BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getConnectionId().get(),
+                                 dataOut);
+        looseMarshalCachedObject(wireFormat,
+                                 info->getTransactionId().get(),
+                                 dataOut);
+        dataOut->write(info->getType());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
@@ -80,6 +80,34 @@ void WireFormatInfoMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void WireFormatInfoMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteReader*     dataIn,
+                                              BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn,
+                                                 bs);
+
+        WireFormatInfo* info = dynamic_cast<WireFormatInfo*>(dataStructure);
+        info->beforeUnmarshal(wireFormat);
+
+        info->setMagic(tightUnmarshalConstByteArray(dataIn, bs, 8));
+        info->setVersion(dataIn->readInt());
+        info->setMarshalledProperties(tightUnmarshalByteArray(dataIn, bs));
+
+        info->afterUnmarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int WireFormatInfoMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                             DataStructure*  dataStructure,
@@ -139,6 +167,39 @@ void WireFormatInfoMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void WireFormatInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                             DataStructure*  dataStructure,
+                                             ByteWriter*     dataOut,
+                                             BooleanStream*  bs)
+{
+    try
+    {
+        BaseDataStreamMarshaller::tightMarshal2(wireFormat,
+                                                dataStructure,
+                                                dataOut,
+                                                bs);
+
+        WireFormatInfo* info = dynamic_cast<WireFormatInfo*>(dataStructure);
+        dataOut->write((const unsigned char*)(&info->getMagic()[0]), 8, 0, 8);
+        dataOut->writeInt(info->getVersion());
+        if (bs->readBoolean())
+        {
+            dataOut->writeInt((int)info->getMarshalledProperties().size());
+            dataOut->write(
+                (const unsigned char*)(&info->getMarshalledProperties()[0]),
+                (int)info->getMarshalledProperties().size(),
+                0,
+                (int)info->getMarshalledProperties().size());
+        }
+        info->afterMarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void WireFormatInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                               DataStructure*   dataStructure,
@@ -162,6 +223,29 @@ void WireFormatInfoMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void WireFormatInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteReader*     dataIn)
+{
+    try
+    {
+        BaseDataStreamMarshaller::looseUnmarshal(wireFormat,
+                                                 dataStructure,
+                                                 dataIn);
+        WireFormatInfo* info = dynamic_cast<WireFormatInfo*>(dataStructure);
+        info->beforeUnmarshal(wireFormat);
+        info->setMagic(looseUnmarshalConstByteArray(dataIn, 8));
+        info->setVersion(dataIn->readInt());
+        info->setMarshalledProperties(looseUnmarshalByteArray(dataIn));
+        info->afterUnmarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void WireFormatInfoMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                             DataStructure*    dataStructure,
@@ -193,3 +277,35 @@ void WireFormatInfoMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void WireFormatInfoMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                            DataStructure*  dataStructure,
+                                            ByteWriter*     dataOut)
+{
+    try
+    {
+        WireFormatInfo* info = dynamic_cast<WireFormatInfo*>(dataStructure);
+        info->beforeMarshal(wireFormat);
+        BaseDataStreamMarshaller::looseMarshal(wireFormat,
+                                               dataStructure,
+                                               dataOut);
+        dataOut->write((const unsigned char*)(&info->getMagic()[0]), 8, 0, 8);
+        dataOut->writeInt(info->getVersion());
+        dataOut->write(info->getMarshalledProperties().size() != 0);
+        if (info->getMarshalledProperties().size() != 0)
+        {
+            dataOut->writeInt((int)info->getMarshalledProperties().size());
+            dataOut->write(
+                (const unsigned char*)(&info->getMarshalledProperties()[0]),
+                (int)info->getMarshalledProperties().size(),
+                0,
+                (int)info->getMarshalledProperties().size());
+        }
+        info->afterMarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
@@ -76,6 +76,30 @@ void XATransactionIdMarshaller::tightUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void XATransactionIdMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn,
+                                               BooleanStream*  bs)
+{
+    try
+    {
+        TransactionIdMarshaller::tightUnmarshal(wireFormat,
+                                                dataStructure,
+                                                dataIn,
+                                                bs);
+
+        XATransactionId* info = dynamic_cast<XATransactionId*>(dataStructure);
+        info->setFormatId(dataIn->readInt());
+        info->setGlobalTransactionId(tightUnmarshalByteArray(dataIn, bs));
+        info->setBranchQualifier(tightUnmarshalByteArray(dataIn, bs));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int XATransactionIdMarshaller::tightMarshal1(OpenWireFormat* wireFormat,
                                              DataStructure*  dataStructure,
@@ -145,6 +169,46 @@ void XATransactionIdMarshaller::tightMarshal2(OpenWireFormat*   wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void XATransactionIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
+                                              DataStructure*  dataStructure,
+                                              ByteWriter*     dataOut,
+                                              BooleanStream*  bs)
+{
+    try
+    {
+        TransactionIdMarshaller::tightMarshal2(wireFormat,
+                                               dataStructure,
+                                               dataOut,
+                                               bs);
+
+        XATransactionId* info = dynamic_cast<XATransactionId*>(dataStructure);
+        dataOut->writeInt(info->getFormatId());
+        if (bs->readBoolean())
+        {
+            dataOut->writeInt((int)info->getGlobalTransactionId().size());
+            dataOut->write(
+                (const unsigned char*)(&info->getGlobalTransactionId()[0]),
+                (int)info->getGlobalTransactionId().size(),
+                0,
+                (int)info->getGlobalTransactionId().size());
+        }
+        if (bs->readBoolean())
+        {
+            dataOut->writeInt((int)info->getBranchQualifier().size());
+            dataOut->write(
+                (const unsigned char*)(&info->getBranchQualifier()[0]),
+                (int)info->getBranchQualifier().size(),
+                0,
+                (int)info->getBranchQualifier().size());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void XATransactionIdMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
                                                DataStructure*   dataStructure,
@@ -166,6 +230,27 @@ void XATransactionIdMarshaller::looseUnmarshal(OpenWireFormat*  wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void XATransactionIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
+                                               DataStructure*  dataStructure,
+                                               ByteReader*     dataIn)
+{
+    try
+    {
+        TransactionIdMarshaller::looseUnmarshal(wireFormat,
+                                                dataStructure,
+                                                dataIn);
+        XATransactionId* info = dynamic_cast<XATransactionId*>(dataStructure);
+        info->setFormatId(dataIn->readInt());
+        info->setGlobalTransactionId(looseUnmarshalByteArray(dataIn));
+        info->setBranchQualifier(looseUnmarshalByteArray(dataIn));
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void XATransactionIdMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                              DataStructure*    dataStructure,
@@ -204,3 +289,42 @@ void XATransactionIdMarshaller::looseMarshal(OpenWireFormat*   wireFormat,
                                 decaf::io::IOException)
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void XATransactionIdMarshaller::looseMarshal(OpenWireFormat* wireFormat,
+                                             DataStructure*  dataStructure,
+                                             ByteWriter*     dataOut)
+{
+    try
+    {
+        XATransactionId* info = dynamic_cast<XATransactionId*>(dataStructure);
+        TransactionIdMarshaller::looseMarshal(wireFormat,
+                                              dataStructure,
+                                              dataOut);
+        dataOut->writeInt(info->getFormatId());
+        dataOut->write(info->getGlobalTransactionId().size() != 0);
+        if (info->getGlobalTransactionId().size() != 0)
+        {
+            dataOut->writeInt((int)info->getGlobalTransactionId().size());
+            dataOut->write(
+                (const unsigned char*)(&info->getGlobalTransactionId()[0]),
+                (int)info->getGlobalTransactionId().size(),
+                0,
+                (int)info->getGlobalTransactionId().size());
+        }
+        dataOut->write(info->getBranchQualifier().size() != 0);
+        if (info->getBranchQualifier().size() != 0)
+        {
+            dataOut->writeInt((int)info->getBranchQualifier().size());
+            dataOut->write(
+                (const unsigned char*)(&info->getBranchQualifier()[0]),
+                (int)info->getBranchQualifier().size(),
+                0,
+                (int)info->getBranchQualifier().size());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException,
+                                decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
@@ -18,6 +18,7 @@
 #include <activemq/wireformat/openwire/utils/BooleanStream.h>
 
 #include <activemq/exceptions/ActiveMQException.h>
+#include <decaf/lang/Short.h>
 
 using namespace std;
 using namespace activemq;
@@ -50,6 +51,14 @@ bool BooleanStream::readBoolean()
 {
     try
     {
+        if (arrayPos >= arrayLimit)
+        {
+            throw IOException(__FILE__,
+                              __LINE__,
+                              "BooleanStream::readBoolean - "
+                              "Read past the end of the stream.");
+        }
+
         unsigned char b  = data[arrayPos];
         bool          rc = ((b >> bytePos) & 0x01) != 0;
         bytePos++;
@@ -72,6 +81,14 @@ void BooleanStream::writeBoolean(bool value)
     {
         if (bytePos == 0)
         {
+            if (arrayLimit == Short::MAX_VALUE)
+            {
+                throw IOException(__FILE__,
+                                  __LINE__,
+                                  "BooleanStream::writeBoolean - "
+                                  "Stream has reached its maximum size.");
+            }
+
             arrayLimit++;
 
             if ((size_t)arrayLimit >= data.size())
@@ -101,7 +118,8 @@ void BooleanStream::writeBoolean(bool value)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void BooleanStream::marshal(DataOutputStream* dataOut)
+template <typename Out>
+void BooleanStream::doMarshal(Out* dataOut)
 {
     try
     {
@@ -121,7 +139,10 @@ void BooleanStream::marshal(DataOutputStream* dataOut)
         }
 
         // Dump the payload
-        dataOut->write(&data[0], (int)data.size(), 0, arrayLimit);
+        if (arrayLimit > 0)
+        {
+            dataOut->write(&data[0], (int)data.size(), 0, arrayLimit);
+        }
         clear();
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -129,6 +150,18 @@ void BooleanStream::marshal(DataOutputStream* dataOut)
     AMQ_CATCHALL_THROW(IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void BooleanStream::marshal(DataOutputStream* dataOut)
+{
+    doMarshal(dataOut);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void BooleanStream::marshal(ByteWriter* dataOut)
+{
+    doMarshal(dataOut);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void BooleanStream::marshal(std::vector<unsigned char>& dataOut)
 {
@@ -151,7 +184,7 @@ void BooleanStream::marshal(std::vector<unsigned char>& dataOut)
         }
 
         // Insert all data from data into the passed buffer
-        dataOut.insert(dataOut.end(), &data[0], &data[arrayLimit - 1]);
+        dataOut.insert(dataOut.end(), data.begin(), data.begin() + arrayLimit);
     }
     AMQ_CATCH_RETHROW(IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
@@ -159,7 +192,8 @@ void BooleanStream::marshal(std::vector<unsigned char>& dataOut)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void BooleanStream::unmarshal(DataInputStream* dataIn)
+template <typename In>
+void BooleanStream::doUnmarshal(In* dataIn)
 {
     try
     {
@@ -174,11 +208,23 @@ void BooleanStream::unmarshal(DataInputStream* dataIn)
             arrayLimit = dataIn->readShort();
         }
 
+        if (arrayLimit < 0)
+        {
+            arrayLimit = 0;
+            throw IOException(__FILE__,
+                              __LINE__,
+                              "BooleanStream::unmarshal - "
+                              "Invalid stream size encountered.");
+        }
+
         // Make sure we can accomodate all the data.
         data.resize(arrayLimit);
 
         // Make sure we get all the data we are expecting
-        dataIn->readFully(&data[0], (int)data.size(), 0, arrayLimit);
+        if (arrayLimit > 0)
+        {
+            dataIn->readFully(&data[0], (int)data.size(), 0, arrayLimit);
+        }
 
         clear();
     }
@@ -187,6 +233,18 @@ void BooleanStream::unmarshal(DataInputStream* dataIn)
     AMQ_CATCHALL_THROW(IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void BooleanStream::unmarshal(DataInputStream* dataIn)
+{
+    doUnmarshal(dataIn);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void BooleanStream::unmarshal(ByteReader* dataIn)
+{
+    doUnmarshal(dataIn);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void BooleanStream::clear()
 {
@@ -19,6 +19,8 @@
 #define _ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_BOOLEANSTREAM_H_
 
 #include <activemq/util/Config.h>
+#include <activemq/wireformat/openwire/utils/ByteReader.h>
+#include <activemq/wireformat/openwire/utils/ByteWriter.h>
 #include <decaf/io/DataInputStream.h>
 #include <decaf/io/DataOutputStream.h>
 
@@ -99,6 +101,7 @@ namespace wireformat
                  * operation.
                  */
                 void marshal(decaf::io::DataOutputStream* dataOut);
+                void marshal(ByteWriter* dataOut);
 
                 /**
                  * Marshal the data to a STL vector of unsigned chars
@@ -117,6 +120,7 @@ namespace wireformat
                  * operation.
                  */
                 void unmarshal(decaf::io::DataInputStream* dataIn);
+                void unmarshal(ByteReader* dataIn);
 
                 /**
                  * Clears to old position markers, data starts at the beginning
@@ -128,6 +132,13 @@ namespace wireformat
                  * @return int size of marshalled data.
                  */
                 int marshalledSize();
+
+            private:
+                template <typename Out>
+                void doMarshal(Out* dataOut);
+
+                template <typename In>
+                void doUnmarshal(In* dataIn);
             };
 
         }  // namespace utils
@@ -0,0 +1,76 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ByteReader.h"
+
+#include <decaf/internal/util/ModifiedUTF8.h>
+#include <decaf/io/EOFException.h>
+#include <decaf/lang/exceptions/IndexOutOfBoundsException.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+using namespace decaf::io;
+using namespace decaf::internal::util;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+std::string ByteReader::readUTF()
+{
+    std::size_t utfLength = readUnsignedShort();
+    require(utfLength);
+
+    const unsigned char* bytes  = this->data + this->position;
+    this->position             += utfLength;
+
+    std::string result(utfLength, '\0');
+    if (utfLength > 0)
+    {
+        result.resize(ModifiedUTF8::decode(bytes, utfLength, &result[0]));
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteReader::throwEOF(std::size_t count) const
+{
+    throw EOFException(__FILE__,
+                       __LINE__,
+                       "ByteReader - Read of %d bytes at offset %d runs past "
+                       "the end of the %d byte span",
+                       (int)count,
+                       (int)this->position,
+                       (int)this->size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteReader::checkRange(int size, int offset, int length)
+{
+    if (offset < 0 || length < 0 || offset > size - length)
+    {
+        throw IndexOutOfBoundsException(
+            __FILE__,
+            __LINE__,
+            "ByteReader - offset %d and length %d exceed buffer size %d",
+            offset,
+            length,
+            size);
+    }
+}
@@ -0,0 +1,221 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_BYTEREADER_H_
+#define _ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_BYTEREADER_H_
+
+#include <activemq/util/Config.h>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace activemq
+{
+namespace wireformat
+{
+    namespace openwire
+    {
+        namespace utils
+        {
+
+            /**
+             * Bounds checked reader over a contiguous span of bytes holding
+             * OpenWire data, such as a complete frame buffered by the
+             * OpenWireFrameDecoder.
+             *
+             * The reader mirrors the parts of the DataInputStream interface
+             * that the marshallers use, big endian primitives, readFully and
+             * modified UTF-8 strings, so the generated code reads the same
+             * against either form.  Unlike the stream, every primitive is an
+             * inline load from the span with no virtual calls or locking, and
+             * a read past the end of the span throws an EOFException.
+             *
+             * The reader does not own the bytes, they must outlive it.
+             */
+            class AMQCPP_API ByteReader
+            {
+            private:
+                const unsigned char* data;
+                std::size_t          size;
+                std::size_t          position;
+
+            public:
+                /**
+                 * Creates a reader over the given bytes.
+                 *
+                 * @param data
+                 *      The first byte of the span, may be NULL if size is 0.
+                 * @param size
+                 *      The number of bytes in the span.
+                 */
+                ByteReader(const unsigned char* data, std::size_t size)
+                    : data(data),
+                      size(size),
+                      position(0)
+                {
+                }
+
+                /**
+                 * @return the first byte of the span being read.
+                 */
+                const unsigned char* getData() const
+                {
+                    return this->data;
+                }
+
+                /**
+                 * @return the total number of bytes in the span.
+                 */
+                std::size_t getSize() const
+                {
+                    return this->size;
+                }
+
+                /**
+                 * @return the offset of the next byte to be read.
+                 */
+                std::size_t getPosition() const
+                {
+                    return this->position;
+                }
+
+                /**
+                 * @return the number of bytes left to read.
+                 */
+                std::size_t remaining() const
+                {
+                    return this->size - this->position;
+                }
+
+                /**
+                 * Skips over the given number of bytes.
+                 *
+                 * @throws EOFException if fewer bytes than that remain.
+                 */
+                void skip(std::size_t count)
+                {
+                    require(count);
+                    this->position += count;
+                }
+
+                bool readBoolean()
+                {
+                    return readByte() != 0;
+                }
+
+                unsigned char readByte()
+                {
+                    require(1);
+                    return this->data[this->position++];
+                }
+
+                short readShort()
+                {
+                    return (short)readUnsignedShort();
+                }
+
+                unsigned short readUnsignedShort()
+                {
+                    require(2);
+                    const unsigned char* bytes  = this->data + this->position;
+                    this->position             += 2;
+                    return (unsigned short)((bytes[0] << 8) | bytes[1]);
+                }
+
+                int readInt()
+                {
+                    require(4);
+                    const unsigned char* bytes  = this->data + this->position;
+                    this->position             += 4;
+                    return (int)(((unsigned int)bytes[0] << 24) |
+                                 ((unsigned int)bytes[1] << 16) |
+                                 ((unsigned int)bytes[2] << 8) |
+                                 (unsigned int)bytes[3]);
+                }
+
+                long long readLong()
+                {
+                    unsigned long long high = (unsigned int)readInt();
+                    unsigned long long low  = (unsigned int)readInt();
+                    return (long long)((high << 32) | low);
+                }
+
+                /**
+                 * Copies the next length bytes into the given buffer.
+                 *
+                 * @throws EOFException if fewer than length bytes remain.
+                 * @throws IndexOutOfBoundsException if length is negative.
+                 */
+                void readFully(unsigned char* buffer, int length)
+                {
+                    readFully(buffer, length, 0, length);
+                }
+
+                /**
+                 * Copies the next length bytes into the given buffer starting
+                 * at offset, the buffer holding size bytes in total.
+                 *
+                 * @throws EOFException if fewer than length bytes remain.
+                 * @throws IndexOutOfBoundsException if offset and length do not
+                 * describe a range within the buffer.
+                 */
+                void readFully(unsigned char* buffer,
+                               int            size,
+                               int            offset,
+                               int            length)
+                {
+                    checkRange(size, offset, length);
+                    require((std::size_t)length);
+                    if (length > 0)
+                    {
+                        std::memcpy(buffer + offset,
+                                    this->data + this->position,
+                                    (std::size_t)length);
+                        this->position += (std::size_t)length;
+                    }
+                }
+
+                /**
+                 * Reads a string written by DataOutputStream::writeUTF, an
+                 * unsigned short length followed by that many bytes of
+                 * modified UTF-8 encoding characters in the range 0-255.
+                 *
+                 * @throws EOFException if the string runs past the span.
+                 * @throws UTFDataFormatException if the bytes are not valid.
+                 */
+                std::string readUTF();
+
+            private:
+                void require(std::size_t count) const
+                {
+                    if (this->size - this->position < count)
+                    {
+                        throwEOF(count);
+                    }
+                }
+
+                void throwEOF(std::size_t count) const;
+
+                static void checkRange(int size, int offset, int length);
+            };
+
+        }  // namespace utils
+    }  // namespace openwire
+}  // namespace wireformat
+}  // namespace activemq
+
+#endif /*_ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_BYTEREADER_H_*/
@@ -0,0 +1,69 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ByteWriter.h"
+
+#include <decaf/internal/util/ModifiedUTF8.h>
+#include <decaf/io/UTFDataFormatException.h>
+#include <decaf/lang/exceptions/IndexOutOfBoundsException.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+using namespace decaf::io;
+using namespace decaf::internal::util;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteWriter::writeUTF(const std::string& value)
+{
+    std::size_t length    = value.length();
+    std::size_t utfLength = ModifiedUTF8::encodedLength(value.c_str(), length);
+
+    if (utfLength > 65535)
+    {
+        throw UTFDataFormatException(
+            __FILE__,
+            __LINE__,
+            "Attempted to write a string as UTF-8 whose length is longer "
+            "than the supported 65535 bytes");
+    }
+
+    writeUnsignedShort((unsigned short)utfLength);
+
+    if (utfLength > 0)
+    {
+        ModifiedUTF8::encode(value.c_str(), length, grow(utfLength));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteWriter::checkRange(int size, int offset, int length)
+{
+    if (offset < 0 || length < 0 || offset > size - length)
+    {
+        throw IndexOutOfBoundsException(
+            __FILE__,
+            __LINE__,
+            "ByteWriter - offset %d and length %d exceed buffer size %d",
+            offset,
+            length,
+            size);
+    }
+}
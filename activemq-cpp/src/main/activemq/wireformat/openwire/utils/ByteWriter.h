@@ -0,0 +1,205 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_BYTEWRITER_H_
+#define _ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_BYTEWRITER_H_
+
+#include <activemq/util/Config.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace activemq
+{
+namespace wireformat
+{
+    namespace openwire
+    {
+        namespace utils
+        {
+
+            /**
+             * Appends OpenWire data to a contiguous byte buffer.
+             *
+             * The writer mirrors the parts of the DataOutputStream interface
+             * that the marshallers use so the generated code writes the same
+             * against either form.  Every primitive is an inline append to the
+             * buffer with no virtual calls or locking, the buffer grows as
+             * needed and keeps its capacity when cleared so it can be reused
+             * from one command to the next.
+             *
+             * The writer does not own the buffer, it must outlive it.
+             */
+            class AMQCPP_API ByteWriter
+            {
+            private:
+                std::vector<unsigned char>* buffer;
+
+            private:
+                ByteWriter(const ByteWriter&);
+                ByteWriter& operator=(const ByteWriter&);
+
+            public:
+                /**
+                 * Creates a writer that appends to the given buffer.
+                 */
+                explicit ByteWriter(std::vector<unsigned char>& buffer)
+                    : buffer(&buffer)
+                {
+                }
+
+                /**
+                 * @return the number of bytes in the buffer.
+                 */
+                std::size_t size() const
+                {
+                    return this->buffer->size();
+                }
+
+                /**
+                 * @return the first byte of the buffer, only valid until the
+                 * next write.
+                 */
+                const unsigned char* getData() const
+                {
+                    return this->buffer->data();
+                }
+
+                void write(unsigned char value)
+                {
+                    this->buffer->push_back(value);
+                }
+
+                void write(const unsigned char* bytes, int length)
+                {
+                    write(bytes, length, 0, length);
+                }
+
+                /**
+                 * Appends length bytes from the given buffer starting at
+                 * offset, the buffer holding size bytes in total.
+                 *
+                 * @throws IndexOutOfBoundsException if offset and length do not
+                 * describe a range within the buffer.
+                 */
+                void write(const unsigned char* bytes,
+                           int                  size,
+                           int                  offset,
+                           int                  length)
+                {
+                    checkRange(size, offset, length);
+                    this->buffer->insert(this->buffer->end(),
+                                         bytes + offset,
+                                         bytes + offset + length);
+                }
+
+                void writeBoolean(bool value)
+                {
+                    this->buffer->push_back(value ? 1 : 0);
+                }
+
+                void writeByte(unsigned char value)
+                {
+                    this->buffer->push_back(value);
+                }
+
+                void writeShort(short value)
+                {
+                    writeUnsignedShort((unsigned short)value);
+                }
+
+                void writeUnsignedShort(unsigned short value)
+                {
+                    unsigned char* bytes = grow(2);
+                    bytes[0]             = (unsigned char)(value >> 8);
+                    bytes[1]             = (unsigned char)value;
+                }
+
+                void writeInt(int value)
+                {
+                    unsigned char* bytes = grow(4);
+                    bytes[0]             = (unsigned char)(value >> 24);
+                    bytes[1]             = (unsigned char)(value >> 16);
+                    bytes[2]             = (unsigned char)(value >> 8);
+                    bytes[3]             = (unsigned char)value;
+                }
+
+                void writeLong(long long value)
+                {
+                    writeInt((int)(value >> 32));
+                    writeInt((int)value);
+                }
+
+                /**
+                 * Overwrites four bytes already in the buffer at the given
+                 * offset with the big-endian form of value, used to fill in a
+                 * size prefix once the data it covers has been written.
+                 *
+                 * @throws IndexOutOfBoundsException if the four bytes are not
+                 * all within the buffer.
+                 */
+                void setInt(std::size_t offset, int value)
+                {
+                    if (offset + 4 > this->buffer->size())
+                    {
+                        checkRange((int)this->buffer->size(), (int)offset, 4);
+                    }
+
+                    unsigned char* bytes = this->buffer->data() + offset;
+                    bytes[0]             = (unsigned char)(value >> 24);
+                    bytes[1]             = (unsigned char)(value >> 16);
+                    bytes[2]             = (unsigned char)(value >> 8);
+                    bytes[3]             = (unsigned char)value;
+                }
+
+                /**
+                 * Appends the characters of the string as single bytes with no
+                 * length prefix.
+                 */
+                void writeBytes(const std::string& value)
+                {
+                    this->buffer->insert(this->buffer->end(),
+                                         value.begin(),
+                                         value.end());
+                }
+
+                /**
+                 * Appends the string as DataOutputStream::writeUTF would, an
+                 * unsigned short length followed by modified UTF-8.
+                 *
+                 * @throws UTFDataFormatException if the encoded form is longer
+                 * than 65535 bytes.
+                 */
+                void writeUTF(const std::string& value);
+
+            private:
+                unsigned char* grow(std::size_t count)
+                {
+                    std::size_t offset = this->buffer->size();
+                    this->buffer->resize(offset + count);
+                    return this->buffer->data() + offset;
+                }
+
+                static void checkRange(int size, int offset, int length);
+            };
+
+        }  // namespace utils
+    }  // namespace openwire
+}  // namespace wireformat
+}  // namespace activemq
+
+#endif /*_ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_BYTEWRITER_H_*/
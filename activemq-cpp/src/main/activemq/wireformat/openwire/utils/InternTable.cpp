@@ -0,0 +1,130 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "InternTable.h"
+
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+InternTable::InternTable(int capacity)
+    : entries(),
+      index(),
+      capacity(0)
+{
+    this->setCapacity(capacity);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+InternTable::~InternTable()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void InternTable::setCapacity(int capacity)
+{
+    if (capacity < 0)
+    {
+        throw IllegalArgumentException(
+            __FILE__,
+            __LINE__,
+            "InternTable - Capacity must not be negative: %d",
+            capacity);
+    }
+
+    this->capacity = capacity;
+
+    while ((int)this->index.size() > this->capacity)
+    {
+        this->evict();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<DataStructure> InternTable::get(const std::string& key)
+{
+    std::unordered_map<std::string, EntryList::iterator>::iterator iter =
+        this->index.find(key);
+
+    if (iter == this->index.end())
+    {
+        return std::shared_ptr<DataStructure>();
+    }
+
+    // Moving the node keeps the iterator held by the index valid.
+    this->entries.splice(this->entries.begin(), this->entries, iter->second);
+
+    return iter->second->object;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void InternTable::put(const std::string&                    key,
+                      const std::shared_ptr<DataStructure>& object)
+{
+    if (this->capacity == 0)
+    {
+        return;
+    }
+
+    std::pair<std::unordered_map<std::string, EntryList::iterator>::iterator,
+              bool>
+        result = this->index.emplace(key, this->entries.end());
+
+    if (!result.second)
+    {
+        result.first->second->object = object;
+        this->entries.splice(this->entries.begin(),
+                             this->entries,
+                             result.first->second);
+        return;
+    }
+
+    Entry entry;
+    entry.key    = &result.first->first;
+    entry.object = object;
+
+    this->entries.push_front(entry);
+    result.first->second = this->entries.begin();
+
+    if ((int)this->index.size() > this->capacity)
+    {
+        this->evict();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void InternTable::clear()
+{
+    this->index.clear();
+    this->entries.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void InternTable::evict()
+{
+    // The list only points at the index's own copy of the key, so find the
+    // entry before either of them goes.
+    this->index.erase(this->index.find(*this->entries.back().key));
+    this->entries.pop_back();
+}
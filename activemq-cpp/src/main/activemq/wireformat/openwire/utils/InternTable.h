@@ -0,0 +1,151 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_INTERNTABLE_H_
+#define _ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_INTERNTABLE_H_
+
+#include <activemq/commands/DataStructure.h>
+#include <activemq/util/Config.h>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace activemq
+{
+namespace wireformat
+{
+    namespace openwire
+    {
+        namespace utils
+        {
+
+            /**
+             * Bounded table of shared DataStructure instances keyed by the
+             * bytes they were unmarshaled from.  Once full the least
+             * recently used entry is dropped to make room for a new one.
+             *
+             * The instances handed out are shared by every command that
+             * refers to them and must be treated as immutable.  The table
+             * isn't thread safe, the OpenWireFormat only uses it from the
+             * thread that unmarshals.
+             */
+            class AMQCPP_API InternTable
+            {
+            private:
+                struct Entry
+                {
+                    const std::string*                       key;
+                    std::shared_ptr<commands::DataStructure> object;
+                };
+
+                typedef std::list<Entry> EntryList;
+
+                // Most recently used entry first.
+                EntryList entries;
+
+                std::unordered_map<std::string, EntryList::iterator> index;
+
+                int capacity;
+
+            private:
+                InternTable(const InternTable&);
+                InternTable& operator=(const InternTable&);
+
+            public:
+                /**
+                 * Creates a table that holds up to the given number of
+                 * entries, a capacity of zero disables it.
+                 *
+                 * @param capacity
+                 *      The maximum number of entries to hold.
+                 *
+                 * @throws IllegalArgumentException if capacity is negative.
+                 */
+                explicit InternTable(int capacity);
+
+                ~InternTable();
+
+                /**
+                 * @return the maximum number of entries held.
+                 */
+                int getCapacity() const
+                {
+                    return this->capacity;
+                }
+
+                /**
+                 * Changes the maximum number of entries held, evicting the
+                 * least recently used ones if there are now too many.
+                 *
+                 * @param capacity
+                 *      The maximum number of entries to hold, zero disables
+                 *      the table.
+                 *
+                 * @throws IllegalArgumentException if capacity is negative.
+                 */
+                void setCapacity(int capacity);
+
+                /**
+                 * @return the number of entries currently held.
+                 */
+                int size() const
+                {
+                    return (int)this->index.size();
+                }
+
+                /**
+                 * Looks up the instance stored for the given key and marks
+                 * it as the most recently used.
+                 *
+                 * @param key
+                 *      The bytes the instance was unmarshaled from.
+                 *
+                 * @return the shared instance or an empty pointer if there is
+                 * none.
+                 */
+                std::shared_ptr<commands::DataStructure> get(
+                    const std::string& key);
+
+                /**
+                 * Stores an instance under the given key, replacing any held
+                 * there already.  Does nothing when the table is disabled.
+                 *
+                 * @param key
+                 *      The bytes the instance was unmarshaled from.
+                 * @param object
+                 *      The instance to share.
+                 */
+                void put(
+                    const std::string&                              key,
+                    const std::shared_ptr<commands::DataStructure>& object);
+
+                /**
+                 * Removes every entry.
+                 */
+                void clear();
+
+            private:
+                void evict();
+            };
+
+        }  // namespace utils
+    }  // namespace openwire
+}  // namespace wireformat
+}  // namespace activemq
+
+#endif /*_ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_INTERNTABLE_H_*/
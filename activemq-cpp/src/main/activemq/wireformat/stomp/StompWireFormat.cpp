@@ -121,7 +121,7 @@ StompWireFormat::~StompWireFormat()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void StompWireFormat::marshal(const std::shared_ptr<Command>        command,
+void StompWireFormat::marshal(const std::shared_ptr<Command>&       command,
                               const activemq::transport::Transport* transport,
                               decaf::io::DataOutputStream*          out)
 {
@@ -80,9 +80,9 @@ namespace wireformat
              * @throws IOException
              */
             virtual void marshal(
-                const std::shared_ptr<commands::Command> command,
-                const activemq::transport::Transport*    transport,
-                decaf::io::DataOutputStream*             out);
+                const std::shared_ptr<commands::Command>& command,
+                const activemq::transport::Transport*     transport,
+                decaf::io::DataOutputStream*              out);
 
             /**
              * Stream based un-marshaling, blocks on reads on the input stream
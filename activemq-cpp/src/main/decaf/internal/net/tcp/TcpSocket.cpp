@@ -23,6 +23,8 @@
 #include <decaf/internal/net/tcp/TcpSocketInputStream.h>
 #include <decaf/internal/net/tcp/TcpSocketOutputStream.h>
 
+#include <decaf/io/EOFException.h>
+
 #include <decaf/lang/Character.h>
 #include <decaf/lang/exceptions/UnsupportedOperationException.h>
 #include <decaf/net/SocketError.h>
@@ -35,9 +37,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <chrono>
+#include <condition_variable>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 using namespace decaf;
 using namespace decaf::internal;
@@ -59,6 +65,44 @@ namespace internal
         namespace tcp
         {
 
+            /**
+             * State shared between a TcpSocket and the completion handlers of
+             * its push driven read loop.  The handlers hold a reference to it
+             * so a completion that races with close() or destruction never
+             * touches a destroyed socket, the stopped flag is checked under
+             * the mutex before the socket is used again.
+             */
+            class AsyncReadState
+            {
+            private:
+                AsyncReadState(const AsyncReadState&);
+                AsyncReadState& operator=(const AsyncReadState&);
+
+            public:
+                std::mutex                 mutex;
+                std::condition_variable    idle;
+                asio::ip::tcp::socket*     socket;
+                SocketReadListener*        listener;
+                std::vector<unsigned char> buffer;
+                bool                       stopped;
+                bool                       dispatching;
+                std::thread::id            dispatchThread;
+
+                AsyncReadState(asio::ip::tcp::socket* socket,
+                               SocketReadListener*    listener,
+                               int                    bufferSize)
+                    : mutex(),
+                      idle(),
+                      socket(socket),
+                      listener(listener),
+                      buffer(bufferSize),
+                      stopped(false),
+                      dispatching(false),
+                      dispatchThread()
+                {
+                }
+            };
+
             class TcpSocketImpl
             {
             public:
@@ -96,6 +140,9 @@ namespace internal
                 int sendBufferSize;  // -1 = not set
                 int recvBufferSize;  // -1 = not set
 
+                // Active push driven read loop, if any.
+                std::shared_ptr<AsyncReadState> asyncRead;
+
                 TcpSocketImpl()
                     : ioContext(IoContextManager::getInstance().getIoContext()),
                       socket(nullptr),
@@ -116,7 +163,8 @@ namespace internal
                       tcpNoDelay(-1),
                       keepAlive(-1),
                       sendBufferSize(-1),
-                      recvBufferSize(-1)
+                      recvBufferSize(-1),
+                      asyncRead()
                 {
                 }
 
@@ -131,6 +179,95 @@ namespace internal
 }  // namespace internal
 }  // namespace decaf
 
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+// Arms the next read of a push driven read loop, the caller must hold the
+// state's mutex.  Each completion hands the data to the listener outside of
+// the lock and then re-arms the read, so at most one read is outstanding and
+// listener calls for a socket never overlap.
+void postAsyncRead(const std::shared_ptr<AsyncReadState>& state)
+{
+    state->socket->async_read_some(
+        asio::buffer(state->buffer),
+        [state](const asio::error_code& error, std::size_t bytes)
+        {
+            SocketReadListener* listener = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (state->stopped)
+                {
+                    return;
+                }
+
+                if (error)
+                {
+                    state->stopped = true;
+                }
+
+                state->dispatching    = true;
+                state->dispatchThread = std::this_thread::get_id();
+                listener              = state->listener;
+            }
+
+            bool failed = (bool)error;
+
+            try
+            {
+                if (!error)
+                {
+                    listener->onRead(state->buffer.data(),
+                                     static_cast<int>(bytes));
+                }
+                else if (error == asio::error::eof)
+                {
+                    EOFException ex(__FILE__,
+                                    __LINE__,
+                                    "The remote end closed the connection");
+                    listener->onReadException(ex);
+                }
+                else if (error == asio::error::operation_aborted)
+                {
+                    IOException ex(__FILE__,
+                                   __LINE__,
+                                   "The connection is closed");
+                    listener->onReadException(ex);
+                }
+                else
+                {
+                    IOException ex(__FILE__,
+                                   __LINE__,
+                                   "Socket Read Error - %s",
+                                   error.message().c_str());
+                    listener->onReadException(ex);
+                }
+            }
+            catch (...)
+            {
+                AMQ_LOG_ERROR("TcpSocket",
+                              "async read listener threw, stopping read loop");
+                failed = true;
+            }
+
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->dispatching = false;
+
+            if (failed)
+            {
+                state->stopped = true;
+            }
+            else if (!state->stopped)
+            {
+                postAsyncRead(state);
+            }
+
+            state->idle.notify_all();
+        });
+}
+
+}  // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 TcpSocket::TcpSocket()
     : impl(new TcpSocketImpl)
@@ -141,6 +278,12 @@ TcpSocket::TcpSocket()
 ////////////////////////////////////////////////////////////////////////////////
 TcpSocket::~TcpSocket()
 {
+    try
+    {
+        stopAsyncRead();
+    }
+    DECAF_CATCHALL_NOTHROW()
+
     try
     {
         close();
@@ -916,9 +1059,17 @@ void TcpSocket::close()
                 impl->outputStream->close();
             }
 
-            // Close the socket
+            // Close the socket, a running read loop may be re-arming a read
+            // on it so that is excluded while the socket is torn down.
             if (this->impl->socket != nullptr)
             {
+                std::unique_lock<std::mutex> asyncLock;
+                if (this->impl->asyncRead != nullptr)
+                {
+                    asyncLock = std::unique_lock<std::mutex>(
+                        this->impl->asyncRead->mutex);
+                }
+
                 asio::error_code ec;
                 this->impl->socket->shutdown(
                     asio::ip::tcp::socket::shutdown_both,
@@ -1675,6 +1826,87 @@ bool TcpSocket::isClosed() const
     return this->impl->closed.get();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void TcpSocket::startAsyncRead(SocketReadListener* listener, int bufferSize)
+{
+    try
+    {
+        if (listener == nullptr)
+        {
+            throw NullPointerException(
+                __FILE__,
+                __LINE__,
+                "TcpSocket::startAsyncRead - listener is null");
+        }
+
+        if (isClosed())
+        {
+            throw IOException(__FILE__, __LINE__, "The stream is closed");
+        }
+
+        if (this->impl->socket == nullptr || !this->impl->connected)
+        {
+            throw SocketException(__FILE__,
+                                  __LINE__,
+                                  "TcpSocket::startAsyncRead - not connected");
+        }
+
+        if (this->impl->asyncRead != nullptr)
+        {
+            throw IOException(
+                __FILE__,
+                __LINE__,
+                "TcpSocket::startAsyncRead - read loop already started");
+        }
+
+        std::shared_ptr<AsyncReadState> state =
+            std::make_shared<AsyncReadState>(this->impl->socket.get(),
+                                             listener,
+                                             bufferSize);
+        this->impl->asyncRead = state;
+
+        AMQ_LOG_DEBUG("TcpSocket",
+                      "startAsyncRead() bufferSize=" << bufferSize);
+
+        std::lock_guard<std::mutex> lock(state->mutex);
+        postAsyncRead(state);
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TcpSocket::stopAsyncRead()
+{
+    std::shared_ptr<AsyncReadState> state = this->impl->asyncRead;
+    if (state == nullptr)
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    if (!state->stopped)
+    {
+        state->stopped = true;
+
+        asio::error_code ec;
+        state->socket->cancel(ec);
+    }
+
+    // Wait out a listener call in progress on another thread, if we are
+    // being called from the listener itself it finishes once we return.
+    if (state->dispatchThread != std::this_thread::get_id())
+    {
+        state->idle.wait(lock,
+                         [&state]
+                         {
+                             return !state->dispatching;
+                         });
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TcpSocketImpl* TcpSocket::getSocketImpl()
 {
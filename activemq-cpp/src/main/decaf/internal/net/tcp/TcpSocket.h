@@ -151,6 +151,17 @@ namespace internal
                  */
                 virtual void setOption(int option, int value);
 
+                virtual bool supportsAsyncRead() const
+                {
+                    return true;
+                }
+
+                virtual void startAsyncRead(
+                    decaf::net::SocketReadListener* listener,
+                    int                             bufferSize);
+
+                virtual void stopAsyncRead();
+
             public:
                 /**
                  * Reads the requested data from the Socket and write it into
@@ -0,0 +1,430 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ModifiedUTF8.h"
+
+#include <decaf/io/UTFDataFormatException.h>
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DECAF_UTF8_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(DECAF_UTF8_SSE2) && defined(__GNUC__) && defined(__x86_64__)
+#define DECAF_UTF8_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::internal;
+using namespace decaf::internal::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+// Each kernel takes a flag selecting which bytes end a run of single byte
+// characters.  When decoding that is any byte with its top bit set, when
+// encoding zero ends a run as well since it is written in two bytes.
+typedef std::size_t (*RunLength)(const unsigned char* data,
+                                 std::size_t          length,
+                                 bool                 stopAtZero);
+
+// Counts the characters that encode to two bytes.
+typedef std::size_t (*WideCount)(const unsigned char* data,
+                                 std::size_t          length);
+
+struct Kernels
+{
+    RunLength runLength;
+    WideCount wideCount;
+};
+
+inline bool isWide(unsigned char value)
+{
+    return value == 0 || value >= 0x80;
+}
+
+#if defined(DECAF_UTF8_SSE2)
+inline unsigned int firstSetBit(unsigned int mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (unsigned int)index;
+#else
+    return (unsigned int)__builtin_ctz(mask);
+#endif
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t scalarRunLength(const unsigned char* data,
+                            std::size_t          length,
+                            bool                 stopAtZero)
+{
+    const unsigned long long highBits = 0x8080808080808080ULL;
+    const unsigned long long lowBits  = 0x0101010101010101ULL;
+
+    std::size_t index = 0;
+
+    for (; index + 8 <= length; index += 8)
+    {
+        unsigned long long word;
+        std::memcpy(&word, data + index, 8);
+
+        unsigned long long stop = word & highBits;
+        if (stopAtZero)
+        {
+            // Flags every zero byte, and can flag a one that follows a zero
+            // as well, the loop below finds the exact position either way.
+            stop |= (word - lowBits) & ~word & highBits;
+        }
+
+        if (stop != 0)
+        {
+            break;
+        }
+    }
+
+    while (index < length &&
+           !(data[index] >= 0x80 || (stopAtZero && data[index] == 0)))
+    {
+        index++;
+    }
+
+    return index;
+}
+
+std::size_t scalarWideCount(const unsigned char* data, std::size_t length)
+{
+    std::size_t count = 0;
+
+    for (std::size_t index = 0; index < length; ++index)
+    {
+        count += isWide(data[index]) ? 1 : 0;
+    }
+
+    return count;
+}
+
+#if defined(DECAF_UTF8_SSE2)
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t sse2RunLength(const unsigned char* data,
+                          std::size_t          length,
+                          bool                 stopAtZero)
+{
+    const __m128i zero  = _mm_setzero_si128();
+    std::size_t   index = 0;
+
+    for (; index + 16 <= length; index += 16)
+    {
+        __m128i chunk =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(chunk);
+        if (stopAtZero)
+        {
+            mask |=
+                (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, zero));
+        }
+
+        if (mask != 0)
+        {
+            return index + firstSetBit(mask);
+        }
+    }
+
+    return index + scalarRunLength(data + index, length - index, stopAtZero);
+}
+
+std::size_t sse2WideCount(const unsigned char* data, std::size_t length)
+{
+    const __m128i zero  = _mm_setzero_si128();
+    std::size_t   count = 0;
+    std::size_t   index = 0;
+
+    while (index + 16 <= length)
+    {
+        // Each lane counts up by one per wide byte, at most 255 times before
+        // the lanes are summed so none of them can wrap.
+        __m128i     lanes  = _mm_setzero_si128();
+        std::size_t rounds = 0;
+
+        for (; index + 16 <= length && rounds < 255; index += 16, ++rounds)
+        {
+            __m128i chunk =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+            __m128i wide = _mm_or_si128(_mm_cmplt_epi8(chunk, zero),
+                                        _mm_cmpeq_epi8(chunk, zero));
+            lanes        = _mm_sub_epi8(lanes, wide);
+        }
+
+        __m128i sums = _mm_sad_epu8(lanes, zero);
+        count += (std::size_t)_mm_cvtsi128_si32(sums) +
+                 (std::size_t)_mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+    }
+
+    return count + scalarWideCount(data + index, length - index);
+}
+
+#endif
+
+#if defined(DECAF_UTF8_AVX2)
+
+////////////////////////////////////////////////////////////////////////////////
+__attribute__((target("avx2"))) std::size_t avx2RunLength(
+    const unsigned char* data,
+    std::size_t          length,
+    bool                 stopAtZero)
+{
+    const __m256i zero  = _mm256_setzero_si256();
+    std::size_t   index = 0;
+
+    for (; index + 32 <= length; index += 32)
+    {
+        __m256i chunk =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index));
+
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(chunk);
+        if (stopAtZero)
+        {
+            mask |= (unsigned int)_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(chunk, zero));
+        }
+
+        if (mask != 0)
+        {
+            return index + firstSetBit(mask);
+        }
+    }
+
+    return index + sse2RunLength(data + index, length - index, stopAtZero);
+}
+
+__attribute__((target("avx2"))) std::size_t avx2WideCount(
+    const unsigned char* data,
+    std::size_t          length)
+{
+    const __m256i zero  = _mm256_setzero_si256();
+    std::size_t   count = 0;
+    std::size_t   index = 0;
+
+    while (index + 32 <= length)
+    {
+        __m256i     lanes  = _mm256_setzero_si256();
+        std::size_t rounds = 0;
+
+        for (; index + 32 <= length && rounds < 255; index += 32, ++rounds)
+        {
+            __m256i chunk = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(data + index));
+            __m256i wide  = _mm256_or_si256(_mm256_cmpgt_epi8(zero, chunk),
+                                            _mm256_cmpeq_epi8(chunk, zero));
+            lanes         = _mm256_sub_epi8(lanes, wide);
+        }
+
+        __m256i sums  = _mm256_sad_epu8(lanes, zero);
+        count        += (std::size_t)_mm256_extract_epi64(sums, 0) +
+                        (std::size_t)_mm256_extract_epi64(sums, 1) +
+                        (std::size_t)_mm256_extract_epi64(sums, 2) +
+                        (std::size_t)_mm256_extract_epi64(sums, 3);
+    }
+
+    return count + sse2WideCount(data + index, length - index);
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+Kernels selectKernels()
+{
+    Kernels kernels;
+
+#if defined(DECAF_UTF8_AVX2)
+    if (__builtin_cpu_supports("avx2"))
+    {
+        kernels.runLength = avx2RunLength;
+        kernels.wideCount = avx2WideCount;
+        return kernels;
+    }
+#endif
+
+#if defined(DECAF_UTF8_SSE2)
+    kernels.runLength = sse2RunLength;
+    kernels.wideCount = sse2WideCount;
+#else
+    kernels.runLength = scalarRunLength;
+    kernels.wideCount = scalarWideCount;
+#endif
+
+    return kernels;
+}
+
+const Kernels& kernels()
+{
+    static const Kernels selected = selectKernels();
+    return selected;
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t ModifiedUTF8::encodedLength(const char* value, std::size_t length)
+{
+    return length + kernels().wideCount(
+                        reinterpret_cast<const unsigned char*>(value),
+                        length);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8::encode(const char*    value,
+                          std::size_t    length,
+                          unsigned char* out)
+{
+    const unsigned char* data =
+        reinterpret_cast<const unsigned char*>(value);
+    RunLength runLength = kernels().runLength;
+
+    std::size_t index = 0;
+    while (index < length)
+    {
+        std::size_t run = runLength(data + index, length - index, true);
+        if (run > 0)
+        {
+            std::memcpy(out, data + index, run);
+            out   += run;
+            index += run;
+
+            if (index == length)
+            {
+                break;
+            }
+        }
+
+        unsigned char c = data[index++];
+        *out++          = (unsigned char)(0xC0 | (0x1F & (c >> 6)));
+        *out++          = (unsigned char)(0x80 | (0x3F & c));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t ModifiedUTF8::decode(const unsigned char* data,
+                                 std::size_t          length,
+                                 char*                out)
+{
+    RunLength runLength = kernels().runLength;
+
+    std::size_t count = 0;
+    std::size_t index = 0;
+
+    while (count < length)
+    {
+        std::size_t run = runLength(data + count, length - count, false);
+        if (run > 0)
+        {
+            // Decoding in place only ever moves the run towards the front.
+            if ((const void*)(out + index) != (const void*)(data + count))
+            {
+                std::memmove(out + index, data + count, run);
+            }
+
+            count += run;
+            index += run;
+
+            if (count == length)
+            {
+                break;
+            }
+        }
+
+        unsigned char a = data[count++];
+
+        if ((a & 0xE0) == 0xC0)
+        {
+            if (count >= length)
+            {
+                throw UTFDataFormatException(
+                    __FILE__,
+                    __LINE__,
+                    "Invalid UTF-8 encoding found, start of two byte char "
+                    "found at end.");
+            }
+
+            unsigned char b = data[count++];
+            if ((b & 0xC0) != 0x80)
+            {
+                throw UTFDataFormatException(
+                    __FILE__,
+                    __LINE__,
+                    "Invalid UTF-8 encoding found, byte two does not start "
+                    "with 0x80.");
+            }
+
+            // 2-byte UTF8 encoding: 110X XXxx 10xx xxxx
+            // Bits set at 'X' means we have encountered a UTF8 encoded
+            // value greater than 255, which is not supported.
+            if (a & 0x1C)
+            {
+                throw UTFDataFormatException(
+                    __FILE__,
+                    __LINE__,
+                    "Invalid 2 byte UTF-8 encoding found, "
+                    "This method only supports encoded ASCII values of "
+                    "(0-255).");
+            }
+
+            out[index++] = (char)(((a & 0x1F) << 6) | (b & 0x3F));
+        }
+        else if ((a & 0xF0) == 0xE0)
+        {
+            if (count + 1 >= length)
+            {
+                throw UTFDataFormatException(
+                    __FILE__,
+                    __LINE__,
+                    "Invalid UTF-8 encoding found, start of three byte "
+                    "char found at end.");
+            }
+
+            throw UTFDataFormatException(
+                __FILE__,
+                __LINE__,
+                "Invalid 3 byte UTF-8 encoding found, "
+                "This method only supports encoded ASCII values of "
+                "(0-255).");
+        }
+        else
+        {
+            throw UTFDataFormatException(
+                __FILE__,
+                __LINE__,
+                "Invalid UTF-8 encoding found, aborting.");
+        }
+    }
+
+    return index;
+}
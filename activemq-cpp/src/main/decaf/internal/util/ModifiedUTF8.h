@@ -0,0 +1,111 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_INTERNAL_UTIL_MODIFIEDUTF8_H_
+#define _DECAF_INTERNAL_UTIL_MODIFIEDUTF8_H_
+
+#include <decaf/util/Config.h>
+#include <cstddef>
+
+namespace decaf
+{
+namespace internal
+{
+    namespace util
+    {
+
+        /**
+         * Encodes and decodes the modified UTF-8 form used by
+         * DataOutputStream::writeUTF and DataInputStream::readUTF for strings
+         * whose characters are single bytes in the range 0-255.
+         *
+         * Characters 1-127 are written as themselves and everything else,
+         * including zero, as two bytes.  Strings on the wire are almost
+         * always plain ASCII so both directions scan for runs of single byte
+         * characters sixteen or thirty two bytes at a time, using SSE2 or AVX2
+         * when the processor has it and a word at a time otherwise, and copy
+         * each run whole.  Only the bytes that need it take the per character
+         * path.
+         */
+        class DECAF_API ModifiedUTF8
+        {
+        private:
+            ModifiedUTF8(const ModifiedUTF8&);
+            ModifiedUTF8& operator=(const ModifiedUTF8&);
+
+            ModifiedUTF8()
+            {
+            }
+
+        public:
+            /**
+             * Returns the number of bytes the given characters take once
+             * encoded, the string is only ASCII when this equals length.
+             *
+             * @param value
+             *      The characters to measure.
+             * @param length
+             *      The number of characters.
+             *
+             * @return the encoded length in bytes.
+             */
+            static std::size_t encodedLength(const char* value,
+                                             std::size_t length);
+
+            /**
+             * Encodes the given characters into out, which must have room for
+             * encodedLength( value, length ) bytes.
+             *
+             * @param value
+             *      The characters to encode.
+             * @param length
+             *      The number of characters.
+             * @param out
+             *      The buffer that receives the encoded bytes.
+             */
+            static void encode(const char*    value,
+                               std::size_t    length,
+                               unsigned char* out);
+
+            /**
+             * Decodes length bytes of modified UTF-8 into out, which needs
+             * room for at most length characters.  The output may start at
+             * the same address as the input so that a buffer is decoded in
+             * place.
+             *
+             * @param data
+             *      The encoded bytes.
+             * @param length
+             *      The number of encoded bytes.
+             * @param out
+             *      The buffer that receives the characters.
+             *
+             * @return the number of characters decoded.
+             *
+             * @throws UTFDataFormatException if the bytes are not valid or
+             *         encode a character above 255.
+             */
+            static std::size_t decode(const unsigned char* data,
+                                      std::size_t          length,
+                                      char*                out);
+        };
+
+    }  // namespace util
+}  // namespace internal
+}  // namespace decaf
+
+#endif /* _DECAF_INTERNAL_UTIL_MODIFIEDUTF8_H_ */
@@ -0,0 +1,252 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <decaf/internal/util/concurrent/LightweightMonitor.h>
+
+#include <chrono>
+#include <climits>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#endif
+
+using namespace decaf;
+using namespace decaf::internal;
+using namespace decaf::internal::util;
+using namespace decaf::internal::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+    std::atomic<long long> totalContended(0);
+    std::atomic<long long> totalParks(0);
+
+    // Spinning only pays off when the owner can run at the same time.
+    int spinLimit()
+    {
+        static const int limit =
+            std::thread::hardware_concurrency() > 1 ? 100 : 0;
+        return limit;
+    }
+
+#if defined(__linux__)
+
+    void park(std::atomic<int>* word, int expected, long long nanos)
+    {
+        struct timespec  timeout;
+        struct timespec* relative = NULL;
+
+        if (nanos > 0)
+        {
+            timeout.tv_sec  = (time_t)(nanos / 1000000000LL);
+            timeout.tv_nsec = (long)(nanos % 1000000000LL);
+            relative        = &timeout;
+        }
+
+        syscall(SYS_futex,
+                reinterpret_cast<int*>(word),
+                FUTEX_WAIT_PRIVATE,
+                expected,
+                relative,
+                NULL,
+                0);
+    }
+
+    void unpark(std::atomic<int>* word, bool all)
+    {
+        syscall(SYS_futex,
+                reinterpret_cast<int*>(word),
+                FUTEX_WAKE_PRIVATE,
+                all ? INT_MAX : 1,
+                NULL,
+                NULL,
+                0);
+    }
+
+#else
+
+    // Without a futex, threads park on one of a fixed set of condition
+    // variables chosen by the address of the word they wait on.  The word is
+    // re-checked under the bucket lock, and wakers take that lock after
+    // changing the word, so a wake-up can not slip in before the park.
+    struct ParkingBucket
+    {
+        std::mutex              mutex;
+        std::condition_variable condition;
+    };
+
+    const int PARKING_BUCKETS = 64;
+
+    ParkingBucket& bucketFor(std::atomic<int>* word)
+    {
+        static ParkingBucket buckets[PARKING_BUCKETS];
+        std::uintptr_t       address = reinterpret_cast<std::uintptr_t>(word);
+        return buckets[(address >> 4) % PARKING_BUCKETS];
+    }
+
+    void park(std::atomic<int>* word, int expected, long long nanos)
+    {
+        ParkingBucket&               bucket = bucketFor(word);
+        std::unique_lock<std::mutex> lock(bucket.mutex);
+
+        if (word->load(std::memory_order_acquire) != expected)
+        {
+            return;
+        }
+
+        if (nanos > 0)
+        {
+            bucket.condition.wait_for(lock, std::chrono::nanoseconds(nanos));
+        }
+        else
+        {
+            bucket.condition.wait(lock);
+        }
+    }
+
+    void unpark(std::atomic<int>* word, bool all DECAF_UNUSED)
+    {
+        // Buckets are shared between words so every sleeper has to re-check.
+        ParkingBucket&              bucket = bucketFor(word);
+        std::lock_guard<std::mutex> lock(bucket.mutex);
+        bucket.condition.notify_all();
+    }
+
+#endif
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+LightweightMonitor::LightweightMonitor()
+    : state(0),
+      owner(std::thread::id()),
+      recursion(0),
+      sequence(0),
+      contended(0),
+      parks(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LightweightMonitor::~LightweightMonitor()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LightweightMonitor::lockContended()
+{
+    contended.fetch_add(1, std::memory_order_relaxed);
+    totalContended.fetch_add(1, std::memory_order_relaxed);
+
+    for (int spins = spinLimit(); spins > 0; --spins)
+    {
+        int expected = 0;
+        if (state.load(std::memory_order_relaxed) == 0 &&
+            state.compare_exchange_weak(expected,
+                                        1,
+                                        std::memory_order_acquire))
+        {
+            return;
+        }
+    }
+
+    // Mark the lock as having waiters so the releasing thread wakes one.
+    while (state.exchange(2, std::memory_order_acquire) != 0)
+    {
+        parks.fetch_add(1, std::memory_order_relaxed);
+        totalParks.fetch_add(1, std::memory_order_relaxed);
+        park(&state, 2, 0);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LightweightMonitor::release()
+{
+    owner.store(std::thread::id(), std::memory_order_relaxed);
+
+    if (state.exchange(0, std::memory_order_release) == 2)
+    {
+        unpark(&state, false);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int LightweightMonitor::fullyUnlock()
+{
+    if (!isHeldByCurrentThread())
+    {
+        return 0;
+    }
+
+    int count = recursion;
+    recursion = 0;
+    release();
+
+    return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LightweightMonitor::reLock(int count)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    lock();
+    recursion = count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LightweightMonitor::await(int observed, long long nanos)
+{
+    if (sequence.load(std::memory_order_acquire) != observed)
+    {
+        return;
+    }
+
+    parks.fetch_add(1, std::memory_order_relaxed);
+    totalParks.fetch_add(1, std::memory_order_relaxed);
+    park(&sequence, observed, nanos);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LightweightMonitor::signal(bool all)
+{
+    sequence.fetch_add(1, std::memory_order_release);
+    unpark(&sequence, all);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long LightweightMonitor::getTotalContendedCount()
+{
+    return totalContended.load(std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long LightweightMonitor::getTotalParkCount()
+{
+    return totalParks.load(std::memory_order_relaxed);
+}
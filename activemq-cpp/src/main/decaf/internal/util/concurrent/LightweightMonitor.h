@@ -0,0 +1,260 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_INTERNAL_UTIL_CONCURRENT_LIGHTWEIGHTMONITOR_H_
+#define _DECAF_INTERNAL_UTIL_CONCURRENT_LIGHTWEIGHTMONITOR_H_
+
+#include <decaf/util/Config.h>
+#include <atomic>
+#include <thread>
+
+namespace decaf
+{
+namespace internal
+{
+    namespace util
+    {
+        namespace concurrent
+        {
+
+            /**
+             * Reentrant monitor built on a single atomic lock word.
+             *
+             * An uncontended acquire is one compare-and-swap of the lock word
+             * from free to held; re-entry by the owner only bumps a counter.
+             * Contended threads spin briefly and then park on the lock word
+             * (a futex on Linux, a hashed parking lot elsewhere) so that no
+             * platform mutex is allocated per monitor.  A second word holds
+             * a wait sequence that waiters park on and notifiers bump, which
+             * gives the wait / notify half of the monitor without a
+             * condition variable.
+             *
+             * Contention counters are kept per monitor and process wide, they
+             * are only touched on the slow paths.
+             *
+             * @since 3.10
+             */
+            class DECAF_API LightweightMonitor
+            {
+            private:
+                // 0 = free, 1 = held, 2 = held with possible parked waiters
+                std::atomic<int> state;
+
+                // Thread that holds the lock, default id when free.
+                std::atomic<std::thread::id> owner;
+
+                // Re-entry depth, only touched by the owning thread.
+                int recursion;
+
+                // Bumped by signal(), parked waiters watch for a change.
+                std::atomic<int> sequence;
+
+                std::atomic<long long> contended;
+                std::atomic<long long> parks;
+
+            private:
+                LightweightMonitor(const LightweightMonitor&);
+                LightweightMonitor& operator=(const LightweightMonitor&);
+
+            public:
+                LightweightMonitor();
+
+                ~LightweightMonitor();
+
+                /**
+                 * Acquires the lock, blocking until it is available.  The
+                 * owning thread may call this any number of times.
+                 */
+                void lock()
+                {
+                    std::thread::id self = std::this_thread::get_id();
+
+                    if (owner.load(std::memory_order_relaxed) == self)
+                    {
+                        recursion++;
+                        return;
+                    }
+
+                    int expected = 0;
+                    if (!state.compare_exchange_strong(
+                            expected,
+                            1,
+                            std::memory_order_acquire))
+                    {
+                        lockContended();
+                    }
+
+                    owner.store(self, std::memory_order_relaxed);
+                    recursion = 1;
+                }
+
+                /**
+                 * Acquires the lock only if it is free or already held by
+                 * the calling thread.
+                 *
+                 * @return true if the lock is now held by the caller.
+                 */
+                bool tryLock()
+                {
+                    std::thread::id self = std::this_thread::get_id();
+
+                    if (owner.load(std::memory_order_relaxed) == self)
+                    {
+                        recursion++;
+                        return true;
+                    }
+
+                    int expected = 0;
+                    if (state.compare_exchange_strong(
+                            expected,
+                            1,
+                            std::memory_order_acquire))
+                    {
+                        owner.store(self, std::memory_order_relaxed);
+                        recursion = 1;
+                        return true;
+                    }
+
+                    return false;
+                }
+
+                /**
+                 * Releases one level of the lock, the lock is freed once the
+                 * owner has unlocked as many times as it locked.  Calls from
+                 * a thread that does not own the lock are ignored.
+                 */
+                void unlock()
+                {
+                    if (owner.load(std::memory_order_relaxed) !=
+                        std::this_thread::get_id())
+                    {
+                        return;
+                    }
+
+                    if (--recursion == 0)
+                    {
+                        release();
+                    }
+                }
+
+                /**
+                 * Releases the lock regardless of the re-entry depth.
+                 *
+                 * @return the depth to hand to reLock(), or 0 if the caller
+                 *         did not own the lock.
+                 */
+                int fullyUnlock();
+
+                /**
+                 * Acquires the lock and restores the re-entry depth returned
+                 * by fullyUnlock().
+                 *
+                 * @param count the depth to restore, values <= 0 do nothing.
+                 */
+                void reLock(int count);
+
+                /**
+                 * Reads the wait sequence, must be called while holding the
+                 * lock and before releasing it to wait so that a signal sent
+                 * in between is not lost.
+                 *
+                 * @return the current wait sequence.
+                 */
+                int getSequence() const
+                {
+                    return sequence.load(std::memory_order_acquire);
+                }
+
+                /**
+                 * Parks the calling thread until the wait sequence moves away
+                 * from the observed value or the timeout elapses.  The caller
+                 * must not hold the lock.  Spurious returns are possible.
+                 *
+                 * @param observed the value returned by getSequence().
+                 * @param nanos the maximum time to park, <= 0 parks until
+                 *        signalled.
+                 */
+                void await(int observed, long long nanos);
+
+                /**
+                 * Advances the wait sequence and wakes one or all parked
+                 * waiters, the caller should hold the lock.
+                 *
+                 * @param all true to wake every parked waiter.
+                 */
+                void signal(bool all);
+
+                bool isHeldByCurrentThread() const
+                {
+                    return owner.load(std::memory_order_relaxed) ==
+                           std::this_thread::get_id();
+                }
+
+                bool isLocked() const
+                {
+                    return state.load(std::memory_order_relaxed) != 0;
+                }
+
+                /**
+                 * @return the re-entry depth of the calling thread, 0 if it
+                 *         does not own the lock.
+                 */
+                int getRecursionCount() const
+                {
+                    return isHeldByCurrentThread() ? recursion : 0;
+                }
+
+                /**
+                 * @return the number of acquires on this monitor that missed
+                 *         the fast path.
+                 */
+                long long getContendedCount() const
+                {
+                    return contended.load(std::memory_order_relaxed);
+                }
+
+                /**
+                 * @return the number of times a thread parked on this
+                 *         monitor, waiting for either the lock or a signal.
+                 */
+                long long getParkCount() const
+                {
+                    return parks.load(std::memory_order_relaxed);
+                }
+
+                /**
+                 * @return the contended acquires of all monitors since start.
+                 */
+                static long long getTotalContendedCount();
+
+                /**
+                 * @return the parks on all monitors since start.
+                 */
+                static long long getTotalParkCount();
+
+            private:
+                void lockContended();
+
+                void release();
+            };
+
+        }  // namespace concurrent
+    }  // namespace util
+}  // namespace internal
+}  // namespace decaf
+
+#endif /* _DECAF_INTERNAL_UTIL_CONCURRENT_LIGHTWEIGHTMONITOR_H_ */
@@ -18,6 +18,7 @@
 #include <decaf/io/DataInputStream.h>
 
 #include <activemq/util/AMQLog.h>
+#include <decaf/internal/util/ModifiedUTF8.h>
 #include <decaf/io/PushbackInputStream.h>
 #include <cstring>
 
@@ -32,6 +33,7 @@ using namespace std;
 using namespace decaf;
 using namespace decaf::io;
 using namespace decaf::util;
+using namespace decaf::internal::util;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 
@@ -271,103 +273,16 @@ std::string DataInputStream::readUTF()
             return "";
         }
 
-        std::vector<unsigned char> buffer(utfLength);
-        std::vector<unsigned char> result(utfLength);
+        // The encoded bytes are read straight into the result and decoded
+        // in place, no character decodes to more than one byte.
+        std::string result(utfLength, '\0');
+        this->readFully((unsigned char*)&result[0], utfLength);
 
-        this->readFully(&buffer[0], utfLength);
+        result.resize(ModifiedUTF8::decode((const unsigned char*)&result[0],
+                                           utfLength,
+                                           &result[0]));
 
-        std::size_t   count = 0;
-        std::size_t   index = 0;
-        unsigned char a     = 0;
-
-        while (count < utfLength)
-        {
-            if ((result[index] = buffer[count++]) < 0x80)
-            {
-                index++;
-            }
-            else if (((a = result[index]) & 0xE0) == 0xC0)
-            {
-                if (count >= utfLength)
-                {
-                    throw UTFDataFormatException(
-                        __FILE__,
-                        __LINE__,
-                        "Invalid UTF-8 encoding found, start of two byte char "
-                        "found at end.");
-                }
-
-                unsigned char b = buffer[count++];
-                if ((b & 0xC0) != 0x80)
-                {
-                    throw UTFDataFormatException(
-                        __FILE__,
-                        __LINE__,
-                        "Invalid UTF-8 encoding found, byte two does not start "
-                        "with 0x80.");
-                }
-
-                // 2-byte UTF8 encoding: 110X XXxx 10xx xxxx
-                // Bits set at 'X' means we have encountered a UTF8 encoded
-                // value greater than 255, which is not supported.
-                if (a & 0x1C)
-                {
-                    throw UTFDataFormatException(
-                        __FILE__,
-                        __LINE__,
-                        "Invalid 2 byte UTF-8 encoding found, "
-                        "This method only supports encoded ASCII values of "
-                        "(0-255).");
-                }
-
-                result[index++] =
-                    (unsigned char)(((a & 0x1F) << 6) | (b & 0x3F));
-            }
-            else if ((a & 0xF0) == 0xE0)
-            {
-                if (count + 1 >= utfLength)
-                {
-                    throw UTFDataFormatException(
-                        __FILE__,
-                        __LINE__,
-                        "Invalid UTF-8 encoding found, start of three byte "
-                        "char found at end.");
-                }
-                else
-                {
-                    throw UTFDataFormatException(
-                        __FILE__,
-                        __LINE__,
-                        "Invalid 3 byte UTF-8 encoding found, "
-                        "This method only supports encoded ASCII values of "
-                        "(0-255).");
-                }
-
-                // If we were to support multibyte strings in the future this
-                // would be the remainder of this method decoding logic.
-                //
-                // int b = buffer[count++];
-                // int c = buffer[count++];
-                // if( ( ( b & 0xC0 ) != 0x80 ) || ( ( c & 0xC0 ) != 0x80 ) ) {
-                //    throw UTFDataFormatException(
-                //        __FILE__, __LINE__,
-                //        "Invalid UTF-8 encoding found, byte two does not start
-                //        with 0x80." );
-                //}
-                //
-                // result[inde++] = ( ( a & 0x0F ) << 12 ) |
-                //                 ( ( b & 0x3F ) << 6 ) | ( c & 0x3F );
-            }
-            else
-            {
-                throw UTFDataFormatException(
-                    __FILE__,
-                    __LINE__,
-                    "Invalid UTF-8 encoding found, aborting.");
-            }
-        }
-
-        return std::string((char*)(&result[0]), index);
+        return result;
     }
     DECAF_CATCH_RETHROW(UTFDataFormatException)
     DECAF_CATCH_RETHROW(EOFException)
@@ -16,6 +16,7 @@
  */
 
 #include <decaf/io/DataOutputStream.h>
+#include <decaf/internal/util/ModifiedUTF8.h>
 #include <decaf/io/UTFDataFormatException.h>
 #include <decaf/util/Config.h>
 #include <stdio.h>
@@ -24,6 +25,7 @@
 using namespace decaf;
 using namespace decaf::io;
 using namespace decaf::util;
+using namespace decaf::internal::util;
 using namespace decaf::lang::exceptions;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -344,7 +346,9 @@ void DataOutputStream::writeUTF(const std::string& value)
 {
     try
     {
-        unsigned int utfLength = this->countUTFLength(value);
+        std::size_t length    = value.length();
+        std::size_t utfLength = ModifiedUTF8::encodedLength(value.c_str(),
+                                                            length);
 
         if (utfLength > 65535)
         {
@@ -355,76 +359,27 @@ void DataOutputStream::writeUTF(const std::string& value)
                 "than the supported 65535 bytes");
         }
 
-        std::size_t                length = value.length();
-        std::vector<unsigned char> utfBytes((std::size_t)utfLength);
-        unsigned int               utfIndex = 0;
+        this->writeUnsignedShort((unsigned short)utfLength);
 
-        for (std::size_t i = 0; i < length; i++)
+        if (utfLength == length)
         {
-            unsigned int charValue = (unsigned char)value.at(i);
-
-            // Written to allow for expansion to wide character strings at some
-            // point, as it stands now the value can never be > 255 since the
-            // string class returns a single byte char.
-            if (charValue > 0 && charValue <= 127)
-            {
-                utfBytes[utfIndex++] = (unsigned char)charValue;
-            }
-            else if (charValue <= 2047)
+            // Only plain ASCII, the characters are their own encoding.
+            if (length > 0)
             {
-                utfBytes[utfIndex++] =
-                    (unsigned char)(0xc0 | (0x1f & (charValue >> 6)));
-                utfBytes[utfIndex++] =
-                    (unsigned char)(0x80 | (0x3f & charValue));
-            }
-            else
-            {
-                utfBytes[utfIndex++] =
-                    (unsigned char)(0xe0 | (0x0f & (charValue >> 12)));
-                utfBytes[utfIndex++] =
-                    (unsigned char)(0x80 | (0x3f & (charValue >> 6)));
-                utfBytes[utfIndex++] =
-                    (unsigned char)(0x80 | (0x3f & charValue));
+                this->write((const unsigned char*)value.c_str(),
+                            (int)length,
+                            0,
+                            (int)length);
             }
         }
-
-        this->writeUnsignedShort((unsigned short)utfLength);
-        if (utfLength > 0)
+        else
         {
-            this->write(&utfBytes[0], utfIndex, 0, utfIndex);
+            std::vector<unsigned char> utfBytes(utfLength);
+            ModifiedUTF8::encode(value.c_str(), length, &utfBytes[0]);
+            this->write(&utfBytes[0], (int)utfLength, 0, (int)utfLength);
         }
     }
     DECAF_CATCH_RETHROW(UTFDataFormatException)
     DECAF_CATCH_RETHROW(IOException)
     DECAF_CATCHALL_THROW(IOException)
 }
-
-////////////////////////////////////////////////////////////////////////////////
-unsigned int DataOutputStream::countUTFLength(const std::string& value)
-{
-    unsigned int utfCount = 0;
-    std::size_t  length   = value.length();
-
-    for (std::size_t i = 0; i < length; ++i)
-    {
-        unsigned int charValue = (unsigned char)value.at(i);
-
-        // Written to allow for expansion to wide character strings at some
-        // point, as it stands now the value can never be > 255 since the
-        // string class returns a single byte char.
-        if (charValue > 0 && charValue <= 127)
-        {
-            utfCount++;
-        }
-        else if (charValue <= 2047)
-        {
-            utfCount += 2;
-        }
-        else
-        {
-            utfCount += 3;
-        }
-    }
-
-    return utfCount;
-}
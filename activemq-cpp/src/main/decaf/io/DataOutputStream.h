@@ -136,11 +136,6 @@ namespace io
                                          int                  size,
                                          int                  offset,
                                          int                  length);
-
-    private:
-        // Determine the encoded length of a string when written as modified
-        // UTF-8
-        unsigned int countUTFLength(const std::string& value);
     };
 
 }  // namespace io
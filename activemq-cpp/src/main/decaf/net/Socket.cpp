@@ -21,6 +21,7 @@
 #include <decaf/net/SocketImplFactory.h>
 
 #include <decaf/internal/net/tcp/TcpSocket.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
 
 using namespace decaf;
 using namespace decaf::net;
@@ -480,6 +481,79 @@ OutputStream* Socket::getOutputStream()
     DECAF_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool Socket::isAsyncReadSupported() const
+{
+    return this->impl != NULL && this->impl->supportsAsyncRead();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Socket::startAsyncRead(SocketReadListener* listener, int bufferSize)
+{
+    checkClosed();
+
+    if (listener == NULL)
+    {
+        throw NullPointerException(__FILE__,
+                                   __LINE__,
+                                   "SocketReadListener cannot be NULL.");
+    }
+
+    if (bufferSize <= 0)
+    {
+        throw IllegalArgumentException(__FILE__,
+                                       __LINE__,
+                                       "Invalid read buffer size: %d",
+                                       bufferSize);
+    }
+
+    if (!isAsyncReadSupported())
+    {
+        throw UnsupportedOperationException(
+            __FILE__,
+            __LINE__,
+            "Asynchronous reads are not supported by this Socket.");
+    }
+
+    try
+    {
+        if (!isConnected())
+        {
+            throw SocketException(__FILE__,
+                                  __LINE__,
+                                  "The Socket is not connected.");
+        }
+
+        if (isInputShutdown())
+        {
+            throw IOException(__FILE__,
+                              __LINE__,
+                              "Input was shutdown on this Socket.");
+        }
+
+        this->impl->startAsyncRead(listener, bufferSize);
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_RETHROW(UnsupportedOperationException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Socket::stopAsyncRead()
+{
+    try
+    {
+        if (this->impl != NULL)
+        {
+            this->impl->stopAsyncRead();
+        }
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void Socket::shutdownInput()
 {
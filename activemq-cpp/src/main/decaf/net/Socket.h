@@ -23,6 +23,7 @@
 #include <decaf/net/InetAddress.h>
 #include <decaf/net/SocketException.h>
 #include <decaf/net/SocketImplFactory.h>
+#include <decaf/net/SocketReadListener.h>
 #include <decaf/util/Config.h>
 
 #include <decaf/io/IOException.h>
@@ -378,6 +379,36 @@ namespace net
          */
         virtual void shutdownOutput();
 
+        /**
+         * @return true if this Socket can push completed reads to a
+         * SocketReadListener instead of being read through its InputStream.
+         */
+        virtual bool isAsyncReadSupported() const;
+
+        /**
+         * Starts delivering the data read from this Socket to the given
+         * listener from the Socket's I/O threads.  Once started the
+         * InputStream of this Socket must not be read from.
+         *
+         * @param listener
+         *      The listener that receives the data read from the Socket.
+         * @param bufferSize
+         *      The size of the buffer used for each individual read.
+         *
+         * @throws IOException if the Socket is closed, not connected or the
+         * read loop cannot be started.
+         * @throws UnsupportedOperationException if the Socket implementation
+         * does not support asynchronous reads.
+         */
+        virtual void startAsyncRead(SocketReadListener* listener,
+                                    int                 bufferSize);
+
+        /**
+         * Stops a read loop started by startAsyncRead, once this method returns
+         * the listener is no longer called.
+         */
+        virtual void stopAsyncRead();
+
         /**
          * Gets the linger time for the socket, SO_LINGER.  A return value of -1
          * indicates that the option is disabled.
@@ -18,10 +18,12 @@
 #include "SocketImpl.h"
 
 #include <decaf/lang/Integer.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
 
 using namespace decaf;
 using namespace decaf::net;
 using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
 
 ////////////////////////////////////////////////////////////////////////////////
 SocketImpl::SocketImpl()
@@ -54,3 +56,18 @@ void SocketImpl::sendUrgentData(int data DECAF_UNUSED)
         __LINE__,
         "Urgent Data not supported by this implementation.");
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void SocketImpl::startAsyncRead(SocketReadListener* listener DECAF_UNUSED,
+                                int bufferSize               DECAF_UNUSED)
+{
+    throw UnsupportedOperationException(
+        __FILE__,
+        __LINE__,
+        "Asynchronous reads not supported by this implementation.");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SocketImpl::stopAsyncRead()
+{
+}
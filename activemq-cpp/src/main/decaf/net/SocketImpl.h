@@ -27,6 +27,7 @@
 
 #include <decaf/net/SocketException.h>
 #include <decaf/net/SocketOptions.h>
+#include <decaf/net/SocketReadListener.h>
 #include <decaf/net/SocketTimeoutException.h>
 
 #include <string>
@@ -314,6 +315,43 @@ namespace net
          * operation.
          */
         virtual void sendUrgentData(int data);
+
+        /**
+         * @return true if this SocketImpl can deliver completed reads to a
+         * SocketReadListener without a blocked reader thread.  The default
+         * implementation always returns false.
+         */
+        virtual bool supportsAsyncRead() const
+        {
+            return false;
+        }
+
+        /**
+         * Starts a push driven read loop on this Socket, each completed read
+         * is handed to the given listener until the Socket is closed, an error
+         * occurs or stopAsyncRead is called.  Once started the Socket's
+         * InputStream must not be used.
+         *
+         * @param listener
+         *      The listener that receives the data read from the Socket.
+         * @param bufferSize
+         *      The size of the buffer used for each individual read.
+         *
+         * @throws IOException if the read loop cannot be started.
+         * @throws UnsupportedOperationException if not supported by this
+         * implementation.
+         */
+        virtual void startAsyncRead(SocketReadListener* listener,
+                                    int                 bufferSize);
+
+        /**
+         * Stops a read loop started with startAsyncRead.  When this method
+         * returns the listener will not be called again and no call to it is
+         * in progress, unless this method is invoked from within the listener
+         * itself in which case the in progress call is allowed to complete.
+         * The default implementation does nothing.
+         */
+        virtual void stopAsyncRead();
     };
 
 }  // namespace net
@@ -0,0 +1,72 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_NET_SOCKETREADLISTENER_H_
+#define _DECAF_NET_SOCKETREADLISTENER_H_
+
+#include <decaf/io/IOException.h>
+#include <decaf/util/Config.h>
+
+namespace decaf
+{
+namespace net
+{
+
+    /**
+     * Callback interface used by Sockets that support push driven reads.  Once
+     * registered with Socket::startAsyncRead the listener is notified from
+     * the Socket's I/O threads each time a read completes, no thread is ever
+     * parked waiting on the Socket on behalf of the listener.
+     *
+     * Notifications for a single Socket are serialized, the next read is not
+     * issued until the previous onRead call has returned.
+     *
+     * @since 1.0
+     */
+    class DECAF_API SocketReadListener
+    {
+    public:
+        virtual ~SocketReadListener();
+
+        /**
+         * Called when a read on the Socket has completed.  The buffer is only
+         * valid for the duration of the call, implementations must copy any
+         * data they need to retain.
+         *
+         * @param buffer
+         *      The bytes that were read from the Socket.
+         * @param length
+         *      The number of valid bytes in the buffer, always greater than
+         * zero.
+         */
+        virtual void onRead(const unsigned char* buffer, int length) = 0;
+
+        /**
+         * Called when a read fails or the remote end closes the connection,
+         * in the latter case the exception is an EOFException.  No further
+         * notifications are delivered after this method has been called.
+         *
+         * @param ex
+         *      The error that terminated the read loop.
+         */
+        virtual void onReadException(decaf::io::IOException& ex) = 0;
+    };
+
+}  // namespace net
+}  // namespace decaf
+
+#endif /*_DECAF_NET_SOCKETREADLISTENER_H_*/
@@ -137,6 +137,18 @@ namespace net
 
             virtual ~SSLSocket();
 
+            /**
+             * {@inheritDoc}
+             *
+             * The raw bytes read from an SSL connection must be decrypted
+             * before use, so SSL Sockets are always read through their
+             * InputStream.
+             */
+            virtual bool isAsyncReadSupported() const
+            {
+                return false;
+            }
+
         public:
             /**
              * Gets a vector containing the names of all the cipher suites that
@@ -887,6 +887,7 @@ namespace util
             this->valueMap.clear();
             this->valueMap.insert(source.valueMap.begin(),
                                   source.valueMap.end());
+            this->modCount++;
         }
 
         /**
@@ -904,6 +905,19 @@ namespace util
         virtual void clear()
         {
             valueMap.clear();
+            modCount++;
+        }
+
+        /**
+         * Gets a count that changes each time entries are added to, replaced
+         * in or removed from this Map, comparing it against an earlier value
+         * tells if the Map has been modified since.
+         *
+         * @return the current modification count.
+         */
+        int getModificationCount() const
+        {
+            return modCount;
         }
 
         /**
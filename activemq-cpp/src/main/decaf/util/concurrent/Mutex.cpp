@@ -17,17 +17,16 @@
 
 #include <decaf/util/concurrent/Mutex.h>
 
-#include <decaf/internal/util/concurrent/CustomReentrantLock.h>
+#include <decaf/internal/util/concurrent/LightweightMonitor.h>
 #include <decaf/internal/util/concurrent/Threading.h>
 #include <decaf/internal/util/concurrent/ThreadingTypes.h>
 #include <decaf/lang/Integer.h>
+#include <decaf/lang/Long.h>
 #include <decaf/lang/Thread.h>
 #include <decaf/lang/exceptions/IllegalMonitorStateException.h>
 
 #include <atomic>
 #include <chrono>
-#include <condition_variable>
-#include <mutex>
 #include <thread>
 
 using namespace decaf;
@@ -35,7 +34,7 @@ using namespace decaf::util;
 using namespace decaf::util::concurrent;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
-using decaf::internal::util::concurrent::CustomReentrantLock;
+using decaf::internal::util::concurrent::LightweightMonitor;
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace decaf
@@ -46,9 +45,9 @@ namespace util
     {
 
         /**
-         * Internal implementation using CustomReentrantLock.
+         * Internal implementation using LightweightMonitor.
          * Supports recursive locking - the same thread can lock multiple times
-         * without deadlocking. Uses std::condition_variable for wait/notify.
+         * without deadlocking. Waiters park on the monitor's wait sequence.
          */
         class MutexProperties
         {
@@ -83,10 +82,7 @@ namespace util
                 }
             }
 
-            CustomReentrantLock reentrantLock;  // Recursive lock implementation
-            std::condition_variable condition;  // Standard condition variable
-                                                // for use with
-                                                // unique_lock<mutex>
+            LightweightMonitor monitor;  // Recursive lock and wait sequence
             std::atomic<int> pendingNotifications;  // Number of pending
                                                     // notify() calls (consumed
                                                     // by waiters)
@@ -127,24 +123,22 @@ Mutex::~Mutex()
 {
     try
     {
-        // CRITICAL: Destroying a locked std::mutex is undefined behavior and
-        // causes crashes. Ensure proper cleanup before destruction.
+        // Ensure the lock is not held by anyone before the monitor goes away,
+        // a parked thread would otherwise be woken on freed memory.
 
         // If the current thread owns the lock, unlock it completely
-        while (this->properties->reentrantLock.isHeldByCurrentThread())
+        while (this->properties->monitor.isHeldByCurrentThread())
         {
-            this->properties->reentrantLock.unlock();
+            this->properties->monitor.unlock();
         }
 
         // If another thread holds the lock, we have a race condition during
         // shutdown. On Windows, thread stack unwinding can continue briefly
         // after join() returns. Wait a short time to allow Lock RAII
         // destructors to complete their unlock() calls.
-        if (this->properties->reentrantLock.isLocked())
+        if (this->properties->monitor.isLocked())
         {
-            for (int i = 0;
-                 i < 50 && this->properties->reentrantLock.isLocked();
-                 ++i)
+            for (int i = 0; i < 50 && this->properties->monitor.isLocked(); ++i)
             {
                 std::this_thread::sleep_for(std::chrono::milliseconds(1));
             }
@@ -173,25 +167,25 @@ std::string Mutex::toString() const
 ////////////////////////////////////////////////////////////////////////////////
 bool Mutex::isLocked() const
 {
-    return this->properties->reentrantLock.isHeldByCurrentThread();
+    return this->properties->monitor.isHeldByCurrentThread();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Mutex::lock()
 {
-    this->properties->reentrantLock.lock();
+    this->properties->monitor.lock();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Mutex::unlock()
 {
-    this->properties->reentrantLock.unlock();
+    this->properties->monitor.unlock();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool Mutex::tryLock()
 {
-    return this->properties->reentrantLock.tryLock();
+    return this->properties->monitor.tryLock();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -234,7 +228,7 @@ void Mutex::wait(long long millisecs, int nanos)
     }
 
     // Verify that we own the lock
-    if (!this->properties->reentrantLock.isHeldByCurrentThread())
+    if (!this->properties->monitor.isHeldByCurrentThread())
     {
         throw IllegalMonitorStateException(__FILE__,
                                            __LINE__,
@@ -257,129 +251,84 @@ void Mutex::wait(long long millisecs, int nanos)
         handle->state.store(Thread::TIMED_WAITING, std::memory_order_release);
     }
 
-    // Save the recursion count before we modify the lock state
-    int savedRecursionCount =
-        this->properties->reentrantLock.getRecursionCount();
+    LightweightMonitor& monitor = this->properties->monitor;
 
-    // Clear the CustomReentrantLock metadata WITHOUT unlocking the internal
-    // mutex. This allows other threads to acquire the lock via
-    // CustomReentrantLock::lock() (which will block on the internal mutex)
-    // while we prepare for the condition wait.
-    this->properties->reentrantLock.clearMetadata();
+    if (millisecs == 0 && nanos == 0)
+    {
+        // Indefinite wait - park in bounded slices so that interruption is
+        // noticed, the notify counters below decide when the wait is over.
 
-    // Create unique_lock adopting the already-locked internal mutex.
-    // This is CRITICAL: we must hold the mutex when calling condition.wait()
-    // to avoid lost notifications.
-    std::unique_lock<std::mutex> lock(
-        this->properties->reentrantLock.getInternalMutex(),
-        std::adopt_lock);
+        // Record the notifyAll generation before waiting. If it changes, a
+        // notifyAll() was called.
+        unsigned int initialGeneration =
+            this->properties->notifyAllGeneration.load(
+                std::memory_order_acquire);
 
-    try
-    {
-        if (millisecs == 0 && nanos == 0)
+        while (true)
         {
-            // Indefinite wait - use polling to check for interruption
-            // periodically We use wait_for with a timeout so we can check for
-            // interruption
+            // The sequence is read while the lock is still held, a notifier
+            // needs the lock to advance it so the wake-up can not be missed.
+            int sequence            = monitor.getSequence();
+            int savedRecursionCount = monitor.fullyUnlock();
 
-            // Record the notifyAll generation before waiting. If it changes, a
-            // notifyAll() was called.
-            unsigned int initialGeneration =
-                this->properties->notifyAllGeneration.load(
-                    std::memory_order_acquire);
+            monitor.await(sequence, 100000000LL);
+            monitor.reLock(savedRecursionCount);
 
-            while (true)
+            // Check if thread was interrupted
+            if (Thread::interrupted())
             {
-                // Wait for up to 100ms, then check for interruption
-                std::cv_status status = this->properties->condition.wait_for(
-                    lock,
-                    std::chrono::milliseconds(100));
+                handle->state.store(savedState, std::memory_order_release);
+                throw InterruptedException(__FILE__,
+                                           __LINE__,
+                                           "Thread interrupted during wait");
+            }
 
-                // Check if thread was interrupted
-                if (Thread::interrupted())
-                {
-                    // Release unique_lock ownership WITHOUT unlocking the mutex
-                    lock.release();
-                    // Restore the CustomReentrantLock state
-                    this->properties->reentrantLock.adoptLock(
-                        savedRecursionCount);
-                    // Restore thread state
-                    handle->state.store(savedState, std::memory_order_release);
-                    throw InterruptedException(
-                        __FILE__,
-                        __LINE__,
-                        "Thread interrupted during wait");
-                }
+            // Check if a notifyAll() was called - generation will have
+            // changed
+            if (this->properties->notifyAllGeneration.load(
+                    std::memory_order_acquire) != initialGeneration)
+            {
+                break;
+            }
 
-                // Check if a notifyAll() was called - generation will have
-                // changed
-                if (this->properties->notifyAllGeneration.load(
-                        std::memory_order_acquire) != initialGeneration)
+            // Check if a notify() was called (pending notification to
+            // consume). Always check pendingNotifications, not just when
+            // woken, a notify() sent while this thread was re-acquiring the
+            // lock wakes no one and is only visible through the counter.
+            int pending = this->properties->pendingNotifications.load(
+                std::memory_order_acquire);
+            if (pending > 0)
+            {
+                // Atomically try to consume one notification
+                if (this->properties->pendingNotifications
+                        .compare_exchange_strong(pending,
+                                                 pending - 1,
+                                                 std::memory_order_acq_rel))
                 {
                     break;
                 }
-
-                // Check if a notify() was called (pending notification to
-                // consume) IMPORTANT: Always check pendingNotifications, not
-                // just when woken. This prevents lost notifications in the race
-                // condition where:
-                // 1. wait_for times out (status = timeout)
-                // 2. Thread returns from wait_for, about to loop back
-                // 3. Another thread calls notify() at this moment
-                // 4. notify_one() wakes no one (this thread wasn't waiting yet)
-                // 5. This thread re-enters wait_for, misses the notification
-                // By always checking pendingNotifications, we catch
-                // notifications that arrived between wait_for returning and
-                // re-entering.
-                int pending = this->properties->pendingNotifications.load(
-                    std::memory_order_acquire);
-                if (pending > 0)
-                {
-                    // Atomically try to consume one notification
-                    if (this->properties->pendingNotifications
-                            .compare_exchange_strong(pending,
-                                                     pending - 1,
-                                                     std::memory_order_acq_rel))
-                    {
-                        break;
-                    }
-                }
-                // Otherwise, continue waiting (spurious wakeup or timeout for
-                // interruption check)
             }
+            // Otherwise, continue waiting (spurious wakeup or timeout for
+            // interruption check)
         }
-        else
+    }
+    else
+    {
+        // Timed wait - park once for the specified duration, the caller
+        // expects the wait to return after the timeout regardless
+        // Timeouts too long to express in nanoseconds are clamped rather
+        // than left to overflow, which could turn them into no wait at all.
+        long long timeout = Long::MAX_VALUE;
+        if (millisecs < Long::MAX_VALUE / 1000000LL)
         {
-            // Timed wait - just wait for the specified duration
-            // For timed waits, we don't need to check the notification counter
-            // since the caller expects the wait to return after the timeout
-            // regardless
-            auto duration = std::chrono::milliseconds(millisecs) +
-                            std::chrono::nanoseconds(nanos);
-            this->properties->condition.wait_for(lock, duration);
+            timeout = millisecs * 1000000LL + nanos;
         }
 
-        // After wait returns, unique_lock has the mutex locked.
-        // Release unique_lock ownership WITHOUT unlocking the mutex.
-        lock.release();
+        int sequence            = monitor.getSequence();
+        int savedRecursionCount = monitor.fullyUnlock();
 
-        // Restore the CustomReentrantLock state (mutex is already locked by
-        // condition variable)
-        this->properties->reentrantLock.adoptLock(savedRecursionCount);
-    }
-    catch (InterruptedException&)
-    {
-        // InterruptedException is already handled above, just rethrow
-        throw;
-    }
-    catch (...)
-    {
-        // If something goes wrong, restore the lock state
-        // The mutex should still be locked after wait() throws
-        lock.release();
-        this->properties->reentrantLock.adoptLock(savedRecursionCount);
-        handle->state.store(savedState, std::memory_order_release);
-        throw;
+        monitor.await(sequence, timeout);
+        monitor.reLock(savedRecursionCount);
     }
 
     // Restore thread state after waiting
@@ -397,7 +346,7 @@ void Mutex::wait(long long millisecs, int nanos)
 ////////////////////////////////////////////////////////////////////////////////
 void Mutex::notify()
 {
-    if (!this->properties->reentrantLock.isHeldByCurrentThread())
+    if (!this->properties->monitor.isHeldByCurrentThread())
     {
         throw IllegalMonitorStateException(__FILE__,
                                            __LINE__,
@@ -407,13 +356,13 @@ void Mutex::notify()
     // thread
     this->properties->pendingNotifications.fetch_add(1,
                                                      std::memory_order_release);
-    this->properties->condition.notify_one();
+    this->properties->monitor.signal(false);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Mutex::notifyAll()
 {
-    if (!this->properties->reentrantLock.isHeldByCurrentThread())
+    if (!this->properties->monitor.isHeldByCurrentThread())
     {
         throw IllegalMonitorStateException(__FILE__,
                                            __LINE__,
@@ -425,5 +374,5 @@ void Mutex::notifyAll()
     // time of notifyAll() are woken, not threads that call wait() later.
     this->properties->notifyAllGeneration.fetch_add(1,
                                                     std::memory_order_release);
-    this->properties->condition.notify_all();
+    this->properties->monitor.signal(true);
 }
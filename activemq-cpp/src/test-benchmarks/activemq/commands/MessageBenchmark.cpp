@@ -0,0 +1,230 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <benchmark/PerformanceTimer.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Thread.h>
+
+#include <gtest/gtest.h>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+
+namespace activemq
+{
+namespace commands
+{
+
+    /**
+     * Creates, decodes and destroys messages the way a consumer does for
+     * every message it receives.
+     */
+    class MessageChurn : public decaf::lang::Runnable
+    {
+    private:
+        const std::vector<unsigned char>* properties;
+        int                               count;
+        int                               failures;
+
+    public:
+        MessageChurn(const std::vector<unsigned char>* properties, int count)
+            : properties(properties),
+              count(count),
+              failures(0)
+        {
+        }
+
+        int getFailures() const
+        {
+            return failures;
+        }
+
+        virtual void run()
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                std::unique_ptr<ActiveMQTextMessage> message(
+                    new ActiveMQTextMessage());
+                message->setMarshalledProperties(*properties);
+                message->afterUnmarshal(NULL);
+
+                if (message->getIntProperty("index") != 42)
+                {
+                    failures++;
+                }
+            }
+        }
+    };
+
+    class MessageBenchmark : public ::testing::Test
+    {
+    protected:
+        static const int MESSAGES = 100000;
+
+        std::vector<unsigned char> properties;
+
+        void SetUp() override
+        {
+            ActiveMQTextMessage message;
+            message.setStringProperty("name", "value");
+            message.setIntProperty("index", 42);
+            message.beforeMarshal(NULL);
+            properties = message.getMarshalledProperties();
+        }
+
+        void runChurn(int threads)
+        {
+            benchmark::PerformanceTimer timer;
+            int                         iterations = 5;
+
+            for (int iter = 0; iter < iterations; ++iter)
+            {
+                std::vector<std::unique_ptr<MessageChurn>> tasks;
+                std::vector<std::unique_ptr<Thread>>       workers;
+
+                timer.start();
+
+                for (int i = 0; i < threads; ++i)
+                {
+                    tasks.emplace_back(new MessageChurn(&properties, MESSAGES));
+                    workers.emplace_back(new Thread(tasks.back().get()));
+                    workers.back()->start();
+                }
+
+                for (int i = 0; i < threads; ++i)
+                {
+                    workers[i]->join();
+                    ASSERT_EQ(0, tasks[i]->getFailures());
+                }
+
+                timer.stop();
+            }
+
+            std::cout << "Message Churn " << threads
+                      << " Threads Benchmark Time = " << timer.getAverageTime()
+                      << " Millisecs, "
+                      << (timer.getAverageTime() * 1000000.0 /
+                          ((double)MESSAGES * threads))
+                      << " ns per message" << std::endl;
+        }
+    };
+
+}  // namespace commands
+}  // namespace activemq
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(MessageBenchmark, runSingleThreadChurnBenchmark)
+{
+    runChurn(1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(MessageBenchmark, runMultiThreadChurnBenchmark)
+{
+    // Consumers on separate sessions create messages concurrently, a
+    // process wide lock taken per message shows up here.
+    runChurn(4);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(MessageBenchmark, runRemarshalBenchmark)
+{
+    ActiveMQTextMessage message;
+    for (int i = 0; i < 10; ++i)
+    {
+        message.setStringProperty("header" + std::to_string(i), "value");
+    }
+
+    benchmark::PerformanceTimer unchanged;
+    benchmark::PerformanceTimer changed;
+    int                         iterations = 5;
+
+    for (int iter = 0; iter < iterations; ++iter)
+    {
+        // A resend of the same Message, such as a failover replay.
+        unchanged.start();
+        for (int i = 0; i < MESSAGES; ++i)
+        {
+            message.beforeMarshal(NULL);
+        }
+        unchanged.stop();
+
+        changed.start();
+        for (int i = 0; i < MESSAGES; ++i)
+        {
+            message.setIntProperty("index", i);
+            message.beforeMarshal(NULL);
+        }
+        changed.stop();
+    }
+
+    std::cout << "Remarshal Unchanged Properties Benchmark Time = "
+              << unchanged.getAverageTime() << " Millisecs" << std::endl;
+    std::cout << "Remarshal Changed Properties Benchmark Time = "
+              << changed.getAverageTime() << " Millisecs" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(MessageBenchmark, runTextBodyAccessBenchmark)
+{
+    ActiveMQTextMessage source;
+    source.setText(std::string(4096, 'x'));
+    source.beforeMarshal(NULL);
+    const std::vector<unsigned char>& content = source.getContent();
+
+    benchmark::PerformanceTimer copied;
+    benchmark::PerformanceTimer viewed;
+    int                         iterations = 5;
+    std::size_t                 total      = 0;
+
+    for (int iter = 0; iter < iterations; ++iter)
+    {
+        // A fresh received message each time, the way a consumer reads it.
+        copied.start();
+        for (int i = 0; i < MESSAGES; ++i)
+        {
+            ActiveMQTextMessage message;
+            message.setContent(content);
+            total += message.getText().size();
+        }
+        copied.stop();
+
+        viewed.start();
+        for (int i = 0; i < MESSAGES; ++i)
+        {
+            ActiveMQTextMessage message;
+            message.setContent(content);
+            total += message.getTextView().size();
+        }
+        viewed.stop();
+    }
+
+    ASSERT_EQ((std::size_t)iterations * MESSAGES * 2 * 4096, total);
+
+    std::cout << "Text Body getText Benchmark Time = "
+              << copied.getAverageTime() << " Millisecs" << std::endl;
+    std::cout << "Text Body getTextView Benchmark Time = "
+              << viewed.getAverageTime() << " Millisecs" << std::endl;
+}
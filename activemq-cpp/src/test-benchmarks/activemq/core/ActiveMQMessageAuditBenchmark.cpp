@@ -0,0 +1,122 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/core/ActiveMQMessageAudit.h>
+#include <benchmark/PerformanceTimer.h>
+
+#include <gtest/gtest.h>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+
+namespace activemq
+{
+namespace core
+{
+
+    class ActiveMQMessageAuditBenchmark : public ::testing::Test
+    {
+    protected:
+        static const int PRODUCERS = 4;
+
+        std::vector<std::shared_ptr<MessageId>> ids;
+        long long                               sequence;
+
+        ActiveMQMessageAuditBenchmark()
+            : ids(),
+              sequence(0)
+        {
+        }
+
+        void SetUp() override
+        {
+            for (int i = 0; i < PRODUCERS; ++i)
+            {
+                std::shared_ptr<ProducerId> pid(new ProducerId);
+                pid->setConnectionId(
+                    "ID:benchmark-host-12345-1234567890123-1:0");
+                pid->setSessionId(1);
+                pid->setValue(i);
+
+                std::shared_ptr<MessageId> id(new MessageId);
+                id->setProducerId(pid);
+                ids.push_back(id);
+            }
+        }
+
+        /**
+         * Audits a fresh id and then its redelivery for every producer in
+         * turn, the average time of a single check is reported.  Sequence
+         * ids carry on from the previous run against the same audit.
+         */
+        void runAudit(ActiveMQMessageAudit& audit, long long perProducer)
+        {
+            benchmark::PerformanceTimer timer;
+            int                         iterations = 3;
+
+            for (int iter = 0; iter < iterations; ++iter)
+            {
+                timer.start();
+
+                for (long long i = 0; i < perProducer; ++i, ++sequence)
+                {
+                    for (int p = 0; p < PRODUCERS; ++p)
+                    {
+                        ids[p]->setProducerSequenceId(sequence);
+                        ASSERT_FALSE(audit.isDuplicate(ids[p]));
+                        ASSERT_TRUE(audit.isDuplicate(ids[p]));
+                    }
+                }
+
+                timer.stop();
+            }
+
+            double checks = (double)perProducer * PRODUCERS * 2;
+            std::cout << "ActiveMQMessageAudit " << perProducer
+                      << " ids per producer, Benchmark Time = "
+                      << timer.getAverageTime() << " Millisecs, "
+                      << (timer.getAverageTime() * 1000000.0 / checks)
+                      << " ns per check" << std::endl;
+        }
+    };
+
+}  // namespace core
+}  // namespace activemq
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQMessageAuditBenchmark, runDefaultWindowBenchmark)
+{
+    ActiveMQMessageAudit audit;
+
+    // The cost per check stays flat however far the sequence ids run.
+    runAudit(audit, 100000);
+    runAudit(audit, 1000000);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQMessageAuditBenchmark, runLargeWindowBenchmark)
+{
+    ActiveMQMessageAudit audit(32768, PRODUCERS);
+    runAudit(audit, 1000000);
+}
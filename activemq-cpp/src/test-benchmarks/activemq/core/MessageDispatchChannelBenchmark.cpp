@@ -0,0 +1,190 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/core/FifoMessageDispatchChannel.h>
+#include <activemq/core/LockFreeMessageDispatchChannel.h>
+#include <activemq/core/LockFreePriorityMessageDispatchChannel.h>
+#include <activemq/core/SimplePriorityMessageDispatchChannel.h>
+#include <benchmark/PerformanceTimer.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Thread.h>
+
+#include <gtest/gtest.h>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+
+namespace activemq
+{
+namespace core
+{
+
+    class DispatchProducer : public decaf::lang::Runnable
+    {
+    private:
+        MessageDispatchChannel*                              channel;
+        const std::vector<std::shared_ptr<MessageDispatch>>* dispatches;
+        int                                                  count;
+
+    public:
+        DispatchProducer(
+            MessageDispatchChannel*                              channel,
+            const std::vector<std::shared_ptr<MessageDispatch>>* dispatches,
+            int                                                  count)
+            : channel(channel),
+              dispatches(dispatches),
+              count(count)
+        {
+        }
+
+        virtual void run()
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                channel->enqueue((*dispatches)[i % dispatches->size()]);
+            }
+        }
+    };
+
+    class MessageDispatchChannelBenchmark : public ::testing::Test
+    {
+    protected:
+        static const int PREFETCH = 1000;
+
+        std::vector<std::shared_ptr<MessageDispatch>> dispatches;
+
+        void SetUp() override
+        {
+            for (int i = 0; i < PREFETCH; ++i)
+            {
+                dispatches.push_back(
+                    std::shared_ptr<MessageDispatch>(new MessageDispatch()));
+            }
+        }
+
+        /**
+         * Enqueues and dequeues a prefetch worth of messages on the calling
+         * thread, this is the cost paid per message with no contention.
+         */
+        void runSingleThreaded(MessageDispatchChannel& channel,
+                               const std::string&      name)
+        {
+            benchmark::PerformanceTimer timer;
+            int                         iterations = 100;
+
+            channel.start();
+
+            for (int iter = 0; iter < iterations; ++iter)
+            {
+                timer.start();
+
+                for (int i = 0; i < PREFETCH; ++i)
+                {
+                    channel.enqueue(dispatches[i]);
+                }
+
+                for (int i = 0; i < PREFETCH; ++i)
+                {
+                    ASSERT_TRUE(channel.dequeueNoWait() != NULL);
+                }
+
+                timer.stop();
+            }
+
+            std::cout << name << " Single Thread Benchmark Time = "
+                      << timer.getAverageTime() << " Millisecs" << std::endl;
+        }
+
+        /**
+         * Hands messages from a producer thread to a consumer blocked in
+         * dequeue, as the transport and session threads do.
+         */
+        void runProducerConsumer(MessageDispatchChannel& channel,
+                                 const std::string&      name)
+        {
+            benchmark::PerformanceTimer timer;
+            int                         iterations = 20;
+            int                         numRuns    = 20000;
+
+            channel.start();
+
+            for (int iter = 0; iter < iterations; ++iter)
+            {
+                timer.start();
+
+                DispatchProducer runnable(&channel, &dispatches, numRuns);
+                Thread           producer(&runnable);
+                producer.start();
+
+                for (int i = 0; i < numRuns; ++i)
+                {
+                    ASSERT_TRUE(channel.dequeue(-1) != NULL);
+                }
+
+                producer.join();
+
+                timer.stop();
+            }
+
+            std::cout << name << " Producer / Consumer Benchmark Time = "
+                      << timer.getAverageTime() << " Millisecs" << std::endl;
+        }
+    };
+
+}  // namespace core
+}  // namespace activemq
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(MessageDispatchChannelBenchmark, runFifoBenchmark)
+{
+    FifoMessageDispatchChannel channel;
+    runSingleThreaded(channel, "FifoMessageDispatchChannel");
+    runProducerConsumer(channel, "FifoMessageDispatchChannel");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(MessageDispatchChannelBenchmark, runLockFreeBenchmark)
+{
+    LockFreeMessageDispatchChannel channel(PREFETCH);
+    runSingleThreaded(channel, "LockFreeMessageDispatchChannel");
+    runProducerConsumer(channel, "LockFreeMessageDispatchChannel");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(MessageDispatchChannelBenchmark, runSimplePriorityBenchmark)
+{
+    SimplePriorityMessageDispatchChannel channel;
+    runSingleThreaded(channel, "SimplePriorityMessageDispatchChannel");
+    runProducerConsumer(channel, "SimplePriorityMessageDispatchChannel");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(MessageDispatchChannelBenchmark, runLockFreePriorityBenchmark)
+{
+    LockFreePriorityMessageDispatchChannel channel(PREFETCH);
+    runSingleThreaded(channel, "LockFreePriorityMessageDispatchChannel");
+    runProducerConsumer(channel, "LockFreePriorityMessageDispatchChannel");
+}
@@ -0,0 +1,193 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <activemq/commands/KeepAliveInfo.h>
+#include <activemq/transport/IOTransport.h>
+#include <activemq/util/AMQLog.h>
+#include <activemq/wireformat/WireFormat.h>
+#include <benchmark/PerformanceTimer.h>
+#include <decaf/io/BlockingByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+
+#include <gtest/gtest.h>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::util;
+
+namespace activemq
+{
+namespace transport
+{
+
+    /**
+     * Writes a single byte per command so the measured time is dominated by
+     * the transport itself rather than by marshaling.
+     */
+    class ByteWireFormat : public wireformat::WireFormat
+    {
+    public:
+        virtual void marshal(const std::shared_ptr<Command>& command,
+                             const Transport*               transport,
+                             decaf::io::DataOutputStream*   out)
+        {
+            out->write(command->getDataStructureType());
+        }
+
+        virtual std::shared_ptr<Command> unmarshal(
+            const Transport*            transport,
+            decaf::io::DataInputStream* in)
+        {
+            in->readByte();
+            return std::shared_ptr<Command>(new KeepAliveInfo());
+        }
+
+        virtual void setVersion(int version)
+        {
+        }
+
+        virtual int getVersion() const
+        {
+            return 0;
+        }
+
+        virtual bool hasNegotiator() const
+        {
+            return false;
+        }
+
+        virtual bool inReceive() const
+        {
+            return false;
+        }
+
+        virtual std::shared_ptr<Transport> createNegotiator(
+            const std::shared_ptr<Transport> transport)
+        {
+            return std::shared_ptr<Transport>();
+        }
+    };
+
+    class IOTransportBenchmark : public ::testing::Test
+    {
+    protected:
+        decaf::io::BlockingByteArrayInputStream is;
+        decaf::io::ByteArrayOutputStream        os;
+        decaf::io::DataInputStream              input;
+        decaf::io::DataOutputStream             output;
+        std::shared_ptr<Command>                command;
+        AMQLogLevel                             savedLevel;
+        bool                                    savedRecordOnly;
+
+        IOTransportBenchmark()
+            : is(),
+              os(),
+              input(&is),
+              output(&os),
+              command(new KeepAliveInfo()),
+              savedLevel(AMQLogLevel::NONE),
+              savedRecordOnly(false)
+        {
+        }
+
+        void SetUp() override
+        {
+            savedLevel      = AMQLogger::getLevel();
+            savedRecordOnly = AMQLogger::isRecordOnlyMode();
+            AMQLogger::setRecordOnlyMode(true);
+        }
+
+        void TearDown() override
+        {
+            AMQLogger::clearLogContext();
+            AMQLogger::clearLevel("tcp://other:61616");
+            AMQLogger::setLevel(savedLevel);
+            AMQLogger::setRecordOnlyMode(savedRecordOnly);
+        }
+
+        /**
+         * Sends commands through IOTransport::oneway, which carries two
+         * debug statements per call, and reports the cost per send.
+         */
+        void runOneway(const std::string& name)
+        {
+            benchmark::PerformanceTimer timer;
+            int                         iterations = 10;
+            int                         numRuns    = 20000;
+
+            IOTransport transport(
+                std::shared_ptr<wireformat::WireFormat>(new ByteWireFormat()));
+            transport.setInputStream(&input);
+            transport.setOutputStream(&output);
+            transport.start();
+
+            for (int iter = 0; iter < iterations; ++iter)
+            {
+                os.reset();
+                timer.start();
+
+                for (int i = 0; i < numRuns; ++i)
+                {
+                    transport.oneway(command);
+                }
+
+                timer.stop();
+            }
+
+            transport.close();
+
+            std::cout << name << " IOTransport oneway Benchmark Time = "
+                      << timer.getAverageTime() << " Millisecs ("
+                      << (timer.getAverageTime() * 1000000LL / numRuns)
+                      << " ns per send)" << std::endl;
+        }
+    };
+
+}  // namespace transport
+}  // namespace activemq
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(IOTransportBenchmark, runLoggingDisabledBenchmark)
+{
+    AMQLogger::setLevel(AMQLogLevel::NONE);
+    runOneway("Logging Disabled");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(IOTransportBenchmark, runContextLoggingDisabledBenchmark)
+{
+    // The sending thread has its own context with no level while another
+    // connection logs at DEBUG, so the check has to resolve the context.
+    AMQLogger::setLevel(AMQLogLevel::NONE);
+    AMQLogger::setLevel("tcp://other:61616", AMQLogLevel::DBG);
+    AMQLogger::setLogContext("tcp://broker:61616");
+    runOneway("Context Logging Disabled");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(IOTransportBenchmark, runDebugRecordOnlyBenchmark)
+{
+    AMQLogger::setLevel(AMQLogLevel::DBG);
+    runOneway("Debug Record Only");
+}
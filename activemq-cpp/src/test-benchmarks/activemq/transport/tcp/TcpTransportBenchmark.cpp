@@ -0,0 +1,203 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/mock/MockBrokerService.h>
+#include <activemq/transport/DefaultTransportListener.h>
+#include <activemq/transport/tcp/TcpTransportFactory.h>
+#include <activemq/util/AMQLog.h>
+#include <benchmark/PerformanceTimer.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/net/URI.h>
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::mock;
+using namespace activemq::transport;
+using namespace activemq::transport::tcp;
+using namespace activemq::util;
+using namespace decaf;
+using namespace decaf::lang;
+
+namespace activemq
+{
+namespace transport
+{
+    namespace tcp
+    {
+
+        class TcpSender : public decaf::lang::Runnable
+        {
+        private:
+            Transport*               transport;
+            std::shared_ptr<Command> message;
+            int                      count;
+            std::atomic<int>*        failures;
+
+        public:
+            TcpSender(Transport*               transport,
+                      std::shared_ptr<Command> message,
+                      int                      count,
+                      std::atomic<int>*        failures)
+                : transport(transport),
+                  message(message),
+                  count(count),
+                  failures(failures)
+            {
+            }
+
+            virtual void run()
+            {
+                try
+                {
+                    for (int i = 0; i < count; ++i)
+                    {
+                        transport->oneway(message);
+                    }
+                }
+                catch (...)
+                {
+                    failures->fetch_add(1);
+                }
+            }
+        };
+
+        /**
+         * Measures the per send cost of the full filter chain built by the
+         * TcpTransportFactory, the correlator, the wire format negotiator,
+         * the inactivity monitor and the socket writer.
+         */
+        class TcpTransportBenchmark : public ::testing::Test
+        {
+        protected:
+            MockBrokerService          broker;
+            DefaultTransportListener   listener;
+            std::shared_ptr<Transport> transport;
+            AMQLogLevel                savedLevel;
+
+            TcpTransportBenchmark()
+                : broker(),
+                  listener(),
+                  transport(),
+                  savedLevel(AMQLogLevel::NONE)
+            {
+            }
+
+            void SetUp() override
+            {
+                // Per message debug logging would dominate the send cost
+                savedLevel = AMQLogger::getLevel();
+                AMQLogger::setLevel(AMQLogLevel::NONE);
+
+                broker.start();
+                broker.waitUntilStarted();
+
+                decaf::net::URI uri("tcp://127.0.0.1:" +
+                                    Integer::toString(broker.getPort()));
+
+                TcpTransportFactory factory;
+                transport = factory.create(uri);
+                transport->setTransportListener(&listener);
+                transport->start();
+            }
+
+            void TearDown() override
+            {
+                transport->close();
+                broker.stop();
+                broker.waitUntilStopped();
+                AMQLogger::setLevel(savedLevel);
+            }
+
+            /**
+             * Sends from several producer threads sharing the one connection
+             * and reports the average cost of a single send.
+             */
+            void runProducers(int producers)
+            {
+                benchmark::PerformanceTimer timer;
+                int                         iterations = 5;
+                int                         numRuns    = 2000;
+                std::atomic<int>            failures(0);
+
+                std::shared_ptr<ActiveMQTextMessage> message(
+                    new ActiveMQTextMessage());
+                message->setText("TcpTransportBenchmark payload");
+
+                // The first sends wait out the wire format negotiation
+                TcpSender warmUp(transport.get(), message, 100, &failures);
+                warmUp.run();
+
+                for (int iter = 0; iter < iterations; ++iter)
+                {
+                    std::vector<std::unique_ptr<TcpSender>> senders;
+                    std::vector<std::unique_ptr<Thread>>    threads;
+
+                    timer.start();
+
+                    for (int i = 0; i < producers; ++i)
+                    {
+                        senders.emplace_back(new TcpSender(
+                            transport.get(), message, numRuns, &failures));
+                        threads.emplace_back(new Thread(senders.back().get()));
+                        threads.back()->start();
+                    }
+
+                    for (std::size_t i = 0; i < threads.size(); ++i)
+                    {
+                        threads[i]->join();
+                    }
+
+                    timer.stop();
+                }
+
+                ASSERT_EQ(0, failures.load());
+
+                long long millis = timer.getAverageTime();
+                std::cout << producers
+                          << " Producer tcp oneway Benchmark Time = " << millis
+                          << " Millisecs ("
+                          << (1000000LL * millis) / (producers * numRuns)
+                          << " ns/send)" << std::endl;
+            }
+        };
+
+    }  // namespace tcp
+}  // namespace transport
+}  // namespace activemq
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(TcpTransportBenchmark, runSingleProducerBenchmark)
+{
+    runProducers(1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(TcpTransportBenchmark, runMultiProducerBenchmark)
+{
+    runProducers(4);
+}
@@ -0,0 +1,425 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/commands/ConsumerId.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/transport/IOTransport.h>
+#include <activemq/util/Config.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <activemq/wireformat/openwire/utils/ByteReader.h>
+#include <benchmark/PerformanceTimer.h>
+#include <decaf/io/BufferedOutputStream.h>
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/OutputStream.h>
+#include <decaf/util/Properties.h>
+
+#include <gtest/gtest.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+using namespace decaf::io;
+using namespace decaf::util;
+
+namespace
+{
+
+    // Stands in for the socket under a transport's buffered stream.
+    class DiscardingOutputStream : public OutputStream
+    {
+    public:
+        long long written;
+
+    public:
+        DiscardingOutputStream()
+            : OutputStream(),
+              written(0)
+        {
+        }
+
+        virtual ~DiscardingOutputStream()
+        {
+        }
+
+    protected:
+        virtual void doWriteByte(unsigned char value AMQCPP_UNUSED)
+        {
+            written++;
+        }
+
+        virtual void doWriteArrayBounded(const unsigned char* buffer
+                                             AMQCPP_UNUSED,
+                                         int size AMQCPP_UNUSED,
+                                         int offset AMQCPP_UNUSED,
+                                         int length)
+        {
+            written += length;
+        }
+    };
+
+}  // namespace
+
+namespace activemq
+{
+namespace wireformat
+{
+    namespace openwire
+    {
+
+        class OpenWireFormatBenchmark : public ::testing::Test
+        {
+        protected:
+            std::shared_ptr<ActiveMQTextMessage> message;
+
+            void SetUp() override
+            {
+                std::shared_ptr<ProducerId> producerId(
+                    new ProducerId("ID:benchmark-host-12345-1:1:1"));
+                std::shared_ptr<MessageId> messageId(new MessageId());
+                messageId->setProducerId(producerId);
+                messageId->setProducerSequenceId(1);
+
+                message.reset(new ActiveMQTextMessage());
+                message->setMessageId(messageId);
+                message->setProducerId(producerId);
+                message->setDestination(std::shared_ptr<ActiveMQDestination>(
+                    new ActiveMQQueue("BENCHMARK.OPENWIRE.QUEUE")));
+                message->setTimestamp(1234567890123LL);
+                message->setPriority(4);
+                message->setPersistent(true);
+                message->setText(std::string(256, 'a'));
+                message->setIntProperty("count", 42);
+                message->setStringProperty("type", "benchmark");
+            }
+
+            void runBenchmark(bool tightEncoding)
+            {
+                Properties     properties;
+                OpenWireFormat wireFormat(properties);
+                wireFormat.setVersion(OpenWireFormat::MAX_SUPPORTED_VERSION);
+                wireFormat.setTightEncodingEnabled(tightEncoding);
+
+                IOTransport                 transport;
+                benchmark::PerformanceTimer timer;
+                int                         iterations = 100;
+                int                         numRuns    = 1000;
+                long long                   frameSize  = 0;
+
+                ByteArrayOutputStream baos;
+                DataOutputStream      dataOut(&baos);
+
+                for (int iter = 0; iter < iterations; ++iter)
+                {
+                    timer.start();
+
+                    for (int i = 0; i < numRuns; ++i)
+                    {
+                        baos.reset();
+                        wireFormat.marshal(message, &transport, &dataOut);
+                        frameSize = baos.size();
+
+                        std::pair<unsigned char*, int> array =
+                            baos.toByteArray();
+                        ByteArrayInputStream bais(array.first,
+                                                  array.second,
+                                                  true);
+                        DataInputStream      dataIn(&bais);
+
+                        ASSERT_TRUE(
+                            wireFormat.unmarshal(&transport, &dataIn) != NULL);
+                    }
+
+                    timer.stop();
+                }
+
+                std::cout << (tightEncoding ? "Tight" : "Loose")
+                          << " OpenWire Benchmark Time = "
+                          << timer.getAverageTime() << " Millisecs, "
+                          << frameSize << " bytes per frame" << std::endl;
+            }
+
+            /**
+             * Marshals the message into the kind of stream an IOTransport
+             * writes to, a DataOutputStream over a buffered socket stream,
+             * with a text body of the given size.
+             */
+            void runMarshalBenchmark(bool tightEncoding, int textSize)
+            {
+                Properties     properties;
+                OpenWireFormat wireFormat(properties);
+                wireFormat.setVersion(OpenWireFormat::MAX_SUPPORTED_VERSION);
+                wireFormat.setTightEncodingEnabled(tightEncoding);
+
+                message->setText(std::string(textSize, 'a'));
+
+                IOTransport            transport;
+                DiscardingOutputStream socket;
+                BufferedOutputStream   buffered(&socket, 64 * 1024);
+                DataOutputStream       dataOut(&buffered);
+
+                // Enough frames per run for the timer's millisecond
+                // resolution to tell the encodings apart.
+                benchmark::PerformanceTimer timer;
+                int                         iterations = 10;
+                int numRuns = textSize > 4096 ? 10000 : 100000;
+
+                for (int iter = 0; iter < iterations; ++iter)
+                {
+                    timer.start();
+
+                    for (int i = 0; i < numRuns; ++i)
+                    {
+                        wireFormat.marshal(message, &transport, &dataOut);
+                    }
+                    dataOut.flush();
+
+                    timer.stop();
+                }
+
+                std::cout << (tightEncoding ? "Tight" : "Loose")
+                          << " OpenWire marshal, " << textSize
+                          << " byte text, " << numRuns
+                          << " frames, Time = " << timer.getAverageTime()
+                          << " Millisecs, "
+                          << socket.written / (iterations * numRuns)
+                          << " bytes per frame" << std::endl;
+            }
+
+            /**
+             * Decodes the same MessageDispatch frame through a stream, as
+             * unmarshal was fed before the span path existed, and through a
+             * ByteReader as the OpenWireFrameDecoder now does.
+             */
+            void runDecodeBenchmark(bool tightEncoding)
+            {
+                Properties     properties;
+                OpenWireFormat wireFormat(properties);
+                wireFormat.setVersion(OpenWireFormat::MAX_SUPPORTED_VERSION);
+                wireFormat.setTightEncodingEnabled(tightEncoding);
+
+                IOTransport transport;
+
+                std::shared_ptr<ConsumerId> consumerId(new ConsumerId());
+                consumerId->setConnectionId("ID:benchmark-host-12345-1:1");
+                consumerId->setSessionId(1);
+                consumerId->setValue(1);
+
+                std::shared_ptr<MessageDispatch> dispatch(
+                    new MessageDispatch());
+                dispatch->setConsumerId(consumerId);
+                dispatch->setDestination(message->getDestination());
+                dispatch->setMessage(message);
+
+                ByteArrayOutputStream baos;
+                DataOutputStream      dataOut(&baos);
+                wireFormat.marshal(dispatch, &transport, &dataOut);
+
+                std::pair<unsigned char*, int> array = baos.toByteArray();
+                std::vector<unsigned char>     frame(array.first,
+                                                 array.first + array.second);
+                delete[] array.first;
+
+                benchmark::PerformanceTimer streamTimer;
+                benchmark::PerformanceTimer spanTimer;
+                int                         iterations = 100;
+                int                         numRuns    = 1000;
+
+                for (int iter = 0; iter < iterations; ++iter)
+                {
+                    streamTimer.start();
+
+                    for (int i = 0; i < numRuns; ++i)
+                    {
+                        ByteArrayInputStream bais(&frame[0], (int)frame.size());
+                        DataInputStream      dataIn(&bais);
+
+                        ASSERT_TRUE(
+                            wireFormat.unmarshal(&transport, &dataIn) != NULL);
+                    }
+
+                    streamTimer.stop();
+                    spanTimer.start();
+
+                    for (int i = 0; i < numRuns; ++i)
+                    {
+                        ByteReader reader(&frame[0], frame.size());
+
+                        ASSERT_TRUE(
+                            wireFormat.unmarshal(&transport, &reader) != NULL);
+                    }
+
+                    spanTimer.stop();
+                }
+
+                std::cout << (tightEncoding ? "Tight" : "Loose")
+                          << " MessageDispatch decode, " << frame.size()
+                          << " bytes per frame, stream = "
+                          << streamTimer.getAverageTime()
+                          << " Millisecs, span = "
+                          << spanTimer.getAverageTime() << " Millisecs"
+                          << std::endl;
+            }
+
+            /**
+             * Decodes the same MessageDispatch frame from a span with the
+             * intern table disabled, so every id and destination is built
+             * afresh, and with it at its default size.
+             */
+            void runInternDecodeBenchmark(bool tightEncoding)
+            {
+                Properties disabledProperties;
+                disabledProperties.setProperty("wireFormat.internTableSize",
+                                               "0");
+
+                Properties     properties;
+                OpenWireFormat disabled(disabledProperties);
+                OpenWireFormat interning(properties);
+
+                disabled.setVersion(OpenWireFormat::MAX_SUPPORTED_VERSION);
+                disabled.setTightEncodingEnabled(tightEncoding);
+                interning.setVersion(OpenWireFormat::MAX_SUPPORTED_VERSION);
+                interning.setTightEncodingEnabled(tightEncoding);
+
+                IOTransport transport;
+
+                std::shared_ptr<ConsumerId> consumerId(new ConsumerId());
+                consumerId->setConnectionId("ID:benchmark-host-12345-1:1");
+                consumerId->setSessionId(1);
+                consumerId->setValue(1);
+
+                std::shared_ptr<MessageDispatch> dispatch(
+                    new MessageDispatch());
+                dispatch->setConsumerId(consumerId);
+                dispatch->setDestination(message->getDestination());
+                dispatch->setMessage(message);
+
+                ByteArrayOutputStream baos;
+                DataOutputStream      dataOut(&baos);
+                interning.marshal(dispatch, &transport, &dataOut);
+
+                std::pair<unsigned char*, int> array = baos.toByteArray();
+                std::vector<unsigned char>     frame(array.first,
+                                                 array.first + array.second);
+                delete[] array.first;
+
+                benchmark::PerformanceTimer disabledTimer;
+                benchmark::PerformanceTimer interningTimer;
+                int                         iterations = 100;
+                int                         numRuns    = 1000;
+
+                for (int iter = 0; iter < iterations; ++iter)
+                {
+                    disabledTimer.start();
+
+                    for (int i = 0; i < numRuns; ++i)
+                    {
+                        ByteReader reader(&frame[0], frame.size());
+
+                        ASSERT_TRUE(
+                            disabled.unmarshal(&transport, &reader) != NULL);
+                    }
+
+                    disabledTimer.stop();
+                    interningTimer.start();
+
+                    for (int i = 0; i < numRuns; ++i)
+                    {
+                        ByteReader reader(&frame[0], frame.size());
+
+                        ASSERT_TRUE(
+                            interning.unmarshal(&transport, &reader) != NULL);
+                    }
+
+                    interningTimer.stop();
+                }
+
+                std::cout << (tightEncoding ? "Tight" : "Loose")
+                          << " MessageDispatch decode, not interned = "
+                          << disabledTimer.getAverageTime()
+                          << " Millisecs, interned = "
+                          << interningTimer.getAverageTime() << " Millisecs"
+                          << std::endl;
+            }
+        };
+
+    }  // namespace openwire
+}  // namespace wireformat
+}  // namespace activemq
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatBenchmark, runLooseEncodingBenchmark)
+{
+    runBenchmark(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatBenchmark, runTightEncodingBenchmark)
+{
+    runBenchmark(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatBenchmark, runLooseMarshalBenchmark)
+{
+    runMarshalBenchmark(false, 256);
+    runMarshalBenchmark(false, 128 * 1024);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatBenchmark, runTightMarshalBenchmark)
+{
+    runMarshalBenchmark(true, 256);
+    runMarshalBenchmark(true, 128 * 1024);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatBenchmark, runLooseDispatchDecodeBenchmark)
+{
+    runDecodeBenchmark(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatBenchmark, runTightDispatchDecodeBenchmark)
+{
+    runDecodeBenchmark(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatBenchmark, runLooseInternDecodeBenchmark)
+{
+    runInternDecodeBenchmark(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatBenchmark, runTightInternDecodeBenchmark)
+{
+    runInternDecodeBenchmark(true);
+}
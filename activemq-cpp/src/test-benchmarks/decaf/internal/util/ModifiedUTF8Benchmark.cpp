@@ -0,0 +1,244 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/PerformanceTimer.h>
+#include <decaf/internal/util/ModifiedUTF8.h>
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+
+#include <gtest/gtest.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::internal;
+using namespace decaf::internal::util;
+
+namespace decaf
+{
+namespace internal
+{
+    namespace util
+    {
+
+        class ModifiedUTF8Benchmark : public ::testing::Test
+        {
+        protected:
+            // The kinds of strings every message carries.
+            std::vector<std::string> strings;
+
+            // Their encoded forms, laid end to end with length prefixes.
+            std::vector<unsigned char> encoded;
+
+            void SetUp() override
+            {
+                strings.push_back(
+                    "ID:broker-host.example.com-61616-1712345678901-1:1:1:1");
+                strings.push_back(
+                    "ID:client-host.example.com-53214-1712345678901-3:7");
+                strings.push_back("orders.eu-west.fulfilment.incoming");
+                strings.push_back("c0ffee00-1234-4bcd-8abc-0123456789ab");
+                strings.push_back("JMSXGroupID");
+                strings.push_back("application/vnd.example.order+json");
+
+                ByteArrayOutputStream baos;
+                DataOutputStream      dataOut(&baos);
+                for (std::size_t i = 0; i < strings.size(); ++i)
+                {
+                    dataOut.writeUTF(strings[i]);
+                }
+
+                std::pair<unsigned char*, int> array = baos.toByteArray();
+                encoded.assign(array.first, array.first + array.second);
+                delete[] array.first;
+            }
+
+            // The byte at a time decode readUTF used before the kernel,
+            // including its two temporary buffers.
+            static std::string referenceDecode(const unsigned char* data,
+                                               std::size_t          length)
+            {
+                std::vector<unsigned char> buffer(data, data + length);
+                std::vector<unsigned char> result(length);
+
+                std::size_t count = 0;
+                std::size_t index = 0;
+                while (count < length)
+                {
+                    unsigned char a = buffer[count++];
+                    if (a < 0x80)
+                    {
+                        result[index++] = a;
+                    }
+                    else
+                    {
+                        unsigned char b = buffer[count++];
+                        result[index++] =
+                            (unsigned char)(((a & 0x1F) << 6) | (b & 0x3F));
+                    }
+                }
+
+                return std::string((char*)&result[0], index);
+            }
+
+            static std::size_t referenceLength(const std::string& value)
+            {
+                std::size_t length = 0;
+                for (std::size_t i = 0; i < value.length(); ++i)
+                {
+                    unsigned char c  = (unsigned char)value[i];
+                    length          += (c > 0 && c <= 127) ? 1 : 2;
+                }
+
+                return length;
+            }
+        };
+
+    }  // namespace util
+}  // namespace internal
+}  // namespace decaf
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ModifiedUTF8Benchmark, runDecodeBenchmark)
+{
+    benchmark::PerformanceTimer referenceTimer;
+    benchmark::PerformanceTimer kernelTimer;
+    benchmark::PerformanceTimer streamTimer;
+    int                         iterations = 100;
+    int                         numRuns    = 2000;
+    std::size_t                 checksum   = 0;
+
+    for (int iter = 0; iter < iterations; ++iter)
+    {
+        referenceTimer.start();
+        for (int run = 0; run < numRuns; ++run)
+        {
+            std::size_t offset = 0;
+            while (offset < encoded.size())
+            {
+                std::size_t length =
+                    ((std::size_t)encoded[offset] << 8) | encoded[offset + 1];
+                std::string value =
+                    referenceDecode(&encoded[offset + 2], length);
+                checksum += value.size();
+                offset   += 2 + length;
+            }
+        }
+        referenceTimer.stop();
+
+        kernelTimer.start();
+        for (int run = 0; run < numRuns; ++run)
+        {
+            std::size_t offset = 0;
+            while (offset < encoded.size())
+            {
+                std::size_t length =
+                    ((std::size_t)encoded[offset] << 8) | encoded[offset + 1];
+                std::string value(length, '\0');
+                value.resize(ModifiedUTF8::decode(
+                    &encoded[offset + 2], length, &value[0]));
+                checksum += value.size();
+                offset   += 2 + length;
+            }
+        }
+        kernelTimer.stop();
+
+        streamTimer.start();
+        for (int run = 0; run < numRuns; ++run)
+        {
+            ByteArrayInputStream bais(&encoded[0], (int)encoded.size());
+            DataInputStream      dataIn(&bais);
+            for (std::size_t i = 0; i < strings.size(); ++i)
+            {
+                checksum += dataIn.readUTF().size();
+            }
+        }
+        streamTimer.stop();
+    }
+
+    ASSERT_TRUE(checksum > 0);
+
+    std::cout << "Modified UTF-8 decode of " << strings.size()
+              << " id strings x " << numRuns
+              << ": byte at a time = " << referenceTimer.getAverageTime()
+              << " Millisecs, kernel = " << kernelTimer.getAverageTime()
+              << " Millisecs, DataInputStream::readUTF = "
+              << streamTimer.getAverageTime() << " Millisecs" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ModifiedUTF8Benchmark, runEncodeBenchmark)
+{
+    benchmark::PerformanceTimer referenceTimer;
+    benchmark::PerformanceTimer kernelTimer;
+    benchmark::PerformanceTimer streamTimer;
+    int                         iterations = 100;
+    int                         numRuns    = 2000;
+    std::size_t                 checksum   = 0;
+
+    ByteArrayOutputStream baos;
+    DataOutputStream      dataOut(&baos);
+
+    for (int iter = 0; iter < iterations; ++iter)
+    {
+        referenceTimer.start();
+        for (int run = 0; run < numRuns; ++run)
+        {
+            for (std::size_t i = 0; i < strings.size(); ++i)
+            {
+                checksum += referenceLength(strings[i]);
+            }
+        }
+        referenceTimer.stop();
+
+        kernelTimer.start();
+        for (int run = 0; run < numRuns; ++run)
+        {
+            for (std::size_t i = 0; i < strings.size(); ++i)
+            {
+                checksum += ModifiedUTF8::encodedLength(strings[i].c_str(),
+                                                        strings[i].length());
+            }
+        }
+        kernelTimer.stop();
+
+        streamTimer.start();
+        for (int run = 0; run < numRuns; ++run)
+        {
+            baos.reset();
+            for (std::size_t i = 0; i < strings.size(); ++i)
+            {
+                dataOut.writeUTF(strings[i]);
+            }
+        }
+        streamTimer.stop();
+    }
+
+    ASSERT_TRUE(checksum > 0);
+
+    std::cout << "Modified UTF-8 encoded length of " << strings.size()
+              << " id strings x " << numRuns
+              << ": byte at a time = " << referenceTimer.getAverageTime()
+              << " Millisecs, kernel = " << kernelTimer.getAverageTime()
+              << " Millisecs, DataOutputStream::writeUTF = "
+              << streamTimer.getAverageTime() << " Millisecs" << std::endl;
+}
@@ -16,14 +16,19 @@
  */
 
 #include <benchmark/PerformanceTimer.h>
+#include <decaf/internal/util/concurrent/LightweightMonitor.h>
 #include <decaf/lang/Runnable.h>
 #include <decaf/lang/Thread.h>
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/Mutex.h>
 
 #include <gtest/gtest.h>
 #include <iostream>
 
 using namespace decaf;
 using namespace decaf::lang;
+using namespace decaf::util::concurrent;
+using decaf::internal::util::concurrent::LightweightMonitor;
 
 namespace decaf
 {
@@ -43,6 +48,37 @@ namespace lang
         }
     };
 
+    class MonitorRunnable : public decaf::lang::Runnable
+    {
+    private:
+        Mutex*     mutex;
+        long long* counter;
+        int        iterations;
+
+    private:
+        MonitorRunnable(const MonitorRunnable&);
+        MonitorRunnable& operator=(const MonitorRunnable&);
+
+    public:
+        MonitorRunnable(Mutex* mutex, long long* counter, int iterations)
+            : mutex(mutex),
+              counter(counter),
+              iterations(iterations)
+        {
+        }
+
+        virtual void run()
+        {
+            for (int i = 0; i < iterations; ++i)
+            {
+                synchronized(mutex)
+                {
+                    (*counter)++;
+                }
+            }
+        }
+    };
+
 }  // namespace lang
 }  // namespace decaf
 
@@ -72,3 +108,70 @@ TEST_F(ThreadBenchmark, runBenchmark)
               << " Benchmark Time = " << timer.getAverageTime() << " Millisecs"
               << std::endl;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ThreadBenchmark, uncontendedMonitorBenchmark)
+{
+    benchmark::PerformanceTimer timer;
+    int                         iterations = 100;
+    Mutex                       mutex;
+    long long                   counter = 0;
+
+    for (int iter = 0; iter < iterations; ++iter)
+    {
+        timer.start();
+
+        MonitorRunnable runnable(&mutex, &counter, 100000);
+        runnable.run();
+
+        timer.stop();
+    }
+
+    std::cout << typeid(Mutex).name()
+              << " Uncontended synchronized x100000 Time = "
+              << timer.getAverageTime() << " Millisecs" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ThreadBenchmark, contendedMonitorBenchmark)
+{
+    benchmark::PerformanceTimer timer;
+    int                         iterations = 20;
+    const int                   threads    = 4;
+    Mutex                       mutex;
+    long long                   counter = 0;
+
+    long long contended = LightweightMonitor::getTotalContendedCount();
+    long long parks     = LightweightMonitor::getTotalParkCount();
+
+    for (int iter = 0; iter < iterations; ++iter)
+    {
+        timer.start();
+
+        MonitorRunnable runnable(&mutex, &counter, 50000);
+        Thread*         workers[threads];
+
+        for (int i = 0; i < threads; ++i)
+        {
+            workers[i] = new Thread(&runnable);
+            workers[i]->start();
+        }
+
+        for (int i = 0; i < threads; ++i)
+        {
+            workers[i]->join();
+            delete workers[i];
+        }
+
+        timer.stop();
+    }
+
+    ASSERT_EQ((long long)iterations * threads * 50000, counter);
+
+    std::cout << typeid(Mutex).name() << " Contended synchronized " << threads
+              << "x50000 Time = " << timer.getAverageTime() << " Millisecs"
+              << ", contended acquires = "
+              << LightweightMonitor::getTotalContendedCount() - contended
+              << ", parks = " << LightweightMonitor::getTotalParkCount() - parks
+              << std::endl;
+}
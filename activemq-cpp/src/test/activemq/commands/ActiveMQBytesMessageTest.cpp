@@ -18,8 +18,13 @@
 #include <gtest/gtest.h>
 
 #include <activemq/commands/ActiveMQBytesMessage.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
 #include <decaf/lang/Exception.h>
 #include <decaf/util/UUID.h>
+#include <decaf/util/zip/DeflaterOutputStream.h>
+
+#include <algorithm>
 
 using namespace std;
 using namespace cms;
@@ -63,6 +68,75 @@ TEST_F(ActiveMQBytesMessageTest, testGetBodyLength)
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQBytesMessageTest, testGetBodySpan)
+{
+    ActiveMQBytesMessage msg;
+    msg.writeInt(1);
+    msg.writeInt(2);
+    msg.reset();
+
+    std::pair<const unsigned char*, int> span = msg.getBodySpan();
+    ASSERT_EQ(8, span.second);
+    ASSERT_EQ((const void*)&msg.getContent()[0], (const void*)span.first);
+    ASSERT_EQ(2, (int)span.first[7]);
+
+    // The span leaves the read position alone.
+    ASSERT_EQ(1, msg.readInt());
+    ASSERT_EQ(span.first, msg.getBodySpan().first);
+    ASSERT_EQ(2, msg.readInt());
+
+    msg.clearBody();
+    msg.setReadOnlyBody(true);
+    span = msg.getBodySpan();
+    ASSERT_TRUE(span.first == NULL);
+    ASSERT_EQ(0, span.second);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQBytesMessageTest, testGetBodySpanCompressed)
+{
+    std::vector<unsigned char> body(256);
+    for (std::size_t i = 0; i < body.size(); ++i)
+    {
+        body[i] = (unsigned char)(i % 7);
+    }
+
+    decaf::io::ByteArrayOutputStream bytesOut;
+    {
+        decaf::io::DataOutputStream header(&bytesOut);
+        header.writeInt((int)body.size());
+
+        decaf::util::zip::DeflaterOutputStream deflater(&bytesOut);
+        deflater.write(&body[0], (int)body.size(), 0, (int)body.size());
+        deflater.close();
+    }
+
+    std::pair<unsigned char*, int> array = bytesOut.toByteArray();
+    ActiveMQBytesMessage           msg;
+    msg.setContent(
+        std::vector<unsigned char>(array.first, array.first + array.second));
+    delete[] array.first;
+    msg.setCompressed(true);
+    msg.setReadOnlyBody(true);
+
+    std::pair<const unsigned char*, int> span = msg.getBodySpan();
+    ASSERT_EQ((int)body.size(), span.second);
+    ASSERT_TRUE(std::equal(body.begin(), body.end(), span.first));
+    ASSERT_EQ(span.first, msg.getBodySpan().first);
+    ASSERT_EQ((int)body.size(), msg.getBodyLength());
+    ASSERT_EQ(0, (int)msg.readByte());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQBytesMessageTest, testGetBodySpanWriteOnly)
+{
+    ActiveMQBytesMessage msg;
+    msg.writeInt(1);
+
+    ASSERT_THROW(msg.getBodySpan(), MessageNotReadableException);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(ActiveMQBytesMessageTest, testReadBoolean)
 {
@@ -600,3 +674,26 @@ TEST_F(ActiveMQBytesMessageTest, testWriteOnlyBody)
     {
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQBytesMessageTest, testCloneSharedKeepsType)
+{
+    std::vector<unsigned char> content(16, 'a');
+
+    ActiveMQBytesMessage received;
+    received.setContent(content);
+
+    std::unique_ptr<ActiveMQBytesMessage> shared(
+        received.cloneSharedDataStructure());
+    ASSERT_TRUE(shared.get() != NULL);
+
+    const ActiveMQBytesMessage& source = received;
+    const ActiveMQBytesMessage& view   = *shared;
+    ASSERT_EQ(source.getContent().data(), view.getContent().data());
+
+    // Sharing is decided per copy, a plain clone made after it copies.
+    std::unique_ptr<ActiveMQBytesMessage> copy(received.cloneDataStructure());
+    const ActiveMQBytesMessage& copied = *copy;
+    ASSERT_NE(source.getContent().data(), copied.getContent().data());
+    ASSERT_EQ(content, copied.getContent());
+}
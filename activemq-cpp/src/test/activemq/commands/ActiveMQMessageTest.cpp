@@ -25,6 +25,7 @@
 #include <activemq/commands/ActiveMQDestination.h>
 #include <activemq/commands/MessageId.h>
 #include <activemq/core/ActiveMQAckHandler.h>
+#include <activemq/util/PrimitiveList.h>
 #include <decaf/lang/System.h>
 #include <memory>
 #include <vector>
@@ -993,3 +994,81 @@ TEST_F(ActiveMQMessageTest, testIsExpired)
     msg.setCMSExpiration(System::currentTimeMillis() + 10000);
     ASSERT_TRUE(!msg.isExpired());
 }
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQMessageTest, testMarshalledPropertiesReused)
+{
+    ActiveMQMessage msg;
+    msg.setStringProperty("name", "value");
+    msg.beforeMarshal(NULL);
+
+    const ActiveMQMessage&     view    = msg;
+    const unsigned char*       encoded = view.getMarshalledProperties().data();
+    std::vector<unsigned char> first   = view.getMarshalledProperties();
+    ASSERT_FALSE(first.empty());
+
+    // Unchanged properties keep the bytes from the first marshal.
+    msg.beforeMarshal(NULL);
+    ASSERT_EQ(encoded, view.getMarshalledProperties().data());
+    ASSERT_EQ(first, view.getMarshalledProperties());
+
+    // Any change encodes them again.
+    msg.setIntProperty("count", 1);
+    msg.beforeMarshal(NULL);
+    ASSERT_NE(first, view.getMarshalledProperties());
+
+    ActiveMQMessage received;
+    received.setMarshalledProperties(view.getMarshalledProperties());
+    received.afterUnmarshal(NULL);
+    ASSERT_EQ(std::string("value"), received.getStringProperty("name"));
+    ASSERT_EQ(1, received.getIntProperty("count"));
+
+    // Passing on a received Message does not have to decode its properties.
+    ActiveMQMessage forwarded;
+    forwarded.setMarshalledProperties(view.getMarshalledProperties());
+    forwarded.afterUnmarshal(NULL);
+    forwarded.beforeMarshal(NULL);
+    const ActiveMQMessage& forwardedView = forwarded;
+    ASSERT_EQ(view.getMarshalledProperties(),
+              forwardedView.getMarshalledProperties());
+
+    msg.clearProperties();
+    msg.beforeMarshal(NULL);
+    ASSERT_TRUE(view.getMarshalledProperties().empty());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQMessageTest, testNestedPropertyChangeEncodedAgain)
+{
+    PrimitiveList list;
+    list.add(PrimitiveValueNode(1));
+
+    PrimitiveValueNode node;
+    node.setList(list);
+
+    ActiveMQMessage msg;
+    msg.getMessageProperties().put("list", node);
+    msg.beforeMarshal(NULL);
+    ASSERT_FALSE(msg.isPropertiesDirty());
+
+    const ActiveMQMessage&     view  = msg;
+    std::vector<unsigned char> first = view.getMarshalledProperties();
+
+    // Changing the nested list in place must not reuse the old bytes.
+    list.add(PrimitiveValueNode(2));
+    msg.getMessageProperties().get("list").setList(list);
+    ASSERT_TRUE(msg.isPropertiesDirty());
+
+    msg.beforeMarshal(NULL);
+    ASSERT_NE(first, view.getMarshalledProperties());
+
+    ActiveMQMessage received;
+    received.setMarshalledProperties(view.getMarshalledProperties());
+    received.afterUnmarshal(NULL);
+    received.ensurePropertiesUnmarshaled();
+
+    const ActiveMQMessage& receivedView = received;
+    ASSERT_EQ(
+        2,
+        receivedView.getMessageProperties().get("list").getList().size());
+}
@@ -18,6 +18,15 @@
 #include <gtest/gtest.h>
 
 #include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/util/MarshallingSupport.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/IOException.h>
+#include <decaf/util/zip/DeflaterOutputStream.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
 
 using namespace cms;
 using namespace std;
@@ -29,6 +38,27 @@ class ActiveMQTextMessageTest : public ::testing::Test
 {
 };
 
+namespace
+{
+
+std::vector<unsigned char> compressedText(const std::string& text)
+{
+    decaf::io::ByteArrayOutputStream bytesOut;
+    {
+        decaf::util::zip::DeflaterOutputStream deflater(&bytesOut);
+        decaf::io::DataOutputStream            dataOut(&deflater);
+        MarshallingSupport::writeString32(dataOut, text);
+        dataOut.close();
+    }
+
+    std::pair<unsigned char*, int> array = bytesOut.toByteArray();
+    std::vector<unsigned char> content(array.first, array.first + array.second);
+    delete[] array.first;
+    return content;
+}
+
+}  // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(ActiveMQTextMessageTest, test)
 {
@@ -76,6 +106,85 @@ TEST_F(ActiveMQTextMessageTest, testGetBytes)
     ASSERT_TRUE(msg2.getText() == str);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQTextMessageTest, testGetTextViewOverContent)
+{
+    ActiveMQTextMessage msg;
+    std::string         str = "testText";
+    msg.setText(str);
+    msg.beforeMarshal(NULL);
+
+    ActiveMQTextMessage msg2;
+    msg2.setContent(msg.getContent());
+
+    std::string_view view = msg2.getTextView();
+    ASSERT_EQ(str, std::string(view));
+    ASSERT_EQ((const void*)&msg2.getContent()[4], (const void*)view.data());
+    ASSERT_TRUE(msg2.text.get() == NULL);
+    ASSERT_EQ(str, msg2.getText());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQTextMessageTest, testGetTextViewOfLocalText)
+{
+    ActiveMQTextMessage msg;
+    ASSERT_TRUE(msg.getTextView().empty());
+
+    msg.setText("local");
+    ASSERT_EQ(std::string("local"), std::string(msg.getTextView()));
+    ASSERT_EQ((const void*)msg.text->data(),
+              (const void*)msg.getTextView().data());
+
+    msg.clearBody();
+    ASSERT_TRUE(msg.getTextView().empty());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQTextMessageTest, testGetTextViewCompressed)
+{
+    std::string str(512, 'x');
+
+    ActiveMQTextMessage msg;
+    msg.setContent(compressedText(str));
+    msg.setCompressed(true);
+
+    std::string_view view = msg.getTextView();
+    ASSERT_EQ(str, std::string(view));
+    ASSERT_TRUE(msg.text.get() != NULL);
+    ASSERT_EQ((const void*)msg.text->data(), (const void*)view.data());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQTextMessageTest, testGetTextViewTruncatedContent)
+{
+    std::vector<unsigned char> content;
+    content.push_back(0);
+    content.push_back(0);
+    content.push_back(0);
+    content.push_back(10);
+    content.push_back('a');
+    content.push_back('b');
+
+    ActiveMQTextMessage msg;
+    msg.setContent(content);
+
+    ASSERT_THROW(msg.getTextView(), CMSException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQTextMessageTest, testGetTextViewContentShorterThanLength)
+{
+    std::vector<unsigned char> content;
+    content.push_back(0);
+    content.push_back(0);
+
+    ActiveMQTextMessage msg;
+    msg.setContent(content);
+
+    ASSERT_THROW(msg.getText(), CMSException);
+    ASSERT_THROW(msg.getTextView(), CMSException);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(ActiveMQTextMessageTest, testClearBody)
 {
@@ -152,3 +261,126 @@ TEST_F(ActiveMQTextMessageTest, testWriteOnlyBody)
     {
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQTextMessageTest, testCloneSharedDataStructure)
+{
+    ActiveMQTextMessage sent;
+    sent.setText("testText");
+    sent.setStringProperty("name", "value");
+    sent.beforeMarshal(NULL);
+
+    // Looks like a received Message, body and properties only in marshalled
+    // form.
+    ActiveMQTextMessage received;
+    received.setContent(sent.getContent());
+    received.setMarshalledProperties(sent.getMarshalledProperties());
+
+    const ActiveMQTextMessage& source = received;
+
+    std::unique_ptr<ActiveMQTextMessage> shared(
+        dynamic_cast<ActiveMQTextMessage*>(
+            received.cloneSharedDataStructure()));
+    ASSERT_TRUE(shared.get() != NULL);
+
+    const ActiveMQTextMessage& view = *shared;
+    ASSERT_EQ(source.getContent().data(), view.getContent().data());
+    ASSERT_EQ(source.getMarshalledProperties().data(),
+              view.getMarshalledProperties().data());
+    ASSERT_EQ(std::string("testText"), shared->getText());
+    ASSERT_EQ(std::string("value"), shared->getStringProperty("name"));
+
+    // Writing through the shared clone copies the bytes first.
+    shared->getContent().clear();
+    ASSERT_NE(source.getContent().data(), view.getContent().data());
+    ASSERT_EQ(sent.getContent(), source.getContent());
+
+    std::unique_ptr<ActiveMQTextMessage> other(
+        dynamic_cast<ActiveMQTextMessage*>(
+            received.cloneSharedDataStructure()));
+    other->clearBody();
+    other->setText("changed");
+    ASSERT_EQ(std::string("changed"), other->getText());
+    ASSERT_EQ(std::string("testText"), received.getText());
+    ASSERT_EQ(sent.getContent(), source.getContent());
+
+    // The default clone still copies the bytes.
+    std::unique_ptr<ActiveMQTextMessage> copy(received.cloneDataStructure());
+    const ActiveMQTextMessage& copied = *copy;
+    ASSERT_NE(source.getContent().data(), copied.getContent().data());
+    ASSERT_EQ(source.getContent(), copied.getContent());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQTextMessageTest, testLazyPropertiesConcurrentAccess)
+{
+    ActiveMQTextMessage sent;
+    sent.setText("testText");
+    sent.setStringProperty("name", "value");
+    sent.setIntProperty("count", 42);
+    sent.beforeMarshal(NULL);
+
+    for (int round = 0; round < 50; ++round)
+    {
+        ActiveMQTextMessage received;
+        received.setMarshalledProperties(sent.getMarshalledProperties());
+        received.afterUnmarshal(NULL);
+
+        // Every reader races to be the one that decodes the properties.
+        std::atomic<bool>        go(false);
+        std::atomic<int>         matches(0);
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 4; ++i)
+        {
+            readers.push_back(std::thread(
+                [&]()
+                {
+                    while (!go.load())
+                    {
+                        std::this_thread::yield();
+                    }
+
+                    if (received.getStringProperty("name") == "value" &&
+                        received.getIntProperty("count") == 42)
+                    {
+                        matches++;
+                    }
+                }));
+        }
+
+        go = true;
+        for (std::thread& reader : readers)
+        {
+            reader.join();
+        }
+
+        ASSERT_EQ(4, matches.load());
+        ASSERT_EQ(2u, received.getPropertyNames().size());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQTextMessageTest, testCorruptedPropertiesFailEveryAccess)
+{
+    // One entry whose value has an unknown type marker.
+    const unsigned char        bytes[] = {0, 0, 0, 1, 0, 1, 'a', 0xFF};
+    std::vector<unsigned char> corrupted(bytes, bytes + sizeof(bytes));
+
+    ActiveMQTextMessage received;
+    received.setMarshalledProperties(corrupted);
+    received.afterUnmarshal(NULL);
+
+    // A failed decode leaves nothing claimed, the next access fails too.
+    ASSERT_THROW(received.ensurePropertiesUnmarshaled(),
+                 decaf::io::IOException);
+    ASSERT_THROW(received.getPropertyNames(), cms::CMSException);
+
+    ActiveMQTextMessage sent;
+    sent.setStringProperty("name", "value");
+    sent.beforeMarshal(NULL);
+
+    ActiveMQTextMessage repaired;
+    repaired.setMarshalledProperties(sent.getMarshalledProperties());
+    repaired.afterUnmarshal(NULL);
+    ASSERT_EQ(std::string("value"), repaired.getStringProperty("name"));
+}
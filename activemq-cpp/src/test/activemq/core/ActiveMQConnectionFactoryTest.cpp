@@ -25,6 +25,7 @@
 #include <activemq/transport/TransportListener.h>
 #include <cms/Connection.h>
 #include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
 #include <decaf/util/concurrent/Concurrent.h>
 #include <decaf/util/concurrent/Mutex.h>
 #include <memory>
@@ -370,6 +371,66 @@ TEST_F(ActiveMQConnectionFactoryTest, testWatchTopicAdvisoriesSetter)
     ASSERT_TRUE(amqConnection->isWatchTopicAdvisories());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQConnectionFactoryTest, testSessionTaskRunnerURIOptions)
+{
+    ActiveMQConnectionFactory defaults("mock://127.0.0.1:23232");
+    ASSERT_TRUE(defaults.isUseDedicatedTaskRunner());
+    ASSERT_TRUE(defaults.getMaxThreadPoolSize() > 0);
+
+    ActiveMQConnectionFactory factory(
+        "mock://127.0.0.1:23232?connection.useDedicatedTaskRunner=false&"
+        "connection.maxThreadPoolSize=3");
+    ASSERT_FALSE(factory.isUseDedicatedTaskRunner());
+    ASSERT_EQ(3, factory.getMaxThreadPoolSize());
+    ASSERT_THROW(factory.setMaxThreadPoolSize(0),
+                 decaf::lang::exceptions::IllegalArgumentException);
+
+    std::unique_ptr<cms::Connection> connection(factory.createConnection());
+    ActiveMQConnection*              amqConnection =
+        dynamic_cast<ActiveMQConnection*>(connection.get());
+    ASSERT_TRUE(amqConnection != NULL);
+    ASSERT_FALSE(amqConnection->isUseDedicatedTaskRunner());
+    ASSERT_EQ(3, amqConnection->getMaxThreadPoolSize());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQConnectionFactoryTest, testLockFreeDispatchURIOption)
+{
+    ActiveMQConnectionFactory defaults("mock://127.0.0.1:23232");
+    ASSERT_FALSE(defaults.isUseLockFreeDispatch());
+
+    ActiveMQConnectionFactory factory(
+        "mock://127.0.0.1:23232?connection.useLockFreeDispatch=true");
+    ASSERT_TRUE(factory.isUseLockFreeDispatch());
+
+    std::unique_ptr<cms::Connection> connection(factory.createConnection());
+    ActiveMQConnection*              amqConnection =
+        dynamic_cast<ActiveMQConnection*>(connection.get());
+    ASSERT_TRUE(amqConnection != NULL);
+    ASSERT_TRUE(amqConnection->isUseLockFreeDispatch());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQConnectionFactoryTest, testAckBatchURIOptions)
+{
+    ActiveMQConnectionFactory defaults("mock://127.0.0.1:23232");
+    ASSERT_EQ(0, defaults.getAckBatchSize());
+
+    ActiveMQConnectionFactory factory(
+        "mock://127.0.0.1:23232?connection.ackBatchSize=64&"
+        "connection.ackBatchTimeOut=500");
+    ASSERT_EQ(64, factory.getAckBatchSize());
+    ASSERT_EQ(500LL, factory.getAckBatchTimeOut());
+
+    std::unique_ptr<cms::Connection> connection(factory.createConnection());
+    ActiveMQConnection*              amqConnection =
+        dynamic_cast<ActiveMQConnection*>(connection.get());
+    ASSERT_TRUE(amqConnection != NULL);
+    ASSERT_EQ(64, amqConnection->getAckBatchSize());
+    ASSERT_EQ(500LL, amqConnection->getAckBatchTimeOut());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(ActiveMQConnectionFactoryTest, testURIOptionsProcessing)
 {
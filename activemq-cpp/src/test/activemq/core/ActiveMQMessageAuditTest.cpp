@@ -22,6 +22,8 @@
 
 #include <decaf/util/ArrayList.h>
 
+#include <vector>
+
 using namespace std;
 using namespace activemq;
 using namespace activemq::core;
@@ -88,6 +90,36 @@ TEST_F(ActiveMQMessageAuditTest, testIsDuplicateMessageId)
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQMessageAuditTest, testStringAndMessageIdShareProducer)
+{
+    ActiveMQMessageAudit audit;
+
+    std::shared_ptr<ProducerId> pid(new ProducerId);
+    pid->setConnectionId("ID:test-1234-1700000000000-0:7");
+    pid->setSessionId(2);
+    pid->setValue(3);
+
+    std::shared_ptr<MessageId> first(new MessageId);
+    first->setProducerId(pid);
+    first->setProducerSequenceId(1);
+    std::shared_ptr<MessageId> second(new MessageId);
+    second->setProducerId(pid);
+    second->setProducerSequenceId(2);
+
+    ASSERT_FALSE(audit.isDuplicate(first));
+    ASSERT_TRUE(audit.isDuplicate(first->toString()));
+    ASSERT_FALSE(audit.isDuplicate(second->toString()));
+    ASSERT_TRUE(audit.isDuplicate(second));
+    ASSERT_EQ(1, audit.getProducerCount());
+
+    ASSERT_TRUE(audit.isInOrder(second));
+    ASSERT_TRUE(audit.isInOrder(second->toString()));
+
+    audit.rollback(second->toString());
+    ASSERT_FALSE(audit.isDuplicate(second));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(ActiveMQMessageAuditTest, testRollbackString)
 {
@@ -238,3 +270,179 @@ TEST_F(ActiveMQMessageAuditTest, testGetLastSeqId)
         ASSERT_EQ((long long)i, audit.getLastSeqId(pid));
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQMessageAuditTest, testWindowSlidesWithProducer)
+{
+    ActiveMQMessageAudit audit(128, 4);
+
+    std::shared_ptr<ProducerId> pid(new ProducerId);
+    pid->setConnectionId("test");
+    pid->setSessionId(0);
+    pid->setValue(1);
+    std::shared_ptr<MessageId> id(new MessageId);
+    id->setProducerId(pid);
+
+    // Far more ids than the window holds, every one is seen exactly once.
+    long long count = 1000000;
+    for (long long i = 0; i < count; i++)
+    {
+        id->setProducerSequenceId(i);
+        ASSERT_FALSE(audit.isDuplicate(id));
+        ASSERT_TRUE(audit.isDuplicate(id));
+    }
+
+    ASSERT_EQ(count - 1, audit.getLastSeqId(pid));
+
+    for (long long i = count - 1 - audit.getAuditDepth(); i < count; i++)
+    {
+        id->setProducerSequenceId(i);
+        ASSERT_TRUE(audit.isDuplicate(id)) << "sequence: " << i;
+    }
+
+    // Ids that have fallen behind the window are no longer known.
+    id->setProducerSequenceId(10);
+    ASSERT_FALSE(audit.isDuplicate(id));
+    ASSERT_EQ(count - 1, audit.getLastSeqId(pid));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQMessageAuditTest, testGapsInSequence)
+{
+    ActiveMQMessageAudit audit(64, 4);
+
+    std::shared_ptr<ProducerId> pid(new ProducerId);
+    pid->setConnectionId("test");
+    pid->setSessionId(0);
+    pid->setValue(1);
+    std::shared_ptr<MessageId> id(new MessageId);
+    id->setProducerId(pid);
+
+    id->setProducerSequenceId(1);
+    ASSERT_FALSE(audit.isDuplicate(id));
+
+    // Small gap, the skipped ids arrive late and are not duplicates.
+    id->setProducerSequenceId(20);
+    ASSERT_FALSE(audit.isDuplicate(id));
+    id->setProducerSequenceId(10);
+    ASSERT_FALSE(audit.isDuplicate(id));
+    ASSERT_TRUE(audit.isDuplicate(id));
+    ASSERT_EQ(20LL, audit.getLastSeqId(pid));
+
+    // Gap larger than the window forgets everything before it.
+    id->setProducerSequenceId(100000);
+    ASSERT_FALSE(audit.isDuplicate(id));
+    id->setProducerSequenceId(100000 - 10);
+    ASSERT_FALSE(audit.isDuplicate(id));
+
+    audit.rollback(id);
+    ASSERT_FALSE(audit.isDuplicate(id));
+    ASSERT_TRUE(audit.isDuplicate(id));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQMessageAuditTest, testLeastRecentProducerEvicted)
+{
+    ActiveMQMessageAudit audit(64, 1);
+
+    std::shared_ptr<ProducerId> first(new ProducerId);
+    first->setConnectionId("test");
+    first->setSessionId(0);
+    first->setValue(1);
+    std::shared_ptr<MessageId> firstId(new MessageId);
+    firstId->setProducerId(first);
+    firstId->setProducerSequenceId(1);
+
+    ASSERT_FALSE(audit.isDuplicate(firstId));
+    ASSERT_TRUE(audit.isDuplicate(firstId));
+
+    // Enough other producers to push the first out of whichever stripe
+    // it was placed in.
+    for (int i = 2; i < 100; i++)
+    {
+        std::shared_ptr<ProducerId> pid(new ProducerId);
+        pid->setConnectionId("test");
+        pid->setSessionId(0);
+        pid->setValue(i);
+        std::shared_ptr<MessageId> id(new MessageId);
+        id->setProducerId(pid);
+        id->setProducerSequenceId(1);
+        ASSERT_FALSE(audit.isDuplicate(id));
+    }
+
+    ASSERT_EQ(-1LL, audit.getLastSeqId(first));
+    ASSERT_FALSE(audit.isDuplicate(firstId));
+
+    audit.clear();
+    ASSERT_FALSE(audit.isDuplicate(firstId));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQMessageAuditTest, testProducersSharingStripeNotEvicted)
+{
+    ActiveMQMessageAudit audit(64, 64);
+
+    // Fewer producers than the limit, but more than an even share of the
+    // limit per stripe, all kept in the same stripe.
+    std::vector<std::shared_ptr<MessageId>> ids;
+    int                                     stripe = -1;
+    for (int i = 1; ids.size() < 20; i++)
+    {
+        std::shared_ptr<ProducerId> pid(new ProducerId);
+        pid->setConnectionId("test");
+        pid->setSessionId(0);
+        pid->setValue(i);
+
+        if (stripe == -1)
+        {
+            stripe = ActiveMQMessageAudit::getStripeIndex(*pid);
+        }
+        else if (ActiveMQMessageAudit::getStripeIndex(*pid) != stripe)
+        {
+            continue;
+        }
+
+        std::shared_ptr<MessageId> id(new MessageId);
+        id->setProducerId(pid);
+        id->setProducerSequenceId(1);
+        ids.push_back(id);
+
+        ASSERT_FALSE(audit.isDuplicate(id));
+    }
+
+    ASSERT_EQ(20, audit.getProducerCount());
+    for (std::size_t i = 0; i < ids.size(); i++)
+    {
+        ASSERT_TRUE(audit.isDuplicate(ids[i]));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQMessageAuditTest, testProducerLimitBelowStripeCount)
+{
+    ActiveMQMessageAudit audit(64, 3);
+
+    std::shared_ptr<MessageId> last;
+    for (int i = 1; i <= 20; i++)
+    {
+        std::shared_ptr<ProducerId> pid(new ProducerId);
+        pid->setConnectionId("test");
+        pid->setSessionId(0);
+        pid->setValue(i);
+        last.reset(new MessageId);
+        last->setProducerId(pid);
+        last->setProducerSequenceId(1);
+
+        ASSERT_FALSE(audit.isDuplicate(last));
+        ASSERT_LE(audit.getProducerCount(), 3);
+    }
+
+    ASSERT_EQ(3, audit.getProducerCount());
+    ASSERT_TRUE(audit.isDuplicate(last));
+
+    audit.getMaximumNumberOfProducersToTrack(1);
+    ASSERT_EQ(1, audit.getProducerCount());
+
+    audit.clear();
+    ASSERT_EQ(0, audit.getProducerCount());
+}
@@ -19,16 +19,20 @@
 
 #include <activemq/commands/ActiveMQTextMessage.h>
 #include <activemq/commands/ConsumerId.h>
+#include <activemq/commands/MessageAck.h>
 #include <activemq/commands/MessageDispatch.h>
 #include <activemq/core/ActiveMQConnection.h>
 #include <activemq/core/ActiveMQConnectionFactory.h>
+#include <activemq/core/ActiveMQConstants.h>
 #include <activemq/core/ActiveMQConsumer.h>
 #include <activemq/core/ActiveMQProducer.h>
 #include <activemq/core/ActiveMQSession.h>
+#include <activemq/transport/DefaultTransportListener.h>
 #include <activemq/transport/TransportRegistry.h>
 #include <activemq/transport/mock/MockTransport.h>
 #include <activemq/transport/mock/MockTransportFactory.h>
 #include <activemq/util/Config.h>
+#include <activemq/wireformat/openwire/marshal/PrimitiveTypesMarshaller.h>
 #include <cms/Connection.h>
 #include <cms/ExceptionListener.h>
 #include <cms/MessageListener.h>
@@ -38,13 +42,16 @@
 #include <decaf/net/Socket.h>
 #include <decaf/util/Properties.h>
 #include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
 #include <decaf/util/concurrent/Mutex.h>
 #include <memory>
+#include <vector>
 
 using namespace std;
 using namespace activemq;
 using namespace activemq::core;
 using namespace activemq::commands;
+using namespace activemq::wireformat::openwire::marshal;
 using namespace decaf;
 using namespace decaf::lang;
 
@@ -157,6 +164,114 @@ public:
     }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+
+class SentMessageListener : public transport::DefaultTransportListener
+{
+public:
+    const commands::Message*   lastSent;
+    std::vector<unsigned char> lastProperties;
+
+public:
+    SentMessageListener()
+        : lastSent(NULL),
+          lastProperties()
+    {
+    }
+
+    virtual ~SentMessageListener()
+    {
+    }
+
+    virtual void onCommand(const std::shared_ptr<commands::Command> command)
+    {
+        if (command->isMessage())
+        {
+            lastSent = dynamic_cast<const commands::Message*>(command.get());
+            lastProperties = lastSent->getMarshalledProperties();
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+class SentAckListener : public transport::DefaultTransportListener
+{
+public:
+    std::vector<std::shared_ptr<commands::MessageAck>> acks;
+    decaf::util::concurrent::Mutex                     mutex;
+
+public:
+    SentAckListener()
+        : acks(),
+          mutex()
+    {
+    }
+
+    virtual ~SentAckListener()
+    {
+    }
+
+    virtual void onCommand(const std::shared_ptr<commands::Command> command)
+    {
+        if (command->isMessageAck())
+        {
+            synchronized(&mutex)
+            {
+                acks.push_back(
+                    std::dynamic_pointer_cast<commands::MessageAck>(command));
+                mutex.notifyAll();
+            }
+        }
+    }
+
+    int waitForAcks(unsigned int count)
+    {
+        synchronized(&mutex)
+        {
+            for (int i = 0; i < 20 && acks.size() < count; ++i)
+            {
+                mutex.wait(250);
+            }
+            return (int)acks.size();
+        }
+        return 0;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+class BlockingAckListener : public SentAckListener
+{
+public:
+    decaf::util::concurrent::CountDownLatch firstAck;
+    decaf::util::concurrent::CountDownLatch release;
+
+public:
+    BlockingAckListener()
+        : SentAckListener(),
+          firstAck(1),
+          release(1)
+    {
+    }
+
+    virtual ~BlockingAckListener()
+    {
+    }
+
+    virtual void onCommand(const std::shared_ptr<commands::Command> command)
+    {
+        SentAckListener::onCommand(command);
+
+        // Holds the first ack in flight until the test lets it go.
+        if (command->isMessageAck() && firstAck.getCount() > 0)
+        {
+            firstAck.countDown();
+            release.await(5000);
+        }
+    }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSessionTest::SetUp()
 {
@@ -904,3 +1019,603 @@ TEST_F(ActiveMQSessionTest, testClearMessagesInProgressFlag)
     consumer->close();
     session->close();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQSessionTest, testZeroCopyDelivery)
+{
+    ASSERT_TRUE(connection.get() != NULL);
+
+    std::unique_ptr<cms::Session> session(connection->createSession());
+    std::unique_ptr<cms::Queue>   queue(
+        session->createQueue("TestQueue?consumer.zeroCopyDelivery=true"));
+    ASSERT_TRUE(queue.get() != NULL);
+
+    std::unique_ptr<ActiveMQConsumer> consumer(
+        dynamic_cast<ActiveMQConsumer*>(session->createConsumer(queue.get())));
+    ASSERT_TRUE(consumer.get() != NULL);
+
+    ActiveMQTextMessage body;
+    body.setText("This is a Test");
+    body.beforeMarshal(NULL);
+
+    std::shared_ptr<ActiveMQTextMessage> msg(new ActiveMQTextMessage());
+    msg->setContent(body.getContent());
+    msg->setCMSDestination(queue.get());
+
+    std::shared_ptr<ProducerId> producerId(new ProducerId());
+    producerId->setConnectionId(consumer->getConsumerId()->getConnectionId());
+    producerId->setSessionId(consumer->getConsumerId()->getSessionId());
+    producerId->setValue(1);
+
+    std::shared_ptr<MessageId> messageId(new MessageId());
+    messageId->setProducerId(producerId);
+    messageId->setProducerSequenceId(1);
+    msg->setMessageId(messageId);
+
+    std::shared_ptr<MessageDispatch> dispatch(new MessageDispatch());
+    dispatch->setMessage(msg);
+    dispatch->setConsumerId(std::shared_ptr<ConsumerId>(
+        consumer->getConsumerId()->cloneDataStructure()));
+    dTransport->fireCommand(dispatch);
+
+    std::unique_ptr<cms::Message> received(consumer->receive(2000));
+    ASSERT_TRUE(received.get() != NULL);
+
+    ActiveMQTextMessage* textMessage =
+        dynamic_cast<ActiveMQTextMessage*>(received.get());
+    ASSERT_TRUE(textMessage != NULL);
+
+    const ActiveMQTextMessage& view = *textMessage;
+    const ActiveMQTextMessage& source = *msg;
+    ASSERT_EQ(source.getContent().data(), view.getContent().data());
+    ASSERT_EQ(std::string("This is a Test"), textMessage->getText());
+    ASSERT_THROW(textMessage->setText("Changed"),
+                 cms::MessageNotWriteableException);
+
+    textMessage->clearBody();
+    textMessage->setText("Changed");
+    ASSERT_EQ(std::string("Changed"), textMessage->getText());
+    ASSERT_EQ(body.getContent(), source.getContent());
+
+    consumer->close();
+    session->close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQSessionTest, testCopyMessageOnSend)
+{
+    ASSERT_TRUE(connection.get() != NULL);
+
+    SentMessageListener sent;
+    dTransport->setOutgoingListener(&sent);
+
+    std::unique_ptr<cms::Session> session(connection->createSession());
+    std::unique_ptr<cms::Queue>   queue(session->createQueue("TestQueue"));
+    std::unique_ptr<cms::Queue>   inPlaceQueue(
+        session->createQueue("TestQueue?producer.copyMessageOnSend=false"));
+
+    std::unique_ptr<ActiveMQProducer> copying(
+        dynamic_cast<ActiveMQProducer*>(session->createProducer(queue.get())));
+    std::unique_ptr<ActiveMQProducer> inPlace(dynamic_cast<ActiveMQProducer*>(
+        session->createProducer(inPlaceQueue.get())));
+    ASSERT_TRUE(copying->isCopyMessageOnSend());
+    ASSERT_FALSE(inPlace->isCopyMessageOnSend());
+
+    std::unique_ptr<cms::TextMessage> message(
+        session->createTextMessage("This is a Test"));
+    const commands::Message* native =
+        dynamic_cast<const commands::Message*>(message.get());
+    ASSERT_TRUE(native != NULL);
+
+    copying->send(message.get());
+    ASSERT_TRUE(sent.lastSent != NULL);
+    ASSERT_TRUE(sent.lastSent != native);
+
+    message.reset(session->createTextMessage("This is a Test"));
+    native = dynamic_cast<const commands::Message*>(message.get());
+    inPlace->send(message.get());
+    ASSERT_TRUE(sent.lastSent == native);
+    ASSERT_EQ(std::string("This is a Test"), message->getText());
+    ASSERT_FALSE(message->getCMSMessageID().empty());
+
+    // The connection setting is the default for new producers.
+    connection->setCopyMessageOnSend(false);
+    std::unique_ptr<ActiveMQProducer> defaulted(
+        dynamic_cast<ActiveMQProducer*>(session->createProducer(queue.get())));
+    ASSERT_FALSE(defaulted->isCopyMessageOnSend());
+
+    message.reset(session->createTextMessage("This is a Test"));
+    native = dynamic_cast<const commands::Message*>(message.get());
+    defaulted->send(message.get());
+    ASSERT_TRUE(sent.lastSent == native);
+
+    dTransport->setOutgoingListener(NULL);
+    session->close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQSessionTest, testSendSameMessageTwiceInPlace)
+{
+    ASSERT_TRUE(connection.get() != NULL);
+
+    SentMessageListener sent;
+    dTransport->setOutgoingListener(&sent);
+
+    std::unique_ptr<cms::Session> session(connection->createSession());
+    std::unique_ptr<cms::Queue>   queue(
+        session->createQueue("TestQueue?producer.copyMessageOnSend=false"));
+    std::unique_ptr<ActiveMQProducer> producer(
+        dynamic_cast<ActiveMQProducer*>(session->createProducer(queue.get())));
+
+    std::unique_ptr<cms::TextMessage> message(
+        session->createTextMessage("This is a Test"));
+    message->setStringProperty("name", "value");
+    const commands::Message* native =
+        dynamic_cast<const commands::Message*>(message.get());
+
+    producer->send(message.get());
+    ASSERT_TRUE(sent.lastSent == native);
+    std::string firstId = message->getCMSMessageID();
+    std::vector<unsigned char> firstProperties = sent.lastProperties;
+
+    // The send leaves its fields on the Message, which is now read only.
+    ASSERT_FALSE(firstId.empty());
+    ASSERT_TRUE(native->getProducerId() != NULL);
+    ASSERT_TRUE(native->getDestination() != NULL);
+    ASSERT_THROW(message->setText("Changed"),
+                 cms::MessageNotWriteableException);
+
+    // Sending it again as it is gives it a new id and the same contents.
+    producer->send(message.get());
+    ASSERT_TRUE(sent.lastSent == native);
+    ASSERT_NE(firstId, message->getCMSMessageID());
+    ASSERT_EQ(firstProperties, sent.lastProperties);
+    ASSERT_EQ(std::string("This is a Test"), message->getText());
+    ASSERT_EQ(std::string("value"), message->getStringProperty("name"));
+
+    message->clearBody();
+    message->setText("Changed");
+    producer->send(message.get());
+    ASSERT_EQ(std::string("Changed"), message->getText());
+
+    dTransport->setOutgoingListener(NULL);
+    session->close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQSessionTest, testProducerPropertyTemplate)
+{
+    ASSERT_TRUE(connection.get() != NULL);
+
+    SentMessageListener sent;
+    dTransport->setOutgoingListener(&sent);
+
+    std::unique_ptr<cms::Session>     session(connection->createSession());
+    std::unique_ptr<cms::Queue>       queue(session->createQueue("TestQueue"));
+    std::unique_ptr<ActiveMQProducer> producer(
+        dynamic_cast<ActiveMQProducer*>(session->createProducer(queue.get())));
+    ASSERT_TRUE(producer->getPropertyTemplate() == NULL);
+
+    activemq::util::PrimitiveMap headers;
+    headers.setString("application", "orders");
+    headers.setInt("schemaVersion", 3);
+    producer->setPropertyTemplate(headers);
+    ASSERT_TRUE(producer->getPropertyTemplate() != NULL);
+
+    std::unique_ptr<cms::TextMessage> message(
+        session->createTextMessage("This is a Test"));
+    producer->send(message.get());
+    ASSERT_EQ(producer->getPropertyTemplate()->getEncoded(),
+              sent.lastProperties);
+
+    // The Message's own properties are sent along with the template's.
+    message->setIntProperty("schemaVersion", 4);
+    message->setStringProperty("orderId", "A-1");
+    producer->send(message.get());
+
+    activemq::util::PrimitiveMap received;
+    PrimitiveTypesMarshaller::unmarshal(&received, sent.lastProperties);
+    ASSERT_EQ(3, received.size());
+    ASSERT_EQ(std::string("orders"), received.getString("application"));
+    ASSERT_EQ(4, received.getInt("schemaVersion"));
+    ASSERT_EQ(std::string("A-1"), received.getString("orderId"));
+
+    // The template is added to the copy that is sent, not to the original.
+    ASSERT_FALSE(message->propertyExists("application"));
+
+    producer->setPropertyTemplate(activemq::util::PrimitiveMap());
+    ASSERT_TRUE(producer->getPropertyTemplate() == NULL);
+
+    dTransport->setOutgoingListener(NULL);
+    session->close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQSessionTest, testPropertyTemplateLeavesInPlaceMessage)
+{
+    ASSERT_TRUE(connection.get() != NULL);
+
+    SentMessageListener sent;
+    dTransport->setOutgoingListener(&sent);
+
+    std::unique_ptr<cms::Session> session(connection->createSession());
+    std::unique_ptr<cms::Queue>   queue(
+        session->createQueue("TestQueue?producer.copyMessageOnSend=false"));
+    std::unique_ptr<ActiveMQProducer> producer(
+        dynamic_cast<ActiveMQProducer*>(session->createProducer(queue.get())));
+    ASSERT_FALSE(producer->isCopyMessageOnSend());
+
+    activemq::util::PrimitiveMap headers;
+    headers.setString("application", "orders");
+    producer->setPropertyTemplate(headers);
+
+    std::unique_ptr<cms::TextMessage> message(
+        session->createTextMessage("This is a Test"));
+    message->setStringProperty("orderId", "A-1");
+    const commands::Message* native =
+        dynamic_cast<const commands::Message*>(message.get());
+
+    producer->send(message.get());
+    ASSERT_TRUE(sent.lastSent != NULL);
+    ASSERT_TRUE(sent.lastSent != native);
+
+    activemq::util::PrimitiveMap received;
+    PrimitiveTypesMarshaller::unmarshal(&received, sent.lastProperties);
+    ASSERT_EQ(2, received.size());
+    ASSERT_EQ(std::string("orders"), received.getString("application"));
+
+    // The caller's Message is left with only its own properties.
+    ASSERT_FALSE(message->propertyExists("application"));
+    ASSERT_EQ(std::string("A-1"), message->getStringProperty("orderId"));
+    ASSERT_EQ(std::string("This is a Test"), message->getText());
+
+    dTransport->setOutgoingListener(NULL);
+    session->close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQSessionTest, testDispatchToManyConsumers)
+{
+    ASSERT_TRUE(connection.get() != NULL);
+
+    std::unique_ptr<cms::Session> session(connection->createSession());
+    std::unique_ptr<cms::Topic>   topic(session->createTopic("TestTopic"));
+
+    const int numConsumers = 200;
+
+    std::vector<std::unique_ptr<MyCMSMessageListener>> listeners;
+    std::vector<std::unique_ptr<ActiveMQConsumer>>     consumers;
+    for (int ix = 0; ix < numConsumers; ++ix)
+    {
+        listeners.emplace_back(new MyCMSMessageListener());
+        consumers.emplace_back(dynamic_cast<ActiveMQConsumer*>(
+            session->createConsumer(topic.get())));
+        consumers.back()->setMessageListener(listeners.back().get());
+    }
+
+    const int target = 150;
+    injectTextMessage("This is a Test 1",
+                      *topic,
+                      *(consumers[target]->getConsumerId()));
+    injectTextMessage("This is a Test 2",
+                      *topic,
+                      *(consumers[0]->getConsumerId()));
+
+    listeners[target]->asyncWaitForMessages(1);
+    listeners[0]->asyncWaitForMessages(1);
+
+    for (int ix = 0; ix < numConsumers; ++ix)
+    {
+        int expected = (ix == target || ix == 0) ? 1 : 0;
+        ASSERT_EQ(expected, (int)listeners[ix]->messages.size()) << ix;
+    }
+
+    // A closed consumer is no longer found by either lookup.
+    std::shared_ptr<ConsumerId> closedId(
+        consumers[target]->getConsumerId()->cloneDataStructure());
+    consumers[target]->close();
+    injectTextMessage("This is a Test 3", *topic, *closedId);
+    injectTextMessage("This is a Test 4",
+                      *topic,
+                      *(consumers[0]->getConsumerId()));
+
+    listeners[0]->asyncWaitForMessages(2);
+    ASSERT_EQ(2, (int)listeners[0]->messages.size());
+    ASSERT_EQ(1, (int)listeners[target]->messages.size());
+
+    session->close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQSessionTest, testPooledSessionDispatch)
+{
+    ASSERT_TRUE(connection.get() != NULL);
+
+    connection->setUseDedicatedTaskRunner(false);
+    connection->setMaxThreadPoolSize(2);
+
+    const int numSessions = 8;
+
+    std::vector<std::unique_ptr<cms::Session>>         sessions;
+    std::vector<std::unique_ptr<cms::Topic>>           topics;
+    std::vector<std::unique_ptr<ActiveMQConsumer>>     consumers;
+    std::vector<std::unique_ptr<MyCMSMessageListener>> listeners;
+    for (int ix = 0; ix < numSessions; ++ix)
+    {
+        sessions.emplace_back(connection->createSession());
+        topics.emplace_back(sessions.back()->createTopic("TestTopic"));
+        consumers.emplace_back(dynamic_cast<ActiveMQConsumer*>(
+            sessions.back()->createConsumer(topics.back().get())));
+        listeners.emplace_back(new MyCMSMessageListener());
+        consumers.back()->setMessageListener(listeners.back().get());
+    }
+
+    for (int ix = 0; ix < numSessions; ++ix)
+    {
+        injectTextMessage("This is a Test 1",
+                          *topics[ix],
+                          *(consumers[ix]->getConsumerId()));
+        injectTextMessage("This is a Test 2",
+                          *topics[ix],
+                          *(consumers[ix]->getConsumerId()));
+    }
+
+    for (int ix = 0; ix < numSessions; ++ix)
+    {
+        listeners[ix]->asyncWaitForMessages(2);
+        ASSERT_EQ(2, (int)listeners[ix]->messages.size());
+
+        std::shared_ptr<cms::TextMessage> first =
+            std::dynamic_pointer_cast<cms::TextMessage>(
+                listeners[ix]->messages[0]);
+        ASSERT_EQ(std::string("This is a Test 1"), first->getText());
+
+        ActiveMQSession* session =
+            dynamic_cast<ActiveMQSession*>(sessions[ix].get());
+        ASSERT_EQ(0, session->getDispatchQueueDepth());
+        ASSERT_TRUE(session->getDispatchIterationCount() > 0);
+        ASSERT_TRUE(session->getDispatchIterationTime() > 0);
+    }
+
+    for (int ix = 0; ix < numSessions; ++ix)
+    {
+        sessions[ix]->close();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQSessionTest, testLockFreeDispatch)
+{
+    ASSERT_TRUE(connection.get() != NULL);
+
+    connection->setUseLockFreeDispatch(true);
+
+    // One Session dispatches to a listener, the other is read synchronously.
+    MyCMSMessageListener          listener;
+    std::unique_ptr<cms::Session> session1(connection->createSession());
+    std::unique_ptr<cms::Session> session2(connection->createSession());
+    std::unique_ptr<cms::Topic>   topic1(session1->createTopic("TestTopic1"));
+    std::unique_ptr<cms::Topic>   topic2(session2->createTopic("TestTopic2"));
+
+    std::unique_ptr<ActiveMQConsumer> consumer1(
+        dynamic_cast<ActiveMQConsumer*>(
+            session1->createConsumer(topic1.get())));
+    std::unique_ptr<ActiveMQConsumer> consumer2(
+        dynamic_cast<ActiveMQConsumer*>(
+            session2->createConsumer(topic2.get())));
+
+    consumer1->setMessageListener(&listener);
+
+    const int numMessages = 100;
+    for (int ix = 0; ix < numMessages; ++ix)
+    {
+        injectTextMessage("This is a Test",
+                          *topic1,
+                          *consumer1->getConsumerId());
+        injectTextMessage("This is a Test",
+                          *topic2,
+                          *consumer2->getConsumerId());
+    }
+
+    listener.asyncWaitForMessages(numMessages);
+    ASSERT_EQ(numMessages, (int)listener.messages.size());
+
+    for (int ix = 0; ix < numMessages; ++ix)
+    {
+        std::unique_ptr<cms::Message> message(consumer2->receive(1000));
+        ASSERT_TRUE(message.get() != NULL);
+    }
+
+    ASSERT_TRUE(consumer2->receiveNoWait() == NULL);
+
+    session1->close();
+    session2->close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQSessionTest, testAckBatching)
+{
+    ASSERT_TRUE(connection.get() != NULL);
+
+    SentAckListener sent;
+    dTransport->setOutgoingListener(&sent);
+
+    // Only a full batch sends acks, the time out is out of reach.
+    connection->setAckBatchSize(4);
+    connection->setAckBatchTimeOut(60LL * 1000 * 1000);
+
+    std::unique_ptr<cms::Session> session(connection->createSession());
+    std::unique_ptr<cms::Topic>   topic1(session->createTopic("TestTopic1"));
+    std::unique_ptr<cms::Topic>   topic2(session->createTopic("TestTopic2"));
+
+    MyCMSMessageListener              msgListener1;
+    MyCMSMessageListener              msgListener2;
+    std::unique_ptr<ActiveMQConsumer> consumer1(
+        dynamic_cast<ActiveMQConsumer*>(session->createConsumer(topic1.get())));
+    std::unique_ptr<ActiveMQConsumer> consumer2(
+        dynamic_cast<ActiveMQConsumer*>(session->createConsumer(topic2.get())));
+    consumer1->setMessageListener(&msgListener1);
+    consumer2->setMessageListener(&msgListener2);
+
+    injectTextMessage("This is a Test 1",
+                      *topic1,
+                      *(consumer1->getConsumerId()));
+    injectTextMessage("This is a Test 2",
+                      *topic1,
+                      *(consumer1->getConsumerId()));
+    msgListener1.asyncWaitForMessages(2);
+    ASSERT_EQ(2, (int)msgListener1.messages.size());
+    ASSERT_EQ(0, sent.waitForAcks(0));
+
+    injectTextMessage("This is a Test 3",
+                      *topic2,
+                      *(consumer2->getConsumerId()));
+    injectTextMessage("This is a Test 4",
+                      *topic2,
+                      *(consumer2->getConsumerId()));
+    msgListener2.asyncWaitForMessages(2);
+    ASSERT_EQ(2, (int)msgListener2.messages.size());
+
+    // One range ack per consumer covering both of its Messages.
+    ASSERT_EQ(2, sent.waitForAcks(2));
+    for (int i = 0; i < 2; ++i)
+    {
+        ASSERT_EQ(2, sent.acks[i]->getMessageCount());
+        ASSERT_EQ((int)ActiveMQConstants::ACK_TYPE_CONSUMED,
+                  (int)sent.acks[i]->getAckType());
+    }
+    ASSERT_TRUE(sent.acks[0]->getConsumerId()->equals(
+        consumer1->getConsumerId().get()));
+    ASSERT_TRUE(sent.acks[1]->getConsumerId()->equals(
+        consumer2->getConsumerId().get()));
+
+    // A batch that never fills is sent once its time out has passed.
+    connection->setAckBatchTimeOut(2000);
+    std::unique_ptr<cms::Session> session2(connection->createSession());
+
+    MyCMSMessageListener              msgListener3;
+    std::unique_ptr<ActiveMQConsumer> consumer3(dynamic_cast<ActiveMQConsumer*>(
+        session2->createConsumer(topic1.get())));
+    consumer3->setMessageListener(&msgListener3);
+
+    injectTextMessage("This is a Test 5",
+                      *topic1,
+                      *(consumer3->getConsumerId()));
+    msgListener3.asyncWaitForMessages(1);
+    ASSERT_EQ(1, (int)msgListener3.messages.size());
+
+    ASSERT_EQ(3, sent.waitForAcks(3));
+    ASSERT_EQ(1, sent.acks[2]->getMessageCount());
+    ASSERT_TRUE(sent.acks[2]->getConsumerId()->equals(
+        consumer3->getConsumerId().get()));
+
+    session->close();
+    session2->close();
+    dTransport->setOutgoingListener(NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQSessionTest, testAckBatchFlushedWhileDeliveringAcks)
+{
+    ASSERT_TRUE(connection.get() != NULL);
+
+    BlockingAckListener sent;
+    dTransport->setOutgoingListener(&sent);
+
+    connection->setAckBatchSize(2);
+    connection->setAckBatchTimeOut(1000LL * 1000);
+
+    std::unique_ptr<cms::Session> session(connection->createSession());
+    std::unique_ptr<cms::Topic>   topic(session->createTopic("TestTopic1"));
+
+    MyCMSMessageListener              msgListener;
+    std::unique_ptr<ActiveMQConsumer> consumer(
+        dynamic_cast<ActiveMQConsumer*>(session->createConsumer(topic.get())));
+    consumer->setMessageListener(&msgListener);
+
+    injectTextMessage("This is a Test 1",
+                      *topic,
+                      *(consumer->getConsumerId()));
+    msgListener.asyncWaitForMessages(1);
+    ASSERT_EQ(1, (int)msgListener.messages.size());
+
+    // Send the first held ack on its own and keep it in flight.
+    connection->getSessions().get(0)->deliverAcks();
+    ASSERT_TRUE(sent.firstAck.await(5000));
+
+    // The batch fills while that ack is still being delivered, so this
+    // consumer can't send the ack for its second Message yet.
+    injectTextMessage("This is a Test 2",
+                      *topic,
+                      *(consumer->getConsumerId()));
+    msgListener.asyncWaitForMessages(2);
+    ASSERT_EQ(2, (int)msgListener.messages.size());
+    Thread::sleep(100);
+    sent.release.countDown();
+
+    // It stays in the batch and is flushed once the time out passes.
+    ASSERT_EQ(2, sent.waitForAcks(2));
+    ASSERT_EQ(1, sent.acks[0]->getMessageCount());
+    ASSERT_EQ(1, sent.acks[1]->getMessageCount());
+    ASSERT_TRUE(sent.acks[1]->getConsumerId()->equals(
+        consumer->getConsumerId().get()));
+
+    session->close();
+    dTransport->setOutgoingListener(NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ActiveMQSessionTest, testAckBatchResetOnTransportInterrupted)
+{
+    ASSERT_TRUE(connection.get() != NULL);
+
+    SentAckListener sent;
+    dTransport->setOutgoingListener(&sent);
+
+    connection->setAckBatchSize(3);
+    connection->setAckBatchTimeOut(60LL * 1000 * 1000);
+
+    std::unique_ptr<cms::Session> session(connection->createSession());
+    std::unique_ptr<cms::Topic>   topic(session->createTopic("TestTopic1"));
+
+    MyCMSMessageListener              msgListener;
+    std::unique_ptr<ActiveMQConsumer> consumer(
+        dynamic_cast<ActiveMQConsumer*>(session->createConsumer(topic.get())));
+    consumer->setMessageListener(&msgListener);
+
+    injectTextMessage("This is a Test 1",
+                      *topic,
+                      *(consumer->getConsumerId()));
+    msgListener.asyncWaitForMessages(1);
+    ASSERT_EQ(1, (int)msgListener.messages.size());
+    // The ack is held once onMessage returns, let that happen first.
+    Thread::sleep(200);
+
+    // The held ack is dropped with its Message, it no longer counts towards
+    // filling the batch.
+    connection->transportInterrupted();
+    connection->transportResumed();
+
+    injectTextMessage("This is a Test 2",
+                      *topic,
+                      *(consumer->getConsumerId()));
+    injectTextMessage("This is a Test 3",
+                      *topic,
+                      *(consumer->getConsumerId()));
+    msgListener.asyncWaitForMessages(3);
+    ASSERT_EQ(3, (int)msgListener.messages.size());
+    Thread::sleep(200);
+    ASSERT_EQ(0, sent.waitForAcks(0));
+
+    injectTextMessage("This is a Test 4",
+                      *topic,
+                      *(consumer->getConsumerId()));
+    msgListener.asyncWaitForMessages(4);
+    ASSERT_EQ(4, (int)msgListener.messages.size());
+
+    ASSERT_EQ(1, sent.waitForAcks(1));
+    ASSERT_EQ(3, sent.acks[0]->getMessageCount());
+
+    session->close();
+    dTransport->setOutgoingListener(NULL);
+}
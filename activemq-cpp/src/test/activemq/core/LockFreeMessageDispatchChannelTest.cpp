@@ -0,0 +1,402 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/core/LockFreeMessageDispatchChannel.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+
+#include <functional>
+#include <vector>
+
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+
+class LockFreeMessageDispatchChannelTest : public ::testing::Test
+{
+};
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreeMessageDispatchChannelTest, testCtor)
+{
+    LockFreeMessageDispatchChannel channel(16);
+    ASSERT_TRUE(channel.isRunning() == false);
+    ASSERT_TRUE(channel.isEmpty() == true);
+    ASSERT_TRUE(channel.size() == 0);
+    ASSERT_TRUE(channel.isClosed() == false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreeMessageDispatchChannelTest, testStart)
+{
+    LockFreeMessageDispatchChannel channel(16);
+    channel.start();
+    ASSERT_TRUE(channel.isRunning() == true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreeMessageDispatchChannelTest, testStop)
+{
+    LockFreeMessageDispatchChannel channel(16);
+    channel.start();
+    ASSERT_TRUE(channel.isRunning() == true);
+    channel.stop();
+    ASSERT_TRUE(channel.isRunning() == false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreeMessageDispatchChannelTest, testClose)
+{
+    LockFreeMessageDispatchChannel channel(16);
+    channel.start();
+    ASSERT_TRUE(channel.isRunning() == true);
+    ASSERT_TRUE(channel.isClosed() == false);
+    channel.close();
+    ASSERT_TRUE(channel.isRunning() == false);
+    ASSERT_TRUE(channel.isClosed() == true);
+    channel.start();
+    ASSERT_TRUE(channel.isRunning() == false);
+    ASSERT_TRUE(channel.isClosed() == true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreeMessageDispatchChannelTest, testEnqueue)
+{
+    LockFreeMessageDispatchChannel   channel(16);
+    std::shared_ptr<MessageDispatch> dispatch1(new MessageDispatch());
+    std::shared_ptr<MessageDispatch> dispatch2(new MessageDispatch());
+
+    ASSERT_TRUE(channel.isEmpty() == true);
+    ASSERT_TRUE(channel.size() == 0);
+
+    channel.enqueue(dispatch1);
+
+    ASSERT_TRUE(channel.isEmpty() == false);
+    ASSERT_TRUE(channel.size() == 1);
+
+    channel.enqueue(dispatch2);
+
+    ASSERT_TRUE(channel.isEmpty() == false);
+    ASSERT_TRUE(channel.size() == 2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreeMessageDispatchChannelTest, testEnqueueFront)
+{
+    LockFreeMessageDispatchChannel   channel(16);
+    std::shared_ptr<MessageDispatch> dispatch1(new MessageDispatch());
+    std::shared_ptr<MessageDispatch> dispatch2(new MessageDispatch());
+
+    channel.start();
+
+    ASSERT_TRUE(channel.isEmpty() == true);
+    ASSERT_TRUE(channel.size() == 0);
+
+    channel.enqueueFirst(dispatch1);
+
+    ASSERT_TRUE(channel.isEmpty() == false);
+    ASSERT_TRUE(channel.size() == 1);
+
+    channel.enqueueFirst(dispatch2);
+
+    ASSERT_TRUE(channel.isEmpty() == false);
+    ASSERT_TRUE(channel.size() == 2);
+
+    ASSERT_TRUE(channel.dequeueNoWait() == dispatch2);
+    ASSERT_TRUE(channel.dequeueNoWait() == dispatch1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreeMessageDispatchChannelTest, testPeek)
+{
+    LockFreeMessageDispatchChannel   channel(16);
+    std::shared_ptr<MessageDispatch> dispatch1(new MessageDispatch());
+    std::shared_ptr<MessageDispatch> dispatch2(new MessageDispatch());
+
+    ASSERT_TRUE(channel.isEmpty() == true);
+    ASSERT_TRUE(channel.size() == 0);
+
+    channel.enqueueFirst(dispatch1);
+
+    ASSERT_TRUE(channel.isEmpty() == false);
+    ASSERT_TRUE(channel.size() == 1);
+
+    channel.enqueueFirst(dispatch2);
+
+    ASSERT_TRUE(channel.isEmpty() == false);
+    ASSERT_TRUE(channel.size() == 2);
+
+    ASSERT_TRUE(channel.peek() == NULL);
+
+    channel.start();
+
+    ASSERT_TRUE(channel.peek() == dispatch2);
+    ASSERT_TRUE(channel.dequeueNoWait() == dispatch2);
+    ASSERT_TRUE(channel.peek() == dispatch1);
+    ASSERT_TRUE(channel.dequeueNoWait() == dispatch1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreeMessageDispatchChannelTest, testDequeueNoWait)
+{
+    LockFreeMessageDispatchChannel channel(16);
+
+    std::shared_ptr<MessageDispatch> dispatch1(new MessageDispatch());
+    std::shared_ptr<MessageDispatch> dispatch2(new MessageDispatch());
+    std::shared_ptr<MessageDispatch> dispatch3(new MessageDispatch());
+
+    ASSERT_TRUE(channel.isRunning() == false);
+    ASSERT_TRUE(channel.dequeueNoWait() == NULL);
+
+    channel.enqueue(dispatch1);
+    channel.enqueue(dispatch2);
+    channel.enqueue(dispatch3);
+
+    ASSERT_TRUE(channel.dequeueNoWait() == NULL);
+    channel.start();
+    ASSERT_TRUE(channel.isRunning() == true);
+
+    ASSERT_TRUE(channel.isEmpty() == false);
+    ASSERT_TRUE(channel.size() == 3);
+    ASSERT_TRUE(channel.dequeueNoWait() == dispatch1);
+    ASSERT_TRUE(channel.dequeueNoWait() == dispatch2);
+    ASSERT_TRUE(channel.dequeueNoWait() == dispatch3);
+
+    ASSERT_TRUE(channel.size() == 0);
+    ASSERT_TRUE(channel.isEmpty() == true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreeMessageDispatchChannelTest, testDequeue)
+{
+    LockFreeMessageDispatchChannel channel(16);
+
+    std::shared_ptr<MessageDispatch> dispatch1(new MessageDispatch());
+    std::shared_ptr<MessageDispatch> dispatch2(new MessageDispatch());
+    std::shared_ptr<MessageDispatch> dispatch3(new MessageDispatch());
+
+    channel.start();
+    ASSERT_TRUE(channel.isRunning() == true);
+
+    long long timeStarted = System::currentTimeMillis();
+
+    ASSERT_TRUE(channel.dequeue(1000) == NULL);
+
+    ASSERT_TRUE(System::currentTimeMillis() - timeStarted >= 999);
+
+    channel.enqueue(dispatch1);
+    channel.enqueue(dispatch2);
+    channel.enqueue(dispatch3);
+    ASSERT_TRUE(channel.isEmpty() == false);
+    ASSERT_TRUE(channel.size() == 3);
+    ASSERT_TRUE(channel.dequeue(-1) == dispatch1);
+    ASSERT_TRUE(channel.dequeue(0) == dispatch2);
+    ASSERT_TRUE(channel.dequeue(1000) == dispatch3);
+
+    ASSERT_TRUE(channel.size() == 0);
+    ASSERT_TRUE(channel.isEmpty() == true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreeMessageDispatchChannelTest, testRemoveAll)
+{
+    LockFreeMessageDispatchChannel channel(16);
+
+    std::shared_ptr<MessageDispatch> dispatch1(new MessageDispatch());
+    std::shared_ptr<MessageDispatch> dispatch2(new MessageDispatch());
+    std::shared_ptr<MessageDispatch> dispatch3(new MessageDispatch());
+
+    channel.enqueue(dispatch1);
+    channel.enqueue(dispatch2);
+    channel.enqueue(dispatch3);
+
+    channel.start();
+    ASSERT_TRUE(channel.isRunning() == true);
+    ASSERT_TRUE(channel.isEmpty() == false);
+    ASSERT_TRUE(channel.size() == 3);
+    ASSERT_TRUE(channel.removeAll().size() == 3);
+    ASSERT_TRUE(channel.size() == 0);
+    ASSERT_TRUE(channel.isEmpty() == true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreeMessageDispatchChannelTest, testSpillKeepsOrder)
+{
+    LockFreeMessageDispatchChannel channel(16);
+    channel.start();
+
+    // Fill well past the ring's capacity so that later messages spill.
+    std::vector<std::shared_ptr<MessageDispatch>> dispatches;
+    for (int i = 0; i < 100; ++i)
+    {
+        dispatches.push_back(
+            std::shared_ptr<MessageDispatch>(new MessageDispatch()));
+        channel.enqueue(dispatches.back());
+    }
+
+    ASSERT_EQ(100, channel.size());
+
+    for (int i = 0; i < 50; ++i)
+    {
+        ASSERT_TRUE(channel.dequeueNoWait() == dispatches[i]);
+    }
+
+    // Messages offered while spilled ones remain must follow them.
+    std::shared_ptr<MessageDispatch> last(new MessageDispatch());
+    channel.enqueue(last);
+
+    for (int i = 50; i < 100; ++i)
+    {
+        ASSERT_TRUE(channel.dequeueNoWait() == dispatches[i]);
+    }
+
+    ASSERT_TRUE(channel.dequeueNoWait() == last);
+    ASSERT_TRUE(channel.isEmpty() == true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+    class ProducerThread : public Thread
+    {
+    private:
+        LockFreeMessageDispatchChannel* channel;
+        int                             count;
+
+    public:
+        std::vector<std::shared_ptr<MessageDispatch>> sent;
+
+        ProducerThread(LockFreeMessageDispatchChannel* channel, int count)
+            : Thread(),
+              channel(channel),
+              count(count),
+              sent()
+        {
+        }
+
+        virtual void run()
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                sent.push_back(
+                    std::shared_ptr<MessageDispatch>(new MessageDispatch()));
+                channel->enqueue(sent.back());
+            }
+        }
+    };
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreeMessageDispatchChannelTest, testMultipleProducers)
+{
+    const int PRODUCERS = 4;
+    const int COUNT     = 5000;
+
+    LockFreeMessageDispatchChannel channel(64);
+    channel.start();
+
+    std::vector<std::unique_ptr<ProducerThread>> producers;
+    for (int i = 0; i < PRODUCERS; ++i)
+    {
+        producers.emplace_back(new ProducerThread(&channel, COUNT));
+        producers.back()->start();
+    }
+
+    // Each producer's messages must arrive in the order it sent them.
+    std::vector<std::shared_ptr<MessageDispatch>> received;
+    while ((int)received.size() < PRODUCERS * COUNT)
+    {
+        std::shared_ptr<MessageDispatch> dispatch = channel.dequeue(5000);
+        ASSERT_TRUE(dispatch != NULL);
+        received.push_back(dispatch);
+    }
+
+    for (int i = 0; i < PRODUCERS; ++i)
+    {
+        producers[i]->join();
+    }
+
+    for (int i = 0; i < PRODUCERS; ++i)
+    {
+        std::size_t next = 0;
+        for (std::size_t j = 0; j < received.size(); ++j)
+        {
+            if (next < producers[i]->sent.size() &&
+                received[j] == producers[i]->sent[next])
+            {
+                next++;
+            }
+        }
+
+        ASSERT_EQ((std::size_t)COUNT, next);
+    }
+
+    ASSERT_TRUE(channel.isEmpty() == true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+    class DelayedThread : public Thread
+    {
+    private:
+        std::function<void()> action;
+
+    public:
+        DelayedThread(std::function<void()> action)
+            : Thread(),
+              action(action)
+        {
+        }
+
+        virtual void run()
+        {
+            // Long enough for the consumer to finish spinning and park.
+            Thread::sleep(200);
+            action();
+        }
+    };
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreeMessageDispatchChannelTest, testDequeueWakesParkedConsumer)
+{
+    LockFreeMessageDispatchChannel   channel(16);
+    std::shared_ptr<MessageDispatch> dispatch(new MessageDispatch());
+
+    channel.start();
+
+    DelayedThread producer([&]() { channel.enqueue(dispatch); });
+    producer.start();
+    ASSERT_TRUE(channel.dequeue(-1) == dispatch);
+    producer.join();
+
+    DelayedThread closer([&]() { channel.close(); });
+    closer.start();
+    ASSERT_TRUE(channel.dequeue(-1) == NULL);
+    ASSERT_TRUE(channel.isClosed() == true);
+    closer.join();
+}
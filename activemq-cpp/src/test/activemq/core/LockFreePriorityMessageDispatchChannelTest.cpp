@@ -0,0 +1,332 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/core/LockFreePriorityMessageDispatchChannel.h>
+#include <decaf/lang/System.h>
+
+#include <vector>
+
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+
+class LockFreePriorityMessageDispatchChannelTest : public ::testing::Test
+{
+};
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreePriorityMessageDispatchChannelTest, testCtor)
+{
+    LockFreePriorityMessageDispatchChannel channel(16);
+    ASSERT_TRUE(channel.isRunning() == false);
+    ASSERT_TRUE(channel.isEmpty() == true);
+    ASSERT_TRUE(channel.size() == 0);
+    ASSERT_TRUE(channel.isClosed() == false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreePriorityMessageDispatchChannelTest, testStart)
+{
+    LockFreePriorityMessageDispatchChannel channel(16);
+    channel.start();
+    ASSERT_TRUE(channel.isRunning() == true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreePriorityMessageDispatchChannelTest, testStop)
+{
+    LockFreePriorityMessageDispatchChannel channel(16);
+    channel.start();
+    ASSERT_TRUE(channel.isRunning() == true);
+    channel.stop();
+    ASSERT_TRUE(channel.isRunning() == false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreePriorityMessageDispatchChannelTest, testClose)
+{
+    LockFreePriorityMessageDispatchChannel channel(16);
+    channel.start();
+    ASSERT_TRUE(channel.isRunning() == true);
+    ASSERT_TRUE(channel.isClosed() == false);
+    channel.close();
+    ASSERT_TRUE(channel.isRunning() == false);
+    ASSERT_TRUE(channel.isClosed() == true);
+    channel.start();
+    ASSERT_TRUE(channel.isRunning() == false);
+    ASSERT_TRUE(channel.isClosed() == true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreePriorityMessageDispatchChannelTest, testEnqueue)
+{
+    LockFreePriorityMessageDispatchChannel channel(16);
+    std::shared_ptr<MessageDispatch>       dispatch1(new MessageDispatch());
+    std::shared_ptr<MessageDispatch>       dispatch2(new MessageDispatch());
+
+    ASSERT_TRUE(channel.isEmpty() == true);
+    ASSERT_TRUE(channel.size() == 0);
+
+    channel.enqueue(dispatch1);
+
+    ASSERT_TRUE(channel.isEmpty() == false);
+    ASSERT_TRUE(channel.size() == 1);
+
+    channel.enqueue(dispatch2);
+
+    ASSERT_TRUE(channel.isEmpty() == false);
+    ASSERT_TRUE(channel.size() == 2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreePriorityMessageDispatchChannelTest, testEnqueueFront)
+{
+    LockFreePriorityMessageDispatchChannel channel(16);
+    std::shared_ptr<MessageDispatch>       dispatch1(new MessageDispatch());
+    std::shared_ptr<MessageDispatch>       dispatch2(new MessageDispatch());
+
+    std::shared_ptr<Message> message1(new Message());
+    std::shared_ptr<Message> message2(new Message());
+
+    message1->setPriority(2);
+    message2->setPriority(1);
+
+    dispatch1->setMessage(message1);
+    dispatch2->setMessage(message2);
+
+    channel.start();
+
+    ASSERT_TRUE(channel.isEmpty() == true);
+    ASSERT_TRUE(channel.size() == 0);
+
+    channel.enqueueFirst(dispatch1);
+
+    ASSERT_TRUE(channel.isEmpty() == false);
+    ASSERT_TRUE(channel.size() == 1);
+
+    channel.enqueueFirst(dispatch2);
+
+    ASSERT_TRUE(channel.isEmpty() == false);
+    ASSERT_TRUE(channel.size() == 2);
+
+    ASSERT_TRUE(channel.dequeueNoWait() == dispatch1);
+    ASSERT_TRUE(channel.dequeueNoWait() == dispatch2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreePriorityMessageDispatchChannelTest, testPeek)
+{
+    LockFreePriorityMessageDispatchChannel channel(16);
+    std::shared_ptr<MessageDispatch>       dispatch1(new MessageDispatch());
+    std::shared_ptr<MessageDispatch>       dispatch2(new MessageDispatch());
+
+    std::shared_ptr<Message> message1(new Message());
+    std::shared_ptr<Message> message2(new Message());
+
+    message1->setPriority(2);
+    message2->setPriority(1);
+
+    dispatch1->setMessage(message1);
+    dispatch2->setMessage(message2);
+
+    ASSERT_TRUE(channel.isEmpty() == true);
+    ASSERT_TRUE(channel.size() == 0);
+
+    channel.enqueueFirst(dispatch1);
+
+    ASSERT_TRUE(channel.isEmpty() == false);
+    ASSERT_TRUE(channel.size() == 1);
+
+    channel.enqueueFirst(dispatch2);
+
+    ASSERT_TRUE(channel.isEmpty() == false);
+    ASSERT_TRUE(channel.size() == 2);
+
+    ASSERT_TRUE(channel.peek() == NULL);
+
+    channel.start();
+
+    ASSERT_TRUE(channel.peek() == dispatch1);
+    ASSERT_TRUE(channel.dequeueNoWait() == dispatch1);
+    ASSERT_TRUE(channel.peek() == dispatch2);
+    ASSERT_TRUE(channel.dequeueNoWait() == dispatch2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreePriorityMessageDispatchChannelTest, testDequeueNoWait)
+{
+    LockFreePriorityMessageDispatchChannel channel(16);
+
+    std::shared_ptr<MessageDispatch> dispatch1(new MessageDispatch());
+    std::shared_ptr<MessageDispatch> dispatch2(new MessageDispatch());
+    std::shared_ptr<MessageDispatch> dispatch3(new MessageDispatch());
+
+    std::shared_ptr<Message> message1(new Message());
+    std::shared_ptr<Message> message2(new Message());
+    std::shared_ptr<Message> message3(new Message());
+
+    message1->setPriority(2);
+    message2->setPriority(3);
+    message3->setPriority(1);
+
+    dispatch1->setMessage(message1);
+    dispatch2->setMessage(message2);
+    dispatch3->setMessage(message3);
+
+    ASSERT_TRUE(channel.isRunning() == false);
+    ASSERT_TRUE(channel.dequeueNoWait() == NULL);
+
+    channel.enqueue(dispatch1);
+    channel.enqueue(dispatch2);
+    channel.enqueue(dispatch3);
+
+    ASSERT_TRUE(channel.dequeueNoWait() == NULL);
+    channel.start();
+    ASSERT_TRUE(channel.isRunning() == true);
+
+    ASSERT_TRUE(channel.isEmpty() == false);
+    ASSERT_TRUE(channel.size() == 3);
+    ASSERT_TRUE(channel.dequeueNoWait() == dispatch2);
+    ASSERT_TRUE(channel.dequeueNoWait() == dispatch1);
+    ASSERT_TRUE(channel.dequeueNoWait() == dispatch3);
+
+    ASSERT_TRUE(channel.size() == 0);
+    ASSERT_TRUE(channel.isEmpty() == true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreePriorityMessageDispatchChannelTest, testDequeue)
+{
+    LockFreePriorityMessageDispatchChannel channel(16);
+
+    std::shared_ptr<MessageDispatch> dispatch1(new MessageDispatch());
+    std::shared_ptr<MessageDispatch> dispatch2(new MessageDispatch());
+    std::shared_ptr<MessageDispatch> dispatch3(new MessageDispatch());
+
+    std::shared_ptr<Message> message1(new Message());
+    std::shared_ptr<Message> message2(new Message());
+    std::shared_ptr<Message> message3(new Message());
+
+    message1->setPriority(2);
+    message2->setPriority(3);
+    message3->setPriority(1);
+
+    dispatch1->setMessage(message1);
+    dispatch2->setMessage(message2);
+    dispatch3->setMessage(message3);
+
+    channel.start();
+    ASSERT_TRUE(channel.isRunning() == true);
+
+    long long timeStarted = System::currentTimeMillis();
+
+    ASSERT_TRUE(channel.dequeue(1000) == NULL);
+
+    ASSERT_TRUE(System::currentTimeMillis() - timeStarted >= 999);
+
+    channel.enqueue(dispatch1);
+    channel.enqueue(dispatch2);
+    channel.enqueue(dispatch3);
+    ASSERT_TRUE(channel.isEmpty() == false);
+    ASSERT_TRUE(channel.size() == 3);
+    ASSERT_TRUE(channel.dequeue(-1) == dispatch2);
+    ASSERT_TRUE(channel.dequeue(0) == dispatch1);
+    ASSERT_TRUE(channel.dequeue(1000) == dispatch3);
+
+    ASSERT_TRUE(channel.size() == 0);
+    ASSERT_TRUE(channel.isEmpty() == true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreePriorityMessageDispatchChannelTest, testRemoveAll)
+{
+    LockFreePriorityMessageDispatchChannel channel(16);
+
+    std::shared_ptr<MessageDispatch> dispatch1(new MessageDispatch());
+    std::shared_ptr<MessageDispatch> dispatch2(new MessageDispatch());
+    std::shared_ptr<MessageDispatch> dispatch3(new MessageDispatch());
+
+    std::shared_ptr<Message> message1(new Message());
+    std::shared_ptr<Message> message2(new Message());
+    std::shared_ptr<Message> message3(new Message());
+
+    message1->setPriority(2);
+    message2->setPriority(3);
+    message3->setPriority(1);
+
+    dispatch1->setMessage(message1);
+    dispatch2->setMessage(message2);
+    dispatch3->setMessage(message3);
+
+    channel.enqueue(dispatch1);
+    channel.enqueue(dispatch2);
+    channel.enqueue(dispatch3);
+
+    channel.start();
+    ASSERT_TRUE(channel.isRunning() == true);
+    ASSERT_TRUE(channel.isEmpty() == false);
+    ASSERT_TRUE(channel.size() == 3);
+    ASSERT_TRUE(channel.removeAll().size() == 3);
+    ASSERT_TRUE(channel.size() == 0);
+    ASSERT_TRUE(channel.isEmpty() == true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LockFreePriorityMessageDispatchChannelTest, testLaneSpillKeepsOrder)
+{
+    LockFreePriorityMessageDispatchChannel channel(16);
+    channel.start();
+
+    // The non default lanes are small so these spill, priorities above
+    // the highest go to the highest lane.
+    std::vector<std::shared_ptr<MessageDispatch>> high;
+    std::vector<std::shared_ptr<MessageDispatch>> low;
+    for (int i = 0; i < 40; ++i)
+    {
+        std::shared_ptr<Message> message1(new Message());
+        std::shared_ptr<Message> message2(new Message());
+        message1->setPriority(12);
+        message2->setPriority(0);
+
+        high.push_back(std::shared_ptr<MessageDispatch>(new MessageDispatch()));
+        high.back()->setMessage(message1);
+        low.push_back(std::shared_ptr<MessageDispatch>(new MessageDispatch()));
+        low.back()->setMessage(message2);
+
+        channel.enqueue(low.back());
+        channel.enqueue(high.back());
+    }
+
+    ASSERT_EQ(80, channel.size());
+
+    for (int i = 0; i < 40; ++i)
+    {
+        ASSERT_TRUE(channel.dequeueNoWait() == high[i]);
+    }
+
+    for (int i = 0; i < 40; ++i)
+    {
+        ASSERT_TRUE(channel.dequeueNoWait() == low[i]);
+    }
+
+    ASSERT_TRUE(channel.isEmpty() == true);
+}
@@ -0,0 +1,121 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/core/MessagePropertyTemplate.h>
+#include <activemq/util/PrimitiveMap.h>
+#include <activemq/wireformat/openwire/marshal/PrimitiveTypesMarshaller.h>
+
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace activemq::util;
+using namespace activemq::wireformat::openwire::marshal;
+
+class MessagePropertyTemplateTest : public ::testing::Test
+{
+protected:
+    PrimitiveMap headers;
+
+    void SetUp() override
+    {
+        headers.setString("application", "orders");
+        headers.setInt("schemaVersion", 3);
+        headers.setBool("audited", true);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(MessagePropertyTemplateTest, testEncodedOnce)
+{
+    MessagePropertyTemplate propertyTemplate(headers);
+
+    std::vector<unsigned char> expected;
+    PrimitiveTypesMarshaller::marshal(&headers, expected);
+    ASSERT_EQ(expected, propertyTemplate.getEncoded());
+    ASSERT_EQ(3, propertyTemplate.getProperties().size());
+
+    // Later changes to the source map do not reach the template.
+    headers.setString("application", "billing");
+    ASSERT_EQ(std::string("orders"),
+              propertyTemplate.getProperties().getString("application"));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(MessagePropertyTemplateTest, testApplyToMessageWithoutProperties)
+{
+    MessagePropertyTemplate propertyTemplate(headers);
+
+    ActiveMQTextMessage message;
+    message.setText("body");
+    propertyTemplate.applyTo(&message);
+
+    const ActiveMQTextMessage& view = message;
+    ASSERT_EQ(propertyTemplate.getEncoded(), view.getMarshalledProperties());
+
+    // The bytes are sent as they are.
+    message.beforeMarshal(NULL);
+    ASSERT_EQ(propertyTemplate.getEncoded(), view.getMarshalledProperties());
+
+    ASSERT_EQ(std::string("orders"), message.getStringProperty("application"));
+    ASSERT_EQ(3, message.getIntProperty("schemaVersion"));
+    ASSERT_TRUE(message.getBooleanProperty("audited"));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(MessagePropertyTemplateTest, testMessagePropertiesTakePrecedence)
+{
+    MessagePropertyTemplate propertyTemplate(headers);
+
+    ActiveMQTextMessage message;
+    message.setIntProperty("schemaVersion", 4);
+    message.setStringProperty("orderId", "A-1");
+    propertyTemplate.applyTo(&message);
+
+    const ActiveMQTextMessage& view = message;
+    PrimitiveMap               decoded;
+    PrimitiveTypesMarshaller::unmarshal(&decoded,
+                                        view.getMarshalledProperties());
+    ASSERT_EQ(4, decoded.size());
+    ASSERT_EQ(std::string("orders"), decoded.getString("application"));
+    ASSERT_EQ(4, decoded.getInt("schemaVersion"));
+    ASSERT_EQ(std::string("A-1"), decoded.getString("orderId"));
+    ASSERT_TRUE(decoded.getBool("audited"));
+
+    ASSERT_EQ(4, message.getIntProperty("schemaVersion"));
+    ASSERT_EQ(std::string("A-1"), message.getStringProperty("orderId"));
+    ASSERT_EQ(4, (int)message.getPropertyNames().size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(MessagePropertyTemplateTest, testEmptyTemplate)
+{
+    PrimitiveMap            empty;
+    MessagePropertyTemplate propertyTemplate(empty);
+    ASSERT_TRUE(propertyTemplate.getEncoded().empty());
+
+    ActiveMQTextMessage message;
+    message.setStringProperty("orderId", "A-1");
+    propertyTemplate.applyTo(&message);
+    ASSERT_EQ(std::string("A-1"), message.getStringProperty("orderId"));
+    ASSERT_EQ(1, (int)message.getPropertyNames().size());
+}
@@ -365,6 +365,16 @@ namespace mock
                             std::shared_ptr<Command> clientWireFormat =
                                 wireFormat->unmarshal(&mock, &dataIn);
 
+                            // Settle on the same options as the client did,
+                            // the marshal caches among them.
+                            std::shared_ptr<WireFormatInfo> clientInfo =
+                                std::dynamic_pointer_cast<WireFormatInfo>(
+                                    clientWireFormat);
+                            if (clientInfo != NULL)
+                            {
+                                wireFormat->renegotiateWireFormat(*clientInfo);
+                            }
+
                             // Small delay to let client process the
                             // WireFormatInfo before we start reading commands
                             Thread::sleep(50);
@@ -17,15 +17,25 @@
 
 #include <gtest/gtest.h>
 
+#include <activemq/commands/ActiveMQTempQueue.h>
+#include <activemq/commands/ActiveMQTextMessage.h>
 #include <activemq/commands/ActiveMQTopic.h>
 #include <activemq/commands/ConnectionInfo.h>
+#include <activemq/commands/DestinationInfo.h>
 #include <activemq/commands/Message.h>
 #include <activemq/commands/SessionInfo.h>
+#include <activemq/core/ActiveMQConstants.h>
 #include <activemq/state/ConnectionStateTracker.h>
 #include <activemq/state/ConsumerState.h>
 #include <activemq/state/SessionState.h>
+#include <activemq/transport/IOTransport.h>
 #include <activemq/transport/Transport.h>
 #include <activemq/wireformat/WireFormat.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
 #include <decaf/lang/exceptions/UnsupportedOperationException.h>
 #include <decaf/util/LinkedList.h>
 #include <memory>
@@ -34,8 +44,11 @@ using namespace std;
 using namespace activemq;
 using namespace activemq::state;
 using namespace activemq::commands;
+using namespace activemq::core;
 using namespace activemq::transport;
 using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace decaf::io;
 using namespace decaf::util;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
@@ -57,6 +70,7 @@ public:
     LinkedList<std::shared_ptr<Command>> consumers;
     LinkedList<std::shared_ptr<Command>> messages;
     LinkedList<std::shared_ptr<Command>> messagePulls;
+    LinkedList<std::shared_ptr<Command>> destinations;
 
 public:
     virtual ~TrackingTransport()
@@ -75,7 +89,7 @@ public:
     {
     }
 
-    virtual void oneway(const std::shared_ptr<Command> command)
+    virtual void oneway(const std::shared_ptr<Command>& command)
     {
         if (command->isConnectionInfo())
         {
@@ -101,6 +115,11 @@ public:
         {
             messagePulls.add(command);
         }
+        else if (command->getDataStructureType() ==
+                 DestinationInfo::ID_DESTINATIONINFO)
+        {
+            destinations.add(command);
+        }
     }
 
     virtual std::shared_ptr<FutureResponse> asyncRequest(
@@ -247,9 +266,10 @@ TEST_F(ConnectionStateTrackerTest, testStalledConsumersAreCleared)
         {
         }
 
-        virtual void marshal(const std::shared_ptr<commands::Command> command,
-                             const activemq::transport::Transport*    transport,
-                             decaf::io::DataOutputStream*             out)
+        virtual void marshal(
+            const std::shared_ptr<commands::Command>& command,
+            const activemq::transport::Transport*     transport,
+            decaf::io::DataOutputStream*              out)
         {
         }
 
@@ -304,7 +324,7 @@ TEST_F(ConnectionStateTrackerTest, testStalledConsumersAreCleared)
             return wireFormat;
         }
 
-        virtual void oneway(const std::shared_ptr<Command> command)
+        virtual void oneway(const std::shared_ptr<Command>& command)
         {
             TrackingTransport::oneway(command);
             if (command->isConsumerControl())
@@ -401,6 +421,164 @@ TEST_F(ConnectionStateTrackerTest, testMessageCache)
         << ("Should only be three messages");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ConnectionStateTrackerTest, testMessageArena)
+{
+    ConnectionStateTracker tracker;
+    tracker.setTrackMessages(true);
+    tracker.setTrackMessageBytes(true);
+
+    ConnectionData conn = createConnectionState(tracker);
+
+    // One byte holds no Message at all, then room for every Message, then
+    // room for only some of the newest ones.
+    int budgets[] = {1, 1024 * 1024, 1024};
+
+    for (int budget = 0; budget < 3; ++budget)
+    {
+        std::shared_ptr<TrackingTransport> transport(new TrackingTransport);
+        tracker.setMaxMessageCacheSize(budgets[budget]);
+
+        for (int i = 1; i <= 100; ++i)
+        {
+            std::shared_ptr<commands::MessageId> id(
+                new commands::MessageId());
+            id->setProducerId(conn.producer->getProducerId());
+            id->setProducerSequenceId(i);
+            std::shared_ptr<ActiveMQTextMessage> message(
+                new ActiveMQTextMessage);
+            message->setMessageId(id);
+            message->setText("Message " + Integer::toString(i));
+
+            tracker.processMessage(message.get());
+            tracker.trackBack(message);
+        }
+
+        tracker.restore(transport);
+
+        int size = transport->messages.size();
+        if (budget == 0)
+        {
+            ASSERT_EQ(1, size) << "Should only keep the newest message";
+        }
+        else if (budget == 1)
+        {
+            // The larger budget grows the ring in place, so the newest
+            // Message of the last round is still held ahead of this one's.
+            ASSERT_EQ(101, size) << "Should keep every message";
+            std::shared_ptr<Message> held = std::dynamic_pointer_cast<Message>(
+                transport->messages.removeFirst());
+            ASSERT_EQ(100LL, held->getMessageId()->getProducerSequenceId());
+            size--;
+        }
+        else
+        {
+            ASSERT_TRUE(size > 1 && size < 100) << size;
+        }
+
+        // Replayed oldest first and ending with the newest, intact.
+        for (int i = 0; i < size; ++i)
+        {
+            std::shared_ptr<ActiveMQTextMessage> message =
+                std::dynamic_pointer_cast<ActiveMQTextMessage>(
+                    transport->messages.get(i));
+            ASSERT_TRUE(message != NULL);
+
+            int sequence = 100 - size + 1 + i;
+            ASSERT_EQ((long long)sequence,
+                      message->getMessageId()->getProducerSequenceId());
+            ASSERT_EQ("Message " + Integer::toString(sequence),
+                      message->getText());
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ConnectionStateTrackerTest, testMessageArenaReplaysFrames)
+{
+    // Negotiated the way the arena writes its frames, unless the marshal
+    // cache is on.
+    class FramedTransport : public TrackingTransport
+    {
+    public:
+        std::shared_ptr<OpenWireFormat> wireFormat;
+        ByteArrayOutputStream            bytesOut;
+        DataOutputStream                 dataOut;
+        IOTransport                      ioTransport;
+
+    public:
+        FramedTransport(bool cacheEnabled)
+            : TrackingTransport(),
+              wireFormat(new OpenWireFormat(decaf::util::Properties())),
+              bytesOut(),
+              dataOut(&bytesOut),
+              ioTransport(wireFormat)
+        {
+            wireFormat->setVersion(OpenWireFormat::MAX_SUPPORTED_VERSION);
+            wireFormat->setTightEncodingEnabled(true);
+            wireFormat->setCacheEnabled(cacheEnabled);
+            ioTransport.setOutputStream(&dataOut);
+        }
+
+        virtual std::shared_ptr<wireformat::WireFormat> getWireFormat() const
+        {
+            return wireFormat;
+        }
+
+        virtual Transport* narrow(const std::type_info& typeId)
+        {
+            return ioTransport.narrow(typeId);
+        }
+    };
+
+    ConnectionStateTracker tracker;
+    tracker.setTrackMessages(true);
+    tracker.setTrackMessageBytes(true);
+    tracker.setMaxMessageCacheSize(1024 * 1024);
+
+    ConnectionData conn = createConnectionState(tracker);
+
+    for (int i = 1; i <= 10; ++i)
+    {
+        std::shared_ptr<commands::MessageId> id(new commands::MessageId());
+        id->setProducerId(conn.producer->getProducerId());
+        id->setProducerSequenceId(i);
+        std::shared_ptr<ActiveMQTextMessage> message(new ActiveMQTextMessage);
+        message->setMessageId(id);
+        message->setText("Message " + Integer::toString(i));
+
+        tracker.processMessage(message.get());
+        tracker.trackBack(message);
+    }
+
+    std::shared_ptr<FramedTransport> cached(new FramedTransport(true));
+    tracker.restore(cached);
+    ASSERT_EQ(10, cached->messages.size());
+    ASSERT_EQ(0, cached->bytesOut.size());
+
+    std::shared_ptr<FramedTransport> framed(new FramedTransport(false));
+    tracker.restore(framed);
+    ASSERT_EQ(0, framed->messages.size());
+    ASSERT_TRUE(framed->bytesOut.size() > 0);
+
+    std::pair<unsigned char*, int> bytes = framed->bytesOut.toByteArray();
+    ByteArrayInputStream bytesIn(bytes.first, bytes.second, true);
+    DataInputStream      dataIn(&bytesIn);
+
+    for (int i = 1; i <= 10; ++i)
+    {
+        std::shared_ptr<ActiveMQTextMessage> message =
+            std::dynamic_pointer_cast<ActiveMQTextMessage>(
+                framed->wireFormat->unmarshal(framed.get(), &dataIn));
+        ASSERT_TRUE(message != NULL);
+        ASSERT_EQ((long long)i,
+                  message->getMessageId()->getProducerSequenceId());
+        ASSERT_EQ("Message " + Integer::toString(i), message->getText());
+    }
+
+    ASSERT_EQ(0, bytesIn.available());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(ConnectionStateTrackerTest, testMessagePullCache)
 {
@@ -427,3 +605,41 @@ TEST_F(ConnectionStateTrackerTest, testMessagePullCache)
     ASSERT_EQ(10, transport->messagePulls.size())
         << ("Should only be three message pulls");
 }
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ConnectionStateTrackerTest, testRemovedTempDestinationNotRestored)
+{
+    std::shared_ptr<TrackingTransport> transport(new TrackingTransport);
+    ConnectionStateTracker             tracker;
+
+    ConnectionData conn = createConnectionState(tracker);
+
+    std::shared_ptr<DestinationInfo> kept(new DestinationInfo);
+    kept->setConnectionId(conn.connection->getConnectionId());
+    kept->setDestination(std::shared_ptr<ActiveMQDestination>(
+        new ActiveMQTempQueue("CONNECTION:1")));
+    kept->setOperationType(ActiveMQConstants::DESTINATION_ADD_OPERATION);
+
+    std::shared_ptr<DestinationInfo> removed(new DestinationInfo);
+    removed->setConnectionId(conn.connection->getConnectionId());
+    removed->setDestination(std::shared_ptr<ActiveMQDestination>(
+        new ActiveMQTempQueue("CONNECTION:2")));
+    removed->setOperationType(ActiveMQConstants::DESTINATION_ADD_OPERATION);
+
+    // Both operations visit processDestinationInfo, as they do when sent.
+    tracker.track(kept);
+    tracker.track(removed);
+
+    std::shared_ptr<DestinationInfo> removal(removed->cloneDataStructure());
+    removal->setOperationType(ActiveMQConstants::DESTINATION_REMOVE_OPERATION);
+    tracker.track(removal);
+
+    tracker.restore(transport);
+
+    ASSERT_EQ(1, transport->destinations.size());
+    std::shared_ptr<DestinationInfo> restored =
+        std::dynamic_pointer_cast<DestinationInfo>(
+            transport->destinations.getFirst());
+    ASSERT_TRUE(restored->getDestination()->equals(
+        kept->getDestination().get()));
+}
@@ -0,0 +1,258 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+
+#include <activemq/threads/PooledTaskRunner.h>
+#include <activemq/threads/Task.h>
+
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/util/concurrent/LinkedBlockingQueue.h>
+#include <decaf/util/concurrent/ThreadPoolExecutor.h>
+#include <decaf/util/concurrent/TimeUnit.h>
+
+using namespace activemq;
+using namespace activemq::threads;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
+
+class PooledTaskRunnerTest : public ::testing::Test
+{
+protected:
+    std::shared_ptr<ThreadPoolExecutor> createPool(int size)
+    {
+        return std::shared_ptr<ThreadPoolExecutor>(
+            new ThreadPoolExecutor(size,
+                                   size,
+                                   5,
+                                   TimeUnit::SECONDS,
+                                   new LinkedBlockingQueue<Runnable*>()));
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+class CountingTask : public Task
+{
+private:
+    std::atomic<unsigned int> count;
+    bool                      infinite;
+
+public:
+    CountingTask(bool infinite)
+        : count(0),
+          infinite(infinite)
+    {
+    }
+
+    virtual ~CountingTask()
+    {
+    }
+
+    virtual bool iterate()
+    {
+        count++;
+        return infinite;
+    }
+
+    unsigned int getCount() const
+    {
+        return count.load();
+    }
+};
+
+class SerialCheckingTask : public Task
+{
+private:
+    std::atomic<int> running;
+    std::atomic<int> maxRunning;
+    std::atomic<int> pending;
+
+public:
+    SerialCheckingTask()
+        : running(0),
+          maxRunning(0),
+          pending(0)
+    {
+    }
+
+    virtual ~SerialCheckingTask()
+    {
+    }
+
+    void addWork()
+    {
+        pending++;
+    }
+
+    virtual bool iterate()
+    {
+        int now = ++running;
+        if (now > maxRunning.load())
+        {
+            maxRunning.store(now);
+        }
+
+        Thread::yield();
+
+        bool more = pending.load() > 0 && --pending > 0;
+        running--;
+        return more;
+    }
+
+    int getMaxRunning() const
+    {
+        return maxRunning.load();
+    }
+
+    int getPending() const
+    {
+        return pending.load();
+    }
+};
+
+class WakeupThread : public Thread
+{
+private:
+    SerialCheckingTask* task;
+    TaskRunner*         runner;
+
+public:
+    WakeupThread(SerialCheckingTask* task, TaskRunner* runner)
+        : Thread(),
+          task(task),
+          runner(runner)
+    {
+    }
+
+    virtual void run()
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            task->addWork();
+            runner->wakeup();
+        }
+    }
+};
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(PooledTaskRunnerTest, testSimple)
+{
+    std::shared_ptr<ThreadPoolExecutor> pool = createPool(2);
+
+    CountingTask nullTask(false);
+    ASSERT_THROW(
+        std::unique_ptr<TaskRunner>(new PooledTaskRunner(pool, NULL)),
+        NullPointerException);
+    ASSERT_THROW(std::unique_ptr<TaskRunner>(new PooledTaskRunner(
+                     std::shared_ptr<ThreadPoolExecutor>(),
+                     &nullTask)),
+                 NullPointerException);
+
+    CountingTask     simpleTask(false);
+    PooledTaskRunner simpleTaskRunner(pool, &simpleTask);
+
+    simpleTaskRunner.wakeup();
+    Thread::sleep(100);
+    ASSERT_EQ(0U, simpleTask.getCount()) << "Not run before start";
+
+    simpleTaskRunner.start();
+    ASSERT_TRUE(simpleTaskRunner.isStarted());
+    Thread::sleep(250);
+    ASSERT_TRUE(simpleTask.getCount() >= 1);
+    simpleTaskRunner.wakeup();
+    Thread::sleep(250);
+    ASSERT_TRUE(simpleTask.getCount() >= 2);
+
+    CountingTask     infiniteTask(true);
+    PooledTaskRunner infiniteTaskRunner(pool, &infiniteTask);
+    infiniteTaskRunner.start();
+    Thread::sleep(250);
+    ASSERT_TRUE(infiniteTask.getCount() != 0);
+    infiniteTaskRunner.shutdown();
+    unsigned int count = infiniteTask.getCount();
+    Thread::sleep(250);
+    ASSERT_EQ(count, infiniteTask.getCount());
+
+    simpleTaskRunner.shutdown();
+    pool->shutdown();
+    pool->awaitTermination(1, TimeUnit::MINUTES);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(PooledTaskRunnerTest, testBusyTasksShareOneThread)
+{
+    std::shared_ptr<ThreadPoolExecutor> pool = createPool(1);
+
+    CountingTask     task1(true);
+    CountingTask     task2(true);
+    PooledTaskRunner runner1(pool, &task1, 10);
+    PooledTaskRunner runner2(pool, &task2, 10);
+
+    runner1.start();
+    runner2.start();
+    Thread::sleep(250);
+
+    runner1.shutdown();
+    runner2.shutdown();
+
+    ASSERT_TRUE(task1.getCount() > 0);
+    ASSERT_TRUE(task2.getCount() > 0);
+
+    pool->shutdown();
+    pool->awaitTermination(1, TimeUnit::MINUTES);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(PooledTaskRunnerTest, testTaskIsRunSerially)
+{
+    std::shared_ptr<ThreadPoolExecutor> pool = createPool(4);
+
+    SerialCheckingTask task;
+    PooledTaskRunner   runner(pool, &task, 5);
+    runner.start();
+
+    WakeupThread thread1(&task, &runner);
+    WakeupThread thread2(&task, &runner);
+    WakeupThread thread3(&task, &runner);
+    thread1.start();
+    thread2.start();
+    thread3.start();
+    thread1.join();
+    thread2.join();
+    thread3.join();
+
+    for (int i = 0; i < 50 && task.getPending() > 0; ++i)
+    {
+        Thread::sleep(20);
+    }
+
+    runner.shutdown();
+    ASSERT_EQ(0, task.getPending());
+    ASSERT_EQ(1, task.getMaxRunning());
+
+    pool->shutdown();
+    pool->awaitTermination(1, TimeUnit::MINUTES);
+}
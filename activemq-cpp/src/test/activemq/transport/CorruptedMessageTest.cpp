@@ -81,7 +81,7 @@ public:
     {
     }
 
-    virtual void oneway(const std::shared_ptr<Command> command)
+    virtual void oneway(const std::shared_ptr<Command>& command)
     {
     }
 
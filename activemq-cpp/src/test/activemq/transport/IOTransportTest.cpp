@@ -27,12 +27,14 @@
 #include <decaf/io/BufferedOutputStream.h>
 #include <decaf/io/ByteArrayOutputStream.h>
 #include <decaf/lang/Exception.h>
+#include <decaf/lang/System.h>
 #include <decaf/lang/Thread.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
 #include <decaf/util/Random.h>
 #include <decaf/util/concurrent/Concurrent.h>
 #include <decaf/util/concurrent/CountDownLatch.h>
 #include <decaf/util/concurrent/Mutex.h>
+#include <vector>
 
 using namespace activemq;
 using namespace activemq::transport;
@@ -186,7 +188,7 @@ public:
         return std::shared_ptr<Command>();
     }
 
-    virtual void marshal(const std::shared_ptr<commands::Command> command,
+    virtual void marshal(const std::shared_ptr<commands::Command>& command,
                          const activemq::transport::Transport* transport
                                                       AMQCPP_UNUSED,
                          decaf::io::DataOutputStream* outputStream)
@@ -279,6 +281,74 @@ public:
     }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+class MyWriter : public decaf::lang::Runnable
+{
+private:
+    IOTransport* transport;
+    char         c;
+    int          count;
+
+private:
+    MyWriter(const MyWriter&);
+    MyWriter& operator=(const MyWriter&);
+
+public:
+    bool failed;
+
+    MyWriter(IOTransport* transport, char c, int count)
+        : transport(transport),
+          c(c),
+          count(count),
+          failed(false)
+    {
+    }
+
+    virtual ~MyWriter()
+    {
+    }
+
+    virtual void run()
+    {
+        try
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                std::shared_ptr<MyCommand> cmd(new MyCommand());
+                cmd->c = c;
+                transport->oneway(cmd);
+            }
+        }
+        catch (...)
+        {
+            failed = true;
+        }
+    }
+};
+
+class FailingFlushOutputStream : public decaf::io::ByteArrayOutputStream
+{
+public:
+    bool failing;
+
+    FailingFlushOutputStream()
+        : failing(true)
+    {
+    }
+
+    virtual ~FailingFlushOutputStream()
+    {
+    }
+
+    virtual void flush()
+    {
+        if (failing)
+        {
+            throw decaf::io::IOException(__FILE__, __LINE__, "Flush failed");
+        }
+    }
+};
+
 }  // anonymous namespace
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -425,6 +495,142 @@ TEST_F(IOTransportTest, testWrite)
 
     delete[] array.first;
 
+    // Without coalescing every frame is flushed on its own.
+    ASSERT_EQ(5, transport.getWriteFrameCount());
+    ASSERT_EQ(5, transport.getWriteFlushCount());
+
+    transport.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(IOTransportTest, testCoalescedWrite)
+{
+    decaf::io::BlockingByteArrayInputStream is;
+    decaf::io::ByteArrayOutputStream        os;
+    decaf::io::DataInputStream              input(&is);
+    decaf::io::DataOutputStream             output(&os);
+
+    std::shared_ptr<MyWireFormat> wireFormat(new MyWireFormat());
+    MyTransportListener           listener;
+    IOTransport                   transport;
+    transport.setInputStream(&input);
+    transport.setOutputStream(&output);
+    transport.setTransportListener(&listener);
+    transport.setWireFormat(wireFormat);
+    transport.setWriteCoalesceMicros(2000);
+
+    transport.start();
+
+    const int NUM_WRITERS = 4;
+    const int NUM_FRAMES  = 250;
+
+    std::vector<std::shared_ptr<MyWriter>>            writers;
+    std::vector<std::shared_ptr<decaf::lang::Thread>> threads;
+
+    for (int i = 0; i < NUM_WRITERS; ++i)
+    {
+        writers.push_back(std::shared_ptr<MyWriter>(
+            new MyWriter(&transport, (char)('a' + i), NUM_FRAMES)));
+        threads.push_back(std::shared_ptr<decaf::lang::Thread>(
+            new decaf::lang::Thread(writers.back().get())));
+        threads.back()->start();
+    }
+
+    for (int i = 0; i < NUM_WRITERS; ++i)
+    {
+        threads[i]->join();
+        ASSERT_FALSE(writers[i]->failed);
+    }
+
+    // Every frame is flushed even though most writers never flush.
+    ASSERT_EQ(NUM_WRITERS * NUM_FRAMES, (int)os.size());
+    ASSERT_EQ(NUM_WRITERS * NUM_FRAMES, transport.getWriteFrameCount());
+    ASSERT_TRUE(transport.getWriteFlushCount() > 0);
+    ASSERT_TRUE(transport.getWriteFlushCount() <=
+                transport.getWriteFrameCount());
+
+    transport.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(IOTransportTest, testCoalescedWriteAloneNotDelayed)
+{
+    decaf::io::BlockingByteArrayInputStream is;
+    decaf::io::ByteArrayOutputStream        os;
+    decaf::io::DataInputStream              input(&is);
+    decaf::io::DataOutputStream             output(&os);
+
+    std::shared_ptr<MyWireFormat> wireFormat(new MyWireFormat());
+    MyTransportListener           listener;
+    IOTransport                   transport;
+    transport.setInputStream(&input);
+    transport.setOutputStream(&output);
+    transport.setTransportListener(&listener);
+    transport.setWireFormat(wireFormat);
+    transport.setWriteCoalesceMicros(500 * 1000);
+
+    transport.start();
+
+    // With no other writer to wait for each frame is flushed at once.
+    long long start = decaf::lang::System::currentTimeMillis();
+    for (int i = 0; i < 5; ++i)
+    {
+        std::shared_ptr<MyCommand> cmd(new MyCommand());
+        cmd->c = (char)('1' + i);
+        transport.oneway(cmd);
+        ASSERT_EQ(i + 1, (int)os.size());
+    }
+    ASSERT_TRUE(decaf::lang::System::currentTimeMillis() - start < 500);
+    ASSERT_EQ(5, transport.getWriteFlushCount());
+
+    transport.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(IOTransportTest, testCoalescedWriteFlushErrorReachesEveryWriter)
+{
+    decaf::io::BlockingByteArrayInputStream is;
+    FailingFlushOutputStream                os;
+    decaf::io::DataInputStream              input(&is);
+    decaf::io::DataOutputStream             output(&os);
+
+    std::shared_ptr<MyWireFormat> wireFormat(new MyWireFormat());
+    MyTransportListener           listener;
+    IOTransport                   transport;
+    transport.setInputStream(&input);
+    transport.setOutputStream(&output);
+    transport.setTransportListener(&listener);
+    transport.setWireFormat(wireFormat);
+    transport.setWriteCoalesceMicros(2000);
+
+    transport.start();
+
+    const int NUM_WRITERS = 8;
+
+    std::vector<std::shared_ptr<MyWriter>>            writers;
+    std::vector<std::shared_ptr<decaf::lang::Thread>> threads;
+
+    for (int i = 0; i < NUM_WRITERS; ++i)
+    {
+        writers.push_back(std::shared_ptr<MyWriter>(
+            new MyWriter(&transport, (char)('a' + i), 1)));
+        threads.push_back(std::shared_ptr<decaf::lang::Thread>(
+            new decaf::lang::Thread(writers.back().get())));
+    }
+
+    for (int i = 0; i < NUM_WRITERS; ++i)
+    {
+        threads[i]->start();
+    }
+
+    // No flush succeeds, so no writer may think its frame was sent.
+    for (int i = 0; i < NUM_WRITERS; ++i)
+    {
+        threads[i]->join();
+        ASSERT_TRUE(writers[i]->failed);
+    }
+
+    os.failing = false;
     transport.close();
 }
 
@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 
 #include <activemq/commands/BaseCommand.h>
+#include <activemq/commands/ExceptionResponse.h>
 #include <activemq/transport/DefaultTransportListener.h>
 #include <activemq/transport/correlator/ResponseCorrelator.h>
 #include <activemq/util/Config.h>
@@ -109,7 +110,7 @@ public:
         close();
     }
 
-    virtual void oneway(const std::shared_ptr<Command> command)
+    virtual void oneway(const std::shared_ptr<Command>& command)
     {
         synchronized(&mutex)
         {
@@ -333,6 +334,31 @@ public:
     }
 };
 
+class MyHoldingTransport : public MyTransport
+{
+public:
+    std::vector<std::shared_ptr<Command>> held;
+
+public:
+    MyHoldingTransport()
+        : held()
+    {
+    }
+
+    virtual ~MyHoldingTransport()
+    {
+    }
+
+    // Keeps the commands so the test decides when responses arrive.
+    virtual void oneway(const std::shared_ptr<Command>& command)
+    {
+        synchronized(&mutex)
+        {
+            held.push_back(command);
+        }
+    }
+};
+
 class MyListener : public DefaultTransportListener
 {
 public:
@@ -647,3 +673,65 @@ TEST_F(ResponseCorrelatorTest, testNarrow)
     narrowed = correlator.narrow(typeid(correlator));
     ASSERT_TRUE(narrowed == &correlator);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ResponseCorrelatorTest, testManyOutstandingRequests)
+{
+    std::shared_ptr<MyHoldingTransport> transport(new MyHoldingTransport());
+    ResponseCorrelator                  correlator(transport);
+
+    // More outstanding requests than the correlator tracks without a lock.
+    const unsigned int                           numRequests = 600;
+    std::vector<std::shared_ptr<FutureResponse>> futures;
+    for (unsigned int ix = 0; ix < numRequests; ++ix)
+    {
+        std::shared_ptr<MyCommand> command(new MyCommand());
+        futures.push_back(correlator.asyncRequest(
+            command,
+            std::shared_ptr<ResponseCallback>()));
+    }
+
+    ASSERT_EQ(numRequests, transport->held.size());
+    ASSERT_TRUE(futures[0]->getResponse(0) == NULL);
+
+    // Answer them out of order.
+    for (unsigned int ix = numRequests; ix > 0; --ix)
+    {
+        std::shared_ptr<Command> command = transport->held[ix - 1];
+        correlator.onCommand(transport->createResponse(command));
+    }
+
+    for (unsigned int ix = 0; ix < numRequests; ++ix)
+    {
+        std::shared_ptr<Response> response = futures[ix]->getResponse(0);
+        ASSERT_TRUE(response != NULL);
+        ASSERT_EQ(transport->held[ix]->getCommandId(),
+                  response->getCorrelationId());
+    }
+
+    // Requests left outstanding when the transport fails get an error.
+    transport->held.clear();
+    futures.clear();
+    for (unsigned int ix = 0; ix < numRequests; ++ix)
+    {
+        std::shared_ptr<MyCommand> command(new MyCommand());
+        futures.push_back(correlator.asyncRequest(
+            command,
+            std::shared_ptr<ResponseCallback>()));
+    }
+
+    correlator.onException(IOException(__FILE__, __LINE__, "failed"));
+
+    for (unsigned int ix = 0; ix < numRequests; ++ix)
+    {
+        std::shared_ptr<Response> response = futures[ix]->getResponse(0);
+        ASSERT_TRUE(response != NULL);
+        ASSERT_EQ((int)commands::ExceptionResponse::ID_EXCEPTIONRESPONSE,
+                  (int)response->getDataStructureType());
+        ASSERT_EQ(transport->held[ix]->getCommandId(),
+                  response->getCorrelationId());
+    }
+
+    std::shared_ptr<MyCommand> command(new MyCommand());
+    ASSERT_THROW(correlator.request(command), IOException);
+}
@@ -18,7 +18,10 @@
 #include <gtest/gtest.h>
 
 #include <activemq/commands/ActiveMQMessage.h>
+#include <activemq/commands/ActiveMQTempQueue.h>
 #include <activemq/commands/ConnectionControl.h>
+#include <activemq/commands/DestinationInfo.h>
+#include <activemq/core/ActiveMQConstants.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/mock/MockBrokerService.h>
 #include <activemq/transport/failover/BrokerStateInfo.h>
@@ -26,6 +29,7 @@
 #include <activemq/transport/failover/FailoverTransportFactory.h>
 #include <activemq/transport/mock/MockTransport.h>
 #include <activemq/util/AMQLog.h>
+#include <activemq/wireformat/openwire/OpenWireResponseBuilder.h>
 #include <decaf/lang/Thread.h>
 #include <decaf/util/UUID.h>
 #include <decaf/util/concurrent/CountDownLatch.h>
@@ -39,8 +43,11 @@
 #include <activemq/transport/Transport.h>
 #include <activemq/util/Config.h>
 #include <decaf/net/ServerSocket.h>
+#include <atomic>
 #include <chrono>
 #include <random>
+#include <thread>
+#include <vector>
 
 using namespace activemq;
 using namespace activemq::mock;
@@ -113,6 +120,50 @@ public:
 namespace
 {
 
+class NoMessageResponseBuilder
+    : public activemq::wireformat::openwire::OpenWireResponseBuilder
+{
+public:
+    virtual void buildIncomingCommands(
+        const std::shared_ptr<Command>        command,
+        LinkedList<std::shared_ptr<Command>>& queue)
+    {
+        // Leave Messages unanswered so they stay in the requestMap.
+        if (!command->isMessage())
+        {
+            OpenWireResponseBuilder::buildIncomingCommands(command, queue);
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+class ConcurrentCommandCounter : public DefaultTransportListener
+{
+public:
+    std::atomic<int> numMessages;
+    std::atomic<int> numDestinationInfos;
+
+    ConcurrentCommandCounter()
+        : numMessages(0),
+          numDestinationInfos(0)
+    {
+    }
+
+    virtual void onCommand(const std::shared_ptr<Command> command)
+    {
+        if (command->isMessage())
+        {
+            numMessages++;
+        }
+        else if (command->getDataStructureType() ==
+                 DestinationInfo::ID_DESTINATIONINFO)
+        {
+            numDestinationInfos++;
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
 class PriorityBackupListener : public DefaultTransportListener
 {
 private:
@@ -526,6 +577,38 @@ TEST_F(FailoverTransportTest, testSendRequestMessage)
     transport->close();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(FailoverTransportTest, testUnansweredRequestKeepsMessageCopy)
+{
+    std::string uri = "failover://(mock://localhost:61616)?randomize=false";
+
+    DefaultTransportListener listener;
+    FailoverTransportFactory factory;
+
+    std::shared_ptr<Transport> transport(factory.create(uri));
+    ASSERT_TRUE(transport != NULL);
+    transport->setTransportListener(&listener);
+    transport->start();
+
+    MockTransport* mock = NULL;
+    while (mock == NULL)
+    {
+        mock = dynamic_cast<MockTransport*>(
+            transport->narrow(typeid(MockTransport)));
+    }
+    mock->setResponseBuilder(std::make_shared<NoMessageResponseBuilder>());
+
+    // A producer that does not copy on send hands the transport the
+    // application's own Message, which may be reused once a timed out send
+    // returns while the request still waits for replay.
+    std::shared_ptr<ActiveMQMessage> message(new ActiveMQMessage());
+    ASSERT_THROW(transport->request(message, 100), IOException);
+
+    ASSERT_EQ(1L, message.use_count());
+
+    transport->close();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(FailoverTransportTest, testSendOnewayMessageFail)
 {
@@ -678,6 +761,123 @@ TEST_F(FailoverTransportTest, testWithOpewireCommands)
     transport->close();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(FailoverTransportTest, testTempDestinationsChurnWhileSending)
+{
+    std::string uri =
+        "failover://(mock://localhost:61616)?randomize=false&"
+        "trackMessages=true";
+
+    const int SENDERS      = 2;
+    const int MESSAGES     = 2000;
+    const int CREATORS     = 4;
+    const int DESTINATIONS = 2000;
+
+    DefaultTransportListener listener;
+    ConcurrentCommandCounter counter;
+    FailoverTransportFactory factory;
+
+    std::shared_ptr<Transport> transport(factory.create(uri));
+    ASSERT_TRUE(transport != NULL);
+    transport->setTransportListener(&listener);
+    transport->start();
+
+    MockTransport* mock = NULL;
+    while (mock == NULL)
+    {
+        mock = dynamic_cast<MockTransport*>(
+            transport->narrow(typeid(MockTransport)));
+    }
+
+    std::shared_ptr<ConnectionInfo> connection = createConnection();
+    transport->request(connection);
+    std::shared_ptr<SessionInfo> session = createSession(connection);
+    transport->request(session);
+
+    mock->setOutgoingListener(&counter);
+
+    std::atomic<int>         failures(0);
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < SENDERS; ++i)
+    {
+        std::shared_ptr<ProducerInfo> producer = createProducer(session);
+        transport->request(producer);
+
+        threads.emplace_back(
+            [&, producer]()
+            {
+                try
+                {
+                    for (int j = 0; j < MESSAGES; ++j)
+                    {
+                        std::shared_ptr<ActiveMQMessage> message(
+                            new ActiveMQMessage());
+                        message->setProducerId(producer->getProducerId());
+                        message->setMessageId(std::make_shared<MessageId>(
+                            producer->getProducerId(),
+                            (long long)j));
+                        transport->oneway(message);
+                    }
+                }
+                catch (...)
+                {
+                    failures++;
+                }
+            });
+    }
+
+    // Temporary destinations are created and removed on several threads at
+    // once, each change is recorded in the tracked ConnectionState.
+    for (int i = 0; i < CREATORS; ++i)
+    {
+        threads.emplace_back(
+            [&, i]()
+            {
+                try
+                {
+                    for (int j = 0; j < DESTINATIONS; ++j)
+                    {
+                        std::string name = "temp-" + std::to_string(i) +
+                                           "-" + std::to_string(j);
+
+                        std::shared_ptr<DestinationInfo> info(
+                            new DestinationInfo());
+                        info->setConnectionId(connection->getConnectionId());
+                        info->setDestination(
+                            std::make_shared<ActiveMQTempQueue>(name));
+                        info->setOperationType(
+                            core::ActiveMQConstants::DESTINATION_ADD_OPERATION);
+                        transport->oneway(info);
+
+                        std::shared_ptr<DestinationInfo> remove(
+                            info->cloneDataStructure());
+                        remove->setOperationType(
+                            core::ActiveMQConstants::
+                                DESTINATION_REMOVE_OPERATION);
+                        transport->oneway(remove);
+                    }
+                }
+                catch (...)
+                {
+                    failures++;
+                }
+            });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(0, failures.load());
+    ASSERT_EQ(SENDERS * MESSAGES, counter.numMessages.load());
+    ASSERT_EQ(CREATORS * DESTINATIONS * 2, counter.numDestinationInfos.load());
+
+    mock->setOutgoingListener(NULL);
+    transport->close();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(FailoverTransportTest, testTransportHandlesConnectionControl)
 {
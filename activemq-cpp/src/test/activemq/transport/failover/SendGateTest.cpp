@@ -0,0 +1,328 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <activemq/transport/Transport.h>
+#include <activemq/transport/failover/SendGate.h>
+#include <activemq/util/Config.h>
+#include <decaf/io/IOException.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::transport::failover;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
+
+namespace
+{
+
+// A Transport whose oneway() blocks until it is closed, like a socket write
+// stuck on a dead peer.
+class BlockingTransport : public Transport
+{
+public:
+    CountDownLatch    sending;
+    CountDownLatch    released;
+    std::atomic<bool> closed;
+
+private:
+    BlockingTransport(const BlockingTransport&);
+    BlockingTransport& operator=(const BlockingTransport&);
+
+public:
+    BlockingTransport()
+        : sending(1),
+          released(1),
+          closed(false)
+    {
+    }
+
+    virtual ~BlockingTransport()
+    {
+    }
+
+    virtual void oneway(const std::shared_ptr<Command>& command AMQCPP_UNUSED)
+    {
+        sending.countDown();
+        released.await();
+        throw IOException(__FILE__, __LINE__, "Transport closed");
+    }
+
+    virtual std::shared_ptr<FutureResponse> asyncRequest(
+        const std::shared_ptr<Command> command          AMQCPP_UNUSED,
+        const std::shared_ptr<ResponseCallback> callback AMQCPP_UNUSED)
+    {
+        throw UnsupportedOperationException(__FILE__, __LINE__, "stub");
+    }
+
+    virtual std::shared_ptr<Response> request(
+        const std::shared_ptr<Command> command AMQCPP_UNUSED)
+    {
+        throw UnsupportedOperationException(__FILE__, __LINE__, "stub");
+    }
+
+    virtual std::shared_ptr<Response> request(
+        const std::shared_ptr<Command> command AMQCPP_UNUSED,
+        unsigned int timeout                   AMQCPP_UNUSED)
+    {
+        throw UnsupportedOperationException(__FILE__, __LINE__, "stub");
+    }
+
+    virtual std::shared_ptr<wireformat::WireFormat> getWireFormat() const
+    {
+        return std::shared_ptr<wireformat::WireFormat>();
+    }
+
+    virtual void setWireFormat(
+        const std::shared_ptr<wireformat::WireFormat> wireFormat AMQCPP_UNUSED)
+    {
+    }
+
+    virtual void setTransportListener(TransportListener* listener
+                                          AMQCPP_UNUSED)
+    {
+    }
+
+    virtual TransportListener* getTransportListener() const
+    {
+        return NULL;
+    }
+
+    virtual void start()
+    {
+    }
+
+    virtual void stop()
+    {
+    }
+
+    virtual void close()
+    {
+        closed = true;
+        released.countDown();
+    }
+
+    virtual Transport* narrow(const std::type_info& typeId)
+    {
+        if (typeid(*this) == typeId)
+        {
+            return this;
+        }
+
+        return NULL;
+    }
+
+    virtual bool isFaultTolerant() const
+    {
+        return false;
+    }
+
+    virtual bool isConnected() const
+    {
+        return !closed;
+    }
+
+    virtual bool isClosed() const
+    {
+        return closed;
+    }
+
+    virtual std::string getRemoteAddress() const
+    {
+        return "";
+    }
+
+    virtual void reconnect(const decaf::net::URI& uri AMQCPP_UNUSED)
+    {
+    }
+
+    virtual bool isReconnectSupported() const
+    {
+        return false;
+    }
+
+    virtual bool isUpdateURIsSupported() const
+    {
+        return false;
+    }
+
+    virtual void updateURIs(bool rebalance AMQCPP_UNUSED,
+                            const decaf::util::List<decaf::net::URI>& uris
+                                AMQCPP_UNUSED)
+    {
+        throw IOException();
+    }
+};
+
+}  // namespace
+
+class SendGateTest : public ::testing::Test
+{
+};
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(SendGateTest, testEnterFollowsOpenAndClose)
+{
+    SendGate                           gate;
+    std::shared_ptr<BlockingTransport> transport(new BlockingTransport());
+
+    ASSERT_FALSE(gate.isOpen());
+    ASSERT_TRUE(gate.enter() == NULL);
+
+    gate.open(transport);
+    ASSERT_TRUE(gate.isOpen());
+    ASSERT_EQ(transport.get(), gate.enter());
+    ASSERT_EQ(transport.get(), gate.enter());
+    ASSERT_EQ(2u, gate.getActiveSends());
+
+    gate.close();
+    ASSERT_FALSE(gate.isOpen());
+    ASSERT_TRUE(gate.enter() == NULL);
+    ASSERT_EQ(2u, gate.getActiveSends());
+
+    gate.leave();
+    gate.leave();
+    ASSERT_EQ(0u, gate.getActiveSends());
+
+    gate.open(std::shared_ptr<Transport>());
+    ASSERT_FALSE(gate.isOpen());
+    ASSERT_TRUE(gate.enter() == NULL);
+    ASSERT_TRUE(transport->isClosed() == false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(SendGateTest, testDrainWaitsForSendsInProgress)
+{
+    SendGate                           gate;
+    std::shared_ptr<BlockingTransport> transport(new BlockingTransport());
+
+    gate.open(transport);
+    ASSERT_TRUE(gate.enter() != NULL);
+    gate.close();
+
+    CountDownLatch drained(1);
+    std::thread    drainer(
+        [&gate, &drained]()
+        {
+            gate.drain(false);
+            drained.countDown();
+        });
+
+    ASSERT_FALSE(drained.await(100));
+
+    gate.leave();
+    ASSERT_TRUE(drained.await(5000));
+    drainer.join();
+
+    ASSERT_FALSE(transport->isClosed());
+    ASSERT_EQ(0u, gate.getActiveSends());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(SendGateTest, testDrainReleasesBlockedSend)
+{
+    SendGate                           gate;
+    std::shared_ptr<BlockingTransport> transport(new BlockingTransport());
+    std::atomic<bool>                  failed(false);
+
+    gate.open(transport);
+
+    std::thread sender(
+        [&gate, &failed]()
+        {
+            Transport* target = gate.enter();
+            try
+            {
+                target->oneway(std::shared_ptr<Command>());
+            }
+            catch (IOException&)
+            {
+                failed = true;
+            }
+            gate.leave();
+        });
+
+    ASSERT_TRUE(transport->sending.await(5000));
+
+    gate.close();
+    gate.drain(true);
+    sender.join();
+
+    ASSERT_TRUE(transport->isClosed());
+    ASSERT_TRUE(failed);
+    ASSERT_EQ(0u, gate.getActiveSends());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(SendGateTest, testOpenReleasesReplacedTransportOnly)
+{
+    SendGate                           gate;
+    std::shared_ptr<BlockingTransport> first(new BlockingTransport());
+    std::shared_ptr<BlockingTransport> second(new BlockingTransport());
+
+    gate.open(first);
+
+    std::thread sender(
+        [&gate]()
+        {
+            Transport* target = gate.enter();
+            try
+            {
+                target->oneway(std::shared_ptr<Command>());
+            }
+            catch (IOException&)
+            {
+            }
+            gate.leave();
+        });
+
+    ASSERT_TRUE(first->sending.await(5000));
+
+    gate.open(second);
+    sender.join();
+
+    ASSERT_TRUE(first->isClosed());
+    ASSERT_TRUE(gate.isOpen());
+
+    // Opening again with the Transport in use waits for its sends without
+    // closing it.
+    ASSERT_EQ(second.get(), gate.enter());
+    CountDownLatch reopened(1);
+    std::thread    opener(
+        [&gate, &second, &reopened]()
+        {
+            gate.open(second);
+            reopened.countDown();
+        });
+
+    ASSERT_FALSE(reopened.await(100));
+    gate.leave();
+    ASSERT_TRUE(reopened.await(5000));
+    opener.join();
+
+    ASSERT_FALSE(second->isClosed());
+    ASSERT_TRUE(gate.isOpen());
+}
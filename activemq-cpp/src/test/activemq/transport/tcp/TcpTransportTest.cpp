@@ -22,6 +22,12 @@
 
 #include <activemq/wireformat/openwire/OpenWireFormat.h>
 
+#include <activemq/commands/ConnectionInfo.h>
+#include <activemq/commands/Response.h>
+#include <activemq/exceptions/ActiveMQException.h>
+#include <activemq/mock/MockBrokerService.h>
+#include <activemq/transport/DefaultTransportListener.h>
+#include <activemq/transport/IOTransport.h>
 #include <activemq/util/Config.h>
 #include <decaf/io/InputStream.h>
 #include <decaf/io/OutputStream.h>
@@ -31,6 +37,7 @@
 #include <decaf/net/SocketFactory.h>
 #include <decaf/net/SocketTimeoutException.h>
 #include <decaf/util/Random.h>
+#include <decaf/util/UUID.h>
 #include <memory>
 
 using namespace decaf;
@@ -40,6 +47,9 @@ using namespace decaf::io;
 using namespace decaf::util;
 using namespace decaf::util::concurrent;
 using namespace activemq;
+using namespace activemq::exceptions;
+using namespace activemq::commands;
+using namespace activemq::mock;
 using namespace activemq::wireformat;
 using namespace activemq::wireformat::openwire;
 using namespace activemq::transport;
@@ -298,3 +308,96 @@ TEST_F(TcpTransportTest, testTransportCreateWithRadomFailures)
         }
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(TcpTransportTest, testTransportCreateWithRandomFailuresAsyncIo)
+{
+    TcpTransportFactory factory;
+
+    int port = server->getLocalPort();
+    URI connectUri("tcp://localhost:" + Integer::toString(port) +
+                   "?transport.ioMode=async");
+
+    std::shared_ptr<Transport> transport;
+
+    // Same as above but with reads pushed from the I/O threads, the connect
+    // and close races must not leave a read pending on a destroyed Transport.
+    for (int i = 0; i < 1000; ++i)
+    {
+        try
+        {
+            transport = factory.create(connectUri);
+        }
+        catch (Exception& ex)
+        {
+        }
+
+        try
+        {
+            transport->start();
+        }
+        catch (Exception& ex)
+        {
+        }
+
+        try
+        {
+            transport->close();
+        }
+        catch (Exception& ex)
+        {
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(TcpTransportTest, testInvalidIoModeRejected)
+{
+    TcpTransportFactory factory;
+
+    int port = server->getLocalPort();
+    URI connectUri("tcp://localhost:" + Integer::toString(port) +
+                   "?transport.ioMode=bogus");
+
+    ASSERT_THROW(factory.create(connectUri), ActiveMQException)
+        << "Should throw an ActiveMQException for an unknown mode";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(TcpTransportTest, testAsyncIoRequestResponse)
+{
+    MockBrokerService broker;
+    broker.start();
+    broker.waitUntilStarted();
+
+    TcpTransportFactory factory;
+
+    URI connectUri("tcp://127.0.0.1:" + Integer::toString(broker.getPort()) +
+                   "?transport.ioMode=async");
+
+    DefaultTransportListener   listener;
+    std::shared_ptr<Transport> transport(factory.create(connectUri));
+    transport->setTransportListener(&listener);
+    transport->start();
+
+    IOTransport* ioTransport =
+        dynamic_cast<IOTransport*>(transport->narrow(typeid(IOTransport)));
+    ASSERT_TRUE(ioTransport != NULL);
+    ASSERT_TRUE(ioTransport->isAsyncReading());
+
+    std::shared_ptr<ConnectionId> id(new ConnectionId());
+    id->setValue(UUID::randomUUID().toString());
+    std::shared_ptr<ConnectionInfo> info(new ConnectionInfo());
+    info->setClientId(UUID::randomUUID().toString());
+    info->setConnectionId(id);
+
+    // The response is decoded and dispatched from the shared I/O threads.
+    std::shared_ptr<Response> response = transport->request(info, 10000);
+    ASSERT_TRUE(response != NULL);
+    ASSERT_EQ(info->getCommandId(), response->getCorrelationId());
+
+    transport->close();
+
+    broker.stop();
+    broker.waitUntilStopped();
+}
@@ -22,6 +22,7 @@
 
 #include <mutex>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 // Undefine Windows macros that conflict with our enum values
@@ -250,6 +251,79 @@ TEST_F(AMQLogTest, testMultiConnectionLogging)
     ASSERT_TRUE(!AMQLogger::isEnabled(LOG_LEVEL_ERROR));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(AMQLogTest, testContextLevelChangeSeenByCachedContext)
+{
+    const std::string context = "failover://server1,server2";
+
+    AMQLogger::setLevel(LOG_LEVEL_WARN);
+    AMQLogger::setLogContext(context);
+
+    // Resolve and cache the (absent) context level for this thread
+    ASSERT_EQ(LOG_LEVEL_WARN, AMQLogger::getEffectiveLevel());
+    ASSERT_TRUE(!AMQLogger::isEnabled(LOG_LEVEL_DEBUG));
+
+    // A level set from another thread must replace the cached one
+    std::thread configurer(
+        [&context]() { AMQLogger::setLevel(context, LOG_LEVEL_DEBUG); });
+    configurer.join();
+    ASSERT_EQ(LOG_LEVEL_DEBUG, AMQLogger::getEffectiveLevel());
+    ASSERT_TRUE(AMQLogger::isEnabled(LOG_LEVEL_DEBUG));
+
+    AMQLogger::setLevel(context, LOG_LEVEL_ERROR);
+    ASSERT_EQ(LOG_LEVEL_ERROR, AMQLogger::getEffectiveLevel());
+    ASSERT_TRUE(!AMQLogger::isEnabled(LOG_LEVEL_WARN));
+
+    // Clearing the context level falls back to the default level
+    AMQLogger::clearLevel(context);
+    ASSERT_EQ(LOG_LEVEL_WARN, AMQLogger::getEffectiveLevel());
+    ASSERT_TRUE(AMQLogger::isEnabled(LOG_LEVEL_WARN));
+
+    // Default level changes apply without any context level set
+    AMQLogger::setLevel(LOG_LEVEL_NONE);
+    ASSERT_TRUE(!AMQLogger::isEnabled(LOG_LEVEL_ERROR));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+    int formatCount = 0;
+
+    int countFormat()
+    {
+        return ++formatCount;
+    }
+}  // namespace
+
+TEST_F(AMQLogTest, testDisabledStatementIsNotFormatted)
+{
+    const std::string context = "tcp://server3:61616";
+
+    AMQLogger::setRecordOnlyMode(true);
+    formatCount = 0;
+
+    // Nothing enabled anywhere, the message is never built
+    AMQ_LOG_DEBUG("AMQLogTest", "value=" << countFormat());
+    AMQ_LOG_ERROR("AMQLogTest", "value=" << countFormat());
+    ASSERT_EQ(0, formatCount);
+
+    // Enabling another context must not enable this thread
+    AMQLogger::setLevel(context, LOG_LEVEL_DEBUG);
+    AMQ_LOG_DEBUG("AMQLogTest", "value=" << countFormat());
+    ASSERT_EQ(0, formatCount);
+
+    AMQLogger::setLogContext(context);
+    AMQ_LOG_DEBUG("AMQLogTest", "value=" << countFormat());
+    ASSERT_EQ(AMQ_LOG_COMPILE_LEVEL >= 4 ? 1 : 0, formatCount);
+    ASSERT_EQ(AMQ_LOG_COMPILE_LEVEL >= 4, AMQ_LOG_DEBUG_ENABLED());
+
+    // Once the context level is gone the statement is skipped again
+    AMQLogger::clearLevel(context);
+    AMQ_LOG_DEBUG("AMQLogTest", "value=" << countFormat());
+    ASSERT_EQ(AMQ_LOG_COMPILE_LEVEL >= 4 ? 1 : 0, formatCount);
+    ASSERT_TRUE(!AMQ_LOG_ERROR_ENABLED());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(AMQLogTest, testContextOutputHandler)
 {
@@ -546,3 +620,83 @@ TEST_F(AMQLogTest, testFlightRecorder)
     AMQLogger::shutdownFlightRecorder();
     ASSERT_TRUE(!AMQLogger::isFlightRecorderEnabled());
 }
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+    std::vector<std::string> dumpMessages(std::size_t maxEntries = 0)
+    {
+        std::vector<std::string> messages;
+        AMQLogger::dumpFlightRecorder(
+            [&messages](const AMQLogger::FlightRecorderEntry& entry)
+            { messages.push_back(entry.message); },
+            maxEntries);
+        return messages;
+    }
+}  // namespace
+
+TEST_F(AMQLogTest, testFlightRecorderEvents)
+{
+    AMQLogger::initializeFlightRecorder(0.001, 100, 1000, 16);
+    AMQLogger::setRecordOnlyMode(true);
+
+    // Events are recorded with logging disabled and formatted on dump
+    AMQ_RECORD_EVENT("EventTest",
+                     "oneway() cmdId={} type={cmd}",
+                     42,
+                     static_cast<unsigned char>(22));
+    AMQLogger::log(LOG_LEVEL_INFO, "EventTest", "logged entry");
+    AMQ_RECORD_EVENT("EventTest", "ptr={x} value={}", 0xBEEFu, -7);
+
+    std::vector<std::string> messages = dumpMessages();
+    ASSERT_EQ(static_cast<std::size_t>(3), messages.size());
+    ASSERT_EQ("oneway() cmdId=42 type=MessageAck", messages[0]);
+    ASSERT_EQ("logged entry", messages[1]);
+    ASSERT_EQ("ptr=0xbeef value=-7", messages[2]);
+
+    // Limiting the dump keeps the newest entries
+    messages = dumpMessages(2);
+    ASSERT_EQ(static_cast<std::size_t>(2), messages.size());
+    ASSERT_EQ("logged entry", messages[0]);
+
+    std::ostringstream dumpOutput;
+    AMQLogger::dumpFlightRecorder(dumpOutput);
+    ASSERT_TRUE(dumpOutput.str().find("[EventTest] ptr=0xbeef value=-7") !=
+                std::string::npos);
+
+    AMQLogger::clearFlightRecorder();
+    ASSERT_TRUE(dumpMessages().empty());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(AMQLogTest, testFlightRecorderEventsPerThread)
+{
+    AMQLogger::initializeFlightRecorder(0.001, 100, 1000, 16);
+    AMQLogger::setRecordOnlyMode(true);
+
+    // Each ring keeps only the newest events of its own thread, and the
+    // events of a thread that has exited stay available
+    std::thread writer(
+        []()
+        {
+            for (int i = 0; i < 40; ++i)
+            {
+                AMQ_RECORD_EVENT("EventTest", "writer seq={}", i);
+            }
+        });
+    writer.join();
+
+    AMQ_RECORD_EVENT("EventTest", "main seq={}", 0);
+
+    std::vector<std::string> messages = dumpMessages();
+    ASSERT_EQ(static_cast<std::size_t>(17), messages.size());
+    ASSERT_EQ("writer seq=24", messages[0]);
+    ASSERT_EQ("writer seq=39", messages[15]);
+    ASSERT_EQ("main seq=0", messages[16]);
+
+    // Nothing is recorded once the recorder is shut down
+    AMQLogger::shutdownFlightRecorder();
+    AMQ_RECORD_EVENT("EventTest", "main seq={}", 1);
+    AMQLogger::initializeFlightRecorder(0.001, 100, 1000, 16);
+    ASSERT_TRUE(dumpMessages().empty());
+}
@@ -17,9 +17,28 @@
 
 #include <gtest/gtest.h>
 
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/commands/ActiveMQTopic.h>
+#include <activemq/commands/ConnectionId.h>
+#include <activemq/commands/ConsumerId.h>
+#include <activemq/commands/ConsumerInfo.h>
+#include <activemq/commands/LocalTransactionId.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/transport/IOTransport.h>
 #include <activemq/wireformat/openwire/OpenWireFormat.h>
 #include <activemq/wireformat/openwire/OpenWireFormatFactory.h>
+#include <activemq/wireformat/openwire/marshal/DataStreamMarshaller.h>
+#include <activemq/wireformat/openwire/utils/BooleanStream.h>
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/IOException.h>
 #include <decaf/util/Properties.h>
+#include <thread>
+#include <vector>
 
 #include <activemq/core/ActiveMQConnectionMetaData.h>
 
@@ -27,12 +46,16 @@ using namespace std;
 using namespace activemq;
 using namespace activemq::util;
 using namespace activemq::core;
+using namespace activemq::commands;
+using namespace activemq::transport;
 using namespace decaf::io;
 using namespace decaf::lang;
 using namespace decaf::util;
 using namespace activemq::exceptions;
 using namespace activemq::wireformat;
 using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::marshal;
+using namespace activemq::wireformat::openwire::utils;
 
 class OpenWireFormatTest : public ::testing::Test
 {
@@ -63,3 +86,741 @@ TEST_F(OpenWireFormatTest, testProviderInfoInWireFormat)
                      .getString("PlatformDetails")
                      .empty());
 }
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+std::shared_ptr<OpenWireFormat> createCachingWireFormat(bool tightEncoding)
+{
+    Properties properties;
+    properties.setProperty("wireFormat.cacheEnabled", "true");
+    properties.setProperty("wireFormat.tightEncodingEnabled",
+                           tightEncoding ? "true" : "false");
+
+    return std::dynamic_pointer_cast<OpenWireFormat>(
+        OpenWireFormatFactory().createWireFormat(properties));
+}
+
+void assertCachedRoundTrip(bool tightEncoding)
+{
+    std::shared_ptr<OpenWireFormat> client =
+        createCachingWireFormat(tightEncoding);
+    std::shared_ptr<OpenWireFormat> broker =
+        createCachingWireFormat(tightEncoding);
+
+    client->renegotiateWireFormat(*broker->getPreferedWireFormatInfo());
+    broker->renegotiateWireFormat(*client->getPreferedWireFormatInfo());
+    ASSERT_TRUE(client->isCacheEnabled());
+    ASSERT_TRUE(broker->isCacheEnabled());
+
+    IOTransport transport;
+
+    std::shared_ptr<ProducerId> producerId(
+        new ProducerId("ID:test-connection:1:1"));
+    std::shared_ptr<ActiveMQDestination> destination(
+        new ActiveMQQueue("TEST.CACHE.QUEUE"));
+
+    std::vector<int> sizes;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        std::shared_ptr<ActiveMQTextMessage> message(new ActiveMQTextMessage());
+
+        // Separate but equal copies must still hit the cache.
+        message->setProducerId(
+            std::shared_ptr<ProducerId>(producerId->cloneDataStructure()));
+        message->setDestination(std::shared_ptr<ActiveMQDestination>(
+            destination->cloneDataStructure()));
+        message->setText("message");
+
+        ByteArrayOutputStream baos;
+        DataOutputStream      dataOut(&baos);
+        client->marshal(message, &transport, &dataOut);
+
+        std::pair<unsigned char*, int> array = baos.toByteArray();
+        sizes.push_back(array.second);
+
+        ByteArrayInputStream bais(array.first, array.second, true);
+        DataInputStream      dataIn(&bais);
+
+        std::shared_ptr<ActiveMQTextMessage> received =
+            std::dynamic_pointer_cast<ActiveMQTextMessage>(
+                broker->unmarshal(&transport, &dataIn));
+
+        ASSERT_TRUE(received != NULL);
+        ASSERT_TRUE(received->getProducerId()->equals(producerId.get()));
+        ASSERT_TRUE(received->getDestination()->equals(destination.get()));
+        ASSERT_EQ(std::string("message"), received->getText());
+    }
+
+    ASSERT_TRUE(sizes[1] < sizes[0]);
+    ASSERT_EQ(sizes[1], sizes[2]);
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatTest, testCacheNotEnabledUnlessNegotiated)
+{
+    std::shared_ptr<OpenWireFormat> client = createCachingWireFormat(false);
+
+    Properties                      properties;
+    std::shared_ptr<OpenWireFormat> broker =
+        std::dynamic_pointer_cast<OpenWireFormat>(
+            OpenWireFormatFactory().createWireFormat(properties));
+
+    ASSERT_FALSE(client->isCacheEnabled());
+
+    client->renegotiateWireFormat(*broker->getPreferedWireFormatInfo());
+    ASSERT_FALSE(client->isCacheEnabled());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatTest, testLooseMarshalCache)
+{
+    assertCachedRoundTrip(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatTest, testTightMarshalCache)
+{
+    assertCachedRoundTrip(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+void assertCachedObjectsShared(bool tightEncoding)
+{
+    std::shared_ptr<OpenWireFormat> client =
+        createCachingWireFormat(tightEncoding);
+    std::shared_ptr<OpenWireFormat> broker =
+        createCachingWireFormat(tightEncoding);
+
+    client->renegotiateWireFormat(*broker->getPreferedWireFormatInfo());
+    broker->renegotiateWireFormat(*client->getPreferedWireFormatInfo());
+
+    IOTransport transport;
+
+    std::shared_ptr<ConnectionId> connectionId(new ConnectionId());
+    connectionId->setValue("ID:test-connection");
+
+    std::shared_ptr<LocalTransactionId> transactionId(new LocalTransactionId());
+    transactionId->setConnectionId(connectionId);
+    transactionId->setValue(42);
+
+    std::vector<std::shared_ptr<TransactionId>> received;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        std::shared_ptr<ActiveMQTextMessage> message(new ActiveMQTextMessage());
+        message->setTransactionId(std::shared_ptr<TransactionId>(
+            transactionId->cloneDataStructure()));
+
+        ByteArrayOutputStream baos;
+        DataOutputStream      dataOut(&baos);
+        client->marshal(message, &transport, &dataOut);
+
+        std::pair<unsigned char*, int> array = baos.toByteArray();
+        ByteArrayInputStream bais(array.first, array.second, true);
+        DataInputStream      dataIn(&bais);
+
+        std::shared_ptr<Message> unmarshaled =
+            std::dynamic_pointer_cast<Message>(
+                broker->unmarshal(&transport, &dataIn));
+
+        ASSERT_TRUE(unmarshaled != NULL);
+        received.push_back(unmarshaled->getTransactionId());
+    }
+
+    ASSERT_TRUE(received[0]->equals(transactionId.get()));
+    ASSERT_EQ(received[0].get(), received[1].get());
+    ASSERT_EQ(received[0].get(), received[2].get());
+
+    // Equal objects have equal wire forms and so share one cache index.
+    std::shared_ptr<LocalTransactionId> other(
+        transactionId->cloneDataStructure());
+    ASSERT_NE(-1, client->getMarshalCacheIndex(other.get()));
+    other->setValue(43);
+    ASSERT_EQ(-1, client->getMarshalCacheIndex(other.get()));
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatTest, testLooseMarshalCacheSharesInstances)
+{
+    assertCachedObjectsShared(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatTest, testTightMarshalCacheSharesInstances)
+{
+    assertCachedObjectsShared(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+std::vector<unsigned char> nestedMarshal(OpenWireFormat& wireFormat,
+                                         DataStructure*  object)
+{
+    ByteArrayOutputStream baos;
+    DataOutputStream      dataOut(&baos);
+
+    if (wireFormat.isTightEncodingEnabled())
+    {
+        BooleanStream bs;
+        int           size = wireFormat.tightMarshalNestedObject1(object, &bs);
+        size += bs.marshalledSize();
+
+        bs.marshal(&dataOut);
+        wireFormat.tightMarshalNestedObject2(object, &dataOut, &bs);
+
+        // The first pass must predict exactly what the second one writes.
+        EXPECT_EQ((long long)size, baos.size());
+    }
+    else
+    {
+        wireFormat.looseMarshalNestedObject(object, &dataOut);
+    }
+
+    std::pair<unsigned char*, int> array = baos.toByteArray();
+    std::vector<unsigned char>     bytes(array.first,
+                                     array.first + array.second);
+    delete[] array.first;
+
+    return bytes;
+}
+
+DataStructure* nestedUnmarshal(OpenWireFormat&                   wireFormat,
+                               const std::vector<unsigned char>& bytes,
+                               int                               length)
+{
+    ByteArrayInputStream bais(bytes.empty() ? NULL : &bytes[0], length);
+    DataInputStream      dataIn(&bais);
+
+    if (wireFormat.isTightEncodingEnabled())
+    {
+        BooleanStream bs;
+        bs.unmarshal(&dataIn);
+        return wireFormat.tightUnmarshalNestedObject(&dataIn, &bs);
+    }
+
+    return wireFormat.looseUnmarshalNestedObject(&dataIn);
+}
+
+std::vector<unsigned char> nestedSpanMarshal(OpenWireFormat& wireFormat,
+                                             DataStructure*  object)
+{
+    std::vector<unsigned char> bytes;
+    ByteWriter                 dataOut(bytes);
+
+    if (wireFormat.isTightEncodingEnabled())
+    {
+        BooleanStream bs;
+        wireFormat.tightMarshalNestedObject1(object, &bs);
+
+        bs.marshal(&dataOut);
+        wireFormat.tightMarshalNestedObject2(object, &dataOut, &bs);
+    }
+    else
+    {
+        wireFormat.looseMarshalNestedObject(object, &dataOut);
+    }
+
+    return bytes;
+}
+
+DataStructure* nestedSpanUnmarshal(OpenWireFormat&                   wireFormat,
+                                   const std::vector<unsigned char>& bytes,
+                                   int                               length)
+{
+    ByteReader dataIn(bytes.empty() ? NULL : &bytes[0], (std::size_t)length);
+
+    if (wireFormat.isTightEncodingEnabled())
+    {
+        BooleanStream bs;
+        bs.unmarshal(&dataIn);
+        return wireFormat.tightUnmarshalNestedObject(&dataIn, &bs);
+    }
+
+    return wireFormat.looseUnmarshalNestedObject(&dataIn);
+}
+
+void assertAllMarshallersRoundTrip(bool tightEncoding)
+{
+    Properties     properties;
+    OpenWireFormat wireFormat(properties);
+    wireFormat.setVersion(OpenWireFormat::MAX_SUPPORTED_VERSION);
+    wireFormat.setTightEncodingEnabled(tightEncoding);
+
+    int tested = 0;
+
+    for (int type = 1; type < 256; ++type)
+    {
+        DataStreamMarshaller* marshaller =
+            wireFormat.getMarshaller((unsigned char)type);
+
+        if (marshaller == NULL)
+        {
+            continue;
+        }
+
+        std::unique_ptr<DataStructure> object(marshaller->createObject());
+        std::vector<unsigned char>     bytes =
+            nestedMarshal(wireFormat, object.get());
+
+        std::unique_ptr<DataStructure> result(
+            nestedUnmarshal(wireFormat, bytes, (int)bytes.size()));
+        ASSERT_TRUE(result != NULL) << "type " << type;
+        ASSERT_EQ(type, (int)result->getDataStructureType());
+
+        // Messages compare by id alone, so check what was read back encodes
+        // to the very same bytes instead.
+        ASSERT_TRUE(nestedMarshal(wireFormat, result.get()) == bytes)
+            << "type " << type;
+
+        // The span based forms must produce and accept the same bytes.
+        ASSERT_TRUE(nestedSpanMarshal(wireFormat, object.get()) == bytes)
+            << "type " << type;
+
+        std::unique_ptr<DataStructure> spanResult(
+            nestedSpanUnmarshal(wireFormat, bytes, (int)bytes.size()));
+        ASSERT_TRUE(spanResult != NULL) << "type " << type;
+        ASSERT_TRUE(nestedMarshal(wireFormat, spanResult.get()) == bytes)
+            << "type " << type;
+
+        // Every truncated copy must be rejected, never read past its end.
+        for (int length = 0; length < (int)bytes.size(); ++length)
+        {
+            ASSERT_THROW(
+                delete nestedUnmarshal(wireFormat, bytes, length),
+                decaf::io::IOException)
+                << "type " << type << " truncated to " << length;
+            ASSERT_THROW(
+                delete nestedSpanUnmarshal(wireFormat, bytes, length),
+                decaf::io::IOException)
+                << "type " << type << " span truncated to " << length;
+        }
+
+        tested++;
+    }
+
+    ASSERT_TRUE(tested > 50);
+}
+
+void assertPopulatedCommandsRoundTrip(bool tightEncoding)
+{
+    Properties     properties;
+    OpenWireFormat wireFormat(properties);
+    wireFormat.setVersion(OpenWireFormat::MAX_SUPPORTED_VERSION);
+    wireFormat.setTightEncodingEnabled(tightEncoding);
+
+    IOTransport transport;
+
+    // Ascii strings longer than a signed short and chars that take two
+    // bytes once encoded each take a different path through the marshalers.
+    std::string longName(40000, 'Q');
+    std::string latin1Text("caf\xE9 \x01\x7F\x80\xFF");
+    latin1Text.push_back('\0');
+
+    std::shared_ptr<ConsumerInfo> consumer(new ConsumerInfo());
+    std::shared_ptr<ConsumerId> consumerId(new ConsumerId());
+    consumerId->setConnectionId("ID:test-connection:1");
+    consumerId->setSessionId(2);
+    consumerId->setValue(3);
+    consumer->setConsumerId(consumerId);
+    consumer->setDestination(
+        std::shared_ptr<ActiveMQDestination>(new ActiveMQQueue(longName)));
+    consumer->setSelector(latin1Text);
+    consumer->setPrefetchSize(1000);
+    consumer->setPriority(5);
+
+    std::shared_ptr<ActiveMQTextMessage> message(new ActiveMQTextMessage());
+    message->setProducerId(std::shared_ptr<ProducerId>(
+        new ProducerId("ID:test-connection:1:1")));
+    message->setDestination(std::shared_ptr<ActiveMQDestination>(
+        new ActiveMQQueue("TEST.ROUNDTRIP")));
+
+    std::shared_ptr<MessageId> messageId(new MessageId());
+    messageId->setProducerId(message->getProducerId());
+    messageId->setProducerSequenceId(7);
+    message->setMessageId(messageId);
+    message->setText(latin1Text);
+    message->setIntProperty("count", 42);
+    message->setStringProperty("name", longName);
+    message->setExpiration(0x0000FFFFFFFFFFFFLL);
+    message->setTimestamp(-1);
+
+    std::vector<std::shared_ptr<Command>> commands;
+    commands.push_back(consumer);
+    commands.push_back(message);
+
+    std::vector<std::shared_ptr<Command>> received;
+
+    for (std::size_t i = 0; i < commands.size(); ++i)
+    {
+        ByteArrayOutputStream baos;
+        DataOutputStream      dataOut(&baos);
+        wireFormat.marshal(commands[i], &transport, &dataOut);
+
+        std::pair<unsigned char*, int> array = baos.toByteArray();
+        ByteArrayInputStream           bais(array.first, array.second, true);
+        DataInputStream                dataIn(&bais);
+
+        // The size prefix covers exactly the bytes that follow it.
+        ByteArrayInputStream prefixIn(array.first, 4);
+        DataInputStream      prefixDataIn(&prefixIn);
+        ASSERT_EQ(array.second - 4, prefixDataIn.readInt());
+
+        received.push_back(wireFormat.unmarshal(&transport, &dataIn));
+        ASSERT_TRUE(received[i] != NULL);
+        ASSERT_EQ(0, bais.available());
+        ASSERT_TRUE(received[i]->equals(commands[i].get()));
+
+        // The frame decoder's span based path reads the same frame.
+        ByteReader               frame(array.first, (std::size_t)array.second);
+        std::shared_ptr<Command> spanCommand =
+            wireFormat.unmarshal(&transport, &frame);
+        ASSERT_TRUE(spanCommand != NULL);
+        ASSERT_EQ((std::size_t)0, frame.remaining());
+        ASSERT_TRUE(spanCommand->equals(commands[i].get()));
+        ASSERT_EQ(received[i]->toString(), spanCommand->toString());
+    }
+
+    std::shared_ptr<ConsumerInfo> receivedConsumer =
+        std::dynamic_pointer_cast<ConsumerInfo>(received[0]);
+    ASSERT_EQ(longName,
+              receivedConsumer->getDestination()->getPhysicalName());
+    ASSERT_EQ(latin1Text, receivedConsumer->getSelector());
+
+    std::shared_ptr<ActiveMQTextMessage> receivedMessage =
+        std::dynamic_pointer_cast<ActiveMQTextMessage>(received[1]);
+    ASSERT_EQ(latin1Text, receivedMessage->getText());
+    ASSERT_EQ(longName, receivedMessage->getStringProperty("name"));
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatTest, testLooseRoundTripAllMarshallers)
+{
+    assertAllMarshallersRoundTrip(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatTest, testTightRoundTripAllMarshallers)
+{
+    assertAllMarshallersRoundTrip(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatTest, testLooseRoundTripPopulatedCommands)
+{
+    assertPopulatedCommandsRoundTrip(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatTest, testTightRoundTripPopulatedCommands)
+{
+    assertPopulatedCommandsRoundTrip(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatTest, testMarshalNullCommand)
+{
+    Properties     properties;
+    OpenWireFormat wireFormat(properties);
+    IOTransport    transport;
+
+    ByteArrayOutputStream prefixed;
+    DataOutputStream      prefixedOut(&prefixed);
+    wireFormat.marshal(std::shared_ptr<Command>(), &transport, &prefixedOut);
+    ASSERT_EQ(5LL, prefixed.size());
+
+    wireFormat.setSizePrefixDisabled(true);
+
+    ByteArrayOutputStream unprefixed;
+    DataOutputStream      unprefixedOut(&unprefixed);
+    wireFormat.marshal(std::shared_ptr<Command>(), &transport, &unprefixedOut);
+    ASSERT_EQ(1LL, unprefixed.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+std::shared_ptr<OpenWireFormat> createInterningWireFormat(
+    bool               tightEncoding,
+    bool               cacheEnabled,
+    const std::string& internTableSize)
+{
+    Properties properties;
+    properties.setProperty("wireFormat.cacheEnabled",
+                           cacheEnabled ? "true" : "false");
+    properties.setProperty("wireFormat.tightEncodingEnabled",
+                           tightEncoding ? "true" : "false");
+    properties.setProperty("wireFormat.internTableSize", internTableSize);
+
+    return std::dynamic_pointer_cast<OpenWireFormat>(
+        OpenWireFormatFactory().createWireFormat(properties));
+}
+
+std::shared_ptr<ActiveMQTextMessage> sendThrough(
+    OpenWireFormat&                             client,
+    OpenWireFormat&                             broker,
+    const std::shared_ptr<ActiveMQTextMessage>& message,
+    bool                                        spanDecode)
+{
+    IOTransport transport;
+
+    ByteArrayOutputStream baos;
+    DataOutputStream      dataOut(&baos);
+    client.marshal(message, &transport, &dataOut);
+
+    std::pair<unsigned char*, int> array = baos.toByteArray();
+    std::unique_ptr<unsigned char[]> bytes(array.first);
+
+    std::shared_ptr<Command> received;
+    if (spanDecode)
+    {
+        ByteReader frame(array.first, (std::size_t)array.second);
+        received = broker.unmarshal(&transport, &frame);
+    }
+    else
+    {
+        ByteArrayInputStream bais(array.first, array.second);
+        DataInputStream      dataIn(&bais);
+        received = broker.unmarshal(&transport, &dataIn);
+    }
+
+    return std::dynamic_pointer_cast<ActiveMQTextMessage>(received);
+}
+
+std::shared_ptr<ActiveMQTextMessage> createInternedMessage(
+    const std::string& destination)
+{
+    std::shared_ptr<ActiveMQTextMessage> message(new ActiveMQTextMessage());
+
+    std::shared_ptr<ProducerId> producerId(
+        new ProducerId("ID:test-connection:1:2:3"));
+    std::shared_ptr<ConsumerId> consumerId(new ConsumerId());
+    consumerId->setConnectionId("ID:test-connection:1");
+    consumerId->setSessionId(4);
+    consumerId->setValue(70000);
+
+    std::shared_ptr<MessageId> messageId(new MessageId());
+    messageId->setProducerId(
+        std::shared_ptr<ProducerId>(producerId->cloneDataStructure()));
+    messageId->setProducerSequenceId(1);
+
+    message->setProducerId(producerId);
+    message->setMessageId(messageId);
+    message->setTargetConsumerId(consumerId);
+    message->setDestination(
+        std::shared_ptr<ActiveMQDestination>(new ActiveMQQueue(destination)));
+    message->setReplyTo(std::shared_ptr<ActiveMQDestination>(
+        new ActiveMQTopic("TEST.INTERN.REPLIES")));
+    message->setText("message");
+
+    return message;
+}
+
+void assertInterning(bool tightEncoding, bool cacheEnabled)
+{
+    std::shared_ptr<OpenWireFormat> client =
+        createInterningWireFormat(tightEncoding, cacheEnabled, "16");
+    std::shared_ptr<OpenWireFormat> broker =
+        createInterningWireFormat(tightEncoding, cacheEnabled, "16");
+
+    client->renegotiateWireFormat(*broker->getPreferedWireFormatInfo());
+    broker->renegotiateWireFormat(*client->getPreferedWireFormatInfo());
+    ASSERT_EQ(cacheEnabled, broker->isCacheEnabled());
+    ASSERT_EQ(16, broker->getInternTableSize());
+
+    std::vector<std::shared_ptr<ActiveMQTextMessage>> received;
+
+    // Alternate between the stream and span based paths, both share the
+    // one intern table.
+    for (int i = 0; i < 3; ++i)
+    {
+        std::shared_ptr<ActiveMQTextMessage> message =
+            createInternedMessage("TEST.INTERN.QUEUE");
+
+        received.push_back(sendThrough(*client, *broker, message, i == 1));
+
+        ASSERT_TRUE(received[i] != NULL);
+        ASSERT_TRUE(received[i]->equals(message.get()));
+        ASSERT_EQ(std::string("message"), received[i]->getText());
+    }
+
+    for (int i = 1; i < 3; ++i)
+    {
+        ASSERT_EQ(received[0]->getProducerId().get(),
+                  received[i]->getProducerId().get());
+        ASSERT_EQ(received[0]->getDestination().get(),
+                  received[i]->getDestination().get());
+        ASSERT_EQ(received[0]->getReplyTo().get(),
+                  received[i]->getReplyTo().get());
+        ASSERT_EQ(received[0]->getTargetConsumerId().get(),
+                  received[i]->getTargetConsumerId().get());
+
+        // Each message still gets its own id, only the parts are shared.
+        ASSERT_NE(received[0]->getMessageId().get(),
+                  received[i]->getMessageId().get());
+        ASSERT_EQ(received[0]->getProducerId().get(),
+                  received[i]->getMessageId()->getProducerId().get());
+    }
+
+    // Same name but another type, and another name, are different entries.
+    std::shared_ptr<ActiveMQTextMessage> other = sendThrough(
+        *client, *broker, createInternedMessage("TEST.INTERN.OTHER"), true);
+    ASSERT_EQ(std::string("TEST.INTERN.OTHER"),
+              other->getDestination()->getPhysicalName());
+    ASSERT_NE(received[0]->getDestination().get(),
+              other->getDestination().get());
+    ASSERT_EQ(received[0]->getReplyTo().get(), other->getReplyTo().get());
+
+    std::shared_ptr<ActiveMQTextMessage> topic =
+        createInternedMessage("TEST.INTERN.REPLIES");
+    topic->setDestination(std::shared_ptr<ActiveMQDestination>(
+        new ActiveMQTopic("TEST.INTERN.REPLIES")));
+    topic->setReplyTo(std::shared_ptr<ActiveMQDestination>(
+        new ActiveMQQueue("TEST.INTERN.REPLIES")));
+    topic = sendThrough(*client, *broker, topic, false);
+    ASSERT_EQ(received[0]->getReplyTo().get(), topic->getDestination().get());
+    ASSERT_EQ(cms::Destination::QUEUE,
+              topic->getReplyTo()->getDestinationType());
+    ASSERT_NE(topic->getDestination().get(), topic->getReplyTo().get());
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatTest, testLooseInterning)
+{
+    assertInterning(false, false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatTest, testTightInterning)
+{
+    assertInterning(true, false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatTest, testLooseInterningWithCache)
+{
+    assertInterning(false, true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatTest, testTightInterningWithCache)
+{
+    assertInterning(true, true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatTest, testInterningDisabled)
+{
+    std::shared_ptr<OpenWireFormat> client =
+        createInterningWireFormat(true, false, "0");
+    std::shared_ptr<OpenWireFormat> broker =
+        createInterningWireFormat(true, false, "0");
+
+    ASSERT_EQ(0, broker->getInternTableSize());
+
+    std::shared_ptr<ActiveMQTextMessage> first = sendThrough(
+        *client, *broker, createInternedMessage("TEST.INTERN.QUEUE"), true);
+    std::shared_ptr<ActiveMQTextMessage> second = sendThrough(
+        *client, *broker, createInternedMessage("TEST.INTERN.QUEUE"), true);
+
+    ASSERT_TRUE(first->getProducerId()->equals(second->getProducerId().get()));
+    ASSERT_NE(first->getProducerId().get(), second->getProducerId().get());
+    ASSERT_TRUE(
+        first->getDestination()->equals(second->getDestination().get()));
+    ASSERT_NE(first->getDestination().get(), second->getDestination().get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatTest, testInternKeyIncludesTightFlags)
+{
+    std::shared_ptr<OpenWireFormat> client =
+        createInterningWireFormat(true, false, "16");
+    std::shared_ptr<OpenWireFormat> broker =
+        createInterningWireFormat(true, false, "16");
+
+    // A two byte value then a four byte session id leaves the same bytes on
+    // the wire as a four byte value then a two byte session id, only the
+    // flags in the boolean stream tell them apart.
+    std::shared_ptr<ActiveMQTextMessage> first =
+        createInternedMessage("TEST.INTERN.QUEUE");
+    std::shared_ptr<ProducerId> shortValue(new ProducerId());
+    shortValue->setConnectionId("ID:test-connection:1");
+    shortValue->setValue(0x0001);
+    shortValue->setSessionId(0x00010002);
+    first->setProducerId(shortValue);
+
+    std::shared_ptr<ActiveMQTextMessage> second =
+        createInternedMessage("TEST.INTERN.QUEUE");
+    std::shared_ptr<ProducerId> longValue(new ProducerId());
+    longValue->setConnectionId("ID:test-connection:1");
+    longValue->setValue(0x00010001);
+    longValue->setSessionId(0x0002);
+    second->setProducerId(longValue);
+
+    first  = sendThrough(*client, *broker, first, true);
+    second = sendThrough(*client, *broker, second, false);
+
+    ASSERT_TRUE(first->getProducerId()->equals(shortValue.get()));
+    ASSERT_TRUE(second->getProducerId()->equals(longValue.get()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFormatTest, testInternedIdParentsSharedAcrossThreads)
+{
+    static const int THREADS = 8;
+
+    std::shared_ptr<OpenWireFormat> client =
+        createInterningWireFormat(true, false, "16");
+    std::shared_ptr<OpenWireFormat> broker =
+        createInterningWireFormat(true, false, "16");
+
+    std::shared_ptr<ActiveMQTextMessage> message = sendThrough(
+        *client, *broker, createInternedMessage("TEST.INTERN.QUEUE"), true);
+    const ProducerId* producerId = message->getProducerId().get();
+    const ConsumerId* consumerId = message->getTargetConsumerId().get();
+
+    // Every reader of an interned id must see the same parent chain, however
+    // many of them get there first.
+    std::vector<const ConnectionId*> producerParents(THREADS, NULL);
+    std::vector<const ConnectionId*> consumerParents(THREADS, NULL);
+    std::vector<std::thread>         readers;
+    for (int i = 0; i < THREADS; ++i)
+    {
+        readers.emplace_back(
+            [&, i]()
+            {
+                producerParents[i] =
+                    producerId->getParentId()->getParentId().get();
+                consumerParents[i] =
+                    consumerId->getParentId()->getParentId().get();
+            });
+    }
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+
+    for (int i = 0; i < THREADS; ++i)
+    {
+        ASSERT_EQ(producerParents[0], producerParents[i]);
+        ASSERT_EQ(consumerParents[0], consumerParents[i]);
+    }
+    ASSERT_EQ(producerId->getConnectionId(), producerParents[0]->getValue());
+    ASSERT_EQ(consumerId->getConnectionId(), consumerParents[0]->getValue());
+}
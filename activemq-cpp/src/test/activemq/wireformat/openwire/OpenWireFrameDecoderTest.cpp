@@ -0,0 +1,266 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/commands/KeepAliveInfo.h>
+#include <activemq/transport/IOTransport.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <activemq/wireformat/openwire/OpenWireFrameDecoder.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/IOException.h>
+#include <decaf/util/Properties.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace decaf::io;
+using namespace decaf::util;
+
+class OpenWireFrameDecoderTest : public ::testing::Test
+{
+};
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+std::shared_ptr<Command> createTextMessage(const std::string& text)
+{
+    std::shared_ptr<ActiveMQTextMessage> message(new ActiveMQTextMessage());
+    message->setText(text);
+    return message;
+}
+
+std::vector<unsigned char> marshalAll(
+    OpenWireFormat&                              wireFormat,
+    const Transport*                             transport,
+    const std::vector<std::shared_ptr<Command>>& commands)
+{
+    ByteArrayOutputStream baos;
+    DataOutputStream      dataOut(&baos);
+
+    for (std::size_t i = 0; i < commands.size(); ++i)
+    {
+        wireFormat.marshal(commands[i], transport, &dataOut);
+    }
+
+    std::pair<unsigned char*, int> array = baos.toByteArray();
+
+    std::vector<unsigned char> result(array.first, array.first + array.second);
+    delete[] array.first;
+
+    return result;
+}
+
+void assertDecodesInChunks(bool tightEncoding, std::size_t chunkSize)
+{
+    Properties     properties;
+    OpenWireFormat wireFormat(properties);
+    IOTransport    transport;
+
+    wireFormat.setVersion(OpenWireFormat::MAX_SUPPORTED_VERSION);
+    wireFormat.setTightEncodingEnabled(tightEncoding);
+
+    std::vector<std::shared_ptr<Command>> commands;
+    commands.push_back(createTextMessage("first"));
+    commands.push_back(std::shared_ptr<Command>(new KeepAliveInfo()));
+    commands.push_back(createTextMessage(std::string(20000, 'x')));
+
+    std::vector<unsigned char> data =
+        marshalAll(wireFormat, &transport, commands);
+
+    OpenWireFrameDecoder                  decoder(&wireFormat, &transport, 64);
+    std::vector<std::shared_ptr<Command>> decoded;
+
+    for (std::size_t offset = 0; offset < data.size(); offset += chunkSize)
+    {
+        std::size_t length = std::min(chunkSize, data.size() - offset);
+        decoder.append(&data[offset], (int)length);
+
+        std::shared_ptr<Command> command;
+        while ((command = decoder.nextCommand()) != NULL)
+        {
+            decoded.push_back(command);
+        }
+    }
+
+    ASSERT_EQ((std::size_t)3, decoded.size());
+    ASSERT_EQ((std::size_t)0, decoder.getBufferedSize());
+
+    std::shared_ptr<ActiveMQTextMessage> first =
+        std::dynamic_pointer_cast<ActiveMQTextMessage>(decoded[0]);
+    ASSERT_TRUE(first != NULL);
+    ASSERT_EQ(std::string("first"), first->getText());
+
+    ASSERT_TRUE(std::dynamic_pointer_cast<KeepAliveInfo>(decoded[1]) != NULL);
+
+    std::shared_ptr<ActiveMQTextMessage> last =
+        std::dynamic_pointer_cast<ActiveMQTextMessage>(decoded[2]);
+    ASSERT_TRUE(last != NULL);
+    ASSERT_EQ(std::string(20000, 'x'), last->getText());
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFrameDecoderTest, testDecodeWholeBuffer)
+{
+    assertDecodesInChunks(false, 1024 * 1024);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFrameDecoderTest, testDecodeOneByteAtATime)
+{
+    assertDecodesInChunks(false, 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFrameDecoderTest, testDecodeSplitChunks)
+{
+    assertDecodesInChunks(false, 7);
+    assertDecodesInChunks(false, 4096);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFrameDecoderTest, testDecodeTightEncoding)
+{
+    assertDecodesInChunks(true, 1);
+    assertDecodesInChunks(true, 513);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFrameDecoderTest, testGrowsAsFrameArrives)
+{
+    Properties     properties;
+    OpenWireFormat wireFormat(properties);
+    IOTransport    transport;
+
+    std::vector<std::shared_ptr<Command>> commands;
+    commands.push_back(createTextMessage(std::string(100000, 'y')));
+
+    std::vector<unsigned char> data =
+        marshalAll(wireFormat, &transport, commands);
+
+    OpenWireFrameDecoder decoder(&wireFormat, &transport, 16);
+
+    // Knowing the size prefix doesn't reserve room for the whole frame.
+    decoder.append(&data[0], 8);
+    ASSERT_TRUE(decoder.nextCommand() == NULL);
+    ASSERT_EQ((std::size_t)16, decoder.getCapacity());
+
+    decoder.append(&data[8], 1000);
+    ASSERT_TRUE(decoder.nextCommand() == NULL);
+    ASSERT_TRUE(decoder.getCapacity() < data.size());
+
+    decoder.append(&data[1008], (int)data.size() - 1008);
+    ASSERT_TRUE(decoder.nextCommand() != NULL);
+    ASSERT_TRUE(decoder.nextCommand() == NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFrameDecoderTest, testInvalidFrameSize)
+{
+    Properties           properties;
+    OpenWireFormat       wireFormat(properties);
+    OpenWireFrameDecoder decoder(&wireFormat, NULL);
+
+    const unsigned char header[] = {0x80, 0x00, 0x00, 0x01};
+    decoder.append(header, 4);
+
+    ASSERT_THROW(decoder.nextCommand(), IOException)
+        << "Should throw an IOException for a negative frame size";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFrameDecoderTest, testResetDiscardsPartialFrame)
+{
+    Properties     properties;
+    OpenWireFormat wireFormat(properties);
+    IOTransport    transport;
+
+    std::vector<std::shared_ptr<Command>> commands;
+    commands.push_back(createTextMessage("partial"));
+    commands.push_back(createTextMessage("complete"));
+
+    std::vector<unsigned char> data =
+        marshalAll(wireFormat, &transport, commands);
+    std::vector<unsigned char> second =
+        marshalAll(wireFormat,
+                   &transport,
+                   std::vector<std::shared_ptr<Command>>(1, commands[1]));
+
+    OpenWireFrameDecoder decoder(&wireFormat, &transport);
+
+    decoder.append(&data[0], 10);
+    ASSERT_TRUE(decoder.nextCommand() == NULL);
+    ASSERT_EQ((std::size_t)10, decoder.getBufferedSize());
+
+    decoder.reset();
+    ASSERT_EQ((std::size_t)0, decoder.getBufferedSize());
+
+    decoder.append(&second[0], (int)second.size());
+    std::shared_ptr<ActiveMQTextMessage> message =
+        std::dynamic_pointer_cast<ActiveMQTextMessage>(decoder.nextCommand());
+    ASSERT_TRUE(message != NULL);
+    ASSERT_EQ(std::string("complete"), message->getText());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(OpenWireFrameDecoderTest, testFrameSizeOverLimit)
+{
+    Properties     properties;
+    OpenWireFormat wireFormat(properties);
+
+    // Text from a peer that doesn't speak OpenWire reads as a huge size.
+    const unsigned char http[] = {'H', 'T', 'T', 'P', '/', '1', '.', '1'};
+
+    OpenWireFrameDecoder decoder(&wireFormat, NULL);
+    decoder.append(http, 8);
+    ASSERT_THROW(decoder.nextCommand(), IOException)
+        << "Should throw an IOException for a frame over the default limit";
+    ASSERT_EQ((std::size_t)OpenWireFrameDecoder::DEFAULT_INITIAL_CAPACITY,
+              decoder.getCapacity());
+
+    const unsigned char header[] = {0x00, 0x00, 0x01, 0x01};
+
+    OpenWireFrameDecoder limited(&wireFormat, NULL, 64, 256);
+    limited.append(header, 4);
+    ASSERT_THROW(limited.nextCommand(), IOException)
+        << "Should throw an IOException for a frame over the given limit";
+
+    // The wire format passes its own limit on to the decoders it makes.
+    properties.setProperty("wireFormat.maxFrameSize", "256");
+    OpenWireFormat configured(properties);
+    ASSERT_EQ(256, configured.getMaxFrameSize());
+
+    std::unique_ptr<FrameDecoder> created(
+        configured.createFrameDecoder(NULL));
+    ASSERT_TRUE(created != NULL);
+    created->append(header, 4);
+    ASSERT_THROW(created->nextCommand(), IOException)
+        << "Should throw an IOException for a frame over the configured limit";
+}
@@ -362,8 +362,12 @@ protected:
                 dynamic_cast<ComplexDataStructure*>(dataStructure);
 
             info->boolValue = bs->readBoolean();
-            info->setCachedChild(dynamic_cast<SimpleDataStructure*>(
-                tightUnmarshalCachedObject(wireFormat, dataIn, bs)));
+            std::shared_ptr<commands::DataStructure> child =
+                tightUnmarshalCachedObject(wireFormat, dataIn, bs);
+            info->setCachedChild(
+                child != NULL ? dynamic_cast<SimpleDataStructure*>(
+                                    child->cloneDataStructure())
+                              : NULL);
         }
 
         virtual int tightMarshal1(OpenWireFormat*          wireFormat,
@@ -413,8 +417,12 @@ protected:
                 dynamic_cast<ComplexDataStructure*>(dataStructure);
 
             info->boolValue = dataIn->readBoolean();
-            info->setCachedChild(dynamic_cast<SimpleDataStructure*>(
-                looseUnmarshalCachedObject(wireFormat, dataIn)));
+            std::shared_ptr<commands::DataStructure> child =
+                looseUnmarshalCachedObject(wireFormat, dataIn);
+            info->setCachedChild(
+                child != NULL ? dynamic_cast<SimpleDataStructure*>(
+                                    child->cloneDataStructure())
+                              : NULL);
         }
 
         virtual void looseMarshal(OpenWireFormat*              wireFormat,
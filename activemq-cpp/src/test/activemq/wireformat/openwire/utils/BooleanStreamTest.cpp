@@ -22,6 +22,9 @@
 #include <decaf/io/ByteArrayOutputStream.h>
 #include <decaf/io/DataInputStream.h>
 #include <decaf/io/DataOutputStream.h>
+#include <decaf/io/IOException.h>
+
+#include <vector>
 
 using namespace decaf;
 using namespace decaf::io;
@@ -105,3 +108,134 @@ TEST_F(BooleanStreamTest, test2)
 
     delete[] array.first;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(BooleanStreamTest, testReadPastEnd)
+{
+    BooleanStream b1Stream;
+
+    io::ByteArrayOutputStream baoStream;
+    io::DataOutputStream      daoStream(&baoStream);
+
+    b1Stream.writeBoolean(true);
+    b1Stream.writeBoolean(true);
+    b1Stream.writeBoolean(true);
+    b1Stream.marshal(&daoStream);
+
+    BooleanStream                        b2Stream;
+    std::pair<const unsigned char*, int> array = baoStream.toByteArray();
+    decaf::io::ByteArrayInputStream      baiStream(array.first, array.second);
+    decaf::io::DataInputStream           daiStream(&baiStream);
+
+    b2Stream.unmarshal(&daiStream);
+
+    // Only whole bytes are sent so the rest of the last one reads as false.
+    for (int i = 0; i < 8; ++i)
+    {
+        ASSERT_EQ(i < 3, b2Stream.readBoolean());
+    }
+
+    ASSERT_THROW(b2Stream.readBoolean(), decaf::io::IOException);
+
+    delete[] array.first;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(BooleanStreamTest, testEmptyStream)
+{
+    BooleanStream b1Stream;
+
+    io::ByteArrayOutputStream baoStream;
+    io::DataOutputStream      daoStream(&baoStream);
+
+    ASSERT_EQ(1, b1Stream.marshalledSize());
+    b1Stream.marshal(&daoStream);
+    ASSERT_EQ(1LL, baoStream.size());
+
+    std::vector<unsigned char> vectorOut;
+    b1Stream.marshal(vectorOut);
+    ASSERT_EQ(1U, vectorOut.size());
+    ASSERT_EQ(0, vectorOut[0]);
+
+    BooleanStream                   b2Stream;
+    decaf::io::ByteArrayInputStream baiStream(&vectorOut[0],
+                                              (int)vectorOut.size());
+    decaf::io::DataInputStream      daiStream(&baiStream);
+
+    b2Stream.unmarshal(&daiStream);
+    ASSERT_THROW(b2Stream.readBoolean(), decaf::io::IOException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(BooleanStreamTest, testMarshalToVector)
+{
+    BooleanStream b1Stream;
+
+    io::ByteArrayOutputStream baoStream;
+    io::DataOutputStream      daoStream(&baoStream);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        b1Stream.writeBoolean(i % 3 == 0);
+    }
+
+    std::vector<unsigned char> vectorOut;
+    b1Stream.marshal(vectorOut);
+    b1Stream.marshal(&daoStream);
+
+    std::pair<unsigned char*, int> array = baoStream.toByteArray();
+    std::vector<unsigned char>     streamOut(array.first,
+                                         array.first + array.second);
+    delete[] array.first;
+
+    ASSERT_EQ(b1Stream.marshalledSize(), (int)vectorOut.size());
+    ASSERT_TRUE(streamOut == vectorOut);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(BooleanStreamTest, testUnmarshalMalformed)
+{
+    // A negative size in the short form of the size field.
+    {
+        unsigned char                   bytes[] = {0x80, 0xFF, 0xFF};
+        decaf::io::ByteArrayInputStream baiStream(bytes, 3);
+        decaf::io::DataInputStream      daiStream(&baiStream);
+
+        BooleanStream bStream;
+        ASSERT_THROW(bStream.unmarshal(&daiStream), decaf::io::IOException);
+        ASSERT_THROW(bStream.readBoolean(), decaf::io::IOException);
+    }
+
+    // Fewer bytes than the size field promises.
+    {
+        unsigned char                   bytes[] = {0x05, 0x01, 0x02};
+        decaf::io::ByteArrayInputStream baiStream(bytes, 3);
+        decaf::io::DataInputStream      daiStream(&baiStream);
+
+        BooleanStream bStream;
+        ASSERT_THROW(bStream.unmarshal(&daiStream), decaf::io::IOException);
+    }
+
+    // The size field itself cut short.
+    {
+        unsigned char                   bytes[] = {0xC0};
+        decaf::io::ByteArrayInputStream baiStream(bytes, 1);
+        decaf::io::DataInputStream      daiStream(&baiStream);
+
+        BooleanStream bStream;
+        ASSERT_THROW(bStream.unmarshal(&daiStream), decaf::io::IOException);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(BooleanStreamTest, testMaximumSize)
+{
+    BooleanStream bStream;
+
+    for (int i = 0; i < 32767 * 8; ++i)
+    {
+        bStream.writeBoolean(true);
+    }
+
+    ASSERT_THROW(bStream.writeBoolean(true), decaf::io::IOException);
+}
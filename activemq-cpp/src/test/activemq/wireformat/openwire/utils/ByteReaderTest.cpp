@@ -0,0 +1,152 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <activemq/wireformat/openwire/utils/ByteReader.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/EOFException.h>
+#include <decaf/io/UTFDataFormatException.h>
+#include <decaf/lang/exceptions/IndexOutOfBoundsException.h>
+
+#include <string>
+#include <vector>
+
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang::exceptions;
+using namespace activemq;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+
+class ByteReaderTest : public ::testing::Test
+{
+};
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ByteReaderTest, testReadsWhatDataOutputStreamWrites)
+{
+    ByteArrayOutputStream baos;
+    DataOutputStream      dos(&baos);
+
+    std::string text("ConsumerId:ID:host-1234-5678:1:1:1");
+    text.push_back('\0');
+    text.push_back((char)0xE9);
+
+    dos.writeBoolean(true);
+    dos.writeByte(0xAB);
+    dos.writeShort(-2);
+    dos.writeShort(0xFEDC);
+    dos.writeInt(0x01020304);
+    dos.writeInt(-5);
+    dos.writeLong(0x0102030405060708LL);
+    dos.writeLong(-9);
+    dos.writeUTF(text);
+    dos.writeUTF("");
+
+    std::pair<const unsigned char*, int> array = baos.toByteArray();
+    ByteReader reader(array.first, (std::size_t)array.second);
+
+    ASSERT_TRUE(reader.readBoolean());
+    ASSERT_EQ(0xAB, reader.readByte());
+    ASSERT_EQ(-2, reader.readShort());
+    ASSERT_EQ(0xFEDC, reader.readUnsignedShort());
+    ASSERT_EQ(0x01020304, reader.readInt());
+    ASSERT_EQ(-5, reader.readInt());
+    ASSERT_EQ(0x0102030405060708LL, reader.readLong());
+    ASSERT_EQ(-9, reader.readLong());
+    ASSERT_EQ(text, reader.readUTF());
+    ASSERT_EQ(std::string(), reader.readUTF());
+    ASSERT_EQ((std::size_t)0, reader.remaining());
+    ASSERT_EQ((std::size_t)array.second, reader.getPosition());
+
+    delete[] array.first;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ByteReaderTest, testReadFully)
+{
+    const unsigned char data[] = {1, 2, 3, 4, 5, 6};
+    ByteReader          reader(data, sizeof(data));
+
+    unsigned char buffer[4] = {0, 0, 0, 0};
+    reader.readFully(buffer, 4, 1, 2);
+    ASSERT_EQ(0, buffer[0]);
+    ASSERT_EQ(1, buffer[1]);
+    ASSERT_EQ(2, buffer[2]);
+    ASSERT_EQ(0, buffer[3]);
+
+    reader.skip(1);
+    reader.readFully(buffer, 3);
+    ASSERT_EQ(4, buffer[0]);
+    ASSERT_EQ(5, buffer[1]);
+    ASSERT_EQ(6, buffer[2]);
+
+    ASSERT_THROW(reader.readFully(buffer, 4, 3, 2), IndexOutOfBoundsException)
+        << "Should throw for a range outside the buffer";
+    ASSERT_THROW(reader.readFully(buffer, 4, 0, -1), IndexOutOfBoundsException)
+        << "Should throw for a negative length";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ByteReaderTest, testReadPastEndThrows)
+{
+    const unsigned char data[] = {0, 0, 0, 1, 7};
+    ByteReader          reader(data, sizeof(data));
+
+    reader.skip(2);
+    ASSERT_THROW(reader.readInt(), EOFException)
+        << "Should throw when the int runs past the span";
+    ASSERT_EQ((std::size_t)2, reader.getPosition())
+        << "A failed read should not consume anything";
+
+    ASSERT_EQ(1, reader.readShort());
+    ASSERT_EQ(7, reader.readByte());
+    ASSERT_THROW(reader.readByte(), EOFException);
+    ASSERT_THROW(reader.skip(1), EOFException);
+
+    unsigned char buffer[1];
+    ASSERT_THROW(reader.readFully(buffer, 1), EOFException);
+
+    ByteReader empty(NULL, 0);
+    ASSERT_THROW(empty.readLong(), EOFException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ByteReaderTest, testReadUTFErrors)
+{
+    // Length claims more bytes than the span holds.
+    const unsigned char truncated[] = {0, 4, 'a', 'b'};
+    ByteReader          reader1(truncated, sizeof(truncated));
+    ASSERT_THROW(reader1.readUTF(), EOFException);
+
+    // Two byte character cut off by the end of the string.
+    const unsigned char split[] = {0, 2, 'a', 0xC3};
+    ByteReader          reader2(split, sizeof(split));
+    ASSERT_THROW(reader2.readUTF(), UTFDataFormatException);
+
+    // Characters above 255 can't be held by a std::string.
+    const unsigned char wide[] = {0, 3, 0xE2, 0x82, 0xAC};
+    ByteReader          reader3(wide, sizeof(wide));
+    ASSERT_THROW(reader3.readUTF(), UTFDataFormatException);
+
+    const unsigned char high[] = {0, 2, 0xC4, 0x80};
+    ByteReader          reader4(high, sizeof(high));
+    ASSERT_THROW(reader4.readUTF(), UTFDataFormatException);
+}
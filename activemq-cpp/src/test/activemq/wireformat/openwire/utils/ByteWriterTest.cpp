@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <activemq/wireformat/openwire/utils/ByteWriter.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/UTFDataFormatException.h>
+#include <decaf/lang/exceptions/IndexOutOfBoundsException.h>
+
+#include <string>
+#include <vector>
+
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang::exceptions;
+using namespace activemq;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+
+class ByteWriterTest : public ::testing::Test
+{
+};
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ByteWriterTest, testWritesWhatDataOutputStreamWrites)
+{
+    std::string text("ProducerId:ID:host-1234-5678:1:1:1");
+    text.push_back('\0');
+    text.push_back((char)0xE9);
+
+    const unsigned char bytes[] = {9, 8, 7, 6};
+
+    ByteArrayOutputStream baos;
+    DataOutputStream      dos(&baos);
+
+    dos.writeBoolean(false);
+    dos.writeByte(0xAB);
+    dos.writeShort(-2);
+    dos.writeShort(0xFEDC);
+    dos.writeInt(0x01020304);
+    dos.writeLong(-9);
+    dos.writeUTF(text);
+    dos.writeBytes("abc");
+    dos.write(bytes, 4, 1, 2);
+
+    std::vector<unsigned char> buffer;
+    ByteWriter                 writer(buffer);
+
+    writer.writeBoolean(false);
+    writer.writeByte(0xAB);
+    writer.writeShort(-2);
+    writer.writeUnsignedShort(0xFEDC);
+    writer.writeInt(0x01020304);
+    writer.writeLong(-9);
+    writer.writeUTF(text);
+    writer.writeBytes("abc");
+    writer.write(bytes, 4, 1, 2);
+
+    std::pair<const unsigned char*, int> array = baos.toByteArray();
+
+    ASSERT_EQ((std::size_t)array.second, writer.size());
+    ASSERT_EQ(std::vector<unsigned char>(array.first,
+                                         array.first + array.second),
+              buffer);
+
+    delete[] array.first;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ByteWriterTest, testAppendsToExistingContent)
+{
+    std::vector<unsigned char> buffer(1, 0x55);
+    ByteWriter                 writer(buffer);
+
+    writer.writeInt(0);
+    writer.write(0x11);
+    writer.setInt(1, 0x0A0B0C0D);
+
+    ASSERT_EQ((std::size_t)6, writer.size());
+    ASSERT_EQ(0x55, buffer[0]);
+    ASSERT_EQ(0x0A, buffer[1]);
+    ASSERT_EQ(0x0B, buffer[2]);
+    ASSERT_EQ(0x0C, buffer[3]);
+    ASSERT_EQ(0x0D, buffer[4]);
+    ASSERT_EQ(0x11, buffer[5]);
+    ASSERT_EQ(buffer.data(), writer.getData());
+
+    ASSERT_THROW(writer.setInt(3, 1), IndexOutOfBoundsException)
+        << "Should throw when the int runs past the written bytes";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ByteWriterTest, testErrors)
+{
+    std::vector<unsigned char> buffer;
+    ByteWriter                 writer(buffer);
+
+    const unsigned char bytes[] = {1, 2, 3};
+    ASSERT_THROW(writer.write(bytes, 3, 2, 2), IndexOutOfBoundsException);
+    ASSERT_THROW(writer.write(bytes, 3, -1, 1), IndexOutOfBoundsException);
+    ASSERT_TRUE(buffer.empty());
+
+    ASSERT_THROW(writer.writeUTF(std::string(65536, 'a')),
+                 UTFDataFormatException);
+    ASSERT_THROW(writer.writeUTF(std::string(40000, (char)0xE9)),
+                 UTFDataFormatException);
+    ASSERT_TRUE(buffer.empty()) << "A failed write should not append";
+
+    writer.writeUTF(std::string(65535, 'a'));
+    ASSERT_EQ((std::size_t)65537, writer.size());
+}
@@ -0,0 +1,151 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/wireformat/openwire/utils/InternTable.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+#include <memory>
+#include <string>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::lang::exceptions;
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+
+class InternTableTest : public ::testing::Test
+{
+};
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(InternTableTest, testGetReturnsTheStoredInstance)
+{
+    InternTable table(4);
+
+    std::shared_ptr<DataStructure> queue(new ActiveMQQueue("TEST.QUEUE"));
+    std::shared_ptr<DataStructure> id(new ProducerId("ID:host-1:1:1:1"));
+
+    table.put("queue", queue);
+    table.put("id", id);
+
+    ASSERT_EQ(2, table.size());
+    ASSERT_EQ(queue.get(), table.get("queue").get());
+    ASSERT_EQ(id.get(), table.get("id").get());
+    ASSERT_FALSE(table.get("missing"));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(InternTableTest, testPutReplacesExistingEntry)
+{
+    InternTable table(4);
+
+    std::shared_ptr<DataStructure> first(new ActiveMQQueue("FIRST"));
+    std::shared_ptr<DataStructure> second(new ActiveMQQueue("SECOND"));
+
+    table.put("key", first);
+    table.put("key", second);
+
+    ASSERT_EQ(1, table.size());
+    ASSERT_EQ(second.get(), table.get("key").get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(InternTableTest, testLeastRecentlyUsedIsEvicted)
+{
+    InternTable table(2);
+
+    std::shared_ptr<DataStructure> a(new ActiveMQQueue("A"));
+    std::shared_ptr<DataStructure> b(new ActiveMQQueue("B"));
+    std::shared_ptr<DataStructure> c(new ActiveMQQueue("C"));
+
+    table.put("a", a);
+    table.put("b", b);
+
+    // Using a makes b the eldest.
+    ASSERT_TRUE(table.get("a"));
+
+    table.put("c", c);
+
+    ASSERT_EQ(2, table.size());
+    ASSERT_EQ(a.get(), table.get("a").get());
+    ASSERT_FALSE(table.get("b"));
+    ASSERT_EQ(c.get(), table.get("c").get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(InternTableTest, testKeysAreBinary)
+{
+    InternTable table(4);
+
+    std::string first("\x00\x01", 2);
+    std::string second("\x00\x02", 2);
+
+    std::shared_ptr<DataStructure> a(new ActiveMQQueue("A"));
+    std::shared_ptr<DataStructure> b(new ActiveMQQueue("B"));
+
+    table.put(first, a);
+    table.put(second, b);
+
+    ASSERT_EQ(a.get(), table.get(first).get());
+    ASSERT_EQ(b.get(), table.get(second).get());
+    ASSERT_FALSE(table.get(std::string(1, '\0')));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(InternTableTest, testShrinkingCapacityEvicts)
+{
+    InternTable table(3);
+
+    std::shared_ptr<DataStructure> a(new ActiveMQQueue("A"));
+    std::shared_ptr<DataStructure> b(new ActiveMQQueue("B"));
+    std::shared_ptr<DataStructure> c(new ActiveMQQueue("C"));
+
+    table.put("a", a);
+    table.put("b", b);
+    table.put("c", c);
+
+    table.setCapacity(1);
+
+    ASSERT_EQ(1, table.getCapacity());
+    ASSERT_EQ(1, table.size());
+    ASSERT_EQ(c.get(), table.get("c").get());
+
+    table.clear();
+    ASSERT_EQ(0, table.size());
+    ASSERT_FALSE(table.get("c"));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(InternTableTest, testZeroCapacityDisables)
+{
+    InternTable table(0);
+
+    table.put("a", std::shared_ptr<DataStructure>(new ActiveMQQueue("A")));
+
+    ASSERT_EQ(0, table.size());
+    ASSERT_FALSE(table.get("a"));
+
+    ASSERT_THROW(table.setCapacity(-1), IllegalArgumentException);
+    ASSERT_THROW(InternTable(-1), IllegalArgumentException);
+}
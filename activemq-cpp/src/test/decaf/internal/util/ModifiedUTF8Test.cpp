@@ -0,0 +1,209 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <decaf/internal/util/ModifiedUTF8.h>
+#include <decaf/io/UTFDataFormatException.h>
+
+#include <string>
+#include <vector>
+
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::internal;
+using namespace decaf::internal::util;
+
+class ModifiedUTF8Test : public ::testing::Test
+{
+};
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+// The byte at a time encoding the vectorized kernels must agree with.
+std::vector<unsigned char> referenceEncode(const std::string& value)
+{
+    std::vector<unsigned char> bytes;
+
+    for (std::size_t i = 0; i < value.length(); ++i)
+    {
+        unsigned char c = (unsigned char)value[i];
+
+        if (c > 0 && c <= 127)
+        {
+            bytes.push_back(c);
+        }
+        else
+        {
+            bytes.push_back((unsigned char)(0xC0 | (0x1F & (c >> 6))));
+            bytes.push_back((unsigned char)(0x80 | (0x3F & c)));
+        }
+    }
+
+    return bytes;
+}
+
+std::string decode(const std::vector<unsigned char>& bytes)
+{
+    std::string result(bytes.size(), '\0');
+    if (!bytes.empty())
+    {
+        result.resize(
+            ModifiedUTF8::decode(&bytes[0], bytes.size(), &result[0]));
+    }
+
+    return result;
+}
+
+void assertRoundTrip(const std::string& value)
+{
+    std::vector<unsigned char> expected = referenceEncode(value);
+
+    ASSERT_EQ(expected.size(),
+              ModifiedUTF8::encodedLength(value.c_str(), value.length()))
+        << "length " << value.length();
+
+    std::vector<unsigned char> encoded(expected.size());
+    if (!encoded.empty())
+    {
+        ModifiedUTF8::encode(value.c_str(), value.length(), &encoded[0]);
+    }
+    ASSERT_TRUE(expected == encoded) << "length " << value.length();
+
+    ASSERT_EQ(value, decode(encoded)) << "length " << value.length();
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ModifiedUTF8Test, testAsciiRoundTrip)
+{
+    // Lengths either side of each vector width exercise the scalar tails.
+    for (std::size_t length = 0; length <= 100; ++length)
+    {
+        std::string value;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            value.push_back((char)('!' + (i % 90)));
+        }
+
+        assertRoundTrip(value);
+    }
+
+    std::string id("ID:broker-host.example.com-61616-1712345678901-1:1:1:1");
+    ASSERT_EQ(id.length(),
+              ModifiedUTF8::encodedLength(id.c_str(), id.length()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ModifiedUTF8Test, testWideCharacterAtEveryPosition)
+{
+    const unsigned char wide[] = {0x00, 0x80, 0xC3, 0xE9, 0xFF};
+
+    for (std::size_t w = 0; w < sizeof(wide); ++w)
+    {
+        for (std::size_t position = 0; position < 70; ++position)
+        {
+            std::string value(70, 'a');
+            value[position] = (char)wide[w];
+            assertRoundTrip(value);
+
+            // And a second one further along in a later vector.
+            value[(position * 7 + 33) % 70] = (char)wide[w];
+            assertRoundTrip(value);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ModifiedUTF8Test, testAllCharacters)
+{
+    std::string value;
+    for (int repeat = 0; repeat < 300; ++repeat)
+    {
+        for (int c = 0; c < 256; ++c)
+        {
+            value.push_back((char)c);
+        }
+    }
+
+    // Long enough that the counting lanes are summed more than once.
+    assertRoundTrip(value);
+    assertRoundTrip(std::string(20000, '\0'));
+    assertRoundTrip(std::string(20000, (char)0xFF));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ModifiedUTF8Test, testDecodeInPlace)
+{
+    std::string value("caf\xE9 ID:host-1:1:\x80 end of the string");
+    std::vector<unsigned char> encoded = referenceEncode(value);
+
+    std::string buffer(encoded.begin(), encoded.end());
+    buffer.resize(ModifiedUTF8::decode(
+        (const unsigned char*)&buffer[0], buffer.size(), &buffer[0]));
+
+    ASSERT_EQ(value, buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ModifiedUTF8Test, testDecodeAcceptsSingleByteZero)
+{
+    std::vector<unsigned char> bytes(40, 'x');
+    bytes[3]  = 0;
+    bytes[37] = 0;
+
+    std::string expected(40, 'x');
+    expected[3]  = '\0';
+    expected[37] = '\0';
+
+    ASSERT_EQ(expected, decode(bytes));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(ModifiedUTF8Test, testDecodeErrors)
+{
+    std::vector<unsigned char> bytes(40, 'x');
+
+    // Two byte character cut off by the end of the data.
+    bytes.back() = 0xC3;
+    ASSERT_THROW(decode(bytes), UTFDataFormatException);
+
+    // Second byte not a continuation.
+    bytes[20] = 0xC3;
+    bytes[21] = 'y';
+    bytes.back() = 'x';
+    ASSERT_THROW(decode(bytes), UTFDataFormatException);
+
+    // Characters above 255.
+    bytes[20] = 0xC4;
+    bytes[21] = 0x80;
+    ASSERT_THROW(decode(bytes), UTFDataFormatException);
+
+    bytes[20] = 0xE2;
+    bytes[21] = 0x82;
+    bytes[22] = 0xAC;
+    ASSERT_THROW(decode(bytes), UTFDataFormatException);
+
+    // A lone continuation byte.
+    bytes[20] = 0x80;
+    bytes[21] = 'x';
+    bytes[22] = 'x';
+    ASSERT_THROW(decode(bytes), UTFDataFormatException);
+}
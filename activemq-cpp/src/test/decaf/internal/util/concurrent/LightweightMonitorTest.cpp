@@ -0,0 +1,176 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <decaf/internal/util/concurrent/LightweightMonitor.h>
+#include <decaf/util/Config.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace decaf;
+using namespace decaf::internal;
+using namespace decaf::internal::util;
+using namespace decaf::internal::util::concurrent;
+
+class LightweightMonitorTest : public ::testing::Test
+{
+};
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LightweightMonitorTest, testReentrantLock)
+{
+    LightweightMonitor monitor;
+
+    ASSERT_FALSE(monitor.isLocked());
+    ASSERT_EQ(0, monitor.getRecursionCount());
+
+    monitor.lock();
+    monitor.lock();
+    ASSERT_TRUE(monitor.tryLock());
+    ASSERT_TRUE(monitor.isHeldByCurrentThread());
+    ASSERT_EQ(3, monitor.getRecursionCount());
+
+    bool otherAcquired = true;
+    std::thread other([&]() { otherAcquired = monitor.tryLock(); });
+    other.join();
+    ASSERT_FALSE(otherAcquired);
+
+    monitor.unlock();
+    monitor.unlock();
+    ASSERT_TRUE(monitor.isLocked());
+    monitor.unlock();
+    ASSERT_FALSE(monitor.isLocked());
+    ASSERT_EQ(0, monitor.getContendedCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LightweightMonitorTest, testFullyUnlockAndReLock)
+{
+    LightweightMonitor monitor;
+
+    ASSERT_EQ(0, monitor.fullyUnlock());
+
+    monitor.lock();
+    monitor.lock();
+    int depth = monitor.fullyUnlock();
+    ASSERT_EQ(2, depth);
+    ASSERT_FALSE(monitor.isLocked());
+
+    monitor.reLock(depth);
+    ASSERT_EQ(2, monitor.getRecursionCount());
+    monitor.unlock();
+    monitor.unlock();
+    ASSERT_FALSE(monitor.isLocked());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LightweightMonitorTest, testContendedCounting)
+{
+    LightweightMonitor monitor;
+    const int          threads    = 4;
+    const int          iterations = 20000;
+    long long          counter    = 0;
+
+    std::thread workers[threads];
+    for (int i = 0; i < threads; ++i)
+    {
+        workers[i] = std::thread(
+            [&]()
+            {
+                for (int j = 0; j < iterations; ++j)
+                {
+                    monitor.lock();
+                    counter++;
+                    monitor.unlock();
+                }
+            });
+    }
+
+    // Hold the lock while the workers start so at least one of them has to
+    // take the slow path.
+    monitor.lock();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    monitor.unlock();
+
+    for (int i = 0; i < threads; ++i)
+    {
+        workers[i].join();
+    }
+
+    ASSERT_EQ((long long)threads * iterations, counter);
+    ASSERT_GT(monitor.getContendedCount(), 0);
+    ASSERT_GE(LightweightMonitor::getTotalContendedCount(),
+              monitor.getContendedCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LightweightMonitorTest, testAwaitSignal)
+{
+    LightweightMonitor monitor;
+    std::atomic<bool>  ready(false);
+    bool               signalled = false;
+
+    std::thread waiter(
+        [&]()
+        {
+            monitor.lock();
+            ready.store(true);
+            while (!signalled)
+            {
+                int sequence = monitor.getSequence();
+                int depth    = monitor.fullyUnlock();
+                monitor.await(sequence, 0);
+                monitor.reLock(depth);
+            }
+            monitor.unlock();
+        });
+
+    while (!ready.load())
+    {
+        std::this_thread::yield();
+    }
+
+    monitor.lock();
+    signalled = true;
+    monitor.signal(false);
+    monitor.unlock();
+
+    waiter.join();
+    ASSERT_FALSE(monitor.isLocked());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(LightweightMonitorTest, testAwaitTimeout)
+{
+    LightweightMonitor monitor;
+
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    monitor.await(monitor.getSequence(), 20000000LL);
+    long long elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+
+    ASSERT_GE(elapsed, 15);
+
+    // A stale sequence returns straight away.
+    monitor.signal(true);
+    monitor.await(monitor.getSequence() - 1, 0);
+}